@@ -5,12 +5,18 @@
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 #include <universal/utility/directives.hpp>
+#include <chrono>
+#include <cstdlib>
 // Configure the posit library with arithmetic exceptions
 // enable posit arithmetic exceptions
 #define POSIT_THROW_ARITHMETIC_EXCEPTION 1
 #include <universal/number/posit/posit.hpp>
 #include <universal/blas/blas.hpp>
 #include <universal/blas/generators.hpp>
+#include <universal/blas/solvers/jacobi.hpp>
+#include <universal/blas/solvers/gauss_seidel.hpp>
+#include <universal/blas/solvers/sor.hpp>
+#include <universal/blas/solvers/cg.hpp>
 
 /*
 
@@ -88,25 +94,76 @@ As I said, I had hoped to try this approach with Type I unums
 but ran out of time. My manuscript was six months late as it was!
 */
 
+// right hand side of the 5-point Laplacian on the N x N interior of the unit square:
+// f = 1 on the left half of the bottom border, f = -1 on the top half of the right border, f = 0 elsewhere
+template<typename Scalar>
+sw::universal::blas::vector<Scalar> BoundaryConditions(size_t N) {
+	sw::universal::blas::vector<Scalar> b(N * N, Scalar(0));
+	for (size_t j = 0; j < N / 2; ++j) b[j] += Scalar(1);                       // bottom row of the interior, i = 0
+	for (size_t i = N / 2; i < N; ++i) b[i * N + N - 1] += Scalar(-1);         // right column of the interior
+	return b;
+}
+
+// solve Laplace's equation with red-black SOR at the optimal relaxation factor and report against a double reference
+// the tolerance is per grid point, as the solvers test the L1 norm of the change of the whole iterate
+template<typename Scalar, size_t MAX_ITERATIONS = 20000>
+void LaplaceSOR(const std::string& tag, size_t N, const sw::universal::blas::vector<double>& reference, double tolerance) {
+	using namespace sw::universal::blas;
+	stencil<Scalar, 2> A;
+	laplace2D(A, N, N);
+	auto b = BoundaryConditions<Scalar>(N);
+	vector<Scalar> x(N * N, Scalar(0));
+	Scalar w = Scalar(2.0 / (1.0 + std::sin(pi / double(N + 1))));
+	auto begin = std::chrono::steady_clock::now();
+	size_t itr = sor<stencil<Scalar, 2>, vector<Scalar>, MAX_ITERATIONS>(A, b, x, w, Scalar(tolerance * double(N * N)));
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+	double error = 0.0;
+	for (size_t i = 0; i < N * N; ++i) error = std::max(error, std::abs(double(x[i]) - reference[i]));
+	std::cout << std::setw(15) << tag << " : " << std::setw(6) << itr << " iterations " << std::setw(10) << elapsed.count() << " sec   max |x - x_double| = " << error << "\n" << std::endl;
+}
+
 int main(int argc, char** argv)
 try {
 	using namespace sw::universal;
 	using namespace sw::universal::blas;
 
-	constexpr size_t nbits = 16;
-	constexpr size_t es = 1;
-	using Scalar = posit<nbits, es>;
-//	using Scalar = float;
-	using Matrix = sw::universal::blas::matrix<Scalar>;
+	// grid of N x N interior points, matrix-free, so 2048 x 2048 grids fit easily
+	size_t N = (argc > 1 ? size_t(std::atol(argv[1])) : 64);
+	if (N < 2) N = 2;
+	std::cout << "Laplace's equation on a " << N << " x " << N << " grid\n";
 
 	int nrOfFailedTestCases = 0;
 
-	Scalar p(pi);
-	std::cout << "PI = " << p << " " << hex_format(p) << '\n';
-
-	Matrix A;
-	laplace2D(A, 5, 5);
-	std::cout << A << std::endl;
+	// double reference, and the convergence of the classic relaxation methods and cg on the same operator
+	stencil<double, 2> A;
+	laplace2D(A, N, N);
+	auto b = BoundaryConditions<double>(N);
+	vector<double> x(N * N, 0.0);
+	double w = 2.0 / (1.0 + std::sin(pi / double(N + 1)));
+	double points = double(N * N);
+	size_t itr = sor<stencil<double, 2>, vector<double>, 100000>(A, b, x, w, 1.0e-14 * points);
+	std::cout << "double SOR reference in " << itr << " iterations\n" << std::endl;
+	vector<double> reference = x;
+
+	if (N <= 256) {
+		x = 0.0;
+		itr = Jacobi<stencil<double, 2>, vector<double>, 100000, false>(A, b, x, 1.0e-10 * points);
+		std::cout << "Jacobi       : " << itr << " iterations\n";
+		x = 0.0;
+		itr = GaussSeidel<stencil<double, 2>, vector<double>, 100000>(A, b, x, 1.0e-10 * points);
+		std::cout << "Gauss-Seidel : " << itr << " iterations\n";
+	}
+	x = 0.0;
+	vector<double> residuals;
+	auto M = jacobi_preconditioner(A);
+	itr = cg<stencil<double, 2>, vector<double>, 100000>(M, A, b, x, residuals, 1.0e-10 * points);
+	std::cout << "cg           : " << itr << " iterations\n\n";
+
+	// the same red-black SOR in lower precisions
+	LaplaceSOR< posit<16, 1> >("posit<16,1>", N, reference, 1.0e-3);
+	LaplaceSOR< posit<32, 2> >("posit<32,2>", N, reference, 1.0e-6);
+	LaplaceSOR< float >("float", N, reference, 1.0e-6);
+	LaplaceSOR< double >("double", N, reference, 1.0e-10);
 
 	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
 }
@@ -5,7 +5,12 @@
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 #include <iostream>
+#include <iomanip>
+#include <universal/number/cfloat/cfloat.hpp>
 #include <universal/number/posit/posit.hpp>
+#include <universal/number/dd/dd.hpp>
+#include <universal/blas/blas.hpp>
+#include <universal/blas/solvers/runge_kutta.hpp>
 
 /*
 On the relation between reliable computation time, float-point precision and the
@@ -30,12 +35,48 @@ agreement with numerical experimental results, especially the scale factors.
 Keywords: reliable computation time, Lyapunov exponent, float precision
  */
 
+// the Lorenz system, sigma = 10, r = 28, b = 8/3, with a maximal Lyapunov exponent of about 0.906
+auto lorenz = [](const auto& t, const auto& y, auto& dydt) {
+	using Scalar = std::remove_cv_t<std::remove_reference_t<decltype(t)>>;
+	Scalar sigma(10), rho(28), beta = Scalar(8) / Scalar(3);
+	dydt[0] = sigma * (y[1] - y[0]);
+	dydt[1] = y[0] * (rho - y[2]) - y[1];
+	dydt[2] = y[0] * y[1] - beta * y[2];
+};
+
 int main()
 try {
+	using namespace sw::universal;
+	using namespace sw::universal::blas;
 
 	std::cout << "Time-Precision Trade-off for Lyaponov exponent\n";
 
-    
+	// all precisions integrate the same trajectory in lockstep, the double-double lane is the reference
+	using Precisions = std::tuple<
+		dd,
+		double, float,
+		cfloat<64, 11, uint32_t, true, false, false>, cfloat<32, 8, uint32_t, true, false, false>, cfloat<16, 5, uint16_t, true, false, false>,
+		posit<64, 3>, posit<32, 2>, posit<16, 1>
+	>;
+	std::vector<double> y0{ 0.0, 1.0, 0.0 };
+	double h = 0.01;
+	size_t steps = 5000, sampleInterval = 10;
+	auto report = ensemble_integrate(Precisions(), butcher_tableau::rk4(), lorenz, y0, 0.0, h, steps, sampleInterval);
+
+	// the reliable computation time Tc: the trajectory stays within 1.0 of the reference, about 5% of the attractor size
+	constexpr double threshold = 1.0;
+	std::cout << "RK4, h = " << h << ", reliable computation time Tc against " << report.lanes[0].type << '\n';
+	for (size_t l = 1; l < report.lanes.size(); ++l) {
+		const auto& lane = report.lanes[l];
+		size_t s = 0;
+		while (s < lane.divergence.size() && !(lane.divergence[s] > threshold)) ++s;
+		std::cout << std::setw(40) << lane.type << " : Tc = ";
+		if (s < lane.divergence.size()) std::cout << std::setw(6) << report.time[s]; else std::cout << " > " << std::setw(3) << report.time.back();
+		std::cout << "   integration time " << lane.seconds << " sec";
+		if (!lane.error.empty()) std::cout << "   stopped: " << lane.error;
+		std::cout << '\n';
+	}
+
 	return EXIT_SUCCESS;
 }
 catch (char const* msg) {
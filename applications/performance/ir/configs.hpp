@@ -62,7 +62,7 @@
     constexpr bool printLU        = false;
     constexpr bool printPA        = false;
     constexpr bool printPerm      = false;
-    constexpr bool showCondest    = false; // bug if true in condest.hpp.
+    constexpr bool showCondest    = true;  // Hager-Higham estimate of kappa_1(A)
     constexpr bool showCond       = true;
     constexpr bool showAmax       = true;  // Maximum element of A
     constexpr bool showSize       = true;  // Size of A
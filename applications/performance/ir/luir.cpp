@@ -387,7 +387,6 @@ try {
     if constexpr (showAmax){std::cout << "(min(A), max(A)) = (" << minelement(A) << ", " << maxelement(A) << ")" << std::endl;}
     if constexpr (printMat){disp(A);} // std::cout << "A = \n" << A << std::endl;
     if constexpr (showCond){std::cout << "Condition Number = " << kappa(testMatrix) << std::endl;}
-    if constexpr (showCondest){std::cout << "Condition estimate: " << condest(A) << std::endl;}
     if constexpr (showSize){std::cout << "Size: (" << n << ", " << n  << ")" << std::endl;}
     /*
     if (isdd(A)){
@@ -447,6 +446,13 @@ try {
     plu(Al, P);
     Mw LU(Al);
     if constexpr (showProcesses){std::cout << "Complete!\n" << std::endl;}
+    if constexpr (showCondest){
+        // estimate kappa_1 of the squeezed matrix from the factors just computed: O(n^2) per estimate
+        sw::universal::blas::vector<size_t> piv(n);
+        for (size_t ii = 0; ii < n - 1; ++ii) piv(ii) = P(ii,1);
+        piv(n - 1) = n - 1;
+        std::cout << "Condition estimate (squeezed A): " << sw::universal::blas::condest1(LU, piv, WorkingPrecision(matnorm(A, 1))) << std::endl;
+    }
     if constexpr (printLU){
         std::cout << "LU = \n"; disp(LU); 
     }
@@ -7,8 +7,12 @@
 #include <math.h>
 #include <stdint.h>
 #include <iostream>
+#include <algorithm>
 #include <chrono>
 #include <cmath>
+#include <string>
+#include <thread>
+#include <vector>
 
 // Configure the fixpnt template environment
 // first: enable general or specialized fixed-point configurations
@@ -32,137 +36,57 @@
 #include <universal/number/posit/posit.hpp>
 
 #include <universal/verification/test_suite.hpp>
-#include <universal/benchmark/performance_runner.hpp>
+#include <universal/benchmark/stream.hpp>
 
-template<typename Scalar>
-void Copy(std::vector<Scalar>& c, const std::vector<Scalar>& a, size_t start, size_t end) {
-	for (size_t i = start; i < end; ++i) {
-		c[i] = a[i];
-	}
-}
+/*
+	usage: stream [elements [maximum number of threads]]
 
-template<typename Scalar>
-void Sum(std::vector<Scalar>& c, const std::vector<Scalar>& a, const std::vector<Scalar>& b, size_t start, size_t end) {
-	for (size_t i = start; i < end; ++i) {
-		c[i] = a[i] + b[i];
-	}
-}
+	Without arguments the regression levels below run. With arguments every number system runs the
+	STREAM kernels on arrays of the given number of elements, for 1, 2, 4, ... up to the maximum
+	number of threads, which defaults to all cores. Choose the arrays at least four times the size
+	of the last level cache to measure memory rather than cache bandwidth: the roofline table is
+	only reported for number systems whose arrays exceed the last level cache.
+*/
 
-template<typename Scalar>
-void Scale(std::vector<Scalar>& c, const Scalar& a, const std::vector<Scalar>& b, size_t start, size_t end) {
-	for (size_t i = start; i < end; ++i) {
-		c[i] = a * b[i];
-	}
+// thread counts 1, 2, 4, ..., maxThreads
+std::vector<unsigned> ThreadCounts(unsigned maxThreads) {
+	std::vector<unsigned> counts;
+	for (unsigned t = 1; t < maxThreads; t *= 2) counts.push_back(t);
+	counts.push_back(maxThreads);
+	return counts;
 }
 
-template<typename Scalar>
-void Triad(std::vector<Scalar>& c, const std::vector<Scalar>& a, const std::vector<Scalar>& b, size_t start, size_t end) {
-	constexpr double pi = 3.14159265358979323846;
-	Scalar alpha(static_cast<Scalar>(pi));
-	for (size_t i = start; i < end; ++i) {
-		c[i] = a[i] + alpha*b[i];
-	}
+// machine bandwidth: the best native double Triad rate with all threads, in bytes/s
+double MachineBandwidth(size_t elements, unsigned maxThreads, unsigned repetitions) {
+	sw::universal::stream_team team(maxThreads);
+	auto result = sw::universal::RunStream<double>(team, elements, repetitions);
+	return result.timing[static_cast<unsigned>(sw::universal::StreamKernel::Triad)].bandwidth();
 }
 
-void ClearCache() {
-	constexpr size_t SIZE = (1ull << 27); // 128MB element array of 8byte doubles = 1GB data set
-	std::vector<double> a(SIZE);
-	for (size_t i = 0; i < SIZE; ++i) {
-		a[i] = INFINITY;
-	}
-}
+// STREAM tables for each thread count, and the roofline position of the number system at the maximum thread count
+// when its arrays, and the double arrays of the bandwidth measurement, exceed the last level cache
 template<typename Scalar>
-void Reset(std::vector<Scalar>& v, Scalar resetValue) {
-	for (size_t i = 0; i < v.size(); ++i) {
-		v[i] = resetValue;
+int Stream(size_t elements, const std::vector<unsigned>& threadCounts, unsigned repetitions, double bandwidth, std::string& roofline) {
+	using namespace sw::universal;
+	int nrOfFailedTestCases = 0;
+	for (unsigned threads : threadCounts) {
+		stream_team team(threads);
+		StreamResult result = RunStream<Scalar>(team, elements, repetitions);
+		std::cout << ReportStream(result) << '\n';
+		if (!result.validates) ++nrOfFailedTestCases;
+		if (threads == threadCounts.back() && stream_exceeds_cache(elements, std::min(sizeof(Scalar), sizeof(double)))) roofline += ReportRoofline(result.numberSystem, result.bytesPerElement, StreamComputePeak<Scalar>(team), bandwidth);
 	}
+	return nrOfFailedTestCases;
 }
 
-// sweep vector operators for different vector sizes.
-// The sweep selected is defined by startSample and endSample
-// and read through vectors sizes defined by 2^startSample, 2^(startSample+1), ... 2^(endSample-1)
-template<typename Scalar>
-void Sweep(size_t startSample, size_t endSample) {   // 13, 28
-	using namespace std;
-	using namespace std::chrono;
-	constexpr double pi = 3.14159265358979323846;
-	Scalar alpha(static_cast<Scalar>(pi));
-
-	std::cout << "STREAM benchmark for Universal type : " << type_tag(alpha) << '\n';
-
-	// create storage
-	size_t leftShift = endSample;
-	size_t SIZE = (1ull << leftShift);
-	std::vector<Scalar> a(SIZE), b(SIZE), c(SIZE);
-	for (size_t i = 0; i < SIZE; ++i) {
-		a[i] = Scalar(1.0f);
-		b[i] = Scalar(0.5f);
-		c[i] = Scalar(0.0f);
-	}
-
-	// benchmark different vector sizes
-	for (size_t i = startSample; i < endSample; ++i) {
-		size_t start = 0;
-		size_t stop  = (1ull << i);
-		Reset(c, Scalar(0));
-		ClearCache();
-
-		steady_clock::time_point begin = steady_clock::now();
-		Copy(c, a, start, stop);
-		steady_clock::time_point end = steady_clock::now();
-		duration<double> time_span = duration_cast<duration<double>> (end - begin);
-		double elapsed_time = time_span.count();
-		size_t NR_OPS = (stop - start);
-		cout << setw(10) << NR_OPS << " copies per " << setw(15) << elapsed_time << "sec -> " << toPowerOfTen(double(NR_OPS) / elapsed_time) << "ops/sec" << endl;
-
-	}
-
-	for (size_t i = startSample; i < endSample; ++i) {
-		size_t start = 0;
-		size_t stop = (1ull << i);
-		Reset(c, Scalar(0));
-		ClearCache();
-
-		steady_clock::time_point begin = steady_clock::now();
-		Sum(c, a, b, start, stop);
-		steady_clock::time_point end = steady_clock::now();
-		duration<double> time_span = duration_cast<duration<double>> (end - begin);
-		double elapsed_time = time_span.count();
-		size_t NR_OPS = (stop - start);
-		cout << setw(10) << NR_OPS << " adds   per " << setw(15) << elapsed_time << "sec -> " << toPowerOfTen(double(NR_OPS) / elapsed_time) << "ops/sec" << endl;
-
+// the roofline table, or why there is none
+void ReportRooflineTable(const std::string& roofline) {
+	using namespace sw::universal;
+	if (roofline.empty()) {
+		std::cout << "no roofline: the arrays fit in the " << (stream_last_level_cache() >> 20) << "MB last level cache\n";
 	}
-
-	for (size_t i = startSample; i < endSample; ++i) {
-		size_t start = 0;
-		size_t stop = (1ull << i);
-		Reset(c, Scalar(0));
-		ClearCache();
-
-		steady_clock::time_point begin = steady_clock::now();
-		Scale(c, alpha, b, start, stop);
-		steady_clock::time_point end = steady_clock::now();
-		duration<double> time_span = duration_cast<duration<double>> (end - begin);
-		double elapsed_time = time_span.count();
-		size_t NR_OPS = (stop - start);
-		cout << setw(10) << NR_OPS << " muls   per " << setw(15) << elapsed_time << "sec -> " << toPowerOfTen(double(NR_OPS) / elapsed_time) << "ops/sec" << endl;
-
-	}
-
-	for (size_t i = startSample; i < endSample; ++i) {
-		size_t start = 0;
-		size_t stop = (1ull << i);
-		Reset(c, Scalar(0));
-		ClearCache();
-
-		steady_clock::time_point begin = steady_clock::now();
-		Triad(c, a, b, start, stop);
-		steady_clock::time_point end = steady_clock::now();
-		duration<double> time_span = duration_cast<duration<double>> (end - begin);
-		double elapsed_time = time_span.count();
-		size_t NR_OPS = (stop - start);
-		cout << setw(10) << NR_OPS << " triads per " << setw(15) << elapsed_time << "sec -> " << toPowerOfTen(double(NR_OPS) / elapsed_time) << "ops/sec" << endl;
-
+	else {
+		std::cout << ReportRooflineHeader() << roofline;
 	}
 }
 
@@ -182,7 +106,7 @@ void Sweep(size_t startSample, size_t endSample) {   // 13, 28
 #define REGRESSION_LEVEL_4 0
 #endif
 
-int main() 
+int main(int argc, char** argv)
 try {
 	using namespace sw::universal;
 
@@ -193,38 +117,91 @@ try {
 
 	ReportTestSuiteHeader(test_suite, reportTestCases);
 
-	size_t startSample = 11;
-	size_t endSample = 13;
+	unsigned maxThreads = std::max(1u, std::thread::hardware_concurrency());
+	std::string roofline;
+
+	if (argc > 1) {
+		size_t elements = size_t(std::stoull(argv[1]));
+		if (argc > 2) maxThreads = std::max(1u, unsigned(std::stoul(argv[2])));
+		auto threadCounts = ThreadCounts(maxThreads);
+		constexpr unsigned repetitions = 10;
+		double bandwidth = MachineBandwidth(elements, maxThreads, repetitions);
+		nrOfFailedTestCases += Stream< float >(elements, threadCounts, repetitions, bandwidth, roofline);
+		nrOfFailedTestCases += Stream< double >(elements, threadCounts, repetitions, bandwidth, roofline);
+		nrOfFailedTestCases += Stream< fixpnt<8, 4, Modulo, std::uint8_t> >(elements, threadCounts, repetitions, bandwidth, roofline);
+		nrOfFailedTestCases += Stream< fixpnt<32, 16, Modulo, std::uint32_t> >(elements, threadCounts, repetitions, bandwidth, roofline);
+		nrOfFailedTestCases += Stream< cfloat<16, 5, std::uint16_t, true, false, false> >(elements, threadCounts, repetitions, bandwidth, roofline);
+		nrOfFailedTestCases += Stream< cfloat<32, 8, std::uint32_t, true, false, false> >(elements, threadCounts, repetitions, bandwidth, roofline);
+		nrOfFailedTestCases += Stream< posit<16, 1> >(elements, threadCounts, repetitions, bandwidth, roofline);
+		nrOfFailedTestCases += Stream< posit<32, 2> >(elements, threadCounts, repetitions, bandwidth, roofline);
+		std::cout << "machine bandwidth (double Triad, " << maxThreads << " threads) : " << bandwidth * 1.0e-6 << " MB/s\n";
+		ReportRooflineTable(roofline);
+		ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+		return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+	}
+
 #if MANUAL_TESTING
-	Sweep<float>(startSample, endSample);
-	Sweep < fixpnt<8, 4> >(startSample, endSample);
+	{
+		auto threadCounts = ThreadCounts(maxThreads);
+		double bandwidth = MachineBandwidth(1ull << 20, maxThreads, 5);
+		nrOfFailedTestCases += Stream< float >(1ull << 20, threadCounts, 5, bandwidth, roofline);
+		nrOfFailedTestCases += Stream< fixpnt<8, 4> >(1ull << 20, threadCounts, 5, bandwidth, roofline);
+		ReportRooflineTable(roofline);
+	}
 
 	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
 	return EXIT_SUCCESS;   // ignore errors
 #else
 
 #if REGRESSION_LEVEL_1
-	startSample = 10;
-	endSample   = 11; // just one pass through the operators
-	Sweep< float >(startSample, endSample);
-	Sweep< double >(startSample, endSample);
-	Sweep< fixpnt<8, 4, Modulo, std::uint8_t> >(startSample, endSample);
-	Sweep< fixpnt<8, 4, Saturate, std::uint8_t> >(startSample, endSample);
-	Sweep< cfloat<32, 8, std::uint32_t, true, false, false> >(startSample, endSample);
+	{
+		// small arrays: a functional pass through the kernels, the team, and the validation
+		constexpr size_t elements = (1ull << 14);
+		constexpr unsigned repetitions = 3;
+		auto threadCounts = ThreadCounts(maxThreads);
+		double bandwidth = MachineBandwidth(elements, maxThreads, repetitions);
+		nrOfFailedTestCases += Stream< float >(elements, threadCounts, repetitions, bandwidth, roofline);
+		nrOfFailedTestCases += Stream< double >(elements, threadCounts, repetitions, bandwidth, roofline);
+		nrOfFailedTestCases += Stream< fixpnt<8, 4, Modulo, std::uint8_t> >(elements, threadCounts, repetitions, bandwidth, roofline);
+		nrOfFailedTestCases += Stream< fixpnt<8, 4, Saturate, std::uint8_t> >(elements, threadCounts, repetitions, bandwidth, roofline);
+		nrOfFailedTestCases += Stream< cfloat<32, 8, std::uint32_t, true, false, false> >(elements, threadCounts, repetitions, bandwidth, roofline);
+		nrOfFailedTestCases += Stream< posit<16, 1> >(elements, threadCounts, repetitions, bandwidth, roofline);
+	}
 #endif
 
 #if REGRESSION_LEVEL_2
-	Sweep<float>(12, 18);
+	{
+		constexpr size_t elements = (1ull << 20);
+		constexpr unsigned repetitions = 5;
+		auto threadCounts = ThreadCounts(maxThreads);
+		double bandwidth = MachineBandwidth(elements, maxThreads, repetitions);
+		nrOfFailedTestCases += Stream< float >(elements, threadCounts, repetitions, bandwidth, roofline);
+	}
 #endif
 
 #if REGRESSION_LEVEL_3
-	Sweep<float>(13, 22);
+	{
+		constexpr size_t elements = (1ull << 24);
+		constexpr unsigned repetitions = 10;
+		auto threadCounts = ThreadCounts(maxThreads);
+		double bandwidth = MachineBandwidth(elements, maxThreads, repetitions);
+		nrOfFailedTestCases += Stream< float >(elements, threadCounts, repetitions, bandwidth, roofline);
+		nrOfFailedTestCases += Stream< cfloat<32, 8, std::uint32_t, true, false, false> >(elements, threadCounts, repetitions, bandwidth, roofline);
+	}
 #endif
 
 #if REGRESSION_LEVEL_4
-	Sweep<float>(10, 28);
+	{
+		constexpr size_t elements = (1ull << 26);
+		constexpr unsigned repetitions = 10;
+		auto threadCounts = ThreadCounts(maxThreads);
+		double bandwidth = MachineBandwidth(elements, maxThreads, repetitions);
+		nrOfFailedTestCases += Stream< float >(elements, threadCounts, repetitions, bandwidth, roofline);
+		nrOfFailedTestCases += Stream< posit<32, 2> >(elements, threadCounts, repetitions, bandwidth, roofline);
+	}
 #endif
 
+	ReportRooflineTable(roofline);
 	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
 	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
 
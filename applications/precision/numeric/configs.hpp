@@ -47,7 +47,7 @@
      */
 
     constexpr bool print          = false;
-    constexpr bool showCondest    = false; // bug if true in condest.hpp.
+    constexpr bool showCondest    = false; // Hager-Higham estimate of kappa_1(A)
     constexpr bool showCond       = true;
     constexpr bool showAmax       = true;
     constexpr bool showSize       = true;
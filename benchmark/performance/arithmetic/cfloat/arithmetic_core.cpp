@@ -0,0 +1,129 @@
+// arithmetic_core.cpp : instructions per addition and multiplication of wide cfloats
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+// configure the cfloat arithmetic class
+#define CFLOAT_THROW_ARITHMETIC_EXCEPTION 0
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/benchmark/performance_counters.hpp>
+
+/*
+   The arithmetic core of cfloat transforms the operands into blocktriples, aligns and
+   combines their significants, and rounds the result back into the cfloat encoding.
+   For wide formats the cost is dominated by the limb loops of these steps, so the
+   operators are measured in instructions per operation, which is insensitive to the
+   clock frequency of the machine. Operands have random signs and scales spread over
+   a few binades, so that the additions exercise alignment and cancellation.
+*/
+
+namespace sw { namespace universal {
+
+	template<typename Scalar>
+	std::vector<Scalar> CoreOperands(size_t n, unsigned seed) {
+		std::mt19937_64 engine(seed);
+		std::uniform_real_distribution<double> dist(-1.0e3, 1.0e3);
+		std::vector<Scalar> data(n);
+		for (auto& v : data) {
+			v = Scalar(dist(engine));
+			// populate the fraction bits below double precision
+			v *= Scalar(1.0 + dist(engine) * 1.0e-12);
+		}
+		return data;
+	}
+
+	template<typename Scalar>
+	void CoreAdditionWorkload(size_t NR_OPS) {
+		constexpr size_t NR_OPERANDS = 1024;
+		static const std::vector<Scalar> a = CoreOperands<Scalar>(NR_OPERANDS, 1);
+		static const std::vector<Scalar> b = CoreOperands<Scalar>(NR_OPERANDS, 2);
+		std::vector<Scalar> c(NR_OPERANDS);
+		for (size_t i = 0; i < NR_OPS; ++i) {
+			size_t j = i % NR_OPERANDS;
+			c[j] = a[j] + b[(i + (i >> 10)) % NR_OPERANDS];
+		}
+		if (c[0] == Scalar(-1.0)) std::cout << "dummy case to fool the optimizer\n";
+	}
+
+	template<typename Scalar>
+	void CoreMultiplicationWorkload(size_t NR_OPS) {
+		constexpr size_t NR_OPERANDS = 1024;
+		static const std::vector<Scalar> a = CoreOperands<Scalar>(NR_OPERANDS, 1);
+		static const std::vector<Scalar> b = CoreOperands<Scalar>(NR_OPERANDS, 2);
+		std::vector<Scalar> c(NR_OPERANDS);
+		for (size_t i = 0; i < NR_OPS; ++i) {
+			size_t j = i % NR_OPERANDS;
+			c[j] = a[j] * b[(i + (i >> 10)) % NR_OPERANDS];
+		}
+		if (c[0] == Scalar(-1.0)) std::cout << "dummy case to fool the optimizer\n";
+	}
+
+}} // namespace sw::universal
+
+void TestArithmeticCore() {
+	using namespace sw::universal;
+	std::cout << "\ncfloat arithmetic core: instructions per operation\n";
+
+	using Single    = cfloat< 32,  8, std::uint32_t, true, false, false>;
+	using Double    = cfloat< 64, 11, std::uint32_t, true, false, false>;
+	using Quad      = cfloat<128, 15, std::uint32_t, true, false, false>;
+	using Octuple   = cfloat<256, 19, std::uint32_t, true, false, false>;
+
+	constexpr size_t NR_OPS = 100'000;
+	PerformanceCounterRunner("cfloat< 32, 8>  add  ", CoreAdditionWorkload< Single >, NR_OPS);
+	PerformanceCounterRunner("cfloat< 32, 8>  mul  ", CoreMultiplicationWorkload< Single >, NR_OPS);
+	PerformanceCounterRunner("cfloat< 64,11>  add  ", CoreAdditionWorkload< Double >, NR_OPS);
+	PerformanceCounterRunner("cfloat< 64,11>  mul  ", CoreMultiplicationWorkload< Double >, NR_OPS);
+	PerformanceCounterRunner("cfloat<128,15>  add  ", CoreAdditionWorkload< Quad >, NR_OPS);
+	PerformanceCounterRunner("cfloat<128,15>  mul  ", CoreMultiplicationWorkload< Quad >, NR_OPS);
+	PerformanceCounterRunner("cfloat<256,19>  add  ", CoreAdditionWorkload< Octuple >, NR_OPS / 10);
+	PerformanceCounterRunner("cfloat<256,19>  mul  ", CoreMultiplicationWorkload< Octuple >, NR_OPS / 10);
+}
+
+// conditional compilation
+#define MANUAL_TESTING 0
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string tag = "cfloat arithmetic core benchmarking";
+
+#if MANUAL_TESTING
+
+	PerformanceCounterRunner("cfloat<128,15>  mul  ", CoreMultiplicationWorkload< cfloat<128, 15, std::uint32_t, true, false, false> >, 100'000);
+
+	std::cout << "done" << std::endl;
+
+	return EXIT_SUCCESS;
+#else
+	std::cout << tag << std::endl;
+
+	TestArithmeticCore();
+
+	return EXIT_SUCCESS;
+
+#endif // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught exception: " << msg << '\n';
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::cfloat_arithmetic_exception& err) {
+	std::cerr << "Uncaught cfloat arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,129 @@
+// sqrt.cpp : latency of the native square root and reciprocal square root of cfloat
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+// configure the cfloat arithmetic class
+#define CFLOAT_THROW_ARITHMETIC_EXCEPTION 0
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/benchmark/performance_runner.hpp>
+
+/*
+   The square root is measured as a latency: every root depends on the previous one.
+   Repeated roots converge to 1, so the chain is reseeded from a table of operands
+   every 32 steps to keep the significants fully populated. The double round trip
+   is the path cfloat used before the native digit recurrence, and is only
+   correctly rounded up to single precision.
+*/
+
+namespace sw { namespace universal {
+
+	template<typename Scalar>
+	std::vector<Scalar> SqrtOperands(size_t n) {
+		std::mt19937_64 engine(42);
+		std::uniform_real_distribution<double> dist(1.0, 1.0e6);
+		std::vector<Scalar> data(n);
+		for (auto& v : data) v = Scalar(dist(engine));
+		return data;
+	}
+
+	template<typename Scalar>
+	void SqrtLatencyWorkload(size_t NR_OPS) {
+		constexpr size_t NR_OPERANDS = 1024;
+		std::vector<Scalar> data = SqrtOperands<Scalar>(NR_OPERANDS);
+		Scalar x{ 2.0 };
+		for (size_t i = 0; i < NR_OPS; ++i) {
+			x = ((i & 0x1F) == 0) ? data[(i >> 5) % NR_OPERANDS] : sqrt(x);
+		}
+		if (x == Scalar(-1.0)) std::cout << "dummy case to fool the optimizer\n";
+	}
+
+	template<typename Scalar>
+	void RsqrtLatencyWorkload(size_t NR_OPS) {
+		constexpr size_t NR_OPERANDS = 1024;
+		std::vector<Scalar> data = SqrtOperands<Scalar>(NR_OPERANDS);
+		Scalar x{ 2.0 };
+		for (size_t i = 0; i < NR_OPS; ++i) {
+			x = ((i & 0x1F) == 0) ? data[(i >> 5) % NR_OPERANDS] : rsqrt(x);
+		}
+		if (x == Scalar(-1.0)) std::cout << "dummy case to fool the optimizer\n";
+	}
+
+	// the double round trip that cfloat sqrt used before the native pipeline
+	template<typename Scalar>
+	void DoubleRoundTripWorkload(size_t NR_OPS) {
+		constexpr size_t NR_OPERANDS = 1024;
+		std::vector<Scalar> data = SqrtOperands<Scalar>(NR_OPERANDS);
+		Scalar x{ 2.0 };
+		for (size_t i = 0; i < NR_OPS; ++i) {
+			x = ((i & 0x1F) == 0) ? data[(i >> 5) % NR_OPERANDS] : Scalar(std::sqrt(double(x)));
+		}
+		if (x == Scalar(-1.0)) std::cout << "dummy case to fool the optimizer\n";
+	}
+
+}} // namespace sw::universal
+
+void TestSqrtLatency() {
+	using namespace sw::universal;
+	std::cout << "\ncfloat square root latency\n";
+
+	using Single = cfloat< 32,  8, std::uint32_t, true, false, false>;
+	using Double = cfloat< 64, 11, std::uint32_t, true, false, false>;
+	using Quad   = cfloat<128, 15, std::uint32_t, true, false, false>;
+
+	constexpr size_t NR_OPS = 100'000;
+	PerformanceRunner("cfloat<32,8>    sqrt        ", SqrtLatencyWorkload< Single >, NR_OPS);
+	PerformanceRunner("cfloat<32,8>    rsqrt       ", RsqrtLatencyWorkload< Single >, NR_OPS);
+	PerformanceRunner("cfloat<32,8>    via double  ", DoubleRoundTripWorkload< Single >, NR_OPS);
+
+	PerformanceRunner("cfloat<64,11>   sqrt        ", SqrtLatencyWorkload< Double >, NR_OPS);
+	PerformanceRunner("cfloat<64,11>   rsqrt       ", RsqrtLatencyWorkload< Double >, NR_OPS);
+	PerformanceRunner("cfloat<64,11>   via double  ", DoubleRoundTripWorkload< Double >, NR_OPS);
+
+	PerformanceRunner("cfloat<128,15>  sqrt        ", SqrtLatencyWorkload< Quad >, NR_OPS / 10);
+	PerformanceRunner("cfloat<128,15>  rsqrt       ", RsqrtLatencyWorkload< Quad >, NR_OPS / 10);
+}
+
+// conditional compilation
+#define MANUAL_TESTING 0
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string tag = "cfloat sqrt and rsqrt latency benchmarking";
+
+#if MANUAL_TESTING
+
+	PerformanceRunner("cfloat<64,11>   sqrt        ", SqrtLatencyWorkload< cfloat<64, 11, std::uint32_t, true, false, false> >, 100'000);
+
+	std::cout << "done" << std::endl;
+
+	return EXIT_SUCCESS;
+#else
+	std::cout << tag << std::endl;
+
+	TestSqrtLatency();
+
+	return EXIT_SUCCESS;
+
+#endif // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught exception: " << msg << '\n';
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << '\n';
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,88 @@
+// counters.cpp: per-operator hardware performance counters across number systems, emitted as CSV or JSON
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <fstream>
+#include <string>
+#include <vector>
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+#include <universal/number/posit/posit.hpp>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/fixpnt/fixpnt.hpp>
+#include <universal/number/lns/lns.hpp>
+#include <universal/performance/number_system.hpp>
+
+/*
+	usage: counters [csv|json|text] [output file]
+
+	Runs the operator workloads of the performance report under the Linux perf_event counters for
+	cycles, instructions, branches, branch misses, L1D and LLC misses. The CSV and JSON records are
+	keyed by number system and operator, so that successive releases can be diffed for IPC regressions.
+	Counters that the platform does not provide, such as the hardware events inside most virtual machines,
+	or when /proc/sys/kernel/perf_event_paranoid is above 2, are reported as empty/null.
+*/
+
+template<typename Scalar>
+void Measure(std::vector<sw::universal::PerformanceRecord>& records, unsigned operators = sw::universal::PerformanceOperators::all) {
+	Scalar number{};
+	sw::universal::GeneratePerformanceCounterReport(sw::universal::type_tag(number), number, records, operators);
+}
+
+int main(int argc, char** argv)
+try {
+	using namespace sw::universal;
+
+	std::string format = (argc > 1 ? argv[1] : "text");
+	std::vector<PerformanceRecord> records;
+
+	Measure< posit<8, 2> >(records);
+	Measure< posit<16, 2> >(records);
+	Measure< posit<32, 2> >(records);
+	Measure< posit<64, 2> >(records);
+	Measure< cfloat<16, 5, uint16_t, true, false, false> >(records);
+	Measure< cfloat<32, 8, uint32_t, true, false, false> >(records);
+	// the sqrt workload starts at 0 and the division workload divides 1 by 0..NR_TEST_CASES: for fixpnt these
+	// time the divide-by-zero and non-convergence diagnostics, and results that underflow to 0, so they are left out
+	constexpr unsigned fixpntOperators = PerformanceOperators::all & ~(PerformanceOperators::sqrt | PerformanceOperators::div);
+	Measure< fixpnt<32, 8, Modulo, uint32_t> >(records, fixpntOperators);
+	Measure< fixpnt<64, 32, Modulo, uint32_t> >(records, fixpntOperators);
+	Measure< lns<16, 8, uint16_t> >(records);
+
+	std::ofstream file;
+	if (argc > 2) file.open(argv[2]);
+	std::ostream& ostr = (argc > 2 ? file : std::cout);
+	if (format == "csv") {
+		WritePerformanceCsv(ostr, records);
+	}
+	else if (format == "json") {
+		WritePerformanceJson(ostr, records);
+	}
+	else {
+		ostr << ReportPerformance(records);
+	}
+
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << "Caught exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
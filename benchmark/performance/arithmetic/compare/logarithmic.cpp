@@ -0,0 +1,119 @@
+// logarithmic.cpp : addition throughput of the double-base and single-base logarithmic number systems against cfloat
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/lns/lns.hpp>
+#include <universal/number/dbns/dbns.hpp>
+#include <universal/benchmark/performance_runner.hpp>
+
+/*
+   Addition is the hard operator of a logarithmic number system: multiplication is an exponent add,
+   but a sum needs the correction log2(1 +/- r). dbns evaluates it natively, with lookup tables for
+   configurations of up to 12 bits, lns marshals through double. The operands are drawn uniformly from [-16, 16] so that all three
+   number systems add values of comparable magnitude.
+*/
+
+namespace sw { namespace universal {
+
+	template<typename Scalar>
+	std::vector<Scalar> LogarithmicOperands(size_t n) {
+		std::mt19937_64 engine(42);
+		std::uniform_real_distribution<double> dist(-16.0, 16.0);
+		std::vector<Scalar> data(n);
+		for (auto& v : data) v = Scalar(dist(engine));
+		return data;
+	}
+
+	template<typename Scalar>
+	void AdditionThroughputWorkload(size_t NR_OPS) {
+		constexpr size_t NR_OPERANDS = 1024;
+		std::vector<Scalar> data = LogarithmicOperands<Scalar>(NR_OPERANDS);
+		Scalar sum{ 0 };
+		for (size_t i = 0; i < NR_OPS; ++i) {
+			sum = data[i % NR_OPERANDS] + data[(i * 7 + 3) % NR_OPERANDS];
+			data[i % NR_OPERANDS] = sum;
+		}
+		if (sum == Scalar(-1.0e10)) std::cout << "dummy case to fool the optimizer\n";
+	}
+
+	// the double round trip that dbns addition used before the native engine
+	template<typename DbnsType>
+	void DoubleRoundTripWorkload(size_t NR_OPS) {
+		constexpr size_t NR_OPERANDS = 1024;
+		std::vector<DbnsType> data = LogarithmicOperands<DbnsType>(NR_OPERANDS);
+		DbnsType sum{ 0 };
+		for (size_t i = 0; i < NR_OPS; ++i) {
+			sum = double(data[i % NR_OPERANDS]) + double(data[(i * 7 + 3) % NR_OPERANDS]);
+			data[i % NR_OPERANDS] = sum;
+		}
+		if (sum == DbnsType(-1.0e10)) std::cout << "dummy case to fool the optimizer\n";
+	}
+
+}} // namespace sw::universal
+
+void TestLogarithmicAdditionPerformance() {
+	using namespace sw::universal;
+	std::cout << "\nlogarithmic number system addition performance\n";
+
+	constexpr size_t NR_OPS = 1'000'000;
+	PerformanceRunner("dbns<8,3>     native add ", AdditionThroughputWorkload< dbns<8, 3> >, NR_OPS);
+	PerformanceRunner("dbns<8,3>     via double ", DoubleRoundTripWorkload< dbns<8, 3> >, NR_OPS);
+	PerformanceRunner("lns<8,3>      add        ", AdditionThroughputWorkload< lns<8, 3> >, NR_OPS / 10);
+	PerformanceRunner("cfloat<8,2>   add        ", AdditionThroughputWorkload< cfloat<8, 2, std::uint8_t, true, false, false> >, NR_OPS);
+
+	PerformanceRunner("dbns<12,4>    native add ", AdditionThroughputWorkload< dbns<12, 4, std::uint16_t> >, NR_OPS);
+	PerformanceRunner("dbns<12,4>    via double ", DoubleRoundTripWorkload< dbns<12, 4, std::uint16_t> >, NR_OPS);
+	PerformanceRunner("lns<12,6>     add        ", AdditionThroughputWorkload< lns<12, 6, std::uint16_t> >, NR_OPS / 10);
+	PerformanceRunner("cfloat<12,4>  add        ", AdditionThroughputWorkload< cfloat<12, 4, std::uint16_t, true, false, false> >, NR_OPS);
+
+	PerformanceRunner("dbns<16,5>    native add ", AdditionThroughputWorkload< dbns<16, 5, std::uint16_t> >, NR_OPS);
+	PerformanceRunner("dbns<16,5>    via double ", DoubleRoundTripWorkload< dbns<16, 5, std::uint16_t> >, NR_OPS / 10);
+	PerformanceRunner("lns<16,8>     add        ", AdditionThroughputWorkload< lns<16, 8, std::uint16_t> >, NR_OPS / 10);
+	PerformanceRunner("cfloat<16,5>  add        ", AdditionThroughputWorkload< cfloat<16, 5, std::uint16_t, true, false, false> >, NR_OPS);
+}
+
+// conditional compilation
+#define MANUAL_TESTING 0
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string tag = "Logarithmic number system addition benchmarking";
+
+#if MANUAL_TESTING
+
+	PerformanceRunner("dbns<12,4>    native add ", AdditionThroughputWorkload< dbns<12, 4, std::uint16_t> >, 1'000'000);
+
+	std::cout << "done" << std::endl;
+
+	return EXIT_SUCCESS;
+#else
+	std::cout << tag << std::endl;
+
+	TestLogarithmicAdditionPerformance();
+
+	return EXIT_SUCCESS;
+
+#endif // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught exception: " << msg << '\n';
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << '\n';
+	return EXIT_FAILURE;
+}
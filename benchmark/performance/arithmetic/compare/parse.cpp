@@ -0,0 +1,124 @@
+// parse.cpp: throughput of the correctly rounded decimal parser against marshalling through native double
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+#include <universal/number/posit/posit.hpp>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/fixpnt/fixpnt.hpp>
+
+/*
+	usage: parse [nrValues]
+
+	Parses a text of shortest round-trip decimals of random encodings three ways:
+	  parse_array : the bulk decimal parser, correctly rounded for any number of digits
+	  strtod      : std::strtod followed by the assignment from double, which double rounds
+	  istream     : operator>> of a double from a std::istringstream, the previous istream path
+	and reports the time per value in nanoseconds.
+*/
+
+template<typename Function>
+double NanosecondsPerValue(Function f, size_t nrValues) {
+	using namespace std::chrono;
+	// take the best of a few runs to remove the warm-up
+	double best = 1.0e300;
+	for (int run = 0; run < 3; ++run) {
+		steady_clock::time_point begin = steady_clock::now();
+		size_t n = f();
+		steady_clock::time_point end = steady_clock::now();
+		if (n != nrValues) std::cerr << "parsed " << n << " values instead of " << nrValues << '\n';
+		double elapsed = duration_cast<duration<double, std::nano>>(end - begin).count() / static_cast<double>(nrValues);
+		if (elapsed < best) best = elapsed;
+	}
+	return best;
+}
+
+template<typename Number>
+void Measure(size_t nrValues) {
+	using namespace sw::universal;
+	std::mt19937_64 engine(Number::nbits);
+	std::string text;
+	char buffer[128];
+	for (size_t i = 0; i < nrValues; ++i) {
+		Number v{};
+		do { v.setbits(engine()); } while (!std::isfinite(double(v)));
+		std::to_chars_result r = to_chars(buffer, buffer + sizeof(buffer), v);
+		text.append(buffer, r.ptr);
+		text += ' ';
+	}
+
+	std::vector<Number> values(nrValues);
+	double bulk = NanosecondsPerValue([&]() {
+		return parse_array(text.data(), text.data() + text.size(), values.data(), values.size());
+	}, nrValues);
+	double native = NanosecondsPerValue([&]() {
+		const char* p = text.c_str();
+		size_t n = 0;
+		for (char* end = nullptr; n < nrValues; ++n, p = end) {
+			values[n] = std::strtod(p, &end);
+			if (end == p) break;
+		}
+		return n;
+	}, nrValues);
+	double stream = NanosecondsPerValue([&]() {
+		std::istringstream istr(text);
+		size_t n = 0;
+		for (double d; n < nrValues && (istr >> d); ++n) values[n] = d;
+		return n;
+	}, nrValues);
+
+	std::cout << std::setw(70) << std::left << type_tag(Number{}) << std::right << std::fixed << std::setprecision(1)
+		<< std::setw(14) << bulk << std::setw(14) << native << std::setw(14) << stream << '\n';
+}
+
+int main(int argc, char** argv)
+try {
+	using namespace sw::universal;
+
+	size_t nrValues = (argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 100'000);
+
+	std::cout << "decimal parser throughput in ns/value for " << nrValues << " values\n";
+	std::cout << std::setw(70) << std::left << "number system" << std::right
+		<< std::setw(14) << "parse_array" << std::setw(14) << "strtod" << std::setw(14) << "istream" << '\n';
+	Measure< cfloat<16, 5, uint16_t, true, false, false> >(nrValues);
+	Measure< cfloat<32, 8, uint32_t, true, false, false> >(nrValues);
+	Measure< cfloat<64, 11, uint32_t, true, false, false> >(nrValues);
+	Measure< posit<16, 1> >(nrValues);
+	Measure< posit<32, 2> >(nrValues);
+	Measure< posit<64, 3> >(nrValues);
+	Measure< fixpnt<32, 16, Modulo, uint32_t> >(nrValues);
+	Measure< fixpnt<64, 32, Modulo, uint32_t> >(nrValues);
+
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << "Caught exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,101 @@
+// sweep.cpp: type-list driven performance sweep across number systems with a JSON regression check
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <fstream>
+#include <string>
+#include <tuple>
+#include <vector>
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+#include <universal/number/posit/posit.hpp>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/fixpnt/fixpnt.hpp>
+#include <universal/number/lns/lns.hpp>
+#include <universal/number/dd/dd.hpp>
+#include <universal/benchmark/performance_sweep.hpp>
+
+/*
+	usage: sweep [text|json] [output file]
+	       sweep compare baseline.json current.json [tolerance]
+
+	Measures the add/sub, mul and div workloads for every number system in the Types list below,
+	with median and MAD over repeated runs. Save the JSON of two commits and compare them to list
+	the (number system, workload) pairs that slowed down by more than the tolerance, default 5%.
+	The compare mode returns EXIT_FAILURE when it finds a regression, so it can gate a CI job.
+*/
+
+using namespace sw::universal;
+
+// add a number system to the sweep here
+using Types = std::tuple<
+	float, double,
+	cfloat<16, 5, uint16_t, true, false, false>, cfloat<32, 8, uint32_t, true, false, false>, cfloat<64, 11, uint32_t, true, false, false>,
+	posit<8, 2>, posit<16, 2>, posit<32, 2>, posit<64, 2>,
+	fixpnt<32, 16, Modulo, uint32_t>,
+	lns<16, 8, uint16_t>,
+	dd
+>;
+
+int main(int argc, char** argv)
+try {
+	std::string mode = (argc > 1 ? argv[1] : "text");
+
+	if (mode == "compare") {
+		if (argc < 4) {
+			std::cerr << "usage: sweep compare baseline.json current.json [tolerance]\n";
+			return EXIT_FAILURE;
+		}
+		std::ifstream baselineFile(argv[2]), currentFile(argv[3]);
+		if (!baselineFile || !currentFile) {
+			std::cerr << "unable to open " << (baselineFile ? argv[3] : argv[2]) << '\n';
+			return EXIT_FAILURE;
+		}
+		double tolerance = (argc > 4 ? std::stod(argv[4]) : 0.05);
+		auto regressions = CompareSweeps(ReadSweepJson(baselineFile), ReadSweepJson(currentFile), tolerance);
+		for (const auto& r : regressions) {
+			std::cout << std::setw(45) << std::left << r.numberSystem << std::setw(12) << r.workload << std::right
+				<< to_scientific(r.baselinePops) << " -> " << to_scientific(r.currentPops) << " POPS ("
+				<< std::setprecision(3) << 100.0 * (r.ratio() - 1.0) << "%)\n";
+		}
+		std::cout << regressions.size() << " performance regressions\n";
+		return (regressions.empty() ? EXIT_SUCCESS : EXIT_FAILURE);
+	}
+
+	SweepConfiguration config;
+	auto records = PerformanceSweep<Types>(config, AdditionSubtraction{}, Multiplication{}, Division{});
+
+	std::ofstream file;
+	if (argc > 2) file.open(argv[2]);
+	std::ostream& ostr = (argc > 2 ? file : std::cout);
+	if (mode == "json") {
+		WriteSweepJson(ostr, records);
+	}
+	else {
+		ostr << ReportSweep(records);
+	}
+
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << "Caught exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
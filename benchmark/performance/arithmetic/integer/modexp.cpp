@@ -0,0 +1,136 @@
+//  modexp.cpp : modular exponentiation throughput for fixed-sized, arbitrary precision integers
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <iostream>
+#include <string>
+#include <random>
+// configure the integer arithmetic class
+#define INTEGER_THROW_ARITHMETIC_EXCEPTION 0
+#include <universal/number/integer/integer.hpp>
+#include <universal/benchmark/performance_runner.hpp>
+
+/*
+   RSA-style modular exponentiation: a full width odd modulus, base, and exponent.
+   The reference reduces every product with the remainder operator on a double-width integer,
+   the Barrett and Montgomery variants replace that division with multiplications,
+   and all three ride on the Karatsuba product for the wider configurations.
+*/
+
+namespace sw { namespace universal {
+
+	// an odd, full width, positive operand
+	template<typename Integer>
+	Integer ModexpOperand(std::uint64_t seed) {
+		using BlockType = typename Integer::BlockType;
+		std::mt19937_64 engine(seed);
+		Integer a{};
+		for (unsigned i = 0; i < Integer::nrBlocks; ++i) a.setblock(i, static_cast<BlockType>(engine()));
+		a.setbit(Integer::nbits - 1, false);
+		a.setbit(Integer::nbits - 2, true);
+		a.setbit(0, true);
+		return a;
+	}
+
+	// square-and-multiply with a double-width product and the remainder operator
+	template<typename Integer>
+	void RemainderModexpWorkload(size_t NR_OPS) {
+		using Wide = integer<2 * Integer::nbits, typename Integer::BlockType>;
+		Integer N = ModexpOperand<Integer>(1), base = ModexpOperand<Integer>(2), exponent = ModexpOperand<Integer>(3);
+		Wide wN(N), x(base), r;
+		for (size_t n = 0; n < NR_OPS; ++n) {
+			r = 1;
+			for (int i = findMsb(exponent); i >= 0; --i) {
+				r = (r * r) % wN;
+				if (exponent.test(static_cast<unsigned>(i))) r = (r * x) % wN;
+			}
+			x = r;
+		}
+		if (r.iszero()) std::cout << "dummy case to fool the optimizer\n";
+	}
+
+	template<typename Integer>
+	void BarrettModexpWorkload(size_t NR_OPS) {
+		Integer N = ModexpOperand<Integer>(1), x = ModexpOperand<Integer>(2), exponent = ModexpOperand<Integer>(3);
+		barrett<Integer> reduction(N);
+		for (size_t n = 0; n < NR_OPS; ++n) x = reduction.modexp(x, exponent);
+		if (x.iszero()) std::cout << "dummy case to fool the optimizer\n";
+	}
+
+	template<typename Integer>
+	void MontgomeryModexpWorkload(size_t NR_OPS) {
+		Integer N = ModexpOperand<Integer>(1), x = ModexpOperand<Integer>(2), exponent = ModexpOperand<Integer>(3);
+		montgomery<Integer> reduction(N);
+		for (size_t n = 0; n < NR_OPS; ++n) x = reduction.modexp(x, exponent);
+		if (x.iszero()) std::cout << "dummy case to fool the optimizer\n";
+	}
+
+}} // namespace sw::universal
+
+// measure modexp throughput at RSA key sizes
+void TestModexpPerformance() {
+	using namespace sw::universal;
+	std::cout << "\nINTEGER modular exponentiation performance\n";
+
+	PerformanceRunner("integer<1024, uint32_t> remainder  ", RemainderModexpWorkload < integer<1024, std::uint32_t> >, 4);
+	PerformanceRunner("integer<1024, uint32_t> barrett    ", BarrettModexpWorkload   < integer<1024, std::uint32_t> >, 16);
+	PerformanceRunner("integer<1024, uint32_t> montgomery ", MontgomeryModexpWorkload< integer<1024, std::uint32_t> >, 16);
+	PerformanceRunner("integer<1024, uint64_t> remainder  ", RemainderModexpWorkload < integer<1024, std::uint64_t> >, 4);
+	PerformanceRunner("integer<1024, uint64_t> barrett    ", BarrettModexpWorkload   < integer<1024, std::uint64_t> >, 32);
+	PerformanceRunner("integer<1024, uint64_t> montgomery ", MontgomeryModexpWorkload< integer<1024, std::uint64_t> >, 32);
+
+	PerformanceRunner("integer<2048, uint32_t> remainder  ", RemainderModexpWorkload < integer<2048, std::uint32_t> >, 1);
+	PerformanceRunner("integer<2048, uint32_t> barrett    ", BarrettModexpWorkload   < integer<2048, std::uint32_t> >, 4);
+	PerformanceRunner("integer<2048, uint32_t> montgomery ", MontgomeryModexpWorkload< integer<2048, std::uint32_t> >, 4);
+	PerformanceRunner("integer<2048, uint64_t> remainder  ", RemainderModexpWorkload < integer<2048, std::uint64_t> >, 1);
+	PerformanceRunner("integer<2048, uint64_t> barrett    ", BarrettModexpWorkload   < integer<2048, std::uint64_t> >, 8);
+	PerformanceRunner("integer<2048, uint64_t> montgomery ", MontgomeryModexpWorkload< integer<2048, std::uint64_t> >, 8);
+
+	PerformanceRunner("integer<4096, uint32_t> remainder  ", RemainderModexpWorkload < integer<4096, std::uint32_t> >, 1);
+	PerformanceRunner("integer<4096, uint32_t> barrett    ", BarrettModexpWorkload   < integer<4096, std::uint32_t> >, 1);
+	PerformanceRunner("integer<4096, uint32_t> montgomery ", MontgomeryModexpWorkload< integer<4096, std::uint32_t> >, 1);
+	PerformanceRunner("integer<4096, uint64_t> remainder  ", RemainderModexpWorkload < integer<4096, std::uint64_t> >, 1);
+	PerformanceRunner("integer<4096, uint64_t> barrett    ", BarrettModexpWorkload   < integer<4096, std::uint64_t> >, 2);
+	PerformanceRunner("integer<4096, uint64_t> montgomery ", MontgomeryModexpWorkload< integer<4096, std::uint64_t> >, 2);
+}
+
+// conditional compilation
+#define MANUAL_TESTING 0
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string tag = "Integer modular exponentiation benchmarking";
+
+#if MANUAL_TESTING
+
+	PerformanceRunner("integer<1024, uint64_t> montgomery ", MontgomeryModexpWorkload< integer<1024, std::uint64_t> >, 32);
+
+	std::cout << "done" << std::endl;
+
+	return EXIT_SUCCESS;
+#else
+	std::cout << tag << std::endl;
+
+	TestModexpPerformance();
+
+	return EXIT_SUCCESS;
+
+#endif // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught exception: " << msg << '\n';
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << '\n';
+	return EXIT_FAILURE;
+}
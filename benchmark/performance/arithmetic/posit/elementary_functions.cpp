@@ -0,0 +1,147 @@
+// elementary_functions.cpp: latency and accuracy of the correctly rounded posit elementary functions
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+// second: disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+#include <universal/number/posit/posit.hpp>
+
+namespace sw { namespace universal {
+
+	// number of units in the last place between a posit and the correctly rounded reference
+	template<unsigned nbits, unsigned es>
+	double UlpDistance(const posit<nbits, es>& p, const posit<nbits, es>& reference) {
+		if (p == reference) return 0.0;
+		if (p.isnar() || reference.isnar()) return std::numeric_limits<double>::infinity();
+		// the ulp of the reference is set by the fraction bits that remain after its regime and exponent
+		int scale = reference.to_value().scale();
+		int k = (scale >= 0 ? (scale >> es) : -((-scale + (1 << es) - 1) >> es));
+		int regimeLength = (k >= 0 ? k + 2 : -k + 1);
+		int fbits = std::max(0, static_cast<int>(nbits) - 1 - regimeLength - static_cast<int>(es));
+		posit<nbits, es> difference = p - reference;
+		return std::fabs(double(difference)) / std::ldexp(std::fabs(double(reference)), -fbits);
+	}
+
+	// the double precision shims the native functions replace
+	template<unsigned nbits, unsigned es>
+	posit<nbits, es> Shim(const std::string& function, const posit<nbits, es>& x) {
+		double d = double(x);
+		if (function == "exp")  return posit<nbits, es>(std::exp(d));
+		if (function == "exp2") return posit<nbits, es>(std::exp2(d));
+		if (function == "log")  return posit<nbits, es>(std::log(d));
+		if (function == "log2") return posit<nbits, es>(std::log2(d));
+		if (function == "sin")  return posit<nbits, es>(std::sin(d));
+		if (function == "cos")  return posit<nbits, es>(std::cos(d));
+		if (function == "tan")  return posit<nbits, es>(std::tan(d));
+		if (function == "pow")  return posit<nbits, es>(std::pow(d, 1.0 / 3.0));
+		return posit<nbits, es>(SpecificValue::nar);
+	}
+
+	template<unsigned nbits, unsigned es>
+	posit<nbits, es> Native(const std::string& function, const posit<nbits, es>& x) {
+		if (function == "exp")  return exp(x);
+		if (function == "exp2") return exp2(x);
+		if (function == "log")  return log(x);
+		if (function == "log2") return log2(x);
+		if (function == "sin")  return sin(x);
+		if (function == "cos")  return cos(x);
+		if (function == "tan")  return tan(x);
+		if (function == "pow")  return pow(x, 1.0 / 3.0);
+		return posit<nbits, es>(SpecificValue::nar);
+	}
+
+	// measure the latency of the native and shim implementations, and the ulp error of the shim
+	template<unsigned nbits, unsigned es>
+	void ElementaryFunctionReport(size_t nrSamples) {
+		using Posit = posit<nbits, es>;
+		std::mt19937_64 engine(nbits);
+		std::uniform_real_distribution<double> arguments(-20.0, 20.0);
+		std::vector<Posit> x(nrSamples);
+		for (auto& v : x) {
+			// a double cannot enumerate the fraction bits of the wider posits: fill them in with a random ulp offset
+			v = arguments(engine);
+			for (int i = static_cast<int>(engine() % 64); i > 0; --i) ++v;
+		}
+
+		std::cout << type_tag(Posit()) << '\n';
+		std::cout << "  function     native latency       shim latency    shim max ulp   shim incorrect\n";
+		for (std::string function : { "exp", "exp2", "log", "log2", "sin", "cos", "tan", "pow" }) {
+			std::vector<Posit> native(nrSamples), shim(nrSamples);
+			std::vector<Posit> argument(x);
+			if (function == "log" || function == "log2" || function == "pow") for (auto& v : argument) v = abs(v);
+
+			auto begin = std::chrono::steady_clock::now();
+			for (size_t i = 0; i < nrSamples; ++i) native[i] = Native(function, argument[i]);
+			auto end = std::chrono::steady_clock::now();
+			double nativeLatency = std::chrono::duration<double, std::micro>(end - begin).count() / nrSamples;
+
+			begin = std::chrono::steady_clock::now();
+			for (size_t i = 0; i < nrSamples; ++i) shim[i] = Shim(function, argument[i]);
+			end = std::chrono::steady_clock::now();
+			double shimLatency = std::chrono::duration<double, std::micro>(end - begin).count() / nrSamples;
+
+			double maxUlp{ 0.0 };
+			size_t incorrect{ 0 };
+			for (size_t i = 0; i < nrSamples; ++i) {
+				if (shim[i] != native[i]) ++incorrect;
+				maxUlp = std::max(maxUlp, UlpDistance(shim[i], native[i]));
+			}
+			std::cout << std::setw(10) << function
+				<< std::setw(15) << std::fixed << std::setprecision(3) << nativeLatency << " usec"
+				<< std::setw(14) << shimLatency << " usec"
+				<< std::setw(16) << std::scientific << std::setprecision(2) << maxUlp
+				<< std::setw(12) << incorrect << " / " << nrSamples << std::defaultfloat << '\n';
+		}
+		std::cout << '\n';
+	}
+
+}} // namespace sw::universal
+
+int main(int argc, char** argv)
+try {
+	using namespace sw::universal;
+
+	// optional command line argument: number of samples per function
+	size_t nrSamples = 1000;
+	if (argc > 1) nrSamples = std::stoul(argv[1]);
+
+	std::cout << "correctly rounded posit elementary functions versus double precision shims\n";
+	std::cout << "POSIT_NATIVE_ELEMENTARY_FUNCTIONS     : " << POSIT_NATIVE_ELEMENTARY_FUNCTIONS << '\n';
+	std::cout << "POSIT_ELEMENTARY_FUNCTION_TABLE_NBITS : " << POSIT_ELEMENTARY_FUNCTION_TABLE_NBITS << "\n\n";
+
+	ElementaryFunctionReport<32, 2>(nrSamples);
+	ElementaryFunctionReport<64, 3>(nrSamples);
+	ElementaryFunctionReport<128, 4>(nrSamples / 10);
+
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << "Caught exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
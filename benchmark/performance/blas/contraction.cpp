@@ -0,0 +1,84 @@
+// contraction.cpp: performance of the blocked einsum contraction versus the triple loop of the matrix product
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <chrono>
+#include <random>
+#include <string>
+#include <universal/blas/blas.hpp>
+
+namespace sw { namespace universal {
+
+	template<typename Function>
+	double Time(Function&& f) {
+		auto begin = std::chrono::steady_clock::now();
+		f();
+		auto end = std::chrono::steady_clock::now();
+		return std::chrono::duration<double>(end - begin).count();
+	}
+
+	template<typename Scalar>
+	void ContractionPerformance(size_t N) {
+		std::mt19937_64 engine(N);
+		std::uniform_real_distribution<double> dist(-1.0, 1.0);
+		blas::matrix<Scalar> Am(N, N), Bm(N, N), Cm;
+		blas::tensor<Scalar, 2> A(N, N), B(N, N), C;
+		for (size_t i = 0; i < N; ++i) {
+			for (size_t j = 0; j < N; ++j) {
+				A(i, j) = Am(i, j) = Scalar(dist(engine));
+				B(i, j) = Bm(i, j) = Scalar(dist(engine));
+			}
+		}
+		double flops = 2.0 * double(N) * double(N) * double(N);
+		double tMatrix = Time([&]() { Cm = Am * Bm; });
+		double tEinsum = Time([&]() { C = blas::einsum<2>("ik,kj->ij", A, B); });
+		// the same product with B supplied as a transposed view: no copy is made
+		blas::tensor<Scalar, 2> Bt(B.transpose());
+		double tTransposed = Time([&]() { C = blas::einsum<2>("ik,jk->ij", A, Bt); });
+		double tWide = Time([&]() { C = blas::einsum<2>("ik,kj->ij", A, B, blas::Accumulation::Wide); });
+		std::cout << std::setw(8) << N << std::setprecision(3)
+			<< std::setw(14) << flops / tMatrix * 1.0e-6
+			<< std::setw(14) << flops / tEinsum * 1.0e-6
+			<< std::setw(14) << flops / tTransposed * 1.0e-6
+			<< std::setw(14) << flops / tWide * 1.0e-6 << '\n';
+	}
+
+}} // namespace sw::universal
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::cout << "matrix product C = A * B in MFLOPS\n";
+	for (std::string type : { "float", "double" }) {
+		std::cout << type << '\n';
+		std::cout << std::setw(8) << "N" << std::setw(14) << "matrix" << std::setw(14) << "einsum" << std::setw(14) << "einsum B^T" << std::setw(14) << "wide" << '\n';
+		for (size_t N : { 64, 128, 256, 512 }) {
+			if (type == "float") ContractionPerformance<float>(N); else ContractionPerformance<double>(N);
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << "Caught exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
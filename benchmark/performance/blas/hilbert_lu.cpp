@@ -0,0 +1,115 @@
+// hilbert_lu.cpp: performance measurement of exact LU decomposition of Hilbert matrices with adaptive precision rationals
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <chrono>
+// defer the gcd reduction of the rationals until their limb count crosses the threshold
+#ifndef ERATIONAL_DEFERRED_REDUCTION
+#define ERATIONAL_DEFERRED_REDUCTION 1
+#endif
+#include <universal/number/erational/erational.hpp>
+#include <universal/blas/blas.hpp>
+#include <universal/blas/generators.hpp>
+
+namespace sw { namespace universal {
+
+	// in-place Doolittle LU decomposition without pivoting: Hilbert matrices are symmetric positive definite
+	// bReduceEveryOp emulates the eager reduction policy by reducing every updated element
+	template<typename Scalar>
+	void ExactLU(blas::matrix<Scalar>& A, bool bReduceEveryOp) {
+		size_t N = num_rows(A);
+		for (size_t k = 0; k < N; ++k) {
+			for (size_t i = k + 1; i < N; ++i) {
+				A(i, k) /= A(k, k);
+				if (bReduceEveryOp) A(i, k).reduce();
+				for (size_t j = k + 1; j < N; ++j) {
+					A(i, j) -= A(i, k) * A(k, j);
+					if (bReduceEveryOp) A(i, j).reduce();
+				}
+			}
+		}
+	}
+
+	// det(H_n) = c_n^4 / c_2n with c_n = prod_{i=1}^{n-1} i!
+	erational HilbertDeterminant(size_t N) {
+		auto c = [](size_t n) {
+			edecimal product(1), factorial(1);
+			for (size_t i = 1; i < n; ++i) {
+				factorial *= edecimal(i);
+				product *= factorial;
+			}
+			return product;
+		};
+		edecimal cn = c(N);
+		erational det;
+		det.setnumerator(cn * cn * cn * cn);
+		det.setdenominator(c(2 * N));
+		return det.reduce();
+	}
+
+	// factor the Hilbert matrix of size N, report the elapsed time, and validate the product of the pivots
+	int HilbertLU(size_t N, bool bReduceEveryOp) {
+		using Scalar = erational;
+		blas::matrix<Scalar> H = blas::hilbert<Scalar>(N, false);
+
+		auto begin = std::chrono::steady_clock::now();
+		ExactLU(H, bReduceEveryOp);
+		auto end = std::chrono::steady_clock::now();
+		double elapsed = std::chrono::duration<double>(end - begin).count();
+
+		Scalar det(1);
+		for (size_t k = 0; k < N; ++k) det *= H(k, k);
+		bool valid = (det == HilbertDeterminant(N));
+		std::cout << std::setw(5) << N << std::setw(15) << (bReduceEveryOp ? "every op" : "deferred")
+			<< std::setw(15) << std::fixed << std::setprecision(4) << elapsed << " sec"
+			<< std::setw(12) << det.reduce().bottom().digits() << " digits"
+			<< (valid ? "    PASS" : "    FAIL") << std::defaultfloat << '\n';
+		return (valid ? 0 : 1);
+	}
+
+}} // namespace sw::universal
+
+int main(int argc, char** argv)
+try {
+	using namespace sw::universal;
+
+	// optional command line arguments: smallest and largest matrix size
+	size_t nmin = 20, nmax = 60;
+	if (argc > 1) nmin = std::stoul(argv[1]);
+	if (argc > 2) nmax = std::stoul(argv[2]);
+
+	std::cout << "exact LU decomposition of Hilbert matrices using erational\n";
+	std::cout << "ERATIONAL_DEFERRED_REDUCTION  : " << ERATIONAL_DEFERRED_REDUCTION << '\n';
+	std::cout << "ERATIONAL_REDUCTION_THRESHOLD : " << ERATIONAL_REDUCTION_THRESHOLD << " limbs\n";
+	std::cout << "    N      reduction        elapsed    det(H) denominator\n";
+
+	int nrOfFailedTestCases = 0;
+	for (size_t N = nmin; N <= nmax; N += 10) {
+		nrOfFailedTestCases += HilbertLU(N, true);
+		nrOfFailedTestCases += HilbertLU(N, false);
+	}
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << "Caught exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
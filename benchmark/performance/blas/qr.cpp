@@ -0,0 +1,87 @@
+// qr.cpp: performance of the blocked Householder QR factorization versus the column-at-a-time Householder QR
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <chrono>
+#include <random>
+#include <string>
+#include <universal/blas/blas.hpp>
+
+namespace sw { namespace universal {
+
+	template<typename Scalar>
+	blas::matrix<Scalar> RandomMatrix(size_t m, size_t n) {
+		std::mt19937_64 engine(m * n);
+		std::uniform_real_distribution<double> dist(-1.0, 1.0);
+		blas::matrix<Scalar> A(m, n);
+		for (size_t i = 0; i < m; ++i) for (size_t j = 0; j < n; ++j) A(i, j) = Scalar(dist(engine));
+		return A;
+	}
+
+	template<typename Scalar>
+	double BlockedQR(size_t m, size_t n, size_t nb) {
+		blas::matrix<Scalar> A = RandomMatrix<Scalar>(m, n);
+		blas::vector<Scalar> tau;
+		auto begin = std::chrono::steady_clock::now();
+		blas::geqrf(A, tau, nb);
+		auto end = std::chrono::steady_clock::now();
+		return std::chrono::duration<double>(end - begin).count();
+	}
+
+	template<typename Scalar>
+	double ColumnQR(size_t m, size_t n) {
+		blas::matrix<Scalar> A = RandomMatrix<Scalar>(m, n);
+		blas::matrix<Scalar> Q(m, m), R(A);
+		Q = Scalar(1);
+		auto begin = std::chrono::steady_clock::now();
+		blas::houseqr(A, Q, R);
+		auto end = std::chrono::steady_clock::now();
+		return std::chrono::duration<double>(end - begin).count();
+	}
+
+	template<typename Scalar>
+	void QRPerformance(size_t m, size_t n, bool compareColumnQR) {
+		std::cout << std::setw(8) << m << " x " << std::setw(4) << n << std::setprecision(3);
+		for (size_t nb : { 1, 8, 32 }) std::cout << std::setw(12) << BlockedQR<Scalar>(m, n, nb) << " sec";
+		if (compareColumnQR) std::cout << std::setw(12) << ColumnQR<Scalar>(m, n) << " sec";
+		std::cout << '\n';
+	}
+
+}} // namespace sw::universal
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::cout << "QR factorization of random double matrices\n";
+	std::cout << std::setw(15) << "size" << std::setw(16) << "geqrf nb=1" << std::setw(16) << "geqrf nb=8"
+		<< std::setw(16) << "geqrf nb=32" << std::setw(16) << "houseqr" << '\n';
+	QRPerformance<double>(200, 100, true);
+	QRPerformance<double>(500, 200, true);
+	QRPerformance<double>(1000, 1000, false);
+	QRPerformance<double>(100000, 50, false);
+
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << "Caught exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
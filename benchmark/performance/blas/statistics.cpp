@@ -0,0 +1,87 @@
+// statistics.cpp: performance of the single-pass summary statistics versus the two-pass, sort-based summary
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <string>
+#include <universal/blas/blas.hpp>
+#include <universal/blas/statistics.hpp>
+
+namespace sw { namespace universal {
+
+	// the summary as computed before: two passes for the moments, and a full sort of a copy for the quantiles
+	blas::SummaryStats<double> SortedSummary(const std::vector<double>& data) {
+		size_t N = data.size();
+		double sum{ 0 };
+		for (auto e : data) sum += e;
+		blas::SummaryStats<double> stats;
+		stats.mean = sum / double(N);
+		sum = 0.0;
+		for (auto e : data) sum += (e - stats.mean) * (e - stats.mean);
+		stats.stddev = std::sqrt(sum / double(N - 1));
+		std::vector<double> v(data);
+		std::sort(v.begin(), v.end());
+		stats.quantiles.set(v[0], v[N / 4], v[N / 2], v[(3 * N) / 4], v[N - 1]);
+		return stats;
+	}
+
+	template<typename Function>
+	double Time(Function&& f) {
+		auto begin = std::chrono::steady_clock::now();
+		f();
+		auto end = std::chrono::steady_clock::now();
+		return std::chrono::duration<double>(end - begin).count();
+	}
+
+	void StatisticsPerformance(size_t N) {
+		std::vector<double> data(N);
+		std::mt19937_64 engine(N);
+		std::normal_distribution<double> dist(0.0, 1.0);
+		for (auto& e : data) e = dist(engine);
+
+		blas::SummaryStats<double> sorted, exact, sketched;
+		double tSorted = Time([&]() { sorted = SortedSummary(data); });
+		double tExact = Time([&]() { exact = blas::summaryStatistics(data, blas::QuantileMethod::Exact); });
+		double tSketch = Time([&]() { sketched = blas::summaryStatistics(data); });
+		std::cout << std::setw(12) << N << std::setprecision(3)
+			<< std::setw(12) << tSorted << " sec" << std::setw(12) << tExact << " sec" << std::setw(12) << tSketch << " sec"
+			<< std::setw(14) << sketched.quantiles.q[2] - sorted.quantiles.q[2] << '\n';
+	}
+
+}} // namespace sw::universal
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::cout << "summary statistics of normally distributed samples\n";
+	std::cout << std::setw(12) << "samples" << std::setw(16) << "sort" << std::setw(16) << "nth_element"
+		<< std::setw(16) << "sketch k=200" << std::setw(14) << "median error" << '\n';
+	for (size_t N : { 10000, 1000000, 10000000 }) StatisticsPerformance(N);
+
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << "Caught exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,93 @@
+// svd.cpp: performance of the one-sided Jacobi singular value decomposition as a function of size and threads
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <chrono>
+#include <random>
+#include <string>
+#include <thread>
+#include <universal/number/posit/posit.hpp>
+#include <universal/blas/blas.hpp>
+
+namespace sw { namespace universal {
+
+	// seconds, sweeps, and the largest reconstruction error of the decomposition of a random N-by-N matrix
+	template<typename Scalar>
+	void JacobiSVDPerformance(size_t N, unsigned nrThreads, bool fused = false) {
+		std::mt19937_64 engine(N);
+		std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+		blas::matrix<Scalar> A(N, N), U, V;
+		for (size_t i = 0; i < N; ++i) for (size_t j = 0; j < N; ++j) A(i, j) = Scalar(distribution(engine));
+		blas::vector<Scalar> sigma;
+		blas::svd_options options;
+		options.nrThreads = nrThreads;
+		options.fused = fused;
+
+		auto begin = std::chrono::steady_clock::now();
+		blas::svd_convergence convergence = blas::jacobi_svd(A, U, sigma, V, options);
+		auto end = std::chrono::steady_clock::now();
+		double elapsed = std::chrono::duration<double>(end - begin).count();
+
+		// sample the reconstruction along the diagonal to keep the check O(N^2)
+		double error{ 0 };
+		for (size_t i = 0; i < N; ++i) {
+			double a{ 0 };
+			for (size_t k = 0; k < N; ++k) a += double(U(i, k)) * double(sigma[k]) * double(V(i, k));
+			error = std::max(error, std::fabs(a - double(A(i, i))));
+		}
+		std::cout << std::setw(30) << type_tag(Scalar()) << (fused ? " quire" : "      ")
+			<< std::setw(6) << N << std::setw(9) << nrThreads
+			<< std::setw(8) << convergence.sweeps << (convergence.converged ? " " : "*")
+			<< std::setw(12) << std::setprecision(3) << elapsed << " sec"
+			<< std::setw(14) << error << '\n';
+	}
+
+}} // namespace sw::universal
+
+int main(int argc, char** argv)
+try {
+	using namespace sw::universal;
+
+	// optional command line argument: largest matrix size
+	size_t maxN = 1000;
+	if (argc > 1) maxN = std::stoul(argv[1]);
+	unsigned hwThreads = std::max(1u, std::thread::hardware_concurrency());
+
+	std::cout << "one-sided Jacobi SVD of random N-by-N matrices\n";
+	std::cout << std::setw(36) << "type" << std::setw(6) << "N" << std::setw(9) << "threads"
+		<< std::setw(9) << "sweeps" << std::setw(13) << "time" << std::setw(18) << "max|diag err|\n";
+
+	for (size_t N : { 100, 200, 500, 1000 }) {
+		if (N > maxN) break;
+		JacobiSVDPerformance<double>(N, 1);
+		if (hwThreads > 1) JacobiSVDPerformance<double>(N, hwThreads);
+		JacobiSVDPerformance<float>(N, hwThreads);
+	}
+	// posit arithmetic is emulated: keep the problem small
+	JacobiSVDPerformance< posit<32, 2> >(32, hwThreads);
+	JacobiSVDPerformance< posit<32, 2> >(32, hwThreads, true);
+
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << "Caught exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
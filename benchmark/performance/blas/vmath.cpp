@@ -0,0 +1,103 @@
+// vmath.cpp: throughput of the vmath execution engine versus an elementwise loop over the scalar functions
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <chrono>
+#include <random>
+#include <string>
+#include <universal/number/posit/posit.hpp>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/blas/blas.hpp>
+
+namespace sw { namespace universal {
+
+	const char* KernelName(blas::VmathKernel kernel) {
+		switch (kernel) {
+		case blas::VmathKernel::simd:     return "simd";
+		case blas::VmathKernel::table:    return "table";
+		case blas::VmathKernel::parallel: return "parallel";
+		}
+		return "unknown";
+	}
+
+	// elements per second of the engine and of the scalar loop it replaces
+	template<typename Scalar, blas::VmathFunction f>
+	void VmathThroughput(const std::string& function, size_t N) {
+		std::mt19937_64 engine(N);
+		std::uniform_real_distribution<double> distribution(0.01, 4.0);
+		blas::vector<Scalar> x(N), scalar(N);
+		for (auto& v : x) v = Scalar(distribution(engine));
+
+		// the first call generates the tables of the small number systems, exclude it from the measurement
+		blas::vector<Scalar> y = blas::vmath_apply<f>(x);
+		auto begin = std::chrono::steady_clock::now();
+		y = blas::vmath_apply<f>(x);
+		auto end = std::chrono::steady_clock::now();
+		double vmathRate = N / std::chrono::duration<double>(end - begin).count();
+
+		begin = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < N; ++i) scalar[i] = blas::vmath::evaluate<f>(x[i]);
+		end = std::chrono::steady_clock::now();
+		double scalarRate = N / std::chrono::duration<double>(end - begin).count();
+
+		std::cout << std::setw(30) << type_tag(Scalar()) << std::setw(10) << function
+			<< std::setw(10) << KernelName(blas::vmath::select_kernel<Scalar>())
+			<< std::setw(14) << std::setprecision(3) << vmathRate / 1.0e6 << " Melem/s"
+			<< std::setw(14) << scalarRate / 1.0e6 << " Melem/s"
+			<< std::setw(10) << vmathRate / scalarRate << "x\n";
+	}
+
+	template<typename Scalar>
+	void VmathThroughput(size_t N) {
+		VmathThroughput<Scalar, blas::VmathFunction::exp>("exp", N);
+		VmathThroughput<Scalar, blas::VmathFunction::log>("log", N);
+		VmathThroughput<Scalar, blas::VmathFunction::tanh>("tanh", N);
+		VmathThroughput<Scalar, blas::VmathFunction::sigmoid>("sigmoid", N);
+		VmathThroughput<Scalar, blas::VmathFunction::rsqrt>("rsqrt", N);
+		VmathThroughput<Scalar, blas::VmathFunction::sin>("sin", N);
+	}
+
+}} // namespace sw::universal
+
+int main(int argc, char** argv)
+try {
+	using namespace sw::universal;
+
+	// optional command line argument: vector size
+	size_t N = 1'000'000;
+	if (argc > 1) N = std::stoul(argv[1]);
+
+	std::cout << "vmath engine throughput for vectors of " << N << " elements\n";
+	std::cout << std::setw(30) << "type" << std::setw(10) << "function" << std::setw(10) << "kernel"
+		<< std::setw(22) << "vmath" << std::setw(22) << "scalar loop" << std::setw(11) << "speedup\n";
+
+	VmathThroughput<float>(N);
+	VmathThroughput<fp32>(N);
+	VmathThroughput<half>(N);
+	VmathThroughput<posit<16, 1>>(N);
+	VmathThroughput<posit<32, 2>>(N / 10);
+
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << "Caught exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,676 @@
+// universal_c.cpp: batch kernels behind the vector entry points of the universal_c shared library
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <bit>
+#include <limits>
+#include <functional>
+#include <type_traits>
+#define UNIVERSAL_C_EXPORTS
+#include <universal/c_api/universal_c.h>
+
+// configure the C++ library
+// Disable exceptions: errors have no way to cross the C interface
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+#define CFLOAT_THROW_ARITHMETIC_EXCEPTION 0
+#define LNS_THROW_ARITHMETIC_EXCEPTION 0
+// use the fast implementation of posit<8,0> to build its operator tables
+#define POSIT_FAST_POSIT_8_0   1
+// Now include the C++ library
+#include <universal/number/posit/posit.hpp>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/lns/lns.hpp>
+#include <universal/internal/uint128/limb_algorithms.hpp>
+
+/*
+   The entry points marshal raw storage, that is, the unions of positctypes.h and universal_c.h,
+   and each number type gets a kernel that decides how an element operation is evaluated:
+
+   - conversions are bit manipulations between the IEEE-754 double and the target encoding
+     that round to nearest even, in place of the generic conversion paths of the C++ types
+   - 8-bit add and mul are 64K-entry lookup tables built from the C++ arithmetic on first use
+   - posits decode into sign, scale, and an integer significand: products are exact 128-bit
+     integer products, and sums, fma, and dot products accumulate in a quire on 64-bit limbs,
+     so every result is rounded once. posit<16,1> and posit<32,2> sums, and posit<16,1> fma,
+     are cheaper in double precision rounded to odd: that double rounding is innocuous
+     when the target has at most 51 significant bits.
+   - fp16 and bf16 add and mul evaluate in double precision, which has more than 2p+2 bits,
+     and fma rounds the exact product plus the addend to odd. The dot products of posit<8,0>
+     and fp8 are exact in double precision for up to 2^29 elements, fp16, bf16, and lns
+     dot products accumulate in double precision.
+*/
+
+namespace sw { namespace universal { namespace capi {
+
+	////////////////////////////////////////////////////////////////////////
+	// double precision building blocks
+
+	inline uint64_t double_bits(double v) noexcept { return std::bit_cast<uint64_t>(v); }
+
+	// the exact value s + err is replaced by the neighbor of s with an odd significand when err is non-zero
+	inline double round_to_odd(double s, double err) noexcept {
+		uint64_t bits = double_bits(s);
+		if (err != 0.0 && std::isfinite(s) && (bits & 1ull) == 0) {
+			bits += ((err > 0.0) == (s > 0.0) ? 1 : -1);   // s is non-zero when err is
+			s = std::bit_cast<double>(bits);
+		}
+		return s;
+	}
+
+	// a + b, rounded to odd
+	inline double sum_round_to_odd(double a, double b) noexcept {
+		double s = a + b;
+		double bb = s - a;
+		return round_to_odd(s, (a - (s - bb)) + (b - bb));   // TwoSum
+	}
+
+	// scale and 53-bit significand of a finite, non-zero double: |v| = m * 2^(scale - 52)
+	inline void decompose(uint64_t bits, int& scale, uint64_t& m) noexcept {
+		int e = static_cast<int>((bits >> 52) & 0x7FF);
+		m = bits & 0x000F'FFFF'FFFF'FFFFull;
+		if (e == 0) {
+			int shift = std::countl_zero(m) - 11;
+			m <<= shift;
+			scale = -1022 - shift;
+		}
+		else {
+			m |= 0x0010'0000'0000'0000ull;
+			scale = e - 1023;
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////
+	// posit<nbits, es> encoding and decoding
+
+	template<unsigned nbits, unsigned es>
+	struct posit_format {
+		static_assert(nbits >= 3 && nbits <= 64, "posit_format: nbits must be in [3, 64]");
+		static_assert((int(nbits - 2) << es) <= 1022, "posit_format: dynamic range exceeds a double");
+		static constexpr uint64_t NAR_ENCODING = 1ull << (nbits - 1);
+		static constexpr uint64_t MASK = (0xFFFF'FFFF'FFFF'FFFFull >> (64 - nbits));
+		static constexpr int      maxScale = int(nbits - 2) << es;  // scale of maxpos
+		static constexpr unsigned fbits = nbits - 3 - es;           // fraction bits of the encodings closest to 1
+	};
+
+	// posit encoding of (-1)^negative * 1.f * 2^scale: the fraction f is left aligned in 64 bits,
+	// sticky is set when there are non-zero bits below f. Rounds to nearest even on the bit string,
+	// and saturates to maxpos and minpos: posits do not overflow to NaR or underflow to zero.
+	template<unsigned nbits, unsigned es>
+	uint64_t posit_round(bool negative, int scale, uint64_t f, bool sticky) noexcept {
+		using P = posit_format<nbits, es>;
+		uint64_t p;
+		if (scale >= P::maxScale) {
+			p = P::NAR_ENCODING - 1;
+		}
+		else if (scale < -P::maxScale) {
+			p = 1;
+		}
+		else {
+			int k = (scale >= 0 ? (scale >> es) : -((-scale + (1 << es) - 1) >> es));
+			uint64_t exponent = static_cast<uint64_t>(scale - (k << es));
+			// w holds the bits that follow the sign bit, left aligned: regime, exponent, fraction
+			unsigned rlen = (k >= 0 ? unsigned(k) + 2u : unsigned(-k) + 1u);  // <= nbits - 1
+			uint64_t w = (k >= 0 ? ((1ull << (k + 1)) - 1ull) << 1 : 1ull) << (64 - rlen);
+			if constexpr (es > 0) {
+				int epos = 64 - int(rlen) - int(es);
+				if (epos >= 0) w |= exponent << epos;
+				else {
+					w |= exponent >> -epos;
+					sticky = sticky || (exponent & ((1ull << -epos) - 1ull)) != 0;
+				}
+			}
+			unsigned fpos = rlen + es;
+			if (fpos < 64) {
+				w |= f >> fpos;
+				sticky = sticky || (f << (64 - fpos)) != 0;
+			}
+			else sticky = sticky || f != 0;
+			// keep nbits - 1 bits, round to nearest even on the guard and sticky bits
+			p = w >> (65 - nbits);
+			bool guard = ((w >> (64 - nbits)) & 1ull) != 0;
+			if constexpr (nbits < 64) sticky = sticky || (w & ((1ull << (64 - nbits)) - 1ull)) != 0;
+			if (guard && (sticky || (p & 1ull))) ++p;   // cannot carry into NaR as the scale is below the scale of maxpos
+		}
+		return (negative ? (~p + 1ull) & P::MASK : p);
+	}
+
+	template<unsigned nbits, unsigned es>
+	uint64_t posit_encode(double v) noexcept {
+		if (v == 0.0) return 0;
+		if (!std::isfinite(v)) return posit_format<nbits, es>::NAR_ENCODING;
+		uint64_t bits = double_bits(v);
+		int scale;
+		uint64_t m;
+		decompose(bits, scale, m);
+		return posit_round<nbits, es>((bits >> 63) != 0, scale, m << 12, false);
+	}
+
+	// sign, scale, and left aligned fraction of a posit encoding that is neither zero nor NaR
+	template<unsigned nbits, unsigned es>
+	void posit_fields(uint64_t p, bool& negative, int& scale, uint64_t& f) noexcept {
+		using P = posit_format<nbits, es>;
+		negative = (p & P::NAR_ENCODING) != 0;
+		if (negative) p = (~p + 1ull) & P::MASK;
+		uint64_t w = p << (65 - nbits);
+		int k;
+		unsigned rlen;
+		if (w >> 63) {
+			unsigned ones = static_cast<unsigned>(std::countl_one(w));
+			k = int(ones) - 1;
+			rlen = ones + 1;
+		}
+		else {
+			unsigned zeros = static_cast<unsigned>(std::countl_zero(w));
+			k = -int(zeros);
+			rlen = zeros + 1;
+		}
+		w = (rlen >= 64 ? 0ull : w << rlen);
+		int exponent = 0;
+		if constexpr (es > 0) {
+			exponent = static_cast<int>(w >> (64 - es));
+			w <<= es;
+		}
+		scale = k * (1 << es) + exponent;
+		f = w;
+	}
+
+	// double value of a posit encoding, fractions longer than 52 bits are rounded to nearest even
+	template<unsigned nbits, unsigned es>
+	double posit_decode(uint64_t p) noexcept {
+		using P = posit_format<nbits, es>;
+		p &= P::MASK;
+		if (p == 0) return 0.0;
+		if (p == P::NAR_ENCODING) return std::numeric_limits<double>::quiet_NaN();
+		bool negative;
+		int scale;
+		uint64_t f;
+		posit_fields<nbits, es>(p, negative, scale, f);
+		uint64_t fraction = f >> 12;
+		uint64_t rest = f & 0xFFFull;
+		if (rest > 0x800ull || (rest == 0x800ull && (fraction & 1ull))) {
+			if (++fraction == (1ull << 52)) {
+				fraction = 0;
+				++scale;
+			}
+		}
+		return std::bit_cast<double>((uint64_t(negative) << 63) | (uint64_t(scale + 1023) << 52) | fraction);
+	}
+
+	// integer significand with fbits fraction bits: |p| = m * 2^(scale - fbits)
+	template<unsigned nbits, unsigned es>
+	void posit_significand(uint64_t p, bool& negative, int& scale, uint64_t& m) noexcept {
+		constexpr unsigned fbits = posit_format<nbits, es>::fbits;
+		uint64_t f;
+		posit_fields<nbits, es>(p, negative, scale, f);
+		m = (1ull << fbits) | (fbits == 0 ? 0ull : f >> (64 - fbits));
+	}
+
+	// correctly rounded product of two posits
+	template<unsigned nbits, unsigned es>
+	uint64_t posit_multiply(uint64_t a, uint64_t b) noexcept {
+		using P = posit_format<nbits, es>;
+		a &= P::MASK;
+		b &= P::MASK;
+		if (a == P::NAR_ENCODING || b == P::NAR_ENCODING) return P::NAR_ENCODING;
+		if (a == 0 || b == 0) return 0;
+		bool na, nb;
+		int sa, sb;
+		uint64_t ma, mb, hi, lo;
+		posit_significand<nbits, es>(a, na, sa, ma);
+		posit_significand<nbits, es>(b, nb, sb, mb);
+		limb_mul(ma, mb, hi, lo);   // in [2^(2 fbits), 2^(2 fbits + 2))
+		constexpr unsigned productMsb = 2 * P::fbits;
+		unsigned msb = (hi != 0 ? 127u - unsigned(std::countl_zero(hi)) : 63u - unsigned(std::countl_zero(lo)));
+		int scale = sa + sb + int(msb) - int(productMsb);
+		// left align the bits below the leading one
+		uint64_t f;
+		bool sticky;
+		if (msb >= 64) {
+			unsigned s = 127 - msb + 1;   // shift of the 128-bit product that removes the leading one
+			f = (s == 64 ? lo : (hi << s) | (lo >> (64 - s)));
+			sticky = (s == 64 ? false : (lo << s) != 0);
+		}
+		else {
+			f = (msb == 0 ? 0ull : lo << (64 - msb));
+			sticky = false;
+		}
+		return posit_round<nbits, es>(na != nb, scale, f, sticky);
+	}
+
+	// exact sum of posit values and products, a quire on 64-bit limbs in two's complement
+	template<unsigned nbits, unsigned es, unsigned capacity = 30>
+	class posit_accumulator {
+		using P = posit_format<nbits, es>;
+		static constexpr int      lsbScale = -2 * P::maxScale - 2 * int(P::fbits);    // weight of the least significant bit
+		static constexpr unsigned qbits = unsigned(4 * P::maxScale + 2 * int(P::fbits) + 2) + capacity + 1;
+		static constexpr unsigned nrLimbs = (qbits + 63) / 64;
+	public:
+		void add(uint64_t a) {
+			a &= P::MASK;
+			if (a == P::NAR_ENCODING) nar = true;
+			if (a == 0 || nar) return;
+			bool negative;
+			int scale;
+			uint64_t m;
+			posit_significand<nbits, es>(a, negative, scale, m);
+			accumulate(negative, scale - int(P::fbits) - lsbScale, 0, m);
+		}
+		void fmadd(uint64_t a, uint64_t b) {
+			a &= P::MASK;
+			b &= P::MASK;
+			if (a == P::NAR_ENCODING || b == P::NAR_ENCODING) nar = true;
+			if (a == 0 || b == 0 || nar) return;
+			bool na, nb;
+			int sa, sb;
+			uint64_t ma, mb, hi, lo;
+			posit_significand<nbits, es>(a, na, sa, ma);
+			posit_significand<nbits, es>(b, nb, sb, mb);
+			limb_mul(ma, mb, hi, lo);
+			accumulate(na != nb, sa + sb - 2 * int(P::fbits) - lsbScale, hi, lo);
+		}
+		uint64_t round() const noexcept {
+			if (nar) return P::NAR_ENCODING;
+			uint64_t q[nrLimbs];
+			std::memcpy(q, limbs, sizeof(q));
+			bool negative = (q[nrLimbs - 1] >> 63) != 0;
+			if (negative) {   // two's complement magnitude
+				for (unsigned i = 0; i < nrLimbs; ++i) q[i] = ~q[i];
+				limb_add_1(q, nrLimbs, uint64_t(1));
+			}
+			int top = int(nrLimbs) - 1;
+			while (top >= 0 && q[top] == 0) --top;
+			if (top < 0) return 0;
+			unsigned lz = unsigned(std::countl_zero(q[top]));
+			int msb = top * 64 + 63 - int(lz);
+			// the 64 bits below the leading one, left aligned, and the sticky bit of the rest
+			uint64_t upper = q[top] << lz << 1;   // lz <= 63: two shifts avoid a shift by 64
+			uint64_t lower = (top > 0 ? q[top - 1] : 0ull);
+			uint64_t f = upper | (lz == 63 ? lower : lower >> (63 - lz));
+			bool sticky = (lz == 63 ? false : (lower << (lz + 1)) != 0);
+			for (int i = top - 2; i >= 0 && !sticky; --i) sticky = (q[i] != 0);
+			return posit_round<nbits, es>(negative, msb + lsbScale, f, sticky);
+		}
+
+	private:
+		uint64_t limbs[nrLimbs]{};
+		bool nar{ false };
+
+		// add or subtract hi:lo * 2^shift
+		void accumulate(bool negative, int shift, uint64_t hi, uint64_t lo) noexcept {
+			unsigned limb = unsigned(shift) / 64, offset = unsigned(shift) % 64;
+			uint64_t term[3] = { lo << offset, (hi << offset) | (offset ? lo >> (64 - offset) : 0ull), (offset ? hi >> (64 - offset) : 0ull) };
+			uint64_t carry{ 0 };
+			unsigned i = limb;
+			for (unsigned j = 0; j < 3 && i < nrLimbs; ++j, ++i) {
+				limbs[i] = (negative ? limb_subb(limbs[i], term[j], carry) : limb_addc(limbs[i], term[j], carry));
+			}
+			if (i < nrLimbs) {
+				if (negative) limb_sub_1(limbs + i, nrLimbs - i, carry);
+				else limb_add_1(limbs + i, nrLimbs - i, carry);
+			}
+		}
+	};
+
+	////////////////////////////////////////////////////////////////////////
+	// IEEE-754 style cfloat<nbits, es, bt, true, false, false> encoding of a double, rounded to nearest even
+	// cfloat reserves the all-ones exponent for the special values: the fraction 11..10 is infinity,
+	// 11..11 is NaN, quiet with the sign bit clear and signalling with the sign bit set, and the rest decode to NaN
+	template<unsigned nbits, unsigned es>
+	struct ieee_format {
+		static constexpr unsigned fbits = nbits - 1u - es;
+		static constexpr int      bias = (1 << (es - 1)) - 1;
+		static constexpr uint64_t EALLSET = (1ull << es) - 1ull;
+		static constexpr uint64_t FMASK = (1ull << fbits) - 1ull;
+		static constexpr uint64_t MAXPOS_ENCODING = ((EALLSET - 1ull) << fbits) | FMASK;
+		static constexpr uint64_t INF_ENCODING = (EALLSET << fbits) | (FMASK - 1ull);
+		static constexpr uint64_t QNAN_ENCODING = (EALLSET << fbits) | FMASK;
+		static constexpr uint64_t SNAN_ENCODING = (1ull << (nbits - 1)) | QNAN_ENCODING;
+		static constexpr int      emin = 1 - bias;
+		static constexpr int      emax = int(EALLSET) - 1 - bias;
+	};
+
+	template<unsigned nbits, unsigned es>
+	uint64_t ieee_encode(double v) noexcept {
+		using F = ieee_format<nbits, es>;
+		static_assert(F::fbits < 52, "ieee_encode: the fraction of the target must be smaller than the fraction of a double");
+		uint64_t bits = double_bits(v);
+		uint64_t sign = (bits >> 63) << (nbits - 1);
+		if (std::isnan(v)) return ((bits >> 51) & 1ull) ? F::QNAN_ENCODING : F::SNAN_ENCODING;
+		if (std::isinf(v)) return sign | F::INF_ENCODING;
+		if (v == 0.0) return sign;
+		int scale;
+		uint64_t m;
+		decompose(bits, scale, m);
+		if (scale > F::emax) return sign | F::INF_ENCODING;
+		int lsb = (scale < F::emin ? F::emin : scale) - int(F::fbits);  // exponent of the least significant bit of the target
+		int shift = lsb - (scale - 52);                                  // >= 1 as the target fraction is shorter
+		uint64_t q = 0;
+		if (shift < 64) {
+			q = m >> shift;
+			bool guard = ((m >> (shift - 1)) & 1ull) != 0;
+			bool sticky = (m & ((1ull << (shift - 1)) - 1ull)) != 0;
+			if (guard && (sticky || (q & 1ull))) ++q;
+		}
+		uint64_t encoding;
+		if (scale < F::emin) {
+			encoding = q;   // subnormal, rounding up into the smallest normal carries into the exponent field
+		}
+		else {
+			encoding = (uint64_t(scale + F::bias) << F::fbits) + (q - (1ull << F::fbits));   // q in [2^fbits, 2^(fbits+1)]
+		}
+		if (encoding > F::MAXPOS_ENCODING) encoding = F::INF_ENCODING;
+		return sign | encoding;
+	}
+
+	template<unsigned nbits, unsigned es>
+	double ieee_decode(uint64_t p) noexcept {
+		using F = ieee_format<nbits, es>;
+		bool negative = ((p >> (nbits - 1)) & 1ull) != 0;
+		uint64_t e = (p >> F::fbits) & F::EALLSET;
+		uint64_t f = p & F::FMASK;
+		double v;
+		if (e == F::EALLSET) {
+			v = (f == F::FMASK - 1ull ? std::numeric_limits<double>::infinity() : std::numeric_limits<double>::quiet_NaN());
+		}
+		else if (e == 0) {
+			v = std::ldexp(double(f), F::emin - int(F::fbits));
+		}
+		else {
+			v = std::bit_cast<double>((uint64_t(int(e) - F::bias + 1023) << 52) | (f << (52 - F::fbits)));
+		}
+		return (negative ? -v : v);
+	}
+
+	////////////////////////////////////////////////////////////////////////
+	// lns<nbits, rbits> encoding of a double, following the saturating conversion of the C++ type
+
+	template<typename Lns>
+	struct lns_codec {
+		static constexpr unsigned nbits = Lns::nbits;
+		static constexpr unsigned rbits = Lns::rbits;
+		static constexpr uint64_t SIGN = 1ull << (nbits - 1);
+		static constexpr uint64_t ZERO = 1ull << (nbits - 2);
+		static constexpr uint64_t NAN_ENCODING = SIGN | ZERO;
+		static constexpr uint64_t EXPONENT_MASK = SIGN - 1ull;
+
+		// range boundaries and special encodings, taken from the C++ type once
+		struct boundaries {
+			double maxpos, minpos, halfMinpos;
+			uint64_t maxposBits, minposBits, posinf, neginf;
+			boundaries() {
+				Lns a(SpecificValue::maxpos), b(SpecificValue::minpos);
+				lns<nbits + 1, rbits + 1, typename Lns::BlockType> half(SpecificValue::minpos);
+				maxpos = double(a);
+				minpos = double(b);
+				halfMinpos = double(half);
+				maxposBits = bits(a);
+				minposBits = bits(b);
+				posinf = bits(Lns(std::numeric_limits<double>::infinity()));
+				neginf = bits(Lns(-std::numeric_limits<double>::infinity()));
+			}
+		};
+		static const boundaries& range() {
+			static const boundaries r;
+			return r;
+		}
+		static uint64_t bits(const Lns& v) noexcept {
+			uint64_t raw = 0;
+			std::memcpy(&raw, &v, sizeof(Lns));
+			return raw;
+		}
+
+		static uint64_t encode(double v) noexcept {
+			const boundaries& r = range();
+			if (std::isnan(v)) return NAN_ENCODING;
+			if (std::isinf(v)) return (v > 0 ? r.posinf : r.neginf);
+			if (v == 0.0) return ZERO;
+			if (v >= r.maxpos) return r.maxposBits;
+			if (v <= -r.maxpos) return r.maxposBits | SIGN;
+			bool negative = v < 0.0;
+			double a = (negative ? -v : v);
+			if (a <= r.halfMinpos) return ZERO;
+			if (a <= r.minpos) return r.minposBits | (negative ? SIGN : 0ull);
+			double e = std::nearbyint(std::ldexp(std::log2(a), int(rbits)));
+			return (negative ? SIGN : 0ull) | (static_cast<uint64_t>(static_cast<int64_t>(e)) & EXPONENT_MASK);
+		}
+
+		static double decode(uint64_t p) noexcept {
+			if (p == ZERO) return 0.0;
+			if (p == NAN_ENCODING) return std::numeric_limits<double>::quiet_NaN();
+			bool negative = (p & SIGN) != 0;
+			int64_t e = static_cast<int64_t>((p & EXPONENT_MASK) << (65 - nbits)) >> (65 - nbits);  // sign extend the exponent
+			double v = std::pow(2.0, std::ldexp(double(e), -int(rbits)));
+			return (negative ? -v : v);
+		}
+	};
+
+
+	////////////////////////////////////////////////////////////////////////
+	// kernels: element operations on raw storage
+
+	// storage <-> C++ number type
+	template<typename Number, typename Storage>
+	struct marshal {
+		static_assert(sizeof(Number) == sizeof(Storage), "marshal: the number type must have the size of its storage");
+		static Number to_number(Storage s) noexcept {
+			Number v;
+			std::memcpy(static_cast<void*>(&v), &s, sizeof(Storage));
+			return v;
+		}
+		static Storage to_storage(const Number& v) noexcept {
+			Storage s;
+			std::memcpy(&s, &v, sizeof(Storage));
+			return s;
+		}
+	};
+
+	// lookup table of a binary operator of an 8-bit number type, built from the C++ arithmetic
+	template<typename Number, typename BinaryOperator>
+	struct operator_table {
+		uint8_t result[256 * 256];
+		operator_table() {
+			using M = marshal<Number, uint8_t>;
+			BinaryOperator op;
+			for (unsigned i = 0; i < 256; ++i) {
+				for (unsigned j = 0; j < 256; ++j) {
+					result[(i << 8) | j] = M::to_storage(op(M::to_number(uint8_t(i)), M::to_number(uint8_t(j))));
+				}
+			}
+		}
+		uint8_t operator()(uint8_t a, uint8_t b) const noexcept { return result[(unsigned(a) << 8) | b]; }
+	};
+	template<typename Number, typename BinaryOperator>
+	const operator_table<Number, BinaryOperator>& lookup() {
+		static const operator_table<Number, BinaryOperator> table;
+		return table;
+	}
+
+	// sum of products in double precision, rounded once
+	template<typename Kernel>
+	struct double_accumulator {
+		using Storage = typename Kernel::Storage;
+		double sum{ 0.0 };
+		void fmadd(Storage a, Storage b) noexcept { sum += Kernel::decode(a) * Kernel::decode(b); }
+		Storage round() const noexcept { return Kernel::encode(sum); }
+	};
+
+	// sum of products in the posit quire, rounded once
+	template<typename Kernel>
+	struct quire_accumulator {
+		using Storage = typename Kernel::Storage;
+		posit_accumulator<Kernel::nbits, Kernel::es> q;
+		void fmadd(Storage a, Storage b) noexcept { q.fmadd(a, b); }
+		Storage round() const noexcept { return Storage(q.round()); }
+	};
+
+	// posits: 8-bit tables, exact integer products, and sums rounded once
+	template<unsigned nbits_, unsigned es_, typename StorageType>
+	struct posit_kernel {
+		static constexpr unsigned nbits = nbits_;
+		static constexpr unsigned es = es_;
+		using Number = posit<nbits, es>;
+		using Storage = StorageType;
+		static constexpr bool doubleSums = (nbits - 2 - es) <= 51;                 // round-to-odd sums in double precision are innocuous
+		static constexpr bool exactProducts = (2 * (nbits - 2 - es)) <= 53;       // the product of two significands fits a double
+
+		static Storage encode(double v) noexcept { return Storage(posit_encode<nbits, es>(v)); }
+		static double  decode(Storage p) noexcept { return posit_decode<nbits, es>(p); }
+		static Storage add(Storage a, Storage b) noexcept {
+			if constexpr (nbits == 8) return lookup<Number, std::plus<Number>>()(a, b);
+			else if constexpr (doubleSums) return encode(sum_round_to_odd(decode(a), decode(b)));
+			else {
+				posit_accumulator<nbits, es> q;
+				q.add(a);
+				q.add(b);
+				return Storage(q.round());
+			}
+		}
+		static Storage mul(Storage a, Storage b) noexcept {
+			if constexpr (nbits == 8) return lookup<Number, std::multiplies<Number>>()(a, b);
+			else return Storage(posit_multiply<nbits, es>(a, b));
+		}
+		static Storage fma(Storage a, Storage b, Storage c) noexcept {
+			if constexpr (exactProducts) {
+				return encode(sum_round_to_odd(decode(a) * decode(b), decode(c)));
+			}
+			else {
+				posit_accumulator<nbits, es> q;
+				q.fmadd(a, b);
+				q.add(c);
+				return Storage(q.round());
+			}
+		}
+		using accumulator = std::conditional_t<nbits == 8, double_accumulator<posit_kernel>, quire_accumulator<posit_kernel>>;
+	};
+
+	// IEEE-754 style cfloats: fp8 tables, fp16 and bf16 in double precision
+	template<unsigned nbits, unsigned es, typename StorageType>
+	struct cfloat_kernel {
+		using Number = cfloat<nbits, es, StorageType, true, false, false>;
+		using Storage = StorageType;
+
+		static Storage encode(double v) noexcept { return Storage(ieee_encode<nbits, es>(v)); }
+		static double  decode(Storage p) noexcept { return ieee_decode<nbits, es>(p); }
+		// double precision has more than 2p+2 bits, so double rounding of a sum is innocuous, and products are exact
+		static Storage add(Storage a, Storage b) noexcept {
+			if constexpr (nbits == 8) return lookup<Number, std::plus<Number>>()(a, b);
+			else return encode(decode(a) + decode(b));
+		}
+		static Storage mul(Storage a, Storage b) noexcept {
+			if constexpr (nbits == 8) return lookup<Number, std::multiplies<Number>>()(a, b);
+			else return encode(decode(a) * decode(b));
+		}
+		static Storage fma(Storage a, Storage b, Storage c) noexcept {
+			return encode(sum_round_to_odd(decode(a) * decode(b), decode(c)));
+		}
+		using accumulator = double_accumulator<cfloat_kernel>;
+	};
+
+	// lns: the C++ type rounds the double precision result of an addition, and multiplies natively
+	template<unsigned nbits, unsigned rbits, typename StorageType>
+	struct lns_kernel {
+		using Number = lns<nbits, rbits, StorageType>;
+		using Storage = StorageType;
+		using M = marshal<Number, Storage>;
+		using Codec = lns_codec<Number>;
+
+		static Storage encode(double v) noexcept { return Storage(Codec::encode(v)); }
+		static double  decode(Storage p) noexcept { return Codec::decode(p); }
+		static Storage add(Storage a, Storage b) noexcept { return encode(decode(a) + decode(b)); }
+		static Storage mul(Storage a, Storage b) { return M::to_storage(M::to_number(a) * M::to_number(b)); }
+		static Storage fma(Storage a, Storage b, Storage c) noexcept { return encode(std::fma(decode(a), decode(b), decode(c))); }
+		using accumulator = double_accumulator<lns_kernel>;
+	};
+
+	////////////////////////////////////////////////////////////////////////
+	// batch drivers
+
+	// BLAS convention: a negative increment starts at the end of the vector
+	template<typename T>
+	inline T* first_element(T* x, size_t n, ptrdiff_t inc) noexcept {
+		return (inc < 0 && n > 0 ? x + ptrdiff_t(n - 1) * -inc : x);
+	}
+
+	template<typename Kernel, typename CType>
+	struct batch {
+		static void fromd(size_t n, const double* x, CType* y) {
+			for (size_t i = 0; i < n; ++i) y[i].v = Kernel::encode(x[i]);
+		}
+		static void tod(size_t n, const CType* x, double* y) {
+			for (size_t i = 0; i < n; ++i) y[i] = Kernel::decode(x[i].v);
+		}
+		static void add(size_t n, const CType* a, const CType* b, CType* c) {
+			for (size_t i = 0; i < n; ++i) c[i].v = Kernel::add(a[i].v, b[i].v);
+		}
+		static void mul(size_t n, const CType* a, const CType* b, CType* c) {
+			for (size_t i = 0; i < n; ++i) c[i].v = Kernel::mul(a[i].v, b[i].v);
+		}
+		static void fma(size_t n, const CType* a, const CType* b, const CType* c, CType* d) {
+			for (size_t i = 0; i < n; ++i) d[i].v = Kernel::fma(a[i].v, b[i].v, c[i].v);
+		}
+		static CType dot(size_t n, const CType* x, ptrdiff_t incx, const CType* y, ptrdiff_t incy) {
+			typename Kernel::accumulator acc;
+			x = first_element(x, n, incx);
+			y = first_element(y, n, incy);
+			for (size_t i = 0; i < n; ++i, x += incx, y += incy) acc.fmadd(x->v, y->v);
+			CType result;
+			result.v = acc.round();
+			return result;
+		}
+		static void axpy(size_t n, CType alpha, const CType* x, ptrdiff_t incx, CType* y, ptrdiff_t incy) {
+			x = first_element(x, n, incx);
+			y = first_element(y, n, incy);
+			for (size_t i = 0; i < n; ++i, x += incx, y += incy) y->v = Kernel::fma(alpha.v, x->v, y->v);
+		}
+		static void gemv(size_t m, size_t n, CType alpha, const CType* A, size_t lda, const CType* x, CType beta, CType* y) {
+			bool zeroBeta = (Kernel::decode(beta.v) == 0.0);   // BLAS: y is not read when beta is zero
+			for (size_t i = 0; i < m; ++i) {
+				typename Kernel::accumulator row;
+				const CType* a = A + i * lda;
+				for (size_t j = 0; j < n; ++j) row.fmadd(a[j].v, x[j].v);
+				typename Kernel::accumulator update;
+				update.fmadd(alpha.v, row.round());
+				if (!zeroBeta) update.fmadd(beta.v, y[i].v);
+				y[i].v = update.round();
+			}
+		}
+	};
+
+}}} // namespace sw::universal::capi
+
+using posit8_batch  = sw::universal::capi::batch<sw::universal::capi::posit_kernel<8, 0, uint8_t>,   posit8_t>;
+using posit16_batch = sw::universal::capi::batch<sw::universal::capi::posit_kernel<16, 1, uint16_t>, posit16_t>;
+using posit32_batch = sw::universal::capi::batch<sw::universal::capi::posit_kernel<32, 2, uint32_t>, posit32_t>;
+using posit64_batch = sw::universal::capi::batch<sw::universal::capi::posit_kernel<64, 3, uint64_t>, posit64_t>;
+using fp8_batch     = sw::universal::capi::batch<sw::universal::capi::cfloat_kernel<8, 2, uint8_t>,  fp8_t>;
+using fp16_batch    = sw::universal::capi::batch<sw::universal::capi::cfloat_kernel<16, 5, uint16_t>, fp16_t>;
+using bf16_batch    = sw::universal::capi::batch<sw::universal::capi::cfloat_kernel<16, 8, uint16_t>, bf16_t>;
+using lns16_batch   = sw::universal::capi::batch<sw::universal::capi::lns_kernel<16, 8, uint16_t>,    lns16_t>;
+using lns32_batch   = sw::universal::capi::batch<sw::universal::capi::lns_kernel<32, 24, uint32_t>,   lns32_t>;
+
+#define UNIVERSAL_C_BATCH_IMPL(T)                                                                                                  \
+	void T##_fromd_array(size_t n, const double* x, T##_t* y) { T##_batch::fromd(n, x, y); }                                        \
+	void T##_tod_array(size_t n, const T##_t* x, double* y) { T##_batch::tod(n, x, y); }                                            \
+	void T##_add_array(size_t n, const T##_t* a, const T##_t* b, T##_t* c) { T##_batch::add(n, a, b, c); }                          \
+	void T##_mul_array(size_t n, const T##_t* a, const T##_t* b, T##_t* c) { T##_batch::mul(n, a, b, c); }                          \
+	void T##_fma_array(size_t n, const T##_t* a, const T##_t* b, const T##_t* c, T##_t* d) { T##_batch::fma(n, a, b, c, d); }       \
+	T##_t T##_dot(size_t n, const T##_t* x, ptrdiff_t incx, const T##_t* y, ptrdiff_t incy) { return T##_batch::dot(n, x, incx, y, incy); } \
+	void T##_axpy(size_t n, T##_t alpha, const T##_t* x, ptrdiff_t incx, T##_t* y, ptrdiff_t incy) { T##_batch::axpy(n, alpha, x, incx, y, incy); } \
+	void T##_gemv(size_t m, size_t n, T##_t alpha, const T##_t* A, size_t lda, const T##_t* x, T##_t beta, T##_t* y) { T##_batch::gemv(m, n, alpha, A, lda, x, beta, y); }
+
+extern "C" {
+	UNIVERSAL_C_BATCH_IMPL(posit8)
+	UNIVERSAL_C_BATCH_IMPL(posit16)
+	UNIVERSAL_C_BATCH_IMPL(posit32)
+	UNIVERSAL_C_BATCH_IMPL(posit64)
+	UNIVERSAL_C_BATCH_IMPL(fp8)
+	UNIVERSAL_C_BATCH_IMPL(fp16)
+	UNIVERSAL_C_BATCH_IMPL(bf16)
+	UNIVERSAL_C_BATCH_IMPL(lns16)
+	UNIVERSAL_C_BATCH_IMPL(lns32)
+}
@@ -0,0 +1,97 @@
+// batch.c: example test of the vector entry points of the universal_c library for C programs
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <stdio.h>
+#include <stdlib.h>
+#include <universal/c_api/universal_c.h>
+
+/*
+   The operands are short binary fractions that fit in the 8-bit types, so that the vector
+   operations are exact for the posits and cfloats. The logarithmic types only represent
+   powers of 2^(2^-rbits) and are checked with a relative tolerance.
+     a = [0.25 0.5 0.75 1], b = [1 0.75 0.5 0.25]
+     a + b = [1.25 1.25 1.25 1.25], a * b = [0.25 0.375 0.375 0.25], a * b + a = [0.5 0.875 1.125 1.25]
+     a . b = 1.25, a(0:2:3) . b(2:-2:0) = 0.875
+     2 * a + b = [1.5 1.75 2 2.25]
+     [a; b] * a + [1 1] = [2.875 2.25]
+*/
+
+static int nearly_equal(double value, double expected, double relativeTolerance) {
+	double error = value - expected;
+	return (error < 0.0 ? -error : error) <= relativeTolerance * (expected < 0.0 ? -expected : expected);
+}
+
+#define TEST_BATCH_API(T, tolerance)                                                                    \
+static int test_##T(void) {                                                                             \
+	const double da[4] = { 0.25, 0.5, 0.75, 1.0 };                                                      \
+	const double db[4] = { 1.0, 0.75, 0.5, 0.25 };                                                      \
+	const double dsum[4] = { 1.25, 1.25, 1.25, 1.25 };                                                  \
+	const double dprod[4] = { 0.25, 0.375, 0.375, 0.25 };                                               \
+	const double dfma[4] = { 0.5, 0.875, 1.125, 1.25 };                                                 \
+	const double daxpy[4] = { 1.5, 1.75, 2.0, 2.25 };                                                   \
+	const double dgemv[2] = { 2.875, 2.25 };                                                            \
+	const double dscalars[4] = { 2.0, 1.0, 1.0, 1.0 };                                                  \
+	T##_t a[4], b[4], c[4], A[8], scalars[4], y[2];                                                     \
+	double r[4];                                                                                        \
+	int fails = 0, i;                                                                                   \
+	T##_fromd_array(4, da, a);                                                                          \
+	T##_fromd_array(4, db, b);                                                                          \
+	T##_fromd_array(4, dscalars, scalars);                                                              \
+	T##_add_array(4, a, b, c);                                                                          \
+	T##_tod_array(4, c, r);                                                                             \
+	for (i = 0; i < 4; ++i) if (!nearly_equal(r[i], dsum[i], tolerance)) ++fails;                       \
+	T##_mul_array(4, a, b, c);                                                                          \
+	T##_tod_array(4, c, r);                                                                             \
+	for (i = 0; i < 4; ++i) if (!nearly_equal(r[i], dprod[i], tolerance)) ++fails;                      \
+	T##_fma_array(4, a, b, a, c);                                                                       \
+	T##_tod_array(4, c, r);                                                                             \
+	for (i = 0; i < 4; ++i) if (!nearly_equal(r[i], dfma[i], tolerance)) ++fails;                       \
+	c[0] = T##_dot(4, a, 1, b, 1);                                                                      \
+	T##_tod_array(1, c, r);                                                                             \
+	if (!nearly_equal(r[0], 1.25, tolerance)) ++fails;                                                  \
+	c[0] = T##_dot(2, a, 2, b, -2);                                                                     \
+	T##_tod_array(1, c, r);                                                                             \
+	if (!nearly_equal(r[0], 0.875, tolerance)) ++fails;                                                 \
+	for (i = 0; i < 4; ++i) c[i] = b[i];                                                                \
+	T##_axpy(4, scalars[0], a, 1, c, 1);                                                                \
+	T##_tod_array(4, c, r);                                                                             \
+	for (i = 0; i < 4; ++i) if (!nearly_equal(r[i], daxpy[i], tolerance)) ++fails;                      \
+	for (i = 0; i < 4; ++i) { A[i] = a[i]; A[4 + i] = b[i]; }                                           \
+	y[0] = scalars[1]; y[1] = scalars[2];                                                               \
+	T##_gemv(2, 4, scalars[1], A, 4, a, scalars[3], y);                                                 \
+	T##_tod_array(2, y, r);                                                                             \
+	for (i = 0; i < 2; ++i) if (!nearly_equal(r[i], dgemv[i], tolerance)) ++fails;                      \
+	printf("%-8s vector operations %s\n", #T, (fails ? "FAIL" : "PASS"));                               \
+	return fails;                                                                                       \
+}
+
+TEST_BATCH_API(posit8,  0.0)
+TEST_BATCH_API(posit16, 0.0)
+TEST_BATCH_API(posit32, 0.0)
+TEST_BATCH_API(posit64, 0.0)
+TEST_BATCH_API(fp8,     0.0)
+TEST_BATCH_API(fp16,    0.0)
+TEST_BATCH_API(bf16,    0.0)
+TEST_BATCH_API(lns16,   1.0e-2)
+TEST_BATCH_API(lns32,   1.0e-6)
+
+int main(int argc, char* argv[])
+{
+	int fails = 0;
+	(void)argc; (void)argv;
+
+	fails += test_posit8();
+	fails += test_posit16();
+	fails += test_posit32();
+	fails += test_posit64();
+	fails += test_fp8();
+	fails += test_fp16();
+	fails += test_bf16();
+	fails += test_lns16();
+	fails += test_lns32();
+
+	return (fails > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
@@ -0,0 +1,302 @@
+// kernels.cpp: verify the batch kernels of the universal_c library against the C++ number types
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <cmath>
+#include <random>
+#include <vector>
+#include <universal/c_api/universal_c.h>
+#include <universal/number/posit/posit.hpp>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/lns/lns.hpp>
+#include <universal/verification/test_suite.hpp>
+
+/*
+   The library evaluates its kernels with bit manipulations and double precision arithmetic,
+   and the references are the conversion and arithmetic operators of the C++ number types,
+   so the results need to agree encoding for encoding:
+   - conversions: all encodings of the 8- and 16-bit types, random encodings of the wider types,
+     and from double the values, the midpoints between adjacent encodings, and their neighbors
+   - add and mul: exhaustive for the 8-bit types, random operands otherwise
+   - fma: posits against the quire, cfloats where a*b+c is exact in double precision
+   - dot: posits against the fused dot product
+*/
+
+namespace sw { namespace universal {
+
+	template<typename CType>
+	struct BatchApi {
+		void  (*fromd)(size_t, const double*, CType*);
+		void  (*tod)(size_t, const CType*, double*);
+		void  (*add)(size_t, const CType*, const CType*, CType*);
+		void  (*mul)(size_t, const CType*, const CType*, CType*);
+		void  (*fma)(size_t, const CType*, const CType*, const CType*, CType*);
+		CType (*dot)(size_t, const CType*, ptrdiff_t, const CType*, ptrdiff_t);
+	};
+#define BATCH_API(T) BatchApi<T##_t>{ T##_fromd_array, T##_tod_array, T##_add_array, T##_mul_array, T##_fma_array, T##_dot }
+
+	template<typename Number, typename CType>
+	Number to_number(const CType& c) {
+		Number v;
+		v.setbits(c.v);
+		return v;
+	}
+
+	// the same encoding, NaN and NaR included
+	template<typename Number>
+	bool same(const Number& lhs, const Number& rhs) {
+		if (lhs.isnan() && rhs.isnan()) return true;
+		return lhs == rhs;
+	}
+
+	// the encodings to test: all of them for up to 16 bits, random ones otherwise
+	template<typename Number, typename CType>
+	std::vector<CType> TestEncodings(std::mt19937_64& engine, size_t nrRandoms) {
+		std::vector<CType> encodings;
+		if constexpr (Number::nbits <= 16) {
+			for (uint64_t i = 0; i < (1ull << Number::nbits); ++i) encodings.push_back(CType{ .v = static_cast<decltype(CType::v)>(i) });
+		}
+		else {
+			for (size_t i = 0; i < nrRandoms; ++i) encodings.push_back(CType{ .v = static_cast<decltype(CType::v)>(engine()) });
+		}
+		return encodings;
+	}
+
+	template<typename Number, typename CType>
+	int VerifyBatchConversion(const BatchApi<CType>& api, bool reportTestCases, size_t nrRandoms) {
+		std::mt19937_64 engine(Number::nbits);
+		std::vector<CType> encodings = TestEncodings<Number, CType>(engine, nrRandoms);
+		size_t n = encodings.size();
+		int nrOfFailedTestCases = 0;
+
+		std::vector<double> values(n);
+		api.tod(n, encodings.data(), values.data());
+		for (size_t i = 0; i < n; ++i) {
+			double ref = double(to_number<Number>(encodings[i]));
+			if (values[i] != ref && !(std::isnan(values[i]) && std::isnan(ref))) {
+				// the library rounds fractions that exceed the 52 bits of a double to nearest,
+				// the C++ posit<64,3> conversion can be off by one ulp
+				if constexpr (Number::nbits > 55) if (std::nextafter(ref, values[i]) == values[i]) continue;
+				++nrOfFailedTestCases;
+				if (reportTestCases) ReportConversionError("FAIL", "tod", values[i], to_number<Number>(encodings[i]), ref);
+			}
+		}
+
+		// the values, the midpoints to the next encoding, and the neighbors of the midpoints
+		std::vector<double> samples;
+		for (size_t i = 0; i < n; ++i) {
+			Number v = to_number<Number>(encodings[i]), next = v;
+			next.setbits(encodings[i].v + 1u);
+			double a = double(v), b = double(next), midpoint = a + (b - a) / 2.0;
+			samples.push_back(a);
+			samples.push_back(midpoint);
+			samples.push_back(std::nextafter(midpoint, -INFINITY));
+			samples.push_back(std::nextafter(midpoint, +INFINITY));
+		}
+		std::vector<CType> results(samples.size());
+		api.fromd(samples.size(), samples.data(), results.data());
+		for (size_t i = 0; i < samples.size(); ++i) {
+			Number result = to_number<Number>(results[i]), ref(samples[i]);
+			if (!same(result, ref)) {
+				++nrOfFailedTestCases;
+				if (reportTestCases) ReportConversionError("FAIL", "fromd", samples[i], result, double(ref));
+			}
+			if (nrOfFailedTestCases > 24) break;
+		}
+		return nrOfFailedTestCases;
+	}
+
+	template<typename Number, typename CType>
+	int VerifyBatchArithmetic(const BatchApi<CType>& api, bool reportTestCases, size_t nrRandoms) {
+		std::mt19937_64 engine(Number::nbits + 1);
+		std::vector<CType> a, b, c;
+		if constexpr (Number::nbits <= 8) {
+			for (unsigned i = 0; i < 256; ++i) {
+				for (unsigned j = 0; j < 256; ++j) {
+					a.push_back(CType{ .v = static_cast<decltype(CType::v)>(i) });
+					b.push_back(CType{ .v = static_cast<decltype(CType::v)>(j) });
+					c.push_back(CType{ .v = static_cast<decltype(CType::v)>(engine()) });
+				}
+			}
+		}
+		else {
+			for (size_t i = 0; i < nrRandoms; ++i) {
+				a.push_back(CType{ .v = static_cast<decltype(CType::v)>(engine()) });
+				b.push_back(CType{ .v = static_cast<decltype(CType::v)>(engine()) });
+				c.push_back(CType{ .v = static_cast<decltype(CType::v)>(engine()) });
+			}
+		}
+		size_t n = a.size();
+		std::vector<CType> sum(n), product(n), fused(n);
+		api.add(n, a.data(), b.data(), sum.data());
+		api.mul(n, a.data(), b.data(), product.data());
+		api.fma(n, a.data(), b.data(), c.data(), fused.data());
+		int nrOfFailedTestCases = 0;
+		for (size_t i = 0; i < n && nrOfFailedTestCases < 25; ++i) {
+			Number x = to_number<Number>(a[i]), y = to_number<Number>(b[i]), z = to_number<Number>(c[i]);
+			Number result = to_number<Number>(sum[i]), ref = x + y;
+			if (!same(result, ref)) {
+				++nrOfFailedTestCases;
+				if (reportTestCases) ReportBinaryArithmeticError("FAIL", "+", x, y, result, ref);
+			}
+			result = to_number<Number>(product[i]);
+			ref = x * y;
+			if (!same(result, ref)) {
+				++nrOfFailedTestCases;
+				if (reportTestCases) ReportBinaryArithmeticError("FAIL", "*", x, y, result, ref);
+			}
+			result = to_number<Number>(fused[i]);
+			if constexpr (is_posit<Number>) {
+				if (x.isnar() || y.isnar() || z.isnar()) ref.setnar();
+				else {
+					quire<Number::nbits, Number::es> q(0);
+					q += quire_mul(x, y);
+					q += quire_mul(z, Number(1));
+					convert(q.to_value(), ref);
+				}
+			}
+			else {
+				double dx = double(x), dy = double(y), dz = double(z);
+				double p = dx * dy, s = p + dz;
+				if (std::fma(dx, dy, -p) != 0.0 || (s - p) != dz || (s - dz) != p) continue;  // a*b+c is not exact in double
+				ref = s;
+			}
+			if (!same(result, ref)) {
+				++nrOfFailedTestCases;
+				if (reportTestCases) ReportBinaryArithmeticError("FAIL", "fma", x, y, result, ref);
+			}
+		}
+		return nrOfFailedTestCases;
+	}
+
+	template<typename Number, typename CType>
+	int VerifyBatchDot(const BatchApi<CType>& api, bool reportTestCases, size_t nrVectors) {
+		constexpr size_t N = 64;
+		std::mt19937_64 engine(Number::nbits + 2);
+		std::uniform_real_distribution<double> dist(-2.0, 2.0);
+		int nrOfFailedTestCases = 0;
+		for (size_t k = 0; k < nrVectors; ++k) {
+			std::vector<double> dx(N), dy(N);
+			for (size_t i = 0; i < N; ++i) {
+				dx[i] = dist(engine);
+				dy[i] = dist(engine);
+			}
+			std::vector<CType> x(N), y(N);
+			api.fromd(N, dx.data(), x.data());
+			api.fromd(N, dy.data(), y.data());
+			Number result = to_number<Number>(api.dot(N, x.data(), 1, y.data(), 1)), ref;
+			std::vector<Number> vx(N), vy(N);
+			for (size_t i = 0; i < N; ++i) {
+				vx[i] = to_number<Number>(x[i]);
+				vy[i] = to_number<Number>(y[i]);
+			}
+			if constexpr (is_posit<Number>) {
+				ref = fdp(vx, vy);
+			}
+			else {
+				double sum = 0.0;
+				for (size_t i = 0; i < N; ++i) sum += double(vx[i]) * double(vy[i]);
+				ref = sum;
+			}
+			if (!same(result, ref)) {
+				++nrOfFailedTestCases;
+				if (reportTestCases) std::cerr << "FAIL: dot " << result << " != " << ref << '\n';
+			}
+		}
+		return nrOfFailedTestCases;
+	}
+
+	template<typename Number, typename CType>
+	int VerifyBatchKernels(const BatchApi<CType>& api, bool reportTestCases, size_t nrRandoms) {
+		int nrOfFailedTestCases = 0;
+		nrOfFailedTestCases += VerifyBatchConversion<Number>(api, reportTestCases, nrRandoms);
+		nrOfFailedTestCases += VerifyBatchArithmetic<Number>(api, reportTestCases, nrRandoms);
+		nrOfFailedTestCases += VerifyBatchDot<Number>(api, reportTestCases, 32);
+		return nrOfFailedTestCases;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "universal_c batch kernel verification";
+	std::string test_tag    = "batch kernels";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	nrOfFailedTestCases += ReportTestResult(VerifyBatchKernels< posit<16, 1> >(BATCH_API(posit16), reportTestCases, 1000), "posit16", test_tag);
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyBatchKernels< posit<8, 0> >(BATCH_API(posit8), reportTestCases, 0), "posit8", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyBatchKernels< cfloat<8, 2, uint8_t, true, false, false> >(BATCH_API(fp8), reportTestCases, 0), "fp8", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyBatchKernels< cfloat<16, 5, uint16_t, true, false, false> >(BATCH_API(fp16), reportTestCases, 10000), "fp16", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyBatchKernels< cfloat<16, 8, uint16_t, true, false, false> >(BATCH_API(bf16), reportTestCases, 10000), "bf16", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyBatchKernels< lns<16, 8, uint16_t> >(BATCH_API(lns16), reportTestCases, 10000), "lns16", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyBatchKernels< posit<16, 1> >(BATCH_API(posit16), reportTestCases, 10000), "posit16", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyBatchKernels< lns<32, 24, uint32_t> >(BATCH_API(lns32), reportTestCases, 10000), "lns32", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyBatchKernels< posit<32, 2> >(BATCH_API(posit32), reportTestCases, 10000), "posit32", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += ReportTestResult(VerifyBatchKernels< posit<64, 3> >(BATCH_API(posit64), reportTestCases, 1000), "posit64", test_tag);
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught ad-hoc exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Caught unexpected universal arithmetic exception : " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Caught unexpected universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Caught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -256,26 +256,6 @@ void reportType(Ty v) {
 	std::cout << "round_style       : " << std::numeric_limits<Ty>::round_style << '\n';
 }
 
-void findLargestMultipleTest() {
-	sw::universal::edecimal d;
-	int fails = 0;
-	int numerator = 9;
-	d = numerator;
-	for (int i = 0; i < 100; ++i) {
-		sw::universal::edecimal multiple = sw::universal::findLargestMultiple(i, d);
-		if (multiple != (i / 9)) {
-			std::cout << d << " into " << i << " yields multiplier " << multiple << " but should have been " << (i/numerator) << std::endl;
-			++fails;
-		}	
-	}
-	if (fails == 0) {
-		std::cout << "PASS  : findLargestMultipleTest" << std::endl;
-	}
-	else {
-		std::cout << fails << " FAILURES in findLargestMultipleTest"  << std::endl;
-	}
-}
-
 int BigNumberComputation() {
 	using namespace sw::universal;
 
@@ -339,8 +319,6 @@ try {
 
 	//reportType(d1);
 
-	findLargestMultipleTest();
-
 	d1.parse("50000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000");
 	std::cout << "big number :  " << d1 << '\n';
 	std::cout << "doubled    : " << d1 + d1 << std::endl;
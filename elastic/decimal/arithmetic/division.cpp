@@ -9,6 +9,7 @@
 #include <string>
 #include <cmath>
 #include <limits>
+#include <random>
 
 // configure the decimal type
 #define EDECIMAL_THROW_ARITHMETIC_EXCEPTION 1
@@ -88,6 +89,36 @@ namespace sw { namespace universal {
 			return nrOfFailedTests;
 		}
 
+		// verify the long division by limbs through the identity a == (a / b) * b + a % b, with |a % b| < |b|
+		int VerifyLargeEdecimalDivision(bool reportTestCases, size_t maxDigits, int nrTestCases) {
+			std::mt19937_64 engine(maxDigits);
+			std::uniform_int_distribution<size_t> length(1, maxDigits);
+			std::uniform_int_distribution<int> digit(0, 9);
+			auto random = [&](size_t nrDigits) {
+				std::string digits(1, static_cast<char>('1' + digit(engine) % 9));
+				for (size_t i = 1; i < nrDigits; ++i) digits.push_back(static_cast<char>('0' + digit(engine)));
+				edecimal d;
+				d.parse(digits);
+				if (digit(engine) & 0x1) d.setneg();
+				return d;
+			};
+			int nrOfFailedTests = 0;
+			for (int i = 0; i < nrTestCases; ++i) {
+				edecimal a = random(length(engine));
+				edecimal b = random(length(engine));
+				edecimal q = a / b;
+				edecimal r = a % b;
+				edecimal absr(r), absb(b);
+				absr.setpos();
+				absb.setpos();
+				if (q * b + r != a || !(absr < absb)) {
+					nrOfFailedTests++;
+					if (reportTestCases) std::cerr << "FAIL: " << a.digits() << " digits / " << b.digits() << " digits\n";
+				}
+			}
+			return nrOfFailedTests;
+		}
+
 }} // namespace sw::universal
 
 // generate specific test case that you can trace with the trace conditions in mpreal.hpp
@@ -149,6 +180,7 @@ try {
 
 #if REGRESSION_LEVEL_1
 	nrOfFailedTestCases += ReportTestResult(VerifyEdecimalDivision<10>(reportTestCases), "decimal division nbits=10", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyLargeEdecimalDivision(reportTestCases, 1000, 100), "decimal division 1000 digits", test_tag);
 #endif
 
 #if REGRESSION_LEVEL_2
@@ -157,6 +189,7 @@ try {
 
 #if REGRESSION_LEVEL_3
 	nrOfFailedTestCases += ReportTestResult(VerifyEdecimalDivision<32>(reportTestCases), "decimal division nbits=32", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyLargeEdecimalDivision(reportTestCases, 20000, 100), "decimal division 20000 digits", test_tag);
 #endif
 
 #if REGRESSION_LEVEL_4
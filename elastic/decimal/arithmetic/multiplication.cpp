@@ -9,6 +9,7 @@
 #include <string>
 #include <cmath>
 #include <limits>
+#include <random>
 
 // minimum set of include files to reflect source code dependencies
 #include <universal/number/edecimal/edecimal.hpp>
@@ -67,6 +68,42 @@ namespace sw { namespace universal {
 			return nrOfFailedTests;
 		}
 
+		// generate a random decimal integer with the given number of digits
+		template<typename RandomEngine>
+		edecimal RandomEdecimal(RandomEngine& engine, size_t nrDigits) {
+			std::uniform_int_distribution<int> digit(0, 9);
+			std::string digits(1, static_cast<char>('1' + digit(engine) % 9));
+			for (size_t i = 1; i < nrDigits; ++i) digits.push_back(static_cast<char>('0' + digit(engine)));
+			edecimal d;
+			d.parse(digits);
+			if (digit(engine) & 0x1) d.setneg();
+			return d;
+		}
+
+		// verify the Karatsuba multiplier against the schoolbook multiplier for operands of up to maxDigits digits
+		int VerifyLargeEdecimalMultiplication(bool reportTestCases, size_t maxDigits, int nrTestCases) {
+			using limb = edecimal::limb;
+			std::mt19937_64 engine(maxDigits);
+			std::uniform_int_distribution<size_t> length(1, maxDigits);
+			int nrOfFailedTests = 0;
+			for (int i = 0; i < nrTestCases; ++i) {
+				edecimal a = RandomEdecimal(engine, length(engine));
+				edecimal b = RandomEdecimal(engine, length(engine));
+				edecimal c = a * b;
+				std::vector<limb> product(a.size() + b.size(), 0);
+				edecimal::multiply_schoolbook(a.data(), a.size(), b.data(), b.size(), product.data());
+				edecimal cref;
+				cref.assign(product.begin(), product.end());
+				cref.unpad();
+				cref.setsign(a.sign() != b.sign());
+				if (c != cref) {
+					nrOfFailedTests++;
+					if (reportTestCases) std::cerr << "FAIL: " << a.digits() << " digits * " << b.digits() << " digits\n";
+				}
+			}
+			return nrOfFailedTests;
+		}
+
 } } // namespace sw::universal
 
 // generate specific test case that you can trace with the trace conditions in mpreal.hpp
@@ -129,6 +166,7 @@ try {
 
 #if REGRESSION_LEVEL_1
 	nrOfFailedTestCases += ReportTestResult(VerifyEdecimalMultiplication<10>(reportTestCases), "decimal multiplication nbits=10", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyLargeEdecimalMultiplication(reportTestCases, 1000, 100), "decimal multiplication 1000 digits", test_tag);
 #endif
 
 #if REGRESSION_LEVEL_2
@@ -137,6 +175,7 @@ try {
 
 #if REGRESSION_LEVEL_3
 	nrOfFailedTestCases += ReportTestResult(VerifyEdecimalMultiplication<32>(reportTestCases), "decimal multiplication nbits=32", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyLargeEdecimalMultiplication(reportTestCases, 20000, 100), "decimal multiplication 20000 digits", test_tag);
 #endif
 
 #if REGRESSION_LEVEL_4
@@ -0,0 +1,129 @@
+// einteger.cpp: test suite runner for conversions between adaptive precision decimal and binary integers
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <random>
+
+// minimum set of include files to reflect source code dependencies
+#include <universal/number/edecimal/edecimal.hpp>
+#include <universal/number/einteger/einteger.hpp>
+#include <universal/verification/test_reporters.hpp>
+
+namespace sw { namespace universal {
+
+	// verify the string and einteger round trips of random decimal integers of up to maxDigits digits
+	template<typename BlockType>
+	int VerifyEdecimalRoundTrip(bool reportTestCases, size_t maxDigits, int nrTestCases) {
+		std::mt19937_64 engine(maxDigits);
+		std::uniform_int_distribution<size_t> length(1, maxDigits);
+		std::uniform_int_distribution<int> digit(0, 9);
+		int nrOfFailedTests = 0;
+		for (int i = 0; i < nrTestCases; ++i) {
+			size_t nrDigits = length(engine);
+			std::string digits;
+			if (digit(engine) & 0x1) digits.push_back('-');
+			digits.push_back(static_cast<char>('1' + digit(engine) % 9));
+			for (size_t j = 1; j < nrDigits; ++j) digits.push_back(static_cast<char>('0' + digit(engine)));
+
+			edecimal d;
+			d.parse(digits);
+			if (to_string(d) != digits) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: string round trip of " << digits << " yields " << d << '\n';
+			}
+			einteger<BlockType> e = to_einteger<BlockType>(d);
+			edecimal roundtrip = to_edecimal(e);
+			if (roundtrip != d) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: einteger round trip of " << d << " yields " << roundtrip << '\n';
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 0
+#define REGRESSION_LEVEL_4 0
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "adaptive precision decimal integer conversion to/from einteger";
+	std::string test_tag    = "edecimal <-> einteger";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	edecimal d;
+	d.parse("123456789012345678901234567890");
+	einteger<std::uint32_t> e = to_einteger(d);
+	std::cout << d << " : " << e << " : " << to_edecimal(e) << '\n';
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyEdecimalRoundTrip<std::uint8_t>(reportTestCases, 100, 100), "einteger<uint8_t> 100 digits", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyEdecimalRoundTrip<std::uint16_t>(reportTestCases, 100, 100), "einteger<uint16_t> 100 digits", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyEdecimalRoundTrip<std::uint32_t>(reportTestCases, 100, 100), "einteger<uint32_t> 100 digits", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyEdecimalRoundTrip<std::uint32_t>(reportTestCases, 2000, 100), "einteger<uint32_t> 2000 digits", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyEdecimalRoundTrip<std::uint32_t>(reportTestCases, 20000, 20), "einteger<uint32_t> 20000 digits", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_4
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught ad-hoc exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Caught unexpected universal arithmetic exception : " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Caught unexpected universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << '\n';
+	return EXIT_FAILURE;
+}
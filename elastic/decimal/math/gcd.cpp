@@ -0,0 +1,139 @@
+// gcd.cpp: test suite runner for the greatest common divisor of adaptive precision decimal integers
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <random>
+
+// minimum set of include files to reflect source code dependencies
+#include <universal/number/edecimal/edecimal.hpp>
+#include <universal/verification/test_reporters.hpp>
+
+namespace sw { namespace universal {
+
+	// reference Euclid algorithm
+	edecimal EuclidGcd(edecimal a, edecimal b) {
+		a.setpos(); b.setpos();
+		while (!b.iszero()) {
+			edecimal r = a % b;
+			a = b;
+			b = r;
+		}
+		return a;
+	}
+
+	edecimal RandomDecimal(std::mt19937_64& engine, size_t nrDigits) {
+		std::uniform_int_distribution<int> digit(0, 9);
+		std::string digits;
+		digits.push_back(static_cast<char>('1' + digit(engine) % 9));
+		for (size_t j = 1; j < nrDigits; ++j) digits.push_back(static_cast<char>('0' + digit(engine)));
+		edecimal d;
+		d.parse(digits);
+		return d;
+	}
+
+	// verify Lehmer's gcd against Euclid on operands that share a random common factor
+	int VerifyEdecimalGcd(bool reportTestCases, size_t maxDigits, int nrTestCases) {
+		std::mt19937_64 engine(maxDigits);
+		std::uniform_int_distribution<size_t> length(1, maxDigits);
+		int nrOfFailedTests = 0;
+		for (int i = 0; i < nrTestCases; ++i) {
+			edecimal g = RandomDecimal(engine, length(engine) / 2 + 1);
+			edecimal a = g * RandomDecimal(engine, length(engine));
+			edecimal b = g * RandomDecimal(engine, length(engine));
+			if (i & 0x1) a.setneg();
+			edecimal ref = EuclidGcd(a, b);
+			edecimal result = gcd(a, b);
+			if (result != ref || !(a % result).iszero() || !(b % result).iszero()) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: gcd(" << a << ", " << b << ") = " << result << " reference " << ref << '\n';
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 0
+#define REGRESSION_LEVEL_4 0
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "adaptive precision decimal integer greatest common divisor";
+	std::string test_tag    = "gcd";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	edecimal a, b;
+	a.parse("1234567890123456789012345678901234567890");
+	b.parse("9876543210987654321098765432109876543210");
+	std::cout << "gcd(" << a << ", " << b << ") = " << gcd(a, b) << '\n';
+	std::cout << "binary_gcd(48, 180) = " << binary_gcd(48, 180) << '\n';
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult((binary_gcd(48, 180) == 12 && binary_gcd(0, 7) == 7 && binary_gcd(17, 5) == 1) ? 0 : 1, "binary_gcd", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyEdecimalGcd(reportTestCases, 40, 200), "edecimal 40 digits", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyEdecimalGcd(reportTestCases, 400, 100), "edecimal 400 digits", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyEdecimalGcd(reportTestCases, 4000, 20), "edecimal 4000 digits", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_4
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught ad-hoc exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Caught unexpected universal arithmetic exception : " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Caught unexpected universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << '\n';
+	return EXIT_FAILURE;
+}
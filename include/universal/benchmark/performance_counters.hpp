@@ -0,0 +1,282 @@
+#pragma once
+// performance_counters.hpp: hardware performance counter instrumentation of the performance runner
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <cstring>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <universal/benchmark/performance_runner.hpp>
+
+// on Linux the counters are read through perf_event_open, on other platforms only the elapsed time is measured
+#if !defined(UNIVERSAL_PERFORMANCE_COUNTERS)
+#if defined(__linux__)
+#define UNIVERSAL_PERFORMANCE_COUNTERS 1
+#else
+#define UNIVERSAL_PERFORMANCE_COUNTERS 0
+#endif
+#endif
+
+#if UNIVERSAL_PERFORMANCE_COUNTERS
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace sw { namespace universal {
+
+	// the events measured for a workload
+	enum class PerformanceEvent : unsigned { cycles = 0, instructions, branches, branchMisses, l1dMisses, llcMisses, taskClock, NR_EVENTS };
+	constexpr unsigned NR_PERFORMANCE_EVENTS = static_cast<unsigned>(PerformanceEvent::NR_EVENTS);
+
+	inline const char* performance_event_name(PerformanceEvent e) {
+		switch (e) {
+		case PerformanceEvent::cycles:       return "cycles";
+		case PerformanceEvent::instructions: return "instructions";
+		case PerformanceEvent::branches:     return "branches";
+		case PerformanceEvent::branchMisses: return "branch_misses";
+		case PerformanceEvent::l1dMisses:    return "l1d_misses";
+		case PerformanceEvent::llcMisses:    return "llc_misses";
+		case PerformanceEvent::taskClock:    return "task_clock_ns";
+		default:                             return "unknown";
+		}
+	}
+
+	// counter values of a single measurement: an event the platform or the permissions do not provide is marked unavailable
+	struct PerformanceCounters {
+		PerformanceCounters() : nrOps{ 0 }, elapsed{ 0.0 }, count{}, available{} {}
+
+		size_t nrOps;
+		double elapsed;  // wall clock seconds
+		uint64_t count[NR_PERFORMANCE_EVENTS];
+		bool available[NR_PERFORMANCE_EVENTS];
+
+		bool     has(PerformanceEvent e) const noexcept { return available[static_cast<unsigned>(e)]; }
+		uint64_t operator[](PerformanceEvent e) const noexcept { return count[static_cast<unsigned>(e)]; }
+
+		double ops_per_second() const noexcept { return (elapsed > 0.0 ? double(nrOps) / elapsed : 0.0); }
+		// instructions per cycle, and the per operation rates, are 0 when the underlying counters are unavailable
+		double ipc() const noexcept {
+			return (has(PerformanceEvent::cycles) && has(PerformanceEvent::instructions) && count[0] > 0) ? double(count[1]) / double(count[0]) : 0.0;
+		}
+		double per_op(PerformanceEvent e) const noexcept {
+			return (has(e) && nrOps > 0) ? double((*this)[e]) / double(nrOps) : 0.0;
+		}
+	};
+
+	// a perf_event group on the calling thread, counting user space only: cycles leads the group, so that
+	// all events are scheduled on the PMU together, count the same interval, and are read with a single read()
+	class PerformanceCounterGroup {
+	public:
+		PerformanceCounterGroup() : leader{ -1 }, nrMembers{ 0 }, fd{}, member{} {
+			for (unsigned i = 0; i < NR_PERFORMANCE_EVENTS; ++i) {
+				// an event that cannot be opened is left out, and the first event that opens leads the group
+				fd[i] = open_event(static_cast<PerformanceEvent>(i), leader);
+				if (fd[i] < 0) continue;
+				if (leader < 0) leader = fd[i];
+				member[nrMembers++] = i;
+			}
+		}
+		~PerformanceCounterGroup() {
+#if UNIVERSAL_PERFORMANCE_COUNTERS
+			for (unsigned i = 0; i < NR_PERFORMANCE_EVENTS; ++i) if (fd[i] >= 0 && fd[i] != leader) close(fd[i]);
+			if (leader >= 0) close(leader);
+#endif
+		}
+		PerformanceCounterGroup(const PerformanceCounterGroup&) = delete;
+		PerformanceCounterGroup& operator=(const PerformanceCounterGroup&) = delete;
+
+		bool available(PerformanceEvent e) const noexcept { return fd[static_cast<unsigned>(e)] >= 0; }
+
+		void start() noexcept {
+#if UNIVERSAL_PERFORMANCE_COUNTERS
+			if (leader < 0) return;
+			ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+			ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+		}
+		void stop(PerformanceCounters& counters) noexcept {
+			for (unsigned i = 0; i < NR_PERFORMANCE_EVENTS; ++i) {
+				counters.available[i] = false;
+				counters.count[i] = 0;
+			}
+#if UNIVERSAL_PERFORMANCE_COUNTERS
+			if (leader < 0) return;
+			ioctl(leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+			// PERF_FORMAT_GROUP layout: nr, time enabled, time running, followed by the member values in the order they were opened
+			uint64_t value[3 + NR_PERFORMANCE_EVENTS] = {};
+			ssize_t size = static_cast<ssize_t>((3 + nrMembers) * sizeof(uint64_t));
+			if (read(leader, value, sizeof(value)) != size || value[0] != nrMembers || value[2] == 0) return;
+			// with the group multiplexed on the PMU, the counts are scaled by the fraction of time it was scheduled
+			double scale = (value[2] < value[1]) ? double(value[1]) / double(value[2]) : 1.0;
+			for (unsigned m = 0; m < nrMembers; ++m) {
+				unsigned i = member[m];
+				counters.count[i] = (scale != 1.0) ? static_cast<uint64_t>(double(value[3 + m]) * scale) : value[3 + m];
+				counters.available[i] = true;
+			}
+#endif
+		}
+
+	private:
+		int leader;
+		unsigned nrMembers;
+		int fd[NR_PERFORMANCE_EVENTS];
+		unsigned member[NR_PERFORMANCE_EVENTS];  // event index of each group member, in read() order
+
+		static int open_event(PerformanceEvent e, int groupFd) noexcept {
+#if UNIVERSAL_PERFORMANCE_COUNTERS
+			perf_event_attr attr;
+			std::memset(&attr, 0, sizeof(attr));
+			attr.size = sizeof(attr);
+			// the leader starts disabled and enables the whole group, the members follow the leader
+			attr.disabled = (groupFd < 0 ? 1 : 0);
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+			constexpr uint64_t l1dReadMiss = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+			switch (e) {
+			case PerformanceEvent::cycles:       attr.type = PERF_TYPE_HARDWARE; attr.config = PERF_COUNT_HW_CPU_CYCLES; break;
+			case PerformanceEvent::instructions: attr.type = PERF_TYPE_HARDWARE; attr.config = PERF_COUNT_HW_INSTRUCTIONS; break;
+			case PerformanceEvent::branches:     attr.type = PERF_TYPE_HARDWARE; attr.config = PERF_COUNT_HW_BRANCH_INSTRUCTIONS; break;
+			case PerformanceEvent::branchMisses: attr.type = PERF_TYPE_HARDWARE; attr.config = PERF_COUNT_HW_BRANCH_MISSES; break;
+			case PerformanceEvent::l1dMisses:    attr.type = PERF_TYPE_HW_CACHE; attr.config = l1dReadMiss; break;
+			case PerformanceEvent::llcMisses:    attr.type = PERF_TYPE_HARDWARE; attr.config = PERF_COUNT_HW_CACHE_MISSES; break;
+			case PerformanceEvent::taskClock:    attr.type = PERF_TYPE_SOFTWARE; attr.config = PERF_COUNT_SW_TASK_CLOCK; break;
+			default: return -1;
+			}
+			// the event is unavailable when the PMU does not exist, as in many virtual machines, or perf_event_paranoid forbids it
+			return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, 0));
+#else
+			(void)e; (void)groupFd;
+			return -1;
+#endif
+		}
+	};
+
+	// the counter set is opened once per thread: opening the events costs several system calls
+	inline PerformanceCounterGroup& performance_counter_group() {
+		thread_local PerformanceCounterGroup group;
+		return group;
+	}
+
+	// measure a workload function that enumerates an operator NR_OPS times
+	template<typename Workload>
+	PerformanceCounters MeasurePerformanceCounters(Workload&& f, size_t NR_OPS) {
+		PerformanceCounters counters;
+		counters.nrOps = NR_OPS;
+		PerformanceCounterGroup& group = performance_counter_group();
+		std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+		group.start();
+		f(NR_OPS);
+		group.stop(counters);
+		std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+		counters.elapsed = std::chrono::duration<double>(end - begin).count();
+		return counters;
+	}
+
+	// generic test runner with hardware counters, prints the PerformanceRunner line followed by the counter rates
+	inline PerformanceCounters PerformanceCounterRunner(const std::string& tag, void (f)(size_t), size_t NR_OPS) {
+		PerformanceCounters counters = MeasurePerformanceCounters(f, NR_OPS);
+		std::cout << tag << ' ' << std::setw(10) << NR_OPS << " per " << std::setw(15) << counters.elapsed << "sec -> " << toPowerOfTen(counters.ops_per_second()) << "ops/sec";
+		if (counters.has(PerformanceEvent::instructions)) {
+			std::cout << " : IPC " << std::setprecision(3) << counters.ipc()
+				<< ", instr/op " << counters.per_op(PerformanceEvent::instructions)
+				<< ", branch-misses/op " << counters.per_op(PerformanceEvent::branchMisses)
+				<< ", L1D-misses/op " << counters.per_op(PerformanceEvent::l1dMisses)
+				<< ", LLC-misses/op " << counters.per_op(PerformanceEvent::llcMisses);
+		}
+		else {
+			std::cout << " : hardware counters unavailable";
+		}
+		std::cout << std::endl;
+		return counters;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// machine readable reports, one record per (number system, operator) measurement
+
+	struct PerformanceRecord {
+		std::string numberSystem;
+		std::string op;
+		PerformanceCounters counters;
+	};
+
+	inline void WritePerformanceCsvHeader(std::ostream& ostr) {
+		ostr << "number_system,operator,ops,seconds,ops_per_second";
+		for (unsigned i = 0; i < NR_PERFORMANCE_EVENTS; ++i) ostr << ',' << performance_event_name(static_cast<PerformanceEvent>(i));
+		ostr << ",ipc\n";
+	}
+
+	// unavailable counters are written as empty fields
+	inline void WritePerformanceCsv(std::ostream& ostr, const PerformanceRecord& r) {
+		std::stringstream s;
+		s << std::setprecision(6);
+		s << '"' << r.numberSystem << "\"," << r.op << ',' << r.counters.nrOps << ',' << r.counters.elapsed << ',' << r.counters.ops_per_second();
+		for (unsigned i = 0; i < NR_PERFORMANCE_EVENTS; ++i) {
+			s << ',';
+			if (r.counters.available[i]) s << r.counters.count[i];
+		}
+		s << ',';
+		if (r.counters.has(PerformanceEvent::instructions) && r.counters.has(PerformanceEvent::cycles)) s << r.counters.ipc();
+		ostr << s.str() << '\n';
+	}
+
+	inline void WritePerformanceCsv(std::ostream& ostr, const std::vector<PerformanceRecord>& records) {
+		WritePerformanceCsvHeader(ostr);
+		for (const auto& r : records) WritePerformanceCsv(ostr, r);
+	}
+
+	// JSON string contents: quotes, backslashes and control characters are escaped
+	inline std::string json_escape(const std::string& str) {
+		std::stringstream s;
+		for (char c : str) {
+			switch (c) {
+			case '"':  s << "\\\""; break;
+			case '\\': s << "\\\\"; break;
+			case '\b': s << "\\b"; break;
+			case '\f': s << "\\f"; break;
+			case '\n': s << "\\n"; break;
+			case '\r': s << "\\r"; break;
+			case '\t': s << "\\t"; break;
+			default:
+				if (static_cast<unsigned char>(c) < 0x20) {
+					s << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<unsigned>(c) << std::dec << std::setfill(' ');
+				}
+				else {
+					s << c;
+				}
+			}
+		}
+		return s.str();
+	}
+
+	// unavailable counters are written as null
+	inline void WritePerformanceJson(std::ostream& ostr, const std::vector<PerformanceRecord>& records) {
+		std::stringstream s;
+		s << std::setprecision(6);
+		s << "[\n";
+		for (size_t r = 0; r < records.size(); ++r) {
+			const PerformanceCounters& c = records[r].counters;
+			s << "  { \"number_system\": \"" << json_escape(records[r].numberSystem) << "\", \"operator\": \"" << json_escape(records[r].op) << "\""
+				<< ", \"ops\": " << c.nrOps << ", \"seconds\": " << c.elapsed << ", \"ops_per_second\": " << c.ops_per_second();
+			for (unsigned i = 0; i < NR_PERFORMANCE_EVENTS; ++i) {
+				s << ", \"" << performance_event_name(static_cast<PerformanceEvent>(i)) << "\": ";
+				if (c.available[i]) s << c.count[i]; else s << "null";
+			}
+			s << ", \"ipc\": ";
+			if (c.has(PerformanceEvent::instructions) && c.has(PerformanceEvent::cycles)) s << c.ipc(); else s << "null";
+			s << " }" << (r + 1 < records.size() ? ",\n" : "\n");
+		}
+		s << "]\n";
+		ostr << s.str();
+	}
+
+}} // namespace sw::universal
@@ -1,4 +1,5 @@
-//  performance_runner.cpp : functions to aid in performance testing and reporting
+#pragma once
+// performance_runner.hpp: functions to aid in performance testing and reporting
 //
 // Copyright (C) 2017-2022 Stillwater Supercomputing, Inc.
 //
@@ -121,7 +122,7 @@ namespace sw { namespace universal {
 	}
 
 	// generic test runner, takes a function that enumerates an operator NR_OPS time, and measures elapsed time
-	void PerformanceRunner(const std::string& tag, void (f)(size_t), size_t NR_OPS) {
+	inline void PerformanceRunner(const std::string& tag, void (f)(size_t), size_t NR_OPS) {
 		using namespace std;
 		using namespace std::chrono;
 
@@ -0,0 +1,216 @@
+#pragma once
+// performance_sweep.hpp: type-list driven benchmark sweeps with repetition statistics and JSON regression reports
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include <universal/native/ieee754_type_tag.hpp>
+#include <universal/utility/scientific.hpp>
+#include <universal/benchmark/performance_runner.hpp>
+
+/*
+    A sweep instantiates a set of workloads for every number system of a std::tuple:
+
+        using Types = std::tuple< posit<16,1>, posit<32,2>, cfloat<32,8,uint32_t,true,false,false> >;
+        auto records = PerformanceSweep<Types>(config, AdditionSubtraction{}, Multiplication{});
+
+    so adding a number system to a benchmark is one entry in the type list. A workload is a type
+    with a name() and a call operator templated on the number system, that enumerates an operator
+    NR_OPS times, like the workloads of performance_runner.hpp which are wrapped below.
+
+    Every (number system, workload) pair is calibrated until a run takes at least minSeconds, run
+    warmup times untimed, and then timed over repetitions runs. The median and the median absolute
+    deviation (MAD) of those runs are robust against the occasional preempted run, and the JSON
+    report of the records can be compared against a baseline with CompareSweeps.
+*/
+
+namespace sw { namespace universal {
+
+	struct SweepConfiguration {
+		size_t nrOps       = 1000;     // initial number of operations, doubled until a run takes minSeconds
+		size_t maxOps      = size_t(1) << 30;
+		double minSeconds  = 0.02;
+		unsigned warmup      = 1;
+		unsigned repetitions = 7;
+	};
+
+	struct SweepRecord {
+		std::string numberSystem;
+		std::string workload;
+		size_t nrOps = 0;
+		unsigned repetitions = 0;
+		double median = 0.0;           // seconds per run
+		double mad = 0.0;              // median absolute deviation of the seconds per run
+		double min = 0.0;
+		double pops() const noexcept { return (median > 0.0 ? double(nrOps) / median : 0.0); }
+	};
+
+	// workloads of performance_runner.hpp
+	struct AdditionSubtraction {
+		const char* name() const noexcept { return "add/sub"; }
+		template<typename Scalar> void operator()(size_t NR_OPS) const { AdditionSubtractionWorkload<Scalar>(NR_OPS); }
+	};
+	struct Multiplication {
+		const char* name() const noexcept { return "mul"; }
+		template<typename Scalar> void operator()(size_t NR_OPS) const { MultiplicationWorkload<Scalar>(NR_OPS); }
+	};
+	struct Division {
+		const char* name() const noexcept { return "div"; }
+		template<typename Scalar> void operator()(size_t NR_OPS) const { DivisionWorkload<Scalar>(NR_OPS); }
+	};
+	struct Construction {
+		const char* name() const noexcept { return "construct"; }
+		template<typename Scalar> void operator()(size_t NR_OPS) const { ConstructionPerformanceWorkload<Scalar>(NR_OPS); }
+	};
+
+	namespace sweep_internal {
+
+		inline double median(std::vector<double> v) {
+			if (v.empty()) return 0.0;
+			size_t mid = v.size() / 2;
+			std::nth_element(v.begin(), v.begin() + static_cast<std::ptrdiff_t>(mid), v.end());
+			double m = v[mid];
+			if (v.size() % 2 == 0) m = (m + *std::max_element(v.begin(), v.begin() + static_cast<std::ptrdiff_t>(mid))) / 2.0;
+			return m;
+		}
+
+		template<typename Scalar, typename Workload>
+		double timed_run(const Workload& workload, size_t NR_OPS) {
+			std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+			workload.template operator()<Scalar>(NR_OPS);
+			std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+			return std::chrono::duration<double>(end - begin).count();
+		}
+
+		template<typename Scalar, typename Workload>
+		SweepRecord measure(const SweepConfiguration& config, const Workload& workload) {
+			SweepRecord record;
+			record.numberSystem = type_tag(Scalar());
+			record.workload = workload.name();
+			size_t NR_OPS = std::max<size_t>(1, config.nrOps);
+			while (timed_run<Scalar>(workload, NR_OPS) < config.minSeconds && NR_OPS < config.maxOps) NR_OPS *= 2;
+			for (unsigned w = 0; w < config.warmup; ++w) timed_run<Scalar>(workload, NR_OPS);
+			std::vector<double> seconds;
+			for (unsigned r = 0; r < std::max(1u, config.repetitions); ++r) seconds.push_back(timed_run<Scalar>(workload, NR_OPS));
+			record.nrOps = NR_OPS;
+			record.repetitions = unsigned(seconds.size());
+			record.median = median(seconds);
+			record.min = *std::min_element(seconds.begin(), seconds.end());
+			std::vector<double> deviation;
+			for (double s : seconds) deviation.push_back(std::abs(s - record.median));
+			record.mad = median(deviation);
+			return record;
+		}
+
+		template<typename... Scalars, typename... Workloads>
+		void sweep(std::tuple<Scalars...>*, const SweepConfiguration& config, std::vector<SweepRecord>& records, const Workloads&... workloads) {
+			// types in the outer, workloads in the inner loop, in the order of the lists
+			auto sweepType = [&](auto* type) {
+				using Scalar = std::remove_pointer_t<decltype(type)>;
+				(records.push_back(measure<Scalar>(config, workloads)), ...);
+			};
+			(sweepType(static_cast<Scalars*>(nullptr)), ...);
+		}
+
+	} // namespace sweep_internal
+
+	// run every workload for every number system of the std::tuple TypeList
+	template<typename TypeList, typename... Workloads>
+	std::vector<SweepRecord> PerformanceSweep(const SweepConfiguration& config, const Workloads&... workloads) {
+		std::vector<SweepRecord> records;
+		sweep_internal::sweep(static_cast<TypeList*>(nullptr), config, records, workloads...);
+		return records;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// reports
+
+	inline std::string ReportSweep(const std::vector<SweepRecord>& records) {
+		std::stringstream ostr;
+		ostr << std::setw(45) << std::left << "number system" << std::setw(12) << "workload" << std::right
+			<< std::setw(12) << "ops" << std::setw(15) << "median [s]" << std::setw(10) << "MAD %" << std::setw(15) << "POPS" << '\n';
+		for (const auto& r : records) {
+			ostr << std::setw(45) << std::left << r.numberSystem << std::setw(12) << r.workload << std::right
+				<< std::setw(12) << r.nrOps << std::setw(15) << std::setprecision(6) << r.median
+				<< std::setw(10) << std::setprecision(3) << (r.median > 0.0 ? 100.0 * r.mad / r.median : 0.0)
+				<< std::setw(15) << to_scientific(r.pops()) << '\n';
+		}
+		return ostr.str();
+	}
+
+	// one record per line, so that sweeps of two commits diff line by line
+	inline void WriteSweepJson(std::ostream& ostr, const std::vector<SweepRecord>& records) {
+		std::stringstream s;
+		s << std::setprecision(9);
+		s << "[\n";
+		for (size_t i = 0; i < records.size(); ++i) {
+			const SweepRecord& r = records[i];
+			s << "  { \"number_system\": \"" << r.numberSystem << "\", \"workload\": \"" << r.workload << "\""
+				<< ", \"ops\": " << r.nrOps << ", \"repetitions\": " << r.repetitions
+				<< ", \"median_seconds\": " << r.median << ", \"mad_seconds\": " << r.mad << ", \"min_seconds\": " << r.min
+				<< ", \"pops\": " << r.pops() << " }" << (i + 1 < records.size() ? ",\n" : "\n");
+		}
+		s << "]\n";
+		ostr << s.str();
+	}
+
+	// read the records written by WriteSweepJson
+	inline std::vector<SweepRecord> ReadSweepJson(std::istream& istr) {
+		std::vector<SweepRecord> records;
+		auto field = [](const std::string& line, const std::string& key) {
+			std::smatch match;
+			std::regex pattern("\"" + key + "\": (\"([^\"]*)\"|([-+0-9.eE]+))");
+			if (!std::regex_search(line, match, pattern)) return std::string();
+			return (match[2].matched ? match[2].str() : match[3].str());
+		};
+		std::string line;
+		while (std::getline(istr, line)) {
+			if (line.find("\"number_system\"") == std::string::npos) continue;
+			SweepRecord r;
+			r.numberSystem = field(line, "number_system");
+			r.workload = field(line, "workload");
+			r.nrOps = size_t(std::stoull(field(line, "ops")));
+			r.repetitions = unsigned(std::stoul(field(line, "repetitions")));
+			r.median = std::stod(field(line, "median_seconds"));
+			r.mad = std::stod(field(line, "mad_seconds"));
+			r.min = std::stod(field(line, "min_seconds"));
+			records.push_back(r);
+		}
+		return records;
+	}
+
+	struct SweepRegression {
+		std::string numberSystem;
+		std::string workload;
+		double baselinePops;
+		double currentPops;
+		double ratio() const noexcept { return (baselinePops > 0.0 ? currentPops / baselinePops : 0.0); }
+	};
+
+	// a regression is a slowdown by more than the tolerance that is also outside three times the combined MAD of the two runs
+	inline std::vector<SweepRegression> CompareSweeps(const std::vector<SweepRecord>& baseline, const std::vector<SweepRecord>& current, double tolerance = 0.05) {
+		std::vector<SweepRegression> regressions;
+		for (const auto& c : current) {
+			auto b = std::find_if(baseline.begin(), baseline.end(), [&](const SweepRecord& r) { return r.numberSystem == c.numberSystem && r.workload == c.workload; });
+			if (b == baseline.end() || b->nrOps == 0 || c.nrOps == 0) continue;
+			// compare seconds per operation, the calibration may have picked different operation counts
+			double bs = b->median / double(b->nrOps), cs = c.median / double(c.nrOps);
+			double noise = 3.0 * (b->mad / double(b->nrOps) + c.mad / double(c.nrOps));
+			if (cs > bs * (1.0 + tolerance) && cs - bs > noise) regressions.push_back({ c.numberSystem, c.workload, b->pops(), c.pops() });
+		}
+		return regressions;
+	}
+
+}} // namespace sw::universal
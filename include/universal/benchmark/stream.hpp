@@ -0,0 +1,331 @@
+#pragma once
+// stream.hpp: multi-threaded STREAM kernels for arbitrary number systems, with a roofline classification
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <iomanip>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+/*
+    STREAM (McCalpin) measures the sustainable memory bandwidth of four kernels
+
+        Copy   c = a              2 words/element   0 ops/element
+        Scale  b = q c            2 words/element   1 op/element
+        Add    c = a + b          3 words/element   1 op/element
+        Triad  a = b + q c        3 words/element   2 ops/element
+
+    For an emulated number system the same kernels can become compute-bound: a posit add costs
+    tens of instructions, and the element size shrinks to one or two bytes. The kernels here run
+    on a team of pinned threads over cache-line aligned arrays. The arrays are constructed by
+    the thread that later streams through that part of them (first touch), so on a NUMA machine
+    every thread reads memory on its own node.
+
+    The roofline of a number system is its in-cache compute rate P (Triad on L1-resident data,
+    ops/s) against the machine bandwidth B (bytes/s). Its ridge point P/B (ops/byte) is where the
+    type crosses over from bandwidth-bound to compute-bound. A kernel with a lower arithmetic
+    intensity, like Triad at 2 ops per 3 elements, runs at the bandwidth roof, and one with a
+    higher intensity runs at the compute roof. B is only a memory bandwidth when the arrays do not
+    fit in the last level cache, so the roofline is only meaningful for arrays that exceed it.
+*/
+
+namespace sw { namespace universal {
+
+	constexpr size_t STREAM_CACHE_LINE = 64;
+
+	// size of the last level cache in bytes, 32MB when the platform does not report it
+	inline size_t stream_last_level_cache() {
+		long bytes = 0;
+#if defined(__linux__) && defined(_SC_LEVEL3_CACHE_SIZE)
+		bytes = sysconf(_SC_LEVEL3_CACHE_SIZE);
+		if (bytes <= 0) bytes = sysconf(_SC_LEVEL2_CACHE_SIZE);
+#endif
+		return (bytes > 0 ? size_t(bytes) : (size_t(32) << 20));
+	}
+	// the three STREAM arrays of n elements do not fit in the last level cache, so the kernels measure memory bandwidth
+	inline bool stream_exceeds_cache(size_t n, size_t bytesPerElement) {
+		return 3 * n * bytesPerElement > stream_last_level_cache();
+	}
+
+	// a team of worker threads, pinned round-robin to the cores, that runs a task on every thread and waits for all of them
+	class stream_team {
+	public:
+		explicit stream_team(unsigned nrThreads) : _size(std::max(1u, nrThreads)), _generation(0), _pending(0), _stop(false) {
+			unsigned nrCores = std::max(1u, std::thread::hardware_concurrency());
+			for (unsigned t = 0; t < _size; ++t) {
+				_workers.emplace_back([this, t]() { work(t); });
+				pin(_workers.back(), t % nrCores);
+			}
+		}
+		~stream_team() {
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				_stop = true;
+				++_generation;
+			}
+			_start.notify_all();
+			for (auto& w : _workers) w.join();
+		}
+		stream_team(const stream_team&) = delete;
+		stream_team& operator=(const stream_team&) = delete;
+
+		unsigned size() const noexcept { return _size; }
+
+		// [begin, end) of thread t's share of n elements
+		size_t begin(size_t n, unsigned t) const noexcept { return n * t / _size; }
+		size_t end(size_t n, unsigned t) const noexcept { return n * (t + 1) / _size; }
+
+		// run task(t) on every thread t of the team
+		void run(const std::function<void(unsigned)>& task) {
+			std::unique_lock<std::mutex> lock(_mutex);
+			_task = &task;
+			_pending = _size;
+			++_generation;
+			_start.notify_all();
+			_done.wait(lock, [this] { return _pending == 0; });
+			_task = nullptr;
+		}
+
+	private:
+		unsigned _size;
+		std::vector<std::thread> _workers;
+		std::mutex _mutex;
+		std::condition_variable _start, _done;
+		size_t _generation;
+		unsigned _pending;
+		bool _stop;
+		const std::function<void(unsigned)>* _task = nullptr;
+
+		void work(unsigned t) {
+			size_t seen = 0;
+			for (;;) {
+				const std::function<void(unsigned)>* task;
+				{
+					std::unique_lock<std::mutex> lock(_mutex);
+					_start.wait(lock, [&] { return _generation != seen; });
+					seen = _generation;
+					if (_stop) return;
+					task = _task;
+				}
+				(*task)(t);
+				{
+					std::lock_guard<std::mutex> lock(_mutex);
+					if (--_pending == 0) _done.notify_one();
+				}
+			}
+		}
+
+		static void pin(std::thread& thread, unsigned core) {
+#if defined(__linux__)
+			cpu_set_t cpus;
+			CPU_ZERO(&cpus);
+			CPU_SET(core, &cpus);
+			pthread_setaffinity_np(thread.native_handle(), sizeof(cpus), &cpus);  // best effort: a restricted cpuset keeps the default
+#else
+			(void)thread; (void)core;
+#endif
+		}
+	};
+
+	// cache-line aligned array whose elements are constructed by the team thread that owns them in the kernels
+	template<typename Scalar>
+	class stream_array {
+	public:
+		stream_array(stream_team& team, size_t n, const Scalar& value) : _n(n) {
+			_data = static_cast<Scalar*>(::operator new(std::max<size_t>(1, n) * sizeof(Scalar), std::align_val_t(STREAM_CACHE_LINE)));
+			team.run([&](unsigned t) {
+				for (size_t i = team.begin(n, t); i < team.end(n, t); ++i) new (_data + i) Scalar(value);
+			});
+		}
+		~stream_array() {
+			for (size_t i = 0; i < _n; ++i) _data[i].~Scalar();
+			::operator delete(_data, std::align_val_t(STREAM_CACHE_LINE));
+		}
+		stream_array(const stream_array&) = delete;
+		stream_array& operator=(const stream_array&) = delete;
+
+		size_t size() const noexcept { return _n; }
+		Scalar* data() noexcept { return _data; }
+		Scalar& operator[](size_t i) noexcept { return _data[i]; }
+		const Scalar& operator[](size_t i) const noexcept { return _data[i]; }
+
+	private:
+		Scalar* _data;
+		size_t _n;
+	};
+
+	enum class StreamKernel : unsigned { Copy = 0, Scale, Add, Triad, NR_KERNELS };
+	constexpr unsigned NR_STREAM_KERNELS = static_cast<unsigned>(StreamKernel::NR_KERNELS);
+
+	inline const char* stream_kernel_name(StreamKernel k) {
+		switch (k) {
+		case StreamKernel::Copy:  return "Copy";
+		case StreamKernel::Scale: return "Scale";
+		case StreamKernel::Add:   return "Add";
+		case StreamKernel::Triad: return "Triad";
+		default:                  return "unknown";
+		}
+	}
+	// words moved and arithmetic operations per element
+	inline unsigned stream_kernel_words(StreamKernel k) { return (k == StreamKernel::Copy || k == StreamKernel::Scale) ? 2u : 3u; }
+	inline unsigned stream_kernel_ops(StreamKernel k) { return (k == StreamKernel::Copy ? 0u : (k == StreamKernel::Triad ? 2u : 1u)); }
+
+	// timings of one kernel: the first of the repetitions is excluded, as in McCalpin's STREAM
+	struct StreamTiming {
+		double bytes = 0.0;                                  // bytes moved per repetition
+		double min = std::numeric_limits<double>::max();
+		double max = 0.0;
+		double sum = 0.0;
+		unsigned count = 0;
+		void add(double seconds) { min = std::min(min, seconds); max = std::max(max, seconds); sum += seconds; ++count; }
+		double avg() const noexcept { return (count > 0 ? sum / double(count) : 0.0); }
+		double bandwidth() const noexcept { return (count > 0 && min > 0.0 ? bytes / min : 0.0); }  // best rate, bytes/s
+	};
+
+	struct StreamResult {
+		std::string numberSystem;
+		size_t bytesPerElement = 0;
+		size_t elements = 0;
+		unsigned threads = 0;
+		StreamTiming timing[NR_STREAM_KERNELS];
+		bool validates = false;
+	};
+
+	// run the four kernels repetitions times on n elements with a team of the given size
+	template<typename Scalar>
+	StreamResult RunStream(stream_team& team, size_t n, unsigned repetitions = 10) {
+		// STREAM's q = 3 grows the values 15-fold per repetition, which overflows small fixed-point and floating-point
+		// formats: with q = 3/8 the values shrink by a factor 0.89 per repetition and stay in range
+		const Scalar q(0.375);
+		stream_array<Scalar> a(team, n, Scalar(1.0)), b(team, n, Scalar(2.0)), c(team, n, Scalar(0.0));
+		team.run([&](unsigned t) { for (size_t i = team.begin(n, t); i < team.end(n, t); ++i) a[i] = Scalar(2.0) * a[i]; });  // as STREAM, outside of the timed loop
+
+		StreamResult result;
+		result.numberSystem = type_tag(Scalar());
+		result.bytesPerElement = sizeof(Scalar);
+		result.elements = n;
+		result.threads = team.size();
+		for (unsigned k = 0; k < NR_STREAM_KERNELS; ++k) result.timing[k].bytes = double(stream_kernel_words(static_cast<StreamKernel>(k))) * double(sizeof(Scalar)) * double(n);
+
+		auto timed = [&](StreamKernel k, unsigned repetition, const std::function<void(unsigned)>& kernel) {
+			std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+			team.run(kernel);
+			std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+			if (repetition > 0) result.timing[static_cast<unsigned>(k)].add(std::chrono::duration<double>(end - begin).count());
+		};
+		// the kernels capture the raw array pointers by value and hoist the bounds, so the loops do not reload them after every store
+		Scalar* pa = a.data(); Scalar* pb = b.data(); Scalar* pc = c.data();
+		for (unsigned r = 0; r < std::max(2u, repetitions); ++r) {
+			timed(StreamKernel::Copy, r,  [&team, n, pa, pb, pc, q](unsigned t) { size_t e = team.end(n, t); for (size_t i = team.begin(n, t); i < e; ++i) pc[i] = pa[i]; });
+			timed(StreamKernel::Scale, r, [&team, n, pa, pb, pc, q](unsigned t) { size_t e = team.end(n, t); const Scalar s = q; for (size_t i = team.begin(n, t); i < e; ++i) pb[i] = s * pc[i]; });
+			timed(StreamKernel::Add, r,   [&team, n, pa, pb, pc, q](unsigned t) { size_t e = team.end(n, t); for (size_t i = team.begin(n, t); i < e; ++i) pc[i] = pa[i] + pb[i]; });
+			timed(StreamKernel::Triad, r, [&team, n, pa, pb, pc, q](unsigned t) { size_t e = team.end(n, t); const Scalar s = q; for (size_t i = team.begin(n, t); i < e; ++i) pa[i] = pb[i] + s * pc[i]; });
+		}
+
+		// replay the kernels on one element in the same number system: every element must match bit for bit
+		Scalar aj(1.0), bj(2.0), cj(0.0);
+		aj = Scalar(2.0) * aj;
+		for (unsigned r = 0; r < std::max(2u, repetitions); ++r) {
+			cj = aj;
+			bj = q * cj;
+			cj = aj + bj;
+			aj = bj + q * cj;
+		}
+		result.validates = true;
+		size_t stride = std::max<size_t>(1, n / 1024);
+		for (size_t i = 0; i < n; i += stride) {
+			if (!(a[i] == aj) || !(b[i] == bj) || !(c[i] == cj)) { result.validates = false; break; }
+		}
+		return result;
+	}
+
+	// in-cache compute rate of Triad on per-thread L1-resident arrays, in ops/s across the team
+	// every thread sweeps plain arrays on its own stack: distinct arrays, so the loops need no aliasing checks
+	template<typename Scalar>
+	double StreamComputePeak(stream_team& team, double minSeconds = 0.05) {
+		constexpr size_t N = 256;
+		const Scalar q(0.375);
+		std::vector<double> sink(team.size());
+		size_t sweeps = 1;
+		for (;;) {
+			std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+			team.run([&sink, sweeps, q](unsigned t) {
+				alignas(STREAM_CACHE_LINE) Scalar a[N], b[N], c[N];
+				for (size_t i = 0; i < N; ++i) { b[i] = Scalar(double(i % 7) / 8.0); c[i] = Scalar(double(i % 5) / 4.0); }
+				const Scalar s = q;
+				for (size_t r = 0; r < sweeps; ++r) {
+					// two Triads per sweep: c converges to b / (1 - q), so the values stay bounded
+					for (size_t i = 0; i < N; ++i) a[i] = b[i] + s * c[i];
+					for (size_t i = 0; i < N; ++i) c[i] = b[i] + s * a[i];
+				}
+				double sum = 0.0;
+				for (size_t i = 0; i < N; ++i) sum += double(c[i]);
+				sink[t] = sum;  // keeps the sweeps observable
+			});
+			double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+			if (elapsed >= minSeconds || sweeps > (size_t(1) << 30)) return 4.0 * double(N) * double(sweeps) * double(team.size()) / elapsed;
+			sweeps *= 2;
+		}
+	}
+
+	// McCalpin's table: best rate, and average, minimum and maximum time over the repetitions
+	inline std::string ReportStream(const StreamResult& r) {
+		std::stringstream ostr;
+		ostr << r.numberSystem << " : " << r.bytesPerElement << " bytes per element, " << r.elements << " elements, " << r.threads << " thread" << (r.threads > 1 ? "s" : "") << '\n';
+		ostr << "Function    Best Rate MB/s  Avg time     Min time     Max time\n";
+		for (unsigned k = 0; k < NR_STREAM_KERNELS; ++k) {
+			const StreamTiming& t = r.timing[k];
+			std::string name = std::string(stream_kernel_name(static_cast<StreamKernel>(k))) + ':';
+			ostr << std::left << std::setw(12) << name << std::right << std::fixed
+				<< std::setw(11) << std::setprecision(1) << t.bandwidth() * 1.0e-6 << "  "
+				<< std::setw(11) << std::setprecision(6) << t.avg() << "  "
+				<< std::setw(11) << t.min << "  "
+				<< std::setw(11) << t.max << '\n';
+			ostr.unsetf(std::ios_base::floatfield);
+		}
+		ostr << (r.validates ? "Solution Validates" : "Failed Validation") << '\n';
+		return ostr.str();
+	}
+
+	// roofline position of a number system: the Triad intensity against the ridge point of its compute peak and the machine bandwidth
+	inline std::string ReportRoofline(const std::string& numberSystem, size_t bytesPerElement, double peakOps, double bandwidth) {
+		std::stringstream ostr;
+		double triadIntensity = 2.0 / (3.0 * double(bytesPerElement));
+		double ridge = (bandwidth > 0.0 ? peakOps / bandwidth : 0.0);
+		double attainable = std::min(peakOps, triadIntensity * bandwidth);
+		ostr << std::left << std::setw(45) << numberSystem << std::right
+			<< std::setw(6) << bytesPerElement
+			<< std::setw(14) << std::setprecision(4) << peakOps * 1.0e-6
+			<< std::setw(14) << triadIntensity
+			<< std::setw(14) << ridge
+			<< std::setw(14) << attainable * 1.0e-6
+			<< "   " << (triadIntensity < ridge ? "bandwidth-bound" : "compute-bound") << '\n';
+		return ostr.str();
+	}
+	inline std::string ReportRooflineHeader() {
+		std::stringstream ostr;
+		ostr << std::left << std::setw(45) << "number system" << std::right << std::setw(6) << "bytes"
+			<< std::setw(14) << "peak Mops/s" << std::setw(14) << "Triad ops/B" << std::setw(14) << "ridge ops/B"
+			<< std::setw(14) << "Triad Mops/s" << "   Triad is\n";
+		return ostr.str();
+	}
+
+}} // namespace sw::universal
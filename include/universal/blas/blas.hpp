@@ -21,6 +21,7 @@ constexpr uint32_t UNIVERSAL_AGGREGATE_TENSOR = 0x8008;
 #include <universal/blas/vector.hpp>
 #include <universal/blas/matrix.hpp>
 #include <universal/blas/tensor.hpp>
+#include <universal/blas/stencil.hpp>
 
 constexpr uint64_t SIZE_1K   = 1024;
 constexpr uint64_t SIZE_2K   = 2 * SIZE_1K;
@@ -61,6 +62,7 @@ constexpr uint64_t SIZE_512G = 512 * SIZE_1G;
 
 // L3
 #include <universal/blas/blas_l3.hpp>
+#include <universal/blas/contraction.hpp>
 #include <universal/blas/inverse.hpp>
 
 // Matrix operators
@@ -90,10 +92,15 @@ constexpr uint64_t SIZE_512G = 512 * SIZE_1G;
 #include <universal/blas/statistics.hpp>
 
 // MATLAB-style elementary vector functions
+#include <universal/blas/vmath/engine.hpp>
 #include <universal/blas/vmath/square.hpp>
 #include <universal/blas/vmath/sqrt.hpp>
 #include <universal/blas/vmath/power.hpp>
 #include <universal/blas/vmath/trigonometry.hpp>
+#include <universal/blas/vmath/exponent.hpp>
+#include <universal/blas/vmath/logarithm.hpp>
+#include <universal/blas/vmath/hyperbolic.hpp>
+#include <universal/blas/vmath/sigmoid.hpp>
 
 // Matrix utilities
 
@@ -8,6 +8,7 @@
 #include <cmath>
 #include <universal/math/mathlib_shim.hpp>  // injection of native IEEE-754 math library functions into sw::universal namespace
 #include <universal/blas/vector.hpp>
+#include <universal/traits/fma_traits.hpp>
 
 namespace sw { namespace universal { namespace blas { 
 
@@ -33,12 +34,18 @@ typename Vector::value_type sum(const Vector& x) {
 	return sum;
 }
 
-// a times x plus y
+// a times x plus y, fused when the element type has a correctly rounded fma
 template<typename Scalar, typename Vector>
 void axpy(size_t n, Scalar a, const Vector& x, size_t incx, Vector& y, size_t incy) {
+	using value_type = typename Vector::value_type;
 	size_t cnt, ix, iy;
 	for (cnt = 0, ix = 0, iy = 0; cnt < n && ix < size(x) && iy < size(y); ++cnt, ix += incx, iy += incy) {
-		y[iy] += a * x[ix];
+		if constexpr (has_fma<value_type>) {
+			y[iy] = fma(value_type(a), x[ix], y[iy]);
+		}
+		else {
+			y[iy] += a * x[ix];
+		}
 	}
 }
 
@@ -64,7 +71,7 @@ typename Vector::value_type dot(size_t n, const Vector& x, size_t incx, const Ve
 	value_type sum_of_products = value_type(0);
 	size_t cnt, ix, iy;
 	for (cnt = 0, ix = 0, iy = 0; cnt < n && ix < size(x) && iy < size(y); ++cnt, ix += incx, iy += incy) {
-		sum_of_products += x[ix] * y[iy];
+		if constexpr (has_fma<value_type>) sum_of_products = fma(x[ix], y[iy], sum_of_products); else sum_of_products += x[ix] * y[iy];
 	}
 	return sum_of_products;
 }
@@ -76,7 +83,7 @@ typename Vector::value_type dot(const Vector& x, const Vector& y) {
 	size_t nx = size(x);
 	if (nx <= size(y)) {
 		for (size_t i = 0; i < nx; ++i) {
-			sum_of_products += x[i] * y[i];
+			if constexpr (has_fma<value_type>) sum_of_products = fma(x[i], y[i], sum_of_products); else sum_of_products += x[i] * y[i];
 		}
 	}
 	return sum_of_products;
@@ -8,6 +8,7 @@
 #include <iostream>
 #include <universal/blas/vector.hpp>
 #include <universal/blas/matrix.hpp>
+#include <universal/traits/fma_traits.hpp>
 
 // compilation flags
 // BLAS_TRACE_ROUNDING_EVENTS
@@ -18,14 +19,14 @@
 
 namespace sw { namespace universal { namespace blas {
 
-	// Matrix-vector product: b = A * x, no quire for posit values
+	// Matrix-vector product: b = A * x, no quire for posit values, but fused when the Scalar has an fma
 	template<typename Matrix, typename Vector>
 	void matvec(Vector& b, const Matrix& A, const Vector& x) {
 		using Scalar = typename Vector::value_type;
 		for (size_t i = 0; i < A.rows(); ++i) {
 			b[i] = Scalar(0);
 			for (size_t j = 0; j < A.cols(); ++j) {
-				b[i] += A(i, j) * x[j];
+				if constexpr (has_fma<Scalar>) b[i] = fma(A(i, j), x[j], b[i]); else b[i] += A(i, j) * x[j];
 			}
 		}
 	}
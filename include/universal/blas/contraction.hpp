@@ -0,0 +1,276 @@
+#pragma once
+// contraction.hpp: einsum-style tensor contraction mapped onto a blocked, batched matrix-matrix product
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <universal/number/posit/posit_fwd.hpp>
+#include <universal/traits/fma_traits.hpp>
+#include <universal/blas/tensor.hpp>
+#include <universal/blas/parallel.hpp>
+
+/*
+    C(labelsC) = sum over the labels not in C of A(labelsA) * B(labelsB)
+
+    Each index label is classified by the operands it appears in:
+        A, B, and C : batch        A and C : rows M
+        A and B     : reduction K  B and C : columns N
+    and a label in only one input is summed over, as if the other input were constant along it.
+    A label repeated within one operand selects the diagonal. The contraction is then the batched
+    product C[b](M x N) = A[b](M x K) * B[b](K x N), where every group of labels is flattened
+    through a table of element offsets into the strided operand. That way a permuted, sliced, or
+    reshaped view is contracted in place, without copying it into a canonical layout first.
+
+    The product is blocked into MC x KC panels of A and KC x NC panels of B, packed into
+    contiguous buffers, and accumulated into an MC x NC tile of C. Tiles are independent and
+    are distributed over the hardware threads.
+
+    The reduction is accumulated in Scalar by default, fused when Scalar has an fma. With
+    Accumulation::Wide each element of the tile is a wide_accumulator instead, which is rounded
+    once at the end of the reduction: the quire for posits, double for float, and compensated
+    summation otherwise.
+*/
+
+namespace sw { namespace universal { namespace blas {
+
+enum class Accumulation { Native, Wide };
+
+// compensated (Neumaier) sum of products, rounded once by value()
+template<typename Scalar>
+struct wide_accumulator {
+	void clear() { sum = Scalar(0); compensation = Scalar(0); }
+	void accumulate(const Scalar& a, const Scalar& b) {
+		using std::abs;
+		Scalar p = a * b;
+		Scalar t = sum + p;
+		if (abs(sum) >= abs(p)) compensation += (sum - t) + p; else compensation += (p - t) + sum;
+		sum = t;
+	}
+	Scalar value() const { return sum + compensation; }
+	Scalar sum{ 0 }, compensation{ 0 };
+};
+
+// float products are exact in double
+template<>
+struct wide_accumulator<float> {
+	void clear() { sum = 0.0; }
+	void accumulate(float a, float b) { sum += double(a) * double(b); }
+	float value() const { return float(sum); }
+	double sum{ 0.0 };
+};
+
+// posit products are accumulated exactly in the quire
+template<unsigned nbits, unsigned es>
+struct wide_accumulator< posit<nbits, es> > {
+	static constexpr unsigned capacity = 20; // FDP for reductions < 1,048,576 elements
+	void clear() { q.clear(); }
+	void accumulate(const posit<nbits, es>& a, const posit<nbits, es>& b) { q += quire_mul(a, b); }
+	posit<nbits, es> value() const {
+		posit<nbits, es> p;
+		convert(q.to_value(), p);
+		return p;
+	}
+	quire<nbits, es, capacity> q;
+};
+
+namespace contraction_internal {
+
+	// blocking of the batched matrix-matrix product
+	constexpr size_t MC = 64;   // rows of a packed panel of A
+	constexpr size_t KC = 128;  // depth of a packed panel of A and B
+	constexpr size_t NC = 128;  // columns of a packed panel of B
+	// products below which the contraction runs on the calling thread
+	constexpr size_t parallelThreshold = size_t(1) << 18;
+
+	struct label {
+		char   name;
+		size_t extent;
+		size_t stride[3];   // stride in A, B, C; a repeated label sums its strides
+		bool   in[3];
+	};
+
+	// the offsets of all multi-indices of a group of labels in one operand, in row-major order of the group
+	inline std::vector<size_t> offsets(const std::vector<label>& group, unsigned operand) {
+		size_t n = 1;
+		for (const auto& l : group) n *= l.extent;
+		std::vector<size_t> offset(n, 0);
+		size_t repeat = n;
+		for (const auto& l : group) {
+			repeat /= l.extent;
+			for (size_t i = 0; i < n; ++i) offset[i] += ((i / repeat) % l.extent) * l.stride[operand];
+		}
+		return offset;
+	}
+
+	template<size_t Rank>
+	void collect(std::vector<label>& labels, const std::string& names, const std::array<size_t, Rank>& shape, const std::array<size_t, Rank>& strides, unsigned operand) {
+		if (names.size() != Rank) throw tensor_incompatible_shapes("labels '" + names + "' do not match the rank " + std::to_string(Rank) + " of the operand");
+		for (size_t d = 0; d < Rank; ++d) {
+			auto l = std::find_if(labels.begin(), labels.end(), [&](const label& e) { return e.name == names[d]; });
+			if (l == labels.end()) {
+				labels.push_back(label{ names[d], shape[d], { 0, 0, 0 }, { false, false, false } });
+				l = labels.end() - 1;
+			}
+			if (l->extent != shape[d]) throw tensor_incompatible_shapes(std::string("label '") + names[d] + "' has extents " + std::to_string(l->extent) + " and " + std::to_string(shape[d]));
+			if (operand == 2 && l->in[2]) throw tensor_incompatible_shapes(std::string("label '") + names[d] + "' is repeated in the result");
+			l->stride[operand] += strides[d];
+			l->in[operand] = true;
+		}
+	}
+
+	// the contraction as a batched matrix-matrix product over offset tables
+	struct plan {
+		std::vector<size_t> batchA, batchB, batchC;
+		std::vector<size_t> rowA, rowC, colB, colC, depthA, depthB;
+	};
+
+	template<typename Scalar, typename Accumulator>
+	void gemm(const plan& p, const Scalar* a, const Scalar* b, Scalar* c) {
+		size_t M = p.rowC.size(), N = p.colC.size(), K = p.depthA.size(), batches = p.batchC.size();
+		size_t rowTiles = (M + MC - 1) / MC, colTiles = (N + NC - 1) / NC;
+		size_t tiles = batches * rowTiles * colTiles;
+		if (tiles == 0) return;
+		size_t grain = (batches * M * N * K < parallelThreshold ? tiles : 1);
+		parallel_for(tiles, grain, [&](size_t begin, size_t end) {
+			std::vector<Scalar> Ap(MC * KC), Bp(KC * NC);
+			std::vector<Accumulator> acc(MC * NC);
+			for (size_t tile = begin; tile < end; ++tile) {
+				size_t batch = tile / (rowTiles * colTiles);
+				size_t ic = ((tile / colTiles) % rowTiles) * MC;
+				size_t jc = (tile % colTiles) * NC;
+				size_t mc = std::min(MC, M - ic), nc = std::min(NC, N - jc);
+				const Scalar* ab = a + p.batchA[batch];
+				const Scalar* bb = b + p.batchB[batch];
+				for (size_t e = 0; e < mc * nc; ++e) {
+					if constexpr (std::is_same_v<Accumulator, Scalar>) acc[e] = Scalar(0); else acc[e].clear();
+				}
+				for (size_t pc = 0; pc < K; pc += KC) {
+					size_t kc = std::min(KC, K - pc);
+					for (size_t i = 0; i < mc; ++i) {
+						const Scalar* row = ab + p.rowA[ic + i];
+						for (size_t k = 0; k < kc; ++k) Ap[i * kc + k] = row[p.depthA[pc + k]];
+					}
+					for (size_t k = 0; k < kc; ++k) {
+						const Scalar* row = bb + p.depthB[pc + k];
+						for (size_t j = 0; j < nc; ++j) Bp[k * nc + j] = row[p.colB[jc + j]];
+					}
+					for (size_t i = 0; i < mc; ++i) {
+						Accumulator* crow = acc.data() + i * nc;
+						for (size_t k = 0; k < kc; ++k) {
+							const Scalar aik = Ap[i * kc + k];
+							const Scalar* brow = Bp.data() + k * nc;
+							for (size_t j = 0; j < nc; ++j) {
+								if constexpr (!std::is_same_v<Accumulator, Scalar>) crow[j].accumulate(aik, brow[j]);
+								else if constexpr (has_fma<Scalar>) crow[j] = fma(aik, brow[j], crow[j]);
+								else crow[j] += aik * brow[j];
+							}
+						}
+					}
+				}
+				Scalar* cb = c + p.batchC[batch];
+				for (size_t i = 0; i < mc; ++i) {
+					Scalar* row = cb + p.rowC[ic + i];
+					for (size_t j = 0; j < nc; ++j) {
+						if constexpr (std::is_same_v<Accumulator, Scalar>) row[p.colC[jc + j]] = acc[i * nc + j]; else row[p.colC[jc + j]] = acc[i * nc + j].value();
+					}
+				}
+			}
+		});
+	}
+
+	template<typename Scalar, unsigned Rank>
+	tensor_view<const Scalar, Rank> operand(const tensor<Scalar, Rank>& T) { return T.view(); }
+	template<typename Scalar, unsigned Rank>
+	tensor_view<const Scalar, Rank> operand(const tensor_view<Scalar, Rank>& T) { return T; }
+	template<typename Scalar, unsigned Rank>
+	tensor_view<Scalar, Rank> result(tensor<Scalar, Rank>& T) { return T.view(); }
+	template<typename Scalar, unsigned Rank>
+	tensor_view<Scalar, Rank> result(const tensor_view<Scalar, Rank>& T) { return T; }
+
+	template<typename Scalar, unsigned RankA, unsigned RankB, unsigned RankC>
+	void contract_views(const tensor_view<const Scalar, RankA>& A, const std::string& labelsA,
+	                    const tensor_view<const Scalar, RankB>& B, const std::string& labelsB,
+	                    const tensor_view<Scalar, RankC>& C, const std::string& labelsC,
+	                    Accumulation accumulation) {
+		static_assert(!std::is_const_v<Scalar>, "the result of a contraction must be mutable");
+		std::vector<label> labels;
+		collect(labels, labelsA, A.shape(), A.strides(), 0);
+		collect(labels, labelsB, B.shape(), B.strides(), 1);
+		collect(labels, labelsC, C.shape(), C.strides(), 2);
+
+		// group the labels: batch, rows, and columns in the order of the result, the reduction in the order of A then B
+		std::vector<label> batch, rows, cols, depth;
+		for (char name : labelsC) {
+			const label& l = *std::find_if(labels.begin(), labels.end(), [&](const label& e) { return e.name == name; });
+			if (l.in[0] && l.in[1]) batch.push_back(l);
+			else if (l.in[0]) rows.push_back(l);
+			else if (l.in[1]) cols.push_back(l);
+			else throw tensor_incompatible_shapes(std::string("result label '") + name + "' is not a label of either operand");
+		}
+		for (const auto& l : labels) if (!l.in[2]) depth.push_back(l);
+
+		plan p;
+		p.batchA = offsets(batch, 0); p.batchB = offsets(batch, 1); p.batchC = offsets(batch, 2);
+		p.rowA = offsets(rows, 0);    p.rowC = offsets(rows, 2);
+		p.colB = offsets(cols, 1);    p.colC = offsets(cols, 2);
+		p.depthA = offsets(depth, 0); p.depthB = offsets(depth, 1);
+
+		if (accumulation == Accumulation::Wide) {
+			gemm<Scalar, wide_accumulator<Scalar>>(p, A.data(), B.data(), C.data());
+		}
+		else {
+			gemm<Scalar, Scalar>(p, A.data(), B.data(), C.data());
+		}
+	}
+
+} // namespace contraction_internal
+
+// C(labelsC) = A(labelsA) * B(labelsB) summed over the labels that are not in labelsC
+// the operands are tensors or views, the result is a tensor or a view of matching shape that must not overlap A or B
+template<typename TensorA, typename TensorB, typename TensorC>
+void contract(const TensorA& A, const std::string& labelsA, const TensorB& B, const std::string& labelsB,
+              TensorC&& C, const std::string& labelsC, Accumulation accumulation = Accumulation::Native) {
+	using namespace contraction_internal;
+	contract_views(operand(A), labelsA, operand(B), labelsB, result(C), labelsC, accumulation);
+}
+
+// einsum<RankC>("ij,jk->ik", A, B): allocate the result and contract A and B into it
+template<unsigned RankC, typename TensorA, typename TensorB>
+auto einsum(const std::string& spec, const TensorA& A, const TensorB& B, Accumulation accumulation = Accumulation::Native) {
+	using namespace contraction_internal;
+	auto a = operand(A);
+	auto b = operand(B);
+	using Scalar = typename decltype(a)::value_type;
+	static_assert(std::is_same_v<Scalar, typename decltype(b)::value_type>, "einsum operands must have the same Scalar type");
+	size_t comma = spec.find(','), arrow = spec.find("->");
+	if (comma == std::string::npos || arrow == std::string::npos || arrow < comma) throw tensor_incompatible_shapes("einsum specification '" + spec + "' is not of the form 'A,B->C'");
+	std::string labelsA = spec.substr(0, comma), labelsB = spec.substr(comma + 1, arrow - comma - 1), labelsC = spec.substr(arrow + 2);
+	if (labelsC.size() != RankC) throw tensor_incompatible_shapes("einsum result labels '" + labelsC + "' do not match the rank " + std::to_string(RankC) + " of the result");
+	std::vector<label> labels;
+	collect(labels, labelsA, a.shape(), a.strides(), 0);
+	collect(labels, labelsB, b.shape(), b.strides(), 1);
+	std::array<size_t, RankC> shape{};
+	for (size_t d = 0; d < RankC; ++d) {
+		auto l = std::find_if(labels.begin(), labels.end(), [&](const label& e) { return e.name == labelsC[d]; });
+		if (l == labels.end()) throw tensor_incompatible_shapes(std::string("result label '") + labelsC[d] + "' is not a label of either operand");
+		shape[d] = l->extent;
+	}
+	tensor<Scalar, RankC> C(shape);
+	contract_views(a, labelsA, b, labelsB, C.view(), labelsC, accumulation);
+	return C;
+}
+
+// rank 2 tensor product
+template<typename Scalar>
+tensor<Scalar, 2> operator*(const tensor<Scalar, 2>& A, const tensor<Scalar, 2>& B) {
+	if (A.extent(1) != B.extent(0)) throw matmul_incompatible_matrices(incompatible_matrices(A.extent(0), A.extent(1), B.extent(0), B.extent(1), "*").what());
+	return einsum<2>("ik,kj->ij", A, B);
+}
+
+}}} // namespace sw::universal::blas
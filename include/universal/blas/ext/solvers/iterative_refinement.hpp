@@ -0,0 +1,376 @@
+#pragma once
+// iterative_refinement.hpp: mixed-precision iterative refinement engine with LU-IR and GMRES-IR correction solvers
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cmath>
+#include <limits>
+#include <universal/number/posit/posit.hpp>
+#include <universal/blas/vector.hpp>
+#include <universal/blas/matrix.hpp>
+#include <universal/blas/solvers/plu.hpp>
+
+/*
+    Iterative refinement in three precisions (Carson and Higham, 2018)
+
+      factorization precision u_f  : A ~ LU, computed once, e.g. in LowPrecision
+      working precision       u    : the solution x, the correction solve
+      residual precision      u_r  : r = b - A x, the only O(n^2) step in high precision
+
+    Each refinement step computes the residual in the residual precision and solves A c = r
+    for a correction in the working precision:
+      LU-IR    : c = U^{-1} L^{-1} P r, converges when kappa(A) u_f < 1
+      GMRES-IR : c from GMRES on the preconditioned system U^{-1} L^{-1} P A c = U^{-1} L^{-1} P r,
+                 which converges for kappa(A) up to about 1/u_f^2, because GMRES only needs
+                 the preconditioned matrix to be well conditioned, not the factors to be accurate.
+    Every refinement step costs one residual in high precision, so GMRES-IR reaches the
+    same backward error on an ill-conditioned system with far fewer high-precision operations.
+
+    The factorization is a template parameter: any type with
+        size_t size() const;
+        void solve(vector<WorkingPrecision>& x) const;   // x = M^{-1} x in place
+    can serve as the preconditioner, e.g. a blocked, a sparse, or an incomplete factorization.
+    All vectors live in an ir_workspace that is allocated once per problem size.
+*/
+
+namespace sw { namespace universal { namespace blas {
+
+	namespace ir_internal {
+
+		// x(i) - sum of A(i, j) x(j) over j in [first, last): one row of a triangular solve
+		template<typename Scalar>
+		Scalar eliminate(const matrix<Scalar>& A, size_t i, size_t first, size_t last, const vector<Scalar>& x) {
+			Scalar s = x(i);
+			for (size_t j = first; j < last; ++j) s -= A(i, j) * x(j);
+			return s;
+		}
+
+		// posit triangular solves accumulate in the quire, as the fused forwsub and backsub do
+		template<unsigned nbits, unsigned es>
+		posit<nbits, es> eliminate(const matrix<posit<nbits, es>>& A, size_t i, size_t first, size_t last, const vector<posit<nbits, es>>& x) {
+			constexpr unsigned capacity = 20; // FDP for vectors < 1,048,576 elements
+			quire<nbits, es, capacity> q(x(i));
+			for (size_t j = first; j < last; ++j) q -= quire_mul(A(i, j), x(j));
+			posit<nbits, es> s;
+			convert(q.to_value(), s);
+			return s;
+		}
+
+	}  // namespace ir_internal
+
+	/// <summary>
+	/// dense PA = LU factorization computed in the factorization precision and applied in the working precision
+	/// </summary>
+	template<typename FactorizationPrecision, typename WorkingPrecision>
+	class dense_lu_factorization {
+	public:
+		dense_lu_factorization() = default;
+		template<typename Scalar>
+		explicit dense_lu_factorization(const matrix<Scalar>& A) { factor(A); }
+
+		template<typename Scalar>
+		void factor(const matrix<Scalar>& A) {
+			// round through double: the factorization precision is the lowest of the three
+			matrix<FactorizationPrecision> Af(num_rows(A), num_cols(A));
+			for (size_t i = 0; i < num_rows(A); ++i) {
+				for (size_t j = 0; j < num_cols(A); ++j) Af(i, j) = FactorizationPrecision(double(A(i, j)));
+			}
+			P.resize(num_rows(A));
+			plu(Af, P);
+			LU = Af;
+		}
+
+		size_t size() const noexcept { return num_rows(LU); }
+		const matrix<WorkingPrecision>& factors() const noexcept { return LU; }
+		const vector<size_t>& pivots() const noexcept { return P; }
+
+		// x = U^{-1} L^{-1} P x
+		void solve(vector<WorkingPrecision>& x) const {
+			size_t n = num_rows(LU);
+			for (size_t i = 0; i < n; ++i) if (P(i) != i) std::swap(x(i), x(P(i)));
+			for (size_t i = 1; i < n; ++i) x(i) = ir_internal::eliminate(LU, i, 0, i, x);
+			for (size_t e = 0; e < n; ++e) {
+				size_t i = n - 1 - e;
+				x(i) = ir_internal::eliminate(LU, i, i + 1, n, x) / LU(i, i);
+			}
+		}
+
+	private:
+		matrix<WorkingPrecision> LU;
+		vector<size_t> P;
+	};
+
+	enum class ir_solver { LU, GMRES };
+
+	struct ir_options {
+		ir_solver solver{ ir_solver::GMRES };
+		unsigned  maxIterations{ 20 };      // refinement steps, each one residual in high precision
+		double    tolerance{ 0.0 };         // target normwise backward error, 0 refines until the correction drops below u
+		unsigned  gmresMaxIterations{ 0 };  // Krylov dimension of the correction solve, 0 selects min(n, 50)
+		double    gmresTolerance{ 1.0e-6 }; // relative reduction of the preconditioned residual
+		bool      trace{ false };
+	};
+
+	struct ir_report {
+		unsigned  iterations{ 0 };          // refinement steps
+		unsigned  preconditionerSolves{ 0 };// applications of the factorization
+		unsigned  residuals{ 0 };           // residuals computed in high precision
+		double    highPrecisionOps{ 0 };    // multiply-adds in the residual precision
+		double    backwardError{ 0 };       // ||b - A x||_inf / (||A||_inf ||x||_inf + ||b||_inf)
+		bool      converged{ false };
+	};
+
+	inline std::ostream& operator<<(std::ostream& ostr, const ir_report& report) {
+		return ostr << (report.converged ? "converged" : "did not converge") << " in " << report.iterations << " steps, "
+			<< report.residuals << " residuals (" << report.highPrecisionOps << " high-precision ops), "
+			<< report.preconditionerSolves << " preconditioner solves, backward error " << report.backwardError;
+	}
+
+	/// <summary>
+	/// preallocated vectors of the refinement and of the GMRES correction solve
+	/// </summary>
+	template<typename ResidualPrecision, typename WorkingPrecision>
+	struct ir_workspace {
+		ir_workspace(size_t n = 0, size_t krylovDimension = 0) { resize(n, krylovDimension); }
+		void resize(size_t n, size_t krylovDimension) {
+			r.resize(n);
+			c.resize(n);
+			w.resize(n);
+			V.resize(krylovDimension + 1, n);
+			H.resize(krylovDimension + 1, krylovDimension);
+			cs.resize(krylovDimension);
+			sn.resize(krylovDimension);
+			g.resize(krylovDimension + 1);
+		}
+		size_t size() const noexcept { return c.size(); }
+		size_t krylovDimension() const noexcept { return cs.size(); }
+
+		vector<ResidualPrecision> r;                // residual b - A x in the residual precision
+		vector<WorkingPrecision>  c, w;             // correction, and the GMRES operator product
+		matrix<WorkingPrecision>  V, H;             // Krylov basis stored as rows, and the Hessenberg matrix
+		vector<WorkingPrecision>  cs, sn, g;        // Givens rotations, and the rotated right-hand side
+	};
+
+	namespace ir_internal {
+
+		// r = b - A x, accumulated in the residual precision
+		template<typename ResidualPrecision, typename WorkingPrecision>
+		void residual(const matrix<ResidualPrecision>& A, const vector<WorkingPrecision>& x, const vector<ResidualPrecision>& b, vector<ResidualPrecision>& r) {
+			size_t m = num_rows(A), n = num_cols(A);
+			for (size_t i = 0; i < m; ++i) {
+				ResidualPrecision s = b(i);
+				for (size_t j = 0; j < n; ++j) s -= A(i, j) * ResidualPrecision(x(j));
+				r(i) = s;
+			}
+		}
+
+		// posit residuals are accumulated in the quire and rounded once
+		template<unsigned nbits, unsigned es, typename WorkingPrecision>
+		void residual(const matrix<posit<nbits, es>>& A, const vector<WorkingPrecision>& x, const vector<posit<nbits, es>>& b, vector<posit<nbits, es>>& r) {
+			using Scalar = posit<nbits, es>;
+			constexpr unsigned capacity = 20; // FDP for vectors < 1,048,576 elements
+			size_t m = num_rows(A), n = num_cols(A);
+			for (size_t i = 0; i < m; ++i) {
+				quire<nbits, es, capacity> q(b(i));
+				for (size_t j = 0; j < n; ++j) q -= quire_mul(A(i, j), Scalar(x(j)));
+				convert(q.to_value(), r(i));
+			}
+		}
+
+		template<typename Scalar>
+		double infnorm(const matrix<Scalar>& A) {
+			double norm{ 0 };
+			for (size_t i = 0; i < num_rows(A); ++i) {
+				double s{ 0 };
+				for (size_t j = 0; j < num_cols(A); ++j) s += std::fabs(double(A(i, j)));
+				norm = std::max(norm, s);
+			}
+			return norm;
+		}
+
+		template<typename Scalar>
+		double infnorm(const vector<Scalar>& x) {
+			double norm{ 0 };
+			for (size_t i = 0; i < x.size(); ++i) norm = std::max(norm, std::fabs(double(x(i))));
+			return norm;
+		}
+
+		template<typename Scalar>
+		bool finite(const vector<Scalar>& x) {
+			for (size_t i = 0; i < x.size(); ++i) if (!std::isfinite(double(x(i)))) return false;
+			return true;
+		}
+
+		// w = A * v for the Krylov vector stored in row j of V
+		template<typename WorkingPrecision>
+		void matvec(const matrix<WorkingPrecision>& A, const matrix<WorkingPrecision>& V, size_t j, vector<WorkingPrecision>& w) {
+			size_t n = num_cols(A);
+			for (size_t i = 0; i < num_rows(A); ++i) {
+				WorkingPrecision s(0);
+				for (size_t k = 0; k < n; ++k) s += A(i, k) * V(j, k);
+				w(i) = s;
+			}
+		}
+
+		/// GMRES with modified Gram-Schmidt and Givens rotations on M^{-1} A c = M^{-1} r, starting from c = 0.
+		/// On entry work.c holds r in the working precision, on exit the correction.
+		template<typename ResidualPrecision, typename WorkingPrecision, typename Factorization>
+		void gmres(const matrix<WorkingPrecision>& A, const Factorization& M, ir_workspace<ResidualPrecision, WorkingPrecision>& work, const ir_options& options, ir_report& report) {
+			using std::sqrt; using std::abs;
+			size_t n = work.size(), m = work.krylovDimension();
+			auto& V = work.V; auto& H = work.H; auto& g = work.g; auto& cs = work.cs; auto& sn = work.sn;
+			vector<WorkingPrecision>& c = work.c;
+			vector<WorkingPrecision>& w = work.w;
+
+			M.solve(c);                      // the preconditioned residual
+			++report.preconditionerSolves;
+			WorkingPrecision beta(0);
+			for (size_t i = 0; i < n; ++i) beta += c(i) * c(i);
+			beta = sqrt(beta);
+			if (beta == WorkingPrecision(0)) return;
+			for (size_t i = 0; i < n; ++i) V(0, i) = c(i) / beta;
+			for (size_t i = 0; i <= m; ++i) g(i) = WorkingPrecision(0);
+			g(0) = beta;
+			double target = options.gmresTolerance * double(beta);
+
+			size_t k = 0;
+			while (k < m) {
+				matvec(A, V, k, w);
+				M.solve(w);
+				++report.preconditionerSolves;
+				for (size_t j = 0; j <= k; ++j) {
+					WorkingPrecision h(0);
+					for (size_t i = 0; i < n; ++i) h += w(i) * V(j, i);
+					H(j, k) = h;
+					for (size_t i = 0; i < n; ++i) w(i) -= h * V(j, i);
+				}
+				WorkingPrecision h(0);
+				for (size_t i = 0; i < n; ++i) h += w(i) * w(i);
+				h = sqrt(h);
+				H(k + 1, k) = h;
+				if (h != WorkingPrecision(0)) for (size_t i = 0; i < n; ++i) V(k + 1, i) = w(i) / h;
+
+				// apply the previous rotations to the new column, then annihilate H(k+1, k)
+				for (size_t j = 0; j < k; ++j) {
+					WorkingPrecision t = cs(j) * H(j, k) + sn(j) * H(j + 1, k);
+					H(j + 1, k) = -sn(j) * H(j, k) + cs(j) * H(j + 1, k);
+					H(j, k) = t;
+				}
+				WorkingPrecision rho = sqrt(H(k, k) * H(k, k) + H(k + 1, k) * H(k + 1, k));
+				cs(k) = H(k, k) / rho;
+				sn(k) = H(k + 1, k) / rho;
+				H(k, k) = rho;
+				H(k + 1, k) = WorkingPrecision(0);
+				g(k + 1) = -sn(k) * g(k);
+				g(k) = cs(k) * g(k);
+				++k;
+				if (options.trace) std::cout << "  gmres " << k << " : " << abs(g(k)) << '\n';
+				if (!(double(abs(g(k))) > target) || h == WorkingPrecision(0)) break;
+			}
+
+			// c = V^T y with H y = g
+			for (size_t e = 0; e < k; ++e) {
+				size_t i = k - 1 - e;
+				WorkingPrecision s = g(i);
+				for (size_t j = i + 1; j < k; ++j) s -= H(i, j) * g(j);
+				g(i) = s / H(i, i);
+			}
+			for (size_t i = 0; i < n; ++i) {
+				WorkingPrecision s(0);
+				for (size_t j = 0; j < k; ++j) s += V(j, i) * g(j);
+				c(i) = s;
+			}
+		}
+
+	}  // namespace ir_internal
+
+	/// <summary>
+	/// refine x, the solution of A x = b, with residuals in the residual precision and corrections in the working precision
+	/// </summary>
+	/// <param name="A">matrix in the residual precision</param>
+	/// <param name="Aw">the same matrix in the working precision, used by the GMRES operator</param>
+	/// <param name="M">factorization of A: a preconditioner with solve(vector&lt;WorkingPrecision&gt;&amp;)</param>
+	/// <param name="b">right-hand side in the residual precision</param>
+	/// <param name="x">on entry the initial solution, on exit the refined solution</param>
+	/// <param name="work">workspace, resized if it does not match the problem</param>
+	/// <returns>report of the refinement: steps, high-precision work, and final backward error</returns>
+	template<typename ResidualPrecision, typename WorkingPrecision, typename Factorization>
+	ir_report refine(const matrix<ResidualPrecision>& A, const matrix<WorkingPrecision>& Aw, const Factorization& M,
+		const vector<ResidualPrecision>& b, vector<WorkingPrecision>& x,
+		ir_workspace<ResidualPrecision, WorkingPrecision>& work, const ir_options& options = ir_options{}) {
+		size_t n = num_rows(A);
+		size_t krylovDimension = (options.solver == ir_solver::GMRES ? (options.gmresMaxIterations ? options.gmresMaxIterations : std::min<size_t>(n, 50)) : 0);
+		if (work.size() != n || work.krylovDimension() != krylovDimension) work.resize(n, krylovDimension);
+
+		ir_report report;
+		double anorm = ir_internal::infnorm(A);
+		double bnorm = ir_internal::infnorm(b);
+		double eps = double(std::numeric_limits<WorkingPrecision>::epsilon());
+		double previousCorrection = std::numeric_limits<double>::infinity();
+		bool done = false;
+		while (true) {
+			ir_internal::residual(A, x, b, work.r);
+			++report.residuals;
+			report.highPrecisionOps += double(n) * double(num_cols(A));
+			report.backwardError = ir_internal::infnorm(work.r) / (anorm * ir_internal::infnorm(x) + bnorm);
+			if (options.trace) std::cout << "step " << report.iterations << " : backward error " << report.backwardError << '\n';
+			if (!ir_internal::finite(x) || !std::isfinite(report.backwardError)) {
+				report.converged = false;
+				break;
+			}
+			if (done) break;
+			if (options.tolerance > 0.0 && report.backwardError <= options.tolerance) {
+				report.converged = true;
+				break;
+			}
+			if (report.iterations >= options.maxIterations) break;
+
+			for (size_t i = 0; i < n; ++i) work.c(i) = WorkingPrecision(work.r(i));
+			if (options.solver == ir_solver::LU) {
+				M.solve(work.c);
+				++report.preconditionerSolves;
+			}
+			else {
+				ir_internal::gmres(Aw, M, work, options, report);
+			}
+			if (!ir_internal::finite(work.c)) break;
+
+			// when the corrections stop shrinking, keep the current iterate: it is converged if it is backward stable
+			double correction = ir_internal::infnorm(work.c);
+			if (correction >= previousCorrection) {
+				report.converged = (report.backwardError <= double(n) * eps);
+				break;
+			}
+			previousCorrection = correction;
+			x += work.c;
+			++report.iterations;
+
+			// converged when the correction no longer changes x in the working precision; report the final residual
+			if (correction <= eps * ir_internal::infnorm(x)) {
+				report.converged = true;
+				done = true;
+			}
+		}
+		return report;
+	}
+
+	/// <summary>
+	/// solve A x = b by iterative refinement: factor A in the factorization precision, start from x = (LU)^{-1} b,
+	/// and refine with LU-IR or GMRES-IR corrections
+	/// </summary>
+	template<typename FactorizationPrecision, typename ResidualPrecision, typename WorkingPrecision>
+	ir_report solve_ir(const matrix<ResidualPrecision>& A, const vector<ResidualPrecision>& b, vector<WorkingPrecision>& x, const ir_options& options = ir_options{}) {
+		matrix<WorkingPrecision> Aw(A);
+		dense_lu_factorization<FactorizationPrecision, WorkingPrecision> M(A);
+		ir_workspace<ResidualPrecision, WorkingPrecision> work;
+		x.resize(num_rows(A));
+		for (size_t i = 0; i < x.size(); ++i) x(i) = WorkingPrecision(b(i));
+		M.solve(x);
+		ir_report report = refine(A, Aw, M, b, x, work, options);
+		++report.preconditionerSolves;
+		return report;
+	}
+
+}}}  // namespace sw::universal::blas
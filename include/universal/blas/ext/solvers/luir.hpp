@@ -12,6 +12,7 @@
 #include <universal/blas/ext/solvers/posit_fused_backsub.hpp>
 #include <universal/blas/ext/solvers/posit_fused_forwsub.hpp>
 #include <universal/blas/utes/nbe.hpp>      // Normwise Backward Error
+#include <universal/blas/ext/solvers/iterative_refinement.hpp>
 
 namespace sw { namespace universal { namespace blas {
 
@@ -123,4 +124,48 @@ std::pair<int, double> SolveIRLU(matrix<HighPrecision>& Ah, matrix<WorkingPrecis
 }
 
 
+/// <summary>
+/// Solve Ax = b using GMRES-based Iterative Refinement preconditioned with the low precision LU factorization
+/// </summary>
+/// <typeparam name="HighPrecision"></typeparam>
+/// <typeparam name="WorkingPrecision"></typeparam>
+/// <typeparam name="LowPrecision"></typeparam>
+/// <param name="Ah">matrix values in high precision</param>
+/// <param name="Aw">matrix values in working precision</param>
+/// <param name="Al">matrix values in low precision</param>
+/// <returns>a pair consisting of the number of iterations of the IR loop and the final error norm of the solution</returns>
+template<typename HighPrecision, typename WorkingPrecision, typename LowPrecision>
+std::pair<int, double> SolveIRGMRES(const matrix<HighPrecision>& Ah, const matrix<WorkingPrecision>& Aw, const matrix<LowPrecision>& Al, int maxIterations = 10, bool reportResultVector = false)
+{
+    using Vh = sw::universal::blas::vector<HighPrecision>;
+    using Vw = sw::universal::blas::vector<WorkingPrecision>;
+
+    size_t n = num_cols(Aw);
+    dense_lu_factorization<LowPrecision, WorkingPrecision> M(Al);
+
+    Vh xh(n, 1);    // generate a known solution
+    Vh b = Ah * xh;
+    Vw xw(xh);
+    Vw xn(n);
+    for (size_t i = 0; i < n; ++i) xn(i) = WorkingPrecision(b(i));
+    M.solve(xn);
+    if (!ir_internal::finite(xn)) {
+        std::cerr << "Initial guess is not a valid solution as it contains infinites\n";
+        return std::make_pair<int, double>(-1, INFINITY);
+    }
+
+    ir_options options;
+    options.solver = ir_solver::GMRES;
+    options.maxIterations = static_cast<unsigned>(maxIterations);
+    ir_workspace<HighPrecision, WorkingPrecision> work;
+    ir_report report = refine(Ah, Aw, M, b, xn, work, options);
+    WorkingPrecision errnorm = (xw - xn).infnorm();
+
+    if (reportResultVector) std::cout << xn << " in " << report.iterations << " iterations, final error = " << errnorm << '\n';
+    if (!report.converged) std::cerr << "GMRES-IR " << report << '\n';
+
+    return std::make_pair(static_cast<int>(report.iterations), double(errnorm));
+}
+
+
 } } }  // namespace sw::universal::blas
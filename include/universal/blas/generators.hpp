@@ -24,3 +24,4 @@
 // PDE and ODE matrices
 #include <universal/blas/generators/tridiag.hpp>
 #include <universal/blas/generators/laplace2D.hpp>
+#include <universal/blas/generators/laplace3D.hpp>
@@ -27,4 +27,11 @@ void laplace2D(matrix<Scalar>& A, size_t m, size_t n) {
 	}
 }
 
+// generate the matrix-free 5-point Laplacian on an m x n grid, the same operator as the dense matrix above
+template<typename Scalar>
+void laplace2D(stencil<Scalar, 2>& A, size_t m, size_t n) {
+	A.resize({ m, n });
+	A.setcoefficients(Scalar(4.0), Scalar(-1.0));
+}
+
 }}} // namespace sw::universal::blas
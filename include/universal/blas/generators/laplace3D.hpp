@@ -0,0 +1,41 @@
+#pragma once
+// laplace3D.hpp: generate 3D Laplace operator difference matrix on a cube domain
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/blas/blas.hpp>
+
+namespace sw { namespace universal { namespace blas { 
+
+// generate a 3D Laplacian difference equation matrix on an l x m x n grid
+template<typename Scalar>
+void laplace3D(matrix<Scalar>& A, size_t l, size_t m, size_t n) {
+	A.resize(l*m*n, l*m*n);
+	A.setzero();
+	Scalar six(6.0), minus_one(-1.0);
+	for (size_t i = 0; i < l; ++i) {
+		for (size_t j = 0; j < m; ++j) {
+			for (size_t k = 0; k < n; ++k) {
+				size_t row = (i * m + j) * n + k;
+				A(row, row) = six;
+				if (k < n - 1) A(row, row + 1) = minus_one;
+				if (j < m - 1) A(row, row + n) = minus_one;
+				if (i < l - 1) A(row, row + m * n) = minus_one;
+				if (k > 0) A(row, row - 1) = minus_one;
+				if (j > 0) A(row, row - n) = minus_one;
+				if (i > 0) A(row, row - m * n) = minus_one;
+			}
+		}
+	}
+}
+
+// generate the matrix-free 7-point Laplacian on an l x m x n grid
+template<typename Scalar>
+void laplace3D(stencil<Scalar, 3>& A, size_t l, size_t m, size_t n) {
+	A.resize({ l, m, n });
+	A.setcoefficients(Scalar(6.0), Scalar(-1.0));
+}
+
+}}} // namespace sw::universal::blas
@@ -10,6 +10,7 @@
 #include <initializer_list>
 #include <map>
 #include <universal/blas/exceptions.hpp>
+#include <universal/traits/fma_traits.hpp>
 
 #if defined(__clang__)
 /* Clang/LLVM. ---------------------------------------------- */
@@ -359,7 +360,7 @@ vector<Scalar> operator*(const matrix<Scalar>& A, const vector<Scalar>& x) {
 	for (size_type i = 0; i < A.rows(); ++i) {
 		b[i] = Scalar(0);
 		for (size_type j = 0; j < A.cols(); ++j) {
-			b[i] += A(i, j) * x[j];
+			if constexpr (has_fma<Scalar>) b[i] = fma(A(i, j), x[j], b[i]); else b[i] += A(i, j) * x[j];
 		}
 	}
 	return b;
@@ -378,7 +379,7 @@ matrix<Scalar> operator*(const matrix<Scalar>& A, const matrix<Scalar>& B) {
 		for (size_type j = 0; j < cols; ++j) {
 			Scalar e = Scalar(0);
 			for (size_type k = 0; k < dots; ++k) {
-				e += A(i, k) * B(k, j);
+				if constexpr (has_fma<Scalar>) e = fma(A(i, k), B(k, j), e); else e += A(i, k) * B(k, j);
 			}
 			C(i, j) = e;
 		}
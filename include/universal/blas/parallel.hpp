@@ -0,0 +1,43 @@
+#pragma once
+// parallel.hpp: partitioning of loops across the hardware threads
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <algorithm>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace sw { namespace universal { namespace blas {
+
+	// run f(begin, end) over [0, N) partitioned across the hardware threads; exceptions are rethrown on the caller
+	template<typename Function>
+	void parallel_for(size_t N, size_t grain, Function&& f) {
+		size_t nrThreads = std::max<size_t>(1, std::thread::hardware_concurrency());
+		size_t nrChunks = std::min(nrThreads, (N + grain - 1) / std::max<size_t>(grain, 1));
+		if (nrChunks <= 1) {
+			f(size_t(0), N);
+			return;
+		}
+		size_t chunk = (N + nrChunks - 1) / nrChunks;
+		std::vector<std::exception_ptr> errors(nrChunks);
+		std::vector<std::thread> workers;
+		workers.reserve(nrChunks - 1);
+		for (size_t t = 1; t < nrChunks; ++t) {
+			size_t begin = t * chunk;
+			size_t end = std::min(N, begin + chunk);
+			if (begin >= end) break;
+			workers.emplace_back([&f, &errors, t, begin, end]() {
+				try { f(begin, end); }
+				catch (...) { errors[t] = std::current_exception(); }
+			});
+		}
+		try { f(size_t(0), std::min(N, chunk)); }
+		catch (...) { errors[0] = std::current_exception(); }
+		for (auto& w : workers) w.join();
+		for (auto& e : errors) if (e) std::rethrow_exception(e);
+	}
+
+}}} // namespace sw::universal::blas
@@ -6,6 +6,7 @@
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 #include <universal/number/posit/posit_fwd.hpp>
 #include <universal/blas/matrix.hpp>
+#include <universal/blas/stencil.hpp>
 
 namespace sw { namespace universal { namespace blas {
 
@@ -17,21 +18,30 @@ size_t GaussSeidel(const Matrix& A, const Vector& b, Vector& x, typename Matrix:
 	size_t m = num_rows(A);
 	size_t n = num_cols(A);
 	size_t itr = 0;
-	while (residual > tolerance && itr < MAX_ITERATIONS) {
-		Vector x_old = x;
-		for (size_t i = 1; i <= m; ++i) {
-			Scalar sigma = 0;
-			for (size_t j = 1; j <= i - 1; ++j) {
-				sigma += A(i - 1, j - 1) * x(j - 1);
-			}
-			for (size_t j = i + 1; j <= n; ++j) {
-				sigma += A(i - 1, j - 1) * x_old(j - 1);
+	if constexpr (is_stencil<Matrix>) {
+		// matrix-free red-black sweeps
+		while (residual > tolerance && itr < MAX_ITERATIONS) {
+			residual = A.sor_sweep(b, x, Scalar(1));
+			++itr;
+		}
+	}
+	else {
+		while (residual > tolerance && itr < MAX_ITERATIONS) {
+			Vector x_old = x;
+			for (size_t i = 1; i <= m; ++i) {
+				Scalar sigma = 0;
+				for (size_t j = 1; j <= i - 1; ++j) {
+					sigma += A(i - 1, j - 1) * x(j - 1);
+				}
+				for (size_t j = i + 1; j <= n; ++j) {
+					sigma += A(i - 1, j - 1) * x_old(j - 1);
+				}
+				x(i - 1) = (b(i - 1) - sigma) / A(i - 1, i - 1);
 			}
-			x(i - 1) = (b(i - 1) - sigma) / A(i - 1, i - 1);
+			residual = norm(x_old - x, 1);
+			std::cout << '[' << itr << "] " << std::setw(10) << x << "        residual " << residual << std::endl;
+			++itr;
 		}
-		residual = norm(x_old - x, 1);
-		std::cout << '[' << itr << "] " << std::setw(10) << x << "        residual " << residual << std::endl;
-		++itr;
 	}
 
 	return itr;
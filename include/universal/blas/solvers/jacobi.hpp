@@ -5,8 +5,10 @@
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 #include <cmath>
+#include <utility>
 #include <universal/number/posit/posit_fwd.hpp>
 #include <universal/blas/matrix.hpp>
+#include <universal/blas/stencil.hpp>
 
 namespace sw { namespace universal { namespace blas {
 
@@ -21,18 +23,30 @@ size_t Jacobi(const Matrix& A, const Vector& b, Vector& x, typename Matrix::valu
 	size_t m = num_rows(A);
 	size_t n = num_cols(A);
 	size_t itr = 0;
-	while (residual > tolerance && itr < MAX_ITERATIONS) {
-		Vector x_old = x;
-		for (size_t i = 0; i < m; ++i) {
-			Scalar sigma = 0;
-			for (size_t j = 0; j < n; ++j) {
-				if (i != j) sigma += A(i, j) * x(j);
+	if constexpr (is_stencil<Matrix>) {
+		// matrix-free sweep into a second iterate, then swap the roles of the two
+		Vector x_next(size(x));
+		while (residual > tolerance && itr < MAX_ITERATIONS) {
+			residual = A.jacobi_sweep(b, x, x_next);
+			std::swap(x, x_next);
+			if constexpr (traceIteration) std::cout << '[' << itr << "] residual " << residual << std::endl;
+			++itr;
+		}
+	}
+	else {
+		while (residual > tolerance && itr < MAX_ITERATIONS) {
+			Vector x_old = x;
+			for (size_t i = 0; i < m; ++i) {
+				Scalar sigma = 0;
+				for (size_t j = 0; j < n; ++j) {
+					if (i != j) sigma += A(i, j) * x(j);
+				}
+				x(i) = (b(i) - sigma) / A(i, i);
 			}
-			x(i) = (b(i) - sigma) / A(i, i);
+			residual = normL1(x_old - x);
+			if constexpr (traceIteration) std::cout << '[' << itr << "] " << std::setw(10) << x << "         residual " << residual << std::endl;
+			++itr;
 		}
-		residual = normL1(x_old - x);
-		if constexpr (traceIteration) std::cout << '[' << itr << "] " << std::setw(10) << x << "         residual " << residual << std::endl;
-		++itr;
 	}
 
 	return itr;
@@ -1,7 +1,21 @@
 #pragma once
-// lsq.hpp: super-simple dense matrix implementation
+// lsq.hpp: linear least-squares solver
 //
 // Copyright (C) 2017 Stillwater Supercomputing, Inc.
 // SPDX-License-Identifier: MIT
 //
-// This file is part of the universal numbers project, which is released under an MIT Open Source license.
\ No newline at end of file
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/blas/vector.hpp>
+#include <universal/blas/matrix.hpp>
+#include <universal/blas/solvers/qr.hpp>
+
+namespace sw { namespace universal { namespace blas {
+
+// x minimizing || A * x - b ||_2 for a full column rank A with at least as many rows as columns,
+// computed with a blocked Householder QR factorization of A
+template<typename Scalar>
+vector<Scalar> lsq(const matrix<Scalar>& A, const vector<Scalar>& b) {
+	return qr_lsq(A, b);
+}
+
+}}} // namespace sw::universal::blas
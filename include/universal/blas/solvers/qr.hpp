@@ -13,6 +13,8 @@
 #pragma once
 #include<universal/blas/blas_l1.hpp>
 #include<universal/blas/blas.hpp>
+#include<universal/blas/exceptions.hpp>
+#include<universal/blas/parallel.hpp>
 
 namespace sw { namespace universal { namespace blas {  
 
@@ -246,6 +248,232 @@ void givensqr(const matrix<Scalar>& A, matrix<Scalar>& Q, matrix<Scalar>& R){
     }
 }
 
+///////////////////////////////////////////////////////////////////////////////////
+// Blocked Householder QR with compact WY representation
+//
+// geqrf factors A = Q * R in place: R occupies the upper triangle, and the Householder
+// vector v_j of H_j = I - tau_j * v_j * v_j^T is stored below the diagonal of column j,
+// with the unit v_j(j) = 1 implicit. The columns are factored in panels of nb columns.
+// The nb reflectors of a panel are aggregated as H = I - V * T * V^T, with T upper
+// triangular, so that the update of the trailing matrix is two matrix-matrix products
+// instead of nb rank-1 updates. The products are partitioned in tiles of QR_ROW_TILE rows
+// across the hardware threads, and the partial products of the tiles are reduced in tile
+// order, so the result does not depend on the number of threads.
+
+#ifndef QR_BLOCK_SIZE
+#define QR_BLOCK_SIZE 32
+#endif
+#ifndef QR_ROW_TILE
+#define QR_ROW_TILE 256
+#endif
+
+namespace qr_internal {
+
+	// element i of the Householder vector stored in column j of the factored matrix
+	template<typename Scalar>
+	inline Scalar reflector(const matrix<Scalar>& A, size_t i, size_t j) {
+		return (i == j ? Scalar(1) : (i < j ? Scalar(0) : A(i, j)));
+	}
+
+	// unblocked factorization of the panel A(j0:m, j0:j0+jb)
+	template<typename Scalar>
+	void geqr2(matrix<Scalar>& A, vector<Scalar>& tau, size_t j0, size_t jb) {
+		using std::sqrt;
+		size_t m = num_rows(A);
+		std::vector<Scalar> w(jb);
+		for (size_t j = j0; j < j0 + jb; ++j) {
+			// generate H_j such that H_j * A(j:m, j) = (beta, 0, ..., 0)
+			Scalar alpha = A(j, j);
+			Scalar xnorm2(0);
+			for (size_t i = j + 1; i < m; ++i) xnorm2 += A(i, j) * A(i, j);
+			if (xnorm2 == Scalar(0)) {
+				tau[j] = Scalar(0);
+				continue;
+			}
+			Scalar beta = sqrt(alpha * alpha + xnorm2);
+			if (alpha >= Scalar(0)) beta = -beta;
+			tau[j] = (beta - alpha) / beta;
+			Scalar scale = Scalar(1) / (alpha - beta);
+			for (size_t i = j + 1; i < m; ++i) A(i, j) *= scale;
+			A(j, j) = beta;
+
+			// apply H_j to the remaining columns of the panel: A -= tau * v * (v^T A)
+			size_t c0 = j + 1, c1 = j0 + jb;
+			if (c0 == c1) continue;
+			for (size_t c = c0; c < c1; ++c) w[c - c0] = A(j, c);
+			for (size_t i = j + 1; i < m; ++i) {
+				Scalar v = A(i, j);
+				for (size_t c = c0; c < c1; ++c) w[c - c0] += v * A(i, c);
+			}
+			for (size_t c = c0; c < c1; ++c) A(j, c) -= tau[j] * w[c - c0];
+			for (size_t i = j + 1; i < m; ++i) {
+				Scalar v = tau[j] * A(i, j);
+				for (size_t c = c0; c < c1; ++c) A(i, c) -= v * w[c - c0];
+			}
+		}
+	}
+
+	// the upper triangular factor T of the block reflector H_j0 ... H_j0+jb-1 = I - V * T * V^T
+	template<typename Scalar>
+	matrix<Scalar> larft(const matrix<Scalar>& A, const vector<Scalar>& tau, size_t j0, size_t jb) {
+		size_t m = num_rows(A);
+		matrix<Scalar> T(jb, jb);
+		std::vector<Scalar> z(jb);
+		for (size_t i = 0; i < jb; ++i) {
+			// T(0:i, i) = -tau_i * T(0:i, 0:i) * V(:, 0:i)^T * v_i
+			std::fill(z.begin(), z.end(), Scalar(0));
+			size_t col = j0 + i;
+			for (size_t r = col; r < m; ++r) {
+				Scalar vi = reflector(A, r, col);
+				for (size_t k = 0; k < i; ++k) z[k] += reflector(A, r, j0 + k) * vi;
+			}
+			for (size_t k = 0; k < i; ++k) {
+				Scalar t(0);
+				for (size_t l = k; l < i; ++l) t += T(k, l) * z[l];
+				T(k, i) = -tau[col] * t;
+			}
+			T(i, i) = tau[col];
+		}
+		return T;
+	}
+
+	// C = (I - V * op(T) * V^T) * C for the columns [c0, c1) of C and rows [j0, m),
+	// with V the reflectors stored in columns [j0, j0+jb) of A, and op(T) = T^T when transpose is set
+	template<typename Scalar>
+	void larfb(const matrix<Scalar>& A, const matrix<Scalar>& T, size_t j0, size_t jb, matrix<Scalar>& C, size_t c0, size_t c1, bool transpose) {
+		size_t m = num_rows(A);
+		size_t nc = c1 - c0;
+		if (nc == 0 || j0 >= m) return;
+
+		// W = V^T * C: the partial products of the row tiles are reduced in tile order
+		size_t nrTiles = (m - j0 + QR_ROW_TILE - 1) / QR_ROW_TILE;
+		std::vector<matrix<Scalar>> partial(nrTiles);
+		parallel_for(nrTiles, 1, [&](size_t begin, size_t end) {
+			for (size_t t = begin; t < end; ++t) {
+				matrix<Scalar> Wt(jb, nc);
+				size_t r0 = j0 + t * QR_ROW_TILE, r1 = std::min(m, r0 + QR_ROW_TILE);
+				for (size_t r = r0; r < r1; ++r) {
+					for (size_t k = 0; k < jb; ++k) {
+						Scalar v = reflector(A, r, j0 + k);
+						if (v == Scalar(0)) continue;
+						for (size_t c = 0; c < nc; ++c) Wt(k, c) += v * C(r, c0 + c);
+					}
+				}
+				partial[t] = std::move(Wt);
+			}
+		});
+		matrix<Scalar> W(jb, nc);
+		for (size_t t = 0; t < nrTiles; ++t) W += partial[t];
+
+		// W = op(T) * W
+		matrix<Scalar> TW(jb, nc);
+		for (size_t k = 0; k < jb; ++k) {
+			for (size_t l = 0; l < jb; ++l) {
+				Scalar tkl = transpose ? T(l, k) : T(k, l);
+				if (tkl == Scalar(0)) continue;
+				for (size_t c = 0; c < nc; ++c) TW(k, c) += tkl * W(l, c);
+			}
+		}
+
+		// C = C - V * W
+		parallel_for(nrTiles, 1, [&](size_t begin, size_t end) {
+			for (size_t t = begin; t < end; ++t) {
+				size_t r0 = j0 + t * QR_ROW_TILE, r1 = std::min(m, r0 + QR_ROW_TILE);
+				for (size_t r = r0; r < r1; ++r) {
+					for (size_t k = 0; k < jb; ++k) {
+						Scalar v = reflector(A, r, j0 + k);
+						if (v == Scalar(0)) continue;
+						for (size_t c = 0; c < nc; ++c) C(r, c0 + c) -= v * TW(k, c);
+					}
+				}
+			}
+		});
+	}
+
+} // namespace qr_internal
+
+// in-place blocked Householder QR factorization of A, returns the scalar factors of the reflectors in tau
+template<typename Scalar>
+void geqrf(matrix<Scalar>& A, vector<Scalar>& tau, size_t nb = QR_BLOCK_SIZE) {
+	size_t m = num_rows(A), n = num_cols(A);
+	size_t k = std::min(m, n);
+	tau.resize(k);
+	if (nb == 0) nb = 1;
+	for (size_t j0 = 0; j0 < k; j0 += nb) {
+		size_t jb = std::min(nb, k - j0);
+		qr_internal::geqr2(A, tau, j0, jb);
+		if (j0 + jb < n) {
+			matrix<Scalar> T = qr_internal::larft(A, tau, j0, jb);
+			qr_internal::larfb(A, T, j0, jb, A, j0 + jb, n, true);  // apply H^T to the trailing matrix
+		}
+	}
+}
+
+// the first ncols columns of Q = H_0 * H_1 * ... * H_k-1 of a factorization computed by geqrf
+template<typename Scalar>
+matrix<Scalar> orgqr(const matrix<Scalar>& QR, const vector<Scalar>& tau, size_t ncols, size_t nb = QR_BLOCK_SIZE) {
+	size_t m = num_rows(QR);
+	size_t k = tau.size();
+	matrix<Scalar> Q(m, ncols);
+	for (size_t i = 0; i < std::min(m, ncols); ++i) Q(i, i) = Scalar(1);
+	if (nb == 0) nb = 1;
+	// accumulate backwards: rows [j0, m) of the columns before j0 are still zero when block j0 is applied
+	size_t nrBlocks = (k + nb - 1) / nb;
+	for (size_t b = nrBlocks; b-- > 0; ) {
+		size_t j0 = b * nb;
+		size_t jb = std::min(nb, k - j0);
+		matrix<Scalar> T = qr_internal::larft(QR, tau, j0, jb);
+		qr_internal::larfb(QR, T, j0, jb, Q, std::min(j0, ncols), ncols, false);
+	}
+	return Q;
+}
+
+// the upper trapezoidal factor R of a factorization computed by geqrf
+template<typename Scalar>
+matrix<Scalar> triu_factor(const matrix<Scalar>& QR, size_t nrows) {
+	size_t n = num_cols(QR);
+	matrix<Scalar> R(nrows, n);
+	for (size_t i = 0; i < std::min(nrows, num_rows(QR)); ++i) {
+		for (size_t j = i; j < n; ++j) R(i, j) = QR(i, j);
+	}
+	return R;
+}
+
+// b = Q^T * b with the reflectors of a factorization computed by geqrf
+template<typename Scalar>
+void ormqr_transpose(const matrix<Scalar>& QR, const vector<Scalar>& tau, vector<Scalar>& b) {
+	size_t m = num_rows(QR);
+	for (size_t j = 0; j < tau.size(); ++j) {
+		if (tau[j] == Scalar(0)) continue;
+		Scalar w = b[j];
+		for (size_t i = j + 1; i < m; ++i) w += QR(i, j) * b[i];
+		w *= tau[j];
+		b[j] -= w;
+		for (size_t i = j + 1; i < m; ++i) b[i] -= w * QR(i, j);
+	}
+}
+
+// least-squares solution of the full column rank, overdetermined system A * x = b, m >= n
+template<typename Scalar>
+vector<Scalar> qr_lsq(const matrix<Scalar>& A, const vector<Scalar>& b, size_t nb = QR_BLOCK_SIZE) {
+	size_t m = num_rows(A), n = num_cols(A);
+	if (m < n || b.size() != m) throw matmul_incompatible_matrices(incompatible_matrices(m, n, b.size(), 1, "qr_lsq").what());
+	matrix<Scalar> QR(A);
+	vector<Scalar> tau;
+	geqrf(QR, tau, nb);
+	vector<Scalar> y(b);
+	ormqr_transpose(QR, tau, y);
+	// solve R * x = y(0:n)
+	vector<Scalar> x(n);
+	for (size_t e = 0; e < n; ++e) {
+		size_t i = n - 1 - e;
+		Scalar s = y[i];
+		for (size_t j = i + 1; j < n; ++j) s -= QR(i, j) * x[j];
+		x[i] = s / QR(i, i);
+	}
+	return x;
+}
+
 // MAIN QR method (calls specific method within)
 template<typename Scalar>
 std::pair<matrix<Scalar>, matrix<Scalar>> qr(const matrix<Scalar>& A, size_t which = 1) {
@@ -287,6 +515,16 @@ std::pair<matrix<Scalar>, matrix<Scalar>> qr(const matrix<Scalar>& A, size_t whi
             houseqrpivot(A, Q, R, P);
         } 
 		break;
+	case 5:
+		{
+            // blocked Householder with compact WY updates
+            R = A;
+            vector<Scalar> tau;
+            geqrf(R, tau);
+            Q = orgqr(R, tau, num_rows(A));
+            R = triu_factor(R, num_rows(A));
+        }
+		break;
 	default:
 		{
             Q = 1;
@@ -0,0 +1,231 @@
+#pragma once
+// runge_kutta.hpp: explicit Runge-Kutta integrators driven by a Butcher tableau, and an ensemble driver
+//                  that advances one integration per number system in lockstep
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <barrier>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include <universal/native/ieee754_type_tag.hpp>
+#include <universal/blas/vector.hpp>
+
+/*
+    An explicit s-stage Runge-Kutta method for y' = f(t, y)
+
+        k_i     = f(t + c_i h, y + h sum_{j<i} a_ij k_j)     i = 1..s
+        y_{n+1} = y_n + h sum_i b_i k_i
+
+    is defined by its Butcher tableau. The coefficients of the classic tableaux are rational,
+    so they are stored as ratios of integers and rounded once into the number system of the
+    integrator: a double-double integrator sees 1/3 to 106 bits, a posit<16,1> to 12.
+
+    A system is any callable f(t, y, dydt) that writes y' into the preallocated dydt. It is
+    typically a generic lambda, so that the same system can be integrated in every number system:
+        auto lorenz = [](const auto& t, const auto& y, auto& dydt) { ... };
+
+    ensemble_integrate runs one integration per type of a std::tuple, each on its own thread with
+    its own preallocated state. The lanes meet every sampleInterval steps to publish their state,
+    and each lane measures its divergence from the first lane, the reference, while the others
+    continue, so a sweep across number systems takes one parallel run instead of one run per type.
+*/
+
+namespace sw { namespace universal { namespace blas {
+
+// a Butcher tableau of an explicit method with rational coefficients
+struct butcher_tableau {
+	struct coefficient {
+		long num, den;
+		template<typename Scalar>
+		Scalar value() const { return (num == 0 ? Scalar(0) : Scalar(num) / Scalar(den)); }
+	};
+
+	std::string name;
+	unsigned order;
+	std::vector<std::vector<coefficient>> a;  // a[i][j] for j < i
+	std::vector<coefficient> b;
+	std::vector<coefficient> c;
+
+	size_t stages() const noexcept { return b.size(); }
+
+	static butcher_tableau euler() {
+		return { "Euler", 1, { {} }, { {1,1} }, { {0,1} } };
+	}
+	static butcher_tableau heun() {
+		return { "Heun", 2, { {}, { {1,1} } }, { {1,2}, {1,2} }, { {0,1}, {1,1} } };
+	}
+	static butcher_tableau midpoint() {
+		return { "midpoint", 2, { {}, { {1,2} } }, { {0,1}, {1,1} }, { {0,1}, {1,2} } };
+	}
+	static butcher_tableau rk4() {
+		return { "RK4", 4,
+			{ {}, { {1,2} }, { {0,1}, {1,2} }, { {0,1}, {0,1}, {1,1} } },
+			{ {1,6}, {1,3}, {1,3}, {1,6} },
+			{ {0,1}, {1,2}, {1,2}, {1,1} } };
+	}
+	static butcher_tableau rk38() {
+		return { "3/8-rule", 4,
+			{ {}, { {1,3} }, { {-1,3}, {1,1} }, { {1,1}, {-1,1}, {1,1} } },
+			{ {1,8}, {3,8}, {3,8}, {1,8} },
+			{ {0,1}, {1,3}, {2,3}, {1,1} } };
+	}
+};
+
+// explicit Runge-Kutta integrator in the number system Scalar for systems of n equations
+template<typename Scalar>
+class explicit_runge_kutta {
+public:
+	typedef Scalar value_type;
+
+	explicit_runge_kutta(const butcher_tableau& tableau, size_t n) : _a(tableau.stages()), _b(tableau.stages()), _c(tableau.stages()), _k(tableau.stages(), vector<Scalar>(n)), _stage(n) {
+		for (size_t i = 0; i < tableau.stages(); ++i) {
+			for (const auto& aij : tableau.a[i]) _a[i].push_back(aij.template value<Scalar>());
+			_b[i] = tableau.b[i].template value<Scalar>();
+			_c[i] = tableau.c[i].template value<Scalar>();
+		}
+	}
+
+	size_t size() const noexcept { return size_t(_stage.size()); }
+
+	// advance y from t to t + h
+	template<typename System>
+	void step(System&& f, const Scalar& t, vector<Scalar>& y, const Scalar& h) {
+		size_t n = size();
+		for (size_t i = 0; i < _k.size(); ++i) {
+			_stage = y;
+			for (size_t j = 0; j < _a[i].size(); ++j) {
+				if (_a[i][j] == Scalar(0)) continue;
+				Scalar ha = h * _a[i][j];
+				for (size_t e = 0; e < n; ++e) _stage[e] += ha * _k[j][e];
+			}
+			f(t + _c[i] * h, _stage, _k[i]);
+		}
+		for (size_t e = 0; e < n; ++e) {
+			Scalar increment(0);
+			for (size_t i = 0; i < _k.size(); ++i) increment += _b[i] * _k[i][e];
+			y[e] += h * increment;
+		}
+	}
+
+	// take steps of size h from t, returns the final time
+	template<typename System>
+	Scalar integrate(System&& f, Scalar t, vector<Scalar>& y, const Scalar& h, size_t steps) {
+		for (size_t s = 0; s < steps; ++s) {
+			step(f, t, y, h);
+			t += h;
+		}
+		return t;
+	}
+
+private:
+	std::vector<std::vector<Scalar>> _a;
+	std::vector<Scalar> _b, _c;
+	std::vector<vector<Scalar>> _k;
+	vector<Scalar> _stage;
+};
+
+// results of an ensemble run: the divergence from the reference lane at every sample time
+struct ensemble_lane {
+	std::string type;
+	std::vector<double> divergence;    // max_i |y_i - y_ref_i| at every sample
+	std::vector<double> state;         // final state
+	double seconds = 0.0;              // time spent integrating, excluding the waits for the other lanes
+	std::string error;                 // arithmetic exception that stopped the lane, if any
+};
+
+struct ensemble_report {
+	std::vector<double> time;
+	std::vector<ensemble_lane> lanes;  // lanes[0] is the reference
+};
+
+namespace ensemble_internal {
+
+	struct context {
+		const butcher_tableau& tableau;
+		const std::vector<double>& y0;
+		double t0, h;
+		size_t samples, sampleInterval;
+		// the state of every lane at the last two samples: a lane publishes sample s while slower lanes read sample s - 1
+		std::vector<std::vector<double>> published[2];
+		std::barrier<> meet;  // lanes meet at every sample
+		ensemble_report& report;
+	};
+
+	template<typename Scalar, typename System>
+	void run_lane(size_t lane, context& ctx, System& f) {
+		ensemble_lane& result = ctx.report.lanes[lane];
+		result.type = type_tag(Scalar());
+		result.divergence.resize(ctx.samples);
+		size_t n = ctx.y0.size();
+		explicit_runge_kutta<Scalar> rk(ctx.tableau, n);
+		vector<Scalar> y(n);
+		for (size_t i = 0; i < n; ++i) y[i] = Scalar(ctx.y0[i]);
+		Scalar t(ctx.t0), h(ctx.h);
+		bool failed = false;
+		for (size_t s = 0; s < ctx.samples; ++s) {
+			if (s > 0 && !failed) {
+				auto begin = std::chrono::steady_clock::now();
+				try {
+					t = rk.integrate(f, t, y, h, ctx.sampleInterval);
+				}
+				catch (const std::exception& err) {
+					// keep meeting the other lanes, reporting NaN from here on
+					failed = true;
+					result.error = err.what();
+				}
+				catch (...) {
+					failed = true;
+					result.error = "unknown exception";
+				}
+				std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+				result.seconds += elapsed.count();
+			}
+			auto& mine = ctx.published[s % 2][lane];
+			for (size_t i = 0; i < n; ++i) mine[i] = (failed ? std::numeric_limits<double>::quiet_NaN() : double(y[i]));
+			ctx.meet.arrive_and_wait();
+			const auto& reference = ctx.published[s % 2][0];
+			double divergence = 0.0;
+			for (size_t i = 0; i < n; ++i) {
+				double d = std::abs(mine[i] - reference[i]);
+				divergence = (d > divergence || std::isnan(d)) ? d : divergence;
+			}
+			result.divergence[s] = divergence;
+		}
+		result.state = ctx.published[(ctx.samples - 1) % 2][lane];
+	}
+
+} // namespace ensemble_internal
+
+// integrate y' = f(t, y) from y(t0) = y0 over steps steps of size h in every number system of the tuple,
+// sampling the divergence from the first type every sampleInterval steps; f is called concurrently from all lanes
+template<typename... Scalars, typename System>
+ensemble_report ensemble_integrate(const std::tuple<Scalars...>&, const butcher_tableau& tableau, System&& f, const std::vector<double>& y0, double t0, double h, size_t steps, size_t sampleInterval = 1) {
+	constexpr size_t nrLanes = sizeof...(Scalars);
+	static_assert(nrLanes > 0, "an ensemble needs at least a reference type");
+	if (sampleInterval == 0) sampleInterval = 1;
+	size_t samples = steps / sampleInterval + 1;
+
+	ensemble_report report;
+	report.lanes.resize(nrLanes);
+	for (size_t s = 0; s < samples; ++s) report.time.push_back(t0 + double(s * sampleInterval) * h);
+	ensemble_internal::context ctx{ tableau, y0, t0, h, samples, sampleInterval, {}, std::barrier<>(static_cast<std::ptrdiff_t>(nrLanes)), report };
+	for (auto& buffer : ctx.published) buffer.assign(nrLanes, std::vector<double>(y0.size()));
+
+	std::vector<std::thread> lanes;
+	lanes.reserve(nrLanes);
+	size_t lane = 0;
+	(lanes.emplace_back([&ctx, &f, index = lane++]() { ensemble_internal::run_lane<Scalars>(index, ctx, f); }), ...);
+	for (auto& l : lanes) l.join();
+	return report;
+}
+
+}}} // namespace sw::universal::blas
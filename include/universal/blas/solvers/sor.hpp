@@ -6,6 +6,7 @@
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 #include <universal/number/posit/posit_fwd.hpp>
 #include <universal/blas/matrix.hpp>
+#include <universal/blas/stencil.hpp>
 
 namespace sw { namespace universal { namespace blas {
 
@@ -17,22 +18,31 @@ size_t sor(const Matrix& A, const Vector& b, Vector& x, typename Matrix::value_t
 	size_t m = num_rows(A);
 	size_t n = num_cols(A);
 	size_t itr = 0;
-	while (residual > tolerance && itr < MAX_ITERATIONS) {
-		Vector x_old = x;
-		// Gauss-Seidel step
-		for (size_t i = 1; i <= m; ++i) {
-			Scalar sigma = 0;
-			for (size_t j = 1; j <= i - 1; ++j) {
-				sigma += A(i - 1, j - 1) * x(j - 1);
-			}
-			for (size_t j = i + 1; j <= n; ++j) {
-				sigma += A(i - 1, j - 1) * x_old(j - 1);
+	if constexpr (is_stencil<Matrix>) {
+		// matrix-free red-black sweeps
+		while (residual > tolerance && itr < MAX_ITERATIONS) {
+			residual = A.sor_sweep(b, x, w);
+			++itr;
+		}
+	}
+	else {
+		while (residual > tolerance && itr < MAX_ITERATIONS) {
+			Vector x_old = x;
+			// Gauss-Seidel step
+			for (size_t i = 1; i <= m; ++i) {
+				Scalar sigma = 0;
+				for (size_t j = 1; j <= i - 1; ++j) {
+					sigma += A(i - 1, j - 1) * x(j - 1);
+				}
+				for (size_t j = i + 1; j <= n; ++j) {
+					sigma += A(i - 1, j - 1) * x_old(j - 1);
+				}
+				x(i - 1) = (1 - w) * x_old(i - 1) + w * (b(i - 1) - sigma) / A(i - 1, i - 1);
 			}
-			x(i - 1) = (1 - w) * x_old(i - 1) + w * (b(i - 1) - sigma) / A(i - 1, i - 1);
+			residual = norm(x_old - x, 1);
+			// std::cout << '[' << itr << "] " << x << " residual " << residual << std::endl;
+			++itr;
 		}
-		residual = norm(x_old - x, 1);
-		// std::cout << '[' << itr << "] " << x << " residual " << residual << std::endl;
-		++itr;
 	}
 	std::cout << "over-relaxation factor w is " << w << '\n';
 	std::cout << "final residual is " << residual << '\n';
@@ -1,68 +1,287 @@
-#pragma once
-// svd.hpp: generate bit patterns and values for a 16-bit takum
-//
-// Copyright (C) 2017 Stillwater Supercomputing, Inc.
-// SPDX-License-Identifier: MIT
-//
-// This file is part of the universal numbers project, which is released under an MIT Open Source license.
-#include <algorithm>
-
-#include <universal/blas/blas_l1.hpp>
-#include <universal/blas/matrix.hpp>
-
-namespace sw { namespace universal { namespace blas {
-
-template<typename Scalar, typename Tolerance = double>
-void svd(const matrix<Scalar>& A, matrix<Scalar>& S, matrix<Scalar>& V, matrix<Scalar>& D, Tolerance tol = 10e-10) {
-/*
-    using value_type = Scalar;
-    using size_type  = typename matrix<Scalar>::size_type;
-    size_type        ncols = num_cols(A), nrows = num_rows(A);
-    value_type       ref, zero = Scalar{ 0 }, one = Scalar{ 1 };
-    
-    // if (nrows != ncols) std::swap(row, col);
-
-    matrix<Scalar> Q(nrows, nrows), R(nrows, ncols), VT(nrows, ncols), E(nrows, ncols),QT(ncols, ncols), RT(ncols, nrows);
-    size_type l = 100 * std::max(nrows, ncols);
-    S = one; D = one; 
-    double err{ std::numeric_limits<double>::max() };
-    for (size_type i = 0; err > tol && i < l; ++i) {
-        double e, f;
-        std::tie(QT, RT) = qr(V);
-        S *= QT;
-        VT = RT.transpose();
-        std::tie(Q, R) = qr(VT);
-        D *= Q;
-        E = triu(R, 1);
-        V = trans(R);
-        f=norm(diag(R), 2);
-        e=norm(E);
-        if(f==zero) f=1;
-        err=e/f;
-    }
-    {
-	    V= 0;  
-	    matrix<Scalar>  ins_V(V), ins_S(S);
-	                
-	    for (size_type i= 0, end= std::min(nrows, ncols); i < end; ++i) {
-	        ins_V[i][i] *= std::abs(R[i][i]);
-	        if (R[i][i] < zero) 	
-		    for (size_type j= 0; j < nrows; ++j) 
-		    ins_S[j][i] *= -1; 
-	    }
-    }
-    */
-}
-
-template<typename Scalar, typename Tolerance>
-std::tuple<matrix<Scalar>, matrix<Scalar>, matrix<Scalar>> svd(const matrix<Scalar>& A, Tolerance tol= 10e-10) {
-    using size_type = typename matrix<Scalar>::size_type;
-    size_type    ncols = num_cols(A), nrows = num_rows(A);
-    //if (nrows != ncols) std::swap(row, col);
-    matrix<Scalar> ST(ncols, ncols), V(A), D(nrows, nrows);
-    svd(A, ST, V, D, tol);
-    return std::make_tuple(ST, V, D);
-
-}   
-
-}}} // namespace sw::universal::blas
+#pragma once
+// svd.hpp: singular value decomposition by one-sided Jacobi rotations
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <algorithm>
+#include <barrier>
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <numeric>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <universal/blas/blas_l1.hpp>
+#include <universal/blas/matrix.hpp>
+#include <universal/number/posit/posit_fwd.hpp>
+
+/*
+	One-sided Jacobi SVD (Hestenes)
+
+	The columns of A are orthogonalized in place by plane rotations: for a column pair (p, q) with
+	  alpha = a_p.a_p,  beta = a_q.a_q,  gamma = a_p.a_q
+	the rotation that zeroes gamma is applied to both columns and accumulated into V. When all pairs
+	are orthogonal to working precision, the column norms are the singular values and the normalized
+	columns are the left singular vectors, A = U * Sigma * V^T.
+
+	A sweep visits every pair once in round-robin (tournament) order: each of the n-1 rounds of a sweep
+	consists of n/2 disjoint pairs, so the rotations of a round are independent and are distributed
+	across worker threads, which meet at a barrier between rounds.
+
+	The columns are stored as the rows of the transposed matrix, so the inner products and rotations
+	stream through contiguous memory. For posit Scalars the three inner products of a pair can be
+	accumulated in the quire, which rounds each of them only once.
+*/
+
+namespace sw { namespace universal { namespace blas {
+
+// smallest number of columns for which the rotations of a round are distributed across threads
+#ifndef SVD_PARALLEL_THRESHOLD
+#define SVD_PARALLEL_THRESHOLD 64
+#endif
+
+struct svd_options {
+	double   tolerance{ 0.0 };     // orthogonality threshold |gamma| <= tolerance * sqrt(alpha * beta); 0 selects sqrt(m) * epsilon
+	unsigned maxSweeps{ 60 };
+	unsigned nrThreads{ 0 };       // 0 selects the hardware concurrency
+	bool     fused{ false };       // accumulate the inner products in the quire for posit Scalars
+	bool     trace{ false };       // print the convergence trace to std::cout
+};
+
+struct svd_convergence {
+	unsigned            sweeps{ 0 };
+	bool                converged{ false };
+	std::vector<double> offness;      // largest |gamma| / sqrt(alpha * beta) encountered in each sweep
+	std::vector<size_t> rotations;    // number of rotations applied in each sweep
+};
+
+namespace internal {
+
+	// alpha = x.x, beta = y.y, gamma = x.y
+	template<typename Scalar>
+	void svd_inner_products(const Scalar* x, const Scalar* y, size_t m, bool, Scalar& alpha, Scalar& beta, Scalar& gamma) {
+		alpha = Scalar(0); beta = Scalar(0); gamma = Scalar(0);
+		for (size_t k = 0; k < m; ++k) {
+			alpha += x[k] * x[k];
+			beta  += y[k] * y[k];
+			gamma += x[k] * y[k];
+		}
+	}
+
+	template<unsigned nbits, unsigned es>
+	void svd_inner_products(const posit<nbits, es>* x, const posit<nbits, es>* y, size_t m, bool fused, posit<nbits, es>& alpha, posit<nbits, es>& beta, posit<nbits, es>& gamma) {
+		using Scalar = posit<nbits, es>;
+		if (!fused) {
+			alpha = Scalar(0); beta = Scalar(0); gamma = Scalar(0);
+			for (size_t k = 0; k < m; ++k) {
+				alpha += x[k] * x[k];
+				beta  += y[k] * y[k];
+				gamma += x[k] * y[k];
+			}
+			return;
+		}
+		constexpr unsigned capacity = 20; // FDP for vectors < 1,048,576 elements
+		quire<nbits, es, capacity> qa, qb, qg;
+		for (size_t k = 0; k < m; ++k) {
+			qa += quire_mul(x[k], x[k]);
+			qb += quire_mul(y[k], y[k]);
+			qg += quire_mul(x[k], y[k]);
+		}
+		convert(qa.to_value(), alpha);
+		convert(qb.to_value(), beta);
+		convert(qg.to_value(), gamma);
+	}
+
+	// rotate the column pair (p, q) of W and V, stored as rows, if they are not yet orthogonal
+	// returns the normalized inner product |gamma| / sqrt(alpha * beta) before the rotation
+	template<typename Scalar>
+	double svd_rotate(matrix<Scalar>& W, matrix<Scalar>& VT, size_t p, size_t q, double threshold, bool fused, size_t& rotations) {
+		using std::sqrt; using std::abs;
+		size_t m = num_cols(W), n = num_cols(VT);
+		Scalar* wp = &W(p, 0);
+		Scalar* wq = &W(q, 0);
+		Scalar alpha, beta, gamma;
+		svd_inner_products(wp, wq, m, fused, alpha, beta, gamma);
+		double a = double(alpha), b = double(beta), g = std::fabs(double(gamma));
+		if (a == 0.0 || b == 0.0 || g == 0.0) return 0.0;
+		double offness = g / (std::sqrt(a) * std::sqrt(b));
+		if (!(offness > threshold)) return offness;
+
+		// the rotation angle: t = tan(theta) is the smaller root of t^2 + 2 zeta t - 1 = 0
+		Scalar zeta = (beta - alpha) / (Scalar(2) * gamma);
+		Scalar t = Scalar(1) / (abs(zeta) + sqrt(Scalar(1) + zeta * zeta));
+		if (zeta < Scalar(0)) t = -t;
+		Scalar c = Scalar(1) / sqrt(Scalar(1) + t * t);
+		Scalar s = c * t;
+		for (size_t k = 0; k < m; ++k) {
+			Scalar x = wp[k], y = wq[k];
+			wp[k] = c * x - s * y;
+			wq[k] = s * x + c * y;
+		}
+		Scalar* vp = &VT(p, 0);
+		Scalar* vq = &VT(q, 0);
+		for (size_t k = 0; k < n; ++k) {
+			Scalar x = vp[k], y = vq[k];
+			vp[k] = c * x - s * y;
+			vq[k] = s * x + c * y;
+		}
+		++rotations;
+		return offness;
+	}
+
+	// the r-th round of a tournament over N (even) players: pair k of the round is (player(k), player(N-1-k))
+	// player 0 stays in place and the others rotate by one position per round
+	inline size_t svd_tournament_player(size_t N, size_t round, size_t position) {
+		if (position == 0) return 0;
+		return 1 + (position - 1 + round) % (N - 1);
+	}
+
+	// orthogonalize the rows of W in place and accumulate the rotations in VT
+	template<typename Scalar>
+	svd_convergence jacobi_sweeps(matrix<Scalar>& W, matrix<Scalar>& VT, const svd_options& options) {
+		size_t n = num_rows(W), m = num_cols(W);
+		double threshold = options.tolerance;
+		if (threshold <= 0.0) threshold = std::sqrt(double(std::max<size_t>(m, 1))) * double(std::numeric_limits<Scalar>::epsilon());
+		svd_convergence result;
+		if (n < 2) {
+			result.converged = true;
+			return result;
+		}
+		size_t N = n + (n & 1);           // a dummy column completes the tournament for odd n
+		size_t nrPairs = N / 2;
+		size_t nrRounds = N - 1;
+		unsigned nrThreads = options.nrThreads > 0 ? options.nrThreads : std::max(1u, std::thread::hardware_concurrency());
+		if (n < SVD_PARALLEL_THRESHOLD) nrThreads = 1;
+		nrThreads = static_cast<unsigned>(std::min<size_t>(nrThreads, nrPairs));
+
+		std::vector<double> offness(nrThreads);
+		std::vector<size_t> rotations(nrThreads);
+		std::vector<std::exception_ptr> errors(nrThreads);
+		auto round = [&](unsigned tid, size_t r) {
+			for (size_t k = tid; k < nrPairs; k += nrThreads) {
+				size_t p = svd_tournament_player(N, r, k);
+				size_t q = svd_tournament_player(N, r, N - 1 - k);
+				if (p >= n || q >= n) continue;
+				if (p > q) std::swap(p, q);
+				offness[tid] = std::max(offness[tid], svd_rotate(W, VT, p, q, threshold, options.fused, rotations[tid]));
+			}
+		};
+
+		while (result.sweeps < options.maxSweeps) {
+			std::fill(offness.begin(), offness.end(), 0.0);
+			std::fill(rotations.begin(), rotations.end(), size_t(0));
+			if (nrThreads == 1) {
+				for (size_t r = 0; r < nrRounds; ++r) round(0, r);
+			}
+			else {
+				std::barrier sync(static_cast<std::ptrdiff_t>(nrThreads));
+				auto worker = [&](unsigned tid) {
+					try {
+						for (size_t r = 0; r < nrRounds; ++r) {
+							round(tid, r);
+							sync.arrive_and_wait();
+						}
+					}
+					catch (...) {
+						errors[tid] = std::current_exception();
+						sync.arrive_and_drop();   // release the other workers from the rounds this one abandons
+					}
+				};
+				std::vector<std::thread> workers;
+				workers.reserve(nrThreads - 1);
+				for (unsigned tid = 1; tid < nrThreads; ++tid) workers.emplace_back(worker, tid);
+				worker(0);
+				for (auto& w : workers) w.join();
+				for (auto& e : errors) if (e) std::rethrow_exception(e);
+			}
+			++result.sweeps;
+			double sweepOffness = *std::max_element(offness.begin(), offness.end());
+			size_t sweepRotations = std::accumulate(rotations.begin(), rotations.end(), size_t(0));
+			result.offness.push_back(sweepOffness);
+			result.rotations.push_back(sweepRotations);
+			if (options.trace) std::cout << "sweep " << result.sweeps << " : rotations " << sweepRotations << " : offness " << sweepOffness << '\n';
+			if (sweepRotations == 0) {
+				result.converged = true;
+				break;
+			}
+		}
+		return result;
+	}
+
+} // namespace internal
+
+// thin SVD of an m-by-n matrix A = U * diag(sigma) * V^T with p = min(m, n)
+// U is m-by-p, sigma holds the p singular values in decreasing order, and V is n-by-p
+template<typename Scalar>
+svd_convergence jacobi_svd(const matrix<Scalar>& A, matrix<Scalar>& U, vector<Scalar>& sigma, matrix<Scalar>& V, const svd_options& options = svd_options{}) {
+	using std::sqrt;
+	size_t m = num_rows(A), n = num_cols(A);
+	bool wide = m < n;             // decompose A^T = V * Sigma * U^T instead
+	size_t rows = wide ? n : m;
+	size_t cols = wide ? m : n;
+
+	// W holds the columns of the matrix being orthogonalized as rows
+	matrix<Scalar> W(cols, rows), VT(cols, cols);
+	for (size_t i = 0; i < m; ++i) {
+		for (size_t j = 0; j < n; ++j) {
+			if (wide) W(i, j) = A(i, j); else W(j, i) = A(i, j);
+		}
+	}
+	VT = Scalar(1);
+	svd_convergence result = internal::jacobi_sweeps(W, VT, options);
+
+	// the singular values are the norms of the orthogonalized columns
+	std::vector<Scalar> norms(cols);
+	for (size_t j = 0; j < cols; ++j) {
+		Scalar sumOfSquares(0);
+		for (size_t k = 0; k < rows; ++k) sumOfSquares += W(j, k) * W(j, k);
+		norms[j] = sqrt(sumOfSquares);
+	}
+	std::vector<size_t> order(cols);
+	std::iota(order.begin(), order.end(), size_t(0));
+	std::stable_sort(order.begin(), order.end(), [&norms](size_t a, size_t b) { return norms[b] < norms[a]; });
+
+	matrix<Scalar> left(rows, cols), right(cols, cols);
+	sigma.resize(cols);
+	for (size_t j = 0; j < cols; ++j) {
+		size_t src = order[j];
+		Scalar s = norms[src];
+		sigma[j] = s;
+		for (size_t k = 0; k < rows; ++k) left(k, j) = (s == Scalar(0) ? Scalar(0) : W(src, k) / s);
+		for (size_t k = 0; k < cols; ++k) right(k, j) = VT(src, k);
+	}
+	if (wide) {
+		U = right;
+		V = left;
+	}
+	else {
+		U = left;
+		V = right;
+	}
+	return result;
+}
+
+// A = S * V * D^T, with S the left singular vectors, V the diagonal matrix of singular values, and D the right singular vectors
+template<typename Scalar, typename Tolerance = double>
+void svd(const matrix<Scalar>& A, matrix<Scalar>& S, matrix<Scalar>& V, matrix<Scalar>& D, Tolerance tol = 10e-10) {
+	svd_options options;
+	options.tolerance = std::max(double(tol), double(std::numeric_limits<Scalar>::epsilon()));
+	vector<Scalar> sigma;
+	jacobi_svd(A, S, sigma, D, options);
+	size_t p = sigma.size();
+	V = matrix<Scalar>(p, p);
+	for (size_t i = 0; i < p; ++i) V(i, i) = sigma[i];
+}
+
+template<typename Scalar, typename Tolerance = double>
+std::tuple<matrix<Scalar>, matrix<Scalar>, matrix<Scalar>> svd(const matrix<Scalar>& A, Tolerance tol = 10e-10) {
+	matrix<Scalar> S, V, D;
+	svd(A, S, V, D, tol);
+	return std::make_tuple(S, V, D);
+}
+
+}}} // namespace sw::universal::blas
@@ -6,8 +6,21 @@
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <limits>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <vector>
 #include <universal/blas/vector.hpp>
+#include <universal/blas/parallel.hpp>
+
+// number of samples below which summaryStatistics accumulates on the calling thread
+#ifndef STATISTICS_PARALLEL_GRAIN
+#define STATISTICS_PARALLEL_GRAIN (size_t(1) << 16)
+#endif
 
 namespace sw { namespace universal { namespace blas {
 
@@ -15,6 +28,8 @@ namespace sw { namespace universal { namespace blas {
 	struct Quantiles {
 		Quantiles() = default;
 		Quantiles(Quantiles&) = default;
+		Quantiles(const Quantiles&) = default;
+		Quantiles& operator=(const Quantiles&) = default;
 		Quantiles(Scalar q0, Scalar q1, Scalar q2, Scalar q3, Scalar q4) {
 			set(q0, q1, q2, q3, q4);
 		}
@@ -25,13 +40,13 @@ namespace sw { namespace universal { namespace blas {
 			q[3] = q3;
 			q[4] = q4;
 		}
-		Scalar q[5];
+		Scalar q[5]{};
 	};
 
 	template<typename Scalar>
 	std::ostream& operator<<(std::ostream& ostr, const Quantiles<Scalar>& quantiles) {
 		ostr << "quantiles: ";
-		ostr << " [ " 
+		ostr << " [ "
 			<< quantiles.q[0] << ", "
 			<< quantiles.q[1] << ", "
 			<< quantiles.q[2] << ", "
@@ -45,8 +60,8 @@ namespace sw { namespace universal { namespace blas {
 	struct SummaryStats {
 		SummaryStats() = default;
 
-		Scalar            mean;
-		Scalar            stddev;
+		Scalar            mean{};
+		Scalar            stddev{};
 		Quantiles<Scalar> quantiles;
 	};
 
@@ -58,57 +73,319 @@ namespace sw { namespace universal { namespace blas {
 		return ostr;
 	}
 
+	/// <summary>
+	/// single-pass mean and variance (Welford) with the extrema of the non-NaN samples.
+	/// Accumulators of disjoint samples combine with merge (Chan, Golub, LeVeque),
+	/// so each thread can summarize its own slice of the data.
+	/// </summary>
+	template<typename Scalar>
+	class StreamingStats {
+	public:
+		void push(const Scalar& x) {
+			using std::isnan;
+			++n;
+			Scalar delta = x - m;
+			m += delta / Scalar(double(n));
+			m2 += delta * (x - m);
+			if (isnan(x)) {
+				++nrNaNs;
+				return;
+			}
+			if (n - nrNaNs == 1) {
+				lo = x;
+				hi = x;
+			}
+			else {
+				if (x < lo) lo = x;
+				if (hi < x) hi = x;
+			}
+		}
+		void merge(const StreamingStats& other) {
+			if (other.n == 0) return;
+			if (n == 0) {
+				*this = other;
+				return;
+			}
+			double na = double(n), nb = double(other.n), nab = na + nb;
+			Scalar delta = other.m - m;
+			m += delta * Scalar(nb / nab);
+			m2 += other.m2 + delta * delta * Scalar(na * nb / nab);
+			if (other.n > other.nrNaNs) {
+				if (n == nrNaNs) {
+					lo = other.lo;
+					hi = other.hi;
+				}
+				else {
+					if (other.lo < lo) lo = other.lo;
+					if (hi < other.hi) hi = other.hi;
+				}
+			}
+			n += other.n;
+			nrNaNs += other.nrNaNs;
+		}
+
+		size_t count() const noexcept { return n; }
+		size_t nans() const noexcept { return nrNaNs; }
+		Scalar mean() const { return m; }
+		// sample variance, normalized by N - 1
+		Scalar variance() const { return (n > 1 ? m2 / Scalar(double(n - 1)) : Scalar(0)); }
+		Scalar stddev() const { using std::sqrt; return sqrt(variance()); }
+		Scalar min() const { return lo; }
+		Scalar max() const { return hi; }
+
+	private:
+		size_t n{ 0 }, nrNaNs{ 0 };
+		Scalar m{ 0 }, m2{ 0 }, lo{ 0 }, hi{ 0 };
+	};
+
+	/// <summary>
+	/// mergeable quantile sketch (Karnin, Lang, Liberty 2016) of a stream of samples.
+	/// The sketch retains about 3k samples in a stack of compactors; the rank error of
+	/// a quantile query is about 1.7/k of the stream length, under 1% for the default k = 200. The extrema are exact,
+	/// and NaNs are counted apart and rank below every other value, as in summaryStatistics.
+	/// </summary>
+	template<typename Scalar>
+	class QuantileSketch {
+	public:
+		explicit QuantileSketch(unsigned k = 200, uint64_t seed = 1) : k{ std::max(k, 8u) }, engine{ seed } { grow(1); }
+
+		void push(const Scalar& x) {
+			using std::isnan;
+			++n;
+			if (isnan(x)) {
+				if (nrNaNs++ == 0) nanValue = x;
+				return;
+			}
+			if (n - nrNaNs == 1) {
+				lo = x;
+				hi = x;
+			}
+			else {
+				if (x < lo) lo = x;
+				if (hi < x) hi = x;
+			}
+			levels[0].push_back(x);
+			if (++nrRetained >= maxRetained) compress();
+		}
+
+		void merge(const QuantileSketch& other) {
+			if (other.n == other.nrNaNs) {
+				if (nrNaNs == 0 && other.nrNaNs > 0) nanValue = other.nanValue;
+				n += other.n;
+				nrNaNs += other.nrNaNs;
+				return;
+			}
+			if (n == nrNaNs) {
+				lo = other.lo;
+				hi = other.hi;
+			}
+			else {
+				if (other.lo < lo) lo = other.lo;
+				if (hi < other.hi) hi = other.hi;
+			}
+			if (nrNaNs == 0 && other.nrNaNs > 0) nanValue = other.nanValue;
+			n += other.n;
+			nrNaNs += other.nrNaNs;
+			if (levels.size() < other.levels.size()) grow(other.levels.size());
+			for (size_t h = 0; h < other.levels.size(); ++h) {
+				size_t middle = levels[h].size();
+				levels[h].insert(levels[h].end(), other.levels[h].begin(), other.levels[h].end());
+				if (h > 0) std::inplace_merge(levels[h].begin(), levels[h].begin() + middle, levels[h].end());
+			}
+			nrRetained += other.nrRetained;
+			compress();
+		}
+
+		// value of rank floor(phi * N) in the sorted stream, 0 <= phi <= 1
+		Scalar quantile(double phi) const {
+			return rankedValue(sortedView(), rank(phi));
+		}
+
+		// min, quartiles, and max from a single sorted view of the retained samples
+		Quantiles<Scalar> quartiles() const {
+			auto view = sortedView();
+			return Quantiles<Scalar>(rankedValue(view, 0), rankedValue(view, n / 4), rankedValue(view, n / 2),
+				rankedValue(view, (3 * n) / 4), rankedValue(view, (n > 0 ? n - 1 : 0)));
+		}
+
+		size_t count() const noexcept { return n; }
+		size_t retained() const noexcept { return nrRetained; }
+
+	private:
+		unsigned k;
+		std::mt19937_64 engine;
+		std::vector<std::vector<Scalar>> levels;   // level h holds samples of weight 2^h, sorted for h > 0
+		std::vector<size_t> capacities;            // capacity of each level
+		size_t maxRetained{ 0 };                   // sum of the capacities
+		size_t n{ 0 }, nrNaNs{ 0 }, nrRetained{ 0 };
+		Scalar lo{ 0 }, hi{ 0 }, nanValue{ 0 };
+
+		// capacities shrink by 2/3 per level below the top, with a floor of eight samples
+		void grow(size_t depth) {
+			levels.resize(depth);
+			capacities.resize(depth);
+			maxRetained = 0;
+			double c = double(k);
+			for (size_t e = 0; e < depth; ++e) {
+				size_t h = depth - 1 - e;
+				capacities[h] = std::max<size_t>(8, size_t(std::ceil(c)));
+				maxRetained += capacities[h];
+				c *= 2.0 / 3.0;
+			}
+		}
+
+		// promote every other sample of the lowest full level, starting at a random parity;
+		// only the incoming samples need sorting, as the promoted samples merge into a sorted level
+		void compress() {
+			while (nrRetained >= maxRetained) {
+				size_t h = 0;
+				while (levels[h].size() < capacities[h]) ++h;
+				if (h + 1 == levels.size()) grow(levels.size() + 1);
+				std::vector<Scalar>& level = levels[h];
+				std::vector<Scalar>& next = levels[h + 1];
+				if (h == 0) std::sort(level.begin(), level.end());
+				size_t middle = next.size();
+				size_t keep = level.size() % 2;     // an odd sample stays behind so the weights add up
+				size_t offset = size_t(engine() & 1);
+				size_t before = level.size();
+				for (size_t i = keep + offset; i < level.size(); i += 2) next.push_back(level[i]);
+				std::inplace_merge(next.begin(), next.begin() + middle, next.end());
+				level.resize(keep);
+				nrRetained -= (before - keep) / 2;
+			}
+		}
+
+		std::vector<std::pair<Scalar, uint64_t>> sortedView() const {
+			std::vector<std::pair<Scalar, uint64_t>> view;
+			view.reserve(nrRetained);
+			for (size_t h = 0; h < levels.size(); ++h) {
+				for (const Scalar& x : levels[h]) view.emplace_back(x, uint64_t(1) << h);
+			}
+			std::sort(view.begin(), view.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+			return view;
+		}
+
+		size_t rank(double phi) const {
+			if (n == 0) return 0;
+			double r = std::floor(std::clamp(phi, 0.0, 1.0) * double(n));
+			return std::min(n - 1, size_t(r));
+		}
+
+		Scalar rankedValue(const std::vector<std::pair<Scalar, uint64_t>>& view, size_t r) const {
+			if (n == 0) return Scalar(0);
+			if (r < nrNaNs) return nanValue;
+			r -= nrNaNs;
+			if (r == 0) return lo;
+			if (r + 1 + nrNaNs >= n) return hi;
+			uint64_t cumulative = 0;
+			for (const auto& item : view) {
+				cumulative += item.second;
+				if (cumulative > r) return item.first;
+			}
+			return hi;
+		}
+	};
+
+	// Sketch: quantiles from a QuantileSketch of size k, O(N) time and O(k) memory, the default
+	// Exact:  quantiles from one copy of the data partitioned with nth_element, O(N) time and N samples of memory
+	enum class QuantileMethod { Exact, Sketch };
+
+	namespace statistics_internal {
+
+		// NaN ranks below any other value
+		template<typename Scalar>
+		bool nanFirst(const Scalar& a, const Scalar& b) {
+			using std::isnan;
+			if (isnan(a) && !isnan(b)) return true;
+			if (!isnan(a) && isnan(b)) return false;
+			return a < b; // this assumes a reasonable interpretation of NaN < NaN
+		}
+
+		template<typename Vector>
+		Quantiles<typename Vector::value_type> exactQuantiles(const Vector& data) {
+			using Scalar = typename Vector::value_type;
+			size_t N = size(data);
+			if (N == 0) return Quantiles<Scalar>{};
+			std::vector<Scalar> v(data.begin(), data.end());
+			auto lt = nanFirst<Scalar>;
+			size_t q1 = N / 4, q2 = N / 2, q3 = (3 * N) / 4;
+			std::nth_element(v.begin(), v.begin() + q2, v.end(), lt);
+			if (q1 < q2) std::nth_element(v.begin(), v.begin() + q1, v.begin() + q2, lt);
+			if (q3 > q2) std::nth_element(v.begin() + q2 + 1, v.begin() + q3, v.end(), lt);
+			Scalar lo = *std::min_element(v.begin(), v.begin() + q1 + 1, lt);
+			Scalar hi = *std::max_element(v.begin() + q3, v.end(), lt);
+			return Quantiles<Scalar>(lo, v[q1], v[q2], v[q3], hi);
+		}
+
+		// accumulate the moments, and optionally a sketch, of each slice on its own thread,
+		// and merge the partial results in slice order so the outcome is reproducible
+		template<typename Vector>
+		void accumulate(const Vector& data, StreamingStats<typename Vector::value_type>& moments,
+			QuantileSketch<typename Vector::value_type>* sketch, unsigned sketchSize) {
+			using Scalar = typename Vector::value_type;
+			struct Partial {
+				size_t begin;
+				StreamingStats<Scalar> moments;
+				std::optional< QuantileSketch<Scalar> > sketch;  // only constructed when the quantiles are sketched
+			};
+			std::vector<Partial> partials;
+			std::mutex guard;
+			parallel_for(size(data), STATISTICS_PARALLEL_GRAIN, [&](size_t begin, size_t end) {
+				Partial partial{ begin, StreamingStats<Scalar>{}, std::nullopt };
+				if (sketch) {
+					partial.sketch.emplace(sketchSize, begin + 1);
+					for (size_t i = begin; i < end; ++i) {
+						partial.moments.push(data[i]);
+						partial.sketch->push(data[i]);
+					}
+				}
+				else {
+					for (size_t i = begin; i < end; ++i) partial.moments.push(data[i]);
+				}
+				std::lock_guard<std::mutex> lock(guard);
+				partials.push_back(std::move(partial));
+			});
+			std::sort(partials.begin(), partials.end(), [](const Partial& a, const Partial& b) { return a.begin < b.begin; });
+			for (const Partial& partial : partials) {
+				moments.merge(partial.moments);
+				if (sketch) sketch->merge(*partial.sketch);
+			}
+		}
+
+	}  // namespace statistics_internal
+
+	/// <summary>
+	/// mean, sample standard deviation, and min/quartiles/max of a data set in a single pass over the data
+	/// </summary>
+	/// <param name="data">data set, a random access container</param>
+	/// <param name="method">quantiles estimated with a QuantileSketch, the default, or exact quantiles from a copy of the data</param>
+	/// <param name="sketchSize">k of the QuantileSketch: larger is more accurate</param>
 	template<typename Vector>
-	SummaryStats<typename Vector::value_type> summaryStatistics(const Vector& data) {
-		using std::isnan;
-		using std::sqrt;
+	SummaryStats<typename Vector::value_type> summaryStatistics(const Vector& data, QuantileMethod method = QuantileMethod::Sketch, unsigned sketchSize = 200) {
 		using Scalar = typename Vector::value_type;
 		SummaryStats<Scalar> stats;
-		size_t N = size(data);
-		Scalar sum{0};
-		for (auto e : data) {
-			sum += e;
-		}
-		stats.mean = sum / Scalar(N);
-		sum = 0.0;
-		for (auto e : data) {
-			Scalar s = (e - stats.mean);
-			sum += s*s;
-		}
-		stats.stddev = sqrt(sum / Scalar(N - 1)); // use sample statistics formula
-					      //
-		Vector v(data); // create a copy you can sort
-		std::sort(v.begin(), v.end(), 
-			[](const Scalar& a, const Scalar& b) {
-				// making NaN smaller than any other value
-				if (isnan(a) && !isnan(b)) return true;
-				if (!isnan(a) && isnan(b)) return false;
-				return a < b; // this assumes a reasonable interpretation of NaN < NaN
-			});
-		stats.quantiles.set(v[0],       // min
-							v[N/4],     // first quartile
-							v[N/2],     // second quartile
-							v[(3*N)/4], // third quartile
-							v[N-1]);    // max
+		StreamingStats<Scalar> moments;
+		if (method == QuantileMethod::Sketch) {
+			QuantileSketch<Scalar> sketch(sketchSize);
+			statistics_internal::accumulate(data, moments, &sketch, sketchSize);
+			stats.quantiles = sketch.quartiles();
+		}
+		else {
+			statistics_internal::accumulate(data, moments, nullptr, sketchSize);
+			stats.quantiles = statistics_internal::exactQuantiles(data);
+		}
+		stats.mean = moments.mean();
+		stats.stddev = moments.stddev(); // use sample statistics formula
 		return stats;
 	}
 
 	template<typename Vector>
-	Quantiles<typename Vector::value_type> quantiles(const Vector& data) {
-		using std::isnan;
+	Quantiles<typename Vector::value_type> quantiles(const Vector& data, QuantileMethod method = QuantileMethod::Sketch, unsigned sketchSize = 200) {
 		using Scalar = typename Vector::value_type;
-		size_t N = size(data);
-		Vector v(data); // create a copy you can sort
-		std::sort(v.begin(), v.end(),
-			[](const Scalar& a, const Scalar& b) {
-				// making NaN smaller than any other value
-				if (isnan(a) && !isnan(b)) return true;
-				if (!isnan(a) && isnan(b)) return false;
-				return a < b; // this assumes a reasonable interpretation of NaN < NaN
-			});
-
-		Quantiles<Scalar> quantiles(v[0], v[N/4], v[N/2], v[(3*N)/4], v[N-1]);
-		return quantiles;
+		if (method == QuantileMethod::Exact) return statistics_internal::exactQuantiles(data);
+		QuantileSketch<Scalar> sketch(sketchSize);
+		for (size_t i = 0; i < size(data); ++i) sketch.push(data[i]);
+		return sketch.quartiles();
 	}
 
 } } }  // namespace sw::universal::blas
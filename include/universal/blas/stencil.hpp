@@ -0,0 +1,207 @@
+#pragma once
+// stencil.hpp: matrix-free constant-coefficient stencil operators on structured 2D and 3D grids
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <type_traits>
+#include <vector>
+#include <universal/blas/vector.hpp>
+#include <universal/blas/parallel.hpp>
+
+/*
+    A stencil<Scalar, Dim> is the matrix of a (2 Dim + 1)-point constant-coefficient stencil on a
+    grid of extent(0) x ... x extent(Dim-1) unknowns, numbered in row-major order, with homogeneous
+    Dirichlet boundaries:
+        (A x)(p) = center * x(p) + neighbor * sum of x(q) over the grid neighbors q of p
+    The laplace2D and laplace3D generators set up the 5-point and 7-point Laplacians, the same
+    matrices as the dense laplace2D generator, in O(1) storage.
+
+    The grid is traversed as lines along the last dimension, and a block of consecutive lines is
+    the unit of work of a thread, so a thread streams through lines that share their neighbor
+    lines in cache. Gauss-Seidel and SOR sweep in red-black order: a point is red when the sum of
+    its coordinates is even, and the points of one color only depend on points of the other, so
+    each half sweep updates its points in parallel. The change ||x_k - x_{k-1}||_1 that the
+    solvers test for convergence is accumulated per line and summed in line order, which makes
+    the iteration independent of the number of threads.
+*/
+
+// number of grid points in a unit of parallel work
+#ifndef STENCIL_BLOCK_SIZE
+#define STENCIL_BLOCK_SIZE 16384
+#endif
+
+namespace sw { namespace universal { namespace blas {
+
+template<typename Scalar, unsigned Dim>
+class stencil {
+public:
+	static_assert(Dim >= 1, "a stencil needs at least one dimension");
+	typedef Scalar                   value_type;
+	typedef size_t                   size_type;
+	typedef std::array<size_t, Dim>  extents_type;
+	static constexpr unsigned dimensions = Dim;
+
+	stencil() : _extents{}, _strides{}, _center{ 0 }, _neighbor{ 0 } {}
+	stencil(const extents_type& extents, const Scalar& center, const Scalar& neighbor) : _center{ center }, _neighbor{ neighbor } { resize(extents); }
+
+	// modifiers
+	void resize(const extents_type& extents) {
+		_extents = extents;
+		size_t stride = 1;
+		for (size_t e = 0; e < Dim; ++e) {
+			size_t d = Dim - 1 - e;
+			_strides[d] = stride;
+			stride *= extents[d];
+		}
+	}
+	void setcoefficients(const Scalar& center, const Scalar& neighbor) { _center = center; _neighbor = neighbor; }
+
+	// selectors
+	const extents_type& extents() const noexcept { return _extents; }
+	size_t extent(unsigned d) const { return _extents[d]; }
+	size_t size() const noexcept { size_t n = 1; for (auto e : _extents) n *= e; return n; }
+	size_t rows() const noexcept { return size(); }
+	size_t cols() const noexcept { return size(); }
+	Scalar center() const noexcept { return _center; }
+	Scalar neighbor() const noexcept { return _neighbor; }
+
+	// y = A x
+	void apply(const vector<Scalar>& x, vector<Scalar>& y) const {
+		if (y.size() != size()) y.resize(size());
+		for_each_line([&](const line& L, Scalar&) {
+			for (size_t j = 0; j < L.length; ++j) {
+				size_t p = L.base + j;
+				y[p] = _center * x[p] + _neighbor * neighbors(x, L, j);
+			}
+		});
+	}
+
+	// one Jacobi sweep: xnext = D^-1 (b - (A - D) x), returns ||xnext - x||_1
+	Scalar jacobi_sweep(const vector<Scalar>& b, const vector<Scalar>& x, vector<Scalar>& xnext) const {
+		using std::abs;
+		if (xnext.size() != size()) xnext.resize(size());
+		return for_each_line([&](const line& L, Scalar& change) {
+			for (size_t j = 0; j < L.length; ++j) {
+				size_t p = L.base + j;
+				xnext[p] = (b[p] - _neighbor * neighbors(x, L, j)) / _center;
+				change += abs(xnext[p] - x[p]);
+			}
+		});
+	}
+
+	// one red-black SOR sweep in place, w = 1 is a Gauss-Seidel sweep; returns ||x_k - x_{k-1}||_1
+	Scalar sor_sweep(const vector<Scalar>& b, vector<Scalar>& x, const Scalar& w) const {
+		using std::abs;
+		Scalar one(1);
+		std::vector<Scalar> change(lines(), Scalar(0));
+		for (unsigned color = 0; color < 2; ++color) {
+			for_each_line([&](const line& L, Scalar&) {
+				Scalar& c = change[L.index];
+				for (size_t j = (L.parity + color) & 1; j < L.length; j += 2) {
+					size_t p = L.base + j;
+					Scalar update = (one - w) * x[p] + w * (b[p] - _neighbor * neighbors(x, L, j)) / _center;
+					c += abs(update - x[p]);
+					x[p] = update;
+				}
+			});
+		}
+		Scalar sum(0);
+		for (const auto& c : change) sum += c;
+		return sum;
+	}
+
+private:
+	extents_type _extents;
+	extents_type _strides;
+	Scalar       _center;
+	Scalar       _neighbor;
+
+	// a line of the grid along the last dimension, and which of its neighbor lines are inside the grid
+	struct line {
+		size_t index;
+		size_t base;
+		size_t length;
+		unsigned parity;        // parity of the sum of the coordinates of the first point of the line
+		bool lower[Dim], upper[Dim];
+	};
+
+	size_t lines() const { return (_extents[Dim - 1] == 0 ? 0 : size() / _extents[Dim - 1]); }
+
+	line make_line(size_t l) const {
+		line L{};
+		L.index = l;
+		L.length = _extents[Dim - 1];
+		L.base = l * L.length;
+		size_t r = l, coordinateSum = 0;
+		for (size_t e = 1; e < Dim; ++e) {
+			size_t d = Dim - 1 - e;
+			size_t coordinate = r % _extents[d];
+			r /= _extents[d];
+			coordinateSum += coordinate;
+			L.lower[d] = coordinate > 0;
+			L.upper[d] = coordinate + 1 < _extents[d];
+		}
+		L.parity = unsigned(coordinateSum & 1);
+		return L;
+	}
+
+	Scalar neighbors(const vector<Scalar>& x, const line& L, size_t j) const {
+		size_t p = L.base + j;
+		Scalar s(0);
+		if (j > 0) s += x[p - 1];
+		if (j + 1 < L.length) s += x[p + 1];
+		for (size_t d = 0; d + 1 < Dim; ++d) {
+			if (L.lower[d]) s += x[p - _strides[d]];
+			if (L.upper[d]) s += x[p + _strides[d]];
+		}
+		return s;
+	}
+
+	// run f(line, change) over all lines in blocks across the hardware threads, and sum the per-line changes in line order
+	template<typename Function>
+	Scalar for_each_line(Function&& f) const {
+		size_t N = lines();
+		if (N == 0) return Scalar(0);
+		std::vector<Scalar> change(N, Scalar(0));
+		size_t grain = std::max<size_t>(1, STENCIL_BLOCK_SIZE / std::max<size_t>(1, _extents[Dim - 1]));
+		parallel_for(N, grain, [&](size_t begin, size_t end) {
+			for (size_t l = begin; l < end; ++l) f(make_line(l), change[l]);
+		});
+		Scalar sum(0);
+		for (const auto& c : change) sum += c;
+		return sum;
+	}
+};
+
+template<typename Matrix>
+struct is_stencil_trait : std::false_type {};
+template<typename Scalar, unsigned Dim>
+struct is_stencil_trait< stencil<Scalar, Dim> > : std::true_type {};
+template<typename Matrix>
+constexpr bool is_stencil = is_stencil_trait<Matrix>::value;
+
+template<typename Scalar, unsigned Dim>
+inline size_t num_rows(const stencil<Scalar, Dim>& A) { return A.rows(); }
+template<typename Scalar, unsigned Dim>
+inline size_t num_cols(const stencil<Scalar, Dim>& A) { return A.cols(); }
+
+// matrix-free matrix-vector product
+template<typename Scalar, unsigned Dim>
+vector<Scalar> operator*(const stencil<Scalar, Dim>& A, const vector<Scalar>& x) {
+	vector<Scalar> y(A.size());
+	A.apply(x, y);
+	return y;
+}
+
+// the Jacobi preconditioner D^-1 of a stencil, as a stencil without neighbor coupling
+template<typename Scalar, unsigned Dim>
+stencil<Scalar, Dim> jacobi_preconditioner(const stencil<Scalar, Dim>& A) {
+	return stencil<Scalar, Dim>(A.extents(), Scalar(1) / A.center(), Scalar(0));
+}
+
+}}} // namespace sw::universal::blas
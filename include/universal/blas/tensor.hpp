@@ -1,14 +1,18 @@
 #pragma once
-// tensor.hpp: super-simple dense tensor class implementation
+// tensor.hpp: dense N-dimensional tensor with zero-copy strided views
 //
 // Copyright (C) 2017 Stillwater Supercomputing, Inc.
 // SPDX-License-Identifier: MIT
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <array>
 #include <iostream>
+#include <iomanip>
 #include <vector>
 #include <initializer_list>
-#include <map>
+#include <sstream>
+#include <string>
+#include <type_traits>
 #include <universal/blas/exceptions.hpp>
 
 #if defined(__clang__)
@@ -51,405 +55,423 @@
 #define _NODISCARD
 #endif // _HAS_NODISCARD
 
-namespace sw { namespace universal { namespace blas { 
+/*
+    A tensor<Scalar, Rank> owns a contiguous, row-major block of Rank-dimensional data.
+    A tensor_view<Scalar, Rank> is a pointer plus a shape and a stride per dimension: it
+    does not own the elements, and permute, transpose, slice, at, and reshape return new
+    views of the same elements without copying them. A view of const Scalar is read-only.
+    Views are invalidated when the tensor they refer to is resized or destroyed.
 
-template<typename Scalar>
+    Contractions of tensors and views are in contraction.hpp.
+*/
+
+namespace sw { namespace universal { namespace blas {
+
+template<typename Scalar, unsigned Rank> class tensor_view;
+
+// number of elements of a shape: the empty shape of a rank 0 tensor holds one element
+template<size_t Rank>
+size_t elements(const std::array<size_t, Rank>& shape) {
+	size_t n = 1;
+	for (size_t d = 0; d < Rank; ++d) n *= shape[d];
+	return n;
+}
+
+// strides of a contiguous row-major layout: the last index is the fastest moving
+template<size_t Rank>
+std::array<size_t, Rank> row_major_strides(const std::array<size_t, Rank>& shape) {
+	std::array<size_t, Rank> strides{};
+	size_t stride = 1;
+	for (size_t e = 0; e < Rank; ++e) {
+		size_t d = Rank - 1 - e;
+		strides[d] = stride;
+		stride *= shape[d];
+	}
+	return strides;
+}
+
+template<size_t Rank>
+std::string to_string(const std::array<size_t, Rank>& shape) {
+	std::stringstream ss;
+	ss << '[';
+	for (size_t d = 0; d < Rank; ++d) ss << (d > 0 ? " x " : " ") << shape[d];
+	ss << " ]";
+	return ss.str();
+}
+
+template<typename Scalar, unsigned Rank>
+class tensor_view {
+public:
+	typedef std::remove_const_t<Scalar>              value_type;
+	typedef Scalar&                                  reference;
+	typedef Scalar*                                  pointer_type;
+	typedef size_t                                   size_type;
+	typedef std::array<size_t, Rank>                 shape_type;
+	static constexpr unsigned rank = Rank;
+
+	tensor_view() : _data{ nullptr }, _shape{}, _strides{} {}
+	tensor_view(Scalar* data, const shape_type& shape, const shape_type& strides) : _data{ data }, _shape{ shape }, _strides{ strides } {}
+	// a view of mutable elements is also a view of const elements
+	template<typename Source, typename = std::enable_if_t<std::is_same_v<const Source, Scalar>>>
+	tensor_view(const tensor_view<Source, Rank>& v) : _data{ v.data() }, _shape{ v.shape() }, _strides{ v.strides() } {}
+
+	// element access: a view is a reference, so a const view still refers to mutable elements
+	template<typename... Indices>
+	Scalar& operator()(Indices... indices) const {
+		static_assert(sizeof...(Indices) == Rank, "number of indices must equal the rank of the tensor view");
+		size_t index[] = { size_t(indices)..., 0 };
+		size_t offset = 0;
+		for (size_t d = 0; d < Rank; ++d) offset += index[d] * _strides[d];
+		return _data[offset];
+	}
+	Scalar& operator[](const shape_type& index) const {
+		size_t offset = 0;
+		for (size_t d = 0; d < Rank; ++d) offset += index[d] * _strides[d];
+		return _data[offset];
+	}
+
+	// selectors
+	Scalar* data() const noexcept { return _data; }
+	const shape_type& shape() const noexcept { return _shape; }
+	const shape_type& strides() const noexcept { return _strides; }
+	size_t extent(unsigned d) const { return _shape[d]; }
+	size_t stride(unsigned d) const { return _strides[d]; }
+	size_t size() const noexcept { return elements(_shape); }
+	bool empty() const noexcept { return size() == 0; }
+	// true when the elements are laid out row-major without gaps, so that reshape is a relabeling
+	bool is_contiguous() const noexcept {
+		size_t stride = 1;
+		for (size_t e = 0; e < Rank; ++e) {
+			size_t d = Rank - 1 - e;
+			if (_shape[d] != 1 && _strides[d] != stride) return false;
+			stride *= _shape[d];
+		}
+		return true;
+	}
+
+	// view with dimension d of the result being dimension axes[d] of this view
+	tensor_view permute(const std::array<unsigned, Rank>& axes) const {
+		std::array<bool, Rank> used{};
+		shape_type shape{}, strides{};
+		for (size_t d = 0; d < Rank; ++d) {
+			if (axes[d] >= Rank || used[axes[d]]) throw tensor_incompatible_shapes("permute requires a permutation of the dimensions");
+			used[axes[d]] = true;
+			shape[d] = _shape[axes[d]];
+			strides[d] = _strides[axes[d]];
+		}
+		return tensor_view(_data, shape, strides);
+	}
+	// view with the order of the dimensions reversed: the matrix transpose for Rank 2
+	tensor_view transpose() const {
+		std::array<unsigned, Rank> axes{};
+		for (unsigned d = 0; d < Rank; ++d) axes[d] = Rank - 1 - d;
+		return permute(axes);
+	}
+	// view of the index range [begin, end) of dimension d
+	tensor_view slice(unsigned d, size_t begin, size_t end) const {
+		if (d >= Rank || begin > end || end > _shape[d]) throw tensor_incompatible_shapes("slice [" + std::to_string(begin) + ", " + std::to_string(end) + ") is out of range of " + to_string(_shape));
+		shape_type shape(_shape);
+		shape[d] = end - begin;
+		return tensor_view(_data + begin * _strides[d], shape, _strides);
+	}
+	// view of rank Rank-1 with index i of dimension d held fixed
+	template<unsigned R = Rank>
+	tensor_view<Scalar, R - 1> at(unsigned d, size_t i) const {
+		static_assert(R > 0, "cannot fix an index of a rank 0 tensor view");
+		if (d >= Rank || i >= _shape[d]) throw tensor_incompatible_shapes("index " + std::to_string(i) + " is out of range of " + to_string(_shape));
+		std::array<size_t, R - 1> shape{}, strides{};
+		for (size_t s = 0, t = 0; s < Rank; ++s) {
+			if (s == d) continue;
+			shape[t] = _shape[s];
+			strides[t] = _strides[s];
+			++t;
+		}
+		return tensor_view<Scalar, R - 1>(_data + i * _strides[d], shape, strides);
+	}
+	// view of the same elements with a different shape; the view must be contiguous
+	template<size_t NewRank>
+	tensor_view<Scalar, unsigned(NewRank)> reshape(const std::array<size_t, NewRank>& shape) const {
+		if (elements(shape) != size()) throw tensor_incompatible_shapes("cannot reshape " + to_string(_shape) + " to " + to_string(shape));
+		if (!is_contiguous()) throw tensor_incompatible_shapes("reshape of a strided view requires a copy: construct a tensor from the view first");
+		return tensor_view<Scalar, unsigned(NewRank)>(_data, shape, row_major_strides(shape));
+	}
+
+	// modifiers: assign to the elements the view refers to
+	void setzero() const { fill(value_type(0)); }
+	void fill(const value_type& v) const {
+		static_assert(!std::is_const_v<Scalar>, "cannot assign through a view of const elements");
+		for_each([&v](Scalar& e) { e = v; });
+	}
+	// copy the elements of a view of the same shape into this view
+	template<typename Source>
+	void assign(const tensor_view<Source, Rank>& src) const {
+		static_assert(!std::is_const_v<Scalar>, "cannot assign through a view of const elements");
+		if (src.shape() != _shape) throw tensor_incompatible_shapes("cannot assign " + to_string(src.shape()) + " to " + to_string(_shape));
+		shape_type index{};
+		for (size_t e = 0; e < size(); ++e) {
+			(*this)[index] = value_type(src[index]);
+			next(index);
+		}
+	}
+
+	// visit every element in row-major order of the view
+	template<typename Function>
+	void for_each(Function&& f) const {
+		if (empty()) return;
+		shape_type index{};
+		for (size_t e = 0; e < size(); ++e) {
+			f((*this)[index]);
+			next(index);
+		}
+	}
+
+	// advance a multi-index in row-major order
+	void next(shape_type& index) const {
+		for (size_t e = 0; e < Rank; ++e) {
+			size_t d = Rank - 1 - e;
+			if (++index[d] < _shape[d]) return;
+			index[d] = 0;
+		}
+	}
+
+private:
+	Scalar*    _data;
+	shape_type _shape;
+	shape_type _strides;
+};
+
+template<typename Scalar, unsigned Rank = 2>
 class tensor {
 public:
-	typedef Scalar									value_type;
-	typedef const value_type&						const_reference;
-	typedef value_type&								reference;
-	typedef const value_type*						const_pointer_type;
-	typedef typename std::vector<Scalar>::size_type size_type;
-	typedef typename std::vector<Scalar>::iterator     iterator;
-	typedef typename std::vector<Scalar>::const_iterator const_iterator;
-	typedef typename std::vector<Scalar>::reverse_iterator reverse_iterator;
+	typedef Scalar                                               value_type;
+	typedef const value_type&                                    const_reference;
+	typedef value_type&                                          reference;
+	typedef const value_type*                                    const_pointer_type;
+	typedef typename std::vector<Scalar>::size_type              size_type;
+	typedef typename std::vector<Scalar>::iterator               iterator;
+	typedef typename std::vector<Scalar>::const_iterator         const_iterator;
+	typedef typename std::vector<Scalar>::reverse_iterator       reverse_iterator;
 	typedef typename std::vector<Scalar>::const_reverse_iterator const_reverse_iterator;
+	typedef std::array<size_t, Rank>                             shape_type;
 	static constexpr unsigned AggregationType = UNIVERSAL_AGGREGATE_TENSOR;
+	static constexpr unsigned rank = Rank;
 
-	tensor() : _m{ 0 }, _n{ 0 }, data(0) {}
-	tensor(unsigned m, unsigned n) : _m{ m }, _n{ n }, data(m*n, Scalar(0.0)) { }
+	tensor() : _shape{}, _strides{ row_major_strides(_shape) }, _data(elements(_shape), Scalar(0)) {}
+	explicit tensor(const shape_type& shape) : _shape{ shape }, _strides{ row_major_strides(shape) }, _data(elements(shape), Scalar(0)) {}
+	template<typename... Extents, typename = std::enable_if_t<sizeof...(Extents) == Rank && (Rank > 0) && (std::is_integral_v<Extents> && ...)>>
+	explicit tensor(Extents... extents) : tensor(shape_type{ size_t(extents)... }) {}
+	// rank 2 tensor from a list of rows
 	tensor(std::initializer_list< std::initializer_list<Scalar> > values) {
-		unsigned nrows = values.size();
-		unsigned ncols = values.begin()->size();
-		data.resize(nrows * ncols);
-		unsigned r = 0;
+		static_assert(Rank == 2, "a list of rows initializes a rank 2 tensor");
+		size_t nrows = values.size();
+		size_t ncols = (nrows > 0 ? values.begin()->size() : 0);
+		_shape = shape_type{ nrows, ncols };
+		_strides = row_major_strides(_shape);
+		_data.resize(nrows * ncols);
+		size_t r = 0;
 		for (auto l : values) {
 			if (l.size() == ncols) {
-				unsigned c = 0;
+				size_t c = 0;
 				for (auto v : l) {
-					data[r*ncols + c] = v;
+					_data[r * ncols + c] = v;
 					++c;
 				}
 				++r;
 			}
 		}
-		_m = nrows;
-		_n = ncols;
 	}
-	tensor(const tensor& A) : _m{ A._m }, _n{ A._n }, data(A.data) {}
+	tensor(const tensor& A) = default;
+	tensor(tensor&& A) = default;
 
 	// Converting Constructor (SourceType A --> Scalar B)
 	template<typename SourceType>
-	tensor(const tensor<SourceType>& A) : _m{ A.rows() }, _n{A.cols() }{
-		data.resize(_m*_n);
-		for (unsigned i = 0; i < _m; ++i){
-			for (unsigned j = 0; j < _n; ++j){
-				data[i*_n + j] = Scalar(A(i,j));
-			}
-		}
+	tensor(const tensor<SourceType, Rank>& A) : _shape{ A.shape() }, _strides{ row_major_strides(_shape) } {
+		_data.reserve(A.size());
+		for (const auto& e : A) _data.push_back(Scalar(e));
 	}
-
-
-	/* Operators
-	/ 	Binary and unitary operators, =,>,!=,...
-	*/
-	tensor& operator=(const tensor& M) = default;
-	tensor& operator=(tensor&& M) = default;
-
-	// Identity tensor operator
-	tensor& operator=(const Scalar& one) {
-		setzero();
-		unsigned smallestDimension = (_m < _n ? _m : _n);
-		for (unsigned i = 0; i < smallestDimension; ++i) data[i*_n + i] = one;
-		return *this;
+	// materialize the elements of a view into a contiguous tensor
+	template<typename ViewScalar>
+	explicit tensor(const tensor_view<ViewScalar, Rank>& v) : _shape{ v.shape() }, _strides{ row_major_strides(_shape) } {
+		_data.reserve(v.size());
+		v.for_each([this](const ViewScalar& e) { _data.push_back(Scalar(e)); });
 	}
 
-	Scalar operator()(unsigned i, unsigned j) const { return data[i*_n + j]; }
-	Scalar& operator()(unsigned i, unsigned j) { return data[i*_n + j]; }
-	RowProxy<Scalar> operator[](unsigned i) {
-		typename std::vector<Scalar>::iterator it = data.begin() + int64_t(i) * int64_t(_n);
-		RowProxy<Scalar> proxy(it);
-		return proxy;
+	tensor& operator=(const tensor& T) = default;
+	tensor& operator=(tensor&& T) = default;
+
+	template<typename... Indices>
+	Scalar operator()(Indices... indices) const {
+		static_assert(sizeof...(Indices) == Rank, "number of indices must equal the rank of the tensor");
+		return _data[offset(indices...)];
 	}
-	ConstRowProxy<Scalar> operator[](unsigned i) const {
-		typename std::vector<Scalar>::const_iterator it = data.begin() + static_cast<int64_t>(i * _n);
-		ConstRowProxy<Scalar> proxy(it);
-		return proxy;
+	template<typename... Indices>
+	Scalar& operator()(Indices... indices) {
+		static_assert(sizeof...(Indices) == Rank, "number of indices must equal the rank of the tensor");
+		return _data[offset(indices...)];
 	}
+	Scalar operator[](const shape_type& index) const { return view()[index]; }
+	Scalar& operator[](const shape_type& index) { return view()[index]; }
 
 	// tensor element-wise sum
 	tensor& operator+=(const tensor& rhs) {
-		// check if the matrices are compatible
-		if (_m != rhs._m || _n != rhs._n) {
-			std::cerr << "Element-wise tensor sum received incompatible matrices ("
-				<< _m << ", " << _n << ") += (" << rhs._m << ", " << rhs._n << ")\n";
+		if (_shape != rhs._shape) {
+			std::cerr << "Element-wise tensor sum received incompatible tensors " << to_string(_shape) << " += " << to_string(rhs._shape) << '\n';
 			return *this; // return without changing
 		}
-		for (size_type e = 0; e < _m * _n; ++e) {
-			data[e] += rhs.data[e];
-		}
+		for (size_type e = 0; e < _data.size(); ++e) _data[e] += rhs._data[e];
 		return *this;
 	}
 	// tensor element-wise difference
 	tensor& operator-=(const tensor& rhs) {
-		// check if the matrices are compatible
-		if (_m != rhs._m || _n != rhs._n) {
-			std::cerr << "Element-wise tensor difference received incompatible matrices ("
-				<< _m << ", " << _n << ") -= (" << rhs._m << ", " << rhs._n << ")\n";
+		if (_shape != rhs._shape) {
+			std::cerr << "Element-wise tensor difference received incompatible tensors " << to_string(_shape) << " -= " << to_string(rhs._shape) << '\n';
 			return *this; // return without changing
 		}
-		for (size_type e = 0; e < _m*_n; ++e) {
-			data[e] -= rhs.data[e];
-		}
+		for (size_type e = 0; e < _data.size(); ++e) _data[e] -= rhs._data[e];
 		return *this;
 	}
-
 	// multiply all tensor elements
 	tensor& operator*=(const Scalar& a) {
-		using size_type = typename tensor<Scalar>::size_type;
-		for (size_type e = 0; e < _m*_n; ++e) {
-			data[e] *= a;
-		}
+		for (auto& e : _data) e *= a;
 		return *this;
 	}
 	// divide all tensor elements
 	tensor& operator/=(const Scalar& a) {
-		using size_type = typename tensor<Scalar>::size_type;
-		for (size_type e = 0; e < _m * _n; ++e) {
-			data[e] /= a;
-		}
+		for (auto& e : _data) e /= a;
 		return *this;
 	}
 
 	// modifiers
-	inline void setzero() { for (auto& elem : data) elem = Scalar(0); }
-	inline void resize(unsigned m, unsigned n) { _m = m; _n = n; data.resize(m * n); }
+	inline void setzero() { for (auto& e : _data) e = Scalar(0); }
+	inline void resize(const shape_type& shape) { _shape = shape; _strides = row_major_strides(shape); _data.resize(elements(shape)); }
 	// selectors
-	inline unsigned rows() const { return _m; }
-	inline unsigned cols() const { return _n; }
-	inline std::pair<unsigned, unsigned> size() const { return std::make_pair(_m, _n); }
-
-	// in-place transpose
-	tensor& transpose() {
-		unsigned size = _m * _n - 1;
-		std::map<unsigned, bool> b; // mark visits
-		b[0] = true; // A(0,0) is stationary
-		b[size] = true; // A(m-1,n-1) is stationary
-		unsigned index = 1;
-		while (index < size) {
-			unsigned cycleStart = index; // holds start of cycle
-			Scalar e = data[index]; // holds value of the element to be swapped
-			do {
-				unsigned next = (index * _m) % size; // index of e
-				std::swap(data[next], e);
-				b[index] = true;
-				index = next;
-			} while (index != cycleStart);
-			// get the starting point of the next cycle
-			for (index = 1; index < size && b[index]; ++index) {}
-		}
-		std::swap(_m, _n);
-		return *this;
-	}
-
-	// Eigen operators I need to reverse engineer
-	tensor Zero(unsigned m, unsigned n) {
-		tensor z(m, n);
-		return z;
-	}
-
-	// iterators
-	_NODISCARD iterator begin() noexcept {
-		return data.begin();
-	}
-
-	_NODISCARD const_iterator begin() const noexcept {
-		return data.begin();
-	}
-
-	_NODISCARD iterator end() noexcept {
-		return data.end();
-	}
-
-	_NODISCARD const_iterator end() const noexcept {
-		return data.end();
-	}
-
-	_NODISCARD reverse_iterator rbegin() noexcept {
-		return reverse_iterator(end());
-	}
-
-	_NODISCARD const_reverse_iterator rbegin() const noexcept {
-		return const_reverse_iterator(end());
-	}
-
-	_NODISCARD reverse_iterator rend() noexcept {
-		return reverse_iterator(begin());
-	}
-
-	_NODISCARD const_reverse_iterator rend() const noexcept {
-		return const_reverse_iterator(begin());
-	}
+	inline const shape_type& shape() const noexcept { return _shape; }
+	inline const shape_type& strides() const noexcept { return _strides; }
+	inline size_t extent(unsigned d) const { return _shape[d]; }
+	inline size_t size() const noexcept { return _data.size(); }
+	inline bool empty() const noexcept { return _data.empty(); }
+	inline Scalar* data() noexcept { return _data.data(); }
+	inline const Scalar* data() const noexcept { return _data.data(); }
+
+	// zero-copy views of the elements
+	tensor_view<Scalar, Rank> view() { return tensor_view<Scalar, Rank>(_data.data(), _shape, _strides); }
+	tensor_view<const Scalar, Rank> view() const { return tensor_view<const Scalar, Rank>(_data.data(), _shape, _strides); }
+	auto permute(const std::array<unsigned, Rank>& axes) { return view().permute(axes); }
+	auto permute(const std::array<unsigned, Rank>& axes) const { return view().permute(axes); }
+	auto transpose() { return view().transpose(); }
+	auto transpose() const { return view().transpose(); }
+	auto slice(unsigned d, size_t begin, size_t end) { return view().slice(d, begin, end); }
+	auto slice(unsigned d, size_t begin, size_t end) const { return view().slice(d, begin, end); }
+	auto at(unsigned d, size_t i) { return view().at(d, i); }
+	auto at(unsigned d, size_t i) const { return view().at(d, i); }
+	template<size_t NewRank>
+	auto reshape(const std::array<size_t, NewRank>& shape) { return view().reshape(shape); }
+	template<size_t NewRank>
+	auto reshape(const std::array<size_t, NewRank>& shape) const { return view().reshape(shape); }
+
+	// iterators over the elements in row-major order
+	_NODISCARD iterator begin() noexcept { return _data.begin(); }
+	_NODISCARD const_iterator begin() const noexcept { return _data.begin(); }
+	_NODISCARD iterator end() noexcept { return _data.end(); }
+	_NODISCARD const_iterator end() const noexcept { return _data.end(); }
+	_NODISCARD reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+	_NODISCARD const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+	_NODISCARD reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+	_NODISCARD const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
 
 private:
-	unsigned _m, _n; // m rows and n columns
-	std::vector<Scalar> data;
-
+	shape_type _shape;    // extent of each dimension
+	shape_type _strides;  // row-major strides of _shape
+	std::vector<Scalar> _data;
+
+	template<typename... Indices>
+	size_t offset(Indices... indices) const {
+		size_t index[] = { size_t(indices)..., 0 };
+		size_t offset = 0;
+		for (size_t d = 0; d < Rank; ++d) offset += index[d] * _strides[d];
+		return offset;
+	}
 };
 
-template<typename Scalar>
-inline unsigned num_rows(const tensor<Scalar>& A) { return A.rows(); }
-template<typename Scalar>
-inline unsigned num_cols(const tensor<Scalar>& A) { return A.cols(); }
-template<typename Scalar>
-inline std::pair<unsigned, unsigned> size(const tensor<Scalar>& A) { return A.size(); }
+template<typename Scalar, unsigned Rank>
+inline const std::array<size_t, Rank>& size(const tensor<Scalar, Rank>& A) { return A.shape(); }
 
-// ostream operator: no need to declare as friend as it only uses public interfaces
-template<typename Scalar>
-std::ostream& operator<<(std::ostream& ostr, const tensor<Scalar>& A) {
+// ostream operator: the last dimension is printed as a row, and the rows of higher dimensions are separated by a blank line
+template<typename Scalar, unsigned Rank>
+std::ostream& operator<<(std::ostream& ostr, const tensor_view<Scalar, Rank>& A) {
 	auto width = ostr.width();
-	unsigned m = A.rows();
-	unsigned n = A.cols();
-	for (unsigned i = 0; i < m; ++i) {
-		for (unsigned j = 0; j < n; ++j) {
-			ostr << std::setw(width) << A(i, j) << " ";
+	if (A.empty()) return ostr;
+	std::array<size_t, Rank> index{};
+	for (size_t e = 0; e < A.size(); ++e) {
+		ostr << std::setw(width) << A[index];
+		if constexpr (Rank == 0) {
+			ostr << '\n';
+		}
+		else {
+			A.next(index);
+			if (index[Rank - 1] != 0) { ostr << ' '; continue; }
+			ostr << '\n';
+			if (Rank > 1 && index[Rank - 2] == 0 && e + 1 < A.size()) ostr << '\n';
 		}
-		ostr << '\n';
 	}
 	return ostr;
 }
 
+template<typename Scalar, unsigned Rank>
+std::ostream& operator<<(std::ostream& ostr, const tensor<Scalar, Rank>& A) {
+	return ostr << A.view();
+}
+
 // tensor element-wise sum
-template<typename Scalar>
-tensor<Scalar> operator+(const tensor<Scalar>& A, const tensor<Scalar>& B) {
-	tensor<Scalar> Sum(A);
+template<typename Scalar, unsigned Rank>
+tensor<Scalar, Rank> operator+(const tensor<Scalar, Rank>& A, const tensor<Scalar, Rank>& B) {
+	tensor<Scalar, Rank> Sum(A);
 	return Sum += B;
 }
 
 // tensor element-wise difference
-template<typename Scalar>
-tensor<Scalar> operator-(const tensor<Scalar>& A, const tensor<Scalar>& B) {
-	tensor<Scalar> Diff(A);
+template<typename Scalar, unsigned Rank>
+tensor<Scalar, Rank> operator-(const tensor<Scalar, Rank>& A, const tensor<Scalar, Rank>& B) {
+	tensor<Scalar, Rank> Diff(A);
 	return Diff -= B;
 }
 
 // tensor scaling through Scalar multiply
-template<typename Scalar>
-tensor<Scalar> operator*(const Scalar& a, const tensor<Scalar>& B) {
-	tensor<Scalar> A(B);
+template<typename Scalar, unsigned Rank>
+tensor<Scalar, Rank> operator*(const Scalar& a, const tensor<Scalar, Rank>& B) {
+	tensor<Scalar, Rank> A(B);
 	return A *= a;
 }
 
 // tensor scaling through Scalar divide
-template<typename Scalar>
-tensor<Scalar> operator/(const tensor<Scalar>& A, const Scalar& b) {
-	tensor<Scalar> B(A);
+template<typename Scalar, unsigned Rank>
+tensor<Scalar, Rank> operator/(const tensor<Scalar, Rank>& A, const Scalar& b) {
+	tensor<Scalar, Rank> B(A);
 	return B /= b;
 }
 
- 
-// tensor-vector multiply
-template<typename Scalar>
-vector<Scalar> operator*(const tensor<Scalar>& A, const vector<Scalar>& x) {
-	vector<Scalar> b(A.rows());
-	for (unsigned i = 0; i < A.rows(); ++i) {
-		b[i] = Scalar(0);
-		for (unsigned j = 0; j < A.cols(); ++j) {
-			b[i] += A(i, j) * x[j];
-		}
-	}
-	return b;
-}
-
-template<typename Scalar>
-tensor<Scalar> operator*(const tensor<Scalar>& A, const tensor<Scalar>& B) {
-	if (A.cols() != B.rows()) throw matmul_incompatible_matrices(incompatible_matrices(A.rows(), A.cols(), B.rows(), B.cols(), "*").what());
-	unsigned rows = A.rows();
-	unsigned cols = B.cols();
-	unsigned dots = A.cols();
-	tensor<Scalar> C(rows, cols);
-	for (unsigned i = 0; i < rows; ++i) {
-		for (unsigned j = 0; j < cols; ++j) {
-			Scalar e = Scalar(0);
-			for (unsigned k = 0; k < dots; ++k) {
-				e += A(i, k) * B(k, j);
-			}
-			C(i, j) = e;
-		}
-	}
-	return C;
-}
-
-
-
-
-template<typename Scalar>
-tensor<Scalar> operator%(const tensor<Scalar>& A, const tensor<Scalar>& B) {
-	// Hadamard Product A.*B.  Element-wise multiplication.
-	if (A.size() != B.size()) throw matmul_incompatible_matrices(incompatible_matrices(A.rows(), A.cols(), B.rows(), B.cols(), "%").what());
-	unsigned rows = A.rows();
-	unsigned cols = A.cols();
-	 
-	tensor<Scalar> C(rows, cols);
-	for (unsigned i = 0; i < rows; ++i) {
-		for (unsigned j = 0; j < cols; ++j) {
-			C(i, j) = A(i, j) * B(i, j);
-		}
-	}
+// Hadamard product: element-wise multiplication
+template<typename Scalar, unsigned Rank>
+tensor<Scalar, Rank> operator%(const tensor<Scalar, Rank>& A, const tensor<Scalar, Rank>& B) {
+	if (A.shape() != B.shape()) throw tensor_incompatible_shapes(to_string(A.shape()) + " and " + to_string(B.shape()) + " incompatible for operator '%'");
+	tensor<Scalar, Rank> C(A);
+	auto b = B.begin();
+	for (auto& e : C) e *= *b++;
 	return C;
 }
 
-
 // tensor equivalence tests
-template<typename Scalar>
-bool operator==(const tensor<Scalar>& A, const tensor<Scalar>& B) {
-	if (num_rows(A) != num_rows(B) ||
-		num_cols(A) != num_cols(B)) return false;
-	bool equal = true;
-	for (unsigned i = 0; i < num_rows(A); ++i) {
-		for (unsigned j = 0; j < num_cols(A); ++j) {
-			if (A(i, j) != B(i, j)) {
-				equal = false;
-				break;
-			}
-		}
-		if (!equal) break;
-	}
-	return equal;
+template<typename Scalar, unsigned Rank>
+bool operator==(const tensor<Scalar, Rank>& A, const tensor<Scalar, Rank>& B) {
+	if (A.shape() != B.shape()) return false;
+	auto b = B.begin();
+	for (const auto& e : A) if (e != *b++) return false;
+	return true;
 }
 
-
-
-template<typename Scalar>
-bool operator!=(const tensor<Scalar>& A, const tensor<Scalar>& B) {
+template<typename Scalar, unsigned Rank>
+bool operator!=(const tensor<Scalar, Rank>& A, const tensor<Scalar, Rank>& B) {
 	return !(A == B);
 }
 
-
-
-// Matrix > x ==> Matrix with 1/0 representing True/False
-template<typename Scalar>
-tensor<Scalar> operator>(const tensor<Scalar>& A, const Scalar& x) {
-	tensor<Scalar> B(A.cols(), A.rows());
-	
-	for (unsigned i = 0; i < num_rows(A); ++i) {
-		for (unsigned j = 0; j < num_cols(A); ++j) {
-			B(i,j) = (A(i, j) > x) ? 1 : 0;
-		}
-	}
-	return B;
-}
- 
-
-// maxelement (jq 2022-10-15)
-template<typename Scalar>
-Scalar maxelement(const tensor<Scalar>&A) {
-	auto x = abs(A(0,0));
-	for (size_t i = 0; i < num_rows(A); ++i) {
-		for (size_t j = 0; j < num_cols(A); ++j) {
-			x = (abs(A(i, j)) > x) ? abs(A(i, j)) : x;
-		}
-	}
-	return x;
-}
-
-// minelement (jq 2022-10-15)
-template<typename Scalar>
-Scalar minelement(const tensor<Scalar>&A) {
-	auto x = maxelement(A);
-	for (size_t i = 0; i < num_rows(A); ++i) {
-		for (size_t j = 0; j < num_cols(A); ++j) {
-			x = ((abs(A(i, j)) < x) && (A(i,j)!=0)) ? abs(A(i, j)) : x;
-		}
-	}
-	return x;
-}
-
-
-// Gets the ith row of tensor A
-template<typename Scalar>
-vector<Scalar> getRow(unsigned i, const tensor<Scalar>&A) {
-	vector<Scalar> x(num_cols(A));
-	for (size_t j = 0; j < num_cols(A); ++j) {
-		x(j) = A(i,j);
-		}
-	return x;
-}
-
-// Gets the jth column of tensor A
-template<typename Scalar>
-vector<Scalar> getCol(unsigned j, const tensor<Scalar>&A) {
-	vector<Scalar> x(num_rows(A));
-	for (size_t i = 0; i < num_rows(A); ++i) {
-		x(i) = A(i,j);
-		}
-	return x;
-}
-
-
-// Display Matrix
-template<typename Scalar>
-void disp(const tensor<Scalar>& A, const size_t COLWIDTH = 10){
-    for (size_t i = 0;i<num_rows(A);++i){
-        for (size_t j = 0; j<num_cols(A);++j){
-            // std::cout <<std::setw(COLWIDTH) << A(i,j) << std::setw(COLWIDTH) << "\t" << std::fixed;
-			std::cout << "\t" << A(i,j) << "\t"; // << std::fixed;
-        }
-        std::cout << "\n";
-    }
-    std::cout << "\n" << std::endl;
-}
-
-
 }}} // namespace sw::universal::blas
@@ -1,11 +1,11 @@
 /** **********************************************************************
- * Estimated Condition number of matrix 
+ * Estimated Condition number of matrix
  *
  * @author:     James Quinlan
  * @date:       2023-02-11
  * @copyright:  Copyright (c) 2022 Stillwater Supercomputing, Inc.
- * @license:    MIT Open Source license 
- * 
+ * @license:    MIT Open Source license
+ *
  * This file is part of the universal numbers project.
  * ***********************************************************************
  */
@@ -13,115 +13,187 @@
 #include <universal/blas/matrix.hpp>
 #include <universal/blas/vector.hpp>
 #include <universal/blas/blas.hpp>
-#include <universal/blas/solvers/lu.hpp>
-#include <universal/blas/solvers/backsub.hpp>
-#include <universal/blas/solvers/forwsub.hpp>
+#include <universal/blas/solvers/plu.hpp>
 #include <universal/blas/utes/matnorm.hpp>
-#include <tuple>
- 
-namespace sw { namespace universal { namespace blas {  
-template<typename Scalar>
-std::tuple<matrix<Scalar>, matrix<Scalar>> plu(const matrix<Scalar>& A){ 
 
-    using Matrix = sw::universal::blas::matrix<Scalar>;
-    using namespace std;
+/*
+    1-norm condition estimation in the style of LAPACK gecon
 
-    Scalar x;
-    size_t n = num_rows(A);
+    kappa_1(A) = ||A||_1 * ||A^{-1}||_1, where ||A^{-1}||_1 is estimated by Hager's method
+    with Higham's refinements (LAPACK lacn2): a few solves with A and A^T, using the
+    LU factorization PA = LU that plu computes in place, find a vector x that nearly
+    maximizes ||A^{-1} x||_1 / ||x||_1. Each solve is a pair of O(n^2) triangular
+    solves, and the estimate typically needs four to five of them. The solves work in
+    a condest_workspace, so repeated estimates of matrices of the same size do not
+    allocate.
+*/
 
-    Matrix L(n,n);
-    Matrix U(n,n);
+namespace sw { namespace universal { namespace blas {
 
-    L = 1;
-    U = A;
+template<typename Scalar>
+struct condest_workspace {
+    condest_workspace(size_t n = 0) : x(n), xi(n) {}
+    void resize(size_t n) { x.resize(n); xi.resize(n); }
+    vector<Scalar> x;    // the vector being solved in place
+    vector<Scalar> xi;   // the sign vector of the previous solution
+};
 
-    // Elimination Process
-    for (size_t i = 0; i < n-1; ++i){ // i-th row
-        Scalar absmax = abs(U(i,i)); 
-        size_t argmax = i;
+namespace condest_internal {
+
+    // x = A^{-1} x with PA = LU stored in place, P the sequence of row interchanges of plu
+    template<typename Scalar>
+    void solve(const matrix<Scalar>& LU, const vector<size_t>& P, vector<Scalar>& x) {
+        size_t n = num_rows(LU);
+        for (size_t i = 0; i < n; ++i) if (P(i) != i) std::swap(x(i), x(P(i)));
+        for (size_t i = 1; i < n; ++i) {
+            Scalar s = x(i);
+            for (size_t j = 0; j < i; ++j) s -= LU(i, j) * x(j);
+            x(i) = s;
+        }
+        for (size_t e = 0; e < n; ++e) {
+            size_t i = n - 1 - e;
+            Scalar s = x(i);
+            for (size_t j = i + 1; j < n; ++j) s -= LU(i, j) * x(j);
+            x(i) = s / LU(i, i);
+        }
+    }
 
-        // Select k >= i to maximize |U(k,i)| 
-        for (size_t k = i + 1; k < n; ++k){ // subsequent row (ele. in column k)
-            if (abs(U(k,i)) > absmax){
-                absmax = abs(U(k,i));
-                argmax = k;
-            }
+    // x = A^{-T} x: solve U^T w = x, L^T v = w, and undo the interchanges in reverse order
+    template<typename Scalar>
+    void solve_transpose(const matrix<Scalar>& LU, const vector<size_t>& P, vector<Scalar>& x) {
+        size_t n = num_rows(LU);
+        for (size_t i = 0; i < n; ++i) {
+            Scalar s = x(i);
+            for (size_t j = 0; j < i; ++j) s -= LU(j, i) * x(j);
+            x(i) = s / LU(i, i);
         }
-        // Check for necessary swaps
-        if (argmax != i){
-            // Swap rows loop
-            for (size_t j = i; j < n;++j){
-                x = U(i,j);
-                U(i,j) = U(argmax,j);
-                U(argmax,j) = x;
-            }
-           
-            // Permuate entries in L to match P
-            for (size_t j = 0; j < i; ++j){
-                x = L(i,j);
-                L(i,j) = L(argmax,j);
-                L(argmax,j) = x;
-            }
+        for (size_t e = 1; e < n; ++e) {
+            size_t i = n - 1 - e;
+            Scalar s = x(i);
+            for (size_t j = i + 1; j < n; ++j) s -= LU(j, i) * x(j);
+            x(i) = s;
         }
-        // Continue with row reduction
-        for (size_t k = i + 1; k < n; ++k){  // objective row
-                    L(k,i) = U(k,i) / U(i,i);
-            for (size_t j = i; j < n; ++j){
-                U(k,j) = U(k,j) - L(k,i)*U(i,j);
-            }
+        for (size_t e = 0; e < n; ++e) {
+            size_t i = n - 1 - e;
+            if (P(i) != i) std::swap(x(i), x(P(i)));
         }
     }
-    U = triu(U);
-    return std::make_tuple(L,U); 
-} // LU
-}}} // namespace sw::universal::blas
 
+    template<typename Scalar>
+    Scalar norm1(const vector<Scalar>& x) {
+        using std::abs;
+        Scalar s(0);
+        for (size_t i = 0; i < x.size(); ++i) s += abs(x(i));
+        return s;
+    }
+
+    template<typename Scalar>
+    size_t argmax_abs(const vector<Scalar>& x) {
+        using std::abs;
+        size_t j = 0;
+        Scalar m = abs(x(0));
+        for (size_t i = 1; i < x.size(); ++i) {
+            if (abs(x(i)) > m) { m = abs(x(i)); j = i; }
+        }
+        return j;
+    }
 
+} // namespace condest_internal
 
+// Hager-Higham estimate of ||A^{-1}||_1 from the in-place factorization PA = LU computed by plu
 template<typename Scalar>
-Scalar condest(const sw::universal::blas::matrix<Scalar> & A){
-/**
- * After changing from [P,L,U] = plu(A) to inplace version of plu,
- * condest has stopped working.  Need to fix, however, as long as
- * showCondest = false; LUIR.cpp will run.   
- */
+Scalar inverse_norm1_estimate(const matrix<Scalar>& LU, const vector<size_t>& P, condest_workspace<Scalar>& work) {
+    using namespace condest_internal;
+    using std::abs;
+    constexpr unsigned maxIterations = 5;
+    size_t n = num_rows(LU);
+    if (n == 0) return Scalar(0);
+    if (work.x.size() != n) work.resize(n);
+    vector<Scalar>& x = work.x;
+    vector<Scalar>& xi = work.xi;
 
-    Scalar Na  = matnorm(A,2);    // || A ||
-    Scalar Ni  = 1;               // || A^{-1} ||
-    sw::universal::blas::vector<Scalar> b(num_cols(A),1);
-    
-    auto [L, U] = plu(A);
-    auto Ut = U;
-    auto Lt = L;
-    auto z = forwsub(Ut.transpose(),b);
-    auto x = backsub(Lt.transpose(),z);
-    auto y = backsub(U,forwsub(L,x));
-
-    Scalar infNormY = 0;
-	for (size_t k = 0; k < num_cols(A); k++) infNormY = (abs(y(k))>infNormY) ? abs(y(k)) : infNormY;
-    Scalar infNormX = 0;
-	for (size_t k = 0; k < num_cols(A); k++) infNormX = (abs(x(k))>infNormX) ? abs(x(k)) : infNormX;
-    Ni = infNormY/infNormX;
-
-    return Ni*Na;
+    for (size_t i = 0; i < n; ++i) x(i) = Scalar(1) / Scalar(double(n));
+    solve(LU, P, x);
+    Scalar estimate = norm1(x);
+    if (n == 1) return estimate;
 
+    for (size_t i = 0; i < n; ++i) xi(i) = (x(i) >= Scalar(0) ? Scalar(1) : Scalar(-1));
+    x = xi;
+    solve_transpose(LU, P, x);
+    size_t j = argmax_abs(x);
+    for (unsigned iteration = 2; iteration <= maxIterations; ++iteration) {
+        // x = A^{-1} e_j
+        for (size_t i = 0; i < n; ++i) x(i) = Scalar(0);
+        x(j) = Scalar(1);
+        solve(LU, P, x);
+        Scalar previous = estimate;
+        estimate = norm1(x);
+        bool signsRepeat = true;
+        for (size_t i = 0; i < n; ++i) {
+            Scalar s = (x(i) >= Scalar(0) ? Scalar(1) : Scalar(-1));
+            if (s != xi(i)) signsRepeat = false;
+            xi(i) = s;
+        }
+        if (signsRepeat || estimate <= previous) {
+            estimate = (estimate > previous ? estimate : previous);
+            break;
+        }
+        x = xi;
+        solve_transpose(LU, P, x);
+        size_t jlast = j;
+        j = argmax_abs(x);
+        if (abs(x(jlast)) == abs(x(j))) break;
+    }
+
+    // Higham's alternating vector guards against the cases where the power iteration is misled
+    for (size_t i = 0; i < n; ++i) {
+        Scalar alternating = Scalar(1) + Scalar(double(i) / double(n - 1));
+        x(i) = (i % 2 ? -alternating : alternating);
+    }
+    solve(LU, P, x);
+    Scalar alternative = Scalar(2) * norm1(x) / Scalar(3.0 * double(n));
+    return (alternative > estimate ? alternative : estimate);
+}
+
+template<typename Scalar>
+Scalar inverse_norm1_estimate(const matrix<Scalar>& LU, const vector<size_t>& P) {
+    condest_workspace<Scalar> work(num_rows(LU));
+    return inverse_norm1_estimate(LU, P, work);
+}
+
+// estimate of kappa_1(A) = ||A||_1 ||A^{-1}||_1 given ||A||_1 and the in-place factorization PA = LU computed by plu
+template<typename Scalar>
+Scalar condest1(const matrix<Scalar>& LU, const vector<size_t>& P, const Scalar& anorm, condest_workspace<Scalar>& work) {
+    return anorm * inverse_norm1_estimate(LU, P, work);
+}
+
+template<typename Scalar>
+Scalar condest1(const matrix<Scalar>& LU, const vector<size_t>& P, const Scalar& anorm) {
+    return anorm * inverse_norm1_estimate(LU, P);
+}
+
+}}} // namespace sw::universal::blas
+
+// estimate of the 1-norm condition number of A, factoring a copy of A
+// use blas::condest1 to reuse an existing factorization
+template<typename Scalar>
+Scalar condest(const sw::universal::blas::matrix<Scalar> & A){
+    sw::universal::blas::matrix<Scalar> LU(A);
+    sw::universal::blas::vector<size_t> P(num_rows(A));
+    sw::universal::blas::plu(LU, P);
+    return sw::universal::blas::condest1(LU, P, matnorm(A, 1));
 } // end function
 
-// Reference 
-// Equations (4.3) and (4.4) p. 372 
+// References
 /**
-Cline, A. K., Moler, C. B., Stewart, G. W., & Wilkinson, J. H. (1979). 
-An estimate for the condition number of a matrix. SIAM Journal on 
-Numerical Analysis, 16(2), 368-375.
+Hager, W. W. (1984). Condition estimates. SIAM Journal on Scientific and
+Statistical Computing, 5(2), 311-316.
 
-@article{cline1979estimate,
-  title={An estimate for the condition number of a matrix},
-  author={Cline, Alan K and Moler, Cleve B and Stewart, George W and Wilkinson, James H},
-  journal={SIAM Journal on Numerical Analysis},
-  volume={16},
-  number={2},
-  pages={368--375},
-  year={1979},
-  publisher={SIAM}
-}
-*/
\ No newline at end of file
+Higham, N. J. (1988). FORTRAN codes for estimating the one-norm of a real or
+complex matrix, with applications to condition estimation (Algorithm 674).
+ACM Transactions on Mathematical Software, 14(4), 381-396.
+
+Cline, A. K., Moler, C. B., Stewart, G. W., & Wilkinson, J. H. (1979).
+An estimate for the condition number of a matrix. SIAM Journal on
+Numerical Analysis, 16(2), 368-375.
+*/
@@ -10,19 +10,21 @@
  */
 
 #pragma once
+#include <cmath>
 #include <universal/blas/blas.hpp>
 
 template<typename Scalar>
 Scalar matnorm(const sw::universal::blas::matrix<Scalar> & A, size_t p = 2){
     size_t m = num_rows(A);
     size_t n = num_cols(A);
-    
+    using std::abs;
+
     if (p == 1){
         // Col. max = 1-norm
         Scalar Cmax = 0;
         for (size_t j=0; j < n; ++j){
             Scalar N = 0;
-            for (size_t i = 0; i < n; ++i){
+            for (size_t i = 0; i < m; ++i){
                 Scalar element = abs(A(i,j));
                 N += element;
             }
@@ -11,6 +11,7 @@
 #include <vector>
 #include <initializer_list>
 #include <cmath>
+#include <universal/traits/fma_traits.hpp>
 
 #if defined(__clang__)
 /* Clang/LLVM. ---------------------------------------------- */
@@ -389,7 +390,7 @@ Scalar operator*(const vector<Scalar>& a, const vector<Scalar>& b) {
 	}
 	Scalar sum{ 0 };
 	for (size_t i = 0; i < N; ++i) {
-		sum += a(i) * b(i);
+		if constexpr (has_fma<Scalar>) sum = fma(a(i), b(i), sum); else sum += a(i) * b(i);
 //		std::cout << std::setw(15) << double(a(i)) << " * " << std::setw(15) << double(b(i)) << " cumulative sum: " << std::setw(15) << double(sum) << '\n';
 	}
 	return sum;
@@ -0,0 +1,334 @@
+#pragma once
+// engine.hpp: execution engine of the vectorized elementwise math library
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <exception>
+#include <limits>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <universal/blas/vector.hpp>
+#include <universal/blas/parallel.hpp>
+#include <universal/number/shared/specific_value_encoding.hpp>
+#include <universal/number/cfloat/cfloat_fwd.hpp>
+#include <universal/number/posit/posit_fwd.hpp>
+#include <universal/number/bfloat/bfloat16_fwd.hpp>
+#include <universal/traits/cfloat_traits.hpp>
+#include <universal/traits/posit_traits.hpp>
+#include <universal/traits/bfloat16_traits.hpp>
+
+// number systems of this many bits or fewer, without a native embedding, evaluate through an exhaustive lookup table
+#if !defined(VMATH_TABLE_NBITS)
+#define VMATH_TABLE_NBITS 16
+#endif
+// smallest number of elements a worker thread of the parallel fallback is given
+#if !defined(VMATH_PARALLEL_GRAIN)
+#define VMATH_PARALLEL_GRAIN 256
+#endif
+
+/*
+	The vmath engine selects an execution strategy per number system:
+	  - simd:     float, cfloats with the float encoding, and bfloat16 are converted in blocks to float and
+	              evaluated by branch-free polynomial kernels that the compiler vectorizes. The conversions of
+	              float and fp32 are exact, so the kernel is the only rounding event. bfloat16 has no scalar
+	              math library: its results are the float kernel rounded to bfloat16, within one bfloat16 ulp
+	              of the correctly rounded result
+	  - table:    posits and cfloats of VMATH_TABLE_NBITS bits or fewer look up an exhaustive table of the
+	              function, generated on first use with the scalar function of the number system. Narrower
+	              cfloats, such as half, take this path rather than the float kernel, because rounding the
+	              kernel result a second time would not reproduce the scalar function of the cfloat
+	  - parallel: all other number systems evaluate the scalar function of the number system, partitioned
+	              across the hardware threads
+*/
+
+namespace sw { namespace universal { namespace blas {
+
+enum class VmathFunction { exp, log, tanh, sigmoid, sqrt, rsqrt, sin, cos };
+enum class VmathKernel { simd, table, parallel };
+
+namespace vmath {
+
+	// a cfloat with the float encoding represents every float result of the kernels exactly
+	template<typename Scalar>
+	constexpr bool cfloat_is_float() {
+		if constexpr (is_cfloat<Scalar>) {
+			return (Scalar::nbits == 32u && Scalar::es == 8u && Scalar::hasSubnormals && !Scalar::hasSupernormals);
+		}
+		else {
+			return false;
+		}
+	}
+
+	template<typename Scalar>
+	constexpr VmathKernel select_kernel() {
+		if constexpr (std::is_same_v<Scalar, float> || is_bfloat16<Scalar> || cfloat_is_float<Scalar>()) {
+			return VmathKernel::simd;
+		}
+		else if constexpr (is_posit<Scalar> || is_cfloat<Scalar>) {
+			return (Scalar::nbits <= VMATH_TABLE_NBITS ? VmathKernel::table : VmathKernel::parallel);
+		}
+		else {
+			return VmathKernel::parallel;
+		}
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// scalar reference: the function as the number system defines it
+
+	template<VmathFunction f, typename Scalar>
+	Scalar evaluate(const Scalar& x) {
+		using std::exp; using std::log; using std::tanh; using std::sqrt; using std::sin; using std::cos;
+		using namespace sw::universal;
+		if constexpr (f == VmathFunction::exp)          return exp(x);
+		else if constexpr (f == VmathFunction::log)     return log(x);
+		else if constexpr (f == VmathFunction::tanh)    return tanh(x);
+		else if constexpr (f == VmathFunction::sigmoid) return Scalar(1) / (Scalar(1) + exp(-x));
+		else if constexpr (f == VmathFunction::sqrt)    return sqrt(x);
+		else if constexpr (f == VmathFunction::rsqrt)   return Scalar(1) / sqrt(x);
+		else if constexpr (f == VmathFunction::sin)     return sin(x);
+		else                                            return cos(x);
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// single precision polynomial kernels (Cephes coefficients)
+	// The kernels are branch-free: every candidate result is computed and the final value is picked with an
+	// integer mask, so that the compiler can if-convert and vectorize the loops without -fno-trapping-math.
+
+	inline float bit_cast_float(std::uint32_t u) { float f; std::memcpy(&f, &u, sizeof(f)); return f; }
+	inline std::uint32_t bit_cast_uint(float f) { std::uint32_t u; std::memcpy(&u, &f, sizeof(u)); return u; }
+	inline float select(bool condition, float a, float b) {
+		std::uint32_t mask = 0u - static_cast<std::uint32_t>(condition);
+		return bit_cast_float((bit_cast_uint(a) & mask) | (bit_cast_uint(b) & ~mask));
+	}
+	inline bool isnan_kernel(float x) { return (bit_cast_uint(x) & 0x7FFFFFFFu) > 0x7F800000u; }
+
+	inline float exp_kernel(float x) {
+		// clamp to the range where the result does not saturate to zero or infinity prematurely
+		float xc = std::min(std::max(x, -104.0f), 89.0f);
+		bool nan = isnan_kernel(x);
+		xc = select(nan, 0.0f, xc);
+		// round to nearest through the 1.5 * 2^23 shifter, which avoids the call to floor
+		float n = (xc * 1.44269504088896341f + 12582912.0f) - 12582912.0f;
+		float r = xc - n * 0.693359375f;
+		r = r + n * 2.12194440e-4f;
+		float p = 1.9875691500e-4f;
+		p = p * r + 1.3981999507e-3f;
+		p = p * r + 8.3334519073e-3f;
+		p = p * r + 4.1665795894e-2f;
+		p = p * r + 1.6666665459e-1f;
+		p = p * r + 5.0000001201e-1f;
+		float y = p * r * r + r + 1.0f;
+		// scale by 2^n in two steps, so that subnormal results and the overflow to infinity come out right
+		std::int32_t in = static_cast<std::int32_t>(n);
+		std::int32_t n1 = in / 2;
+		std::int32_t n2 = in - n1;
+		y *= bit_cast_float(static_cast<std::uint32_t>(n1 + 127) << 23);
+		y *= bit_cast_float(static_cast<std::uint32_t>(n2 + 127) << 23);
+		return select(nan, x, y);
+	}
+
+	inline float log_kernel(float x) {
+		// scale subnormals into the normal range
+		bool subnormal = (bit_cast_uint(x) < 0x00800000u);
+		float xs = select(subnormal, x * 8388608.0f, x);
+		std::uint32_t bits = bit_cast_uint(xs);
+		float e = static_cast<float>(static_cast<std::int32_t>((bits >> 23) & 0xFFu) - 126) - select(subnormal, 23.0f, 0.0f);
+		float m = bit_cast_float((bits & 0x007FFFFFu) | 0x3F000000u); // m in [0.5, 1)
+		bool low = (m < 0.707106781186547524f);
+		e = select(low, e - 1.0f, e);
+		m = select(low, m + m - 1.0f, m - 1.0f);
+		float z = m * m;
+		float y = 7.0376836292e-2f;
+		y = y * m - 1.1514610310e-1f;
+		y = y * m + 1.1676998740e-1f;
+		y = y * m - 1.2420140846e-1f;
+		y = y * m + 1.4249322787e-1f;
+		y = y * m - 1.6668057665e-1f;
+		y = y * m + 2.0000714765e-1f;
+		y = y * m - 2.4999993993e-1f;
+		y = y * m + 3.3333331174e-1f;
+		y = y * m * z;
+		y += -2.12194440e-4f * e;
+		y += -0.5f * z;
+		float result = m + y + 0.693359375f * e;
+		// special values
+		std::uint32_t ux = bit_cast_uint(x);
+		result = select((ux & 0x7FFFFFFFu) == 0u, -std::numeric_limits<float>::infinity(), result);
+		result = select(ux > 0x80000000u, std::numeric_limits<float>::quiet_NaN(), result);
+		result = select(ux >= 0x7F800000u && ux <= 0x7FFFFFFFu, x, result);
+		return result;
+	}
+
+	// sine (cosine = false) or cosine (cosine = true) for |x| <= 8192, larger arguments are patched up afterwards
+	inline float sincos_kernel(float x, bool cosine) {
+		float ax = std::fabs(x);
+		std::int32_t j = static_cast<std::int32_t>(select(ax <= 8192.0f, ax, 0.0f) * 1.27323954473516f);
+		j += (j & 1);
+		float y = static_cast<float>(j);
+		float r = ((ax - y * 0.78515625f) - y * 2.4187564849853515625e-4f) - y * 3.77489497744594108e-8f;
+		// octant bookkeeping: cos(x) = sin(x + pi/2)
+		std::int32_t octant = (j + (cosine ? 2 : 0)) & 7;
+		bool negate = (octant > 3);
+		octant &= 3;
+		bool usecos = (octant == 2);
+		float z = r * r;
+		float ps = ((-1.9515295891e-4f * z + 8.3321608736e-3f) * z - 1.6666654611e-1f) * z * r + r;
+		float pc = ((2.443315711809948e-5f * z - 1.388731625493765e-3f) * z + 4.166664568298827e-2f) * z * z - 0.5f * z + 1.0f;
+		float result = select(usecos, pc, ps);
+		bool sign = (cosine ? negate : (negate != (bit_cast_uint(x) >> 31 != 0)));
+		return select(sign, -result, result);
+	}
+
+	inline float tanh_kernel(float x) {
+		float ax = std::fabs(x);
+		float z = x * x;
+		float small = ((((-5.70498872745e-3f * z + 2.06390887954e-2f) * z - 5.37397155531e-2f) * z + 1.33314422036e-1f) * z - 3.33332819422e-1f) * z * x + x;
+		float large = 1.0f - 2.0f / (exp_kernel(ax + ax) + 1.0f);
+		large = select(x < 0.0f, -large, large);
+		return select((ax < 0.625f) | isnan_kernel(x), small, large);
+	}
+
+	// evaluated through e^-|x| so that neither tail overflows
+	inline float sigmoid_kernel(float x) {
+		float e = exp_kernel(-std::fabs(x));
+		float s = 1.0f / (1.0f + e);
+		return select(x < 0.0f, e * s, s);
+	}
+
+	template<VmathFunction f>
+	void simd_kernel(float* v, size_t n) {
+		if constexpr (f == VmathFunction::exp) {
+			for (size_t i = 0; i < n; ++i) v[i] = exp_kernel(v[i]);
+		}
+		if constexpr (f == VmathFunction::log) {
+			for (size_t i = 0; i < n; ++i) v[i] = log_kernel(v[i]);
+		}
+		if constexpr (f == VmathFunction::tanh) {
+			for (size_t i = 0; i < n; ++i) v[i] = tanh_kernel(v[i]);
+		}
+		if constexpr (f == VmathFunction::sigmoid) {
+			for (size_t i = 0; i < n; ++i) v[i] = sigmoid_kernel(v[i]);
+		}
+		if constexpr (f == VmathFunction::sqrt) {
+			for (size_t i = 0; i < n; ++i) v[i] = std::sqrt(v[i]);
+		}
+		if constexpr (f == VmathFunction::rsqrt) {
+			for (size_t i = 0; i < n; ++i) v[i] = 1.0f / std::sqrt(v[i]);
+		}
+		if constexpr (f == VmathFunction::sin || f == VmathFunction::cos) {
+			constexpr bool cosine = (f == VmathFunction::cos);
+			// the arguments of a chunk are saved, so that the lanes beyond the reduction are recomputed from their input
+			constexpr size_t chunkSize = 256;
+			float argument[chunkSize];
+			for (size_t c = 0; c < n; c += chunkSize) {
+				size_t m = std::min(chunkSize, n - c);
+				float* w = v + c;
+				std::uint32_t large{ 0 };
+				for (size_t i = 0; i < m; ++i) {
+					argument[i] = w[i];
+					bool reducible = (std::fabs(w[i]) <= 8192.0f);
+					large |= static_cast<std::uint32_t>(!reducible);
+					w[i] = select(reducible, sincos_kernel(w[i], cosine), w[i]);
+				}
+				if (large) {
+					// arguments beyond the Cody-Waite reduction, infinities and NaNs are rare: evaluate them in double precision
+					for (size_t i = 0; i < m; ++i) {
+						if (!(std::fabs(argument[i]) <= 8192.0f)) w[i] = static_cast<float>(cosine ? std::cos(double(argument[i])) : std::sin(double(argument[i])));
+					}
+				}
+			}
+		}
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// execution strategies
+
+	template<typename Scalar>
+	std::uint64_t encoding(const Scalar& x) {
+		if constexpr (is_posit<Scalar>) {
+			return x.bits();
+		}
+		else {
+			std::uint64_t bits{ 0 };
+			for (unsigned b = 0; b < Scalar::nrBlocks; ++b) {
+				bits |= static_cast<std::uint64_t>(x.block(b)) << (b * Scalar::bitsInBlock);
+			}
+			return bits;
+		}
+	}
+
+	// exhaustive table of the function over all encodings of the number system, generated on first use
+	// encodings for which the number system raises an arithmetic exception map to NaN/NaR, and the
+	// negative cfloat arguments of sqrt map to NaN without the diagnostic of the cfloat sqrt
+	template<VmathFunction f, typename Scalar>
+	const std::vector<Scalar>& table() {
+		static const std::vector<Scalar> t = []() {
+			std::vector<Scalar> values(std::size_t(1) << Scalar::nbits);
+			Scalar a;
+			for (std::size_t i = 0; i < values.size(); ++i) {
+				a.setbits(i);
+				if constexpr (is_cfloat<Scalar> && (f == VmathFunction::sqrt || f == VmathFunction::rsqrt)) {
+					if (a.isneg() && !a.iszero()) {
+						values[i] = Scalar(SpecificValue::qnan);
+						continue;
+					}
+				}
+				try {
+					values[i] = evaluate<f>(a);
+				}
+				catch (...) {
+					values[i] = Scalar(SpecificValue::qnan);
+				}
+			}
+			return values;
+		}();
+		return t;
+	}
+
+	template<VmathFunction f, typename Scalar>
+	void apply(const vector<Scalar>& x, vector<Scalar>& y) {
+		size_t N = x.size();
+		if constexpr (std::is_same_v<Scalar, float>) {
+			for (size_t i = 0; i < N; ++i) y[i] = x[i];
+			if (N > 0) simd_kernel<f>(&y[0], N);
+		}
+		else if constexpr (select_kernel<Scalar>() == VmathKernel::simd) {
+			// convert in blocks that stay in the L1 cache
+			constexpr size_t blockSize = 256;
+			float block[blockSize];
+			for (size_t i = 0; i < N; i += blockSize) {
+				size_t n = std::min(blockSize, N - i);
+				for (size_t j = 0; j < n; ++j) block[j] = float(x[i + j]);
+				simd_kernel<f>(block, n);
+				for (size_t j = 0; j < n; ++j) y[i + j] = Scalar(block[j]);
+			}
+		}
+		else if constexpr (select_kernel<Scalar>() == VmathKernel::table) {
+			const std::vector<Scalar>& t = table<f, Scalar>();
+			for (size_t i = 0; i < N; ++i) y[i] = t[encoding(x[i])];
+		}
+		else {
+			parallel_for(N, VMATH_PARALLEL_GRAIN, [&x, &y](size_t begin, size_t end) {
+				for (size_t i = begin; i < end; ++i) y[i] = evaluate<f>(x[i]);
+			});
+		}
+	}
+
+} // namespace vmath
+
+// evaluate an elementwise function over a vector with the execution strategy of its number system
+template<VmathFunction f, typename Scalar>
+vector<Scalar> vmath_apply(const vector<Scalar>& x) {
+	vector<Scalar> y(x.size());
+	vmath::apply<f>(x, y);
+	return y;
+}
+
+} } }  // namespace sw::universal::blas
@@ -0,0 +1,18 @@
+#pragma once
+// exponent.hpp: vectorized exponential function, takes a vector of exponents and returns the vector of e^x
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/blas/vmath/engine.hpp>
+
+namespace sw { namespace universal { namespace blas {
+
+// vector exponential function
+template<typename Scalar>
+vector<Scalar> exp(const vector<Scalar>& x) {
+	return vmath_apply<VmathFunction::exp>(x);
+}
+
+} } }  // namespace sw::universal::blas
@@ -0,0 +1,18 @@
+#pragma once
+// hyperbolic.hpp: vectorized hyperbolic tangent, takes a vector and returns the vector of hyperbolic tangents
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/blas/vmath/engine.hpp>
+
+namespace sw { namespace universal { namespace blas {
+
+// vector hyperbolic tangent function
+template<typename Scalar>
+vector<Scalar> tanh(const vector<Scalar>& x) {
+	return vmath_apply<VmathFunction::tanh>(x);
+}
+
+} } }  // namespace sw::universal::blas
@@ -0,0 +1,18 @@
+#pragma once
+// logarithm.hpp: vectorized natural logarithm, takes a vector and returns the vector of natural logarithms
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/blas/vmath/engine.hpp>
+
+namespace sw { namespace universal { namespace blas {
+
+// vector natural logarithm function
+template<typename Scalar>
+vector<Scalar> log(const vector<Scalar>& x) {
+	return vmath_apply<VmathFunction::log>(x);
+}
+
+} } }  // namespace sw::universal::blas
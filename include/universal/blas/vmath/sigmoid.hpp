@@ -0,0 +1,18 @@
+#pragma once
+// sigmoid.hpp: vectorized logistic sigmoid, takes a vector and returns the vector of 1/(1+e^-x)
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/blas/vmath/engine.hpp>
+
+namespace sw { namespace universal { namespace blas {
+
+// vector logistic sigmoid function
+template<typename Scalar>
+vector<Scalar> sigmoid(const vector<Scalar>& x) {
+	return vmath_apply<VmathFunction::sigmoid>(x);
+}
+
+} } }  // namespace sw::universal::blas
@@ -1,24 +1,24 @@
 #pragma once
-// sqrt.hpp: vectorized square root function, takes a base and a vector of exponents, and returns vector of square roots
+// sqrt.hpp: vectorized square root and reciprocal square root functions
 //
 // Copyright (C) 2017 Stillwater Supercomputing, Inc.
 // SPDX-License-Identifier: MIT
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
-#include <cmath>
-#include <universal/blas/vector.hpp>
+#include <universal/blas/vmath/engine.hpp>
 
 namespace sw { namespace universal { namespace blas {
 
-// vector power function
+// vector square root function
 template<typename Scalar>
 vector<Scalar> sqrt(const vector<Scalar>& y) {
-	using namespace sw::universal;
-	vector<Scalar> x(y.size());
-	for (size_t i = 0; i < y.size(); ++i) {
-		x[i] = sqrt(y[i]);
-	}
-	return x;
+	return vmath_apply<VmathFunction::sqrt>(y);
+}
+
+// vector reciprocal square root function
+template<typename Scalar>
+vector<Scalar> rsqrt(const vector<Scalar>& y) {
+	return vmath_apply<VmathFunction::rsqrt>(y);
 }
 
 } } }  // namespace sw::universal::blas
@@ -6,32 +6,20 @@
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 #include <cmath>
-#include <universal/blas/vector.hpp>
+#include <universal/blas/vmath/engine.hpp>
 
 namespace sw { namespace universal { namespace blas {
 
 // vector sine function
 template<typename Scalar>
 vector<Scalar> sin(const vector<Scalar>& radians) {
-	using std::sin;
-	using namespace sw::universal;
-	vector<Scalar> v(radians.size());
-	for (size_t i = 0; i < radians.size(); ++i) {
-		v[i] = sin(radians[i]);
-	}
-	return v;
+	return vmath_apply<VmathFunction::sin>(radians);
 }
 
 // vector cosine function
 template<typename Scalar>
 vector<Scalar> cos(const vector<Scalar>& radians) {
-	using std::cos;
-	using namespace sw::universal;
-	vector<Scalar> v(radians.size());
-	for (size_t i = 0; i < radians.size(); ++i) {
-		v[i] = cos(radians[i]);
-	}
-	return v;
+	return vmath_apply<VmathFunction::cos>(radians);
 }
 // vector tangent function
 template<typename Scalar>
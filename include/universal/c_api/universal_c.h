@@ -0,0 +1,99 @@
+#pragma once
+// universal_c.h: C API of the universal_c shared library: vector entry points for posits, cfloats, and lns
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// set up the correct C11 infrastructure
+#include <stddef.h>
+#include <stdint.h>
+
+// posit C types
+#include <universal/number/posit/positctypes.h>
+
+#if defined(_WIN32) && defined(UNIVERSAL_C_SHARED)
+#  if defined(UNIVERSAL_C_EXPORTS)
+#    define UNIVERSAL_C_API __declspec(dllexport)
+#  else
+#    define UNIVERSAL_C_API __declspec(dllimport)
+#  endif
+#elif defined(__GNUC__)
+#  define UNIVERSAL_C_API __attribute__((visibility("default")))
+#else
+#  define UNIVERSAL_C_API
+#endif
+
+#ifdef __cplusplus
+// export a C interface if used by C++ source code
+extern "C" {
+#endif
+
+	//////////////////////////////////////////////////////////////////////
+	/// cfloat and lns storage formats
+	typedef union fp8_u {
+		uint8_t x[1];
+		uint8_t v;
+	}							fp8_t;		// cfloat<8,2,uint8_t,true,false,false>   quarter precision
+	typedef union fp16_u {
+		uint8_t x[2];
+		uint16_t v;
+	}							fp16_t;		// cfloat<16,5,uint16_t,true,false,false>  IEEE-754 half precision
+	typedef union bf16_u {
+		uint8_t x[2];
+		uint16_t v;
+	}							bf16_t;		// cfloat<16,8,uint16_t,true,false,false>  Google Brain float
+	typedef union lns16_u {
+		uint8_t x[2];
+		uint16_t v;
+	}							lns16_t;	// lns<16,8,uint16_t>
+	typedef union lns32_u {
+		uint8_t x[4];
+		uint32_t v;
+	}							lns32_t;	// lns<32,24,uint32_t>
+
+/*
+   Vector entry points, generated for each number type T in
+   { posit8, posit16, posit32, posit64, fp8, fp16, bf16, lns16, lns32 }:
+
+     void T_fromd_array(size_t n, const double* x, T_t* y)                 y[i] = T(x[i])
+     void T_tod_array(size_t n, const T_t* x, double* y)                   y[i] = double(x[i])
+     void T_add_array(size_t n, const T_t* a, const T_t* b, T_t* c)        c[i] = a[i] + b[i]
+     void T_mul_array(size_t n, const T_t* a, const T_t* b, T_t* c)        c[i] = a[i] * b[i]
+     void T_fma_array(size_t n, const T_t* a, const T_t* b, const T_t* c, T_t* d)    d[i] = a[i] * b[i] + c[i]
+     T_t  T_dot(size_t n, const T_t* x, ptrdiff_t incx, const T_t* y, ptrdiff_t incy)
+     void T_axpy(size_t n, T_t alpha, const T_t* x, ptrdiff_t incx, T_t* y, ptrdiff_t incy)   y = alpha * x + y
+     void T_gemv(size_t m, size_t n, T_t alpha, const T_t* A, size_t lda, const T_t* x, T_t beta, T_t* y)
+                                                                          y = alpha * A * x + beta * y, A is m x n row-major
+
+   The strides of dot and axpy follow the BLAS convention: a negative increment walks the vector
+   from its end. The fma, dot, and axpy results are rounded once; posit dot products accumulate
+   in a quire. gemv rounds the dot product of each row and fuses the alpha/beta update.
+   The output arrays of the element-wise functions may alias their inputs.
+*/
+#define UNIVERSAL_C_BATCH_API(T)                                                                                      \
+	UNIVERSAL_C_API void T##_fromd_array(size_t n, const double* x, T##_t* y);                                       \
+	UNIVERSAL_C_API void T##_tod_array(size_t n, const T##_t* x, double* y);                                         \
+	UNIVERSAL_C_API void T##_add_array(size_t n, const T##_t* a, const T##_t* b, T##_t* c);                          \
+	UNIVERSAL_C_API void T##_mul_array(size_t n, const T##_t* a, const T##_t* b, T##_t* c);                          \
+	UNIVERSAL_C_API void T##_fma_array(size_t n, const T##_t* a, const T##_t* b, const T##_t* c, T##_t* d);          \
+	UNIVERSAL_C_API T##_t T##_dot(size_t n, const T##_t* x, ptrdiff_t incx, const T##_t* y, ptrdiff_t incy);         \
+	UNIVERSAL_C_API void T##_axpy(size_t n, T##_t alpha, const T##_t* x, ptrdiff_t incx, T##_t* y, ptrdiff_t incy);  \
+	UNIVERSAL_C_API void T##_gemv(size_t m, size_t n, T##_t alpha, const T##_t* A, size_t lda, const T##_t* x, T##_t beta, T##_t* y);
+
+	UNIVERSAL_C_BATCH_API(posit8)
+	UNIVERSAL_C_BATCH_API(posit16)
+	UNIVERSAL_C_BATCH_API(posit32)
+	UNIVERSAL_C_BATCH_API(posit64)
+	UNIVERSAL_C_BATCH_API(fp8)
+	UNIVERSAL_C_BATCH_API(fp16)
+	UNIVERSAL_C_BATCH_API(bf16)
+	UNIVERSAL_C_BATCH_API(lns16)
+	UNIVERSAL_C_BATCH_API(lns32)
+
+#undef UNIVERSAL_C_BATCH_API
+
+#ifdef __cplusplus
+}
+#endif
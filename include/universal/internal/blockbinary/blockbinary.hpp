@@ -10,6 +10,7 @@
 #include <string>
 #include <sstream>
 #include <universal/number/shared/specific_value_encoding.hpp>
+#include <universal/internal/uint128/limbs.hpp>
 
 namespace sw { namespace universal {
 
@@ -76,12 +77,10 @@ void truncate(const blockbinary<srcbits, bt, nt>& src, blockbinary<tgtbits, bt,
 /*
 NOTES
 
-for block arithmetic, we need to manage a carry bit.
-This disqualifies using uint64_t as a block type as we can't catch the overflow condition
-in the same way as the other native types, uint8_t, uint16_t, uint32_t.
-
-We could use a sint64_t and then convert to uint64_t and observe the MSB. Very different 
-logic though.
+for block arithmetic, we need to manage a carry bit, and for multiplication the upper half of
+the partial product. For uint8_t, uint16_t, and uint32_t blocks both fit in a uint64_t, for
+uint64_t blocks the limb primitives in limbs.hpp use a 128-bit widening multiply and an
+explicit carry out.
 */
 
 // a block-based binary number configurable to be signed or unsigned. When signed it uses 2's complement encoding
@@ -105,7 +104,7 @@ public:
 	static constexpr bt       SIGN_BIT_MASK = (0 == nbits ? bt(0) : (bt(bt(1) << ((nbits - 1ull) % bitsInBlock))));
 
 	static constexpr bool     uniblock64 = (bitsInBlock == 64) && (nrBlocks == 1);
-	static_assert(bitsInBlock < 64 || uniblock64, "storage unit for multi-block arithmetic needs to be one of [uint8_t | uint16_t | uint32_t]");
+	static_assert(bitsInBlock <= 64, "storage unit for block arithmetic needs to be one of [uint8_t | uint16_t | uint32_t | uint64_t]");
 
 	/// trivial constructor
 	blockbinary() = default;
@@ -147,9 +146,15 @@ public:
 
 	constexpr blockbinary& operator=(long long rhs) noexcept {
 		if constexpr (1 < nrBlocks) {
-			for (unsigned i = 0; i < nrBlocks; ++i) {
-				_block[i] = rhs & storageMask;
-				rhs >>= bitsInBlock;
+			if constexpr (bitsInBlock < 64) {
+				for (unsigned i = 0; i < nrBlocks; ++i) {
+					_block[i] = rhs & storageMask;
+					rhs >>= bitsInBlock;
+				}
+			}
+			else {
+				_block[0] = static_cast<bt>(rhs);
+				for (unsigned i = 1; i < nrBlocks; ++i) _block[i] = (rhs < 0 ? ALL_ONES : bt(0)); // sign extend
 			}
 			// enforce precondition for fast comparison by properly nulling bits that are outside of nbits
 			_block[MSU] &= MSU_MASK;
@@ -236,11 +241,9 @@ public:
 			BlockType const* pB = rhs._block;
 			BlockType* pC = sum._block;
 			BlockType* pEnd = pC + nrBlocks;
-			std::uint64_t carry = 0;
+			BlockType carry = 0;
 			while (pC != pEnd) {
-				carry += static_cast<std::uint64_t>(*pA) + static_cast<std::uint64_t>(*pB);
-				*pC = static_cast<bt>(carry);
-				carry >>= bitsInBlock;
+				*pC = limb_addc(*pA, *pB, carry);
 				++pA; ++pB; ++pC;
 			}
 			// enforce precondition for fast comparison by properly nulling bits that are outside of nbits
@@ -273,15 +276,9 @@ public:
 				}
 				clear();
 				for (unsigned i = 0; i < static_cast<unsigned>(nrBlocks); ++i) {
-					std::uint64_t segment(0);
-					for (unsigned j = 0; j < static_cast<unsigned>(nrBlocks); ++j) {
-						segment += static_cast<std::uint64_t>(base.block(i)) * static_cast<std::uint64_t>(multiplicant.block(j));
-
-						if (i + j < static_cast<unsigned>(nrBlocks)) {
-							segment += _block[i + j];
-							_block[i + j] = static_cast<bt>(segment);
-							segment >>= bitsInBlock;
-						}
+					BlockType carry(0);
+					for (unsigned j = 0; i + j < static_cast<unsigned>(nrBlocks); ++j) {
+						_block[i + j] = limb_muladd(base.block(i), multiplicant.block(j), _block[i + j], carry);
 					}
 				}
 				if (resultIsNeg) twosComplement();
@@ -296,15 +293,9 @@ public:
 				blockbinary multiplicant(rhs);
 				clear();
 				for (unsigned i = 0; i < static_cast<unsigned>(nrBlocks); ++i) {
-					std::uint64_t segment(0);
-					for (unsigned j = 0; j < static_cast<unsigned>(nrBlocks); ++j) {
-						segment += static_cast<std::uint64_t>(base.block(i)) * static_cast<std::uint64_t>(multiplicant.block(j));
-
-						if (i + j < static_cast<unsigned>(nrBlocks)) {
-							segment += _block[i + j];
-							_block[i + j] = static_cast<bt>(segment);
-							segment >>= bitsInBlock;
-						}
+					BlockType carry(0);
+					for (unsigned j = 0; i + j < static_cast<unsigned>(nrBlocks); ++j) {
+						_block[i + j] = limb_muladd(base.block(i), multiplicant.block(j), _block[i + j], carry);
 					}
 				}
 			}
@@ -425,7 +416,10 @@ public:
 			}
 			// adjust the shift
 			bitsToShift -= static_cast<int>(blockShift * bitsInBlock);
-			if (bitsToShift == 0) return *this;
+			if (bitsToShift == 0) {
+				_block[MSU] &= MSU_MASK;
+				return *this;
+			}
 		}
 		if constexpr (MSU > 0) {
 			// construct the mask for the upper bits in the block that needs to move to the higher word
@@ -438,6 +432,7 @@ public:
 			}
 		}
 		_block[0] <<= bitsToShift;
+		_block[MSU] &= MSU_MASK; // enforce precondition for fast comparison by properly nulling bits that are outside of nbits
 		return *this;
 	}
 	// arithmetic shift right operator
@@ -549,9 +544,15 @@ public:
 			_block[0] = value & storageMask;
 		}
 		else if constexpr (1 < nrBlocks) {
-			for (unsigned i = 0; i < nrBlocks; ++i) {
-				_block[i] = value & storageMask;
-				value >>= bitsInBlock;
+			if constexpr (bitsInBlock < 64) {
+				for (unsigned i = 0; i < nrBlocks; ++i) {
+					_block[i] = value & storageMask;
+					value >>= bitsInBlock;
+				}
+			}
+			else {
+				_block[0] = value;
+				for (unsigned i = 1; i < nrBlocks; ++i) _block[i] = 0;
 			}
 		}
 		_block[MSU] &= MSU_MASK; // enforce precondition for fast comparison by properly nulling bits that are outside of nbits
@@ -685,7 +686,7 @@ public:
 		if (n < (1 + ((nbits - 1) >> 2))) {
 			bt word = _block[(n * 4) / bitsInBlock];
 			unsigned nibbleIndexInWord = n % (bitsInBlock >> 2);
-			bt mask = static_cast<bt>(0x0Fu << (nibbleIndexInWord*4));
+			bt mask = static_cast<bt>(bt(0x0Fu) << (nibbleIndexInWord*4));
 			bt nibblebits = static_cast<bt>(mask & word);
 			retval = static_cast<uint8_t>(nibblebits >> static_cast<bt>(nibbleIndexInWord*4));
 		}
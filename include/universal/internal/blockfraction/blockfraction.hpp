@@ -11,6 +11,7 @@
 #include <string>
 #include <sstream>
 
+#include <universal/internal/uint128/limbs.hpp>
 #include <universal/internal/blockfraction/blockfraction_fwd.hpp>
 
 namespace sw { namespace universal {
@@ -26,13 +27,9 @@ struct bfquorem {
 
 /*
 NOTE 1
-   For block arithmetic, we need to manage a carry bit.
-This disqualifies using uint64_t as a block type as we can't catch the overflow condition
-in the same way as the other native types, uint8_t, uint16_t, uint32_t.
-   We could use a sint64_t and then convert to uint64_t and observe the MSB. 
-That requires different logic though. 
-TODO: the highest performance for 32bits and up would be to have a uint64_t base type
-for which we need asm to get the carry bit logic to work.
+   For block arithmetic, we need to manage a carry bit. The limb primitives in limbs.hpp
+propagate the carry, and the upper half of a partial product, for all block types
+including uint64_t, which uses a 128-bit widening multiply.
 
 TODO: are there mechanisms where we can use SIMD for vector operations?
 If there are, then doing something with more fitting and smaller base types might
@@ -173,13 +170,9 @@ public:
 	/// </summary>
 	/// <returns></returns>
 	constexpr void increment() noexcept {
-		bool carry = true;
+		bt carry = 1;
 		for (unsigned i = 0; i < nrBlocks; ++i) {
-			// cast up so we can test for overflow
-			uint64_t l = uint64_t(_block[i]);
-			uint64_t s = l + (carry ? uint64_t(1) : uint64_t(0));
-			carry = (s > ALL_ONES);
-			_block[i] = bt(s);
+			_block[i] = limb_addc(_block[i], bt(0), carry);
 		}
 		// enforce precondition for fast comparison by properly nulling bits that are outside of nbits
 		_block[MSU] &= MSU_MASK;
@@ -192,14 +185,9 @@ public:
 	/// <param name="lhs">nbits of fraction in the form 00h.ffff</param>
 	/// <param name="rhs">nbits of fraction in the form 00h.ffff</param>
 	void add(const blockfraction& lhs, const blockfraction& rhs) noexcept {
-		bool carry = false;
+		bt carry = 0;
 		for (unsigned i = 0; i < nrBlocks; ++i) {
-			// cast up so we can test for overflow
-			uint64_t l = uint64_t(lhs._block[i]);
-			uint64_t r = uint64_t(rhs._block[i]);
-			uint64_t s = l + r + (carry ? uint64_t(1) : uint64_t(0));
-			carry = (s > ALL_ONES);
-			_block[i] = bt(s);
+			_block[i] = limb_addc(lhs._block[i], rhs._block[i], carry);
 		}
 		// enforce precondition for fast comparison by properly nulling bits that are outside of nbits
 		_block[MSU] &= MSU_MASK;
@@ -212,14 +200,15 @@ public:
 		blockfraction<nbits, bt> base(lhs);
 		blockfraction<nbits, bt> multiplicant(rhs);
 		clear();
-		for (unsigned i = 0; i < nbits; ++i) {
-			if (base.at(i)) {
-				add(*this, multiplicant);
+		// schoolbook product on limbs, modulo 2^nbits
+		for (unsigned i = 0; i < nrBlocks; ++i) {
+			bt carry(0);
+			for (unsigned j = 0; i + j < nrBlocks; ++j) {
+				_block[i + j] = limb_muladd(base._block[i], multiplicant._block[j], _block[i + j], carry);
 			}
-			multiplicant <<= 1;
 		}
-		// since we used operator+=, which enforces the nulling of leading bits
-		// we don't need to null here
+		// enforce precondition for fast comparison by properly nulling bits that are outside of nbits
+		_block[MSU] &= MSU_MASK;
 	}
 	void div(const blockfraction& lhs, const blockfraction& rhs) noexcept {
 		blockfraction<nbits, bt> base(lhs);
@@ -436,7 +425,7 @@ public:
 		if (n < (1 + ((nbits - 1) >> 2))) {
 			bt word = _block[(n * 4) / bitsInBlock];
 			unsigned nibbleIndexInWord = n % (bitsInBlock >> 2);
-			bt mask = static_cast<bt>(0x0Fu << (nibbleIndexInWord*4));
+			bt mask = static_cast<bt>(bt(0x0Fu) << (nibbleIndexInWord*4));
 			bt nibblebits = static_cast<bt>(mask & word);
 			return static_cast<uint8_t>(nibblebits >> static_cast<bt>(nibbleIndexInWord*4));
 		}
@@ -11,6 +11,8 @@
 #include <string>
 #include <sstream>
 
+#include <universal/internal/uint128/limbs.hpp>
+#include <universal/utility/find_msb.hpp>
 #include <universal/internal/blocksignificant/blocksignificant_fwd.hpp>
 
 /*
@@ -55,13 +57,9 @@ struct bsquorem {
 
 /*
 NOTE 1
-   For block arithmetic, we need to manage a carry bit.
-This disqualifies using uint64_t as a block type as we can't catch the overflow condition
-in the same way as the other native types, uint8_t, uint16_t, uint32_t.
-   We could use a sint64_t and then convert to uint64_t and observe the MSB. 
-That requires different logic though. 
-TODO: the highest performance for 32bits and up would be to have a uint64_t base type
-for which we need asm to get the carry bit logic to work.
+   For block arithmetic, we need to manage a carry bit. The limb primitives in limbs.hpp
+propagate the carry, and the upper half of a partial product, for all block types
+including uint64_t, which uses a 128-bit widening multiply.
 
 TODO: are there mechanisms where we can use SIMD for vector operations?
 If there are, then doing something with more fitting and smaller base types might
@@ -202,13 +200,9 @@ public:
 	/// </summary>
 	/// <returns></returns>
 	constexpr void increment() noexcept {
-		bool carry = true;
+		bt carry = 1;
 		for (unsigned i = 0; i < nrBlocks; ++i) {
-			// cast up so we can test for overflow
-			uint64_t l = uint64_t(_block[i]);
-			uint64_t s = l + (carry ? uint64_t(1) : uint64_t(0));
-			carry = (s > ALL_ONES);
-			_block[i] = bt(s);
+			_block[i] = limb_addc(_block[i], bt(0), carry);
 		}
 		// enforce precondition for fast comparison by properly nulling bits that are outside of nbits
 		_block[MSU] &= MSU_MASK;
@@ -221,14 +215,9 @@ public:
 	/// <param name="lhs">nbits of fraction in the form 00h.ffff</param>
 	/// <param name="rhs">nbits of fraction in the form 00h.ffff</param>
 	void add(const blocksignificant& lhs, const blocksignificant& rhs) noexcept {
-		bool carry = false;
+		bt carry = 0;
 		for (unsigned i = 0; i < nrBlocks; ++i) {
-			// cast up so we can test for overflow
-			uint64_t l = uint64_t(lhs._block[i]);
-			uint64_t r = uint64_t(rhs._block[i]);
-			uint64_t s = l + r + (carry ? uint64_t(1) : uint64_t(0));
-			carry = (s > ALL_ONES);
-			_block[i] = bt(s);
+			_block[i] = limb_addc(lhs._block[i], rhs._block[i], carry);
 		}
 		// enforce precondition for fast comparison by properly nulling bits that are outside of nbits
 		_block[MSU] &= MSU_MASK;
@@ -238,17 +227,38 @@ public:
 		add(lhs, b);
 	}
 	void mul(const blocksignificant& lhs, const blocksignificant& rhs) noexcept {
-		blocksignificant<nbits, bt> base(lhs);
-		blocksignificant<nbits, bt> multiplicant(rhs);
-		clear();
-		for (unsigned i = 0; i < nbits; ++i) {
-			if (base.at(i)) {
-				add(*this, multiplicant);
+		if (this == &rhs) {
+			if (this == &lhs) {
+				blocksignificant<nbits, bt> multiplicant(rhs);  // squaring in place needs one operand out of the way
+				mul(lhs, multiplicant);
+			}
+			else {
+				mul(rhs, lhs);
+			}
+			return;
+		}
+		if (this != &lhs) {
+			for (unsigned i = 0; i < nrBlocks; ++i) _block[i] = lhs._block[i];
+		}
+		// schoolbook product on limbs, modulo 2^nbits, in place: processing the limbs of the
+		// multiplier from the top down, limb i is consumed before any partial product lands on it
+		unsigned rhsBlocks = nrBlocks;
+		while (rhsBlocks > 0 && rhs._block[rhsBlocks - 1] == 0) --rhsBlocks;
+		for (unsigned i = nrBlocks; i-- > 0;) {
+			bt a = _block[i];
+			_block[i] = bt(0);
+			if (a == 0) continue;
+			bt carry(0);
+			unsigned j = 0;
+			for (; j < rhsBlocks && i + j < nrBlocks; ++j) {
+				_block[i + j] = limb_muladd(a, rhs._block[j], _block[i + j], carry);
+			}
+			for (unsigned k = i + j; carry != 0 && k < nrBlocks; ++k) {
+				_block[k] = limb_addc(_block[k], bt(0), carry);
 			}
-			multiplicant <<= 1;
 		}
-		// since we used operator+=, which enforces the nulling of leading bits
-		// we don't need to null here
+		// enforce precondition for fast comparison by properly nulling bits that are outside of nbits
+		_block[MSU] &= MSU_MASK;
 	}
 	void div(const blocksignificant& lhs, const blocksignificant& rhs) noexcept {
 		blocksignificant<nbits, bt> base(lhs);
@@ -266,6 +276,57 @@ public:
 			divider >>= 1;
 		}
 	}
+	/// <summary>
+	/// integer square root by digit recurrence: this = floor(sqrt(radicand)).
+	/// The partial remainders need two bits of headroom above the radicand.
+	/// </summary>
+	/// <param name="radicand">unsigned integer</param>
+	/// <returns>true when the remainder radicand - root^2 is non-zero, that is, the sticky bit of the root</returns>
+	bool sqrt(const blocksignificant& radicand) noexcept {
+		blocksignificant remainder(radicand), term;
+		clear();
+		int msb = radicand.msb();
+		for (int i = msb / 2; msb >= 0 && i >= 0; --i) {
+			// (q + 2^i)^2 - q^2 = q * 2^(i+1) + 2^(2i), and q has no bits at or below i
+			term = *this;
+			term <<= i + 1;
+			term.setbit(static_cast<unsigned>(2 * i));
+			if (ule(term, remainder)) {
+				remainder.usub(term);
+				setbit(static_cast<unsigned>(i));
+			}
+		}
+		return !remainder.iszero();
+	}
+	/// <summary>
+	/// reciprocal square root by digit recurrence: this = floor(sqrt(2^power / d)),
+	/// the largest integer q with q^2 * d <= 2^power. The partial remainders need
+	/// three bits of headroom above 2^power.
+	/// </summary>
+	/// <param name="d">non-zero unsigned integer</param>
+	/// <param name="power">power of 2 of the dividend</param>
+	/// <returns>true when q^2 * d differs from 2^power, that is, the sticky bit of the root</returns>
+	bool rsqrt(const blocksignificant& d, unsigned power) noexcept {
+		blocksignificant remainder, dq, term, step;  // remainder = 2^power - q^2 * d, dq = d * q
+		remainder.setbit(power);
+		clear();
+		int msb = d.msb();
+		for (int i = (static_cast<int>(power) - msb) / 2 + 1; msb >= 0 && i >= 0; --i) {
+			// (q + 2^i)^2 d - q^2 d = (2 dq + d 2^i) 2^i
+			step = d;
+			step <<= i;
+			term = dq;
+			term <<= 1;
+			term.add(term, step);
+			term <<= i;
+			if (ule(term, remainder)) {
+				remainder.usub(term);
+				dq.add(dq, step);
+				setbit(static_cast<unsigned>(i));
+			}
+		}
+		return !remainder.iszero();
+	}
 
 #ifdef FRACTION_REMAINDER
 	// remainder operator
@@ -326,11 +387,7 @@ public:
 			bitsToShift -= static_cast<int>(blockShift * bitsInBlock);
 			if (bitsToShift == 0) {
 				// clean up the blocks we have shifted clean
-				bitsToShift += static_cast<int>(blockShift * bitsInBlock);
-				for (unsigned i = nbits - bitsToShift; i < nbits; ++i) {
-					this->setbit(i, false); // reset
-				}
-
+				clearFrom(nbits - blockShift * bitsInBlock);
 				return *this;
 			}
 		}
@@ -348,9 +405,7 @@ public:
 
 		// clean up the blocks we have shifted clean
 		bitsToShift += static_cast<int>(blockShift * bitsInBlock);
-		for (unsigned i = nbits - bitsToShift; i < nbits; ++i) {
-			this->setbit(i, false); // reset
-		}
+		clearFrom(nbits - static_cast<unsigned>(bitsToShift));
 
 		// enforce precondition for fast comparison by properly nulling bits that are outside of nbits
 		_block[MSU] &= MSU_MASK;
@@ -407,10 +462,8 @@ public:
 	}
 	// in-place 2's complement
 	constexpr blocksignificant& twosComplement() noexcept {
-		blocksignificant<nbits, bt> plusOne;
-		plusOne.setbit(0);
 		flip();
-		add(*this, plusOne);
+		increment();
 		return *this;
 	}
 
@@ -438,7 +491,7 @@ public:
 		if (n < (1 + ((nbits - 1) >> 2))) {
 			bt word = _block[(n * 4) / bitsInBlock];
 			unsigned nibbleIndexInWord = n % (bitsInBlock >> 2);
-			bt mask = static_cast<bt>(0x0Fu << (nibbleIndexInWord*4));
+			bt mask = static_cast<bt>(bt(0x0Fu) << (nibbleIndexInWord*4));
 			bt nibblebits = static_cast<bt>(mask & word);
 			return static_cast<uint8_t>(nibblebits >> static_cast<bt>(nibbleIndexInWord*4));
 		}
@@ -523,13 +576,7 @@ public:
 	constexpr int msb() const noexcept {
 		for (int i = int(MSU); i >= 0; --i) {
 			if (_block[i] != 0) {
-				bt mask = (bt(1u) << (bitsInBlock-1));
-				for (int j = bitsInBlock - 1; j >= 0; --j) {
-					if (_block[i] & mask) {
-						return i * static_cast<int>(bitsInBlock) + j;
-					}
-					mask >>= 1;
-				}
+				return i * static_cast<int>(bitsInBlock) + static_cast<int>(find_msb(static_cast<unsigned long long>(_block[i]))) - 1;
 			}
 		}
 		return -1; // no significant bit found, all bits are zero
@@ -586,6 +633,15 @@ public:
 		bool tie = guard && !round && !sticky;
 		return (lsb && tie) || (guard && !tie);
 	}
+	// the bitsInBlock bits starting at bit lsb, bits beyond nbits read as 0
+	constexpr bt blockAt(unsigned lsb) const noexcept {
+		unsigned blockIndex = lsb / bitsInBlock;
+		if (blockIndex >= nrBlocks) return bt(0);
+		unsigned shift = lsb % bitsInBlock;
+		bt bits = bt(_block[blockIndex] >> shift);
+		if (shift == 0 || blockIndex + 1 >= nrBlocks) return bits;
+		return bt(bits | bt(_block[blockIndex + 1] << (bitsInBlock - shift)));
+	}
 	constexpr bool any(unsigned msb) const noexcept {
 		msb = (msb > nbits - 1 ? nbits - 1 : msb);
 		unsigned topBlock = msb / bitsInBlock;
@@ -600,7 +656,30 @@ public:
 
 protected:
 	// HELPER methods
-	// none
+
+	// reset the bits from bitIndex up to nbits
+	constexpr void clearFrom(unsigned bitIndex) noexcept {
+		unsigned blockIndex = bitIndex / bitsInBlock;
+		if (blockIndex >= nrBlocks) return;
+		unsigned bitsInLowBlock = bitIndex % bitsInBlock;
+		_block[blockIndex] = (bitsInLowBlock == 0 ? bt(0) : bt(_block[blockIndex] & bt(ALL_ONES >> (bitsInBlock - bitsInLowBlock))));
+		for (unsigned i = blockIndex + 1; i < nrBlocks; ++i) _block[i] = bt(0);
+	}
+
+	// unsigned comparison of the bit patterns: lhs <= rhs
+	static constexpr bool ule(const blocksignificant& lhs, const blocksignificant& rhs) noexcept {
+		for (unsigned i = nrBlocks; i-- > 0;) {
+			if (lhs._block[i] != rhs._block[i]) return lhs._block[i] < rhs._block[i];
+		}
+		return true;
+	}
+	// in-place unsigned subtraction, precondition: rhs <= *this
+	constexpr void usub(const blocksignificant& rhs) noexcept {
+		bt borrow = 0;
+		for (unsigned i = 0; i < nrBlocks; ++i) {
+			_block[i] = limb_subb(_block[i], rhs._block[i], borrow);
+		}
+	}
 
 public:
 	int radixPoint;
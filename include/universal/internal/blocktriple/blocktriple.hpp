@@ -127,7 +127,7 @@ public:
 	static constexpr unsigned mbits    = 2 * fbits;          // size of the fraction bits of the multiplier
 	static constexpr unsigned divbits  = 3 * fbits + 4;      // size of the fraction bits of the divider
 	static constexpr unsigned divshift = divbits - fbits;    // alignment shift for divider operands
-	static constexpr unsigned sqrtbits = 2 * fhbits;      // size of the square root output
+	static constexpr unsigned sqrtbits = 2 * fhbits + 4;  // size of the square root output: the root with fbits + 4 fraction bits, or an input scaled to radix 2*fbits
 	// we transform input operands into the operation's target output size
 	// so that everything is aligned correctly before the operation starts.
 	static constexpr unsigned bfbits =
@@ -140,7 +140,7 @@ public:
 		(op == BlockTripleOperator::ADD ? static_cast<int>(abits) :
 			(op == BlockTripleOperator::MUL ? static_cast<int>(mbits) :
 				(op == BlockTripleOperator::DIV ? static_cast<int>(divbits) :
-					(op == BlockTripleOperator::SQRT ? static_cast<int>(sqrtbits) : static_cast<int>(fbits)))));  // REPRESENTATION is the fall through condition
+					(op == BlockTripleOperator::SQRT ? static_cast<int>(fbits + 4) : static_cast<int>(fbits)))));  // REPRESENTATION is the fall through condition
 //	static constexpr BitEncoding encoding =
 //		(op == BlockTripleOperator::ADD ? BitEncoding::Twos :
 //			(op == BlockTripleOperator::MUL ? BitEncoding::Ones :
@@ -361,18 +361,15 @@ public:
 	inline constexpr bool sign()                 const noexcept { return _sign; }
 	inline constexpr int  scale()                const noexcept { return _scale; }
 	inline constexpr int  significantscale()     const noexcept {
-		int sigScale = 0;
-		for (int i = bfbits - 1; i >= radix; --i) {
-			if (_significant.at(static_cast<unsigned>(i))) {
-				sigScale = i - radix;
-				break;
-			}
-		}
-		return sigScale;
+		// a block scan instead of a bit scan: GCC 12 -O2 folds the split-off at() tails of different
+		// blocksignificant sizes without comparing their block index ranges (GCC PR ipa/113907)
+		int msb = _significant.msb();
+		return (msb > radix ? msb - radix : 0);
 	}
 	inline constexpr Significant significant()   const noexcept { return _significant; }
 	inline constexpr Significant fraction()      const noexcept { return _significant.fraction(); }
 	inline constexpr uint64_t significant_ull()  const noexcept { return _significant.significant_ull(); } // fast path when bfbits <= 64 to get the significant bits out of the representation
+	inline constexpr bt       significant_block(unsigned lsb) const noexcept { return _significant.blockAt(lsb); } // the block of significant bits starting at lsb, without copying the significant
 	inline constexpr uint64_t fraction_ull()     const noexcept { return _significant.fraction_ull(); }
 	inline constexpr bool at(unsigned index)       const noexcept { return _significant.at(index); }
 	inline constexpr bool test(unsigned index)     const noexcept { return _significant.at(index); }
@@ -476,6 +473,7 @@ public:
 		}
 		else {
 			_zero = false;
+			_sign = false;  // the sum may overwrite one of its operands
 			if (_significant.test(bfbits-1)) {  // is the result negative?
 				_significant.twosComplement();
 				_sign = true;
@@ -621,6 +619,125 @@ public:
 		}
 	}
 
+	/// <summary>
+	/// square root of a positive real number with fbits fraction bits and a leading 1,
+	/// yielding a root 1.ffff with fbits + 4 fraction bits, the last of which is the sticky bit.
+	/// The input significant must be prepared by the calling environment in the form 1.ffff
+	/// with the radix at fbits, and the output is left to the calling environment for rounding.
+	/// </summary>
+	/// <param name="a">ephemeral blocktriple that may get modified</param>
+	void sqrt(blocktriple& a) {
+		// radicand = m * 2^(fbits + 8), so that root = sqrt(m * 2^-fbits) * 2^(fbits + 4)
+		using Radicand = blocksignificant<2 * fbits + 14, bt>;
+		int scale = a.scale();
+		bool odd = (scale & 1);  // make the scale even: the significant moves into [1, 4)
+		if (odd) --scale;
+		if constexpr (Radicand::nbits < 65) {
+			// fast path: the radicand fits in a native word
+			uint64_t radicand = a.significant_ull() << ((odd ? 1 : 0) + fbits + 8);
+			uint64_t root{ 0 };
+			uint64_t bit = 1ull << 62;
+			while (bit > radicand) bit >>= 2;
+			while (bit != 0) {
+				if (radicand >= root + bit) {
+					radicand -= root + bit;
+					root = (root >> 1) + bit;
+				}
+				else {
+					root >>= 1;
+				}
+				bit >>= 2;
+			}
+			clear();
+			_zero = false;
+			_scale = scale / 2;
+			_significant.setbits(root | (radicand != 0 ? 1ull : 0ull));
+		}
+		else {
+			Radicand radicand, root;
+			for (unsigned i = 0; i < Significant::nrBlocks && i < Radicand::nrBlocks; ++i) radicand.setblock(i, a.block(i));
+			if (odd) radicand <<= 1;
+			radicand <<= static_cast<int>(fbits + 8);
+			bool sticky = root.sqrt(radicand);
+
+			clear();
+			_zero = false;
+			_scale = scale / 2;
+			for (unsigned i = 0; i < Significant::nrBlocks; ++i) _significant.setblock(i, root.block(i));
+			if (sticky) _significant.setbit(0);
+		}
+		_significant.setradix(radix);
+
+		if constexpr (_trace_btriple_sqrt) {
+			std::cout << "blocktriple sqrt\n";
+			std::cout << "a    : " << to_binary(a) << " : " << a << '\n';
+			std::cout << "sqrt : " << to_binary(*this) << " : " << *this << '\n';
+		}
+	}
+
+	/// <summary>
+	/// reciprocal square root of a positive real number with fbits fraction bits and a leading 1,
+	/// yielding a result 1.ffff with fbits + 4 fraction bits, the last of which is the sticky bit.
+	/// The input is prepared as for sqrt.
+	/// </summary>
+	/// <param name="a">ephemeral blocktriple that may get modified</param>
+	void rsqrt(blocktriple& a) {
+		// q = floor(sqrt(2^(3*fbits + 8) / m)) = floor(2^(fbits + 4) / sqrt(m * 2^-fbits))
+		using Reciprocal = blocksignificant<3 * fbits + 14, bt>;
+		constexpr unsigned power = 3 * fbits + 8;
+		int scale = a.scale();
+		bool odd = (scale & 1);
+		if (odd) --scale;
+		int rootScale = -scale / 2;
+		if constexpr (Reciprocal::nbits < 65) {
+			// fast path: the partial remainders fit in a native word
+			uint64_t d = a.significant_ull() << (odd ? 1 : 0);
+			uint64_t remainder = 1ull << power, dq{ 0 }, root{ 0 };
+			int msb = static_cast<int>(fbits) + (odd ? 1 : 0);
+			for (int i = (static_cast<int>(power) - msb) / 2 + 1; i >= 0; --i) {
+				// (q + 2^i)^2 d - q^2 d = (2 dq + d 2^i) 2^i
+				uint64_t step = d << i;
+				uint64_t term = ((dq << 1) + step) << i;
+				if (term <= remainder) {
+					remainder -= term;
+					dq += step;
+					root |= (1ull << i);
+				}
+			}
+			if ((root & (1ull << (fbits + 4))) == 0) {  // 1/sqrt(m * 2^-fbits) is in (1/2, 1]: normalize to 1.ffff
+				root <<= 1;
+				--rootScale;
+			}
+			clear();
+			_zero = false;
+			_scale = rootScale;
+			_significant.setbits(root | (remainder != 0 ? 1ull : 0ull));
+		}
+		else {
+			Reciprocal m, root;
+			for (unsigned i = 0; i < Significant::nrBlocks && i < Reciprocal::nrBlocks; ++i) m.setblock(i, a.block(i));
+			if (odd) m <<= 1;
+			bool sticky = root.rsqrt(m, power);
+			if (!root.test(fbits + 4)) {  // 1/sqrt(m * 2^-fbits) is in (1/2, 1]: normalize to 1.ffff
+				root <<= 1;
+				--rootScale;
+			}
+
+			clear();
+			_zero = false;
+			_scale = rootScale;
+			for (unsigned i = 0; i < Significant::nrBlocks; ++i) _significant.setblock(i, root.block(i));
+			if (sticky) _significant.setbit(0);
+		}
+		_significant.setradix(radix);
+
+		if constexpr (_trace_btriple_sqrt) {
+			std::cout << "blocktriple rsqrt\n";
+			std::cout << "a     : " << to_binary(a) << " : " << a << '\n';
+			std::cout << "rsqrt : " << to_binary(*this) << " : " << *this << '\n';
+		}
+	}
+
 private:
 	// special cases to keep track of
 	bool _nan; // most dominant state
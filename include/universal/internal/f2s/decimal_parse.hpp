@@ -0,0 +1,711 @@
+#pragma once
+// decimal_parse.hpp: correctly rounded decimal to binary conversion to parse arbitrary binary floating-point and fixed-point values
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <cstddef>
+#include <bit>
+#include <charconv>
+#include <string>
+#include <vector>
+#include <system_error>
+#include <type_traits>
+#include <universal/internal/f2s/dragon.hpp>
+
+/*
+	A decimal d1d2...dn * 10^q is converted into a binary significand of 64 * nrWords bits that is
+	rounded to odd: the bits are the truncation of the exact value, and the lsb is set when any of
+	the discarded bits is set. Rounding a round-to-odd value of p bits to a precision of at most
+	p - 2 bits yields the same result as rounding the exact value, so each number system applies
+	its own rounding rule, round-to-nearest-even for cfloat and fixpnt, and the tapered rounding of
+	the posit, to this intermediate without double rounding errors.
+
+	The digits take one of three paths:
+	  1- Clinger: up to 19 digits with an exponent in [-27, -1] are divided exactly by 5^-q
+	  2- Eisel-Lemire: up to 19 digits are multiplied by a 128-bit truncated power of five, and the
+	     product is accepted when the truncation error can not carry into the significand
+	  3- an exact dragon_bignum quotient or product for the remaining hard cases, and for any
+	     inexact value when the significand is wider than 128 bits
+	128-bit significands run the same fast paths on up to 38 digits with a 192-bit power of five.
+	Inputs with more digits run the fast paths for the leading digits D and for D + 1, and use the
+	result when both agree in the bits that the target rounds. Values that are far outside the scale range of the target
+	are projected to a scale just beyond it, so that the target applies its own overflow and
+	underflow rules.
+*/
+
+namespace sw { namespace universal {
+
+// round-to-odd binary approximation of a parsed decimal: v = (-1)^sign * significand * 2^(scale - (64 * nrWords - 1))
+template<unsigned nrWords>
+struct parsed_decimal {
+	static constexpr unsigned pbits = 64u * nrWords;
+
+	bool          sign;
+	bool          zero;
+	bool          inf;
+	bool          nan;
+	int           scale;                // scale of the most significant bit of the significand
+	std::uint64_t significand[nrWords]; // the msb is bit 63 of significand[nrWords - 1]
+
+	void clear() noexcept {
+		sign = false; zero = false; inf = false; nan = false;
+		scale = 0;
+		for (unsigned i = 0; i < nrWords; ++i) significand[i] = 0;
+	}
+	// bit i of the significand, bits outside the significand are 0
+	bool at(int i) const noexcept {
+		if (i < 0 || i >= static_cast<int>(pbits)) return false;
+		return (significand[i / 64] >> (i % 64)) & 1u;
+	}
+	// true when any bit below position i is set
+	bool any(int i) const noexcept {
+		if (i <= 0) return false;
+		if (i >= static_cast<int>(pbits)) i = static_cast<int>(pbits);
+		unsigned w = static_cast<unsigned>(i) / 64u;
+		unsigned b = static_cast<unsigned>(i) % 64u;
+		for (unsigned j = 0; j < w; ++j) if (significand[j] != 0) return true;
+		return (b > 0 && (significand[w % nrWords] & (0xFFFF'FFFF'FFFF'FFFFull >> (64u - b))) != 0);
+	}
+	// the n <= 64 most significant bits, rounded to odd
+	std::uint64_t bits(unsigned n) const noexcept {
+		std::uint64_t top = significand[nrWords - 1];
+		bool sticky = any(static_cast<int>(pbits) - 64);
+		if (n < 64) {
+			sticky = sticky || (top & (0xFFFF'FFFF'FFFF'FFFFull >> n)) != 0;
+			top >>= (64u - n);
+		}
+		return top | (sticky ? 1u : 0u);
+	}
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 64x64 -> 128 multiply and 128/64 -> 64 divide
+
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef unsigned __int128 decimal_uint128;
+#endif
+
+inline void decimal_mul128(std::uint64_t a, std::uint64_t b, std::uint64_t& hi, std::uint64_t& lo) noexcept {
+#if defined(__SIZEOF_INT128__)
+	decimal_uint128 p = static_cast<decimal_uint128>(a) * b;
+	hi = static_cast<std::uint64_t>(p >> 64);
+	lo = static_cast<std::uint64_t>(p);
+#else
+	std::uint64_t a0 = a & 0xFFFF'FFFFull, a1 = a >> 32;
+	std::uint64_t b0 = b & 0xFFFF'FFFFull, b1 = b >> 32;
+	std::uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+	std::uint64_t mid = (p00 >> 32) + (p01 & 0xFFFF'FFFFull) + (p10 & 0xFFFF'FFFFull);
+	hi = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+	lo = (mid << 32) | (p00 & 0xFFFF'FFFFull);
+#endif
+}
+
+// (hi:lo) / d, precondition: hi < d
+inline std::uint64_t decimal_div128(std::uint64_t hi, std::uint64_t lo, std::uint64_t d, std::uint64_t& remainder) noexcept {
+#if defined(__SIZEOF_INT128__)
+	decimal_uint128 n = (static_cast<decimal_uint128>(hi) << 64) | lo;
+	std::uint64_t q = static_cast<std::uint64_t>(n / d);
+	remainder = static_cast<std::uint64_t>(n - static_cast<decimal_uint128>(q) * d);
+	return q;
+#else
+	// Knuth D with two 32-bit digits, after Hacker's Delight divlu
+	constexpr std::uint64_t b = 1ull << 32;
+	unsigned s = static_cast<unsigned>(std::countl_zero(d));
+	d <<= s;
+	std::uint64_t vn1 = d >> 32, vn0 = d & 0xFFFF'FFFFull;
+	std::uint64_t un32 = (s == 0 ? hi : (hi << s) | (lo >> (64u - s)));
+	std::uint64_t un10 = lo << s;
+	std::uint64_t un1 = un10 >> 32, un0 = un10 & 0xFFFF'FFFFull;
+	std::uint64_t q1 = un32 / vn1, rhat = un32 - q1 * vn1;
+	while (q1 >= b || q1 * vn0 > b * rhat + un1) {
+		--q1; rhat += vn1;
+		if (rhat >= b) break;
+	}
+	std::uint64_t un21 = un32 * b + un1 - q1 * d;
+	std::uint64_t q0 = un21 / vn1;
+	rhat = un21 - q0 * vn1;
+	while (q0 >= b || q0 * vn0 > b * rhat + un0) {
+		--q0; rhat += vn1;
+		if (rhat >= b) break;
+	}
+	remainder = (un21 * b + un0 - q0 * d) >> s;
+	return q1 * b + q0;
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// exact quotients and bit extraction on dragon_bignums
+
+// quotient limbs q[0, m) of num / den, precondition: num < den * 2^(32m), returns true when the remainder is not zero
+template<unsigned nbits>
+bool decimal_divide(dragon_bignum<nbits>& num, dragon_bignum<nbits>& den, std::uint32_t* q, unsigned m) noexcept {
+	// normalize the divisor for the quotient estimate of divmod
+	unsigned shift = den.leading_zeros();
+	num.shift_left(shift);
+	den.shift_left(shift);
+	dragon_bignum<nbits> d;
+	for (unsigned j = m; j-- > 0; ) {
+		d = den;
+		d.shift_left(32u * j);
+		q[j] = num.divmod(d);
+	}
+	return !num.iszero();
+}
+
+// copy the bits [msb - 64 * nrWords + 1, msb] of a into words, returns true when a bit below is set
+template<unsigned nbits>
+bool decimal_extract(const dragon_bignum<nbits>& a, int msb, std::uint64_t* words, unsigned nrWords) noexcept {
+	int available = static_cast<int>(a.size() * 32u);
+	auto bit = [&](int i) -> bool {
+		if (i < 0 || i >= available) return false;
+		return (a.limb(static_cast<unsigned>(i) / 32u) >> (static_cast<unsigned>(i) % 32u)) & 1u;
+	};
+	int lsb = msb - static_cast<int>(64u * nrWords) + 1;
+	for (unsigned w = 0; w < nrWords; ++w) {
+		std::uint64_t word{ 0 };
+		for (int b = 63; b >= 0; --b) {
+			word = (word << 1) | (bit(lsb + static_cast<int>(64u * w) + b) ? 1u : 0u);
+		}
+		words[w] = word;
+	}
+	if (lsb <= 0) return false;
+	unsigned limbs = static_cast<unsigned>(lsb) / 32u;
+	for (unsigned i = 0; i < limbs && i < a.size(); ++i) if (a.limb(i) != 0) return true;
+	for (int i = static_cast<int>(limbs * 32u); i < lsb; ++i) if (bit(i)) return true;
+	return false;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// truncated 192-bit powers of five for the Eisel-Lemire path
+
+// 5^q = (hi:lo) * 2^exponent, with the msb of hi set, truncated when 5^q needs more than 128 bits,
+// and ext holds the next 64 bits of 5^q for the 128-bit significands
+struct decimal_power {
+	std::uint64_t hi;
+	std::uint64_t lo;
+	std::uint64_t ext;
+	int           exponent;
+};
+
+class decimal_power_table {
+public:
+	static constexpr int minExponent = -342;
+	static constexpr int maxExponent = 308;
+	static constexpr int maxExactExponent = 55;      // 5^55 < 2^128
+	static constexpr int maxExactExtExponent = 82;   // 5^82 < 2^192
+
+	decimal_power_table() noexcept {
+		using Bignum = dragon_bignum<1024>;
+		std::uint64_t words[3];
+		Bignum f;
+		f.setvalue(1);
+		for (int q = 0; q <= maxExponent; ++q) {
+			int msb = static_cast<int>(f.bitlength()) - 1;
+			decimal_extract(f, msb, words, 3);
+			_power[q - minExponent] = { words[2], words[1], words[0], msb - 127 };
+			f.mul(5);
+		}
+		// 5^-k = floor(2^(L + 191) / 5^k) * 2^-(L + 191), where L is the bit length of 5^k
+		f.setvalue(1);
+		for (int k = 1; k <= -minExponent; ++k) {
+			f.mul(5);
+			unsigned L = f.bitlength();
+			Bignum num, den(f);
+			num.setvalue(1);
+			num.shift_left(L + 191u);
+			std::uint32_t q[6];
+			decimal_divide(num, den, q, 6);
+			_power[-k - minExponent] = { (std::uint64_t(q[5]) << 32) | q[4], (std::uint64_t(q[3]) << 32) | q[2], (std::uint64_t(q[1]) << 32) | q[0], -static_cast<int>(L) - 127 };
+		}
+	}
+
+	const decimal_power& operator[](int q) const noexcept { return _power[q - minExponent]; }
+
+private:
+	decimal_power _power[maxExponent - minExponent + 1];
+};
+
+inline const decimal_power_table& decimal_powers() noexcept {
+	static const decimal_power_table table;
+	return table;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// the fast paths: D * 10^q for a 64-bit D
+
+// the powers of five below 2^64
+constexpr std::uint64_t decimal_pow5[] = {
+	1ull, 5ull, 25ull, 125ull, 625ull, 3125ull, 15625ull, 78125ull, 390625ull, 1953125ull,
+	9765625ull, 48828125ull, 244140625ull, 1220703125ull, 6103515625ull, 30517578125ull,
+	152587890625ull, 762939453125ull, 3814697265625ull, 19073486328125ull, 95367431640625ull,
+	476837158203125ull, 2384185791015625ull, 11920928955078125ull, 59604644775390625ull,
+	298023223876953125ull, 1490116119384765625ull, 7450580596923828125ull
+};
+
+// truncation of D * 10^q to 64 bits with its msb at bit 63, the scale of that msb, and whether
+// the truncation is inexact, returns false when the fast paths can not decide the truncation
+inline bool decimal_to_binary64(std::uint64_t D, int q, std::uint64_t& bits, int& scale, bool& inexact) noexcept {
+	int lz = std::countl_zero(D);
+	std::uint64_t w = D << lz;
+	if (q < 0 && q >= -27) {
+		// Clinger: w * 2^sh / 5^-q is exact up to its remainder
+		std::uint64_t d = decimal_pow5[-q];
+		int sh = 63 - std::countl_zero(d);  // bit length of d - 1: the quotient is in (w/2, w)
+		std::uint64_t remainder{ 0 };
+		std::uint64_t quotient = decimal_div128(w >> (64 - sh), w << sh, d, remainder);
+		if ((quotient >> 63) == 0) {
+			++sh;
+			quotient = decimal_div128(w >> (64 - sh), w << sh, d, remainder);
+		}
+		bits = quotient;
+		inexact = (remainder != 0);
+		scale = 63 + q - lz - sh;
+		return true;
+	}
+	if (q < decimal_power_table::minExponent || q > decimal_power_table::maxExponent) return false;
+
+	// Eisel-Lemire: w * T is a 192-bit product, and the exact w * 5^q is in [w * T, w * T + w)
+	const decimal_power& T = decimal_powers()[q];
+	std::uint64_t p1hi, p1lo, p2hi, p2lo;
+	decimal_mul128(w, T.lo, p1hi, p1lo);
+	decimal_mul128(w, T.hi, p2hi, p2lo);
+	std::uint64_t mid = p2lo + p1hi;
+	std::uint64_t top = p2hi + (mid < p2lo ? 1u : 0u);
+	std::uint64_t low = p1lo;
+	int msb{ 191 };
+	bool saturatedRemainder{ false };
+	if ((top >> 63) == 0) {
+		top = (top << 1) | (mid >> 63);
+		mid &= 0x7FFF'FFFF'FFFF'FFFFull;
+		saturatedRemainder = (mid == 0x7FFF'FFFF'FFFF'FFFFull);
+		msb = 190;
+	}
+	else {
+		saturatedRemainder = (mid == 0xFFFF'FFFF'FFFF'FFFFull);
+	}
+	if (q >= 0 && q <= decimal_power_table::maxExactExponent) {
+		// T is exact, and so is the product
+		inexact = (mid != 0 || low != 0);
+	}
+	else {
+		// the truncation error of T is below w < 2^64 and can only carry into the top
+		// bits when the remainder is within 2^64 of the next multiple of the lsb
+		if (saturatedRemainder) return false;
+		inexact = true;
+	}
+	bits = top;
+	scale = msb + T.exponent + q - lz;
+	return true;
+}
+
+// truncation of N * 10^q for a 128-bit N = (nh:nl) to 128 bits, bits[1]:bits[0] with the msb at bit 63
+// of bits[1], the scale of that msb, and whether the truncation is inexact, as decimal_to_binary64
+inline bool decimal_to_binary128(std::uint64_t nh, std::uint64_t nl, int q, std::uint64_t* bits, int& scale, bool& inexact) noexcept {
+	int lz = (nh != 0 ? std::countl_zero(nh) : 64 + std::countl_zero(nl));
+	std::uint64_t wh{ nh }, wl{ nl };
+	if (lz >= 64) {
+		wh = nl << (lz - 64);
+		wl = 0;
+	}
+	else if (lz > 0) {
+		wh = (nh << lz) | (nl >> (64 - lz));
+		wl = nl << lz;
+	}
+	if (q < 0 && q >= -27) {
+		// Clinger: the long division of the 192-bit w * 2^sh by 5^-q
+		std::uint64_t d = decimal_pow5[-q];
+		auto divide = [&](int sh, std::uint64_t& remainder) {
+			bits[1] = decimal_div128(wh >> (64 - sh), (wh << sh) | (wl >> (64 - sh)), d, remainder);
+			bits[0] = decimal_div128(remainder, wl << sh, d, remainder);
+		};
+		int sh = 63 - std::countl_zero(d);
+		std::uint64_t remainder{ 0 };
+		divide(sh, remainder);
+		if ((bits[1] >> 63) == 0) divide(++sh, remainder);
+		inexact = (remainder != 0);
+		scale = 127 + q - lz - sh;
+		return true;
+	}
+	if (q < decimal_power_table::minExponent || q > decimal_power_table::maxExponent) return false;
+	if (q < -27 && (nh != 0 || nl >= decimal_pow5[27])) {
+		// N / 5^-q is exact when 5^-q divides N, which the truncated power of five can not tell
+		std::uint64_t h{ nh }, l{ nl }, remainder{ 0 };
+		for (int k = -q; k > 0 && remainder == 0; k -= 27) {
+			std::uint64_t d = decimal_pow5[k < 27 ? k : 27];
+			remainder = h % d;
+			h /= d;
+			l = decimal_div128(remainder, l, d, remainder);
+		}
+		if (remainder == 0) return false;
+	}
+
+	// Eisel-Lemire with the 192-bit power: the exact w * 5^q is in [w * T, w * T + w) of the 320-bit product
+	const decimal_power& T = decimal_powers()[q];
+	std::uint64_t r[5] = { 0, 0, 0, 0, 0 };
+	auto accumulate = [&r](unsigned i, std::uint64_t a, std::uint64_t b) {
+		std::uint64_t hi, lo;
+		decimal_mul128(a, b, hi, lo);
+		r[i] += lo;
+		std::uint64_t carry = (r[i] < lo ? 1u : 0u) + hi;   // hi < 2^64 - 1, so this can not overflow
+		for (unsigned j = i + 1; j < 5 && carry != 0; ++j) {
+			r[j] += carry;
+			carry = (r[j] < carry ? 1u : 0u);
+		}
+	};
+	accumulate(0, wl, T.ext);
+	accumulate(1, wl, T.lo);
+	accumulate(1, wh, T.ext);
+	accumulate(2, wl, T.hi);
+	accumulate(2, wh, T.lo);
+	accumulate(3, wh, T.hi);
+	int msb{ 255 };
+	if ((r[4] >> 63) == 0) {
+		for (unsigned j = 4; j > 0; --j) r[j] = (r[j] << 1) | (r[j - 1] >> 63);
+		r[0] <<= 1;
+		msb = 254;
+	}
+	if (q >= 0 && q <= decimal_power_table::maxExactExtExponent) {
+		// T is exact, and so is the product
+		inexact = (r[2] != 0 || r[1] != 0 || r[0] != 0);
+	}
+	else {
+		// the truncation error of T, below 2w < 2^129 after normalization, can only carry into
+		// the top 128 bits when the 192-bit remainder is within 2^129 of the next multiple of the lsb
+		if (r[2] >= 0xFFFF'FFFF'FFFF'FFFEull) return false;
+		inexact = true;
+	}
+	bits[1] = r[4];
+	bits[0] = r[3];
+	scale = msb + T.exponent + q - lz;
+	return true;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// scanning the decimal
+
+constexpr int decimal_fast_digits = 19;
+
+// decimal mantissa: value = digits * 10^exponent, where exponent is the power of the last significant digit
+struct decimal_scan {
+	const char*   mantissa;      // first character of the mantissa
+	const char*   mantissaEnd;   // one past the last character of the mantissa
+	std::uint64_t leading;       // the first decimal_fast_digits significant digits
+	std::uint64_t trailing;      // the next decimal_fast_digits significant digits
+	int           nrDigits;      // number of significant digits
+	long long     exponent;      // decimal exponent of the last significant digit
+	bool          truncated;     // a nonzero digit beyond the leading digits
+	bool          truncatedWide; // a nonzero digit beyond the trailing digits
+};
+
+inline bool decimal_isdigit(char c) noexcept { return static_cast<unsigned>(c - '0') < 10u; }
+
+// scan [+|-]digits[.digits][(e|E)[+|-]digits], returns first when there is no number
+inline const char* decimal_scan_number(const char* first, const char* last, bool& sign, decimal_scan& s) noexcept {
+	constexpr long long exponentLimit = 1'000'000'000;
+	const char* p = first;
+	sign = false;
+	if (p != last && (*p == '-' || *p == '+')) {
+		sign = (*p == '-');
+		++p;
+	}
+	s.mantissa = p;
+	s.leading = 0;
+	s.trailing = 0;
+	s.nrDigits = 0;
+	s.truncated = false;
+	s.truncatedWide = false;
+	long long exponent{ 0 };
+	bool anyDigit{ false };
+	auto digit = [&s](unsigned d) {
+		if (s.nrDigits < decimal_fast_digits) {
+			s.leading = s.leading * 10u + d;
+		}
+		else {
+			if (s.nrDigits < 2 * decimal_fast_digits) s.trailing = s.trailing * 10u + d; else s.truncatedWide = s.truncatedWide || (d != 0);
+			s.truncated = s.truncated || (d != 0);
+		}
+		++s.nrDigits;
+	};
+	while (p != last && *p == '0') { ++p; anyDigit = true; }
+	while (p != last && decimal_isdigit(*p)) {
+		digit(static_cast<unsigned>(*p - '0'));
+		++p;
+		anyDigit = true;
+	}
+	if (p != last && *p == '.') {
+		++p;
+		if (s.nrDigits == 0) {
+			while (p != last && *p == '0') { ++p; --exponent; anyDigit = true; }
+		}
+		while (p != last && decimal_isdigit(*p)) {
+			digit(static_cast<unsigned>(*p - '0'));
+			++p;
+			--exponent;
+			anyDigit = true;
+		}
+	}
+	if (!anyDigit) return first;
+	s.mantissaEnd = p;
+	if (p != last && (*p == 'e' || *p == 'E')) {
+		const char* e = p + 1;
+		bool negative{ false };
+		if (e != last && (*e == '-' || *e == '+')) {
+			negative = (*e == '-');
+			++e;
+		}
+		if (e != last && decimal_isdigit(*e)) {
+			long long x{ 0 };
+			while (e != last && decimal_isdigit(*e)) {
+				if (x < exponentLimit) x = x * 10 + (*e - '0');
+				++e;
+			}
+			exponent += (negative ? -x : x);
+			p = e;
+		}
+	}
+	s.exponent = exponent;
+	return p;
+}
+
+// case insensitive match of a lower case keyword
+inline const char* decimal_match(const char* first, const char* last, const char* keyword) noexcept {
+	const char* p = first;
+	for (; *keyword != 0; ++keyword, ++p) {
+		if (p == last || (*p | 0x20) != *keyword) return first;
+	}
+	return p;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// the exact path
+
+template<unsigned nrWords, unsigned maxScale>
+void decimal_to_binary_exact(const decimal_scan& s, parsed_decimal<nrWords>& v) noexcept {
+	// digits beyond maxDigits are below the lsb of the significand for any scale in range and only contribute to the sticky bit
+	constexpr unsigned maxDigits = (70u * maxScale) / 100u + 70u;
+	constexpr unsigned capacity = 4u * maxDigits + 2u * maxScale + 64u * nrWords + 256u;
+	using Bignum = dragon_bignum<capacity>;
+
+	Bignum N, chunk;
+	N.setzero();
+	unsigned nrUsed{ 0 };
+	bool tail{ false };
+	std::uint32_t c{ 0 };
+	unsigned chunkDigits{ 0 };
+	bool leadingZeros{ true };
+	for (const char* p = s.mantissa; p != s.mantissaEnd; ++p) {
+		if (*p == '.') continue;
+		unsigned d = static_cast<unsigned>(*p - '0');
+		if (leadingZeros && d == 0) continue;
+		leadingZeros = false;
+		if (nrUsed < maxDigits) {
+			c = c * 10u + d;
+			++nrUsed;
+			if (++chunkDigits == 9) {
+				N.mul(1'000'000'000u);
+				chunk.setvalue(c);
+				N.add(chunk);
+				c = 0;
+				chunkDigits = 0;
+			}
+		}
+		else if (d != 0) {
+			tail = true;
+		}
+	}
+	if (chunkDigits > 0) {
+		N.mul_pow10(chunkDigits);
+		chunk.setvalue(c);
+		N.add(chunk);
+	}
+	long long q = s.exponent + (s.nrDigits - static_cast<long long>(nrUsed));
+
+	bool sticky{ false };
+	if (q >= 0) {
+		N.mul_pow10(static_cast<unsigned>(q));
+		int msb = static_cast<int>(N.bitlength()) - 1;
+		sticky = decimal_extract(N, msb, v.significand, nrWords);
+		v.scale = msb;
+	}
+	else {
+		// Q = N * 2^sh / 10^-q has pbits or pbits + 1 bits
+		constexpr unsigned pbits = 64u * nrWords;
+		constexpr unsigned m = 2u * nrWords + 1u;
+		Bignum S;
+		S.setvalue(1);
+		S.mul_pow10(static_cast<unsigned>(-q));
+		int sh = static_cast<int>(pbits + S.bitlength()) - static_cast<int>(N.bitlength());
+		if (sh >= 0) N.shift_left(static_cast<unsigned>(sh)); else S.shift_left(static_cast<unsigned>(-sh));
+		std::uint32_t limbs[m];
+		sticky = decimal_divide(N, S, limbs, m);
+		dragon_bignum<32u * m> Q;
+		Q.setlimbs(limbs, m);
+		int msb = static_cast<int>(Q.bitlength()) - 1;
+		sticky = decimal_extract(Q, msb, v.significand, nrWords) || sticky;
+		v.scale = msb - sh;
+	}
+	if (sticky || tail) v.significand[0] |= 1u;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// parse_decimal converts the decimal at the start of [first, last) into a round-to-odd
+// significand of 64 * nrWords bits. maxScale bounds the scale range of the target: values
+// beyond 2^(maxScale + 1) and below 2^-(maxScale + 1) are projected to the scale +-(maxScale + 2).
+// precision is the widest significand the target rounds to: the round-to-odd truncation only
+// needs to be exact in the leading precision + 2 bits, which lets more inputs with over 19 digits
+// take the fast paths
+template<unsigned nrWords, unsigned maxScale, unsigned precision = 64u * nrWords - 2u>
+std::from_chars_result parse_decimal(const char* first, const char* last, parsed_decimal<nrWords>& v) noexcept {
+	static_assert(precision + 2u <= 64u * nrWords, "the round-to-odd significand needs two bits more than the target precision");
+	// the leading precision + 2 bits of the fast path significands
+	constexpr unsigned roundToOddBits = precision + 2u;
+	constexpr std::uint64_t hiMask = (roundToOddBits >= 64u ? ~0ull : ~(~0ull >> roundToOddBits));
+	constexpr std::uint64_t loMask = (roundToOddBits <= 64u ? 0ull : (roundToOddBits >= 128u ? ~0ull : ~(~0ull >> (roundToOddBits - 64u))));
+	v.clear();
+	bool sign{ false };
+	decimal_scan s;
+	const char* p = decimal_scan_number(first, last, sign, s);
+	v.sign = sign;
+	if (p == first) {
+		const char* k = first;
+		if (k != last && (*k == '-' || *k == '+')) ++k;
+		const char* e = decimal_match(k, last, "inf");
+		if (e != k) {
+			const char* f = decimal_match(e, last, "inity");
+			v.inf = true;
+			return { f, std::errc{} };
+		}
+		e = decimal_match(k, last, "nan");
+		if (e == k) e = decimal_match(k, last, "nar");
+		if (e != k) {
+			v.nan = true;
+			return { e, std::errc{} };
+		}
+		return { first, std::errc::invalid_argument };
+	}
+	if (s.nrDigits == 0) {
+		v.zero = true;
+		return { p, std::errc{} };
+	}
+
+	// the value is in [10^(m10 - 1), 10^m10), and 3.3219 is just below log2(10)
+	long long m10 = s.nrDigits + s.exponent;
+	if ((m10 - 1) * 33219 > (static_cast<long long>(maxScale) + 1) * 10000) {
+		v.scale = static_cast<int>(maxScale) + 2;
+		v.significand[nrWords - 1] = 0x8000'0000'0000'0000ull;
+		v.significand[0] |= 1u;
+		return { p, std::errc{} };
+	}
+	if (m10 * 33219 < -(static_cast<long long>(maxScale) + 2) * 10000) {
+		v.scale = -static_cast<int>(maxScale) - 2;
+		v.significand[nrWords - 1] = 0x8000'0000'0000'0000ull;
+		v.significand[0] |= 1u;
+		return { p, std::errc{} };
+	}
+
+	int scale{ 0 };
+	bool inexact{ false };
+	if constexpr (nrWords == 2) {
+		// the leading and trailing digits form a 128-bit N
+		int nrWide = (s.nrDigits < 2 * decimal_fast_digits ? s.nrDigits : 2 * decimal_fast_digits);
+		int q = static_cast<int>(s.exponent + (s.nrDigits - nrWide));
+		std::uint64_t nh{ 0 }, nl{ s.leading };
+		if (nrWide > decimal_fast_digits) {
+			unsigned k = static_cast<unsigned>(nrWide - decimal_fast_digits);
+			decimal_mul128(s.leading, decimal_pow5[k] << k, nh, nl);
+			nl += s.trailing;
+			nh += (nl < s.trailing ? 1u : 0u);
+		}
+		std::uint64_t bits[2] = { 0, 0 };
+		bool decided = decimal_to_binary128(nh, nl, q, bits, scale, inexact);
+		if (decided && s.truncatedWide) {
+			// the exact value is in (N * 10^q, (N + 1) * 10^q)
+			std::uint64_t upperBits[2] = { 0, 0 };
+			int upperScale{ 0 };
+			bool upperInexact{ false };
+			decided = decimal_to_binary128(nh + (nl == ~0ull ? 1u : 0u), nl + 1u, q, upperBits, upperScale, upperInexact) && upperScale == scale
+				&& ((upperBits[1] ^ bits[1]) & hiMask) == 0 && ((upperBits[0] ^ bits[0]) & loMask) == 0;
+			bits[1] &= hiMask;
+			bits[0] &= loMask;
+			inexact = true;
+		}
+		if (decided) {
+			v.scale = scale;
+			v.significand[1] = bits[1];
+			v.significand[0] = bits[0] | (inexact ? 1u : 0u);
+			return { p, std::errc{} };
+		}
+	}
+	else {
+		int q = static_cast<int>(s.exponent + (s.nrDigits > decimal_fast_digits ? s.nrDigits - decimal_fast_digits : 0));
+		std::uint64_t bits{ 0 };
+		bool decided = decimal_to_binary64(s.leading, q, bits, scale, inexact);
+		if (decided && s.truncated) {
+			// the exact value is in (D * 10^q, (D + 1) * 10^q)
+			std::uint64_t upperBits{ 0 };
+			int upperScale{ 0 };
+			bool upperInexact{ false };
+			decided = decimal_to_binary64(s.leading + 1u, q, upperBits, upperScale, upperInexact) && upperScale == scale && ((upperBits ^ bits) & hiMask) == 0;
+			bits &= hiMask;
+			inexact = true;
+		}
+		if (decided && (nrWords == 1 || !inexact)) {
+			v.scale = scale;
+			v.significand[nrWords - 1] = bits;
+			if (inexact) v.significand[0] |= 1u;
+			return { p, std::errc{} };
+		}
+	}
+	decimal_to_binary_exact<nrWords, maxScale>(s, v);
+	return { p, std::errc{} };
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// bulk parsing
+
+inline bool decimal_isseparator(char c) noexcept {
+	return (c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v' || c == ',' || c == ';');
+}
+
+// parse a sequence of decimals separated by white space, commas, or semicolons into values[0, n),
+// returns the number of values parsed: parsing stops at the first token that is not a number
+template<typename Real>
+std::size_t parse_array(const char* first, const char* last, Real* values, std::size_t n, const char** end = nullptr) noexcept {
+	std::size_t count{ 0 };
+	const char* p = first;
+	while (count < n) {
+		while (p != last && decimal_isseparator(*p)) ++p;
+		if (p == last) break;
+		std::from_chars_result r;
+		if constexpr (std::is_floating_point_v<Real>) {
+			r = std::from_chars(p, last, values[count]);
+		}
+		else {
+			r = from_chars(p, last, values[count]);
+		}
+		if (r.ec != std::errc{}) break;
+		p = r.ptr;
+		++count;
+	}
+	if (end != nullptr) *end = p;
+	return count;
+}
+
+// append all the decimals in the text to values, returns the number of values appended
+template<typename Real>
+std::size_t parse_array(const std::string& text, std::vector<Real>& values) {
+	const char* p = text.data();
+	const char* last = p + text.size();
+	std::size_t count{ 0 };
+	Real v{};
+	while (parse_array(p, last, &v, 1, &p) == 1) {
+		values.push_back(v);
+		++count;
+	}
+	return count;
+}
+
+}} // namespace sw::universal
@@ -0,0 +1,471 @@
+#pragma once
+// dragon.hpp: exact binary to decimal conversion to print arbitrary binary floating-point and fixed-point values
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <cmath>
+#include <bit>
+#include <charconv>
+#include <string>
+#include <system_error>
+
+/*
+	The digit generator is the free-format algorithm of Steele & White (Dragon4) with the
+	scaling estimate of Burger & Dybvig. A value is presented as an unsigned significand f
+	and the scale of its lsb e, that is, v = f * 2^e, together with the half distances to its
+	two neighbors in the number system, 2^lowerGap and 2^upperGap. Any decimal inside
+	(v - 2^lowerGap, v + 2^upperGap) rounds back to v, and the shortest generator returns the
+	shortest such decimal. When the number system rounds ties to v, for example, round-to-nearest-even
+	for an even significand, the interval is closed and the boundaries are candidates as well.
+	The precision generator returns the correctly rounded decimal with a requested number of
+	significant or fractional digits, rounding ties to even as printf does.
+
+	All arithmetic runs on a fixed-capacity dragon_bignum that lives on the stack. Its capacity
+	is derived from the significand size and the scale range of the number system, and the cost
+	of each operation is proportional to the limbs in use, not to the capacity.
+*/
+
+namespace sw { namespace universal {
+
+// fixed-capacity unsigned integer to hold the scaled values of the digit generator
+template<unsigned nbits>
+class dragon_bignum {
+public:
+	static constexpr unsigned nrLimbs = (nbits + 31u) / 32u;
+
+	dragon_bignum() noexcept : _size{ 0 } {}
+	dragon_bignum(const dragon_bignum& rhs) noexcept { assign(rhs); }
+	dragon_bignum& operator=(const dragon_bignum& rhs) noexcept { assign(rhs); return *this; }
+
+	// modifiers
+	void assign(const dragon_bignum& rhs) noexcept {
+		_size = rhs._size;
+		for (unsigned i = 0; i < _size; ++i) _limb[i] = rhs._limb[i];
+	}
+	void setzero() noexcept { _size = 0; }
+	void setvalue(std::uint32_t v) noexcept {
+		_limb[0] = v;
+		_size = (v == 0 ? 0u : 1u);
+	}
+	void setlimbs(const std::uint32_t* limbs, unsigned n) noexcept {
+		for (unsigned i = 0; i < n; ++i) _limb[i] = limbs[i];
+		_size = n;
+		trim();
+	}
+	void shift_left(unsigned shift) noexcept {
+		if (_size == 0 || shift == 0) return;
+		unsigned limbShift = shift / 32u;
+		unsigned bitShift = shift % 32u;
+		unsigned newSize = _size + limbShift;
+		if (bitShift == 0) {
+			for (unsigned i = _size; i-- > 0; ) _limb[i + limbShift] = _limb[i];
+		}
+		else {
+			std::uint32_t top = _limb[_size - 1] >> (32u - bitShift);
+			for (unsigned i = _size - 1; i > 0; --i) {
+				_limb[i + limbShift] = (_limb[i] << bitShift) | (_limb[i - 1] >> (32u - bitShift));
+			}
+			_limb[limbShift] = _limb[0] << bitShift;
+			if (top != 0) _limb[newSize++] = top;
+		}
+		for (unsigned i = 0; i < limbShift; ++i) _limb[i] = 0;
+		_size = newSize;
+	}
+	void mul(std::uint32_t m) noexcept {
+		std::uint64_t carry{ 0 };
+		for (unsigned i = 0; i < _size; ++i) {
+			std::uint64_t p = std::uint64_t(_limb[i]) * m + carry;
+			_limb[i] = static_cast<std::uint32_t>(p);
+			carry = p >> 32;
+		}
+		if (carry != 0) _limb[_size++] = static_cast<std::uint32_t>(carry);
+	}
+	void mul_pow10(unsigned k) noexcept {
+		constexpr std::uint32_t pow10[] = { 1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u, 10000000u, 100000000u };
+		while (k >= 9) {
+			mul(1000000000u);
+			k -= 9;
+		}
+		if (k > 0) mul(pow10[k]);
+	}
+	void add(const dragon_bignum& rhs) noexcept {
+		unsigned n = (_size > rhs._size ? _size : rhs._size);
+		std::uint64_t carry{ 0 };
+		for (unsigned i = 0; i < n; ++i) {
+			std::uint64_t s = carry + (i < _size ? _limb[i] : 0u) + (i < rhs._size ? rhs._limb[i] : 0u);
+			_limb[i] = static_cast<std::uint32_t>(s);
+			carry = s >> 32;
+		}
+		_size = n;
+		if (carry != 0) _limb[_size++] = static_cast<std::uint32_t>(carry);
+	}
+	// precondition: *this >= rhs
+	void sub(const dragon_bignum& rhs) noexcept {
+		std::uint64_t borrow{ 0 };
+		for (unsigned i = 0; i < _size; ++i) {
+			std::uint64_t d = std::uint64_t(_limb[i]) - (i < rhs._size ? rhs._limb[i] : 0u) - borrow;
+			_limb[i] = static_cast<std::uint32_t>(d);
+			borrow = d >> 63;
+		}
+		trim();
+	}
+	// precondition: *this < 10 * divisor, returns the quotient digit and leaves the remainder
+	std::uint32_t divmod(const dragon_bignum& divisor) noexcept {
+		unsigned n = divisor._size;
+		if (_size < n) return 0;
+		std::uint64_t top = _limb[n - 1];
+		if (_size > n) top |= std::uint64_t(_limb[n]) << 32;
+		std::uint32_t q = static_cast<std::uint32_t>(top / (std::uint64_t(divisor._limb[n - 1]) + 1u));
+		if (q > 0) submul(divisor, q);
+		while (compare(divisor) >= 0) {
+			sub(divisor);
+			++q;
+		}
+		return q;
+	}
+
+	// selectors
+	bool iszero() const noexcept { return _size == 0; }
+	unsigned size() const noexcept { return _size; }
+	std::uint32_t limb(unsigned i) const noexcept { return _limb[i]; }
+	unsigned bitlength() const noexcept {
+		return (_size == 0 ? 0u : 32u * _size - static_cast<unsigned>(std::countl_zero(_limb[_size - 1])));
+	}
+	// number of leading zeros in the most significant limb
+	unsigned leading_zeros() const noexcept {
+		return (_size == 0 ? 0u : static_cast<unsigned>(std::countl_zero(_limb[_size - 1])));
+	}
+	int compare(const dragon_bignum& rhs) const noexcept {
+		if (_size != rhs._size) return (_size < rhs._size ? -1 : 1);
+		for (unsigned i = _size; i-- > 0; ) {
+			if (_limb[i] != rhs._limb[i]) return (_limb[i] < rhs._limb[i] ? -1 : 1);
+		}
+		return 0;
+	}
+
+private:
+	std::uint32_t _limb[nrLimbs + 2];
+	unsigned      _size;   // number of limbs in use, the most significant limb in use is non-zero
+
+	void trim() noexcept {
+		while (_size > 0 && _limb[_size - 1] == 0) --_size;
+	}
+	// *this -= q * rhs, precondition: q * rhs <= *this
+	void submul(const dragon_bignum& rhs, std::uint32_t q) noexcept {
+		std::uint64_t carry{ 0 }, borrow{ 0 };
+		for (unsigned i = 0; i < _size; ++i) {
+			std::uint64_t p = (i < rhs._size ? std::uint64_t(rhs._limb[i]) * q : 0u) + carry;
+			carry = p >> 32;
+			std::uint64_t d = std::uint64_t(_limb[i]) - static_cast<std::uint32_t>(p) - borrow;
+			_limb[i] = static_cast<std::uint32_t>(d);
+			borrow = d >> 63;
+		}
+		trim();
+	}
+};
+
+// digits generated by the dragon: value = 0.d1d2...dn * 10^exponent
+struct dragon_digits {
+	unsigned ndigits;
+	int      exponent;
+};
+
+// dragon digit generator for values with a significand of fhbits bits and scales in [-maxScale, maxScale]
+template<unsigned fhbits, unsigned maxScale>
+class dragon {
+public:
+	// capacity of the scaled values: the significand, the scale range, the 10x digit headroom and the normalization shift
+	static constexpr unsigned capacity = fhbits + maxScale + 128u;
+	// upper bound on the number of significant digits of the exact decimal expansion of any value
+	static constexpr unsigned maxDigits = (31u * fhbits + 70u * maxScale) / 100u + 4u;
+
+	// value = significand * 2^lsbScale, with the rounding interval (value - 2^lowerGap, value + 2^upperGap)
+	dragon(const std::uint32_t* significand, unsigned nrLimbs, int lsbScale, int lowerGap, int upperGap) noexcept {
+		_r.setlimbs(significand, nrLimbs);
+		int binaryExponent = static_cast<int>(_r.bitlength()) - 1 + lsbScale;  // floor(log2(value))
+		int b = lsbScale;
+		if (lowerGap < b) b = lowerGap;
+		if (upperGap < b) b = upperGap;
+		_r.shift_left(static_cast<unsigned>(lsbScale - b));
+		_mplus.setvalue(1);
+		_mplus.shift_left(static_cast<unsigned>(upperGap - b));
+		_mminus.setvalue(1);
+		_mminus.shift_left(static_cast<unsigned>(lowerGap - b));
+		_symmetric = (lowerGap == upperGap);
+		_s.setvalue(1);
+		if (b >= 0) {
+			_r.shift_left(static_cast<unsigned>(b));
+			_mplus.shift_left(static_cast<unsigned>(b));
+			_mminus.shift_left(static_cast<unsigned>(b));
+		}
+		else {
+			_s.shift_left(static_cast<unsigned>(-b));
+		}
+		// estimate of the decimal exponent, never larger than the exponent the generators settle on
+		_k = static_cast<int>(std::floor(binaryExponent * 0.30102999566398114)) + 1;
+		if (_k >= 0) {
+			_s.mul_pow10(static_cast<unsigned>(_k));
+		}
+		else {
+			_r.mul_pow10(static_cast<unsigned>(-_k));
+			_mplus.mul_pow10(static_cast<unsigned>(-_k));
+			_mminus.mul_pow10(static_cast<unsigned>(-_k));
+		}
+	}
+
+	// shortest digit string that rounds back to the value, inclusive selects the closed rounding interval
+	dragon_digits shortest(char* digits, unsigned bufferSize, bool inclusive) noexcept {
+		// establish value + 2^upperGap <= 10^k, or < 10^k for a closed interval
+		for (;;) {
+			_t.assign(_r);
+			_t.add(_mplus);
+			int c = _t.compare(_s);
+			if (c < 0 || (c == 0 && !inclusive)) break;
+			_s.mul(10);
+			++_k;
+		}
+		normalize();
+		unsigned n = 0;
+		while (n < bufferSize) {
+			_r.mul(10);
+			_mplus.mul(10);
+			if (!_symmetric) _mminus.mul(10);
+			std::uint32_t d = _r.divmod(_s);
+			int cl = _r.compare(_symmetric ? _mplus : _mminus);
+			bool low = (cl < 0 || (cl == 0 && inclusive));
+			_t.assign(_r);
+			_t.add(_mplus);
+			int ch = _t.compare(_s);
+			bool high = (ch > 0 || (ch == 0 && inclusive));
+			if (!low && !high) {
+				digits[n++] = static_cast<char>('0' + d);
+				continue;
+			}
+			if (low && high) {
+				_t.assign(_r);
+				_t.add(_r);
+				int c = _t.compare(_s);
+				if (c > 0 || (c == 0 && (d & 1u))) ++d;
+			}
+			else if (high) {
+				++d;
+			}
+			digits[n++] = static_cast<char>('0' + d);
+			break;
+		}
+		return { n, _k };
+	}
+
+	// correctly rounded digits: nrDigits significant digits, or nrDigits fractional digits when fractional is set
+	dragon_digits precision(char* digits, unsigned bufferSize, int nrDigits, bool fractional) noexcept {
+		// establish value < 10^k
+		while (_r.compare(_s) >= 0) {
+			_s.mul(10);
+			++_k;
+		}
+		normalize();
+		int N = (fractional ? _k + nrDigits : nrDigits);
+		if (N < 0) return { 0, _k };
+		unsigned n = 0;
+		while (n < static_cast<unsigned>(N) && n < bufferSize) {
+			_r.mul(10);
+			std::uint32_t d = _r.divmod(_s);
+			digits[n++] = static_cast<char>('0' + d);
+			if (_r.iszero()) return { n, _k };  // exact
+		}
+		// round the remainder to nearest, ties to even
+		_t.assign(_r);
+		_t.add(_r);
+		int c = _t.compare(_s);
+		bool odd = (n > 0 && ((digits[n - 1] - '0') & 1));
+		if (c > 0 || (c == 0 && odd)) {
+			while (n > 0 && digits[n - 1] == '9') --n;
+			if (n == 0) {
+				digits[n++] = '1';
+				++_k;
+			}
+			else {
+				++digits[n - 1];
+			}
+		}
+		return { n, _k };
+	}
+
+private:
+	dragon_bignum<capacity> _r, _s, _mplus, _mminus, _t;
+	int  _k;
+	bool _symmetric;  // equal gaps: the lower gap tracks _mplus
+
+	// shift the scaled values so that the top limb of the divisor is normalized for the quotient estimate
+	void normalize() noexcept {
+		unsigned shift = _s.leading_zeros();
+		_r.shift_left(shift);
+		_s.shift_left(shift);
+		_mplus.shift_left(shift);
+		_mminus.shift_left(shift);
+	}
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// decimal formatting of the generated digits into a caller supplied buffer
+
+class dragon_writer {
+public:
+	dragon_writer(char* first, char* last) noexcept : _p{ first }, _last{ last }, _overflow{ false } {}
+	void put(char c) noexcept {
+		if (_p < _last) *_p++ = c; else _overflow = true;
+	}
+	void put(char c, int count) noexcept {
+		for (int i = 0; i < count; ++i) put(c);
+	}
+	std::to_chars_result result() const noexcept {
+		if (_overflow) return { _last, std::errc::value_too_large };
+		return { _p, std::errc{} };
+	}
+private:
+	char* _p;
+	char* _last;
+	bool  _overflow;
+};
+
+// fixed format with at least minDecimals fractional digits: ddd.ddd
+inline void dragon_write_fixed(dragon_writer& w, const char* digits, int n, int k, int minDecimals) noexcept {
+	if (k <= 0) {
+		w.put('0');
+	}
+	else {
+		for (int i = 0; i < k; ++i) w.put(i < n ? digits[i] : '0');
+	}
+	int decimals = (n - k > minDecimals ? n - k : minDecimals);
+	if (decimals > 0) {
+		w.put('.');
+		for (int j = 0; j < decimals; ++j) {
+			int i = k + j;
+			w.put((i >= 0 && i < n) ? digits[i] : '0');
+		}
+	}
+}
+
+// scientific format with at least minDecimals fractional digits: d.ddde+xx
+inline void dragon_write_scientific(dragon_writer& w, const char* digits, int n, int k, int minDecimals) noexcept {
+	w.put(digits[0]);
+	int decimals = (n - 1 > minDecimals ? n - 1 : minDecimals);
+	if (decimals > 0) {
+		w.put('.');
+		for (int i = 1; i <= decimals; ++i) w.put(i < n ? digits[i] : '0');
+	}
+	int x = k - 1;
+	w.put('e');
+	w.put(x < 0 ? '-' : '+');
+	unsigned ux = static_cast<unsigned>(x < 0 ? -x : x);
+	char exponent[12];
+	int nx = 0;
+	do {
+		exponent[nx++] = static_cast<char>('0' + ux % 10u);
+		ux /= 10u;
+	} while (ux > 0);
+	if (nx < 2) exponent[nx++] = '0';
+	while (nx > 0) w.put(exponent[--nx]);
+}
+
+/// <summary>
+/// convert the value significand * 2^lsbScale to decimal characters in [first, last)
+/// precision < 0 generates the shortest decimal that rounds back to the value, which requires the
+/// rounding interval (value - 2^lowerGap, value + 2^upperGap), which is closed when inclusive is set.
+/// std::chars_format{} and general pick
+/// the shorter of the fixed and scientific forms. precision >= 0 follows printf %f, %e, and %g.
+/// </summary>
+/// <returns>std::to_chars_result with std::errc::value_too_large when the buffer is too small</returns>
+template<unsigned fhbits, unsigned maxScale>
+std::to_chars_result dragon_to_chars(char* first, char* last, bool sign, const std::uint32_t* significand, unsigned nrLimbs, int lsbScale, int lowerGap, int upperGap, bool inclusive, std::chars_format fmt, int precision) noexcept {
+	using Dragon = dragon<fhbits, maxScale>;
+	if (fmt == std::chars_format::hex) return { last, std::errc::invalid_argument };
+
+	dragon_writer w(first, last);
+	if (sign) w.put('-');
+
+	bool iszero = true;
+	for (unsigned i = 0; i < nrLimbs; ++i) if (significand[i] != 0) iszero = false;
+
+	char digits[Dragon::maxDigits];
+	dragon_digits d{ 0, 1 };
+	bool shortest = (precision < 0);
+	if (!iszero) {
+		Dragon generator(significand, nrLimbs, lsbScale, lowerGap, upperGap);
+		if (shortest) {
+			d = generator.shortest(digits, Dragon::maxDigits, inclusive);
+		}
+		else if (fmt == std::chars_format::fixed) {
+			d = generator.precision(digits, Dragon::maxDigits, precision, true);
+		}
+		else if (fmt == std::chars_format::scientific) {
+			d = generator.precision(digits, Dragon::maxDigits, precision + 1, false);
+		}
+		else {
+			d = generator.precision(digits, Dragon::maxDigits, (precision == 0 ? 1 : precision), false);
+		}
+	}
+	if (d.ndigits == 0) {
+		// zero, or a value that rounds to zero in fixed format
+		digits[0] = '0';
+		d = { 1, 1 };
+	}
+	int n = static_cast<int>(d.ndigits);
+	int k = d.exponent;
+
+	if (!shortest && fmt != std::chars_format::general) {
+		if (fmt == std::chars_format::fixed) {
+			dragon_write_fixed(w, digits, n, k, precision);
+		}
+		else {
+			dragon_write_scientific(w, digits, n, k, precision);
+		}
+		return w.result();
+	}
+
+	while (n > 1 && digits[n - 1] == '0') --n;
+	bool useFixed{ false };
+	if (shortest && fmt == std::chars_format::fixed) {
+		useFixed = true;
+	}
+	else if (shortest && fmt == std::chars_format::scientific) {
+		useFixed = false;
+	}
+	else if (shortest) {
+		int fixedLength = (k <= 0 ? n + 2 - k : (k >= n ? k : n + 1));
+		int x = (k - 1 < 0 ? 1 - k : k - 1);
+		int scientificLength = n + (n > 1 ? 1 : 0) + 2 + (x >= 100 ? (x >= 1000 ? 4 : 3) : 2);
+		useFixed = (fixedLength <= scientificLength);
+	}
+	else {
+		// printf %g: fixed when the decimal exponent X satisfies P > X >= -4
+		int P = (precision == 0 ? 1 : precision);
+		int X = k - 1;
+		useFixed = (P > X && X >= -4);
+	}
+	if (useFixed) {
+		dragon_write_fixed(w, digits, n, k, 0);
+	}
+	else {
+		dragon_write_scientific(w, digits, n, k, 0);
+	}
+	return w.result();
+}
+
+// collect the output of a to_chars conversion in a string: a small stack buffer covers
+// the common case, and the conversion is repeated into a buffer of maxLength when it does not fit
+template<typename ToChars>
+std::string dragon_to_string(ToChars&& convert, std::size_t maxLength) {
+	char buffer[128];
+	std::to_chars_result r = convert(buffer, buffer + sizeof(buffer));
+	if (r.ec == std::errc{}) return std::string(buffer, r.ptr);
+	std::string s(maxLength, '\0');
+	r = convert(s.data(), s.data() + s.size());
+	s.resize(static_cast<std::size_t>(r.ptr - s.data()));
+	return s;
+}
+
+}} // namespace sw::universal
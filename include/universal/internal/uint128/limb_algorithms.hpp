@@ -0,0 +1,281 @@
+#pragma once
+// limb_algorithms.hpp: multi-limb add, subtract, Karatsuba multiply, and Knuth algorithm D division
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <bit>
+#include <universal/internal/uint128/limbs.hpp>
+
+/*
+   Operations on little-endian limb vectors, the storage layout of integer and blockbinary.
+   The caller owns all memory: the multiplication and division algorithms take a scratch
+   vector whose size is given by the matching _scratch() function, so that fixed-size
+   number types can size it at compile time and stay allocation free.
+   Result vectors must not alias the operands unless stated otherwise.
+*/
+
+namespace sw { namespace universal {
+
+// below this many limbs the O(n^2) schoolbook product is faster than the Karatsuba recursion
+constexpr unsigned limb_karatsuba_threshold = 32;
+
+// three-way comparison of a[0,n) and b[0,n): -1, 0, or 1
+template<typename bt>
+constexpr int limb_cmp(const bt* a, const bt* b, unsigned n) noexcept {
+	for (unsigned i = n; i-- > 0;) {
+		if (a[i] != b[i]) return (a[i] < b[i] ? -1 : 1);
+	}
+	return 0;
+}
+
+// r[0,n) = a[0,n) + b[0,n), returns the carry out; r may alias a or b
+template<typename bt>
+constexpr bt limb_add_n(bt* r, const bt* a, const bt* b, unsigned n) noexcept {
+	bt carry{ 0 };
+	for (unsigned i = 0; i < n; ++i) r[i] = limb_addc(a[i], b[i], carry);
+	return carry;
+}
+
+// r[0,n) = a[0,n) - b[0,n), returns the borrow out; r may alias a or b
+template<typename bt>
+constexpr bt limb_sub_n(bt* r, const bt* a, const bt* b, unsigned n) noexcept {
+	bt borrow{ 0 };
+	for (unsigned i = 0; i < n; ++i) r[i] = limb_subb(a[i], b[i], borrow);
+	return borrow;
+}
+
+// r[0,n) += c, returns the carry out
+template<typename bt>
+constexpr bt limb_add_1(bt* r, unsigned n, bt c) noexcept {
+	for (unsigned i = 0; i < n && c != 0; ++i) {
+		r[i] = static_cast<bt>(r[i] + c);
+		c = static_cast<bt>(r[i] < c);
+	}
+	return c;
+}
+
+// r[0,n) -= c, returns the borrow out
+template<typename bt>
+constexpr bt limb_sub_1(bt* r, unsigned n, bt c) noexcept {
+	for (unsigned i = 0; i < n && c != 0; ++i) {
+		bt t = r[i];
+		r[i] = static_cast<bt>(t - c);
+		c = static_cast<bt>(t < c);
+	}
+	return c;
+}
+
+// r[0,na+nb) = a[0,na) * b[0,nb)
+template<typename bt>
+constexpr void limb_mul_basecase(bt* r, const bt* a, unsigned na, const bt* b, unsigned nb) noexcept {
+	for (unsigned i = 0; i < na + nb; ++i) r[i] = 0;
+	for (unsigned i = 0; i < na; ++i) {
+		bt carry{ 0 };
+		for (unsigned j = 0; j < nb; ++j) r[i + j] = limb_muladd(a[i], b[j], r[i + j], carry);
+		r[i + nb] = carry;
+	}
+}
+
+// r[0,n) = a[0,n) * b[0,n) mod B^n
+template<typename bt>
+constexpr void limb_mullo_basecase(bt* r, const bt* a, const bt* b, unsigned n) noexcept {
+	for (unsigned i = 0; i < n; ++i) r[i] = 0;
+	for (unsigned i = 0; i < n; ++i) {
+		bt carry{ 0 };
+		for (unsigned j = 0; i + j < n; ++j) r[i + j] = limb_muladd(a[i], b[j], r[i + j], carry);
+	}
+}
+
+// number of scratch limbs limb_mul_karatsuba needs for an n x n product
+constexpr unsigned limb_karatsuba_scratch(unsigned n) noexcept {
+	if (n < limb_karatsuba_threshold) return 0;
+	unsigned l = n - n / 2;
+	return 4 * (l + 1) + limb_karatsuba_scratch(l + 1);
+}
+
+// r[0,2n) = a[0,n) * b[0,n)
+// with a = a0 + a1 B^l and b = b0 + b1 B^l: a*b = z0 + (z1 - z0 - z2) B^l + z2 B^2l,
+// where z0 = a0*b0, z2 = a1*b1 and z1 = (a0 + a1)(b0 + b1)
+template<typename bt>
+constexpr void limb_mul_karatsuba(bt* r, const bt* a, const bt* b, unsigned n, bt* scratch) noexcept {
+	if (n < limb_karatsuba_threshold) {
+		limb_mul_basecase(r, a, n, b, n);
+		return;
+	}
+	unsigned h = n / 2;     // limbs in the upper halves a1 and b1
+	unsigned l = n - h;     // limbs in the lower halves a0 and b0, l >= h
+	bt* sa = scratch;       // l+1 limbs
+	bt* sb = sa + (l + 1);  // l+1 limbs
+	bt* z1 = sb + (l + 1);  // 2l+2 limbs
+	bt* next = z1 + 2 * (l + 1);
+
+	limb_mul_karatsuba(r, a, b, l, next);                   // z0 in r[0,2l)
+	limb_mul_karatsuba(r + 2 * l, a + l, b + l, h, next);   // z2 in r[2l,2n)
+
+	// sa = a0 + a1 and sb = b0 + b1, l+1 limbs each
+	bt ca = limb_add_n(sa, a, a + l, h);
+	bt cb = limb_add_n(sb, b, b + l, h);
+	if (l > h) {
+		sa[h] = limb_addc(a[h], bt(0), ca);
+		sb[h] = limb_addc(b[h], bt(0), cb);
+	}
+	sa[l] = ca;
+	sb[l] = cb;
+	limb_mul_karatsuba(z1, sa, sb, l + 1, next);
+
+	unsigned nz = 2 * (l + 1);
+	limb_sub_1(z1 + 2 * l, nz - 2 * l, limb_sub_n(z1, z1, r, 2 * l));
+	limb_sub_1(z1 + 2 * h, nz - 2 * h, limb_sub_n(z1, z1, r + 2 * l, 2 * h));
+
+	// z1 = a0*b1 + a1*b0 < 2 B^n, so only the limbs that land inside r[0,2n) can be non-zero
+	unsigned m = (nz < 2 * n - l ? nz : 2 * n - l);
+	limb_add_1(r + l + m, 2 * n - l - m, limb_add_n(r + l, r + l, z1, m));
+}
+
+// number of scratch limbs limb_mullo_karatsuba needs for an n x n low product
+constexpr unsigned limb_mullo_karatsuba_scratch(unsigned n) noexcept {
+	if (n < limb_karatsuba_threshold) return 0;
+	unsigned h = n - n / 2;
+	unsigned k = n / 2;
+	unsigned full = limb_karatsuba_scratch(h);
+	unsigned low  = k + limb_mullo_karatsuba_scratch(k);
+	return 2 * h + (full > low ? full : low);
+}
+
+// r[0,n) = a[0,n) * b[0,n) mod B^n
+// with a = a0 + a1 B^h: a*b mod B^n = a0*b0 + (a0*b1 + a1*b0 mod B^k) B^h, where k = n - h
+template<typename bt>
+constexpr void limb_mullo_karatsuba(bt* r, const bt* a, const bt* b, unsigned n, bt* scratch) noexcept {
+	if (n < limb_karatsuba_threshold) {
+		limb_mullo_basecase(r, a, b, n);
+		return;
+	}
+	unsigned h = n - n / 2;  // limbs in a0 and b0
+	unsigned k = n / 2;      // limbs in a1 and b1, k <= h
+	bt* z0 = scratch;        // 2h limbs
+	bt* next = z0 + 2 * h;
+
+	limb_mul_karatsuba(z0, a, b, h, next);
+	for (unsigned i = 0; i < n; ++i) r[i] = z0[i];
+
+	bt* t = next;            // k limbs
+	limb_mullo_karatsuba(t, a, b + h, k, t + k);
+	limb_add_n(r + h, r + h, t, k);
+	limb_mullo_karatsuba(t, a + h, b, k, t + k);
+	limb_add_n(r + h, r + h, t, k);
+}
+
+// r[0,2n) = a[0,n) * b[0,n) for n <= maxLimbs: the Karatsuba recursion and its scratch are only compiled in
+// when maxLimbs reaches the threshold
+template<unsigned maxLimbs, typename bt>
+constexpr void limb_mul_n(bt* r, const bt* a, const bt* b, unsigned n) noexcept {
+	if constexpr (maxLimbs < limb_karatsuba_threshold) {
+		limb_mul_basecase(r, a, n, b, n);
+	}
+	else {
+		bt scratch[limb_karatsuba_scratch(maxLimbs)];
+		limb_mul_karatsuba(r, a, b, n, scratch);
+	}
+}
+
+// r[0,n) = a[0,n) * b[0,n) mod B^n for n <= maxLimbs
+template<unsigned maxLimbs, typename bt>
+constexpr void limb_mullo_n(bt* r, const bt* a, const bt* b, unsigned n) noexcept {
+	if constexpr (maxLimbs < limb_karatsuba_threshold) {
+		limb_mullo_basecase(r, a, b, n);
+	}
+	else {
+		bt scratch[limb_mullo_karatsuba_scratch(maxLimbs)];
+		limb_mullo_karatsuba(r, a, b, n, scratch);
+	}
+}
+
+// number of scratch limbs limb_divmod needs to divide an m limb dividend by an n limb divisor
+constexpr unsigned limb_divmod_scratch(unsigned m, unsigned n) noexcept {
+	return m + 1 + n;
+}
+
+// Knuth, TAOCP Vol 2, 4.3.1, Algorithm D
+// q[0,m-n+1) = u[0,m) / v[0,n) and r[0,n) = u[0,m) % v[0,n), precondition: m >= n and v[n-1] != 0
+template<typename bt>
+constexpr void limb_divmod(bt* q, bt* r, const bt* u, unsigned m, const bt* v, unsigned n, bt* scratch) noexcept {
+	constexpr unsigned bitsInBlock = sizeof(bt) * 8;
+	if (n == 1) {
+		bt rem{ 0 };
+		for (unsigned i = m; i-- > 0;) q[i] = limb_div(rem, u[i], v[0], rem);
+		r[0] = rem;
+		return;
+	}
+
+	// D1: normalize so that the most significant bit of the divisor is set
+	unsigned s = static_cast<unsigned>(std::countl_zero(v[n - 1]));
+	bt* un = scratch;       // m+1 limbs
+	bt* vn = un + (m + 1);  // n limbs
+	if (s > 0) {
+		for (unsigned i = n - 1; i > 0; --i) vn[i] = static_cast<bt>((v[i] << s) | (v[i - 1] >> (bitsInBlock - s)));
+		vn[0] = static_cast<bt>(v[0] << s);
+		un[m] = static_cast<bt>(u[m - 1] >> (bitsInBlock - s));
+		for (unsigned i = m - 1; i > 0; --i) un[i] = static_cast<bt>((u[i] << s) | (u[i - 1] >> (bitsInBlock - s)));
+		un[0] = static_cast<bt>(u[0] << s);
+	}
+	else {
+		for (unsigned i = 0; i < n; ++i) vn[i] = v[i];
+		for (unsigned i = 0; i < m; ++i) un[i] = u[i];
+		un[m] = 0;
+	}
+
+	for (unsigned j = m - n + 1; j-- > 0;) {
+		// D3: estimate qhat from the top two limbs of the remainder and the top limb of the divisor,
+		// and refine with the second limb of the divisor: qhat is then at most one too large
+		bt qhat{ 0 }, rhat{ 0 };
+		bool rhatOverflow = false;
+		if (un[j + n] >= vn[n - 1]) {
+			// un[j+n] == vn[n-1]: the quotient limb is B-1 or B-2
+			qhat = static_cast<bt>(~bt(0));
+			bt c{ 0 };
+			rhat = limb_addc(un[j + n - 1], vn[n - 1], c);
+			rhatOverflow = (c != 0);
+		}
+		else {
+			qhat = limb_div(un[j + n], un[j + n - 1], vn[n - 1], rhat);
+		}
+		while (!rhatOverflow) {
+			bt phi{ 0 }, plo{ 0 };
+			limb_mul(qhat, vn[n - 2], phi, plo);
+			if (phi < rhat || (phi == rhat && plo <= un[j + n - 2])) break;
+			--qhat;
+			bt c{ 0 };
+			rhat = limb_addc(rhat, vn[n - 1], c);
+			rhatOverflow = (c != 0);
+		}
+
+		// D4: multiply and subtract
+		bt carry{ 0 }, borrow{ 0 };
+		for (unsigned i = 0; i < n; ++i) {
+			bt p = limb_muladd(qhat, vn[i], bt(0), carry);
+			un[i + j] = limb_subb(un[i + j], p, borrow);
+		}
+		un[j + n] = limb_subb(un[j + n], carry, borrow);
+
+		// D5/D6: the estimate was one too large, add back
+		if (borrow != 0) {
+			--qhat;
+			bt c = limb_add_n(un + j, un + j, vn, n);
+			un[j + n] = static_cast<bt>(un[j + n] + c);
+		}
+		q[j] = qhat;
+	}
+
+	// D8: unnormalize the remainder
+	if (s > 0) {
+		for (unsigned i = 0; i < n - 1; ++i) r[i] = static_cast<bt>((un[i] >> s) | (un[i + 1] << (bitsInBlock - s)));
+		r[n - 1] = static_cast<bt>(un[n - 1] >> s);
+	}
+	else {
+		for (unsigned i = 0; i < n; ++i) r[i] = un[i];
+	}
+}
+
+}} // namespace sw::universal
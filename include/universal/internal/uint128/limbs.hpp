@@ -0,0 +1,163 @@
+#pragma once
+// limbs.hpp: carry propagating add/subtract and widening multiply on a single limb of a block-based number
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <bit>
+#include <cstdint>
+#include <type_traits>
+#if defined(_MSC_VER) && defined(_M_X64) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+/*
+   The block-based number systems, blockbinary, blocksignificant, blockfraction and integer,
+   compose their arithmetic out of limbs of type uint8_t, uint16_t, uint32_t, or uint64_t.
+   For limbs narrower than 64 bits, the carry and the upper half of a product fit in a uint64_t
+   accumulator. A uint64_t limb needs a 128-bit product and an explicit carry out of the sum:
+   the primitives below use unsigned __int128 or _umul128 when available, and fall back to
+   a 32x32 decomposition otherwise. The sums are written so that gcc and clang emit adc/sbb.
+*/
+
+namespace sw { namespace universal {
+
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef unsigned __int128 limb_uint128;
+#endif
+
+// sum = a + b + carry, carry in and out are 0 or 1
+template<typename bt>
+constexpr bt limb_addc(bt a, bt b, bt& carry) noexcept {
+	static_assert(std::is_unsigned_v<bt>, "limb type must be an unsigned integer");
+	if constexpr (sizeof(bt) < sizeof(std::uint64_t)) {
+		std::uint64_t s = static_cast<std::uint64_t>(a) + static_cast<std::uint64_t>(b) + static_cast<std::uint64_t>(carry);
+		carry = static_cast<bt>(s >> (sizeof(bt) * 8));
+		return static_cast<bt>(s);
+	}
+	else {
+		bt s = static_cast<bt>(a + b);
+		bt c = static_cast<bt>(s < a);
+		bt t = static_cast<bt>(s + carry);
+		carry = static_cast<bt>(c | static_cast<bt>(t < s));
+		return t;
+	}
+}
+
+// difference = a - b - borrow, borrow in and out are 0 or 1
+template<typename bt>
+constexpr bt limb_subb(bt a, bt b, bt& borrow) noexcept {
+	static_assert(std::is_unsigned_v<bt>, "limb type must be an unsigned integer");
+	bt d = static_cast<bt>(a - b);
+	bt c = static_cast<bt>(a < b);
+	bt t = static_cast<bt>(d - borrow);
+	borrow = static_cast<bt>(c | static_cast<bt>(d < borrow));
+	return t;
+}
+
+// widening multiply: hi:lo = a * b
+template<typename bt>
+constexpr void limb_mul(bt a, bt b, bt& hi, bt& lo) noexcept {
+	static_assert(std::is_unsigned_v<bt>, "limb type must be an unsigned integer");
+	if constexpr (sizeof(bt) < sizeof(std::uint64_t)) {
+		std::uint64_t p = static_cast<std::uint64_t>(a) * static_cast<std::uint64_t>(b);
+		hi = static_cast<bt>(p >> (sizeof(bt) * 8));
+		lo = static_cast<bt>(p);
+	}
+	else {
+#if defined(__SIZEOF_INT128__)
+		limb_uint128 p = static_cast<limb_uint128>(a) * b;
+		hi = static_cast<bt>(p >> 64);
+		lo = static_cast<bt>(p);
+#else
+#if defined(_MSC_VER) && defined(_M_X64) && !defined(__clang__)
+		if (!std::is_constant_evaluated()) {
+			unsigned long long h{ 0 };
+			lo = static_cast<bt>(_umul128(a, b, &h));
+			hi = static_cast<bt>(h);
+			return;
+		}
+#endif
+		std::uint64_t a0 = a & 0xFFFF'FFFFull, a1 = a >> 32;
+		std::uint64_t b0 = b & 0xFFFF'FFFFull, b1 = b >> 32;
+		std::uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+		std::uint64_t mid = (p00 >> 32) + (p01 & 0xFFFF'FFFFull) + (p10 & 0xFFFF'FFFFull);
+		hi = static_cast<bt>(p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32));
+		lo = static_cast<bt>((mid << 32) | (p00 & 0xFFFF'FFFFull));
+#endif
+	}
+}
+
+// multiply-accumulate step of the schoolbook product: returns the low limb of a * b + addend + carry,
+// and leaves the high limb in carry. The result can't overflow: (B-1)^2 + 2(B-1) = B^2 - 1
+template<typename bt>
+constexpr bt limb_muladd(bt a, bt b, bt addend, bt& carry) noexcept {
+	if constexpr (sizeof(bt) < sizeof(std::uint64_t)) {
+		std::uint64_t p = static_cast<std::uint64_t>(a) * static_cast<std::uint64_t>(b) + static_cast<std::uint64_t>(addend) + static_cast<std::uint64_t>(carry);
+		carry = static_cast<bt>(p >> (sizeof(bt) * 8));
+		return static_cast<bt>(p);
+	}
+	else {
+#if defined(__SIZEOF_INT128__)
+		limb_uint128 p = static_cast<limb_uint128>(a) * b + addend + carry;
+		carry = static_cast<bt>(p >> 64);
+		return static_cast<bt>(p);
+#else
+		bt hi{ 0 }, lo{ 0 };
+		limb_mul(a, b, hi, lo);
+		bt c{ 0 };
+		lo = limb_addc(lo, addend, c);
+		hi = static_cast<bt>(hi + c);
+		c = 0;
+		lo = limb_addc(lo, carry, c);
+		carry = static_cast<bt>(hi + c);
+		return lo;
+#endif
+	}
+}
+
+// (hi:lo) / d, returns the quotient limb and leaves the remainder in remainder, precondition: hi < d
+template<typename bt>
+constexpr bt limb_div(bt hi, bt lo, bt d, bt& remainder) noexcept {
+	static_assert(std::is_unsigned_v<bt>, "limb type must be an unsigned integer");
+	if constexpr (sizeof(bt) < sizeof(std::uint64_t)) {
+		std::uint64_t n = (static_cast<std::uint64_t>(hi) << (sizeof(bt) * 8)) | static_cast<std::uint64_t>(lo);
+		std::uint64_t q = n / d;
+		remainder = static_cast<bt>(n - q * d);
+		return static_cast<bt>(q);
+	}
+	else {
+#if defined(__SIZEOF_INT128__)
+		limb_uint128 n = (static_cast<limb_uint128>(hi) << 64) | lo;
+		bt q = static_cast<bt>(n / d);
+		remainder = static_cast<bt>(lo - q * d);
+		return q;
+#else
+		// two 32-bit digit steps of Knuth's algorithm D, after Hacker's Delight divlu
+		constexpr std::uint64_t b = 1ull << 32;
+		unsigned s = static_cast<unsigned>(std::countl_zero(d));
+		d <<= s;
+		std::uint64_t vn1 = d >> 32, vn0 = d & 0xFFFF'FFFFull;
+		std::uint64_t un32 = (s == 0 ? hi : (hi << s) | (lo >> (64u - s)));
+		std::uint64_t un10 = lo << s;
+		std::uint64_t un1 = un10 >> 32, un0 = un10 & 0xFFFF'FFFFull;
+		std::uint64_t q1 = un32 / vn1, rhat = un32 - q1 * vn1;
+		while (q1 >= b || q1 * vn0 > b * rhat + un1) {
+			--q1; rhat += vn1;
+			if (rhat >= b) break;
+		}
+		std::uint64_t un21 = un32 * b + un1 - q1 * d;
+		std::uint64_t q0 = un21 / vn1;
+		rhat = un21 - q0 * vn1;
+		while (q0 >= b || q0 * vn0 > b * rhat + un0) {
+			--q0; rhat += vn1;
+			if (rhat >= b) break;
+		}
+		remainder = (un21 * b + un0 - q0 * d) >> s;
+		return static_cast<bt>(q1 * b + q0);
+#endif
+	}
+}
+
+}} // namespace sw::universal
@@ -5,12 +5,14 @@
 // SPDX-License-Identifier: MIT
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/traits/fma_traits.hpp>
 
 namespace sw { namespace universal {
 
     /// <summary>
     /// polyeval evaluates a given n-th degree polynomial at x using Horner's rule.
     /// The polynomial is given by the array of (n+1) coefficients.
+    /// Number systems with a fused multiply-add round once per step instead of twice.
     /// </summary>
     /// <param name="c">polynomial coefficients</param>
     /// <param name="n">portion of the polynomial to evaluate</param>
@@ -23,8 +25,13 @@ namespace sw { namespace universal {
         Scalar r{ coefficients[n] };
 
         for (int i = n - 1; i >= 0; --i) {
-            r *= x;
-            r += coefficients[i];
+            if constexpr (has_fma<Scalar>) {
+                r = fma(r, x, Scalar(coefficients[i]));
+            }
+            else {
+                r *= x;
+                r += coefficients[i];
+            }
         }
 
         return r;
@@ -46,9 +46,9 @@
 
 ////////////////////////////////////////////////////////////////////////////////////////
 // enable native sqrt implementation
-// 
+// the native sqrt is correctly rounded for all precisions, set to 0 to marshal through double
 #if !defined(CFLOAT_NATIVE_SQRT)
-#define CFLOAT_NATIVE_SQRT 0
+#define CFLOAT_NATIVE_SQRT 1
 #endif
 
 ///////////////////////////////////////////////////////////////////////////////////////
@@ -34,7 +34,11 @@
 // composition types used by cfloat
 #include <universal/internal/blockbinary/blockbinary.hpp>
 #include <universal/internal/blocktriple/blocktriple.hpp>
+#include <universal/traits/fma_traits.hpp>
+#include <universal/number/shared/encoding_table.hpp>
 #include <universal/number/support/decimal.hpp>
+#include <universal/internal/f2s/dragon.hpp>
+#include <universal/internal/f2s/decimal_parse.hpp>
 
 #ifndef CFLOAT_THROW_ARITHMETIC_EXCEPTION
 #define CFLOAT_THROW_ARITHMETIC_EXCEPTION 0
@@ -116,6 +120,9 @@ template<unsigned srcbits, BlockTripleOperator op, unsigned nbits, unsigned es,
 inline /*constexpr*/ void convert(const blocktriple<srcbits, op, bt>& src, cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>& tgt) {
 	using btType = blocktriple<srcbits, op, bt>;
 	using cfloatType = cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>;
+	// a blocktriple that carries more fraction bits than the cfloat, such as the sum of a fused multiply-add,
+	// rounds at the lsb of the cfloat fraction
+	constexpr int widthAdjustment = (srcbits > cfloatType::fbits ? static_cast<int>(srcbits - cfloatType::fbits) : 0);
 	// test special cases
 	if (src.isnan()) {
 		tgt.setnan(src.sign() ? NAN_TYPE_SIGNALLING : NAN_TYPE_QUIET);
@@ -139,7 +146,7 @@ inline /*constexpr*/ void convert(const blocktriple<srcbits, op, bt>& src, cfloa
 				tgt.setzero();
 				if (exponent == (cfloatType::MIN_EXP_SUBNORMAL - 1)) {
 					// -exponent because we are right shifting and exponent in this range is negative
-					int adjustment = -(exponent + subnormal_reciprocal_shift[es]);
+					int adjustment = widthAdjustment - (exponent + subnormal_reciprocal_shift[es]);
 					std::pair<bool, unsigned> alignment = src.roundingDecision(adjustment);
 					if (alignment.first) ++tgt; // we are minpos
 				}
@@ -189,7 +196,7 @@ inline /*constexpr*/ void convert(const blocktriple<srcbits, op, bt>& src, cfloa
 		// tgt.clear();  // no need as all bits are going to be set by the code below
 
 		// exponent construction
-		int adjustment{ 0 };
+		int adjustment{ widthAdjustment };
 		// construct exponent
 		uint64_t biasedExponent = static_cast<uint64_t>(static_cast<long long>(exponent) + static_cast<long long>(cfloatType::EXP_BIAS)); // this is guaranteed to be positive if exponent in encoding range
 //			std::cout << "exponent         " << to_binary(biasedExponent) << '\n';	
@@ -199,7 +206,7 @@ inline /*constexpr*/ void convert(const blocktriple<srcbits, op, bt>& src, cfloa
 				// the value is in the subnormal range of the cfloat
 				biasedExponent = 0;
 				// -exponent because we are right shifting and exponent in this range is negative
-				adjustment = -(exponent + subnormal_reciprocal_shift[es]);
+				adjustment = widthAdjustment - (exponent + subnormal_reciprocal_shift[es]);
 				// this is the right shift adjustment required for subnormal representation due 
 				// to the scale of the input number, i.e. the exponent of 2^-adjustment
 			}
@@ -251,8 +258,10 @@ inline /*constexpr*/ void convert(const blocktriple<srcbits, op, bt>& src, cfloa
 			//std::cout << "raw bits (final) " << to_binary(raw) << '\n';
 			tgt.setbits(raw);
 //			std::cout << "raw bits (all)   " << to_binary(raw) << '\n';
+			// without supernormals, the binade with an all-ones exponent only encodes inf and nan
+			bool overflow = (hasSupernormals ? tgt.isnan() : tgt.issupernormal());
 			if constexpr (isSaturating) {
-				if (tgt.isnan()) {
+				if (overflow) {
 					if (src.sign()) {
 						tgt.maxneg();	// map back to maxneg
 					}
@@ -264,34 +273,45 @@ inline /*constexpr*/ void convert(const blocktriple<srcbits, op, bt>& src, cfloa
 			else {
 				// when you get too far, map it back to +-inf: 
 				// TBD: this doesn't appear to be the right algorithm to catch all overflow patterns
-				if (tgt.isnan()) tgt.setinf(src.sign());	// map back to +-inf
+				if (overflow) tgt.setinf(src.sign());	// map back to +-inf
 			}
 		}
 		else {
-			// compose the segments
-			auto fracbits = src.significant();  // why significant? cheesy optimization: we are going to overwrite the hidden bit position anyway when we write the exponent below, so no need to pay the overhead of generating the fraction here.
-			//std::cout << "fraction      : " << to_binary(fracbits, true) << '\n';
-			fracbits >>= static_cast<int>(rightShift);
-			//std::cout << "aligned fbits : " << to_binary(fracbits, true) << '\n';
-
-			// copy the blocks that contain fraction bits
-			// significant blocks are organized like this:
+			// alignment and rounding fused with the assembly of the encoding: the fraction bits are
+			// read straight out of the significant at the lsb of the target, and the rounding increment
+			// is applied to the encoding, where a carry out of the fraction moves a subnormal to minpos
+			// normal, or a normal to the next binade, without a copy of the significant
 			//   ADD        iii.ffffrrrrrrrrr          3 integer bits, f fraction bits, and 2*fhbits rounding bits
 			//   MUL         ii.ffff'ffff              2 integer bits, 2*f fraction bits
 			//   DIV         ii.ffff'ffff'ffff'rrrr    2 integer bits, 3*f fraction bits, and r rounding bits
-			//std::cout << "fraction bits : " << to_binary(fracbits, true) << '\n';
-			tgt.clear();
-			//std::cout << "initial state : " << to_binary(tgt) << " : " << tgt << '\n';
-			for (unsigned b = 0; b < btType::nrBlocks; ++b) {
-				tgt.setblock(b, fracbits.block(b));
+			for (unsigned b = 0; b < cfloatType::nrBlocks; ++b) {
+				tgt.setblock(b, src.significant_block(rightShift + b * cfloatType::bitsInBlock));
+			}
+			tgt.setblock(cfloatType::MSU, bt(tgt.block(cfloatType::MSU) & cfloatType::MSU_MASK));
+			// the exponent field and the sign overwrite the hidden and integer bits of the significant
+			for (unsigned i = 0; i < es; ++i) {
+				tgt.setbit(cfloatType::fbits + i, (biasedExponent >> i) & 0x1);
 			}
-			//std::cout << "fraction bits : " << to_binary(tgt, true) << '\n';
 			tgt.setsign(src.sign());
-			//std::cout << "adding sign   : " << to_binary(tgt) << '\n';
-			if (!tgt.setexponent(exponent)) {
-				std::cerr << "exponent value is out of range: " << exponent << '\n';
+			// a value that lands on, or rounds onto, the inf/nan encodings has overflowed
+			// the test precedes the increment as a carry out of the nan encoding would reach the sign
+			bool overflow = (hasSupernormals ? tgt.isnan() : tgt.issupernormal());
+			if (!overflow && alignment.first) {
+				for (unsigned b = 0; b < cfloatType::nrBlocks; ++b) {
+					bt block = bt(tgt.block(b) + 1u);
+					tgt.setblock(b, block);
+					if (block != 0) break;
+				}
+				overflow = (hasSupernormals ? tgt.isnan() : tgt.issupernormal());
+			}
+			if (overflow) {
+				if constexpr (isSaturating) {
+					if (src.sign()) tgt.maxneg(); else tgt.maxpos();
+				}
+				else {
+					tgt.setinf(src.sign());
+				}
 			}
-			//std::cout << "add exponent  : " << to_binary(tgt) << '\n';
 		}
 	}
 }
@@ -531,13 +551,13 @@ public:
 		}
 		if (rhs.iszero()) return *this;
 
-		// arithmetic operation
-		blocktriple<fbits, BlockTripleOperator::ADD, bt> a, b, sum;
+		// arithmetic operation: the sum accumulates in place in the triple of the left operand
+		blocktriple<fbits, BlockTripleOperator::ADD, bt> sum, b;
 
 		// transform the inputs into (sign,scale,significant) 
-		normalizeAddition(a); 
+		normalizeAddition(sum); 
 		rhs.normalizeAddition(b);
-		sum.add(a, b);
+		sum.add(sum, b);
 
 		convert(sum, *this);
 
@@ -605,18 +625,18 @@ public:
 			return *this;
 		}
 
-		// arithmetic operation
-		blocktriple<fbits, BlockTripleOperator::MUL, bt> a, b, product;
+		// arithmetic operation: the product accumulates in place in the triple of the left operand
+		blocktriple<fbits, BlockTripleOperator::MUL, bt> product, b;
 
 		// transform the inputs into (sign,scale,significant) 
 		// triples of the correct width
-		normalizeMultiplication(a);
+		normalizeMultiplication(product);
 		rhs.normalizeMultiplication(b);
-		product.mul(a, b);
+		if constexpr (_trace_mul) std::cout << to_binary(product) << " : " << product << " *\n" << to_binary(b) << " : " << b << " =\n";
+		product.mul(product, b);
+		if constexpr (_trace_mul) std::cout << to_binary(product) << " : " << product << '\n';
 		convert(product, *this);
 
-		if constexpr (_trace_mul) std::cout << to_binary(a) << " : " << a << " *\n" << to_binary(b) << " : " << b << " =\n" << to_binary(product) << " : " << product << '\n';
-
 		return *this;
 	}
 	cfloat& operator*=(double rhs) CFLOAT_EXCEPT {
@@ -1910,7 +1930,10 @@ public:
 	explicit operator long()      const noexcept { return to_long(); }
 	explicit operator long long() const noexcept { return to_long_long(); }
 	explicit operator float()     const noexcept { return to_native<float>(); }
-	explicit operator double()    const noexcept { return to_native<double>(); }
+	explicit operator double()    const noexcept {
+		if constexpr (encoding_table_traits<cfloat>::enabled) return encoding_table<cfloat>::to_double(*this);
+		else return to_native<double>();
+	}
 
 	// convert a cfloat to a blocktriple with the fraction format 1.ffff
 	// we are using the same block type so that we can use block copies to move bits around.
@@ -2081,7 +2104,7 @@ public:
 			// where 'f' is a fraction bit, and 'e' is an extension bit
 			// so that normalize can be used to generate blocktriples for add/sub/mul/div/sqrt
 			if (isnormal() || issupernormal()) {
-				if constexpr (fbits < 64) { // max 63 bits of fraction to yield 64bit of raw significant bits
+				if constexpr (fbits < 64 && bitsInBlock < 64) { // max 63 bits of fraction to yield 64bit of raw significant bits, and setbits() fills the MSU of multi-limb 64-bit significants
 					uint64_t raw = fraction_ull();
 					raw |= (1ull << fbits);
 					tgt.setbits(raw);
@@ -2095,7 +2118,7 @@ public:
 			else { 
 				// it is a subnormal encoding in this target cfloat
 				if constexpr (hasSubnormals) {
-					if constexpr (fbits < 64) {
+					if constexpr (fbits < 64 && bitsInBlock < 64) {
 						uint64_t raw = fraction_ull();
 						int shift = MIN_EXP_NORMAL - scale;
 						raw <<= shift;
@@ -2177,6 +2200,60 @@ public:
 		tgt.setradix(blocktriple<fbits, BlockTripleOperator::DIV, bt>::radix);
 	}
 
+	// normalize a cfloat to a blocktriple used in sqrt and rsqrt, which has the form 0'00001.fffff
+	// with the radix set at <fbits>: subnormals are normalized so that the leading 1 is in the hidden bit position.
+	// The result radix will go to fbits + 4 after the root is taken.
+	constexpr void normalizeSqrt(blocktriple<fbits, BlockTripleOperator::SQRT, bt>& tgt) const {
+		// test special cases
+		if (isnan()) {
+			tgt.setnan();
+		}
+		else if (isinf()) {
+			tgt.setinf();
+		}
+		else if (iszero()) {
+			tgt.setzero();
+		}
+		else {
+			tgt.setnormal(); // a blocktriple is always normalized
+			int scale = this->scale();
+			tgt.setsign(sign());
+			tgt.setscale(scale);
+			if (isnormal() || issupernormal()) {
+				if constexpr (fbits < 64 && bitsInBlock < 64) {  // setbits() fills the MSU of multi-limb 64-bit significants
+					uint64_t raw = fraction_ull();
+					raw |= (1ull << fbits);
+					tgt.setbits(raw);
+				}
+				else {
+					blockcopy(tgt);
+					tgt.setbit(fbits); // add the hidden bit
+				}
+			}
+			else {
+				// it is a subnormal encoding in this target cfloat
+				if constexpr (hasSubnormals) {
+					int shift = MIN_EXP_NORMAL - scale;
+					if constexpr (fbits < 64 && bitsInBlock < 64) {
+						uint64_t raw = fraction_ull();
+						raw <<= shift;
+						raw |= (1ull << fbits);
+						tgt.setbits(raw);
+					}
+					else {
+						blockcopy(tgt);
+						tgt.bitShift(shift);
+						tgt.setbit(fbits);
+					}
+				}
+				else { // this cfloat has no subnormals
+					tgt.setzero(tgt.sign()); // preserve the sign
+				}
+			}
+		}
+		tgt.setradix(fbits); // override the radix with the input scale for accurate value printing
+	}
+
 	// helper debug function
 	void constexprClassParameters() const noexcept {
 		std::cout << "-------------------------------------------------------------\n";
@@ -3122,115 +3199,80 @@ private:
 
 ///////////////////////////// IOSTREAM operators ///////////////////////////////////////////////
 
-// convert cfloat to decimal fixpnt string, i.e. "-1234.5678"
+// convert a cfloat to decimal characters in the caller's buffer [first, last) following std::to_chars:
+// without a precision, the result is the shortest decimal that rounds back to the same cfloat,
+// with a precision, the result is the correctly rounded value in printf %f, %e, or %g format
 template<unsigned nbits, unsigned es, typename bt, bool hasSubnormals, bool hasSupernormals, bool isSaturating>
-std::string to_decimal_fixpnt_string(const cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>& value, long long precision) {
-	constexpr unsigned fbits = cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>::fbits;
-	constexpr unsigned bias = cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>::EXP_BIAS;
-	std::stringstream str;
-	if (value.iszero()) {
-		str << '0';
-		return str.str();
-	}
-	if (value.sign()) str << '-';
-
-	// construct the discretization levels of the fraction part
-	support::decimal range, discretizationLevels, step;
-	// create the decimal range we are discretizing
-	range.setdigit(1);
-	range.shiftLeft(fbits); // the decimal range of the fraction
-	discretizationLevels.powerOf2(fbits); // calculate the discretization levels of this range
-	step = div(range, discretizationLevels);
-	// now construct the value of this range by adding the fraction samples
-	support::decimal partial, multiplier;
-	partial.setzero();  // if you just want the fraction
-	multiplier.setdigit(1);
-	// convert the fraction part
-	for (unsigned i = 0; i < fbits; ++i) {
-		if (value.at(i)) {
-			support::add(partial, multiplier);
-		}
-		support::add(multiplier, multiplier);
-	}
-	if (value.isdenormal()) {
-		support::mul(partial, step);
-		support::decimal scale;
-		scale.powerOf2(bias - 1ull);
-		partial = support::div(partial, scale);
-	} 
-	else {
-		support::add(partial, multiplier); // add the hidden bit
-		support::mul(partial, step);
-		support::decimal scale;
-		int exponent = value.scale();
-		if (exponent < 0) {
-			scale.powerOf2(static_cast<unsigned>(-exponent));
-			partial = support::div(partial, scale);
-		}
-		else {
-			scale.powerOf2(static_cast<unsigned>(exponent));
-			support::mul(partial, scale);
+std::to_chars_result to_chars(char* first, char* last, const cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>& value, std::chars_format fmt = std::chars_format{}, int precision = -1) noexcept {
+	using Cfloat = cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>;
+	constexpr unsigned fbits = Cfloat::fbits;
+	constexpr int minScale = (Cfloat::MIN_EXP_SUBNORMAL < 0 ? -Cfloat::MIN_EXP_SUBNORMAL : Cfloat::MIN_EXP_SUBNORMAL);
+	constexpr unsigned maxScale = static_cast<unsigned>(minScale > Cfloat::MAX_EXP ? minScale : Cfloat::MAX_EXP) + 2u;
+	constexpr unsigned nrLimbs = (fbits + 1u + 31u) / 32u;
+
+	auto copy = [&](const char* txt) {
+		std::size_t length = std::char_traits<char>::length(txt);
+		if (static_cast<std::size_t>(last - first) < length) return std::to_chars_result{ last, std::errc::value_too_large };
+		for (std::size_t i = 0; i < length; ++i) first[i] = txt[i];
+		return std::to_chars_result{ first + length, std::errc{} };
+	};
+	bool sign = value.sign();
+	if (value.isnan()) return copy("nan");
+	if (value.isinf()) return copy(sign ? "-inf" : "inf");
+
+	std::uint32_t significand[nrLimbs] = { 0 };
+	blockbinary<es, bt> ebits;
+	value.exponent(ebits);
+	int biasedExponent = static_cast<int>(unsigned(ebits));
+	bool fractionIsZero = true;
+	if (!value.iszero()) {
+		for (unsigned b = 0; b < Cfloat::nrBlocks; ++b) {
+			std::uint64_t word = static_cast<std::uint64_t>(value.block(b));
+			while (word != 0) {
+				unsigned i = b * Cfloat::bitsInBlock + static_cast<unsigned>(std::countr_zero(word));
+				if (i >= fbits) break;
+				significand[i / 32u] |= (1u << (i % 32u));
+				fractionIsZero = false;
+				word &= word - 1u;
+			}
 		}
 	}
-
-	// the radix is at fbits
-	// The partial represents the parts in the range, so we can deduce
-	// the number of leading zeros by comparing to the length of range
-	int nrLeadingZeros = static_cast<int>(range.size()) - static_cast<int>(partial.size()) - 1;
-	if (nrLeadingZeros >= 0) str << "0.";
-	for (int i = 0; i < nrLeadingZeros; ++i) str << '0';
-	int digitsWritten = (nrLeadingZeros > 0) ? nrLeadingZeros : 0;
-	int position = static_cast<int>(partial.size()) - 1;
-	for (support::decimal::const_reverse_iterator rit = partial.rbegin(); rit != partial.rend(); ++rit) {
-		str << (int)*rit;
-		++digitsWritten;
-		if (position == fbits) str << '.';
-		--position;
+	int lsbScale{ 0 };
+	if (value.iszero() || (biasedExponent == 0 && !hasSubnormals)) {
+		for (unsigned i = 0; i < nrLimbs; ++i) significand[i] = 0;
+	}
+	else if (biasedExponent == 0) {
+		lsbScale = Cfloat::MIN_EXP_NORMAL - static_cast<int>(fbits);
 	}
-	if (digitsWritten < precision) { // deal with trailing 0s
-		for (unsigned i = static_cast<unsigned>(digitsWritten); i < fbits; ++i) {
-			str << '0';
+	else {
+		if constexpr (!hasSupernormals) {
+			if (ebits.all()) return copy("nan");  // supernormals are mapped to quiet NaNs
 		}
+		significand[fbits / 32u] |= (1u << (fbits % 32u));
+		lsbScale = biasedExponent - Cfloat::EXP_BIAS - static_cast<int>(fbits);
 	}
+	// the lower neighbor of a power of 2 is half an ulp closer, except at the smallest normal binade
+	int lowerGap = (fractionIsZero && biasedExponent > 1 ? lsbScale - 2 : lsbScale - 1);
+	// round-to-nearest-even rounds the midpoints to an even significand
+	bool inclusive = ((significand[0] & 1u) == 0);
+	return dragon_to_chars<fbits + 1u, maxScale>(first, last, sign, significand, nrLimbs, lsbScale, lowerGap, lsbScale - 1, inclusive, fmt, precision);
+}
 
-	return str.str();
+// convert cfloat to decimal fixpnt string with precision fractional digits, i.e. "-1234.5678"
+template<unsigned nbits, unsigned es, typename bt, bool hasSubnormals, bool hasSupernormals, bool isSaturating>
+std::string to_decimal_fixpnt_string(const cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>& value, long long precision) {
+	constexpr unsigned fhbits = cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>::fhbits;
+	int digits = static_cast<int>(precision < 0 ? 6 : precision);
+	return dragon_to_string([&](char* first, char* last) { return to_chars(first, last, value, std::chars_format::fixed, digits); },
+		static_cast<std::size_t>(digits) + 32u + 2u * dragon<fhbits, (1u << es) + fhbits>::maxDigits);
 }
 
+// convert cfloat to a decimal string with precision significant digits, as printf %g
 template<unsigned nbits, unsigned es, typename bt, bool hasSubnormals, bool hasSupernormals, bool isSaturating>
 std::string to_string(const cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>& value, long long precision) {
-	constexpr unsigned fbits = cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>::fbits;
-	std::stringstream str;
-	if (value.iszero()) {
-		str << '0';
-		return str.str();
-	}
-	if (value.sign()) str << '-';
-
-	// denormalize the number to gain access to the most sigificant digits
-	// 1.ffff^e
-	// scale is e
-	// lsbScale is e - fbits
-	// shift to get lsb to position 2^0 = (e - fbits)
-	std::int64_t scale = value.scale();
-//	std::int64_t shift = scale + fbits; // we want the lsb at 2^0
-	std::int64_t lsbScale = scale - fbits;  // scale of the lsb
-	support::decimal partial, multiplier;
-	partial.setzero();
-
-	multiplier.powerOf2(lsbScale);
-
-	// convert the fraction bits 
-	for (unsigned i = 0; i < fbits; ++i) {
-		if (value.at(i)) {
-			support::add(partial, multiplier);
-		}
-		support::add(multiplier, multiplier);
-	}
-	if (!value.isdenormal()) {
-		support::add(partial, multiplier); // add the hidden bit
-	}
-	str << partial;
-	return str.str();
+	int digits = static_cast<int>(precision < 0 ? 6 : precision);
+	return dragon_to_string([&](char* first, char* last) { return to_chars(first, last, value, std::chars_format::general, digits); },
+		static_cast<std::size_t>(digits) + 32u);
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////
@@ -3251,11 +3293,13 @@ inline std::ostream& operator<<(std::ostream& ostr, const cfloat<nbits, es, bt,
 	if (fixed) {
 		representation = to_decimal_fixpnt_string(v, precision);
 	}
+	else if (scientific) {
+		int digits = static_cast<int>(precision < 0 ? 6 : precision);
+		representation = dragon_to_string([&](char* first, char* last) { return to_chars(first, last, v, std::chars_format::scientific, digits); },
+			static_cast<std::size_t>(digits) + 32u);
+	}
 	else {
-		std::stringstream ss;
-		ss << std::setprecision(precision) << double(v);  // TODO: make this native
-		representation = ss.str();
-//		representation = to_string(v, precision);
+		representation = to_string(v, precision);
 	}
 
 	// implement setw and left/right operators
@@ -3274,17 +3318,119 @@ inline std::ostream& operator<<(std::ostream& ostr, const cfloat<nbits, es, bt,
 	return ostr << representation;
 }
 
-// istream input: currently marshalling through native double
+// istream input: reads a decimal and rounds it to the nearest cfloat
 template<unsigned nbits, unsigned es, typename bt, bool hasSubnormals, bool hasSupernormals, bool isSaturating>
 inline std::istream& operator>>(std::istream& istr, cfloat<nbits,es,bt,hasSubnormals,hasSupernormals,isSaturating>& v) {
-	double d(0.0);
-	istr >> d;
-	v = d;
+	std::string txt;
+	istr >> txt;
+	if (!parse(txt, v)) {
+		istr.setstate(std::ios_base::failbit);
+	}
 	return istr;
 }
 
 // encoding helpers
 
+// convert the decimal at the start of [first, last) to the nearest cfloat following std::from_chars:
+// the value is correctly rounded for any number of digits, and inf, infinity, and nan are recognized
+template<unsigned nbits, unsigned es, typename bt, bool hasSubnormals, bool hasSupernormals, bool isSaturating>
+std::from_chars_result from_chars(const char* first, const char* last, cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>& value) noexcept {
+	using Cfloat = cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>;
+	constexpr unsigned fbits = Cfloat::fbits;
+	constexpr int minScale = (Cfloat::MIN_EXP_SUBNORMAL < 0 ? -Cfloat::MIN_EXP_SUBNORMAL : Cfloat::MIN_EXP_SUBNORMAL);
+	constexpr unsigned maxScale = static_cast<unsigned>(minScale > Cfloat::MAX_EXP ? minScale : Cfloat::MAX_EXP) + 2u;
+	// the blocktriple of an addition carries the hidden bit, the fraction bits, and three rounding bits
+	using BlockTriple = blocktriple<fbits, BlockTripleOperator::ADD, bt>;
+	constexpr unsigned tbits = fbits + 4u;
+	constexpr unsigned nrWords = (tbits + 63u) / 64u;
+
+	parsed_decimal<nrWords> d;
+	std::from_chars_result r = parse_decimal<nrWords, maxScale, fbits + 1u>(first, last, d);
+	if (r.ec != std::errc{}) return r;
+	if (d.nan) {
+		value.setnan(NAN_TYPE_QUIET);
+	}
+	else if (d.inf) {
+		value.setinf(d.sign);
+	}
+	else if (d.zero) {
+		value.setzero();
+		value.setsign(d.sign);
+	}
+	else if constexpr (tbits <= 64) {
+		// the round-to-odd significand leaves the rounding to the cfloat conversion of the blocktriple
+		BlockTriple t;
+		t.setbits(d.bits(tbits));
+		t.setnormal();
+		t.setsign(d.sign);
+		t.setscale(d.scale);
+		convert(t, value);
+	}
+	else {
+		// wide significands are rounded here: the biased exponent and the fraction form one integer,
+		// so the carry of the rounding propagates from the fraction into the exponent
+		constexpr int pbits = static_cast<int>(parsed_decimal<nrWords>::pbits);
+		constexpr unsigned nrEncodingWords = (nbits + 63u) / 64u;
+		int scale = d.scale;
+		bool underflow = (hasSubnormals ? scale < Cfloat::MIN_EXP_SUBNORMAL - 1 : scale < Cfloat::MIN_EXP_NORMAL);
+		if (underflow) {
+			value.setzero();
+			value.setsign(d.sign);
+			return r;
+		}
+		std::uint64_t encoding[nrEncodingWords] = { 0 };
+		int precision = static_cast<int>(fbits) + 1;
+		if (scale < Cfloat::MIN_EXP_NORMAL) precision -= Cfloat::MIN_EXP_NORMAL - scale;
+		int lsb = pbits - precision;
+		for (int i = 0; i < precision; ++i) {
+			if (d.at(lsb + i)) encoding[i / 64] |= (1ull << (i % 64));
+		}
+		auto add = [&](unsigned word, std::uint64_t addend) {
+			for (unsigned i = word; i < nrEncodingWords && addend != 0; ++i) {
+				encoding[i] += addend;
+				addend = (encoding[i] < addend ? 1u : 0u);
+			}
+		};
+		if (scale >= Cfloat::MIN_EXP_NORMAL) {
+			// the hidden bit adds the last one to the biased exponent
+			std::uint64_t biasedExponent = static_cast<std::uint64_t>(scale + Cfloat::EXP_BIAS - 1);
+			add(fbits / 64u, biasedExponent << (fbits % 64u));
+			if (fbits % 64u != 0) add(fbits / 64u + 1u, biasedExponent >> (64u - fbits % 64u));
+		}
+		if (d.at(lsb - 1) && (d.any(lsb - 1) || (encoding[0] & 1u))) add(0, 1u);
+		if (scale > Cfloat::MAX_EXP || ((encoding[(nbits - 1u) / 64u] >> ((nbits - 1u) % 64u)) & 1u)) {
+			if constexpr (isSaturating) {
+				if (d.sign) value.maxneg(); else value.maxpos();
+			}
+			else {
+				value.setinf(d.sign);
+			}
+			return r;
+		}
+		value.clear();
+		for (unsigned i = 0; i < nbits - 1u; ++i) value.setbit(i, (encoding[i / 64u] >> (i % 64u)) & 1u);
+		value.setsign(d.sign);
+		if (value.isnan()) {
+			// encodings beyond the largest value map back to maxpos/maxneg or inf
+			if constexpr (isSaturating) {
+				if (d.sign) value.maxneg(); else value.maxpos();
+			}
+			else {
+				value.setinf(d.sign);
+			}
+		}
+	}
+	return r;
+}
+
+// parse a decimal string into a cfloat, the entire string needs to be consumed
+template<unsigned nbits, unsigned es, typename bt, bool hasSubnormals, bool hasSupernormals, bool isSaturating>
+bool parse(const std::string& number, cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>& value) {
+	const char* last = number.data() + number.size();
+	std::from_chars_result r = from_chars(number.data(), last, value);
+	return (r.ec == std::errc{} && r.ptr == last);
+}
+
 // return the Unit in the Last Position
 template<unsigned nbits, unsigned es, typename bt, bool hasSubnormals, bool hasSupernormals, bool isSaturating>
 inline cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating> ulp(const cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>& a) {
@@ -3929,30 +4075,81 @@ inline cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating> ldexp
 	return result;
 }
 
+/// <summary>
+/// fused multiply-add: x * y + z with a single rounding event.
+/// The product leaves the multiplier unrounded with 2*fbits fraction bits, and is
+/// aligned with the addend in an adder that is wide enough to hold it, so that
+/// only the final conversion to the cfloat rounds.
+/// </summary>
 template<unsigned nbits, unsigned es, typename bt, bool hasSubnormals, bool hasSupernormals, bool isSaturating>
 inline cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating> 
-fma(cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating> x,
-	cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating> y,
-	cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating> z) {
-	cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating> fused{ 0 };
-	constexpr unsigned FBITS = cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>::fbits;
-	constexpr unsigned EXTRA_FBITS = FBITS+2;
-	constexpr unsigned EXTENDED_PRECISION = nbits + EXTRA_FBITS;
-	// the C++ fma spec indicates that the x*y+z is evaluated in 'infinite' precision
-	// with only a single rounding event. The minimum finite precision that would behave like this
-	// is the precision where the product x*y does not need to be rounded, which will
-	// need at least 2*(fbits+1) mantissa bits to capture all bits that can be
-	// generated by the product.
-	cfloat<EXTENDED_PRECISION, es, bt, hasSubnormals, hasSupernormals, isSaturating> preciseX(x), preciseY(y), preciseZ(z);
-//	ReportValue(preciseX, "extended precision x");
-//	ReportValue(preciseY, "extended precision y");
-//	ReportValue(preciseZ, "extended precision z");
-	cfloat<EXTENDED_PRECISION, es, bt, hasSubnormals, hasSupernormals, isSaturating> product = preciseX * preciseY;
-//	ReportValue(product, "extended precision p");
-	fused = product + preciseZ;
-	return fused;
+fma(const cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>& x,
+	const cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>& y,
+	const cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>& z) {
+	using Cfloat = cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>;
+	constexpr unsigned fbits = Cfloat::fbits;
+	constexpr unsigned fmabits = 2 * fbits + 1;  // fraction bits of the exact product in the form 1.ffff
+	using Product = blocktriple<fbits, BlockTripleOperator::MUL, bt>;
+	using Sum = blocktriple<fmabits, BlockTripleOperator::ADD, bt>;
+
+	// special cases follow the unfused operators, except that a finite product
+	// does not overflow before an infinite addend is added
+	if (x.isnan() || y.isnan() || z.isnan() || x.isinf() || y.isinf() || z.isinf()) {
+		if (z.isinf() && !(x.isnan() || y.isnan() || x.isinf() || y.isinf())) return z;
+		return (x * y) + z;
+	}
+	if (x.iszero() || y.iszero()) return (x * y) + z;
+
+	Product a, b, product;
+	x.normalizeMultiplication(a);
+	y.normalizeMultiplication(b);
+	if (a.iszero() || b.iszero()) return (x * y) + z;  // subnormals of a cfloat without subnormals
+	product.mul(a, b);
+
+	Cfloat result;
+	Product c;
+	z.normalizeMultiplication(c);
+	if (c.iszero()) {
+		convert(product, result);
+		return result;
+	}
+
+	// move the product ii.ffff'ffff, radix at 2*fbits, and the addend 1.ffff, radix at fbits,
+	// into the adder's form 001.ffff'ffff'f rrr
+	Sum p, addend, sum;
+	int carry = product.significantscale();  // 1 when the product is in [2, 4)
+	p.setnormal();
+	p.setsign(product.sign());
+	p.setscale(product.scale() + carry);
+	for (unsigned i = 0; i < Product::Significant::nrBlocks; ++i) p.setblock(i, product.block(i));
+	p.bitShift(static_cast<int>(Sum::radix) - 2 * static_cast<int>(fbits) - carry);
+	p.setradix();
+
+	addend.setnormal();
+	addend.setsign(c.sign());
+	addend.setscale(c.scale());
+	for (unsigned i = 0; i < Product::Significant::nrBlocks; ++i) addend.setblock(i, c.block(i));
+	addend.bitShift(static_cast<int>(Sum::radix) - static_cast<int>(fbits));
+	addend.setradix();
+
+	sum.add(p, addend);
+	convert(sum, result);
+	return result;
 }
 
+template<unsigned nbits, unsigned es, typename bt, bool hasSubnormals, bool hasSupernormals, bool isSaturating>
+struct has_fma_trait< cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating> > : true_type {};
+
+// cfloats of ENCODING_TABLE_NBITS bits or fewer convert to double through an exhaustive table
+template<unsigned nbits, unsigned es, typename bt, bool hasSubnormals, bool hasSupernormals, bool isSaturating>
+struct encoding_table_traits< cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating> > {
+	using Cfloat = cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>;
+	static constexpr bool enabled = (nbits <= ENCODING_TABLE_NBITS);
+	static constexpr bool logarithmic = false;
+	static std::uint64_t encoding(const Cfloat& c) noexcept { return block_encoding(c); }
+	static double decode(const Cfloat& c) noexcept { return c.template to_native<double>(); }
+};
+
 template<unsigned nbits, unsigned es, typename bt, bool hasSubnormals, bool hasSupernormals, bool isSaturating>
 cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>&
 minpos(cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>& c) {
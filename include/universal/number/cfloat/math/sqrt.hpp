@@ -8,10 +8,6 @@
 #include <universal/native/ieee754.hpp>
 #include <universal/number/cfloat/math/sqrt_tables.hpp>
 
-#ifndef CFLOAT_NATIVE_SQRT
-#define CFLOAT_NATIVE_SQRT 0
-#endif
-
 namespace sw { namespace universal {
 
 /*
@@ -76,16 +72,30 @@ namespace sw { namespace universal {
 
 
 #if CFLOAT_NATIVE_SQRT
-	// sqrt for arbitrary cfloat
+	// sqrt for arbitrary cfloat: a digit recurrence on the significant yields the root
+	// with guard, round, and sticky bits, so the result is correctly rounded for all precisions
 	template<unsigned nbits, unsigned es, typename bt, bool hasSubnormal, bool hasSupernormal, bool isSaturating>
 	inline cfloat<nbits, es, bt, hasSubnormal, hasSupernormal, isSaturating> sqrt(const cfloat<nbits, es, bt, hasSubnormal, hasSupernormal, isSaturating>& a) {
+		using Cfloat = cfloat<nbits, es, bt, hasSubnormal, hasSupernormal, isSaturating>;
+		if (a.isnan() || a.iszero()) return a;  // sqrt(-0) = -0
+		if (a.isneg()) {
 #if CFLOAT_THROW_ARITHMETIC_EXCEPTION
-		if (a.isneg()) throw cfloat_negative_sqrt_arg();
+			throw cfloat_negative_sqrt_arg();
 #else
-		if (a.isneg()) std::cerr << "cfloat argument to sqrt is negative: " << a << std::endl;
+			std::cerr << "cfloat argument to sqrt is negative: " << a << std::endl;
+			return Cfloat(SpecificValue::qnan);
 #endif
-		if (a.iszero()) return a;
-		return cfloat<nbits, es, bt, hasSubnormal, hasSupernormal, isSaturating>(std::sqrt((double)a));  // TBD
+		}
+		if (a.isinf()) return a;
+
+		using BlockTriple = blocktriple<Cfloat::fbits, BlockTripleOperator::SQRT, bt>;
+		BlockTriple v, root;
+		a.normalizeSqrt(v);
+		if (v.iszero()) return Cfloat(0);  // subnormal encodings of a cfloat without subnormals
+		root.sqrt(v);
+		Cfloat result;
+		convert(root, result);
+		return result;
 	}
 #else
 	template<unsigned nbits, unsigned es, typename bt, bool hasSubnormal, bool hasSupernormal, bool isSaturating>
@@ -100,11 +110,38 @@ namespace sw { namespace universal {
 	}
 #endif
 
-	// reciprocal sqrt
+	// reciprocal sqrt, correctly rounded
 	template<unsigned nbits, unsigned es, typename bt, bool hasSubnormal, bool hasSupernormal, bool isSaturating>
 	inline cfloat<nbits, es, bt, hasSubnormal, hasSupernormal, isSaturating> rsqrt(const cfloat<nbits, es, bt, hasSubnormal, hasSupernormal, isSaturating>& a) {
-		cfloat<nbits, es, bt, hasSubnormal, hasSupernormal, isSaturating> v = sqrt(a);
-		return v.reciprocate();
+		using Cfloat = cfloat<nbits, es, bt, hasSubnormal, hasSupernormal, isSaturating>;
+		if (a.isnan()) return a;
+		if (a.iszero()) {  // rsqrt(+-0) = +-inf
+			Cfloat inf;
+			inf.setinf(a.sign());
+			return inf;
+		}
+		if (a.isneg()) {
+#if CFLOAT_THROW_ARITHMETIC_EXCEPTION
+			throw cfloat_negative_sqrt_arg();
+#else
+			std::cerr << "cfloat argument to rsqrt is negative: " << a << std::endl;
+			return Cfloat(SpecificValue::qnan);
+#endif
+		}
+		if (a.isinf()) return Cfloat(0);
+
+		using BlockTriple = blocktriple<Cfloat::fbits, BlockTripleOperator::SQRT, bt>;
+		BlockTriple v, root;
+		a.normalizeSqrt(v);
+		if (v.iszero()) {
+			Cfloat inf;
+			inf.setinf(false);
+			return inf;
+		}
+		root.rsqrt(v);
+		Cfloat result;
+		convert(root, result);
+		return result;
 	}
 
 	///////////////////////////////////////////////////////////////////
@@ -13,6 +13,7 @@ namespace sw { namespace universal {
     /// <summary>
     /// polyeval evaluates a given n-th degree polynomial at x using Horner's rule.
     /// The polynomial is given by the array of (n+1) coefficients.
+    /// Each step is a fused multiply-add, so the polynomial is rounded once per coefficient.
     /// </summary>
     /// <param name="c">polynomial coefficients</param>
     /// <param name="n">portion of the polynomial to evaluate</param>
@@ -25,8 +26,7 @@ namespace sw { namespace universal {
         cfloat<nbits, es, BlockType, hasSubnormals, hasSupernormals, isSaturating> r = coefficients[n];
 
         for (int i = n - 1; i >= 0; --i) {
-            r *= x;
-            r += coefficients[i];
+            r = fma(r, x, coefficients[i]);
         }
 
         return r;
@@ -0,0 +1,158 @@
+#pragma once
+// dbns_addition.hpp: native addition and subtraction engine for the double-base logarithmic number system
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <algorithm>
+
+/*
+   A dbns magnitude is 0.5^a * 3^b, with a in [0, MAX_A] and b in [0, MAX_B], so its base-2 logarithm is
+   b*log2(3) - a. For |x| >= |y| the sum and difference are
+
+       |x| + |y| = |x| * (1 + r)      |x| - |y| = |x| * (1 - r)      r = 0.5^(ay - ax) * 3^(by - bx) <= 1
+
+   and the correction log2(1 +/- r) only depends on the exponent differences (ay - ax, by - bx).
+   The result is the representable (a, b) pair closest to log2|x| + correction in the log domain.
+   That rounding step is what keeps the exponents in range: instead of adding a correction pair to
+   (ax, bx) and walking the out-of-range result back with unity approximations like 2^3 * 3^-2,
+   it directly picks the nearest pair that fits in the fields. The bit pattern of zero,
+   a = MAX_A and b = 0, is not a magnitude and is never selected; results beyond maxpos saturate
+   to maxpos, and results below the smallest magnitude round to that smallest magnitude.
+
+   Configurations with fbbits + sbbits <= 11 are table driven: the correction is read from 2-D
+   tables indexed by the exponent differences, and the rounding is a binary search in the sorted
+   list of all 2^(fbbits+sbbits) - 1 magnitudes. The tables are built once, on first use.
+   Larger configurations evaluate the correction with log2/exp2 and search the b exponents
+   that can land within half a unit of the target.
+*/
+
+namespace sw { namespace universal {
+
+template<unsigned fbbits, unsigned sbbits>
+class dbns_adder {
+public:
+	static constexpr uint64_t MAX_A = (0xFFFF'FFFF'FFFF'FFFFull >> (64 - fbbits));
+	static constexpr uint64_t MAX_B = (0xFFFF'FFFF'FFFF'FFFFull >> (64 - sbbits));
+	static constexpr double   log2of3 = 1.5849625007211561814537389439478;
+	static constexpr bool     tableDriven = (fbbits + sbbits) <= 11;
+
+	// base-2 logarithm of the magnitude 0.5^a * 3^b
+	static constexpr double log2magnitude(uint32_t a, uint32_t b) noexcept { return double(b) * log2of3 - double(a); }
+
+	// |x| < |y|
+	static bool less(uint32_t ax, uint32_t bx, uint32_t ay, uint32_t by) noexcept {
+		if constexpr (tableDriven) {
+			const tables& t = lookup();
+			return t.rank[index(ax, bx)] < t.rank[index(ay, by)];
+		}
+		else {
+			return log2magnitude(ax, bx) < log2magnitude(ay, by);
+		}
+	}
+
+	// (a, b) of the magnitude closest to |x| + |y|, or |x| - |y| when subtract is set, precondition |x| >= |y|
+	// returns false when the difference cancels exactly
+	static bool add(uint32_t ax, uint32_t bx, uint32_t ay, uint32_t by, bool subtract, uint32_t& a, uint32_t& b) noexcept {
+		if (subtract && ax == ay && bx == by) return false;
+		if constexpr (tableDriven) {
+			const tables& t = lookup();
+			uint32_t rx = t.rank[index(ax, bx)];
+			size_t d = correction_index(int64_t(ay) - int64_t(ax), int64_t(by) - int64_t(bx));
+			double target = t.logv[rx] + (subtract ? t.minus[d] : t.plus[d]);
+			// the sum is at least |x|, the difference at most |x|
+			const double* first = t.logv.data() + (subtract ? 0 : rx);
+			const double* last = t.logv.data() + (subtract ? rx + 1 : t.logv.size());
+			const double* hi = std::upper_bound(first, last, target);
+			const double* nearest = hi;
+			if (hi == last) nearest = hi - 1;
+			else if (hi != first && (target - *(hi - 1)) <= (*hi - target)) nearest = hi - 1;
+			uint32_t m = t.order[static_cast<size_t>(nearest - t.logv.data())];
+			a = m >> sbbits;
+			b = m & static_cast<uint32_t>(MAX_B);
+		}
+		else {
+			using std::exp2;
+			using std::log2;
+			double lx = log2magnitude(ax, bx);
+			double r = exp2(log2magnitude(ay, by) - lx);
+			round(lx + log2(subtract ? 1.0 - r : 1.0 + r), a, b);
+		}
+		return true;
+	}
+
+	// (a, b) of the magnitude closest to 2^target in the log domain
+	static void round(double target, uint32_t& a, uint32_t& b) noexcept {
+		using std::floor;
+		using std::ceil;
+		using std::llround;
+		// only b in [blo, bhi] can place b*log2(3) - a within half a unit of the target with a in [0, MAX_A]:
+		// below blo, a clamps to 0 and the value falls further short, above bhi, a clamps to MAX_A and overshoots more
+		double lo = floor((target - 0.5) / log2of3), hi = ceil((target + double(MAX_A) + 0.5) / log2of3);
+		uint64_t blo = (lo <= 0.0 ? 0ull : (lo >= double(MAX_B) ? MAX_B : static_cast<uint64_t>(lo)));
+		uint64_t bhi = (hi <= 0.0 ? 0ull : (hi >= double(MAX_B) ? MAX_B : static_cast<uint64_t>(hi)));
+		double lowestError = std::numeric_limits<double>::infinity();
+		for (uint64_t bb = blo; bb <= bhi; ++bb) {
+			double ar = double(bb) * log2of3 - target;
+			uint64_t aa = (ar <= 0.0 ? 0ull : (ar >= double(MAX_A) ? MAX_A : static_cast<uint64_t>(llround(ar))));
+			if (aa == MAX_A && bb == 0) aa = MAX_A - 1; // the zero encoding is not a magnitude
+			double error = std::abs(double(bb) * log2of3 - double(aa) - target);
+			if (error < lowestError) {
+				lowestError = error;
+				a = static_cast<uint32_t>(aa);
+				b = static_cast<uint32_t>(bb);
+			}
+		}
+	}
+
+private:
+	static constexpr uint32_t index(uint32_t a, uint32_t b) noexcept { return (a << sbbits) | b; }
+	static constexpr size_t correction_index(int64_t da, int64_t db) noexcept {
+		return static_cast<size_t>((da + int64_t(MAX_A)) * int64_t(2 * MAX_B + 1) + (db + int64_t(MAX_B)));
+	}
+
+	struct tables {
+		std::vector<uint32_t> order;  // magnitude encodings (a << sbbits | b), sorted by value
+		std::vector<double>   logv;   // log2 of the sorted magnitudes
+		std::vector<uint32_t> rank;   // position of a magnitude encoding in the sorted order
+		std::vector<double>   plus;   // log2(1 + r) indexed by the exponent differences
+		std::vector<double>   minus;  // log2(1 - r) indexed by the exponent differences
+
+		tables() {
+			constexpr uint32_t nrEncodings = 1u << (fbbits + sbbits);
+			constexpr uint32_t zeroEncoding = static_cast<uint32_t>(MAX_A << sbbits);
+			order.reserve(nrEncodings - 1);
+			for (uint32_t m = 0; m < nrEncodings; ++m) if (m != zeroEncoding) order.push_back(m);
+			auto value = [](uint32_t m) { return log2magnitude(m >> sbbits, m & static_cast<uint32_t>(MAX_B)); };
+			std::sort(order.begin(), order.end(), [&](uint32_t lhs, uint32_t rhs) { return value(lhs) < value(rhs); });
+			logv.resize(order.size());
+			rank.assign(nrEncodings, 0);
+			for (uint32_t i = 0; i < order.size(); ++i) {
+				logv[i] = value(order[i]);
+				rank[order[i]] = i;
+			}
+			size_t size = (2 * MAX_A + 1) * (2 * MAX_B + 1);
+			plus.resize(size);
+			minus.resize(size);
+			for (int64_t da = -int64_t(MAX_A); da <= int64_t(MAX_A); ++da) {
+				for (int64_t db = -int64_t(MAX_B); db <= int64_t(MAX_B); ++db) {
+					double r = std::exp2(double(db) * log2of3 - double(da));
+					plus[correction_index(da, db)] = std::log2(1.0 + r);
+					minus[correction_index(da, db)] = (r < 1.0 ? std::log2(1.0 - r) : 0.0); // only r < 1 is reachable
+				}
+			}
+		}
+	};
+
+	static const tables& lookup() {
+		static const tables t;
+		return t;
+	}
+};
+
+}} // namespace sw::universal
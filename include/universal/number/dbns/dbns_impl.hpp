@@ -13,6 +13,7 @@
 #include <universal/number/shared/specific_value_encoding.hpp>
 #include <universal/behavior/arithmetic.hpp>
 #include <universal/number/dbns/dbns_fwd.hpp>
+#include <universal/number/dbns/dbns_addition.hpp>
 
 namespace sw { namespace universal {
 		
@@ -195,27 +196,13 @@ public:
 
 	// in-place arithmetic assignment operators
 	dbns& operator+=(const dbns& rhs) {
-		double sum{ 0.0 };
-		if constexpr (behavior == Behavior::Saturating) {
-			sum = double(*this) + double(rhs);  // TODO: native implementation
-		}
-		else {
-			sum = double(*this) + double(rhs);  // TODO: native implementation
-		}
-		return *this = sum; // <-- saturation happens in the assignment
+		return accumulate(rhs, rhs.sign());
 	}
 	dbns& operator+=(double rhs) { 
 		return operator+=(dbns(rhs));
 	}
 	dbns& operator-=(const dbns& rhs) { 
-		double diff{ 0.0 };
-		if constexpr (behavior == Behavior::Saturating) {
-			diff = double(*this) - double(rhs);  // TODO: native implementation
-		}
-		else {
-			diff = double(*this) - double(rhs);  // TODO: native implementation
-		}
-		return *this = diff; // <-- saturation happens in the assignment
+		return accumulate(rhs, !rhs.sign());
 	}
 	dbns& operator-=(double rhs) {
 		return operator-=(dbns(rhs));
@@ -836,6 +823,50 @@ protected:
 private:
 	BlockType _block[nrBlocks];
 
+	// native addition of rhs with its sign replaced by rhsSign:
+	// the larger magnitude determines the sign, the exponent differences the correction
+	dbns& accumulate(const dbns& rhs, bool rhsSign) {
+		if (isnan()) return *this;
+		if (rhs.isnan()) {
+			setnan();
+			return *this;
+		}
+		if (rhs.iszero()) return *this;
+		if (iszero()) {
+			*this = rhs;
+			if (rhsSign != rhs.sign()) _block[MSU] ^= SIGN_BIT_MASK;
+			return *this;
+		}
+		using Adder = dbns_adder<fbbits, sbbits>;
+		uint32_t ax = extractExponent(0), bx = extractExponent(1);
+		uint32_t ay = rhs.extractExponent(0), by = rhs.extractExponent(1);
+		bool negative = sign();
+		bool subtract = (negative != rhsSign);
+		if (Adder::less(ax, bx, ay, by)) {
+			std::swap(ax, ay);
+			std::swap(bx, by);
+			negative = rhsSign;
+		}
+		uint32_t a{ 0 }, b{ 0 };
+		if (!Adder::add(ax, bx, ay, by, subtract, a, b)) {
+			setzero();
+			return *this;
+		}
+		// the rounding saturates at maxpos and at the smallest magnitude for both behaviors
+		// a single store of the encoding: GCC 12 -O2 folds the split-off setbit tails of different dbns sizes
+		// without comparing their value ranges, and the setsign of the larger size loses its bit (GCC PR ipa/113907)
+		if constexpr (nbits <= 64) {
+			setbits((uint64_t(negative) << (nbits - 1)) | (uint64_t(a) << sbbits) | uint64_t(b));
+		}
+		else {
+			clear();
+			setexponent(0, a);
+			setexponent(1, b);
+			setsign(negative);
+		}
+		return *this;
+	}
+
 	////////////////////// operators
 
 	// stream operators
@@ -927,6 +958,7 @@ private:
 	friend constexpr dbns operator+(const dbns& lhs, double rhs) {
 		dbns sum(lhs);
 		sum += rhs;
+		return sum;
 	}
 	friend constexpr dbns operator-(const dbns& lhs, double rhs) {
 		dbns diff(lhs);
@@ -25,6 +25,7 @@
 #include <universal/number/shared/nan_encoding.hpp>
 #include <universal/number/shared/infinite_encoding.hpp>
 #include <universal/number/shared/specific_value_encoding.hpp>
+#include <universal/traits/fma_traits.hpp>
 // dd exception structure
 #include <universal/number/dd/exceptions.hpp>
 #include <universal/number/dd/dd_fwd.hpp>
@@ -1216,6 +1217,10 @@ inline dd fma(const dd& a, const dd& b, const dd& c) {
 	return dd(p[0], p[1]);
 }
 
+// the product and the sum are carried in quad-double, so the fma rounds once to double-double
+template<>
+struct has_fma_trait<dd> : true_type {};
+
 inline dd sqr(const dd& a) {
 	if (a.isnan()) return a;
 
@@ -28,8 +28,7 @@ namespace sw { namespace universal {
         dd r{ coefficients[static_cast<unsigned>(n)] };
 
         for (int i = n - 1; i >= 0; --i) {
-            r *= x;
-            r += coefficients[static_cast<unsigned>(i)];
+            r = fma(r, x, coefficients[static_cast<unsigned>(i)]);
         }
 
         return r;
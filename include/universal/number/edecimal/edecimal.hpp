@@ -52,6 +52,7 @@
 ////////////////////////////////////////////////////////////////////////////////////////
 /// INCLUDE FILES that make up the library
 #include <universal/number/edecimal/exceptions.hpp>
+#include <universal/number/einteger/einteger_fwd.hpp>
 #include <universal/number/edecimal/edecimal_fwd.hpp>
 #include <universal/number/edecimal/edecimal_impl.hpp>
 #include <universal/number/edecimal/numeric_limits.hpp>
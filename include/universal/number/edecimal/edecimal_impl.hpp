@@ -18,13 +18,21 @@ namespace sw { namespace universal {
 /// <summary>
 /// Adaptive precision decimal integer number type
 /// </summary>
-/// The digits are managed as a vector with the digit for 10^0 stored at index 0, 10^1 stored at index 1, etc.
-class edecimal : public std::vector<uint8_t> {
+/// The magnitude is managed as a vector of base 10^9 limbs, each limb holding nine decimal digits,
+/// with the limb for 10^0 stored at index 0, the limb for 10^9 stored at index 1, etc.
+/// The value zero is represented by a single zero limb with a positive sign.
+class edecimal : public std::vector<std::uint32_t> {
 #if EDECIMAL_OPERATIONS_COUNT
 	static bool enableAdd;
 	static occurrence<edecimal> ops;
 #endif
 public:
+	using limb = std::uint32_t;
+	static constexpr unsigned digitsInLimb = 9;
+	static constexpr limb     BASE = 1'000'000'000u;
+	// operand size, in limbs, above which multiplication switches from schoolbook to Karatsuba
+	static constexpr size_t   karatsubaThreshold = 32;
+
 	edecimal() { setzero(); }
 
 	edecimal(const edecimal&) = default;
@@ -73,90 +81,44 @@ public:
 
 	// arithmetic operators
 	edecimal& operator+=(const edecimal& rhs) {
-		edecimal _rhs(rhs);   // is this copy necessary? I introduced it to have a place to pad
-		if (negative != rhs.negative) {  // different signs
-			_rhs.setsign(!rhs.sign());
-			return operator-=(_rhs);
-		}
-		else {
+		if (negative == rhs.negative) {
 			// same sign implies this->negative is invariant
-		}
-		size_t l = size();
-		size_t r = _rhs.size();
-		// zero pad the shorter edecimal
-		if (l < r) {
-			insert(end(), r - l, 0);
+			add_magnitude(rhs);
 		}
 		else {
-			_rhs.insert(_rhs.end(), l - r, 0);
-		}
-		edecimal::iterator lit = begin();
-		edecimal::iterator rit = _rhs.begin();
-		uint8_t carry = 0;
-		for (; lit != end() || rit != _rhs.end(); ++lit, ++rit) {
-			*lit += *rit + carry;
-			if (*lit > 9) {
-				carry = 1;
-				*lit -= 10;
+			// different signs: subtract the smaller magnitude from the larger
+			if (compare_magnitude(*this, rhs) >= 0) {
+				subtract_magnitude(rhs);
 			}
 			else {
-				carry = 0;
+				edecimal sum(rhs);
+				sum.subtract_magnitude(*this);
+				*this = std::move(sum);
 			}
+			if (iszero()) setpos();
 		}
-		if (carry) push_back(1);
 #if EDECIMAL_OPERATIONS_COUNT
 		if (enableAdd) ++ops.add;
 #endif
 		return *this;
 	}
 	edecimal& operator-=(const edecimal& rhs) {
-		edecimal _rhs(rhs);   // is this copy necessary? I introduced it to have a place to pad
-		bool sign = this->sign();
 		if (negative != rhs.negative) {
-			_rhs.setsign(!rhs.sign());
-			return operator+=(_rhs);
-		}
-		// largest value must be subtracted from
-		size_t l = size();
-		size_t r = _rhs.size();
-		// zero pad the shorter edecimal
-		if (l < r) {
-			insert(end(), r - l, 0);
-			std::swap(*this, _rhs);
-			sign = !sign;
-		}
-		else if (r < l) {
-			_rhs.insert(_rhs.end(), l - r, 0);
+			// opposite signs: magnitudes add and this->negative is invariant
+			add_magnitude(rhs);
 		}
 		else {
-			// the operands are the same size, thus we need to check their magnitude
-			this->setpos();
-			_rhs.setpos();
-			if (*this < _rhs) {
-				std::swap(*this, _rhs);
-				sign = !sign;
-			}
-		}
-		edecimal::iterator lit = begin();
-		edecimal::iterator rit = _rhs.begin();
-		uint8_t borrow = 0;
-		for (; lit != end() || rit != _rhs.end(); ++lit, ++rit) {
-			if (*rit > *lit - borrow) {
-				*lit = static_cast<uint8_t>(10 + *lit - borrow - *rit);
-				borrow = 1;
+			// largest magnitude must be subtracted from
+			if (compare_magnitude(*this, rhs) >= 0) {
+				subtract_magnitude(rhs);
 			}
 			else {
-				*lit = static_cast<uint8_t>(*lit - borrow - *rit);
-				borrow = 0;
+				edecimal diff(rhs);
+				diff.subtract_magnitude(*this);
+				diff.setsign(!negative);
+				*this = std::move(diff);
 			}
-		}
-		if (borrow) std::cout << "can this happen?" << std::endl;
-		unpad();
-		if (this->iszero()) { // special case of zero having positive sign
-			this->setpos();
-		}
-		else {
-			this->setsign(sign);
+			if (iszero()) setpos(); // special case of zero having positive sign
 		}
 #if EDECIMAL_OPERATIONS_COUNT
 		++ops.sub;
@@ -173,55 +135,12 @@ public:
 			return *this;
 		}
 		bool signOfFinalResult = (negative != rhs.negative) ? true : false;
-		edecimal product;
-#if EDECIMAL_OPERATIONS_COUNT
-		enableAdd = false;
-#endif
-		// find the smallest edecimal to minimize the amount of work
-		size_t l = size();
-		size_t r = rhs.size();
-		edecimal::const_iterator sit, bit; // sit = smallest iterator, bit = biggest iterator
-		if (l < r) {
-			int64_t position = 0;
-			for (sit = begin(); sit != end(); ++sit) {
-				edecimal partial_sum; partial_sum.clear(); // TODO: this is silly, create and immediately destruct to make the insert work
-				partial_sum.insert(partial_sum.end(), r + position, 0);
-				edecimal::iterator pit = partial_sum.begin() + position;
-				uint8_t carry = 0;
-				for (bit = rhs.begin(); bit != rhs.end() && pit != partial_sum.end(); ++bit, ++pit) {
-					uint8_t digit = static_cast<uint8_t>(*sit * *bit + carry);
-					*pit = static_cast<uint8_t>(digit % 10);
-					carry = static_cast<uint8_t>(digit / 10);
-				}
-				if (carry) partial_sum.push_back(carry);
-				product += partial_sum;
-				//				std::cout << "partial sum " << partial_sum << " intermediate product " << product << std::endl;
-				++position;
-			}
-		}
-		else {
-			int64_t position = 0;
-			for (sit = rhs.begin(); sit != rhs.end(); ++sit) {
-				edecimal partial_sum; partial_sum.clear(); // TODO: this is silly, create and immediately destruct to make the insert work
-				partial_sum.insert(partial_sum.end(), l + position, 0);
-				edecimal::iterator pit = partial_sum.begin() + position;
-				uint8_t carry = 0;
-				for (bit = begin(); bit != end() && pit != partial_sum.end(); ++bit, ++pit) {
-					uint8_t digit = static_cast<uint8_t>(*sit * *bit + carry);
-					*pit = static_cast<uint8_t>(digit % 10);
-					carry = static_cast<uint8_t>(digit / 10);
-				}
-				if (carry) partial_sum.push_back(carry);
-				product += partial_sum;
-				//				std::cout << "partial sum " << partial_sum << " intermediate product " << product << std::endl;
-				++position;
-			}
-		}
-		product.unpad();
-		*this = product;
+		std::vector<limb> product(size() + rhs.size(), 0);
+		multiply(data(), size(), rhs.data(), rhs.size(), product.data());
+		std::vector<limb>::swap(product);
+		unpad();
 		setsign(signOfFinalResult);
 #if EDECIMAL_OPERATIONS_COUNT
-		enableAdd = true;
 		++ops.mul;
 #endif
 		return *this;
@@ -240,36 +159,42 @@ public:
 #endif
 		return *this;
 	}
+	// decimal shift left: multiply by 10^shift
 	edecimal& operator<<=(int shift) {
 		if (shift == 0) return *this;
 		if (shift < 0) {
 			return operator>>=(-shift);
 		}
-		for (int i = 0; i < shift; ++i) {
-			this->insert(this->begin(), 0);
-		}
+		if (iszero()) return *this;
+		unsigned digitShift = static_cast<unsigned>(shift) % digitsInLimb;
+		size_t   limbShift  = static_cast<size_t>(shift) / digitsInLimb;
+		if (digitShift > 0) multiply_limb(pow10(digitShift), 0);
+		if (limbShift > 0) insert(begin(), limbShift, limb(0));
 		return *this;
 	}
+	// decimal shift right: divide by 10^shift and truncate
 	edecimal& operator>>=(int shift) {
 		if (shift == 0) return *this;
 		if (shift < 0) {
 			return operator<<=(-shift);
 		}
-		if (signed(size()) <= shift) {
-			this->setzero();
-		}
-		else {
-			for (int i = 0; i < shift; ++i) {
-				this->erase(this->begin());
-			}
+		unsigned digitShift = static_cast<unsigned>(shift) % digitsInLimb;
+		size_t   limbShift  = static_cast<size_t>(shift) / digitsInLimb;
+		if (size() <= limbShift) {
+			setzero();
+			return *this;
 		}
+		if (limbShift > 0) erase(begin(), begin() + static_cast<std::ptrdiff_t>(limbShift));
+		if (digitShift > 0) divide_limb(pow10(digitShift));
+		unpad();
+		if (iszero()) setpos();
 		return *this;
 	}
 
 	// unitary operators
 	edecimal operator-() const {
 		edecimal tmp(*this);
-		tmp.setsign(!tmp.sign());
+		if (!tmp.iszero()) tmp.setsign(!tmp.sign());
 		return tmp;
 	}
 	edecimal operator++(int) { // postfix
@@ -315,11 +240,28 @@ public:
 	// selectors
 	inline bool iszero() const {
 		if (size() == 0) return true;
-		return std::all_of(begin(), end(), [](uint8_t i) { return 0 == i; });
+		return std::all_of(begin(), end(), [](limb i) { return 0 == i; });
 	}
 	inline bool sign() const { return negative; }
 	inline bool isneg() const { return negative; }   // <  0
 	inline bool ispos() const { return !negative; }  // >= 0
+	inline unsigned limbs() const { return static_cast<unsigned>(size()); }
+	// number of significant decimal digits, 1 for the value zero
+	inline unsigned digits() const {
+		size_t n = size();
+		while (n > 1 && operator[](n - 1) == 0) --n;
+		if (n == 0) return 1;
+		unsigned nrDigits = static_cast<unsigned>((n - 1) * digitsInLimb);
+		limb msl = operator[](n - 1);
+		do { ++nrDigits; msl /= 10; } while (msl);
+		return nrDigits;
+	}
+	// return the decimal digit at position index, with 10^0 at index 0
+	inline unsigned digit(unsigned index) const {
+		size_t l = index / digitsInLimb;
+		if (l >= size()) return 0;
+		return static_cast<unsigned>((operator[](l) / pow10(index % digitsInLimb)) % 10u);
+	}
 
 	// modifiers
 	inline void setzero() { clear(); push_back(0); negative = false; }
@@ -334,79 +276,68 @@ public:
 	}
 	inline void setbits(uint64_t v) { *this = v; } // API to be consistent with the other number systems
 
-	// remove any leading zeros from a edecimal representation
+	// remove any leading zero limbs from a edecimal representation
 	void unpad() {
-		int n = (int)size();
-		for (int i = n - 1; i > 0; --i) {
-			if (operator[](static_cast<size_t>(i)) == 0) {
-				pop_back();
-			}
-			else {
-				return;  // found the most significant digit
-			}
-		}
+		size_t n = size();
+		while (n > 1 && operator[](n - 1) == 0) --n;
+		if (n == 0) { push_back(0); return; }
+		resize(n);
 	}
 
 	// read a edecimal ASCII format and make a edecimal type out of it
 	bool parse(const std::string& _digits) {
-		bool bSuccess = false;
 		std::string digits(_digits);
 		trim(digits);
 		// check if the txt is an edecimal form:[+-]*[0123456789]+
-		std::regex edecimal_regex("[+-]*[0123456789]+");
-		if (std::regex_match(digits, edecimal_regex)) {
-			// found a edecimal representation
-			clear();
-			auto it = digits.begin();
-			if (*it == '-') {
-				setneg();
-				++it;
-			}
-			else if (*it == '+') {
-				++it;
+		size_t first = 0;
+		bool sign = false;
+		while (first < digits.size() && (digits[first] == '+' || digits[first] == '-')) {
+			if (digits[first] == '-') sign = !sign;
+			++first;
+		}
+		if (first == digits.size()) return false;
+		for (size_t i = first; i < digits.size(); ++i) {
+			if (digits[i] < '0' || digits[i] > '9') return false;
+		}
+		// found a edecimal representation: consume the digits in chunks of digitsInLimb from the right
+		clear();
+		size_t last = digits.size();
+		while (last > first) {
+			size_t chunk = (last - first < digitsInLimb) ? last - first : digitsInLimb;
+			limb l = 0;
+			for (size_t i = last - chunk; i < last; ++i) {
+				l = l * 10u + static_cast<limb>(digits[i] - '0');
 			}
-			for (; it != digits.end(); ++it) {
-				uint8_t v;
-				switch (*it) {
-				case '0':
-					v = 0;
-					break;
-				case '1':
-					v = 1;
-					break;
-				case '2':
-					v = 2;
-					break;
-				case '3':
-					v = 3;
-					break;
-				case '4':
-					v = 4;
-					break;
-				case '5':
-					v = 5;
-					break;
-				case '6':
-					v = 6;
-					break;
-				case '7':
-					v = 7;
-					break;
-				case '8':
-					v = 8;
-					break;
-				case '9':
-					v = 9;
-					break;
-				default:
-					v = 0;
-				}
-				push_back(v);
+			push_back(l);
+			last -= chunk;
+		}
+		unpad();
+		negative = iszero() ? false : sign;
+		return true;
+	}
+
+	// generate the decimal digits of the magnitude into a string
+	std::string str() const {
+		size_t n = size();
+		while (n > 1 && operator[](n - 1) == 0) --n;
+		if (n == 0) return std::string("0");
+		char buffer[digitsInLimb];
+		std::string s;
+		s.reserve(n * digitsInLimb);
+		// most significant limb without zero padding
+		limb msl = operator[](n - 1);
+		unsigned nrDigits = 0;
+		do { buffer[nrDigits++] = static_cast<char>('0' + msl % 10u); msl /= 10u; } while (msl);
+		while (nrDigits > 0) s.push_back(buffer[--nrDigits]);
+		for (size_t i = n - 1; i > 0; --i) {
+			limb l = operator[](i - 1);
+			for (int d = static_cast<int>(digitsInLimb) - 1; d >= 0; --d) {
+				buffer[d] = static_cast<char>('0' + l % 10u);
+				l /= 10u;
 			}
-			std::reverse(begin(), end());
-			bSuccess = true;
+			s.append(buffer, digitsInLimb);
 		}
-		return bSuccess;
+		return s;
 	}
 
 #if EDECIMAL_OPERATIONS_COUNT
@@ -419,140 +350,326 @@ public:
 	}
 #endif
 
+	///////////////////////////////////////////////////////////////////////////
+	// limb arithmetic engine: operates on little-endian base 10^9 limb arrays
+
+	// return 10^e for 0 <= e <= 9
+	static constexpr limb pow10(unsigned e) {
+		constexpr limb powers[] = { 1u, 10u, 100u, 1'000u, 10'000u, 100'000u, 1'000'000u, 10'000'000u, 100'000'000u, 1'000'000'000u };
+		return powers[e];
+	}
+
+	// r[0, n) += a[0, n), returns the carry out
+	static limb add_limbs(limb* r, const limb* a, size_t n) {
+		limb carry = 0;
+		for (size_t i = 0; i < n; ++i) {
+			limb s = r[i] + a[i] + carry;
+			carry = (s >= BASE) ? 1u : 0u;
+			r[i] = s - carry * BASE;
+		}
+		return carry;
+	}
+	// r[0, n) -= a[0, n), returns the borrow out
+	static limb subtract_limbs(limb* r, const limb* a, size_t n) {
+		limb borrow = 0;
+		for (size_t i = 0; i < n; ++i) {
+			limb s = a[i] + borrow;
+			borrow = (r[i] < s) ? 1u : 0u;
+			r[i] = r[i] + borrow * BASE - s;
+		}
+		return borrow;
+	}
+	// propagate a carry into r[0, n), returns the carry out
+	static limb propagate_carry(limb* r, size_t n, limb carry) {
+		for (size_t i = 0; carry && i < n; ++i) {
+			limb s = r[i] + carry;
+			carry = (s >= BASE) ? 1u : 0u;
+			r[i] = s - carry * BASE;
+		}
+		return carry;
+	}
+	// propagate a borrow into r[0, n), returns the borrow out
+	static limb propagate_borrow(limb* r, size_t n, limb borrow) {
+		for (size_t i = 0; borrow && i < n; ++i) {
+			if (r[i] >= borrow) { r[i] -= borrow; borrow = 0; }
+			else { r[i] = r[i] + BASE - borrow; }
+		}
+		return borrow;
+	}
+
+	// r[0, na + nb) += a[0, na) * b[0, nb) using the O(n*m) schoolbook algorithm
+	static void multiply_schoolbook(const limb* a, size_t na, const limb* b, size_t nb, limb* r) {
+		for (size_t i = 0; i < na; ++i) {
+			std::uint64_t ai = a[i];
+			if (ai == 0) continue;
+			std::uint64_t carry = 0;
+			for (size_t j = 0; j < nb; ++j) {
+				std::uint64_t t = r[i + j] + ai * b[j] + carry;
+				carry = t / BASE;
+				r[i + j] = static_cast<limb>(t - carry * BASE);
+			}
+			size_t k = i + nb;
+			while (carry) {
+				std::uint64_t t = r[k] + carry;
+				carry = t / BASE;
+				r[k] = static_cast<limb>(t - carry * BASE);
+				++k;
+			}
+		}
+	}
+
+	// r[0, na + nb) += a[0, na) * b[0, nb), dispatching to schoolbook or Karatsuba
+	static void multiply(const limb* a, size_t na, const limb* b, size_t nb, limb* r) {
+		if (na < nb) { std::swap(a, b); std::swap(na, nb); }
+		if (nb < karatsubaThreshold) {
+			multiply_schoolbook(a, na, b, nb, r);
+			return;
+		}
+		if (na >= 2 * nb) {
+			// unbalanced operands: slice the longer operand into nb-sized chunks
+			std::vector<limb> partial(2 * nb);
+			for (size_t offset = 0; offset < na; offset += nb) {
+				size_t chunk = (na - offset < nb) ? na - offset : nb;
+				std::fill(partial.begin(), partial.end(), 0);
+				multiply(a + offset, chunk, b, nb, partial.data());
+				size_t n = chunk + nb;
+				limb carry = add_limbs(r + offset, partial.data(), n);
+				propagate_carry(r + offset + n, na + nb - offset - n, carry);
+			}
+			return;
+		}
+		// Karatsuba: a = a1*B^m + a0, b = b1*B^m + b0, with nb > m
+		size_t m = na / 2;
+		const limb* a0 = a;     size_t na0 = m;
+		const limb* a1 = a + m; size_t na1 = na - m;
+		const limb* b0 = b;     size_t nb0 = m;
+		const limb* b1 = b + m; size_t nb1 = nb - m;
+
+		std::vector<limb> z0(na0 + nb0, 0), z2(na1 + nb1, 0);
+		multiply(a0, na0, b0, nb0, z0.data());
+		multiply(a1, na1, b1, nb1, z2.data());
+
+		size_t nsa = (na0 > na1 ? na0 : na1) + 1;
+		size_t nsb = (nb0 > nb1 ? nb0 : nb1) + 1;
+		std::vector<limb> sa(nsa, 0), sb(nsb, 0);
+		std::copy(a0, a0 + na0, sa.begin());
+		sa[na1] = add_limbs(sa.data(), a1, na1);                     // na1 >= na0
+		std::copy(b0, b0 + nb0, sb.begin());
+		if (nb1 >= nb0) {
+			sb[nb1] = add_limbs(sb.data(), b1, nb1);
+		}
+		else {
+			limb carry = add_limbs(sb.data(), b1, nb1);
+			sb[nb0] = propagate_carry(sb.data() + nb1, nb0 - nb1, carry);
+		}
+		std::vector<limb> z1(nsa + nsb, 0);
+		multiply(sa.data(), nsa, sb.data(), nsb, z1.data());
+		// z1 = (a0 + a1)(b0 + b1) - z0 - z2 >= 0
+		propagate_borrow(z1.data() + z0.size(), z1.size() - z0.size(), subtract_limbs(z1.data(), z0.data(), z0.size()));
+		propagate_borrow(z1.data() + z2.size(), z1.size() - z2.size(), subtract_limbs(z1.data(), z2.data(), z2.size()));
+
+		size_t nr = na + nb;
+		limb carry = add_limbs(r, z0.data(), z0.size());
+		propagate_carry(r + z0.size(), nr - z0.size(), carry);
+		carry = add_limbs(r + 2 * m, z2.data(), z2.size());
+		propagate_carry(r + 2 * m + z2.size(), nr - 2 * m - z2.size(), carry);
+		// the top limbs of z1 are zero beyond the product extent
+		size_t nz1 = z1.size();
+		while (nz1 > 0 && z1[nz1 - 1] == 0) --nz1;
+		carry = add_limbs(r + m, z1.data(), nz1);
+		propagate_carry(r + m + nz1, nr - m - nz1, carry);
+	}
+
+	// |this| = |this| * m + a, with m, a < BASE
+	void multiply_limb(limb m, limb a) {
+		std::uint64_t carry = a;
+		for (limb& l : *this) {
+			std::uint64_t t = static_cast<std::uint64_t>(l) * m + carry;
+			carry = t / BASE;
+			l = static_cast<limb>(t - carry * BASE);
+		}
+		if (carry) push_back(static_cast<limb>(carry));
+	}
+	// |this| = |this| / d, returns the remainder, with 0 < d < BASE
+	limb divide_limb(limb d) {
+		std::uint64_t rem = 0;
+		for (size_t i = size(); i > 0; --i) {
+			std::uint64_t cur = rem * BASE + operator[](i - 1);
+			std::uint64_t q = cur / d;
+			rem = cur - q * d;
+			operator[](i - 1) = static_cast<limb>(q);
+		}
+		return static_cast<limb>(rem);
+	}
+
+	// magnitude division: q = u / v, r = u % v, with u >= v > 0 and both unpadded
+	static void divide(const edecimal& u, const edecimal& v, edecimal& q, edecimal& r) {
+		size_t m = u.size();
+		size_t n = v.size();
+		if (n == 1) {
+			q.assign(u.begin(), u.end());
+			limb rem = q.divide_limb(v[0]);
+			q.unpad();
+			r.clear(); r.push_back(rem);
+			return;
+		}
+		// Knuth algorithm D: normalize so that the most significant limb of the divisor is >= BASE/2
+		limb d = static_cast<limb>(BASE / (static_cast<std::uint64_t>(v[n - 1]) + 1u));
+		edecimal un(u), vn(v);
+		un.push_back(0);
+		if (d > 1) {
+			un.multiply_limb(d, 0); un.resize(m + 1);
+			vn.multiply_limb(d, 0); vn.resize(n);
+		}
+		q.assign(m - n + 1, 0);
+		std::uint64_t vtop = vn[n - 1];
+		std::uint64_t vnext = vn[n - 2];
+		for (size_t jj = m - n + 1; jj > 0; --jj) {
+			size_t j = jj - 1;
+			std::uint64_t numerator = static_cast<std::uint64_t>(un[j + n]) * BASE + un[j + n - 1];
+			std::uint64_t qhat = numerator / vtop;
+			std::uint64_t rhat = numerator - qhat * vtop;
+			while (qhat >= BASE || qhat * vnext > rhat * BASE + un[j + n - 2]) {
+				--qhat;
+				rhat += vtop;
+				if (rhat >= BASE) break;
+			}
+			// multiply and subtract
+			std::uint64_t carry = 0;
+			std::int64_t borrow = 0;
+			for (size_t i = 0; i < n; ++i) {
+				std::uint64_t p = qhat * vn[i] + carry;
+				carry = p / BASE;
+				std::int64_t t = static_cast<std::int64_t>(un[i + j]) - static_cast<std::int64_t>(p - carry * BASE) - borrow;
+				borrow = (t < 0) ? 1 : 0;
+				un[i + j] = static_cast<limb>(t + borrow * static_cast<std::int64_t>(BASE));
+			}
+			std::int64_t t = static_cast<std::int64_t>(un[j + n]) - static_cast<std::int64_t>(carry) - borrow;
+			if (t < 0) {
+				// subtracted too much, add back
+				un[j + n] = static_cast<limb>(t + static_cast<std::int64_t>(BASE));
+				--qhat;
+				limb c = add_limbs(un.data() + j, vn.data(), n);
+				un[j + n] = static_cast<limb>((static_cast<std::uint64_t>(un[j + n]) + c) % BASE);
+			}
+			else {
+				un[j + n] = static_cast<limb>(t);
+			}
+			q[j] = static_cast<limb>(qhat);
+		}
+		q.unpad();
+		// denormalize the remainder
+		r.assign(un.begin(), un.begin() + static_cast<std::ptrdiff_t>(n));
+		if (d > 1) r.divide_limb(d);
+		r.unpad();
+	}
+
 protected:
 	// HELPER methods
 
+	// compare the magnitudes of two unpadded edecimals: returns 1 if |a| > |b|, 0 if equal, -1 if |a| < |b|
+	static int compare_magnitude(const edecimal& a, const edecimal& b) {
+		size_t l = a.size();
+		size_t r = b.size();
+		if (l != r) return (l > r ? 1 : -1);
+		for (size_t i = l; i > 0; --i) {
+			if (a[i - 1] != b[i - 1]) return (a[i - 1] > b[i - 1] ? 1 : -1);
+		}
+		return 0;
+	}
+	// |this| += |rhs|
+	void add_magnitude(const edecimal& rhs) {
+		size_t l = size();
+		size_t r = rhs.size();
+		if (l < r) resize(r, 0);
+		limb carry = add_limbs(data(), rhs.data(), r);
+		carry = propagate_carry(data() + r, size() - r, carry);
+		if (carry) push_back(carry);
+	}
+	// |this| -= |rhs|, precondition |this| >= |rhs|
+	void subtract_magnitude(const edecimal& rhs) {
+		size_t r = rhs.size();
+		limb borrow = subtract_limbs(data(), rhs.data(), r);
+		propagate_borrow(data() + r, size() - r, borrow);
+		unpad();
+	}
 	// conversion functions
-	inline short              to_short()       const noexcept { return short(to_long_long()); }
-	inline int                to_int()         const noexcept { return short(to_long_long()); }
-	inline long               to_long()        const noexcept { return short(to_long_long()); }
+	inline short              to_short()       const noexcept { return static_cast<short>(to_long_long()); }
+	inline int                to_int()         const noexcept { return static_cast<int>(to_long_long()); }
+	inline long               to_long()        const noexcept { return static_cast<long>(to_long_long()); }
 	inline long long          to_long_long()   const noexcept {
-		long long v = 0;	
-		long long order = sign() ? -1 : 1;
-		for (edecimal::const_iterator it = this->begin(); it != this->end(); ++it) {
-			v += *it * order;
-			order *= 10;
+		unsigned long long v = 0;
+		for (size_t i = size(); i > 0; --i) {
+			v = v * BASE + operator[](i - 1);
 		}
-		return v;
+		return static_cast<long long>(sign() ? (0ull - v) : v);
 	}
 	inline unsigned short     to_ushort()      const noexcept { return static_cast<unsigned short>(to_ulong_long()); }
 	inline unsigned int       to_uint()        const noexcept { return static_cast<unsigned int>(to_ulong_long()); }
 	inline unsigned long      to_ulong()       const noexcept { return static_cast<unsigned long>(to_ulong_long()); }
 	inline unsigned long long to_ulong_long()  const noexcept { return static_cast<unsigned long long>(to_long_long()); }
-	inline float              to_float()       const noexcept {
-		float f = 0.0f;
-		float order = sign() ? -1.0f : 1.0f;
-		for (edecimal::const_iterator it = this->begin(); it != this->end(); ++it) {
-			f += *it * order;
-			order *= 10.0f;
-		}
-		return f;
-	}
-	inline double             to_double()      const noexcept {
-		double d{ 0.0 };
-		double order = sign() ? -1.0 : 1.0;
-		for (edecimal::const_iterator it = this->begin(); it != this->end(); ++it) {
-			d += *it * order;
-			order *= 10.0;
-		}
-		return d;
-	}
+	inline float              to_float()       const noexcept { return static_cast<float>(to_long_double()); }
+	inline double             to_double()      const noexcept { return static_cast<double>(to_long_double()); }
 	inline long double        to_long_double() const noexcept {
 		long double ld{ 0.0l };
-		long double order = sign() ? -1.0l : 1.0l;
-		for (edecimal::const_iterator it = this->begin(); it != this->end(); ++it) {
-			ld += *it * order;
-			order *= 10.0l;
+		for (size_t i = size(); i > 0; --i) {
+			ld = ld * static_cast<long double>(BASE) + static_cast<long double>(operator[](i - 1));
 		}
-		return ld;
+		return sign() ? -ld : ld;
 	}
 
 	// Convert integer types to a edecimal representation
-// TODO: needs SFINAE enable_if to constrain it to native integer types
 	template<typename Ty>
 	edecimal& convert_integer(Ty v) {
-		using namespace std;
-		//cout << numeric_limits<Ty>::digits << " max value " << numeric_limits<Ty>::max() << endl;
-		bool sign = false;
-		setzero(); // initialize the edecimal value to 0
-		if (v == 0) return *this;
-		if (numeric_limits<Ty>::is_signed) {
+		clear();
+		negative = false;
+		unsigned long long magnitude = static_cast<unsigned long long>(v);
+		if constexpr (std::numeric_limits<Ty>::is_signed) {
 			if (v < 0) {
-				sign = true; // negative number
-				// transform to sign-magnitude on positive side
-				v *= Ty(-1);
-			}
-		}
-		uint64_t mask = 0x1;
-		// IMPORTANT: can't use initializer or assignment operator as it would yield 
-		// an infinite loop calling convert_integer. So we need to construct the
-		// edecimal from first principals
-		edecimal base; // can't use base(1) semantics here as it would cause an infinite loop
-		base.clear();
-		base.push_back(1);
-		while (v) { // minimum loop iterations; exits when no bits left
-			if (v & mask) {
-				*this += base;
+				negative = true;
+				// transform to sign-magnitude on positive side, safe for the most negative value
+				magnitude = 0ull - static_cast<unsigned long long>(static_cast<long long>(v));
 			}
-			base += base;
-			v >>= 1;
 		}
-		// lastly, set the sign
-		setsign(sign);
+		do {
+			push_back(static_cast<limb>(magnitude % BASE));
+			magnitude /= BASE;
+		} while (magnitude);
 		return *this;
 	}
+	// Convert an ieee-754 value to a edecimal representation, truncating the fraction
 	template<typename Ty>
 	edecimal& convert_ieee754(Ty rhs) {
-		clear();
-		if (rhs <= 0.5 && rhs >= -0.5) {
-			return *this = 0;
+		setzero();
+		bool s{ false };
+		uint64_t unbiasedExponent{ 0 };
+		uint64_t fraction{ 0 };
+		uint64_t bits{ 0 };
+		extractFields(rhs, s, unbiasedExponent, fraction, bits);
+		if (unbiasedExponent == ieee754_parameter<Ty>::eallset) return *this; // no representation for inf and nan
+		if (unbiasedExponent == 0) return *this; // zero and subnormals truncate to 0
+
+		constexpr int fbits = static_cast<int>(ieee754_parameter<Ty>::fbits);
+		int scale = static_cast<int>(unbiasedExponent) - ieee754_parameter<Ty>::bias; // original scale of the number
+		if (scale < 0) return *this;
+		if constexpr (fbits < 64) {
+			fraction |= (1ull << fbits); // add in the hidden bit
+		}
+		int shift = scale - fbits;
+		if (shift <= 0) {
+			*this = static_cast<unsigned long long>(fraction >> -shift);
 		}
 		else {
-			if (rhs < -0.5) negative = true; else negative = false;
-
-			bool s{ false };
-			uint64_t unbiasedExponent{ 0 };
-			uint64_t fraction{ 0 };
-			uint64_t bits{ 0 };
-			extractFields(rhs, s, unbiasedExponent, fraction, bits);
-			// TODO: subnormals
-
-			fraction |= (1ull << ieee754_parameter<Ty>::fbits); // add in the hidden bit
-			// scale up by fbits, convert, and then scale back
-			uint64_t mask = 0x1;
-			edecimal base; // can't use base(1) semantics here as it would cause an infinite loop
-			base[0] = 1;
-//			int i = 0;
-			while (fraction) { // minimum loop iterations; exits when no bits left
-//				std::cout << std::setw(3) << i++ << "  base : " << base << '\n';
-				if (fraction & mask) {
-					*this += base;
-				}
-				base += base;
-				fraction >>= 1;
-			}
-//			std::cout << "upconversion : " << *this << " : final bit value: " << base << '\n';
-			int scale = static_cast<int>(unbiasedExponent) - ieee754_parameter<Ty>::bias; // original scale of the number
-			int upScale = ieee754_parameter<Ty>::fbits;
-			int correction = upScale - scale;
-//			std::cout << "correction = " << correction << " scale = " << scale << " upscale = " << upScale << '\n';
-			if (correction >= 0) {
-				edecimal downConvert;
-				downConvert[0] = 1;
-				for (int i = 0; i < correction; ++i) downConvert += downConvert;
-//				std::cout << "downConvert : " << downConvert << '\n';
-				// divide the factor out
-				*this /= downConvert;
-			}
-			else {
-				edecimal upConvert;
-				upConvert[0] = 1;
-				for (int i = 0; i < -correction; ++i) upConvert += upConvert;
-//				std::cout << "upConvert : " << upConvert << '\n';
-				// multiply to add the missing factor
-				*this *= upConvert;
+			*this = static_cast<unsigned long long>(fraction);
+			// scale up by powers of two that fit in a single limb multiply
+			constexpr int maxShift = 29;  // 2^29 < 10^9
+			while (shift > 0) {
+				int s = (shift > maxShift) ? maxShift : shift;
+				multiply_limb(limb(1u) << s, 0);
+				shift -= s;
 			}
 		}
+		negative = s;
 		return *this;
 	}
 
@@ -576,10 +693,9 @@ private:
 
 // find the order of the most significant digit, precondition edecimal is unpadded
 inline int findMsd(const edecimal& v) {
-	int msd = int(v.size()) - 1;
-	if (msd == 0 && v == 0) return -1; // no significant digit found, all digits are zero
-	assert(v.at(static_cast<size_t>(msd)) != 0); // indicates the edecimal wasn't unpadded
-	return msd;
+	if (v.iszero()) return -1; // no significant digit found, all digits are zero
+	assert(v.back() != 0); // indicates the edecimal wasn't unpadded
+	return static_cast<int>(v.digits()) - 1;
 }
 
 
@@ -588,39 +704,23 @@ inline int findMsd(const edecimal& v) {
 /// stream operators
 
 inline std::string to_binary(const edecimal& d) {
-	std::stringstream s;
-	if (d.isneg()) s << '-';
-	for (edecimal::const_reverse_iterator rit = d.rbegin(); rit != d.rend(); ++rit) {
-		s << (int)*rit;
-	}
-	return s.str();
+	std::string s;
+	if (d.isneg()) s.push_back('-');
+	return s.append(d.str());
 }
 
 // generate an ASCII edecimal string
 inline std::string to_string(const edecimal& d) {
-	std::stringstream s;
-	if (d.isneg()) s << '-';
-	for (edecimal::const_reverse_iterator rit = d.rbegin(); rit != d.rend(); ++rit) {
-		s << (int)*rit;
-	}
-	return s.str();
+	std::string s;
+	if (d.isneg()) s.push_back('-');
+	return s.append(d.str());
 }
 
 // generate an ASCII edecimal format and send to ostream
 inline std::ostream& operator<<(std::ostream& ostr, const edecimal& d) {
 	// to make certain that setw and left/right operators work properly
 	// we need to transform the integer into a string
-	std::stringstream ss;
-
-	//std::streamsize width = ostr.width();
-	std::ios_base::fmtflags ff;
-	ff = ostr.flags();
-	ss.flags(ff);
-	if (d.isneg()) ss << '-';
-	for (edecimal::const_reverse_iterator rit = d.rbegin(); rit != d.rend(); ++rit) {
-		ss << (int)*rit;
-	}
-	return ostr << ss.str();
+	return ostr << to_string(d);
 }
 
 // read an ASCII edecimal format from an istream
@@ -696,20 +796,9 @@ bool operator<(const edecimal& lhs, const edecimal& rhs) {
 
 	// signs are the same
 	// this logic assumes that there is no padding in the operands
-	size_t l = lhs.size();
-	size_t r = rhs.size();
-	if (l < r) return lhs.sign() ? false : true;
-	if (l > r) return lhs.sign() ? true : false;
-	// numbers are the same size, need to compare magnitude
-	edecimal::const_reverse_iterator ritl = lhs.rbegin();
-	edecimal::const_reverse_iterator ritr = rhs.rbegin();
-	for (; ritl != lhs.rend() || ritr != rhs.rend(); ++ritl, ++ritr) {
-		if (*ritl < *ritr) return lhs.sign() ? false : true;
-		if (*ritl > *ritr) return lhs.sign() ? true : false;
-		// if the digits are equal we need to check the next set
-	}
-	// at this point we know the two operands are the same
-	return false;
+	int magnitude = edecimal::compare_magnitude(lhs, rhs);
+	if (magnitude == 0) return false;
+	return lhs.sign() ? (magnitude > 0) : (magnitude < 0);
 }
 // greater-than test
 bool operator>(const edecimal& lhs, const edecimal& rhs) {
@@ -764,32 +853,6 @@ inline bool operator>=(long lhs, const edecimal& rhs) {
 	return !operator<(edecimal(lhs), rhs);
 }
 
-///////////////////////////////////////////////////////////////////////
-// 
-// find largest multiplier of rhs being less or equal to lhs by subtraction; assumes 0*rhs <= lhs <= 9*rhs 
-edecimal findLargestMultiple(const edecimal& lhs, const edecimal& rhs) {
-	// check argument assumption	assert(0 <= lhs && lhs >= 9 * rhs);
-	edecimal remainder = lhs;
-	remainder.setpos();
-	edecimal multiplier;
-	multiplier.setdigit(0);
-	for (int i = 0; i <= 11; ++i) {  // function works for 9 into 99, just as an aside
-		if (remainder > 0) {
-			remainder -= rhs;
-			++multiplier;
-		}
-		else {
-			if (remainder < 0) {  // we went too far
-				--multiplier;
-			}
-			// else implies remainder is 0										
-			break;
-		}
-	}
-	return multiplier;
-}
-
-
 ///////////////////////
 // decintdiv_t for edecimal to capture quotient and remainder during long division
 struct decintdiv {
@@ -799,58 +862,34 @@ struct decintdiv {
 
 // divide integer edecimal a and b and return result argument
 decintdiv decint_divide(const edecimal& _a, const edecimal& _b) {
+	decintdiv divresult;
 	if (_b.iszero()) {
 #if EDECIMAL_THROW_ARITHMETIC_EXCEPTION
 		throw edecimal_integer_divide_by_zero{};
 #else
 		std::cerr << "integer_divide_by_zero\n";
+		return divresult;
 #endif // EDECIMAL_THROW_ARITHMETIC_EXCEPTION
 	}
-	// generate the absolute values to do long division 
+	// generate the absolute values to do long division
 	bool a_negative = _a.sign();
 	bool b_negative = _b.sign();
 	bool result_negative = (a_negative ^ b_negative);
-	edecimal a(_a); a.setpos();
-	edecimal b(_b); b.setpos();
-	decintdiv divresult;
+	edecimal a(_a); a.setpos(); a.unpad();
+	edecimal b(_b); b.setpos(); b.unpad();
 	if (a < b) {
 		divresult.quot = 0;
 		divresult.rem = _a; // a % b = a when a / b = 0
 		return divresult; // a / b = 0 when b > a
 	}
-	// initialize the long division
-	edecimal accumulator = a;
-	// prepare the subtractand
-	edecimal subtractand = b;
-	int msd_b = findMsd(b);
-	int msd_a = findMsd(a);
-	int shift = msd_a - msd_b;
-	subtractand <<= shift;
-	// long division
-	for (int i = shift; i >= 0; --i) {
-		if (subtractand <= accumulator) {
-			edecimal multiple = findLargestMultiple(accumulator, subtractand);
-			accumulator -= multiple * subtractand;
-			uint8_t multiplier = static_cast<uint8_t>(int(multiple)); // TODO: fix the ugly
-			divresult.quot.insert(divresult.quot.begin(), multiplier);
-		}
-		else {
-			divresult.quot.insert(divresult.quot.begin(), 0);
-		}
-		subtractand >>= 1;
-		if (subtractand == 0) break;
-	}
-	if (result_negative) {
+	// long division by limbs
+	edecimal::divide(a, b, divresult.quot, divresult.rem);
+	if (result_negative && !divresult.quot.iszero()) {
 		divresult.quot.setneg();
 	}
-	if (_a < 0) {
-		divresult.rem = -accumulator;
-	}
-	else {
-		divresult.rem = accumulator;
+	if (a_negative && !divresult.rem.iszero()) {
+		divresult.rem.setneg();
 	}
-	divresult.quot.unpad();
-	divresult.rem.unpad();
 	return divresult;
 }
 
@@ -863,5 +902,61 @@ edecimal remainder(const edecimal& _a, const edecimal& _b) {
 	return decint_divide(_a, _b).rem;
 }
 
-}} // namespace sw::universal
+///////////////////////////////////////////////////////////////////////
+// conversion between the decimal limbs of edecimal and the binary limbs of einteger
+
+// convert an einteger into a edecimal
+template<typename BlockType>
+edecimal to_edecimal(const einteger<BlockType>& v) {
+	constexpr unsigned bitsInBlock = sizeof(BlockType) * 8;
+	// feed the binary limbs, most significant first, through a multiply-add of at most 16 bits at a time
+	constexpr unsigned bitsInStep = (bitsInBlock > 16) ? 16 : bitsInBlock;
+	constexpr edecimal::limb stepMask = static_cast<edecimal::limb>((1ul << bitsInStep) - 1ul);
+	edecimal d;
+	for (unsigned i = v.limbs(); i > 0; --i) {
+		std::uint64_t block = static_cast<std::uint64_t>(v.block(i - 1));
+		for (int shift = static_cast<int>(bitsInBlock - bitsInStep); shift >= 0; shift -= static_cast<int>(bitsInStep)) {
+			d.multiply_limb(edecimal::limb(1u) << bitsInStep, static_cast<edecimal::limb>((block >> shift) & stepMask));
+		}
+	}
+	d.unpad();
+	if (v.sign() && !d.iszero()) d.setneg();
+	return d;
+}
+
+// convert a edecimal into an einteger
+template<typename BlockType = std::uint32_t>
+einteger<BlockType> to_einteger(const edecimal& d) {
+	constexpr unsigned bitsInBlock = sizeof(BlockType) * 8;
+	// accumulate into 32-bit binary words: word = word * 10^9 + limb, most significant decimal limb first
+	std::vector<std::uint32_t> words;
+	for (size_t i = d.size(); i > 0; --i) {
+		std::uint64_t carry = d[i - 1];
+		for (std::uint32_t& w : words) {
+			std::uint64_t t = static_cast<std::uint64_t>(w) * edecimal::BASE + carry;
+			w = static_cast<std::uint32_t>(t);
+			carry = t >> 32;
+		}
+		if (carry) words.push_back(static_cast<std::uint32_t>(carry));
+	}
+	einteger<BlockType> v;
+	constexpr unsigned blocksInWord = (bitsInBlock < 32) ? 32 / bitsInBlock : 1;
+	unsigned b = 0;
+	for (std::uint32_t w : words) {
+		for (unsigned j = 0; j < blocksInWord; ++j) {
+			v.setblock(b++, static_cast<BlockType>(w >> (j * bitsInBlock)));
+		}
+	}
+	if (!v.iszero()) {
+		// setblock extends the limbs: reassemble to drop any leading zero blocks
+		unsigned top = v.limbs();
+		while (top > 0 && v.block(top - 1) == 0) --top;
+		einteger<BlockType> trimmed;
+		for (unsigned i = 0; i < top; ++i) trimmed.setblock(i, v.block(i));
+		trimmed.setsign(d.sign());
+		return trimmed;
+	}
+	return v;
+}
 
+}} // namespace sw::universal
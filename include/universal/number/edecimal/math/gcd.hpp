@@ -0,0 +1,75 @@
+#pragma once
+// gcd.hpp: greatest common divisor of adaptive precision decimal integers
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <utility>
+
+namespace sw { namespace universal {
+
+	// binary gcd (Stein's algorithm) of two native unsigned integers
+	inline std::uint64_t binary_gcd(std::uint64_t u, std::uint64_t v) {
+		if (u == 0) return v;
+		if (v == 0) return u;
+		int shift = 0;
+		while (((u | v) & 0x1ull) == 0) { u >>= 1; v >>= 1; ++shift; }
+		while ((u & 0x1ull) == 0) u >>= 1;
+		do {
+			while ((v & 0x1ull) == 0) v >>= 1;
+			if (u > v) std::swap(u, v);
+			v -= u;
+		} while (v != 0);
+		return u << shift;
+	}
+
+	// Lehmer's gcd over the base 10^9 limbs of edecimal
+	// The leading two limbs of the operands drive a single-precision Euclid that accumulates
+	// the cofactor matrix [A B; C D], which is then applied to the full-precision operands in one step.
+	// Once the operands fit in 64 bits, the computation finishes with the native binary gcd.
+	inline edecimal gcd(const edecimal& a, const edecimal& b) {
+		using limb = edecimal::limb;
+		constexpr std::uint64_t BASE = edecimal::BASE;
+		edecimal u(a), v(b);
+		u.setpos(); u.unpad();
+		v.setpos(); v.unpad();
+		if (u < v) std::swap(u, v);
+		while (v.size() > 2) {
+			// leading 18 digits of u and the digits of v at the same position
+			size_t n = u.size();
+			std::int64_t uh = static_cast<std::int64_t>(static_cast<std::uint64_t>(u[n - 1]) * BASE + u[n - 2]);
+			std::int64_t vh = 0;
+			if (v.size() == n) vh = static_cast<std::int64_t>(static_cast<std::uint64_t>(v[n - 1]) * BASE);
+			if (v.size() >= n - 1) vh += static_cast<std::int64_t>(static_cast<limb>(v[n - 2]));
+
+			std::int64_t A = 1, B = 0, C = 0, D = 1;
+			while (vh + C > 0 && vh + D > 0) {
+				std::int64_t q  = (uh + A) / (vh + C);
+				std::int64_t q2 = (uh + B) / (vh + D);
+				if (q != q2) break;
+				std::int64_t T = A - q * C; A = C; C = T;
+				T = B - q * D; B = D; D = T;
+				T = uh - q * vh; uh = vh; vh = T;
+			}
+			if (B == 0) {
+				// no progress in single precision: take a full-precision Euclid step
+				edecimal r = u % v;
+				u = std::move(v);
+				v = std::move(r);
+			}
+			else {
+				// the cofactors have alternating signs, so both combinations are non-negative
+				edecimal t = u * edecimal(A) + v * edecimal(B);
+				edecimal w = u * edecimal(C) + v * edecimal(D);
+				u = std::move(t);
+				v = std::move(w);
+			}
+		}
+		if (v.iszero()) return u;
+		// finish in native precision
+		edecimal r = u % v;
+		return edecimal(binary_gcd(static_cast<unsigned long long>(v), static_cast<unsigned long long>(r)));
+	}
+
+}} // namespace sw::universal
@@ -10,6 +10,7 @@
 //#include <universal/number/edecimal/math/error_and_gamma.hpp>
 //#include <universal/number/edecimal/math/exponent.hpp>
 //#include <universal/number/edecimal/math/fractional.hpp>
+#include <universal/number/edecimal/math/gcd.hpp>
 //#include <universal/number/edecimal/math/hyperbolic.hpp>
 //#include <universal/number/edecimal/math/hypot.hpp>
 //#include <universal/number/edecimal/math/logarithm.hpp>
@@ -37,6 +37,19 @@
 #define ERATIONAL_THROW_ARITHMETIC_EXCEPTION 0
 #endif
 
+////////////////////////////////////////////////////////////////////////////////////////
+// enable/disable deferred reduction of numerator/denominator
+// when enabled, the gcd reduction is postponed until the limb count of the numerator or
+// denominator crosses ERATIONAL_REDUCTION_THRESHOLD, or the value is printed
+#if !defined(ERATIONAL_DEFERRED_REDUCTION)
+// default is to reduce after every arithmetic operation
+#define ERATIONAL_DEFERRED_REDUCTION 0
+#endif
+// limb count of numerator or denominator that triggers a deferred reduction
+#if !defined(ERATIONAL_REDUCTION_THRESHOLD)
+#define ERATIONAL_REDUCTION_THRESHOLD 16
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////
 /// INCLUDE FILES that make up the library
 #include <universal/number/erational/exceptions.hpp>
@@ -5,6 +5,7 @@
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 #include <cstdint>
+#include <cmath>
 #include <sstream>
 #include <cassert>
 #include <iostream>
@@ -117,7 +118,7 @@ public:
 			numerator = (negative ? -e : e);
 			denominator = f;
 		}
-		normalize();
+		reduce_if_needed();
 		return *this;
 	}
 	erational& operator-=(const erational& rhs) {
@@ -137,14 +138,14 @@ public:
 			numerator = (negative ? -e : e);
 			denominator = f;
 		}
-		normalize();
+		reduce_if_needed();
 		return *this;
 	}
 	erational& operator*=(const erational& rhs) {
 		numerator *= rhs.numerator;
 		denominator *= rhs.denominator;
 		negative = !((negative && rhs.negative) || (!negative && !rhs.negative));
-		normalize();
+		reduce_if_needed();
 		return *this;
 	}
 	erational& operator/=(const erational& rhs) {
@@ -153,12 +154,12 @@ public:
 			throw erational_divide_by_zero();
 		}
 #else
-		std::cerr << "erational_divide_by_zero\n";
+		if (rhs.iszero()) std::cerr << "erational_divide_by_zero\n";
 #endif
 		negative = !((negative && rhs.negative) || (!negative && !rhs.negative));
 		numerator *= rhs.denominator;
 		denominator *= rhs.numerator;
-		normalize();
+		reduce_if_needed();
 		return *this;
 	}
 
@@ -197,6 +198,9 @@ public:
 	inline void setdenominator(const edecimal& denom) { denominator = denom; }
 	inline void setbits(uint64_t v) { *this = v; } // API to be consistent with the other number systems
 
+	// remove the greatest common divisor from the numerator/denominator pair
+	inline erational& reduce() { normalize(); return *this; }
+
 	// read a erational ASCII format and make a erational type out of it
 	bool parse(const std::string& _digits) {
 		bool bSuccess = false;
@@ -206,55 +210,10 @@ public:
 		std::regex erational_regex("[+-]*[0123456789]+");
 		if (std::regex_match(digits, erational_regex)) {
 			// found a erational representation
-			numerator.clear();
-			auto it = digits.begin();
-			if (*it == '-') {
-				setneg();
-				++it;
-			}
-			else if (*it == '+') {
-				++it;
-			}
-			for (; it != digits.end(); ++it) {
-				uint8_t v;
-				switch (*it) {
-				case '0':
-					v = 0;
-					break;
-				case '1':
-					v = 1;
-					break;
-				case '2':
-					v = 2;
-					break;
-				case '3':
-					v = 3;
-					break;
-				case '4':
-					v = 4;
-					break;
-				case '5':
-					v = 5;
-					break;
-				case '6':
-					v = 6;
-					break;
-				case '7':
-					v = 7;
-					break;
-				case '8':
-					v = 8;
-					break;
-				case '9':
-					v = 9;
-					break;
-				default:
-					v = 0;
-				}
-				numerator.push_back(v);
-			}
-			std::reverse(numerator.begin(), numerator.end());
-			bSuccess = true;
+			bSuccess = numerator.parse(digits);
+			negative = numerator.isneg();
+			numerator.setpos();
+			denominator = 1;
 		}
 		return bSuccess;
 	}
@@ -264,22 +223,35 @@ protected:
 
 	// remove greatest common divisor out of the numerator/denominator pair
 	inline void normalize() {
-		edecimal a, b, r;
-		a = numerator; b = denominator;  // precondition is numerator and denominator are positive
+		// precondition is numerator and denominator are positive
+		if (denominator.iszero()) {
 #if ERATIONAL_THROW_ARITHMETIC_EXCEPTION
-		if (b.iszero()) {
 			throw erational_divide_by_zero();
-		}
 #else
-		std::cerr << "erational_divide_by_zero\n";
+			std::cerr << "erational_divide_by_zero\n";
+			return;
 #endif
-		while (a % b > 0) {
-			r = a % b;
-			a = b;
-			b = r;
 		}
-		numerator /= b;
-		denominator /= b;
+		if (numerator.iszero()) {
+			negative = false;
+			denominator = 1;
+			return;
+		}
+		edecimal g = gcd(numerator, denominator);
+		if (g != 1) {
+			numerator /= g;
+			denominator /= g;
+		}
+	}
+	// reduce after an arithmetic operation: always in eager mode, and only when
+	// the numerator or denominator has grown beyond the threshold in deferred mode
+	inline void reduce_if_needed() {
+#if ERATIONAL_DEFERRED_REDUCTION
+		if (numerator.iszero()) negative = false;
+		if (numerator.limbs() > ERATIONAL_REDUCTION_THRESHOLD || denominator.limbs() > ERATIONAL_REDUCTION_THRESHOLD) normalize();
+#else
+		normalize();
+#endif
 	}
 	// conversion functions
 	// convert to signed int: TODO, SFINEA
@@ -290,7 +262,20 @@ protected:
 	inline UnsignedInt to_unsigned() const { return static_cast<UnsignedInt>(numerator / denominator); }
 	// convert to ieee-754: TODO, SFINEA
 	template<typename Ty>
-	inline Ty to_ieee754() const { return Ty(numerator) / Ty(denominator); }
+	inline Ty to_ieee754() const {
+		// scale numerator and denominator into the dynamic range of the target before dividing
+		constexpr int maxDigits = 40;
+		int numScale = static_cast<int>(numerator.digits()) - maxDigits;
+		int denScale = static_cast<int>(denominator.digits()) - maxDigits;
+		if (numScale < 0) numScale = 0;
+		if (denScale < 0) denScale = 0;
+		edecimal num(numerator), den(denominator);
+		if (numScale > 0) num >>= numScale;
+		if (denScale > 0) den >>= denScale;
+		Ty v = Ty(num) / Ty(den);
+		if (numScale != denScale) v *= std::pow(Ty(10), Ty(numScale - denScale));
+		return (negative ? -v : v);
+	}
 
 	// from signed int: TODO, SFINEA
 	template<typename UnsignedInt>
@@ -317,7 +302,20 @@ protected:
 	// from ieee754: TODO, SFINEA
 	template<typename Real>
 	erational& from_ieee754(Real& rhs) {
-		std::cerr << "TBD" << rhs << std::endl;
+		setzero();
+		if (rhs == Real(0) || std::isnan(rhs) || std::isinf(rhs)) return *this;
+		// rhs = fraction * 2^exponent, with the fraction scaled to an integer
+		int exponent;
+		Real fraction = std::frexp(std::fabs(rhs), &exponent);
+		constexpr int fbits = std::numeric_limits<Real>::digits;
+		fraction = std::ldexp(fraction, fbits < 64 ? fbits : 64);
+		exponent -= (fbits < 64 ? fbits : 64);
+		numerator = static_cast<unsigned long long>(fraction);
+		edecimal power(1);
+		for (int i = 0; i < (exponent < 0 ? -exponent : exponent); ++i) power *= 2;
+		if (exponent > 0) numerator *= power; else denominator = power;
+		negative = (rhs < Real(0));
+		normalize();
 		return *this;
 	}
 
@@ -327,6 +325,32 @@ private:
 	edecimal numerator; // will be managed as a positive number
 	edecimal denominator; // will be managed as a positive number
 
+	// three-way comparison of two rationals, returns -1, 0, or 1
+	// the cross products are only formed when the digit counts do not decide the magnitude ordering
+	static int compare(const erational& lhs, const erational& rhs) {
+		bool lzero = lhs.iszero(), rzero = rhs.iszero();
+		if (lzero && rzero) return 0;
+		bool lneg = !lzero && lhs.negative;
+		bool rneg = !rzero && rhs.negative;
+		if (lneg != rneg) return (lneg ? -1 : 1);
+		int order; // ordering of the magnitudes
+		if (lzero) order = -1;
+		else if (rzero) order = 1;
+		else {
+			// digits(a*d) is in [da+dd-1, da+dd]
+			long long ad = static_cast<long long>(lhs.numerator.digits()) + rhs.denominator.digits();
+			long long bc = static_cast<long long>(lhs.denominator.digits()) + rhs.numerator.digits();
+			if (ad > bc + 1) order = 1;
+			else if (bc > ad + 1) order = -1;
+			else {
+				edecimal a = lhs.numerator * rhs.denominator;
+				edecimal b = lhs.denominator * rhs.numerator;
+				order = (a < b ? -1 : (b < a ? 1 : 0));
+			}
+		}
+		return (lneg ? -order : order);
+	}
+
 	friend std::ostream& operator<<(std::ostream& ostr, const erational& d);
 	friend std::istream& operator>>(std::istream& istr, erational& d);
 
@@ -358,8 +382,10 @@ inline std::string to_string(const erational& d) {
 inline std::ostream& operator<<(std::ostream& ostr, const erational& d) {
 	// make certain that setw and left/right operators work properly
 	std::stringstream str;
-	if (d.isneg()) str << '-';
-	str << d.numerator << '/' << d.denominator;
+	erational v(d);
+	v.normalize();
+	if (v.isneg()) str << '-';
+	str << v.numerator << '/' << v.denominator;
 	return ostr << str.str();
 }
 
@@ -407,7 +433,12 @@ inline erational operator/(const erational& lhs, const erational& rhs) {
 
 // equality test
 bool operator==(const erational& lhs, const erational& rhs) {
-	return lhs.numerator == rhs.numerator && lhs.denominator == rhs.denominator;
+#if ERATIONAL_DEFERRED_REDUCTION
+	return erational::compare(lhs, rhs) == 0;
+#else
+	// reduced forms are unique
+	return lhs.negative == rhs.negative && lhs.numerator == rhs.numerator && lhs.denominator == rhs.denominator;
+#endif
 }
 // inequality test
 bool operator!=(const erational& lhs, const erational& rhs) {
@@ -416,9 +447,7 @@ bool operator!=(const erational& lhs, const erational& rhs) {
 // less-than test
 bool operator<(const erational& lhs, const erational& rhs) {
 	// a/b < c/d  => ad / bd < cb / bd => ad < cb
-	edecimal ad = lhs.numerator * rhs.denominator;
-	edecimal bc = lhs.denominator * rhs.numerator;
-	return ad < bc;
+	return erational::compare(lhs, rhs) < 0;
 }
 // greater-than test
 bool operator>(const erational& lhs, const erational& rhs) {
@@ -426,11 +455,11 @@ bool operator>(const erational& lhs, const erational& rhs) {
 }
 // less-or-equal test
 bool operator<=(const erational& lhs, const erational& rhs) {
-	return operator<(lhs, rhs) || operator==(lhs, rhs);
+	return erational::compare(lhs, rhs) <= 0;
 }
 // greater-or-equal test
 bool operator>=(const erational& lhs, const erational& rhs) {
-	return !operator<(lhs, rhs);
+	return erational::compare(lhs, rhs) >= 0;
 }
 
 // erational - long logic operators
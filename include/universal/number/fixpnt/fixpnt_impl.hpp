@@ -39,7 +39,10 @@ You need the exception types defined, but you have the option to throw them
 
 // composition types used by fixpnt
 #include <universal/internal/blockbinary/blockbinary.hpp>
+#include <universal/traits/fma_traits.hpp>
 #include <universal/number/support/decimal.hpp>
+#include <universal/internal/f2s/dragon.hpp>
+#include <universal/internal/f2s/decimal_parse.hpp>
 #ifdef FIXPNT_SCALE_TRACKING
 #include <universal/utility/scale_tracker.hpp>
 #endif
@@ -318,25 +321,8 @@ public:
 			}
 		}
 		else {
-			std::cout << "found a decimal representation: TBD\n";
-			int64_t scale = 1;
-			int64_t fraction = 0;
-			for (std::string::const_reverse_iterator r = number.rbegin();
-				r != number.rend();
-				++r) {
-				if (*r != '.') {
-					int64_t digit = charLookup.at(*r);
-					fraction += scale * digit;
-					scale *= 10;
-				}
-				else {
-					// construct fraction
-					*this = 0;
-				}
-			}
-			// TODO: implement decimal string parse for fixpnt
-			if (fraction < 0) std::cout << "found a negative decimal representation\n"; // TODO: remove when implemented properly
-			*this = 6.90234375;
+			// decimal representation, correctly rounded to the nearest fixpnt
+			if (!parse(number, *this)) clear();
 		}
 
 		return *this;
@@ -562,6 +548,7 @@ public:
 		// when bitIndex is out-of-bounds, fail silently as no-op
 	}
 	constexpr void setbits(uint64_t value) noexcept { _block.setbits(value); }
+	constexpr void setbits(const blockbinary<nbits, bt, BinaryNumberType::Signed>& bits) noexcept { _block = bits; }
 
 	// specific number system values we would like to have as constexpr
 	// 01111....11111 is max pos
@@ -853,6 +840,35 @@ fixpnt<nbits, rbits, arithmetic, bt> abs(const fixpnt<nbits, rbits, arithmetic,
 	return tmp;
 }
 
+/// fused multiply-add: a * b + c with a single rounding event.
+/// The 2*nbits product is exact, so the addend is aligned to its radix point,
+/// and only the sum is rounded back to rbits fraction bits.
+template<unsigned nbits, unsigned rbits, bool arithmetic, typename bt>
+fixpnt<nbits, rbits, arithmetic, bt> fma(const fixpnt<nbits, rbits, arithmetic, bt>& a, const fixpnt<nbits, rbits, arithmetic, bt>& b, const fixpnt<nbits, rbits, arithmetic, bt>& c) {
+	using Sum = blockbinary<2 * nbits + 1, bt, BinaryNumberType::Signed>;
+	Sum sum = urmul2(a.bits(), b.bits());
+	Sum addend = c.bits();
+	addend <<= static_cast<int>(rbits);
+	sum += addend;
+	bool roundUp = sum.roundingMode(rbits);
+	sum >>= static_cast<int>(rbits);
+	if (roundUp) ++sum;
+
+	fixpnt<nbits, rbits, arithmetic, bt> result;
+	if constexpr (arithmetic == Saturate) {
+		fixpnt<nbits, rbits, arithmetic, bt> maxpos(SpecificValue::maxpos), maxneg(SpecificValue::maxneg);
+		Sum saturation = maxpos.bits();
+		if (sum > saturation) return maxpos;
+		saturation = maxneg.bits();
+		if (sum < saturation) return maxneg;
+	}
+	result.setbits(blockbinary<nbits, bt, BinaryNumberType::Signed>(sum)); // select the lower nbits of the result
+	return result;
+}
+
+template<unsigned nbits, unsigned rbits, bool arithmetic, typename bt>
+struct has_fma_trait< fixpnt<nbits, rbits, arithmetic, bt> > : true_type {};
+
 ////////////////////////    FIXED-POINT functions   /////////////////////////////////
 
 ////////////////////////    FIXED-POINT operators   /////////////////////////////////
@@ -1881,84 +1897,132 @@ inline fixpnt<nbits, rbits, arithmetic, bt> operator%(long double lhs, const fix
 
 ///////////////////////////// IOSTREAM operators ///////////////////////////////////////////////
 
-// convert fixpnt to decimal string, i.e. "-1234.5678"
-template<unsigned nbits, unsigned rbits, bool arithmetic, typename bt>
-std::string convert_to_decimal_string(const fixpnt<nbits, rbits, arithmetic, bt>& value) {
-	std::stringstream str;
-	if (value.iszero()) {
-		str << '0';
-		if constexpr (rbits > 0) {
-			str << '.';
-			for (unsigned i = 0; i < rbits; ++i) {
-				str << '0';
-			}
+// convert a fixpnt to decimal characters in the caller's buffer [first, last) following std::to_chars:
+// without a precision, the result is the shortest decimal that rounds back to the same fixpnt,
+// with a precision, the result is the correctly rounded value in printf %f, %e, or %g format
+template<unsigned nbits, unsigned rbits, bool arithmetic, typename bt>
+std::to_chars_result to_chars(char* first, char* last, const fixpnt<nbits, rbits, arithmetic, bt>& value, std::chars_format fmt = std::chars_format{}, int precision = -1) noexcept {
+	using BlockBinary = blockbinary<nbits, bt, BinaryNumberType::Signed>;
+	constexpr unsigned maxScale = (rbits > nbits - rbits ? rbits : nbits - rbits) + 2u;
+	constexpr unsigned nrLimbs = (nbits + 31u) / 32u;
+	std::uint32_t significand[nrLimbs] = { 0 };
+	BlockBinary raw = value.bits();
+	for (unsigned b = 0; b < BlockBinary::nrBlocks; ++b) {
+		std::uint64_t word = static_cast<std::uint64_t>(raw.block(b));
+		while (word != 0) {
+			unsigned i = b * BlockBinary::bitsInBlock + static_cast<unsigned>(std::countr_zero(word));
+			if (i >= nbits) break;
+			significand[i / 32u] |= (1u << (i % 32u));
+			word &= word - 1u;
 		}
-		return str.str();
 	}
-	if (value.sign()) str << '-';
-	support::decimal partial, multiplier;
-	fixpnt<nbits, rbits, arithmetic, bt> number;
-	number = value.sign() ? sw::universal::twosComplement(value) : value;
-	if constexpr (nbits > rbits) {
-		// convert the fixed point: start by handling the integer part
-		multiplier.setdigit(1);
-		// convert fixpnt to decimal by adding and doubling multipliers
-		for (unsigned i = rbits; i < nbits; ++i) {
-			if (number.at(i)) {
-				support::add(partial, multiplier);
-			}
-			support::add(multiplier, multiplier);
-		}
-		for (support::decimal::const_reverse_iterator rit = partial.rbegin(); rit != partial.rend(); ++rit) {
-			str << (int)*rit;
+	bool sign = value.sign();
+	if (sign) {
+		// magnitude of the two's complement encoding, which is 2^(nbits-1) for maxneg
+		std::uint64_t carry{ 1 };
+		for (unsigned i = 0; i < nrLimbs; ++i) {
+			std::uint64_t limb = static_cast<std::uint64_t>(static_cast<std::uint32_t>(~significand[i])) + carry;
+			significand[i] = static_cast<std::uint32_t>(limb);
+			carry = limb >> 32;
 		}
+		if constexpr ((nbits % 32u) != 0) significand[nrLimbs - 1] &= (0xFFFF'FFFFu >> (32u - nbits % 32u));
 	}
-	else {
-		str << '0';
+	constexpr int lsbScale = -static_cast<int>(rbits);
+	return dragon_to_chars<nbits, maxScale>(first, last, sign, significand, nrLimbs, lsbScale, lsbScale - 1, lsbScale - 1, false, fmt, precision);
+}
+
+// convert the decimal at the start of [first, last) to the nearest fixpnt following std::from_chars:
+// the value is rounded to nearest even at the lsb for any number of digits, and values outside
+// the range saturate to maxpos/maxneg or wrap around depending on the arithmetic of the fixpnt.
+// inf and nan have no fixpnt encoding and are reported as std::errc::invalid_argument
+template<unsigned nbits, unsigned rbits, bool arithmetic, typename bt>
+std::from_chars_result from_chars(const char* first, const char* last, fixpnt<nbits, rbits, arithmetic, bt>& value) noexcept {
+	constexpr unsigned maxScale = (rbits > nbits - rbits ? rbits : nbits - rbits) + 2u;
+	constexpr unsigned nrWords = (nbits + 65u) / 64u;  // at least two bits more than the fixpnt
+	constexpr int pbits = static_cast<int>(parsed_decimal<nrWords>::pbits);
+	constexpr unsigned nrMagWords = (nbits + 64u) / 64u; // magnitude including the rounding carry
+
+	parsed_decimal<nrWords> d;
+	std::from_chars_result r = parse_decimal<nrWords, maxScale, nbits>(first, last, d);
+	if (r.ec != std::errc{}) return r;
+	if (d.nan || d.inf) {
+		r.ptr = first;
+		r.ec = std::errc::invalid_argument;
+		return r;
 	}
-
-	if constexpr (rbits > 0) {
-		str << ".";
-		// and secondly, the fraction part
-		support::decimal range, discretizationLevels, step;
-		// create the decimal range we are discretizing
-		range.setdigit(1);
-		range.shiftLeft(rbits);
-		// calculate the discretization levels of this range
-		discretizationLevels.setdigit(1);
-		for (unsigned i = 0; i < rbits; ++i) {
-			support::add(discretizationLevels, discretizationLevels);
+	value.clear();
+	if (d.zero) return r;
+
+	// msb is the position of the leading significand bit relative to the lsb of the fixpnt
+	int msb = d.scale + static_cast<int>(rbits);
+	if (msb < -1) return r;   // below half an ulp
+	int roundPos = pbits - 1 - msb;
+	// the integer magnitude in units of the lsb is the significand shifted right by roundPos
+	std::uint64_t magnitude[nrMagWords] = { 0 };
+	for (unsigned i = 0; i < nrMagWords; ++i) {
+		int lsb = roundPos + 64 * static_cast<int>(i);
+		if (lsb >= pbits || lsb <= -64) continue;
+		if (lsb < 0) {
+			magnitude[i] = d.significand[0] << -lsb;
 		}
-		step = div(range, discretizationLevels);
-		// now construct the value of this range by adding the fraction samples
-		partial.setzero();
-		multiplier.setdigit(1);
-		// convert the fraction part
-		for (unsigned i = 0; i < rbits; ++i) {
-			if (number.at(i)) {
-				support::add(partial, multiplier);
-			}
-			support::add(multiplier, multiplier);
+		else {
+			unsigned w = static_cast<unsigned>(lsb) / 64u, shift = static_cast<unsigned>(lsb) % 64u;
+			magnitude[i] = d.significand[w] >> shift;
+			if (shift > 0 && w + 1u < nrWords) magnitude[i] |= d.significand[w + 1u] << (64u - shift);
 		}
-		support::mul(partial, step);
-		// leading 0s will cause the partial to be represented incorrectly
-		// if we simply convert it to digits.
-		// The partial represents the parts in the range, so we can deduce
-		// the number of leading zeros by comparing to the length of range
-		unsigned nrLeadingZeros = static_cast<unsigned>(range.size() - partial.size() - 1);
-		for (unsigned i = 0; i < nrLeadingZeros; ++i) str << '0';
-		unsigned digitsWritten = nrLeadingZeros;
-		for (support::decimal::const_reverse_iterator rit = partial.rbegin(); rit != partial.rend(); ++rit) {
-			str << (int)*rit;
-			++digitsWritten;
+	}
+	// round to nearest, ties to even
+	bool guard = d.at(roundPos - 1);
+	bool sticky = d.any(roundPos - 1);
+	if (guard && (sticky || (magnitude[0] & 1u))) {
+		for (unsigned i = 0; i < nrMagWords; ++i) {
+			if (++magnitude[i] != 0) break;
 		}
-		if (digitsWritten < rbits) { // deal with trailing 0s
-			for (unsigned i = digitsWritten; i < rbits; ++i) {
-				str << '0';
-			}
+	}
+
+	// magnitudes beyond 2^(nbits-1) - 1, or beyond 2^(nbits-1) when negative, overflow
+	constexpr unsigned signWord = (nbits - 1u) / 64u, signBit = (nbits - 1u) % 64u;
+	bool above = (msb > static_cast<int>(nbits) - 1) || (magnitude[signWord] >> signBit) > 1u;
+	bool lower = (magnitude[signWord] & ((1ull << signBit) - 1u)) != 0;
+	for (unsigned i = 0; i < nrMagWords; ++i) {
+		if (i > signWord) above = above || magnitude[i] != 0;
+		if (i < signWord) lower = lower || magnitude[i] != 0;
+	}
+	bool overflow = above || (((magnitude[signWord] >> signBit) & 1u) && (!d.sign || lower));
+	if (overflow && arithmetic == Saturate) {
+		if (d.sign) value.maxneg(); else value.maxpos();
+		return r;
+	}
+	if (d.sign) {
+		// two's complement of the magnitude, which wraps around for Modulo arithmetic
+		std::uint64_t carry = 1;
+		for (unsigned i = 0; i < nrMagWords; ++i) {
+			magnitude[i] = ~magnitude[i] + carry;
+			carry = (carry && magnitude[i] == 0) ? 1u : 0u;
 		}
 	}
-	return str.str();
+	if constexpr (nbits <= 64) {
+		value.setbits(magnitude[0]);
+	}
+	else {
+		for (unsigned i = 0; i < nbits; ++i) value.setbit(i, (magnitude[i / 64] >> (i % 64)) & 1u);
+	}
+	return r;
+}
+
+// parse a decimal string into a fixpnt, the entire string needs to be consumed
+template<unsigned nbits, unsigned rbits, bool arithmetic, typename bt>
+bool parse(const std::string& number, fixpnt<nbits, rbits, arithmetic, bt>& value) {
+	const char* last = number.data() + number.size();
+	std::from_chars_result r = from_chars(number.data(), last, value);
+	return (r.ec == std::errc{} && r.ptr == last);
+}
+
+// convert fixpnt to its exact decimal string with rbits fractional digits, i.e. "-1234.5678"
+template<unsigned nbits, unsigned rbits, bool arithmetic, typename bt>
+std::string convert_to_decimal_string(const fixpnt<nbits, rbits, arithmetic, bt>& value) {
+	return dragon_to_string([&](char* first, char* last) { return to_chars(first, last, value, std::chars_format::fixed, static_cast<int>(rbits)); },
+		nbits + rbits + 8u);
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////
@@ -1987,7 +2051,7 @@ inline std::istream& operator>>(std::istream& istr, fixpnt<nbits, rbits, arithme
 	std::string txt;
 	istr >> txt;
 	if (!parse(txt, p)) {
-		std::cerr << "unable to parse -" << txt << "- into a posit value\n";
+		std::cerr << "unable to parse -" << txt << "- into a fixpnt value\n";
 	}
 	return istr;
 }
@@ -32,6 +32,11 @@ struct integer_negative_sqrt_arg : public integer_arithmetic_exception {
 	integer_negative_sqrt_arg() : integer_arithmetic_exception("negative input argument to sqrt function") {}
 };
 
+// modulus that the modular reduction can't work with: Montgomery requires an odd and positive modulus, Barrett a positive modulus
+struct integer_invalid_modulus : public integer_arithmetic_exception {
+	integer_invalid_modulus() : integer_arithmetic_exception("invalid modulus for modular reduction") {}
+};
+
 // encoding exception for Whole Integers
 struct integer_wholenumber_cannot_be_zero : public integer_encoding_exception {
 	integer_wholenumber_cannot_be_zero() : integer_encoding_exception("whole numbers can't be zero") {}
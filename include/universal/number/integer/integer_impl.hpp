@@ -17,6 +17,8 @@
 #include <universal/number/shared/specific_value_encoding.hpp>
 #include <universal/number/shared/blocktype.hpp>
 #include <universal/native/integers.hpp> // just for printing native integers in binary form
+#include <universal/internal/uint128/limbs.hpp>
+#include <universal/internal/uint128/limb_algorithms.hpp>
 
 /*
 the integer arithmetic can be configured to:
@@ -280,15 +282,13 @@ public:
 		}
 		else {
 			integer<nbits, BlockType, NumberType> sum;
-			std::uint64_t carry = 0;
+			BlockType carry = 0;
 			BlockType* pA = _block;
 			BlockType const* pB = rhs._block;
 			BlockType* pC = sum._block;
 			BlockType* pEnd = pC + nrBlocks;
 			while (pC != pEnd) {
-				carry += static_cast<std::uint64_t>(*pA) + static_cast<std::uint64_t>(*pB);
-				*pC = static_cast<bt>(carry);
-				if constexpr (bitsInBlock == 64) carry = 0; else carry >>= bitsInBlock;
+				*pC = limb_addc(*pA, *pB, carry);
 				++pA; ++pB; ++pC;
 			}
 			// enforce precondition for fast comparison by properly nulling bits that are outside of nbits
@@ -326,69 +326,30 @@ public:
 		return *this;
 	}
 	integer& operator*=(const integer& rhs) {
-		if constexpr (NumberType == IntegerNumberType::IntegerNumber) {
-			if constexpr (nrBlocks == 1) {
-				_block[0] = static_cast<bt>(_block[0] * rhs.block(0));
-			}
-			else {
-				// is there a better way than upconverting to deal with maxneg in a 2's complement encoding?
-				integer<nbits + 1, BlockType, NumberType> base(*this);
-				integer<nbits + 1, BlockType, NumberType> multiplicant(rhs);
-				bool resultIsNeg = (base.isneg() ^ multiplicant.isneg());
-				if (base.isneg()) {
-					base.twosComplement();
-				}
-				if (multiplicant.isneg()) {
-					multiplicant.twosComplement();
-				}
-				clear();
-				for (unsigned i = 0; i < static_cast<unsigned>(nrBlocks); ++i) {
-					std::uint64_t segment(0);
-					for (unsigned j = 0; j < static_cast<unsigned>(nrBlocks); ++j) {
-						segment += static_cast<std::uint64_t>(base.block(i)) * static_cast<std::uint64_t>(multiplicant.block(j));
-
-						if (i + j < static_cast<unsigned>(nrBlocks)) {
-							segment += _block[i + j];
-							_block[i + j] = static_cast<bt>(segment);
-							segment >>= bitsInBlock;
-						}
-					}
-				}
-				if (resultIsNeg) twosComplement();
-			}
+		if constexpr (nrBlocks == 1) {
+			_block[0] = static_cast<bt>(_block[0] * rhs.block(0));
 		}
-		else {  // whole and natural numbers are closed under multiplication (modulo)
-			if constexpr (nrBlocks == 1) {
-				_block[0] = static_cast<bt>(_block[0] * rhs.block(0));
-			}
-			else {
-				integer<nbits, BlockType, NumberType> base(*this), multiplicant(rhs);
-				clear();
-				for (unsigned i = 0; i < static_cast<unsigned>(nrBlocks); ++i) {
-					std::uint64_t segment(0);
-					for (unsigned j = 0; j < static_cast<unsigned>(nrBlocks); ++j) {
-						segment += static_cast<std::uint64_t>(base.block(i)) * static_cast<std::uint64_t>(multiplicant.block(j));
-
-						if (i + j < static_cast<unsigned>(nrBlocks)) {
-							segment += _block[i + j];
-							_block[i + j] = static_cast<bt>(segment);
-							segment >>= bitsInBlock;
-						}
-					}
-				}
+		else {
+			// the 2's complement product modulo 2^nbits is the product of the unsigned encodings modulo 2^nbits,
+			// so integer, whole, and natural numbers all reduce to a truncated product of the limbs
+			bt a[nrBlocks], b[nrBlocks];
+			for (unsigned i = 0; i < nrBlocks; ++i) {
+				a[i] = _block[i];
+				b[i] = rhs._block[i];
 			}
+			limb_mullo_n<nrBlocks>(_block, a, b, nrBlocks);  // Karatsuba when nrBlocks reaches limb_karatsuba_threshold
 		}
 		// null any leading bits that fall outside of nbits
 		_block[MSU] = static_cast<bt>(MSU_MASK & _block[MSU]);
 		return *this;
 	}
 	integer& operator*=(const BlockType& scale) noexcept {
-		std::uint64_t scaleFactor(scale), segment(0);
+		BlockType carry(0);
 		for (unsigned i = 0; i < nrBlocks; ++i) {
-			segment += static_cast<std::uint64_t>(_block[i]) * scaleFactor;
-			_block[i] = static_cast<BlockType>(segment);
-			segment >>= bitsInBlock;
+			_block[i] = limb_muladd(_block[i], scale, BlockType(0), carry);
 		}
+		// null any leading bits that fall outside of nbits
+		_block[MSU] = static_cast<bt>(MSU_MASK & _block[MSU]);
 		return *this;
 	}
 	integer& operator/=(const integer& rhs) {
@@ -819,7 +780,7 @@ public:
 		if (n < (1 + ((nbits - 1) >> 2))) {
 			bt word = _block[(n * 4) / bitsInBlock];
 			int nibbleIndexInWord = int(n % (bitsInBlock >> 2ull));
-			bt mask = bt(0xF << (nibbleIndexInWord * 4));
+			bt mask = bt(bt(0xF) << (nibbleIndexInWord * 4));
 			bt nibblebits = bt(mask & word);
 			return uint8_t(nibblebits >> (nibbleIndexInWord * 4));
 		}
@@ -836,168 +797,9 @@ public:
 			return;
 #endif // INTEGER_THROW_ARITHMETIC_EXCEPTION
 		}
-
-		if (a.iszero()) {
-			clear();
-			r.clear();
-			return;
-		}
-		if constexpr (nrBlocks == 1) { // completely reduce this to native div and rem
-			BlockType _a = a._block[0];
-			BlockType _b = b._block[0];
-			if constexpr (NumberType == IntegerNumber) {
-				bool sign_a = _a & SIGN_BIT_MASK;
-				bool sign_b = _b & SIGN_BIT_MASK;
-				if constexpr (8 == bitsInBlock) {
-					std::int8_t a0 = (sign_a ? SIGN_EXTENTION_BITS | _a : _a);
-					std::int8_t b0 = (sign_b ? SIGN_EXTENTION_BITS | _b : _b);
-					*this = static_cast<BlockType>(a0 / b0);
-					r = static_cast<BlockType>(a0 % b0);
-				}
-				else if constexpr (16 == bitsInBlock) {
-					std::int16_t a0 = (sign_a ? SIGN_EXTENTION_BITS | _a : _a);
-					std::int16_t b0 = (sign_b ? SIGN_EXTENTION_BITS | _b : _b);
-					*this = static_cast<BlockType>(a0 / b0);
-					r = static_cast<BlockType>(a0 % b0);
-				}
-				else if constexpr (32 == bitsInBlock) {
-					std::int32_t a0 = (sign_a ? SIGN_EXTENTION_BITS | _a : _a);
-					std::int32_t b0 = (sign_b ? SIGN_EXTENTION_BITS | _b : _b);
-					*this = static_cast<BlockType>(a0 / b0);
-					r = static_cast<BlockType>(a0 % b0);
-				}
-				else {
-					std::int64_t a0 = (sign_a ? SIGN_EXTENTION_BITS | _a : _a);
-					std::int64_t b0 = (sign_b ? SIGN_EXTENTION_BITS | _b : _b);
-					*this = static_cast<BlockType>(a0 / b0);
-					r = static_cast<BlockType>(a0 % b0);
-				}
-			}
-			else {
-				*this = static_cast<BlockType>(_a / _b);
-				r = static_cast<BlockType>(_a % _b);
-			}
-		}
-		else {
-			clear();
-			// no need to constexpr guard this for IntegerNumber as sign() will return false for Whole and Natural Numbers
-			bool sign_a = a.sign();
-			bool sign_b = b.sign();
-			bool sign_q = sign_a ^ sign_b;
-			using Integer = integer<nbits+1, BlockType, NumberType>; // nbits+1 to deal with maxneg
-			Integer _a(a), _b(b);
-			if (sign_a) _a.twosComplement();
-			if (sign_b) _b.twosComplement();			
-			
-			// filter out the easy stuff
-			if (_a < _b) { r = a; clear(); return; }
-
-			// determine first non-zero limbs
-			unsigned m{ 0 }, n{ 0 };
-			for (unsigned i = nrBlocks; i > 0; --i) {
-				if (_a.block(i - 1) != 0) {
-					m = static_cast<unsigned>(i);
-					break;
-				}
-			}
-			for (unsigned i = nrBlocks; i > 0; --i) {
-				if (_b.block(i - 1) != 0) {
-					n = static_cast<unsigned>(i);
-					break;
-				}
-			}
-
-			// single limb divisor
-			if (n == 1) {
-				std::uint64_t remainder{ 0 };
-				auto divisor = _b.block(0);
-				for (unsigned j = m; j > 0; --j) {
-					std::uint64_t dividend = remainder * BASE + _a.block(j - 1);
-					std::uint64_t limbQuotient = dividend / divisor;
-					_block[j - 1] = static_cast<BlockType>(limbQuotient);
-					remainder = dividend - limbQuotient * divisor;
-				}
-				r._block[0] = static_cast<BlockType>(remainder);
-				if (sign_q) twosComplement();
-				return;
-			}
-
-			// Knuth's algorithm calculates a normalization factor d
-			// that perfectly aligns b so that b0 >= floor(BASE/2),
-			// a requirement for the relationship: (qHat - 2) <= q <= qHat
-
-			using OriginalInteger = integer<nbits, BlockType, NumberType>;
-			using ExpandedInteger = integer<nbits + sizeof(BlockType) * 8, BlockType, NumberType>; // need room for overflow to receive the normalization bits
-
-			int shift = nlz(b.block(n - 1));
-			ExpandedInteger normalized_a;
-			normalized_a.setblock(m, static_cast<BlockType>((_a.block(m - 1) >> (bitsInBlock - shift))));
-			for (unsigned i = m - 1; i > 0; --i) {
-				normalized_a.setblock(i, static_cast<BlockType>((_a.block(i) << shift) | (_a.block(i - 1) >> (bitsInBlock - shift))));
-			}
-			normalized_a.setblock(0, static_cast<BlockType>(_a.block(0) << shift));
-			// normalize b
-			OriginalInteger normalized_b;
-			unsigned n_minus_1 = n - 1;
-			for (unsigned i = n_minus_1; i > 0; --i) {
-				normalized_b.setblock(i, static_cast<BlockType>((_b.block(i) << shift) | (_b.block(i - 1) >> (bitsInBlock - shift))));
-			}
-			normalized_b.setblock(0, static_cast<BlockType>(_b.block(0) << shift));
-
-//			std::cout << "normalized a : " << normalized_a.showLimbs() << " : " << normalized_a.showLimbValues() << '\n';
-//			std::cout << "normalized b :             " << normalized_b.showLimbs() << " : " << normalized_b.showLimbValues() << '\n';
-
-			// divide by limb
-			std::uint64_t divisor = normalized_b._block[n - 1];
-			std::uint64_t v_nminus2 = normalized_b._block[n - 2]; // n > 1 at this point
-			for (int j = static_cast<int>(m - n); j >= 0; --j) {
-				std::uint64_t dividend = normalized_a.block(j + n) * BASE + normalized_a.block(j + n - 1);
-				std::uint64_t qhat = dividend / divisor;
-				std::uint64_t rhat = dividend - qhat * divisor;
-
-				while (qhat >= BASE || qhat * v_nminus2 > BASE * rhat + normalized_a.block(j + n - 2)) {
-					--qhat;
-					rhat += divisor;
-					if (rhat < BASE) continue;
-				}
-				std::uint64_t borrow{ 0 };
-				std::uint64_t diff{ 0 };
-				for (unsigned i = 0; i < n; ++i) {
-					std::uint64_t p = qhat * normalized_b.block(i);
-					diff = normalized_a.block(i + j) - static_cast<BlockType>(p) - borrow;
-					normalized_a.setblock(i + j, static_cast<BlockType>(diff));
-					borrow = (p >> bitsInBlock) - (diff >> bitsInBlock);
-				}
-				std::int64_t signedBorrow = static_cast<int64_t>(normalized_a.block(j + n) - borrow);
-				normalized_a.setblock(j + n, static_cast<BlockType>(signedBorrow));
-
-//				std::cout << "   updated a : " << normalized_a.showLimbs() << " : " << normalized_a.showLimbValues() << '\n';
-
-				setblock(static_cast<unsigned>(j), static_cast<BlockType>(qhat));
-				if (signedBorrow < 0) { // subtracted too much, add back
-					std::cout << "subtracted too much, add back\n";
-					_block[j] -= 1;
-					std::uint64_t carry{ 0 };
-					for (unsigned i = 0; i < n; ++i) {
-						carry += static_cast<std::uint64_t>(normalized_a.block(i + j)) + static_cast<std::uint64_t>(normalized_b.block(i));
-						normalized_a.setblock(i + j, static_cast<BlockType>(carry));
-						carry >>= 32;
-					}
-					BlockType rectified = static_cast<BlockType>(normalized_a.block(j + n) + carry);
-					normalized_a.setblock(j + n, rectified);
-				}
-//				std::cout << "   updated a : " << normalized_a.showLimbs() << " : " << normalized_a.showLimbValues() << '\n';
-			}
-			if (sign_q) twosComplement();
-
-			// remainder needs to be normalized
-			for (unsigned i = 0; i < n - 1; ++i) {
-				std::uint64_t remainder = static_cast<uint64_t>(normalized_a.block(i) >> shift);
-				remainder |= static_cast<uint64_t>(normalized_a.block(i + 1) << (32 - shift));
-				r.setblock(i, static_cast<BlockType>(remainder));
-			}
-			r.setblock(n - 1, static_cast<BlockType>(normalized_a.block(n - 1) >> shift));
-		}
+		idiv_t<nbits, BlockType, NumberType> divresult = idiv<nbits, BlockType, NumberType>(a, b);
+		*this = divresult.quot;
+		r = divresult.rem;
 	}
 	// signed integer conversion
 	template<typename SignedInt>
@@ -1322,77 +1124,43 @@ idiv_t<nbits, BlockType, NumberType> idiv(const integer<nbits, BlockType, Number
 	divresult.rem = 0;
 	divresult.quot = 0;
 
-	// generate the absolute values to do long division
+	// long division on the magnitudes: Knuth's algorithm D over the limbs
+	// 2's complement special case -max requires an signed int that is 1 bit bigger to represent abs()
+	using Magnitude = integer<nbits + 1, BlockType, NumberType>;
+	constexpr unsigned nrLimbs = Magnitude::nrBlocks;
+	bool a_negative = _a.sign();
+	bool b_negative = _b.sign();
+	Magnitude a(_a), b(_b);
 	if constexpr (NumberType == IntegerNumberType::IntegerNumber) {
-		using Integer = integer<nbits+1, BlockType, NumberType>;
-		// 2's complement special case -max requires an signed int that is 1 bit bigger to represent abs()
-		bool a_negative = _a.sign();
-		bool b_negative = _b.sign();
-		bool result_negative = (a_negative ^ b_negative);
-		Integer a; a.bitcopy(a_negative ? -_a : _a);
-		Integer b; b.bitcopy(b_negative ? -_b : _b);
-
-		if (a < b) {
-			divresult.quot = 0; // a / b = 0
-			divresult.rem = _a; // a % b = a when a / b = 0
-			return divresult;
-		}
-		// initialize the long division
-		integer<nbits + 1, BlockType, NumberType> accumulator = a;
-		// prepare the subtractand
-		integer<nbits + 1, BlockType, NumberType> subtractand = b;
-		int msb_b = findMsb(b);
-		int msb_a = findMsb(a);
-		int shift = msb_a - msb_b;
-		subtractand <<= shift;
-		divresult.quot = 0;
-		// long division
-		for (int i = shift; i >= 0; --i) {
-			if (subtractand <= accumulator) {
-				accumulator -= subtractand;
-				divresult.quot.setbit(static_cast<unsigned>(i));
-			}
-			else {
-				divresult.quot.setbit(static_cast<unsigned>(i), false);
-			}
-			subtractand >>= 1;
-			//		std::cout << "i = " << i << " subtractand : " << long(subtractand) << '\n';
-		}
-		if (result_negative) {  // take 2's complement
-			divresult.quot.flip();
-			divresult.quot += 1;
-		}
-		if (_a.isneg()) {
-			divresult.rem = -accumulator;
-		}
-		else {
-			divresult.rem = accumulator;
-		}
-	}
-	else {
-		if (_a < _b) {
-			divresult.rem = _a; // a % b = a when a / b = 0
-			return divresult; // a / b = 0 when b > a
-		}
-		using Integer = integer<nbits, BlockType, NumberType>;
-		Integer accumulator(_a), subtractand(_b);
-		int msb_b = findMsb(_b);
-		int msb_a = findMsb(_a);
-		int shift = msb_a - msb_b;
-		subtractand <<= shift;
-		// long division
-		for (int i = shift; i >= 0; --i) {
-			if (subtractand <= accumulator) {
-				accumulator -= subtractand;
-				divresult.quot.setbit(static_cast<unsigned>(i));
-			}
-			else {
-				divresult.quot.setbit(static_cast<unsigned>(i), false);
-			}
-			subtractand >>= 1;
-			//		std::cout << "i = " << i << " subtractand : " << long(subtractand) << '\n';
-		}
-		divresult.rem = accumulator;
+		if (a_negative) a.twosComplement();
+		if (b_negative) b.twosComplement();
+	}
+	BlockType u[nrLimbs], v[nrLimbs];
+	unsigned m{ 0 }, n{ 0 };
+	for (unsigned i = 0; i < nrLimbs; ++i) {
+		u[i] = a.block(i);
+		v[i] = b.block(i);
+		if (u[i] != 0) m = i + 1;
+		if (v[i] != 0) n = i + 1;
+	}
+	if (n == 0) return divresult;
+	if (m < n) {
+		divresult.rem = _a; // a % b = a when a / b = 0
+		return divresult;
+	}
+	BlockType q[nrLimbs] = { 0 }, r[nrLimbs] = { 0 };
+	BlockType scratch[limb_divmod_scratch(nrLimbs, nrLimbs)];
+	limb_divmod(q, r, u, m, v, n, scratch);
+	Magnitude quot, rem;
+	for (unsigned i = 0; i < nrLimbs; ++i) {
+		quot.setblock(i, q[i]);
+		rem.setblock(i, r[i]);
+	}
+	divresult.quot.bitcopy(quot);
+	divresult.rem.bitcopy(rem);
+	if constexpr (NumberType == IntegerNumberType::IntegerNumber) {
+		if (a_negative ^ b_negative) divresult.quot.twosComplement();
+		if (a_negative) divresult.rem.twosComplement();  // the remainder takes the sign of the dividend
 	}
 
 	return divresult;
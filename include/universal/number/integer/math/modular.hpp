@@ -0,0 +1,238 @@
+#pragma once
+// modular.hpp: Montgomery and Barrett modular multiplication and exponentiation for integers
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/internal/uint128/limb_algorithms.hpp>
+#include <universal/number/integer/exceptions.hpp>
+
+/*
+   Modular multiplication a * b mod N without a long division per product.
+
+   montgomery<Integer> keeps residues in the form aR mod N, with R = B^k the smallest power of the
+   limb base B that exceeds N. The product of two such residues is brought back into range by REDC,
+   which only needs multiplications by -N^-1 mod B and shifts by whole limbs. N must be odd.
+
+   barrett<Integer> keeps residues in the plain form and replaces the division by N with two
+   multiplications by the precomputed mu = floor(B^2k / N). It works for any positive N.
+
+   Both work on the limbs of the integer encoding. The operand products run through the Karatsuba
+   multiply of limb_algorithms.hpp, so for the 1024-bit and larger moduli of the cryptography
+   experiments the O(n^2) schoolbook product is replaced by O(n^1.58). The residues and the modulus
+   are non-negative values of the integer type.
+*/
+
+namespace sw { namespace universal {
+
+namespace internal {
+
+	// modexp with a fixed 4-bit window: 16 precomputed powers, one multiply per window
+	template<typename Residue, typename Multiply>
+	Residue modexp_window(const Residue& one, const Residue& x, const Residue& exponent, Multiply mul) {
+		constexpr unsigned windowBits = 4;
+		Residue powers[1u << windowBits];
+		powers[0] = one;
+		for (unsigned i = 1; i < (1u << windowBits); ++i) powers[i] = mul(powers[i - 1], x);
+		int msb = findMsb(exponent);
+		if (msb < 0) return one;
+		unsigned nrWindows = static_cast<unsigned>(msb) / windowBits + 1;
+		Residue result = one;
+		for (unsigned w = nrWindows; w-- > 0;) {
+			for (unsigned s = 0; s < windowBits; ++s) result = mul(result, result);
+			unsigned digit = 0;
+			for (unsigned b = windowBits; b-- > 0;) digit = (digit << 1) | (exponent.test(w * windowBits + b) ? 1u : 0u);
+			if (digit != 0) result = mul(result, powers[digit]);
+		}
+		return result;
+	}
+
+	// number of significant limbs of a, 0 for zero
+	template<typename IntegerType>
+	unsigned significant_limbs(const IntegerType& a) {
+		for (unsigned i = IntegerType::nrBlocks; i > 0; --i) {
+			if (a.block(i - 1) != 0) return i;
+		}
+		return 0;
+	}
+
+	// a mod N in [0, N) for a positive modulus N
+	template<typename IntegerType>
+	IntegerType residue(const IntegerType& a, const IntegerType& N) {
+		IntegerType r = a % N;
+		if (r.sign()) r += N;
+		return r;
+	}
+
+} // namespace internal
+
+// Montgomery representation and arithmetic modulo an odd modulus
+template<typename IntegerType>
+class montgomery {
+public:
+	using BlockType = typename IntegerType::BlockType;
+	static constexpr unsigned nrLimbs = IntegerType::nrBlocks;
+	static constexpr unsigned bitsInBlock = sizeof(BlockType) * 8;
+
+	explicit montgomery(const IntegerType& modulus) : _N{ modulus }, _k{ 0 }, _n0inv{ 0 }, _n{}, _one{}, _r2{} {
+		if (modulus.iseven() || modulus.sign() || modulus.iszero()) {
+#if INTEGER_THROW_ARITHMETIC_EXCEPTION
+			throw integer_invalid_modulus{};
+#else
+			std::cerr << "integer_invalid_modulus: montgomery requires an odd and positive modulus\n";
+			return;
+#endif
+		}
+		_k = internal::significant_limbs(modulus);
+		for (unsigned i = 0; i < nrLimbs; ++i) _n[i] = modulus.block(i);
+
+		// -N^-1 mod B by Newton iteration: x = N0 is correct to 3 bits, every step doubles the correct bits
+		BlockType x = _n[0];
+		for (unsigned bits = 3; bits < bitsInBlock; bits *= 2) x = static_cast<BlockType>(x * static_cast<BlockType>(2u - _n[0] * x));
+		_n0inv = static_cast<BlockType>(BlockType(0) - x);
+
+		// R mod N and R^2 mod N, with R = B^k
+		BlockType u[2 * nrLimbs + 1] = { 0 }, q[2 * nrLimbs + 1], r[nrLimbs], scratch[limb_divmod_scratch(2 * nrLimbs + 1, nrLimbs)];
+		u[_k] = 1;
+		limb_divmod(q, r, u, _k + 1, _n, _k, scratch);
+		for (unsigned i = 0; i < _k; ++i) _one.setblock(i, r[i]);
+		for (unsigned i = 0; i <= _k; ++i) u[i] = 0;
+		u[2 * _k] = 1;
+		limb_divmod(q, r, u, 2 * _k + 1, _n, _k, scratch);
+		for (unsigned i = 0; i < _k; ++i) _r2.setblock(i, r[i]);
+	}
+
+	const IntegerType& modulus() const noexcept { return _N; }
+
+	// aR mod N, for a in [0, N)
+	IntegerType to_montgomery(const IntegerType& a) const { return mul(a, _r2); }
+	// aR^-1 mod N, for a in [0, N)
+	IntegerType from_montgomery(const IntegerType& a) const { return mul(a, IntegerType(1)); }
+
+	// abR^-1 mod N, for a and b in [0, N): the product of two Montgomery residues
+	IntegerType mul(const IntegerType& a, const IntegerType& b) const {
+		BlockType x[nrLimbs], y[nrLimbs], t[2 * nrLimbs + 1];
+		for (unsigned i = 0; i < nrLimbs; ++i) {
+			x[i] = a.block(i);
+			y[i] = b.block(i);
+		}
+		limb_mul_n<nrLimbs>(t, x, y, _k);
+		t[2 * _k] = 0;
+		// REDC: add multiples of N that clear the low k limbs, then shift them out
+		for (unsigned i = 0; i < _k; ++i) {
+			BlockType m = static_cast<BlockType>(t[i] * _n0inv);
+			BlockType carry{ 0 };
+			for (unsigned j = 0; j < _k; ++j) t[i + j] = limb_muladd(m, _n[j], t[i + j], carry);
+			limb_add_1(t + i + _k, _k + 1 - i, carry);
+		}
+		// t / R < 2N
+		BlockType* r = t + _k;
+		if (r[_k] != 0 || limb_cmp(r, _n, _k) >= 0) limb_sub_n(r, r, _n, _k);
+		IntegerType result{};
+		for (unsigned i = 0; i < _k; ++i) result.setblock(i, r[i]);
+		return result;
+	}
+
+	// base^exponent mod N, for a non-negative exponent
+	IntegerType modexp(const IntegerType& base, const IntegerType& exponent) const {
+		IntegerType x = to_montgomery(internal::residue(base, _N));
+		auto mul = [this](const IntegerType& a, const IntegerType& b) { return this->mul(a, b); };
+		return from_montgomery(internal::modexp_window(_one, x, exponent, mul));
+	}
+
+private:
+	IntegerType _N;
+	unsigned    _k;               // number of significant limbs of N, R = B^k
+	BlockType   _n0inv;           // -N^-1 mod B
+	BlockType   _n[nrLimbs];
+	IntegerType _one;             // R mod N, the Montgomery form of 1
+	IntegerType _r2;              // R^2 mod N
+};
+
+// Barrett reduction modulo a positive modulus
+template<typename IntegerType>
+class barrett {
+public:
+	using BlockType = typename IntegerType::BlockType;
+	static constexpr unsigned nrLimbs = IntegerType::nrBlocks;
+
+	explicit barrett(const IntegerType& modulus) : _N{ modulus }, _k{ 0 }, _n{}, _mu{} {
+		if (modulus.sign() || modulus.iszero()) {
+#if INTEGER_THROW_ARITHMETIC_EXCEPTION
+			throw integer_invalid_modulus{};
+#else
+			std::cerr << "integer_invalid_modulus: barrett requires a positive modulus\n";
+			return;
+#endif
+		}
+		_k = internal::significant_limbs(modulus);
+		for (unsigned i = 0; i < nrLimbs; ++i) _n[i] = modulus.block(i);
+
+		// mu = floor(B^2k / N), at most k+1 limbs
+		BlockType u[2 * nrLimbs + 1] = { 0 }, q[2 * nrLimbs + 1] = { 0 }, r[nrLimbs], scratch[limb_divmod_scratch(2 * nrLimbs + 1, nrLimbs)];
+		u[2 * _k] = 1;
+		limb_divmod(q, r, u, 2 * _k + 1, _n, _k, scratch);
+		for (unsigned i = 0; i <= _k; ++i) _mu[i] = q[i];
+	}
+
+	const IntegerType& modulus() const noexcept { return _N; }
+
+	// a * b mod N, for a and b in [0, N)
+	IntegerType mul(const IntegerType& a, const IntegerType& b) const {
+		BlockType x[nrLimbs], y[nrLimbs], t[2 * nrLimbs];
+		for (unsigned i = 0; i < nrLimbs; ++i) {
+			x[i] = a.block(i);
+			y[i] = b.block(i);
+		}
+		limb_mul_n<nrLimbs>(t, x, y, _k);
+		return reduce(t);
+	}
+
+	// a mod N, for a in [0, B^2k)
+	IntegerType reduce(const BlockType* a) const {
+		constexpr unsigned w = nrLimbs + 1;
+		BlockType q1[w]{}, q2[2 * w], r2[w], n[w], r[w];
+		unsigned k1 = _k + 1;
+		// q1 = floor(a / B^(k-1)), q3 = floor(q1 * mu / B^(k+1)) underestimates the quotient by at most 2
+		for (unsigned i = 0; i < k1; ++i) q1[i] = a[_k - 1 + i];
+		limb_mul_n<w>(q2, q1, _mu, k1);
+		const BlockType* q3 = q2 + k1;
+		// r = (a - q3 * N) mod B^(k+1)
+		for (unsigned i = 0; i < _k; ++i) n[i] = _n[i];
+		n[_k] = 0;
+		limb_mullo_n<w>(r2, q3, n, k1);
+		limb_sub_n(r, a, r2, k1);
+		while (r[_k] != 0 || limb_cmp(r, n, _k) >= 0) {
+			limb_sub_n(r, r, n, k1);
+		}
+		IntegerType result{};
+		for (unsigned i = 0; i < _k; ++i) result.setblock(i, r[i]);
+		return result;
+	}
+
+	// base^exponent mod N, for a non-negative exponent
+	IntegerType modexp(const IntegerType& base, const IntegerType& exponent) const {
+		IntegerType x = internal::residue(base, _N);
+		IntegerType one = internal::residue(IntegerType(1), _N);
+		auto mul = [this](const IntegerType& a, const IntegerType& b) { return this->mul(a, b); };
+		return internal::modexp_window(one, x, exponent, mul);
+	}
+
+private:
+	IntegerType _N;
+	unsigned    _k;               // number of significant limbs of N
+	BlockType   _n[nrLimbs];
+	BlockType   _mu[nrLimbs + 1]; // floor(B^2k / N)
+};
+
+// base^exponent mod modulus, for a positive modulus and a non-negative exponent:
+// Montgomery for an odd modulus, Barrett otherwise
+template<unsigned nbits, typename BlockType, IntegerNumberType NumberType>
+integer<nbits, BlockType, NumberType> modexp(const integer<nbits, BlockType, NumberType>& base, const integer<nbits, BlockType, NumberType>& exponent, const integer<nbits, BlockType, NumberType>& modulus) {
+	using Integer = integer<nbits, BlockType, NumberType>;
+	if (modulus.isodd()) return montgomery<Integer>(modulus).modexp(base, exponent);
+	return barrett<Integer>(modulus).modexp(base, exponent);
+}
+
+}} // namespace sw::universal
@@ -14,6 +14,7 @@
 // no hypot
 // no logarithmic functions
 #include <universal/number/integer/math/minmax.hpp>
+#include <universal/number/integer/math/modular.hpp>
 #include <universal/number/integer/math/next.hpp>
 #include <universal/number/integer/math/pow.hpp>
 #include <universal/number/integer/math/sqrt.hpp>
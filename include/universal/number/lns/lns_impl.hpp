@@ -12,6 +12,7 @@
 #include <universal/internal/blockbinary/blockbinary.hpp>
 #include <universal/internal/abstract/triple.hpp>
 #include <universal/number/shared/specific_value_encoding.hpp>
+#include <universal/number/shared/encoding_table.hpp>
 #include <universal/behavior/arithmetic.hpp>
 #include <universal/number/lns/lns_fwd.hpp>
 
@@ -482,7 +483,12 @@ public:
 	explicit constexpr operator long()      const noexcept { return to_signed<long>(); }
 	explicit constexpr operator long long() const noexcept { return to_signed<long long>(); }
 	explicit constexpr operator float()     const noexcept { return to_ieee754<float>(); }
-	explicit constexpr operator double()    const noexcept { return to_ieee754<double>(); }
+	explicit constexpr operator double()    const noexcept {
+		if constexpr (encoding_table_traits<lns>::enabled) {
+			if (!std::is_constant_evaluated()) return encoding_table<lns>::to_double(*this);
+		}
+		return to_ieee754<double>();
+	}
 	
 	// guard long double support to enable ARM and RISC-V embedded environments
 #if LONG_DOUBLE_SUPPORT
@@ -764,6 +770,9 @@ protected:
 private:
 	BlockBinary _block;
 
+	// the encoding table decodes through the conversion of the lns
+	friend struct encoding_table_traits<lns>;
+
 	////////////////////// operators
 
 	/// stream operators
@@ -886,6 +895,16 @@ private:
 	}
 };
 
+// lns of ENCODING_TABLE_NBITS bits or fewer convert to double through an exhaustive table
+template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
+struct encoding_table_traits< lns<nbits, rbits, bt, xtra...> > {
+	using Lns = lns<nbits, rbits, bt, xtra...>;
+	static constexpr bool enabled = (nbits <= ENCODING_TABLE_NBITS);
+	static constexpr bool logarithmic = true;
+	static std::uint64_t encoding(const Lns& l) noexcept { return block_encoding(l); }
+	static double decode(const Lns& l) noexcept { return l.template to_ieee754<double>(); }
+};
+
 // return the Unit in the Last Position
 template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
 inline lns<nbits, rbits, bt, xtra...> ulp(const lns<nbits, rbits, bt, xtra...>& a) {
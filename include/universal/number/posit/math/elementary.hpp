@@ -0,0 +1,1038 @@
+#pragma once
+// elementary.hpp: correctly rounded elementary function kernels for posits
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <limits>
+
+// enable/disable the native, correctly rounded elementary functions: the alternative is to round the double precision result
+#ifndef POSIT_NATIVE_ELEMENTARY_FUNCTIONS
+#define POSIT_NATIVE_ELEMENTARY_FUNCTIONS 1
+#endif
+// posit configurations up to this size evaluate the unary elementary functions through an exhaustive lookup table
+#ifndef POSIT_ELEMENTARY_FUNCTION_TABLE_NBITS
+#define POSIT_ELEMENTARY_FUNCTION_TABLE_NBITS 16
+#endif
+
+/*
+	The posit standard requires every function to be correctly rounded for every input value.
+	Rounding a double precision evaluation back to the posit does not satisfy that requirement:
+	posit<64,3> carries up to 59 fraction bits, posit<128,4> up to 121, and their dynamic range
+	exceeds that of a double.
+
+	The kernels below evaluate the functions in a fixed-point accumulator that is at least twice
+	as wide as the posit:
+	  - exp, exp2, exp10, expm1, pow: reduce x = k ln(2) + r, evaluate exp(r/256) - 1 with a Taylor
+	    series, square back up with (1+s)^2 - 1 = 2s + s^2, and scale by 2^k
+	  - log, log2, log10, log1p: reduce x = m 2^e with m in [sqrt(2)/2, sqrt(2)) and evaluate
+	    log(m) = 2 atanh((m-1)/(m+1))
+	  - sin, cos, tan: reduce x modulo pi/2 with as many bits of 2/pi as the scale of x requires
+	    (Payne-Hanek), and evaluate the Taylor series of sin and cos on [-pi/4, pi/4]
+	The result is rounded with Ziv's strategy: when the approximation plus or minus its error bound
+	rounds to two different posits, the evaluation is repeated at twice the precision.
+	Posit configurations of POSIT_ELEMENTARY_FUNCTION_TABLE_NBITS or fewer bits build an exhaustive
+	table of the correctly rounded results on first use.
+*/
+
+namespace sw { namespace universal { namespace internal {
+
+/// <summary>
+/// signed-magnitude fixed-point accumulator for the elementary function kernels
+/// </summary>
+/// The magnitude is stored in 32-bit limbs, least significant limb first. The top limb holds
+/// the integer part, which wraps modulo 2^32, and the remaining limbs hold the fraction.
+/// Operands of an arithmetic operation must have the same number of fraction limbs.
+class elementary_accumulator {
+public:
+	using limb = std::uint32_t;
+	static constexpr unsigned bitsInLimb = 32;
+
+	explicit elementary_accumulator(unsigned fractionLimbs = 0, limb integer = 0) : _negative{ false }, _limb(fractionLimbs + 1ull, 0) { _limb.back() = integer; }
+
+	// selectors
+	unsigned fractionLimbs() const noexcept { return static_cast<unsigned>(_limb.size()) - 1u; }
+	int  fractionBits() const noexcept { return static_cast<int>(bitsInLimb * fractionLimbs()); }
+	bool isneg() const noexcept { return _negative; }
+	bool iszero() const noexcept {
+		for (limb l : _limb) if (l) return false;
+		return true;
+	}
+	limb integer() const noexcept { return _limb.back(); }
+	limb block(unsigned i) const noexcept { return _limb[i]; }
+	// test the bit of weight 2^position
+	bool test(int position) const noexcept {
+		int b = position + fractionBits();
+		if (b < 0 || b >= static_cast<int>(bitsInLimb * _limb.size())) return false;
+		return ((_limb[static_cast<unsigned>(b) / bitsInLimb] >> (static_cast<unsigned>(b) % bitsInLimb)) & 0x1u) != 0;
+	}
+	// true if any bit of weight smaller than 2^position is set
+	bool anyBelow(int position) const noexcept {
+		int b = position + fractionBits();
+		if (b <= 0) return false;
+		unsigned full = static_cast<unsigned>(b) / bitsInLimb;
+		for (unsigned i = 0; i < full && i < _limb.size(); ++i) if (_limb[i]) return true;
+		if (full >= _limb.size()) return false;
+		unsigned partial = static_cast<unsigned>(b) % bitsInLimb;
+		return partial > 0 && (_limb[full] & ((limb(1) << partial) - 1u)) != 0;
+	}
+	// weight of the most significant set bit, or INT_MIN when zero
+	int msb() const noexcept {
+		for (int i = static_cast<int>(_limb.size()) - 1; i >= 0; --i) {
+			limb l = _limb[static_cast<unsigned>(i)];
+			if (l) {
+				int b = static_cast<int>(bitsInLimb) - 1;
+				while (((l >> b) & 0x1u) == 0) --b;
+				return i * static_cast<int>(bitsInLimb) + b - fractionBits();
+			}
+		}
+		return std::numeric_limits<int>::min();
+	}
+	double to_double() const noexcept {
+		double v{ 0.0 };
+		int top = static_cast<int>(_limb.size()) - 1;
+		for (int i = top; i >= 0 && i > top - 3; --i) {
+			v += std::ldexp(static_cast<double>(_limb[static_cast<unsigned>(i)]), i * static_cast<int>(bitsInLimb) - fractionBits());
+		}
+		return (_negative ? -v : v);
+	}
+
+	// modifiers
+	void clear() noexcept { _negative = false; for (limb& l : _limb) l = 0; }
+	void setsign(bool sign) noexcept { _negative = sign && !iszero(); }
+	void setinteger(limb integer) noexcept { _limb.back() = integer; }
+	// set the bit of weight 2^position, ignored when outside of the accumulator
+	void setbit(int position) noexcept {
+		int b = position + fractionBits();
+		if (b < 0 || b >= static_cast<int>(bitsInLimb * _limb.size())) return;
+		_limb[static_cast<unsigned>(b) / bitsInLimb] |= limb(1) << (static_cast<unsigned>(b) % bitsInLimb);
+	}
+	// change the precision: new fraction limbs are zero, dropped fraction limbs truncate
+	void resize(unsigned fractionLimbs) {
+		unsigned current = this->fractionLimbs();
+		if (fractionLimbs > current) _limb.insert(_limb.begin(), fractionLimbs - current, 0u);
+		else if (fractionLimbs < current) _limb.erase(_limb.begin(), _limb.begin() + (current - fractionLimbs));
+		if (iszero()) _negative = false;
+	}
+	// assign a double exactly, truncating bits below the precision of the accumulator
+	void assign(double v) {
+		clear();
+		if (v == 0.0 || !std::isfinite(v)) return;
+		int e;
+		double m = std::frexp(std::fabs(v), &e);
+		std::uint64_t bits = static_cast<std::uint64_t>(std::ldexp(m, 53));
+		for (int i = 0; i < 53; ++i) {
+			if ((bits >> i) & 0x1u) setbit(e - 53 + i);
+		}
+		setsign(v < 0.0);
+	}
+
+	// arithmetic operators
+	elementary_accumulator& operator+=(const elementary_accumulator& rhs) {
+		if (_negative == rhs._negative) {
+			add_magnitude(rhs);
+		}
+		else if (compare_magnitude(rhs) >= 0) {
+			subtract_magnitude(rhs);
+		}
+		else {
+			elementary_accumulator tmp(rhs);
+			tmp.subtract_magnitude(*this);
+			*this = std::move(tmp);
+		}
+		if (iszero()) _negative = false;
+		return *this;
+	}
+	elementary_accumulator& operator-=(const elementary_accumulator& rhs) {
+		elementary_accumulator negated(rhs);
+		negated._negative = !rhs._negative && !rhs.iszero();
+		return operator+=(negated);
+	}
+	// truncated product
+	elementary_accumulator& operator*=(const elementary_accumulator& rhs) {
+		size_t n = _limb.size();
+		size_t f = n - 1;
+		std::vector<limb> product(2 * n, 0);
+		for (size_t i = 0; i < n; ++i) {
+			if (_limb[i] == 0) continue;
+			std::uint64_t carry = 0;
+			for (size_t j = 0; j < n; ++j) {
+				std::uint64_t t = static_cast<std::uint64_t>(_limb[i]) * rhs._limb[j] + product[i + j] + carry;
+				product[i + j] = static_cast<limb>(t);
+				carry = t >> bitsInLimb;
+			}
+			product[i + n] = static_cast<limb>(carry);
+		}
+		for (size_t i = 0; i < n; ++i) _limb[i] = product[f + i];
+		_negative = (_negative != rhs._negative) && !iszero();
+		return *this;
+	}
+	// multiply by a small integer, the integer part wraps
+	elementary_accumulator& mul(limb m) {
+		std::uint64_t carry = 0;
+		for (limb& l : _limb) {
+			std::uint64_t t = static_cast<std::uint64_t>(l) * m + carry;
+			l = static_cast<limb>(t);
+			carry = t >> bitsInLimb;
+		}
+		if (iszero()) _negative = false;
+		return *this;
+	}
+	// divide by a small integer, truncating
+	elementary_accumulator& div(limb d) {
+		std::uint64_t remainder = 0;
+		for (size_t i = _limb.size(); i > 0; --i) {
+			std::uint64_t t = (remainder << bitsInLimb) | _limb[i - 1];
+			_limb[i - 1] = static_cast<limb>(t / d);
+			remainder = t % d;
+		}
+		if (iszero()) _negative = false;
+		return *this;
+	}
+	// shift the magnitude left, bits shifted out of the integer part are lost
+	elementary_accumulator& operator<<=(unsigned shift) {
+		size_t n = _limb.size();
+		size_t limbShift = shift / bitsInLimb;
+		unsigned bitShift = shift % bitsInLimb;
+		if (limbShift >= n) { clear(); return *this; }
+		for (size_t i = n; i > 0; --i) {
+			size_t tgt = i - 1;
+			limb v = 0;
+			if (tgt >= limbShift) {
+				size_t src = tgt - limbShift;
+				v = _limb[src] << bitShift;
+				if (bitShift && src > 0) v |= _limb[src - 1] >> (bitsInLimb - bitShift);
+			}
+			_limb[tgt] = v;
+		}
+		if (iszero()) _negative = false;
+		return *this;
+	}
+	// shift the magnitude right, truncating
+	elementary_accumulator& operator>>=(unsigned shift) {
+		size_t n = _limb.size();
+		size_t limbShift = shift / bitsInLimb;
+		unsigned bitShift = shift % bitsInLimb;
+		if (limbShift >= n) { clear(); return *this; }
+		for (size_t tgt = 0; tgt < n; ++tgt) {
+			size_t src = tgt + limbShift;
+			limb v = 0;
+			if (src < n) {
+				v = _limb[src] >> bitShift;
+				if (bitShift && src + 1 < n) v |= _limb[src + 1] << (bitsInLimb - bitShift);
+			}
+			_limb[tgt] = v;
+		}
+		if (iszero()) _negative = false;
+		return *this;
+	}
+	// shift by a signed amount: positive shifts left
+	elementary_accumulator& scale(int shift) {
+		return (shift >= 0 ? operator<<=(static_cast<unsigned>(shift)) : operator>>=(static_cast<unsigned>(-shift)));
+	}
+
+	// compare magnitudes: returns 1 if |this| > |rhs|, 0 if equal, -1 if |this| < |rhs|
+	int compare_magnitude(const elementary_accumulator& rhs) const noexcept {
+		for (size_t i = _limb.size(); i > 0; --i) {
+			if (_limb[i - 1] != rhs._limb[i - 1]) return (_limb[i - 1] > rhs._limb[i - 1] ? 1 : -1);
+		}
+		return 0;
+	}
+
+protected:
+	// magnitude addition, the carry out of the integer part is lost
+	void add_magnitude(const elementary_accumulator& rhs) noexcept {
+		std::uint64_t carry = 0;
+		for (size_t i = 0; i < _limb.size(); ++i) {
+			std::uint64_t t = static_cast<std::uint64_t>(_limb[i]) + rhs._limb[i] + carry;
+			_limb[i] = static_cast<limb>(t);
+			carry = t >> bitsInLimb;
+		}
+	}
+	// magnitude subtraction, precondition |this| >= |rhs|
+	void subtract_magnitude(const elementary_accumulator& rhs) noexcept {
+		std::int64_t borrow = 0;
+		for (size_t i = 0; i < _limb.size(); ++i) {
+			std::int64_t t = static_cast<std::int64_t>(_limb[i]) - rhs._limb[i] - borrow;
+			borrow = (t < 0 ? 1 : 0);
+			_limb[i] = static_cast<limb>(t + (borrow << bitsInLimb));
+		}
+	}
+
+private:
+	bool              _negative;
+	std::vector<limb> _limb;
+};
+
+inline elementary_accumulator operator*(const elementary_accumulator& lhs, const elementary_accumulator& rhs) {
+	elementary_accumulator product(lhs);
+	return product *= rhs;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+// kernels on the accumulator
+
+// reciprocal of a positive d in [1/4, 4) by Newton iteration y = y + y(1 - dy), seeded in double precision
+inline elementary_accumulator reciprocal(const elementary_accumulator& d) {
+	unsigned fl = d.fractionLimbs();
+	elementary_accumulator one(fl, 1);
+	elementary_accumulator y(fl);
+	y.assign(1.0 / d.to_double());
+	for (int bits = 48; bits < 2 * (d.fractionBits() + 32); bits *= 2) {
+		elementary_accumulator residual(one);
+		residual -= d * y;
+		y += residual * y;
+	}
+	return y;
+}
+
+// atan(1/n) = sum_k (-1)^k / ((2k+1) n^(2k+1))
+inline elementary_accumulator atan_inverse(elementary_accumulator::limb n, unsigned fractionLimbs) {
+	elementary_accumulator sum(fractionLimbs), power(fractionLimbs, 1);
+	power.div(n);
+	bool subtract = false;
+	for (elementary_accumulator::limb k = 1; !power.iszero(); k += 2) {
+		elementary_accumulator term(power);
+		term.div(k);
+		if (subtract) sum -= term; else sum += term;
+		subtract = !subtract;
+		power.div(n);
+		power.div(n);
+	}
+	return sum;
+}
+
+enum class ElementaryConstant { ln2, pi, two_over_pi, ln10, inv_ln2, inv_ln10, nrConstants };
+
+inline elementary_accumulator log_kernel(elementary_accumulator m, int e);
+
+// compute a constant with a few guard bits beyond the requested precision
+inline elementary_accumulator compute_constant(ElementaryConstant c, unsigned fractionLimbs) {
+	unsigned fl = fractionLimbs + 1;
+	elementary_accumulator v(fl);
+	switch (c) {
+	case ElementaryConstant::ln2:
+		{
+			// ln(2) = 2 atanh(1/3) = 2 sum_k 1 / ((2k+1) 3^(2k+1))
+			elementary_accumulator power(fl, 1);
+			power.div(3);
+			for (elementary_accumulator::limb k = 1; !power.iszero(); k += 2) {
+				elementary_accumulator term(power);
+				term.div(k);
+				v += term;
+				power.div(9);
+			}
+			v <<= 1;
+		}
+		break;
+	case ElementaryConstant::pi:
+		{
+			// Machin: pi = 16 atan(1/5) - 4 atan(1/239)
+			v = atan_inverse(5, fl);
+			v <<= 4;
+			elementary_accumulator t = atan_inverse(239, fl);
+			t <<= 2;
+			v -= t;
+		}
+		break;
+	case ElementaryConstant::two_over_pi:
+		{
+			elementary_accumulator half_pi = compute_constant(ElementaryConstant::pi, fl);
+			half_pi >>= 1;
+			v = reciprocal(half_pi);
+		}
+		break;
+	case ElementaryConstant::ln10:
+		{
+			// ln(10) = 3 ln(2) + ln(1.25)
+			elementary_accumulator m(fl, 1);
+			m.setbit(-2);
+			v = log_kernel(m, 3);
+		}
+		break;
+	case ElementaryConstant::inv_ln2:
+		v = reciprocal(compute_constant(ElementaryConstant::ln2, fl));
+		break;
+	case ElementaryConstant::inv_ln10:
+		{
+			elementary_accumulator ln10 = compute_constant(ElementaryConstant::ln10, fl);
+			ln10 >>= 2; // reciprocal wants its argument in [1/4, 4)
+			v = reciprocal(ln10);
+			v >>= 2;
+		}
+		break;
+	default:
+		break;
+	}
+	v.resize(fractionLimbs);
+	return v;
+}
+
+// constants are cached per thread at the highest precision requested so far
+inline elementary_accumulator constant(ElementaryConstant c, unsigned fractionLimbs) {
+	thread_local std::vector<elementary_accumulator> cache(static_cast<size_t>(ElementaryConstant::nrConstants));
+	elementary_accumulator& entry = cache[static_cast<size_t>(c)];
+	if (entry.fractionLimbs() < fractionLimbs) entry = compute_constant(c, fractionLimbs);
+	elementary_accumulator v(entry);
+	v.resize(fractionLimbs);
+	return v;
+}
+
+// exp(r) - 1 for |r| < 1/2: evaluate the Taylor series at r/2^8 and square back up
+inline elementary_accumulator expm1_kernel(elementary_accumulator r) {
+	constexpr unsigned squarings = 8;
+	r >>= squarings;
+	elementary_accumulator sum(r), term(r);
+	for (elementary_accumulator::limb k = 2; ; ++k) {
+		term *= r;
+		term.div(k);
+		if (term.iszero()) break;
+		sum += term;
+	}
+	for (unsigned i = 0; i < squarings; ++i) {
+		elementary_accumulator square = sum * sum;
+		sum <<= 1;
+		sum += square;
+	}
+	return sum;
+}
+
+// natural logarithm of m 2^e with m in [1, 2)
+inline elementary_accumulator log_kernel(elementary_accumulator m, int e) {
+	unsigned fl = m.fractionLimbs();
+	// center the mantissa around 1: m in [sqrt(2)/2, sqrt(2))
+	if (m.integer() == 1 && m.block(fl - 1) > 0x6A09E667u) {
+		m >>= 1;
+		++e;
+	}
+	// log(m) = 2 atanh(z) = 2 (z + z^3/3 + z^5/5 + ...) with z = (m - 1)/(m + 1)
+	elementary_accumulator one(fl, 1), num(m), den(m);
+	num -= one;
+	den += one;
+	elementary_accumulator z = num * reciprocal(den);
+	elementary_accumulator z2 = z * z;
+	elementary_accumulator sum(z), power(z);
+	for (elementary_accumulator::limb k = 3; ; k += 2) {
+		power *= z2;
+		if (power.iszero()) break;
+		elementary_accumulator term(power);
+		term.div(k);
+		sum += term;
+	}
+	sum <<= 1;
+	if (e != 0) {
+		elementary_accumulator eln2 = constant(ElementaryConstant::ln2, fl + 1);
+		eln2.mul(static_cast<elementary_accumulator::limb>(e < 0 ? -e : e));
+		eln2.setsign(e < 0);
+		eln2.resize(fl);
+		sum += eln2;
+	}
+	return sum;
+}
+
+// sine and cosine of |r| <= pi/4
+inline void sincos_kernel(const elementary_accumulator& r, elementary_accumulator& s, elementary_accumulator& c) {
+	unsigned fl = r.fractionLimbs();
+	elementary_accumulator r2 = r * r;
+	s = r;
+	elementary_accumulator term(r);
+	bool subtract = true;
+	for (elementary_accumulator::limb k = 2; ; k += 2) {
+		term *= r2;
+		term.div(k * (k + 1));
+		if (term.iszero()) break;
+		if (subtract) s -= term; else s += term;
+		subtract = !subtract;
+	}
+	c = elementary_accumulator(fl, 1);
+	term = c;
+	subtract = true;
+	for (elementary_accumulator::limb k = 1; ; k += 2) {
+		term *= r2;
+		term.div(k * (k + 1));
+		if (term.iszero()) break;
+		if (subtract) c -= term; else c += term;
+		subtract = !subtract;
+	}
+}
+
+// quotient a/b normalized to [1/2, 2), the binary scale of the quotient is returned in scaleOffset
+inline elementary_accumulator divide(elementary_accumulator a, elementary_accumulator b, int& scaleOffset) {
+	int ma = a.msb();
+	int mb = b.msb();
+	bool negative = a.isneg() != b.isneg();
+	a.scale(-ma);
+	b.scale(-mb);
+	a.setsign(false);
+	b.setsign(false);
+	elementary_accumulator q = a * reciprocal(b);
+	q.setsign(negative);
+	scaleOffset += ma - mb;
+	return q;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+// conversions between posits and the accumulator
+
+// +-1 from its encoding: the integer conversions of the fast specializations are not all exact
+template<unsigned nbits, unsigned es>
+posit<nbits, es> posit_one(bool negative = false) {
+	posit<nbits, es> p;
+	if constexpr (nbits <= 64) {
+		p.setbits(std::uint64_t(1) << (nbits - 2));
+	}
+	else {
+		p = 1;
+	}
+	return (negative ? -p : p);
+}
+
+// decode a posit into its (sign, scale, fraction) triple: the fast specializations do not all provide to_value()
+template<unsigned nbits, unsigned es>
+value<(es + 2 >= nbits ? 0 : nbits - 3 - es)> decode_posit(const posit<nbits, es>& x) {
+	constexpr unsigned fbits = (es + 2 >= nbits ? 0 : nbits - 3 - es);
+	bool sign{ false };
+	positRegime<nbits, es>   regime;
+	positExponent<nbits, es> exponent;
+	positFraction<fbits>     fraction;
+	decode(x.get(), sign, regime, exponent, fraction);
+	return value<fbits>(sign, regime.scale() + exponent.scale(), fraction.get(), x.iszero(), x.isnar());
+}
+
+// place the value 1.f 2^scale of a decoded posit into an accumulator, bits below its precision are truncated
+template<unsigned fbits>
+elementary_accumulator to_accumulator(const value<fbits>& v, unsigned fractionLimbs) {
+	elementary_accumulator a(fractionLimbs);
+	if (v.iszero()) return a;
+	int scale = v.scale();
+	a.setbit(scale);
+	bitblock<fbits> f = v.fraction();
+	for (unsigned i = 0; i < fbits; ++i) {
+		if (f.test(i)) a.setbit(scale - static_cast<int>(fbits) + static_cast<int>(i));
+	}
+	a.setsign(v.sign());
+	return a;
+}
+
+// the significand 1.f of a decoded posit
+template<unsigned fbits>
+elementary_accumulator significand(const value<fbits>& v, unsigned fractionLimbs) {
+	elementary_accumulator a(fractionLimbs, 1);
+	bitblock<fbits> f = v.fraction();
+	for (unsigned i = 0; i < fbits; ++i) {
+		if (f.test(i)) a.setbit(static_cast<int>(i) - static_cast<int>(fbits));
+	}
+	return a;
+}
+
+// test if a decoded value is an integer, and if so, return its value when it fits and whether it is odd
+template<unsigned fbits>
+bool integer_value(const value<fbits>& v, long long& integer, bool& odd) {
+	integer = 0;
+	odd = false;
+	if (v.iszero()) return true;
+	int scale = v.scale();
+	if (scale < 0) return false;
+	bitblock<fbits> f = v.fraction();
+	for (int i = 0; i < static_cast<int>(fbits) - scale; ++i) {
+		if (f.test(static_cast<unsigned>(i))) return false;
+	}
+	if (scale < 62) {
+		long long magnitude = 1ll << scale;
+		for (int i = 0; i < scale && i < static_cast<int>(fbits); ++i) {
+			if (f.test(fbits - 1u - static_cast<unsigned>(i))) magnitude |= 1ll << (scale - 1 - i);
+		}
+		integer = (v.sign() ? -magnitude : magnitude);
+		odd = (magnitude & 0x1) != 0;
+	}
+	else {
+		integer = (v.sign() ? std::numeric_limits<long long>::min() : std::numeric_limits<long long>::max());
+	}
+	return true;
+}
+
+// round the magnitude of an accumulator times 2^scaleOffset to the nearest posit
+template<unsigned nbits, unsigned es>
+posit<nbits, es> round_to_posit(const elementary_accumulator& a, bool sign, int scaleOffset) {
+	constexpr unsigned fbits = nbits + 2;
+	posit<nbits, es> p;
+	if (a.iszero()) {
+		p.setzero();
+		return p;
+	}
+	int top = a.msb();
+	bitblock<fbits> fraction;
+	for (unsigned i = 0; i < fbits; ++i) {
+		fraction.set(fbits - 1u - i, a.test(top - 1 - static_cast<int>(i)));
+	}
+	if (a.anyBelow(top - static_cast<int>(fbits))) fraction.set(0, true);
+	return convert_<nbits, es, fbits>(sign, top + scaleOffset, fraction, p);
+}
+
+// Ziv's rounding test: the exact value lies within 2^errorBit of the approximation a;
+// succeed when both ends of that interval round to the same posit
+template<unsigned nbits, unsigned es>
+bool round_to_posit(const elementary_accumulator& a, int scaleOffset, int errorBit, posit<nbits, es>& p) {
+	elementary_accumulator error(a.fractionLimbs());
+	error.setbit(std::max(errorBit, -a.fractionBits()));
+	elementary_accumulator lo(a), hi(a);
+	lo.setsign(false);
+	hi.setsign(false);
+	lo -= error;
+	hi += error;
+	if (lo.isneg() || lo.iszero() || hi.compare_magnitude(lo) <= 0) return false;
+	posit<nbits, es> plo = round_to_posit<nbits, es>(lo, a.isneg(), scaleOffset);
+	posit<nbits, es> phi = round_to_posit<nbits, es>(hi, a.isneg(), scaleOffset);
+	if (plo != phi) return false;
+	p = plo;
+	return true;
+}
+
+// evaluate a kernel with increasing precision until its result rounds unambiguously
+// the kernel signature is elementary_accumulator kernel(unsigned fractionLimbs, int& scaleOffset, int& errorBit),
+// and it computes with one guard limb beyond fractionLimbs. The default error bound is 2^-(32 fractionLimbs).
+template<unsigned nbits, unsigned es, typename Kernel>
+posit<nbits, es> correctly_rounded(Kernel&& kernel) {
+	constexpr unsigned maxAttempts = 4;
+	unsigned fl = (2 * nbits + 64 + elementary_accumulator::bitsInLimb - 1) / elementary_accumulator::bitsInLimb;
+	elementary_accumulator y;
+	int scaleOffset{ 0 };
+	for (unsigned attempt = 0; attempt < maxAttempts; ++attempt, fl *= 2) {
+		scaleOffset = 0;
+		int errorBit = -static_cast<int>(elementary_accumulator::bitsInLimb * fl);
+		y = kernel(fl, scaleOffset, errorBit);
+		posit<nbits, es> p;
+		if (round_to_posit(y, scaleOffset, errorBit, p)) return p;
+	}
+	// exact results, and results too close to call at the highest precision, round the approximation
+	return round_to_posit<nbits, es>(y, y.isneg(), scaleOffset);
+}
+
+// exhaustive table of a unary function for small posits, generated on first use
+template<unsigned nbits, unsigned es, typename Function>
+posit<nbits, es> table_lookup(const posit<nbits, es>& x, Function&& f) {
+	static const std::vector<posit<nbits, es>> table = [&f]() {
+		std::vector<posit<nbits, es>> t(std::size_t(1) << nbits);
+		posit<nbits, es> a;
+		for (std::size_t i = 0; i < t.size(); ++i) {
+			a.setbits(i);
+			t[i] = f(a);
+		}
+		return t;
+	}();
+	return table[static_cast<std::size_t>(x.get().to_ulong())];
+}
+
+// dispatch a unary function to its lookup table or to its kernel
+template<unsigned nbits, unsigned es, typename Function>
+posit<nbits, es> elementary_function(const posit<nbits, es>& x, Function&& f) {
+	if constexpr (nbits <= POSIT_ELEMENTARY_FUNCTION_TABLE_NBITS) {
+		return table_lookup(x, f);
+	}
+	else {
+		return f(x);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+// correctly rounded posit functions
+
+// largest binary scale of a posit configuration
+template<unsigned nbits, unsigned es>
+constexpr int maxscale() { return (nbits < 2 ? 0 : static_cast<int>(nbits - 2) * (1 << es)); }
+
+// s^k = power 2^binaryScale, with power in [1, 2), for a significand s in [1, 2) and a positive integer k
+// returns false when the exact result would have more than maxBits significant bits
+inline bool exact_power(const elementary_accumulator& significand, long long k, unsigned maxBits, elementary_accumulator& power, int& binaryScale) {
+	int lsb = 0;
+	while (!significand.test(lsb)) --lsb;
+	if (static_cast<long long>(1 - lsb) * k > static_cast<long long>(maxBits)) return false;
+	// the partial products fit in the fraction, so the truncated products are exact
+	unsigned fl = maxBits / elementary_accumulator::bitsInLimb + 1u;
+	elementary_accumulator s(significand);
+	s.resize(fl);
+	power = s;
+	binaryScale = 0;
+	for (long long i = 1; i < k; ++i) {
+		power *= s;
+		if (power.integer() >= 2) {
+			power >>= 1;
+			++binaryScale;
+		}
+	}
+	return true;
+}
+
+// (s 2^scale)^k rounded to a posit, when it can be computed exactly
+template<unsigned nbits, unsigned es>
+bool exact_integer_power(const elementary_accumulator& significand, int scale, long long k, bool sign, posit<nbits, es>& p) {
+	elementary_accumulator power;
+	int binaryScale;
+	if (!exact_power(significand, k, nbits + 4u, power, binaryScale)) return false;
+	p = round_to_posit<nbits, es>(power, sign, binaryScale + static_cast<int>(scale * k));
+	return true;
+}
+
+template<unsigned nbits, unsigned es>
+posit<nbits, es> posit_exp(const posit<nbits, es>& x) {
+	using Posit = posit<nbits, es>;
+	if (x.isnar()) return x;
+	if (x.iszero()) return posit_one<nbits, es>();
+	auto v = decode_posit(x);
+	if (v.scale() < -static_cast<int>(nbits) - 2) return posit_one<nbits, es>(); // exp(x) = 1 + x rounds to 1
+	const double ln2 = std::log(2.0);
+	double dx = v.to_double();
+	double threshold = (maxscale<nbits, es>() + 2) * ln2;
+	if (dx > threshold) return Posit(SpecificValue::maxpos);
+	if (dx < -threshold) return Posit(SpecificValue::minpos);
+	long long k = std::llround(dx / ln2);
+	return correctly_rounded<nbits, es>([&](unsigned fl, int& scaleOffset, int&) {
+		elementary_accumulator r = to_accumulator(v, fl + 1);
+		elementary_accumulator kln2 = constant(ElementaryConstant::ln2, fl + 2);
+		kln2.mul(static_cast<elementary_accumulator::limb>(k < 0 ? -k : k));
+		kln2.setsign(k < 0);
+		kln2.resize(fl + 1);
+		r -= kln2;
+		elementary_accumulator y = expm1_kernel(r);
+		y += elementary_accumulator(fl + 1, 1);
+		scaleOffset = static_cast<int>(k);
+		return y;
+	});
+}
+
+template<unsigned nbits, unsigned es>
+posit<nbits, es> posit_exp2(const posit<nbits, es>& x) {
+	using Posit = posit<nbits, es>;
+	if (x.isnar()) return x;
+	if (x.iszero()) return posit_one<nbits, es>();
+	auto v = decode_posit(x);
+	if (v.scale() < -static_cast<int>(nbits) - 2) return posit_one<nbits, es>();
+	double dx = v.to_double();
+	double threshold = maxscale<nbits, es>() + 2;
+	if (dx > threshold) return Posit(SpecificValue::maxpos);
+	if (dx < -threshold) return Posit(SpecificValue::minpos);
+	long long k; bool odd;
+	if (integer_value(v, k, odd)) return round_to_posit<nbits, es>(elementary_accumulator(0, 1), false, static_cast<int>(k));
+	k = std::llround(dx);
+	return correctly_rounded<nbits, es>([&](unsigned fl, int& scaleOffset, int&) {
+		// 2^x = 2^k exp((x - k) ln(2)), with x - k exact
+		elementary_accumulator r = to_accumulator(v, fl + 1);
+		elementary_accumulator ik(fl + 1, static_cast<elementary_accumulator::limb>(k < 0 ? -k : k));
+		ik.setsign(k < 0);
+		r -= ik;
+		r *= constant(ElementaryConstant::ln2, fl + 1);
+		elementary_accumulator y = expm1_kernel(r);
+		y += elementary_accumulator(fl + 1, 1);
+		scaleOffset = static_cast<int>(k);
+		return y;
+	});
+}
+
+template<unsigned nbits, unsigned es>
+posit<nbits, es> posit_exp10(const posit<nbits, es>& x) {
+	using Posit = posit<nbits, es>;
+	if (x.isnar()) return x;
+	if (x.iszero()) return posit_one<nbits, es>();
+	auto v = decode_posit(x);
+	if (v.scale() < -static_cast<int>(nbits) - 4) return posit_one<nbits, es>();
+	const double log2_10 = std::log2(10.0);
+	double dx = v.to_double();
+	double threshold = maxscale<nbits, es>() + 2;
+	if (dx * log2_10 > threshold) return Posit(SpecificValue::maxpos);
+	if (dx * log2_10 < -threshold) return Posit(SpecificValue::minpos);
+	long long k; bool odd;
+	if (integer_value(v, k, odd) && k > 0) {
+		// 10^k = 5^k 2^k can be representable, or a rounding midpoint
+		elementary_accumulator five_quarters(1, 1);
+		five_quarters.setbit(-2);
+		Posit p;
+		if (exact_integer_power<nbits, es>(five_quarters, 3, k, false, p)) return p;
+	}
+	k = std::llround(dx * log2_10);
+	return correctly_rounded<nbits, es>([&](unsigned fl, int& scaleOffset, int&) {
+		// 10^x = 2^k exp(x ln(10) - k ln(2))
+		elementary_accumulator z = to_accumulator(v, fl + 2);
+		z *= constant(ElementaryConstant::ln10, fl + 2);
+		elementary_accumulator kln2 = constant(ElementaryConstant::ln2, fl + 2);
+		kln2.mul(static_cast<elementary_accumulator::limb>(k < 0 ? -k : k));
+		kln2.setsign(k < 0);
+		z -= kln2;
+		z.resize(fl + 1);
+		elementary_accumulator y = expm1_kernel(z);
+		y += elementary_accumulator(fl + 1, 1);
+		scaleOffset = static_cast<int>(k);
+		return y;
+	});
+}
+
+template<unsigned nbits, unsigned es>
+posit<nbits, es> posit_expm1(const posit<nbits, es>& x) {
+	using Posit = posit<nbits, es>;
+	if (x.isnar() || x.iszero()) return x;
+	auto v = decode_posit(x);
+	if (v.scale() < -static_cast<int>(nbits) - 2) return x; // expm1(x) = x + x^2/2 rounds to x
+	const double ln2 = std::log(2.0);
+	double dx = v.to_double();
+	double threshold = (maxscale<nbits, es>() + 2) * ln2;
+	if (dx > threshold) return Posit(SpecificValue::maxpos);
+	if (dx < -static_cast<double>(nbits) - 8.0) return posit_one<nbits, es>(true);
+	long long k = std::llround(dx / ln2);
+	return correctly_rounded<nbits, es>([&](unsigned fl, int& scaleOffset, int&) {
+		elementary_accumulator r = to_accumulator(v, fl + 1);
+		elementary_accumulator kln2 = constant(ElementaryConstant::ln2, fl + 2);
+		kln2.mul(static_cast<elementary_accumulator::limb>(k < 0 ? -k : k));
+		kln2.setsign(k < 0);
+		kln2.resize(fl + 1);
+		r -= kln2;
+		elementary_accumulator y = expm1_kernel(r);
+		elementary_accumulator one(fl + 1, 1);
+		if (k > 0) {
+			// 2^k (1 + e) - 1 = 2^k (1 + e - 2^-k)
+			elementary_accumulator bias(fl + 1);
+			bias.setbit(static_cast<int>(-k));
+			y += one;
+			y -= bias;
+			scaleOffset = static_cast<int>(k);
+		}
+		else if (k < 0) {
+			y += one;
+			y >>= static_cast<unsigned>(-k);
+			y -= one;
+		}
+		return y;
+	});
+}
+
+template<unsigned nbits, unsigned es>
+posit<nbits, es> posit_log(const posit<nbits, es>& x) {
+	using Posit = posit<nbits, es>;
+	if (x.isnar() || x.iszero() || x.isneg()) return Posit(SpecificValue::nar);
+	if (x == posit_one<nbits, es>()) return Posit(0);
+	auto v = decode_posit(x);
+	return correctly_rounded<nbits, es>([&](unsigned fl, int&, int&) {
+		return log_kernel(significand(v, fl + 1), v.scale());
+	});
+}
+
+template<unsigned nbits, unsigned es>
+posit<nbits, es> posit_log2(const posit<nbits, es>& x) {
+	using Posit = posit<nbits, es>;
+	if (x.isnar() || x.iszero() || x.isneg()) return Posit(SpecificValue::nar);
+	auto v = decode_posit(x);
+	if (v.fraction().none()) {
+		// exact power of two
+		int scale = v.scale();
+		elementary_accumulator e(0, static_cast<elementary_accumulator::limb>(scale < 0 ? -scale : scale));
+		return round_to_posit<nbits, es>(e, scale < 0, 0);
+	}
+	return correctly_rounded<nbits, es>([&](unsigned fl, int&, int&) {
+		return log_kernel(significand(v, fl + 1), v.scale()) * constant(ElementaryConstant::inv_ln2, fl + 1);
+	});
+}
+
+template<unsigned nbits, unsigned es>
+posit<nbits, es> posit_log10(const posit<nbits, es>& x) {
+	using Posit = posit<nbits, es>;
+	if (x.isnar() || x.iszero() || x.isneg()) return Posit(SpecificValue::nar);
+	if (x == posit_one<nbits, es>()) return Posit(0);
+	auto v = decode_posit(x);
+	long long k = std::llround(std::log10(v.to_double()));
+	if (k > 0 && k < 64) {
+		// x is an exact power of ten when x = 1.25^k 2^3k
+		unsigned fl = static_cast<unsigned>(nbits) / elementary_accumulator::bitsInLimb + 1u;
+		elementary_accumulator five_quarters(1, 1), power;
+		five_quarters.setbit(-2);
+		int binaryScale;
+		if (exact_power(five_quarters, k, nbits, power, binaryScale) && v.scale() == 3 * k + binaryScale) {
+			power.resize(fl);
+			if (power.compare_magnitude(significand(v, fl)) == 0) {
+				return round_to_posit<nbits, es>(elementary_accumulator(0, static_cast<elementary_accumulator::limb>(k)), false, 0);
+			}
+		}
+	}
+	return correctly_rounded<nbits, es>([&](unsigned fl, int&, int&) {
+		return log_kernel(significand(v, fl + 1), v.scale()) * constant(ElementaryConstant::inv_ln10, fl + 1);
+	});
+}
+
+template<unsigned nbits, unsigned es>
+posit<nbits, es> posit_log1p(const posit<nbits, es>& x) {
+	using Posit = posit<nbits, es>;
+	if (x.isnar() || x.iszero()) return x;
+	if (x <= posit_one<nbits, es>(true)) return Posit(SpecificValue::nar);
+	auto v = decode_posit(x);
+	if (v.scale() < -static_cast<int>(nbits) - 2) return x; // log1p(x) = x - x^2/2 rounds to x
+	return correctly_rounded<nbits, es>([&](unsigned fl, int&, int&) {
+		// form 1 + x and normalize it to m 2^e
+		elementary_accumulator a(fl + 1);
+		int e = 0;
+		if (v.scale() <= 30) {
+			a = to_accumulator(v, fl + 1);
+			a += elementary_accumulator(fl + 1, 1);
+		}
+		else {
+			a = significand(v, fl + 1);
+			a.setbit(-v.scale());
+			e = v.scale();
+		}
+		int top = a.msb();
+		a.scale(-top);
+		return log_kernel(a, e + top);
+	});
+}
+
+// x^y with the special cases of std::pow
+template<unsigned nbits, unsigned es, unsigned yfbits>
+posit<nbits, es> posit_pow(const posit<nbits, es>& x, const value<yfbits>& vy) {
+	using Posit = posit<nbits, es>;
+	if (vy.iszero()) return posit_one<nbits, es>();
+	if (x == posit_one<nbits, es>()) return x;
+	if (x.isnar() || vy.isnan() || vy.isinf()) return Posit(SpecificValue::nar);
+	if (x.iszero()) return (vy.isneg() ? Posit(SpecificValue::nar) : x);
+	long long iy; bool odd;
+	bool integerExponent = integer_value(vy, iy, odd);
+	if (x.isneg() && !integerExponent) return Posit(SpecificValue::nar);
+	bool negative = x.isneg() && odd;
+	auto vx = decode_posit(x);
+	vx.setsign(false);
+	if (vx.fraction().none() && integerExponent && iy != std::numeric_limits<long long>::min() && iy != std::numeric_limits<long long>::max()) {
+		// powers of two stay exact: (2^s)^y = 2^(s y)
+		long long limit = maxscale<nbits, es>() + 2;
+		long long s = static_cast<long long>(vx.scale());
+		if (s != 0 && (iy > limit || iy < -limit)) s = ((s < 0) != (iy < 0) ? -limit : limit);
+		else s *= iy;
+		if (s > limit) s = limit;
+		if (s < -limit) s = -limit;
+		return round_to_posit<nbits, es>(elementary_accumulator(0, 1), negative, static_cast<int>(s));
+	}
+	if (integerExponent && iy > 0 && iy < 256) {
+		Posit p;
+		if (exact_integer_power<nbits, es>(significand(vx, nbits / elementary_accumulator::bitsInLimb + 1u), vx.scale(), iy, negative, p)) return p;
+	}
+	// saturation: estimate log2|x^y| = y log2|x| from the accumulator
+	const double ln2 = std::log(2.0);
+	double threshold = (maxscale<nbits, es>() + 2) * ln2;
+	{
+		unsigned fl = nbits / elementary_accumulator::bitsInLimb + 2u;
+		elementary_accumulator l = log_kernel(significand(vx, fl), vx.scale());
+		// |z| = |y| |log x| with |y| in [2^scale, 2^(scale+1))
+		long long zmsb = static_cast<long long>(l.msb()) + vy.scale();
+		double dz = (zmsb > 12 ? threshold + 1.0 : std::fabs(l.to_double() * vy.to_double()));
+		if (l.isneg() != vy.sign()) dz = -dz;
+		if (dz > threshold) return (negative ? Posit(SpecificValue::maxneg) : Posit(SpecificValue::maxpos));
+		if (dz < -threshold) return (negative ? Posit(SpecificValue::minneg) : Posit(SpecificValue::minpos));
+	}
+	int yscale = vy.scale();
+	unsigned extra = (yscale > 0 ? static_cast<unsigned>(yscale) / elementary_accumulator::bitsInLimb + 1u : 1u);
+	return correctly_rounded<nbits, es>([&](unsigned fl, int& scaleOffset, int& errorBit) {
+		unsigned wl = fl + 1 + extra;
+		// z = y log(x), the absolute error of log(x) is amplified by |y|
+		elementary_accumulator z = log_kernel(significand(vx, wl), vx.scale());
+		z *= significand(vy, wl);
+		z.scale(yscale);
+		z.setsign(z.isneg() != vy.sign());
+		long long k = std::llround(z.to_double() / ln2);
+		elementary_accumulator kln2 = constant(ElementaryConstant::ln2, wl + 1);
+		kln2.mul(static_cast<elementary_accumulator::limb>(k < 0 ? -k : k));
+		kln2.setsign(k < 0);
+		kln2.resize(wl);
+		z -= kln2;
+		z.resize(fl + 1);
+		elementary_accumulator y = expm1_kernel(z);
+		y += elementary_accumulator(fl + 1, 1);
+		y.setsign(negative);
+		scaleOffset = static_cast<int>(k);
+		errorBit = std::max(errorBit, -static_cast<int>(elementary_accumulator::bitsInLimb * wl) + 16 + std::max(yscale, 0));
+		return y;
+	});
+}
+
+// reduce |x| modulo pi/2: returns the quadrant and the reduced argument r in [-pi/4, pi/4]
+template<unsigned fbits>
+unsigned reduce_half_pi(const value<fbits>& v, unsigned fractionLimbs, elementary_accumulator& r) {
+	using limb = elementary_accumulator::limb;
+	constexpr unsigned bitsInLimb = elementary_accumulator::bitsInLimb;
+	int scale = v.scale();
+	// enough bits of 2/pi to leave fractionLimbs+2 limbs after the integer bits of x (2/pi) are discarded
+	unsigned cl = fractionLimbs + 2u + (scale > 0 ? static_cast<unsigned>(scale) / bitsInLimb + 1u : 0u);
+	elementary_accumulator c = constant(ElementaryConstant::two_over_pi, cl);
+	// |x| = M 2^s, with M the integer 1f
+	int s = scale - static_cast<int>(fbits);
+	c.scale(s);
+	std::vector<limb> M(fbits / bitsInLimb + 1u, 0);
+	M[fbits / bitsInLimb] |= limb(1) << (fbits % bitsInLimb);
+	bitblock<fbits> f = v.fraction();
+	for (unsigned i = 0; i < fbits; ++i) if (f.test(i)) M[i / bitsInLimb] |= limb(1) << (i % bitsInLimb);
+	// t = |x| 2/pi modulo 2^32
+	elementary_accumulator t(cl);
+	for (unsigned i = 0; i < M.size(); ++i) {
+		if (M[i] == 0) continue;
+		elementary_accumulator term(c);
+		term.mul(M[i]);
+		term <<= i * bitsInLimb;
+		t += term;
+	}
+	unsigned q = t.integer() & 0x3u;
+	t.setinteger(0);
+	if (t.test(-1)) {
+		t -= elementary_accumulator(cl, 1);
+		++q;
+	}
+	t.resize(fractionLimbs);
+	elementary_accumulator half_pi = constant(ElementaryConstant::pi, fractionLimbs);
+	half_pi >>= 1;
+	r = t * half_pi;
+	return q & 0x3u;
+}
+
+enum class TrigonometricFunction { sine, cosine, tangent };
+
+template<unsigned nbits, unsigned es>
+posit<nbits, es> posit_trigonometric(const posit<nbits, es>& x, TrigonometricFunction function) {
+	if (x.isnar()) return x;
+	if (x.iszero()) return (function == TrigonometricFunction::cosine ? posit_one<nbits, es>() : x);
+	auto v = decode_posit(x);
+	if (v.scale() < -static_cast<int>(nbits) / 2 - 2) {
+		// sin(x) = x - x^3/6, tan(x) = x + x^3/3, and cos(x) = 1 - x^2/2 round to x, x, and 1
+		return (function == TrigonometricFunction::cosine ? posit_one<nbits, es>() : x);
+	}
+	bool negative = v.sign();
+	return correctly_rounded<nbits, es>([&](unsigned fl, int& scaleOffset, int& errorBit) {
+		elementary_accumulator r;
+		unsigned q = reduce_half_pi(v, fl + 1, r);
+		elementary_accumulator s, c;
+		sincos_kernel(r, s, c);
+		elementary_accumulator y;
+		switch (function) {
+		case TrigonometricFunction::sine:
+			y = (q & 0x1u) ? c : s;
+			if (q >= 2) y.setsign(!y.isneg());
+			if (negative) y.setsign(!y.isneg());
+			break;
+		case TrigonometricFunction::cosine:
+			y = (q & 0x1u) ? s : c;
+			if (q == 1 || q == 2) y.setsign(!y.isneg());
+			break;
+		case TrigonometricFunction::tangent:
+			{
+				// tan(x) = sin(r)/cos(r) in even quadrants and -cos(r)/sin(r) in odd quadrants
+				int ms = s.msb(), mc = c.msb();
+				if (s.iszero()) { y = s; break; }
+				y = (q & 0x1u) ? divide(c, s, scaleOffset) : divide(s, c, scaleOffset);
+				if (q & 0x1u) y.setsign(!y.isneg());
+				if (negative) y.setsign(!y.isneg());
+				// the relative errors of numerator and denominator carry over into the quotient
+				int lost = std::max(0, -std::min(ms, mc));
+				errorBit = std::max(errorBit, -static_cast<int>(elementary_accumulator::bitsInLimb * (fl + 1)) + 8 + lost);
+			}
+			break;
+		}
+		return y;
+	});
+}
+
+}}} // namespace sw::universal::internal
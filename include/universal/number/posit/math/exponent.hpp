@@ -5,11 +5,41 @@
 // SPDX-License-Identifier: MIT
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/number/posit/math/elementary.hpp>
 
 namespace sw { namespace universal {
 
-// the current shims are NON-COMPLIANT with the posit standard, which says that every function must be
-// correctly rounded for every input value. Anything less sacrifices bitwise reproducibility of results.
+// With POSIT_NATIVE_ELEMENTARY_FUNCTIONS set, the functions are correctly rounded for every input value,
+// as the posit standard requires. The alternative shims round the double precision result, which is
+// NON-COMPLIANT and loses precision and dynamic range for posits wider than a double.
+
+#if POSIT_NATIVE_ELEMENTARY_FUNCTIONS
+
+// Base-e exponential function
+template<unsigned nbits, unsigned es>
+posit<nbits,es> exp(posit<nbits,es> x) {
+	return internal::elementary_function(x, [](const posit<nbits, es>& a) { return internal::posit_exp(a); });
+}
+
+// Base-2 exponential function
+template<unsigned nbits, unsigned es>
+posit<nbits,es> exp2(posit<nbits,es> x) {
+	return internal::elementary_function(x, [](const posit<nbits, es>& a) { return internal::posit_exp2(a); });
+}
+
+// Base-10 exponential function
+template<unsigned nbits, unsigned es>
+posit<nbits, es> exp10(posit<nbits, es> x) {
+	return internal::elementary_function(x, [](const posit<nbits, es>& a) { return internal::posit_exp10(a); });
+}
+
+// Base-e exponential function exp(x)-1
+template<unsigned nbits, unsigned es>
+posit<nbits,es> expm1(posit<nbits,es> x) {
+	return internal::elementary_function(x, [](const posit<nbits, es>& a) { return internal::posit_expm1(a); });
+}
+
+#else
 
 // Base-e exponential function
 template<unsigned nbits, unsigned es>
@@ -53,5 +83,7 @@ posit<nbits,es> expm1(posit<nbits,es> x) {
 	return posit<nbits,es>(std::expm1(double(x)));
 }
 
+#endif // POSIT_NATIVE_ELEMENTARY_FUNCTIONS
+
 
 }} // namespace sw::universal
@@ -5,11 +5,41 @@
 // SPDX-License-Identifier: MIT
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/number/posit/math/elementary.hpp>
 
 namespace sw { namespace universal {
 
-// the current shims are NON-COMPLIANT with the posit standard, which says that every function must be
-// correctly rounded for every input value. Anything less sacrifices bitwise reproducibility of results.
+// With POSIT_NATIVE_ELEMENTARY_FUNCTIONS set, the functions are correctly rounded for every input value,
+// as the posit standard requires. The alternative shims round the double precision result, which is
+// NON-COMPLIANT and loses precision and dynamic range for posits wider than a double.
+
+#if POSIT_NATIVE_ELEMENTARY_FUNCTIONS
+
+// Natural logarithm of x
+template<unsigned nbits, unsigned es>
+posit<nbits,es> log(posit<nbits,es> x) {
+	return internal::elementary_function(x, [](const posit<nbits, es>& a) { return internal::posit_log(a); });
+}
+
+// Binary logarithm of x
+template<unsigned nbits, unsigned es>
+posit<nbits,es> log2(posit<nbits,es> x) {
+	return internal::elementary_function(x, [](const posit<nbits, es>& a) { return internal::posit_log2(a); });
+}
+
+// Decimal logarithm of x
+template<unsigned nbits, unsigned es>
+posit<nbits,es> log10(posit<nbits,es> x) {
+	return internal::elementary_function(x, [](const posit<nbits, es>& a) { return internal::posit_log10(a); });
+}
+
+// Natural logarithm of 1+x
+template<unsigned nbits, unsigned es>
+posit<nbits,es> log1p(posit<nbits,es> x) {
+	return internal::elementary_function(x, [](const posit<nbits, es>& a) { return internal::posit_log1p(a); });
+}
+
+#else
 
 // Natural logarithm of x
 template<unsigned nbits, unsigned es>
@@ -35,4 +65,6 @@ posit<nbits,es> log1p(posit<nbits,es> x) {
 	return posit<nbits,es>(std::log1p(double(x)));
 }
 
+#endif // POSIT_NATIVE_ELEMENTARY_FUNCTIONS
+
 }} // namespace sw::universal
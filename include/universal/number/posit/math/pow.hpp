@@ -5,11 +5,32 @@
 // SPDX-License-Identifier: MIT
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/number/posit/math/elementary.hpp>
 
 namespace sw { namespace universal {
 
-// the current shims are NON-COMPLIANT with the posit standard, which says that every function must be
-// correctly rounded for every input value. Anything less sacrifices bitwise reproducibility of results.
+// With POSIT_NATIVE_ELEMENTARY_FUNCTIONS set, the functions are correctly rounded for every input value,
+// as the posit standard requires. The alternative shims round the double precision result, which is
+// NON-COMPLIANT and loses precision and dynamic range for posits wider than a double.
+
+#if POSIT_NATIVE_ELEMENTARY_FUNCTIONS
+
+template<unsigned nbits, unsigned es>
+posit<nbits,es> pow(posit<nbits,es> x, posit<nbits, es> y) {
+	return internal::posit_pow(x, internal::decode_posit(y));
+}
+		
+template<unsigned nbits, unsigned es>
+posit<nbits,es> pow(posit<nbits,es> x, int y) {
+	return internal::posit_pow(x, internal::value<64>(static_cast<long long>(y)));
+}
+		
+template<unsigned nbits, unsigned es>
+posit<nbits,es> pow(posit<nbits,es> x, double y) {
+	return internal::posit_pow(x, internal::value<52>(y));
+}
+
+#else
 
 template<unsigned nbits, unsigned es>
 posit<nbits,es> pow(posit<nbits,es> x, posit<nbits, es> y) {
@@ -26,6 +47,8 @@ posit<nbits,es> pow(posit<nbits,es> x, double y) {
 	return posit<nbits,es>(std::pow(double(x), y));
 }
 
+#endif // POSIT_NATIVE_ELEMENTARY_FUNCTIONS
+
 // calculate an integer power function base^int
 template<typename Scalar>
 Scalar integer_power(Scalar base, int exponent) {
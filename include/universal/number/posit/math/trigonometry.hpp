@@ -6,6 +6,7 @@
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 #include <universal/math/constants/double_constants.hpp>  // for m_pi_2
+#include <universal/number/posit/math/elementary.hpp>
 
 namespace sw { namespace universal {
 
@@ -15,6 +16,28 @@ namespace sw { namespace universal {
 // value representing an angle expressed in radians
 // One radian is equivalent to 180/PI degrees
 
+#if POSIT_NATIVE_ELEMENTARY_FUNCTIONS
+
+// sine of an angle of x radians, correctly rounded
+template<unsigned nbits, unsigned es>
+posit<nbits,es> sin(posit<nbits,es> x) {
+	return internal::elementary_function(x, [](const posit<nbits, es>& a) { return internal::posit_trigonometric(a, internal::TrigonometricFunction::sine); });
+}
+
+// cosine of an angle of x radians, correctly rounded
+template<unsigned nbits, unsigned es>
+posit<nbits,es> cos(posit<nbits,es> x) {
+	return internal::elementary_function(x, [](const posit<nbits, es>& a) { return internal::posit_trigonometric(a, internal::TrigonometricFunction::cosine); });
+}
+
+// tangent of an angle of x radians, correctly rounded
+template<unsigned nbits, unsigned es>
+posit<nbits,es> tan(posit<nbits,es> x) {
+	return internal::elementary_function(x, [](const posit<nbits, es>& a) { return internal::posit_trigonometric(a, internal::TrigonometricFunction::tangent); });
+}
+
+#else
+
 // sine of an angle of x radians
 template<unsigned nbits, unsigned es>
 posit<nbits,es> sin(posit<nbits,es> x) {
@@ -36,6 +59,8 @@ posit<nbits,es> tan(posit<nbits,es> x) {
 	return posit<nbits,es>(std::tan(double(x)));
 }
 
+#endif // POSIT_NATIVE_ELEMENTARY_FUNCTIONS
+
 // cotangent of an angle of x radians
 template<unsigned nbits, unsigned es>
 posit<nbits,es> atan(posit<nbits,es> x) {
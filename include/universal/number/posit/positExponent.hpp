@@ -43,7 +43,8 @@ public:
 		}
 	}
 	long double value() const {
-		return (long double)(uint64_t(1) << scale());
+		// es > 6 has exponent values beyond the 64-bit shift range
+		return std::ldexp(1.0l, scale());
 	}
 	bitblock<es> get() const {
 		return _Bits;
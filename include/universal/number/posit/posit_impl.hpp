@@ -39,6 +39,9 @@
 #include <universal/number/algorithm/trace_constants.hpp>
 #include <universal/internal/bitblock/bitblock.hpp>
 #include <universal/internal/value/value.hpp>
+#include <universal/number/shared/encoding_table.hpp>
+#include <universal/internal/f2s/dragon.hpp>
+#include <universal/internal/f2s/decimal_parse.hpp>
 #include <universal/number/shared/specific_value_encoding.hpp>
 
 // posit environment
@@ -1003,7 +1006,10 @@ public:
 	explicit operator long() const { return to_long(); }
 	explicit operator long long() const { return to_long_long(); }
 	explicit operator float() const { return to_float(); }
-	explicit operator double() const { return to_double(); }
+	explicit operator double() const {
+		if constexpr (encoding_table_traits<posit>::enabled) return encoding_table<posit>::to_double(*this);
+		else return to_double();
+	}
 	explicit operator long double() const { return to_long_double(); }
 
 	// Selectors
@@ -1252,6 +1258,9 @@ private:
 		return *this;
 	}
 
+	// the encoding table decodes through the conversion of the posit
+	friend struct encoding_table_traits<posit>;
+
 	// friend functions
 	// template parameters need names different from class template parameters (for gcc and clang)
 	template<unsigned nnbits, unsigned ees>
@@ -1731,15 +1740,109 @@ inline std::string hex_format(Float f) {
 	return ss.str();
 }
 
-// convert a posit value to a string using "nar" as designation of NaR
+// convert the decimal at the start of [first, last) to the nearest posit following std::from_chars:
+// the value is correctly rounded for any number of digits, inf and nan are mapped to NaR,
+// and values outside the dynamic range project to maxpos/minpos
 template<unsigned nbits, unsigned es>
-inline std::string to_string(const posit<nbits, es>& p, std::streamsize precision = 17) {
+std::from_chars_result from_chars(const char* first, const char* last, posit<nbits, es>& p) noexcept {
+	constexpr unsigned maxScale = (nbits - 2u) * (1u << es) + 2u;
+	constexpr unsigned nrWords = (nbits + 63u) / 64u;
+	constexpr unsigned fbits = 64u * nrWords - 1u;
+
+	parsed_decimal<nrWords> d;
+	std::from_chars_result r = parse_decimal<nrWords, maxScale, nbits - 2u>(first, last, d);
+	if (r.ec != std::errc{}) return r;
+	if (d.nan || d.inf) {
+		p.setnar();
+	}
+	else if (d.zero) {
+		p.setzero();
+	}
+	else {
+		// the round-to-odd fraction below the hidden bit carries the sticky bit for convert_
+		bitblock<fbits> fraction;
+		if constexpr (nrWords == 1) {
+			fraction = d.significand[0];
+		}
+		else {
+			for (unsigned i = 0; i < fbits; ++i) fraction[i] = d.at(static_cast<int>(i));
+		}
+		convert_<nbits, es, fbits>(d.sign, d.scale, fraction, p);
+	}
+	return r;
+}
+
+// convert a posit to decimal characters in the caller's buffer [first, last) following std::to_chars:
+// without a precision, the result is the shortest decimal that rounds back to the same posit,
+// with a precision, the result is the correctly rounded value in printf %f, %e, or %g format
+template<unsigned nbits, unsigned es>
+std::to_chars_result to_chars(char* first, char* last, const posit<nbits, es>& p, std::chars_format fmt = std::chars_format{}, int precision = -1) noexcept {
+	constexpr unsigned fbits = (es + 2 >= nbits ? 0 : nbits - 3 - es);
+	constexpr unsigned maxScale = (nbits - 2u) * (1u << es) + fbits + 2u;
+	constexpr unsigned nrLimbs = (fbits + 1u + 31u) / 32u;
 	if (p.isnar()) {
-		return std::string("nar");
+		if (last - first < 3) return { last, std::errc::value_too_large };
+		first[0] = 'n'; first[1] = 'a'; first[2] = 'r';
+		return { first + 3, std::errc{} };
 	}
-	std::stringstream ss;
-	ss << std::setprecision(precision) << (long double)p;
-	return ss.str();
+	std::uint32_t significand[nrLimbs] = { 0 };
+	if (p.iszero()) return dragon_to_chars<fbits + 1u, maxScale>(first, last, false, significand, nrLimbs, 0, 0, 0, false, fmt, precision);
+
+	// scale and number of fraction bits of a positive posit
+	auto decoded = [](const posit<nbits, es>& a, int& scale, unsigned& nf, bitblock<fbits>& fraction) {
+		bool s{ false };
+		positRegime<nbits, es> r;
+		positExponent<nbits, es> e;
+		positFraction<fbits> f;
+		decode(a.get(), s, r, e, f);
+		scale = r.scale() + e.scale();
+		nf = f.nrBits();
+		fraction = f.get();
+	};
+	posit<nbits, es> a(p.isneg() ? -p : p);
+	int scale{ 0 };
+	unsigned nf{ 0 };
+	bitblock<fbits> fraction;
+	decoded(a, scale, nf, fraction);
+	for (unsigned i = 0; i < fbits; ++i) {
+		if (fraction.test(i)) significand[i / 32u] |= (1u << (i % 32u));
+	}
+	significand[fbits / 32u] |= (1u << (fbits % 32u));
+	int lsbScale = scale - static_cast<int>(fbits);
+	int halfUlp = scale - static_cast<int>(nf) - 1;
+
+	// posits round to nearest on the encoding: inside a binade the rounding interval is half an ulp,
+	// across the truncated exponent bits of long regimes the midpoint is geometric
+	int neighborScale{ 0 };
+	unsigned neighborNf{ 0 };
+	bitblock<fbits> neighborFraction;
+	// only the largest and the smallest fraction of a binade can have a neighbor in another binade
+	bool allOnes = true;
+	for (unsigned i = fbits - nf; i < fbits; ++i) if (!fraction.test(i)) allOnes = false;
+	int upperGap = halfUlp;
+	posit<nbits, es> up(a);
+	if (allOnes && !(++up).isnar()) {
+		decoded(up, neighborScale, neighborNf, neighborFraction);
+		int d = neighborScale - scale;
+		if (d >= 2) upperGap = scale + d / 2 - 1;
+	}
+	int lowerGap = halfUlp;
+	posit<nbits, es> down(a);
+	if (fraction.none() && !(--down).iszero()) {
+		decoded(down, neighborScale, neighborNf, neighborFraction);
+		int d = scale - neighborScale;
+		if (d == 1) lowerGap = neighborScale - static_cast<int>(neighborNf) - 1;
+		else if (d >= 2) lowerGap = scale - 1;
+	}
+	return dragon_to_chars<fbits + 1u, maxScale>(first, last, p.isneg(), significand, nrLimbs, lsbScale, lowerGap, upperGap, false, fmt, precision);
+}
+
+// convert a posit value to a string with precision significant digits, as printf %g, using "nar" as designation of NaR
+template<unsigned nbits, unsigned es>
+inline std::string to_string(const posit<nbits, es>& p, std::streamsize precision = 17) {
+	int digits = static_cast<int>(precision < 0 ? 6 : precision);
+	return dragon_to_string([&](char* first, char* last) { return to_chars(first, last, p, std::chars_format::general, digits); },
+		static_cast<std::size_t>(digits) + 32u);
 }
 
 // binary representation of a posit with delimiters: i.e. 0.10.00.000000 => sign.positRegime.exp.positFraction
@@ -2658,9 +2761,11 @@ posit<nbits, es> fabs(const posit<nbits, es>& v) {
 // Atomic fused operators
 
 // FMA: fused multiply-add:  a*b + c
+// returns the unrounded sum: the product is kept exact and the sum carries a sticky bit.
+// For posits with fraction bits this is an internal::value<1 + 2 * (nbits - es)>.
 template<unsigned nbits, unsigned es>
-internal::value<1 + 2 * (nbits - es)> fma(const posit<nbits, es>& a, const posit<nbits, es>& b, const posit<nbits, es>& c) {
-	constexpr unsigned fbits = nbits - 3 - es;
+auto fma_unrounded(const posit<nbits, es>& a, const posit<nbits, es>& b, const posit<nbits, es>& c) {
+	constexpr unsigned fbits = (es + 2 >= nbits ? 0 : nbits - 3 - es);
 	constexpr unsigned fhbits = fbits + 1;      // size of positFraction + hidden bit
 	constexpr unsigned mbits = 2 * fhbits;      // size of the multiplier output
 	constexpr unsigned abits = mbits + 4;       // size of the addend
@@ -2706,6 +2811,29 @@ internal::value<1 + 2 * (nbits - es)> fma(const posit<nbits, es>& a, const posit
 	return sum;
 }
 
+// FMA: fused multiply-add:  a*b + c, rounded once
+// has_fma_trait is not set for posit: this value-based path is slower than a multiply followed by an add,
+// so the BLAS kernels keep using mul+add, and fused dot products should use the quire.
+template<unsigned nbits, unsigned es>
+posit<nbits, es> fma(const posit<nbits, es>& a, const posit<nbits, es>& b, const posit<nbits, es>& c) {
+	posit<nbits, es> result;
+	if (a.isnar() || b.isnar() || c.isnar()) {
+		result.setnar();
+		return result;
+	}
+	convert(fma_unrounded(a, b, c), result);
+	return result;
+}
+
+// posits of ENCODING_TABLE_NBITS bits or fewer convert to double through an exhaustive table
+template<unsigned nbits, unsigned es>
+struct encoding_table_traits< posit<nbits, es> > {
+	static constexpr bool enabled = (nbits <= ENCODING_TABLE_NBITS);
+	static constexpr bool logarithmic = false;
+	static std::uint64_t encoding(const posit<nbits, es>& p) noexcept { return p.bits(); }
+	static double decode(const posit<nbits, es>& p) { return p.to_double(); }
+};
+
 // FAM: fused add-multiply: (a + b) * c
 template<unsigned nbits, unsigned es>
 internal::value<2 * (nbits - 2 - es)> fam(const posit<nbits, es>& a, const posit<nbits, es>& b, const posit<nbits, es>& c) {
@@ -5,60 +5,52 @@
 // SPDX-License-Identifier: MIT
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
-#include <iostream>
-#include <regex>
-#include <sstream>
+#include <charconv>
+#include <cstdint>
+#include <string>
 #include <universal/number/posit/posit_fwd.hpp>
 
 namespace sw { namespace universal {
 
 // read a posit ASCII format and make a memory posit out of it
+// accepts the native posit form nbits.esXhexvalue[p], for example 32.2x40000000p,
+// and otherwise a decimal that is rounded correctly to the nearest posit
 template<unsigned nbits, unsigned es>
-bool parse(std::string& txt, posit<nbits, es>& p) {
-	bool bSuccess = false;
+bool parse(const std::string& txt, posit<nbits, es>& p) {
+	const char* first = txt.data();
+	const char* last  = first + txt.size();
+
 	// check if the txt is of the native posit form: nbits.esXhexvalue
-	std::regex posit_regex("[\\d]+\\.[0123456789][xX][\\w]+[p]*");
-	if (std::regex_match(txt, posit_regex)) {
-		// found a posit representation
-		std::string nbitsStr, esStr, bitStr;
-		auto it = txt.begin();
-		for (; it != txt.end(); it++) {
-			if (*it == '.') break;
-			nbitsStr.append(1, *it);
-		}
-		for (it++; it != txt.end(); it++) {
-			if (*it == 'x' || *it == 'X') break;
-			esStr.append(1, *it);
-		}
-		for (it++; it != txt.end(); it++) {
-			if (*it == 'p') break;
-			bitStr.append(1, *it);
+	const char* it = first;
+	unsigned nbits_in = 0;
+	while (it != last && *it >= '0' && *it <= '9') nbits_in = 10 * nbits_in + static_cast<unsigned>(*it++ - '0');
+	if (it != first && last - it >= 4 && it[0] == '.' && it[1] >= '0' && it[1] <= '9' && (it[2] == 'x' || it[2] == 'X')) {
+		it += 3;
+		const char* hex = it;
+		uint64_t raw = 0;
+		for (; it != last && *it != 'p'; ++it) {
+			char c = *it;
+			unsigned digit;
+			if (c >= '0' && c <= '9') digit = static_cast<unsigned>(c - '0');
+			else if (c >= 'a' && c <= 'f') digit = static_cast<unsigned>(c - 'a' + 10);
+			else if (c >= 'A' && c <= 'F') digit = static_cast<unsigned>(c - 'A' + 10);
+			else break;
+			raw = (raw << 4) | digit;
 		}
-		unsigned nbits_in = nbits;
-		{
-			std::istringstream ss(nbitsStr);
-			ss >> nbits_in;
+		while (it != last && *it == 'p') ++it;
+		if (it != hex && it == last) {
+			// if not aligned, setbits takes the least significant nbits, so we need to shift to pick up the most significant nbits
+			if (nbits < nbits_in) {
+				raw >>= (nbits_in - nbits);
+			}
+			p.setbits(raw);
+			return true;
 		}
-		uint64_t raw;
-		std::istringstream ss(bitStr);
-		ss >> std::hex >> raw;
-		//std::cout << "[" << nbitsStr << "] [" << esStr << "] [" << bitStr << "] = " << raw << std::endl;
-		// if not aligned, setbits takes the least significant nbits, so we need to shift to pick up the most significant nbits
-		if (nbits < nbits_in) {
-			raw >>= (nbits_in - nbits);
-		}
-		p.setbits(raw);  
-		bSuccess = true;
-	}
-	else {
-		// assume it is a float/double/long double representation
-		std::istringstream ss(txt);
-		double d;
-		ss >> d;
-		p = d;
-		bSuccess = true;
 	}
-	return bSuccess;
+
+	// assume it is a decimal representation
+	std::from_chars_result r = from_chars(first, last, p);
+	return (r.ec == std::errc{} && r.ptr == last);
 }
 
 }} // namespace sw::universal
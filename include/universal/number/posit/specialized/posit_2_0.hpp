@@ -170,7 +170,7 @@ public:
 	explicit operator unsigned long() const { return to_long(); }
 	explicit operator unsigned int() const { return to_int(); }
 
-	posit& setBitblock(sw::universal::bitblock<NBITS_IS_2>& raw) {
+	posit& setBitblock(const sw::universal::bitblock<NBITS_IS_2>& raw) {
 		_bits = uint8_t(raw.to_ulong() & bit_mask);
 		return *this;
 	}
@@ -137,7 +137,7 @@ namespace sw { namespace universal {
 				explicit operator unsigned long() const      { return to_long(); }
 				explicit operator unsigned int() const       { return to_int(); }
 
-				posit& setBitblock(sw::universal::bitblock<NBITS_IS_3>& raw) {
+				posit& setBitblock(const sw::universal::bitblock<NBITS_IS_3>& raw) {
 					_bits = uint8_t(raw.to_ulong());
 					return *this;
 				}
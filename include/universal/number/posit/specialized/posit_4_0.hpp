@@ -222,7 +222,7 @@ public:
 	explicit operator unsigned long() const { return to_long(); }
 	explicit operator unsigned int() const { return to_int(); }
 
-	posit& setBitblock(sw::universal::bitblock<NBITS_IS_4>& raw) {
+	posit& setBitblock(const sw::universal::bitblock<NBITS_IS_4>& raw) {
 		_bits = uint8_t(raw.to_ulong());
 		return *this;
 	}
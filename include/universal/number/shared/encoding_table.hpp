@@ -0,0 +1,231 @@
+#pragma once
+// encoding_table.hpp: exhaustive encode/decode tables for small number systems
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// number systems of this many bits or fewer convert to and from double through an exhaustive table
+#if !defined(ENCODING_TABLE_NBITS)
+#define ENCODING_TABLE_NBITS 16
+#endif
+
+/*
+	An encoding table replaces the field extraction of a conversion with a lookup.
+
+	  - decode: a table of 2^nbits doubles, indexed by the raw encoding, generated on first use
+	            with the conversion of the number system, so the lookup is bit-identical to it
+	  - encode: the finite values of the number system in increasing order, together with the
+	            doubles at which the conversion from double steps from one value to the next; a binary
+	            search over these thresholds selects the encoding. The thresholds are not derived from a
+	            rounding rule: they are located with the conversion of the number system itself, so
+	            tapered precision at the regime extremes of posits and takums, and rounding in the log
+	            domain of lns, are reproduced exactly. Zero, values that round to zero or to the extreme
+	            finite values, non-finite values, and intervals at whose ends the conversion disagrees
+	            with the table take the conversion of the number system.
+
+	A number system opts in by specializing encoding_table_traits with
+	  static constexpr bool enabled;                          nbits <= ENCODING_TABLE_NBITS
+	  static constexpr bool logarithmic;                      rounding happens in the log domain
+	  static std::uint64_t encoding(const Number&);           the raw bits
+	  static double decode(const Number&);                    the conversion to double
+*/
+
+namespace sw { namespace universal {
+
+	template<typename Number>
+	struct encoding_table_traits {
+		static constexpr bool enabled = false;
+	};
+
+	// raw encoding of a number system that stores its bits in blocks
+	template<typename Number>
+	std::uint64_t block_encoding(const Number& x) noexcept {
+		std::uint64_t bits{ 0 };
+		for (unsigned b = 0; b < Number::nrBlocks; ++b) {
+			bits |= static_cast<std::uint64_t>(x.block(b)) << (b * Number::bitsInBlock);
+		}
+		return bits & (0xFFFF'FFFF'FFFF'FFFFull >> (64 - Number::nbits));
+	}
+
+	template<typename Number>
+	class encoding_table {
+		using traits = encoding_table_traits<Number>;
+		static_assert(traits::enabled, "encoding_table: number system does not enable an encoding table");
+	public:
+		static constexpr unsigned    nbits = Number::nbits;
+		static constexpr std::size_t size  = std::size_t(1) << nbits;
+
+		static double to_double(const Number& x) noexcept {
+			return decode_table()[traits::encoding(x)];
+		}
+
+		static Number from_double(double v) {
+			const encode_table& t = encode_table_instance();
+			if (v == 0.0 || !(v >= t.lowest && v < t.highest)) return Number(v);
+			std::size_t i = static_cast<std::size_t>(std::upper_bound(t.thresholds.begin(), t.thresholds.end(), v) - t.thresholds.begin());
+			if (t.codes[i] == conversion) return Number(v);
+			Number x;
+			x.setbits(t.codes[i]);
+			return x;
+		}
+
+		// the doubles at which the encoding steps from codes[i] to codes[i+1]
+		static const std::vector<double>& thresholds() { return encode_table_instance().thresholds; }
+
+	private:
+		static constexpr std::uint64_t conversion = ~std::uint64_t(0);  // interval that takes the conversion of the number system
+
+		struct encode_table {
+			std::vector<std::uint64_t> codes;       // encodings, in increasing value
+			std::vector<double>        thresholds;  // v >= thresholds[i] encodes at or above codes[i+1]
+			double lowest{ 0.0 };                  // the encodings of [lowest, highest) are looked up
+			double highest{ 0.0 };
+		};
+
+		static const std::vector<double>& decode_table() {
+			static const std::vector<double> t = []() {
+				std::vector<double> values(size);
+				Number a;
+				for (std::size_t i = 0; i < size; ++i) {
+					a.setbits(i);
+					values[i] = traits::decode(a);
+				}
+				return values;
+			}();
+			return t;
+		}
+
+		// doubles mapped to integers that order the same way, so that bisection can step through them
+		static std::int64_t key(double v) noexcept {
+			std::uint64_t u;
+			std::memcpy(&u, &v, sizeof(u));
+			std::int64_t magnitude = static_cast<std::int64_t>(u & 0x7FFF'FFFF'FFFF'FFFFull);
+			return (u >> 63) ? -magnitude : magnitude;
+		}
+		static double value_of(std::int64_t k) noexcept {
+			std::uint64_t u = (k < 0 ? (static_cast<std::uint64_t>(-k) | 0x8000'0000'0000'0000ull) : static_cast<std::uint64_t>(k));
+			double v;
+			std::memcpy(&v, &u, sizeof(v));
+			return v;
+		}
+
+		// smallest double that the conversion of the number system rounds to hi or above, given neighbors lo < hi
+		static double locate_threshold(double lo, double hi) {
+			const std::vector<double>& values = decode_table();
+			auto roundsUp = [&values, hi](std::int64_t k) {
+				return values[traits::encoding(Number(value_of(k)))] >= hi;
+			};
+			constexpr std::int64_t kmin = -0x7FEF'FFFF'FFFF'FFFFll;  // -DBL_MAX
+			constexpr std::int64_t kmax =  0x7FEF'FFFF'FFFF'FFFFll;  //  DBL_MAX
+			std::int64_t klo = key(lo), khi = key(hi);
+			double midpoint = lo / 2 + hi / 2;
+			if constexpr (traits::logarithmic) {
+				if (lo != 0.0 && hi != 0.0 && (lo < 0.0) == (hi < 0.0)) {
+					midpoint = std::sqrt(lo * hi);
+					if (lo < 0.0) midpoint = -midpoint;
+				}
+			}
+			// round-to-nearest places the threshold at the midpoint, truncation at either neighbor
+			std::int64_t candidates[] = { key(midpoint), khi, khi + 1, klo + 1 };
+			for (std::int64_t k : candidates) {
+				if (k > kmin && k <= kmax && roundsUp(k) && !roundsUp(k - 1)) return value_of(k);
+			}
+			// otherwise gallop away from the midpoint until the threshold is bracketed by (a, b], and bisect
+			std::int64_t a{ candidates[0] }, b{ candidates[0] };
+			if (roundsUp(b)) {
+				for (std::uint64_t step = 1; ; step *= 2) {
+					a = (static_cast<std::uint64_t>(b - kmin) > step) ? b - static_cast<std::int64_t>(step) : kmin;
+					if (a == kmin || !roundsUp(a)) break;
+					b = a;
+				}
+			}
+			else {
+				for (std::uint64_t step = 1; ; step *= 2) {
+					b = (static_cast<std::uint64_t>(kmax - a) > step) ? a + static_cast<std::int64_t>(step) : kmax;
+					if (b == kmax || roundsUp(b)) break;
+					a = b;
+				}
+			}
+			while (b - a > 1) {
+				std::int64_t m = a + (b - a) / 2;
+				if (roundsUp(m)) b = m; else a = m;
+			}
+			return value_of(b);
+		}
+
+		static const encode_table& encode_table_instance() {
+			static const encode_table t = []() {
+				const std::vector<double>& values = decode_table();
+				// the finite values in increasing order, with a single zero. Encodings that the conversion never
+				// produces, such as subnormals of a cfloat without subnormals, end up with an empty interval
+				// between two equal thresholds, and are never selected
+				std::vector<std::pair<double, std::uint64_t>> sorted;
+				sorted.reserve(size);
+				for (std::size_t i = 0; i < size; ++i) {
+					double v = values[i];
+					if (!std::isfinite(v) || (v == 0.0 && std::signbit(v))) continue;
+					sorted.emplace_back(v, static_cast<std::uint64_t>(i));
+				}
+				std::sort(sorted.begin(), sorted.end());
+				sorted.erase(std::unique(sorted.begin(), sorted.end(), [](const auto& lhs, const auto& rhs) { return lhs.first == rhs.first; }), sorted.end());
+				encode_table e;
+				if (sorted.size() < 3) return e;
+				e.codes.reserve(sorted.size());
+				e.thresholds.reserve(sorted.size() - 1);
+				for (std::size_t i = 0; i < sorted.size(); ++i) {
+					e.codes.push_back(sorted[i].second);
+					if (i > 0) e.thresholds.push_back(std::max(locate_threshold(sorted[i - 1].first, sorted[i].first), (i > 1 ? e.thresholds.back() : -INFINITY)));
+				}
+				// an interval [thresholds[i-1], thresholds[i]) is looked up only when the conversion agrees at both ends:
+				// zero, whose sign the conversion decides, and conversions that are not monotone stay with the conversion
+				for (std::size_t i = 1; i + 1 < e.codes.size(); ++i) {
+					double lo = e.thresholds[i - 1], hi = e.thresholds[i];
+					if (lo == hi) continue;
+					std::uint64_t code = e.codes[i];
+					if (sorted[i].first == 0.0 ||
+					    traits::encoding(Number(lo)) != code ||
+					    traits::encoding(Number(std::nextafter(hi, -INFINITY))) != code) {
+						e.codes[i] = conversion;
+					}
+				}
+				// the extreme encodings border on overflow and underflow behavior, which stays with the conversion
+				e.lowest = e.thresholds.front();
+				e.highest = e.thresholds.back();
+				return e;
+			}();
+			return t;
+		}
+	};
+
+	// convert an array of a number system to double
+	template<typename Number>
+	void convert_to_double(const Number* src, double* dst, std::size_t n) {
+		if constexpr (encoding_table_traits<Number>::enabled) {
+			for (std::size_t i = 0; i < n; ++i) dst[i] = encoding_table<Number>::to_double(src[i]);
+		}
+		else {
+			for (std::size_t i = 0; i < n; ++i) dst[i] = double(src[i]);
+		}
+	}
+
+	// convert an array of doubles to a number system
+	template<typename Number>
+	void convert_from_double(const double* src, Number* dst, std::size_t n) {
+		if constexpr (encoding_table_traits<Number>::enabled) {
+			for (std::size_t i = 0; i < n; ++i) dst[i] = encoding_table<Number>::from_double(src[i]);
+		}
+		else {
+			for (std::size_t i = 0; i < n; ++i) dst[i] = Number(src[i]);
+		}
+	}
+
+}} // namespace sw::universal
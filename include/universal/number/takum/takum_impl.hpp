@@ -11,6 +11,7 @@
 #include <universal/native/ieee754.hpp>
 #include <universal/internal/blockbinary/blockbinary.hpp>
 #include <universal/internal/abstract/triple.hpp>
+#include <universal/number/shared/encoding_table.hpp>
 
 namespace sw {	namespace universal {
 		
@@ -122,7 +123,12 @@ public:
 	explicit constexpr operator long()      const noexcept { return to_signed<long>(); }
 	explicit constexpr operator long long() const noexcept { return to_signed<long long>(); }
 	explicit constexpr operator float()     const noexcept { return to_ieee754<float>(); }
-	explicit constexpr operator double()    const noexcept { return to_ieee754<double>(); }
+	explicit constexpr operator double()    const noexcept {
+		if constexpr (encoding_table_traits<takum>::enabled) {
+			if (!std::is_constant_evaluated()) return encoding_table<takum>::to_double(*this);
+		}
+		return to_ieee754<double>();
+	}
 
 	// guard long double support to enable ARM and RISC-V embedded environments
 #if LONG_DOUBLE_SUPPORT
@@ -512,6 +518,9 @@ protected:
 private:
 	BlockBinary _block;
 
+	// the encoding table decodes through the conversion of the takum
+	friend struct encoding_table_traits<takum>;
+
 	// template parameters need names different from class template parameters (for gcc and clang)
 	template<unsigned nnbits, typename nbt>
 	friend std::ostream& operator<< (std::ostream& ostr, const takum<nnbits, nbt>& r);
@@ -532,6 +541,15 @@ private:
 	friend bool operator>=(const takum<nnbits, nbt>& lhs, const takum<nnbits, nbt>& rhs);
 };
 
+// takums of ENCODING_TABLE_NBITS bits or fewer convert to double through an exhaustive table
+template<unsigned nbits, typename bt>
+struct encoding_table_traits< takum<nbits, bt> > {
+	static constexpr bool enabled = (nbits <= ENCODING_TABLE_NBITS);
+	static constexpr bool logarithmic = false;
+	static std::uint64_t encoding(const takum<nbits, bt>& t) noexcept { return block_encoding(t); }
+	static double decode(const takum<nbits, bt>& t) noexcept { return t.template to_ieee754<double>(); }
+};
+
 // return the Unit in the Last Position
 template<unsigned nbits, typename bt>
 inline takum<nbits, bt> ulp(const takum<nbits, bt>& a) {
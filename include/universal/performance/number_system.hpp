@@ -12,6 +12,8 @@
 #include <chrono>
 #include <universal/native/ieee754.hpp>
 #include <universal/utility/scientific.hpp>
+#include <universal/benchmark/performance_runner.hpp>
+#include <universal/benchmark/performance_counters.hpp>
 
 namespace sw { namespace universal {
 
@@ -380,4 +382,77 @@ namespace sw { namespace universal {
 		report.div = (double(positives) + double(negatives)) / elapsed;
 	}
 
+	// operator selection of the counter report: the workloads are written for posits, and a number system
+	// that lacks an operator, or only exercises its error path with these operands, leaves it out
+	struct PerformanceOperators {
+		static constexpr unsigned intconvert  = 0x001;
+		static constexpr unsigned ieeeconvert = 0x002;
+		static constexpr unsigned prefix      = 0x004;
+		static constexpr unsigned postfix     = 0x008;
+		static constexpr unsigned neg         = 0x010;
+		static constexpr unsigned sqrt        = 0x020;
+		static constexpr unsigned add         = 0x040;
+		static constexpr unsigned sub         = 0x080;
+		static constexpr unsigned mul         = 0x100;
+		static constexpr unsigned div         = 0x200;
+		static constexpr unsigned all         = 0x3FF;
+	};
+
+	// run the operator workloads of GeneratePerformanceReport under the hardware performance counters,
+	// and append one record per selected operator for the CSV/JSON writers
+	template<typename Scalar>
+	void GeneratePerformanceCounterReport(const std::string& numberSystem, Scalar& number, std::vector<PerformanceRecord>& records, unsigned operators = PerformanceOperators::all) {
+		int positives{ 0 }, negatives{ 0 };
+		auto measure = [&](unsigned selector, const char* op, int (*workload)(Scalar&, int&, int&)) {
+			if ((operators & selector) == 0) return;
+			PerformanceRecord record;
+			record.numberSystem = numberSystem;
+			record.op = op;
+			record.counters = MeasurePerformanceCounters([&](size_t) { workload(number, positives, negatives); }, 0);
+			record.counters.nrOps = static_cast<size_t>(positives) + static_cast<size_t>(negatives);
+			records.push_back(record);
+		};
+		measure(PerformanceOperators::intconvert,   "intconvert",  MeasureIntegerConversionPerformance<Scalar>);
+		measure(PerformanceOperators::ieeeconvert,  "ieeeconvert", MeasureIeeeConversionPerformance<Scalar>);
+		measure(PerformanceOperators::prefix,       "prefix",      MeasurePrefixPerformance<Scalar>);
+		measure(PerformanceOperators::postfix,      "postfix",     MeasurePostfixPerformance<Scalar>);
+		measure(PerformanceOperators::neg,          "neg",         MeasureNegationPerformance<Scalar>);
+		measure(PerformanceOperators::sqrt,         "sqrt",        MeasureSqrtPerformance<Scalar>);
+		measure(PerformanceOperators::add,          "add",         MeasureAdditionPerformance<Scalar>);
+		measure(PerformanceOperators::sub,          "sub",         MeasureSubtractionPerformance<Scalar>);
+		measure(PerformanceOperators::mul,          "mul",         MeasureMultiplicationPerformance<Scalar>);
+		measure(PerformanceOperators::div,          "div",         MeasureDivisionPerformance<Scalar>);
+	}
+
+	// human readable report of the operator records: POPS plus the counter rates per operation
+	inline std::string ReportPerformance(const std::vector<PerformanceRecord>& records) {
+		std::stringstream ostr;
+		std::string numberSystem;
+		for (const auto& r : records) {
+			if (r.numberSystem != numberSystem) {
+				numberSystem = r.numberSystem;
+				ostr << "Performance Report for type: " << numberSystem << '\n'
+					<< std::setw(12) << "operator" << std::setw(FLOAT_TABLE_WIDTH) << "POPS"
+					<< std::setw(8) << "IPC" << std::setw(FLOAT_TABLE_WIDTH) << "instr/op"
+					<< std::setw(FLOAT_TABLE_WIDTH) << "branches/op" << std::setw(FLOAT_TABLE_WIDTH) << "br-miss/op"
+					<< std::setw(FLOAT_TABLE_WIDTH) << "L1D-miss/op" << std::setw(FLOAT_TABLE_WIDTH) << "LLC-miss/op" << '\n';
+			}
+			const PerformanceCounters& c = r.counters;
+			ostr << std::setw(12) << r.op << std::setw(FLOAT_TABLE_WIDTH) << to_scientific(c.ops_per_second());
+			if (c.has(PerformanceEvent::instructions)) {
+				ostr << std::setw(8) << std::setprecision(3) << c.ipc()
+					<< std::setw(FLOAT_TABLE_WIDTH) << c.per_op(PerformanceEvent::instructions)
+					<< std::setw(FLOAT_TABLE_WIDTH) << c.per_op(PerformanceEvent::branches)
+					<< std::setw(FLOAT_TABLE_WIDTH) << c.per_op(PerformanceEvent::branchMisses)
+					<< std::setw(FLOAT_TABLE_WIDTH) << c.per_op(PerformanceEvent::l1dMisses)
+					<< std::setw(FLOAT_TABLE_WIDTH) << c.per_op(PerformanceEvent::llcMisses);
+			}
+			else {
+				ostr << "    hardware counters unavailable";
+			}
+			ostr << '\n';
+		}
+		return ostr.str();
+	}
+
 }} // namespace sw::universal
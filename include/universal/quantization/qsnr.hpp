@@ -21,8 +21,9 @@ namespace sw { namespace universal {
 		// std::cout << type_tag(Scalar()) << " : " << symmetry_range<Scalar>() << '\n';
 		size_t N = size(v);
 
-		blas::SummaryStats<double> stats = blas::summaryStatistics(v);
-		auto stddev = stats.stddev;
+		blas::StreamingStats<double> stats;  // only the spread is needed, so skip the quantiles
+		for (auto number : v) stats.push(number);
+		auto stddev = stats.stddev();
 
 		double sum = 0.0;
 		for (auto number : v) {
@@ -0,0 +1,23 @@
+#pragma once
+// fma_traits.hpp : trait to identify number systems with a fused multiply-add
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/traits/integral_constant.hpp>
+
+namespace sw { namespace universal {
+
+	// number systems that provide an fma(a, b, c) with a single rounding event specialize this trait,
+	// so that generic kernels can select the fused path without relying on an fma declaration alone
+	template<typename _Ty>
+	struct has_fma_trait
+		: false_type
+	{
+	};
+
+	template<typename _Ty>
+	constexpr bool has_fma = has_fma_trait<_Ty>::value;
+
+}} // namespace sw::universal
@@ -1865,5 +1865,84 @@ namespace sw { namespace universal {
 		return nrOfFailedTests;
 	}
 
+	/// <summary>
+	/// Enumerate all reciprocal square root cases for a cfloat configuration.
+	/// Uses doubles to create a reference to verify against: 1/sqrt(x) in double precision
+	/// is close enough to the exact value to round correctly to cfloats of up to 16 bits.
+	/// </summary>
+	/// <param name="reportTestCases"></param>
+	/// <returns></returns>
+	template<typename TestType>
+	int VerifyCfloatRsqrt(bool reportTestCases) {
+		constexpr unsigned nbits = TestType::nbits;
+		static_assert(nbits <= 16, "VerifyCfloatRsqrt: the double precision reference requires nbits <= 16");
+		constexpr unsigned NR_TEST_CASES = (1u << (nbits - 1)); // remove the negative values from the test
+		int nrOfFailedTests = 0;
+
+		for (unsigned i = 1; i < NR_TEST_CASES; i++) {
+			TestType ca, crsqrt, cref;
+			ca.setbits(i);
+			if (ca.isnan()) continue;
+			crsqrt = sw::universal::rsqrt(ca);
+			// generate reference
+			double da = double(ca);
+			cref = 1.0 / std::sqrt(da);
+			if (crsqrt != cref) {
+				if (crsqrt.isnan() && cref.isnan()) continue;
+				nrOfFailedTests++;
+				if (reportTestCases)	ReportUnaryArithmeticError("FAIL", "rsqrt", ca, crsqrt, cref);
+				if (nrOfFailedTests > 24) return nrOfFailedTests;
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+
+	/// <summary>
+	/// Enumerate all fused multiply-add cases for a cfloat configuration.
+	/// Uses doubles to create a reference to verify against: the product and the sum of small cfloats
+	/// span fewer than 53 bits, so std::fma in double precision is exact and a single rounding remains.
+	/// </summary>
+	/// <param name="reportTestCases"></param>
+	/// <returns></returns>
+	template<typename TestType>
+	int VerifyCfloatFma(bool reportTestCases) {
+		constexpr unsigned nbits = TestType::nbits;
+		constexpr unsigned es = TestType::es;
+		static_assert(nbits <= 10 && es <= 4, "VerifyCfloatFma: the double precision reference requires nbits <= 10 and es <= 4");
+		constexpr unsigned NR_ENCODINGS = (1u << nbits);
+		int nrOfFailedTests = 0;
+
+		for (unsigned i = 0; i < NR_ENCODINGS; i++) {
+			TestType ca;
+			ca.setbits(i);
+			double da = double(ca);
+			if (!ca.isnan() && TestType(da) != ca) continue;  // skip encodings that are not values, such as subnormals of a cfloat without subnormals
+			for (unsigned j = 0; j < NR_ENCODINGS; j++) {
+				TestType cb;
+				cb.setbits(j);
+				double db = double(cb);
+				if (!cb.isnan() && TestType(db) != cb) continue;
+				for (unsigned k = 0; k < NR_ENCODINGS; k++) {
+					TestType cc, cfma, cref;
+					cc.setbits(k);
+					double dc = double(cc);
+					if (!cc.isnan() && TestType(dc) != cc) continue;
+					cfma = sw::universal::fma(ca, cb, cc);
+					// generate reference
+					cref = std::fma(da, db, dc);
+					if (cfma != cref) {
+						if (cfma.isnan() && cref.isnan()) continue;
+						if (cfma.iszero() && cref.iszero()) continue;  // the sign of a zero sum follows the unfused operators
+						nrOfFailedTests++;
+						if (reportTestCases) std::cerr << "FAIL fma(" << to_binary(ca) << ", " << to_binary(cb) << ", " << to_binary(cc) << ") = " << to_binary(cfma) << " reference " << to_binary(cref) << '\n';
+						if (nrOfFailedTests > 24) return nrOfFailedTests;
+					}
+				}
+			}
+		}
+		return nrOfFailedTests;
+	}
+
 }} // namespace sw::universal
 
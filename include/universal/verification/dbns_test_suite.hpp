@@ -0,0 +1,127 @@
+#pragma once
+// dbns_test_suite.hpp : test suite runners for double-base logarithmic number system arithmetic
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#include <universal/verification/test_status.hpp>
+#include <universal/verification/test_reporters.hpp>
+
+namespace sw { namespace universal {
+
+	// Reference rounding for dbns arithmetic: the encoding whose magnitude is closest,
+	// in the log domain, to a double precision value. It enumerates and sorts all positive
+	// encodings, so it is independent of the conversion and arithmetic of the dbns type.
+	template<typename DbnsType>
+	class DbnsReference {
+	public:
+		DbnsReference() {
+			constexpr size_t NR_MAGNITUDES = (1ull << (DbnsType::nbits - 1));
+			DbnsType v{}, negv{};
+			for (size_t i = 0; i < NR_MAGNITUDES; ++i) {
+				v.setbits(i);
+				if (v.iszero()) continue;
+				negv.setbits(i | NR_MAGNITUDES);
+				magnitudes.push_back({ std::log2(double(v)), v, negv });
+			}
+			std::sort(magnitudes.begin(), magnitudes.end(), [](const entry& lhs, const entry& rhs) { return lhs.logv < rhs.logv; });
+		}
+
+		DbnsType nearest(double value) const {
+			DbnsType result{};
+			if (std::isnan(value)) {
+				result.setnan();
+				return result;
+			}
+			if (value == 0.0) {
+				result.setzero();
+				return result;
+			}
+			double target = std::log2(std::abs(value));
+			auto hi = std::upper_bound(magnitudes.begin(), magnitudes.end(), target, [](double t, const entry& e) { return t < e.logv; });
+			auto nearest = hi;
+			if (hi == magnitudes.end()) nearest = hi - 1;
+			else if (hi != magnitudes.begin() && (target - (hi - 1)->logv) <= (hi->logv - target)) nearest = hi - 1;
+			return (value < 0.0 ? nearest->negv : nearest->v);
+		}
+
+		// the candidate is as close to the value as the reference: accepts the other side of a near tie
+		bool equidistant(const DbnsType& candidate, const DbnsType& ref, double value) const {
+			if (candidate.iszero() || candidate.isnan() || ref.iszero() || ref.isnan()) return false;
+			if (candidate.sign() != ref.sign()) return false;
+			double target = std::log2(std::abs(value));
+			double e1 = std::abs(std::log2(std::abs(double(candidate))) - target);
+			double e2 = std::abs(std::log2(std::abs(double(ref))) - target);
+			return std::abs(e1 - e2) < 1.0e-9;
+		}
+
+	private:
+		struct entry {
+			double   logv;
+			DbnsType v;
+			DbnsType negv;
+		};
+		std::vector<entry> magnitudes;
+	};
+
+	// enumerate all addition cases for a dbns configuration, the reference is the log-domain nearest encoding of the sum
+	template<typename DbnsType>
+	int VerifyDbnsAddition(bool reportTestCases) {
+		constexpr size_t NR_ENCODINGS = (1ull << DbnsType::nbits);
+		DbnsReference<DbnsType> reference;
+		int nrOfFailedTestCases = 0;
+		DbnsType a{}, b{}, c{}, cref{};
+		for (size_t i = 0; i < NR_ENCODINGS; ++i) {
+			a.setbits(i);
+			double da = double(a);
+			for (size_t j = 0; j < NR_ENCODINGS; ++j) {
+				b.setbits(j);
+				double ref = da + double(b);
+				c = a + b;
+				cref = reference.nearest(ref);
+				if (c != cref) {
+					if (c.isnan() && cref.isnan()) continue; // NaN non-equivalence
+					if (reference.equidistant(c, cref, ref)) continue;
+					++nrOfFailedTestCases;
+					if (reportTestCases) ReportBinaryArithmeticError("FAIL", "+", a, b, c, cref);
+				}
+				if (nrOfFailedTestCases > 24) return nrOfFailedTestCases;
+			}
+		}
+		return nrOfFailedTestCases;
+	}
+
+	// enumerate all subtraction cases for a dbns configuration, the reference is the log-domain nearest encoding of the difference
+	template<typename DbnsType>
+	int VerifyDbnsSubtraction(bool reportTestCases) {
+		constexpr size_t NR_ENCODINGS = (1ull << DbnsType::nbits);
+		DbnsReference<DbnsType> reference;
+		int nrOfFailedTestCases = 0;
+		DbnsType a{}, b{}, c{}, cref{};
+		for (size_t i = 0; i < NR_ENCODINGS; ++i) {
+			a.setbits(i);
+			double da = double(a);
+			for (size_t j = 0; j < NR_ENCODINGS; ++j) {
+				b.setbits(j);
+				double ref = da - double(b);
+				c = a - b;
+				cref = reference.nearest(ref);
+				if (c != cref) {
+					if (c.isnan() && cref.isnan()) continue; // NaN non-equivalence
+					if (reference.equidistant(c, cref, ref)) continue;
+					++nrOfFailedTestCases;
+					if (reportTestCases) ReportBinaryArithmeticError("FAIL", "-", a, b, c, cref);
+				}
+				if (nrOfFailedTestCases > 24) return nrOfFailedTestCases;
+			}
+		}
+		return nrOfFailedTestCases;
+	}
+
+}} // namespace sw::universal
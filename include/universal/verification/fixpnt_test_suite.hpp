@@ -348,6 +348,35 @@ int VerifyMultiplication(bool reportTestCases) {
 	return nrOfFailedTests;
 }
 
+// enumerate all fused multiply-add cases for a fixpnt<nbits,rbits> configuration
+// the double precision fma is exact for these sizes, so the fixpnt conversion is the single rounding
+template<unsigned nbits, unsigned rbits, bool arithmetic, typename BlockType>
+int VerifyFma(bool reportTestCases) {
+	static_assert(nbits <= 16, "VerifyFma: the double precision reference requires nbits <= 16");
+	constexpr unsigned NR_VALUES = (unsigned(1) << nbits);
+	int nrOfFailedTests = 0;
+	fixpnt<nbits, rbits, arithmetic, BlockType> a, b, c, result, cref;
+	for (unsigned i = 0; i < NR_VALUES; i++) {
+		a.setbits(i);
+		double da = double(a);
+		for (unsigned j = 0; j < NR_VALUES; j++) {
+			b.setbits(j);
+			double db = double(b);
+			for (unsigned k = 0; k < NR_VALUES; k++) {
+				c.setbits(k);
+				result = fma(a, b, c);
+				cref = std::fma(da, db, double(c));
+				if (result != cref) {
+					nrOfFailedTests++;
+					if (reportTestCases) std::cerr << "FAIL fma(" << to_binary(a) << ", " << to_binary(b) << ", " << to_binary(c) << ") = " << to_binary(result) << " reference " << to_binary(cref) << '\n';
+				}
+				if (nrOfFailedTests > 24) return nrOfFailedTests;
+			}
+		}
+	}
+	return nrOfFailedTests;
+}
+
 // enumerate all division cases for a fixpnt<nbits,rbits> configuration
 template<unsigned nbits, unsigned rbits, bool arithmetic, typename BlockType>
 int VerifyDivision(bool reportTestCases) {
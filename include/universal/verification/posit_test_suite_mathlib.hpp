@@ -114,7 +114,7 @@ int VerifyExp(bool reportTestCases) {
 		double da = double(pa);
 		pref = std::exp(da);
 		if (pexp != pref) {
-			if (std::exp(da) != 0.0) { // exclude special posit rounding rule that projects to minpos
+			if (std::exp(da) != 0.0 && !std::isinf(std::exp(da))) { // exclude special posit rounding rules that project to minpos and maxpos
 				nrOfFailedTests++;
 				if (reportTestCases)	ReportOneInputFunctionError("FAIL", "exp", pa, pexp, pref);
 			}
@@ -142,7 +142,7 @@ int VerifyExp2(bool reportTestCases) {
 		double da = double(pa);
 		pref = std::exp2(da);
 		if (pexp2 != pref) {
-			if (std::exp2(da) != 0.0) { // exclude special posit rounding rule that projects to minpos
+			if (std::exp2(da) != 0.0 && !std::isinf(std::exp2(da))) { // exclude special posit rounding rules that project to minpos and maxpos
 				nrOfFailedTests++;
 				if (reportTestCases)	ReportOneInputFunctionError("FAIL", "exp2", pa, pexp2, pref);
 			}
@@ -187,8 +187,11 @@ int VerifyPowerFunction(bool reportTestCases, unsigned int maxSamples = 10000) {
 #endif
 			pref = std::pow(da, db);
 			if (ppow != pref) {
-				nrOfFailedTests++;
-				if (reportTestCases)	ReportTwoInputFunctionError("FAIL", "pow", pa, pb, ppow, pref);
+				// exclude special posit rounding rules that project to minpos and maxpos: the reference underflows to zero or overflows to NaR
+				if (da == 0.0 || std::isnan(std::pow(da, db)) || !(pref.iszero() || pref.isnar())) {
+					nrOfFailedTests++;
+					if (reportTestCases)	ReportTwoInputFunctionError("FAIL", "pow", pa, pb, ppow, pref);
+				}
 			}
 			else {
 				//if (reportTestCases) ReportTwoInputFunctionSuccess("PASS", "pow", pa, pb, ppow, pref);
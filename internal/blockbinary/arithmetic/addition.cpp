@@ -174,6 +174,7 @@ try {
 	nrOfFailedTestCases += ReportTestResult(VerifyAddition<12, uint8_t>(bReportIndividualTestCases), "blockbinary<12,uint8_t>", "addition");
 	nrOfFailedTestCases += ReportTestResult(VerifyAddition<12, uint16_t>(bReportIndividualTestCases), "blockbinary<12,uint16_t>", "addition");
 	nrOfFailedTestCases += ReportTestResult(VerifyAddition<12, uint32_t>(bReportIndividualTestCases), "blockbinary<12,uint32_t>", "addition");
+	nrOfFailedTestCases += ReportTestResult(VerifyAddition<12, uint64_t>(bReportIndividualTestCases), "blockbinary<12,uint64_t>", "addition");
 
 #if STRESS_TESTING
 
@@ -0,0 +1,147 @@
+// limbs.cpp: verification of blockbinary arithmetic on uint64_t limbs against the same arithmetic on uint32_t limbs
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <universal/utility/long_double.hpp>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <universal/internal/blockbinary/blockbinary.hpp>
+#include <universal/verification/test_status.hpp> // ReportTestResult
+
+/*
+   blockbinary<nbits, uint64_t> propagates carries and partial products through the limb
+   primitives of limbs.hpp, the uint32_t configuration accumulates them in a uint64_t.
+   The random operands are drawn limb by limb from {0, all ones, random} so that
+   long carry and borrow chains are exercised.
+*/
+
+namespace sw { namespace universal {
+
+	template<unsigned nbits, BinaryNumberType NumberType>
+	void CopyLimbs(const blockbinary<nbits, std::uint32_t, NumberType>& src, blockbinary<nbits, std::uint64_t, NumberType>& tgt) {
+		for (unsigned i = 0; i < blockbinary<nbits, std::uint64_t, NumberType>::nrBlocks; ++i) {
+			std::uint64_t lo = src.block(2 * i);
+			std::uint64_t hi = (2 * i + 1 < blockbinary<nbits, std::uint32_t, NumberType>::nrBlocks ? src.block(2 * i + 1) : 0u);
+			tgt.setblock(i, (hi << 32) | lo);
+		}
+	}
+
+	template<unsigned nbits, BinaryNumberType NumberType>
+	bool SameLimbs(const blockbinary<nbits, std::uint32_t, NumberType>& ref, const blockbinary<nbits, std::uint64_t, NumberType>& result) {
+		blockbinary<nbits, std::uint64_t, NumberType> r;
+		CopyLimbs(ref, r);
+		return r == result;
+	}
+
+	template<unsigned nbits, BinaryNumberType NumberType, typename RandomEngine>
+	blockbinary<nbits, std::uint32_t, NumberType> RandomLimbs(RandomEngine& engine) {
+		using Reference = blockbinary<nbits, std::uint32_t, NumberType>;
+		Reference a;
+		for (unsigned i = 0; i < Reference::nrBlocks; ++i) {
+			std::uint64_t r = engine();
+			std::uint32_t limb = ((r & 0x3) == 0 ? 0u : ((r & 0x3) == 1 ? 0xFFFF'FFFFu : static_cast<std::uint32_t>(r >> 32)));
+			a.setblock(i, (i == Reference::MSU ? limb & Reference::MSU_MASK : limb));
+		}
+		return a;
+	}
+
+	template<unsigned nbits, BinaryNumberType NumberType>
+	void ReportLimbError(const std::string& op, const blockbinary<nbits, std::uint64_t, NumberType>& a, const blockbinary<nbits, std::uint64_t, NumberType>& b, const blockbinary<nbits, std::uint64_t, NumberType>& result, const blockbinary<nbits, std::uint32_t, NumberType>& ref) {
+		std::cerr << "FAIL " << to_hex(a) << ' ' << op << ' ' << to_hex(b) << " = " << to_hex(result) << " reference " << to_hex(ref) << '\n';
+	}
+
+	template<unsigned nbits, BinaryNumberType NumberType>
+	int VerifyLimbArithmetic(bool reportTestCases, unsigned nrRandoms) {
+		using Reference   = blockbinary<nbits, std::uint32_t, NumberType>;
+		using BlockBinary = blockbinary<nbits, std::uint64_t, NumberType>;
+		std::mt19937_64 engine(nbits);
+		int nrOfFailedTests = 0;
+		for (unsigned n = 0; n < nrRandoms; ++n) {
+			Reference ra = RandomLimbs<nbits, NumberType>(engine), rb = RandomLimbs<nbits, NumberType>(engine);
+			BlockBinary a, b;
+			CopyLimbs(ra, a);
+			CopyLimbs(rb, b);
+
+			if (!SameLimbs(Reference(ra + rb), BlockBinary(a + b))) { ++nrOfFailedTests; if (reportTestCases) ReportLimbError("+", a, b, BlockBinary(a + b), Reference(ra + rb)); }
+			if (!SameLimbs(Reference(ra - rb), BlockBinary(a - b))) { ++nrOfFailedTests; if (reportTestCases) ReportLimbError("-", a, b, BlockBinary(a - b), Reference(ra - rb)); }
+			if (!SameLimbs(Reference(ra * rb), BlockBinary(a * b))) { ++nrOfFailedTests; if (reportTestCases) ReportLimbError("*", a, b, BlockBinary(a * b), Reference(ra * rb)); }
+			if (!rb.iszero()) {
+				if (!SameLimbs(Reference(ra / rb), BlockBinary(a / b))) { ++nrOfFailedTests; if (reportTestCases) ReportLimbError("/", a, b, BlockBinary(a / b), Reference(ra / rb)); }
+				if (!SameLimbs(Reference(ra % rb), BlockBinary(a % b))) { ++nrOfFailedTests; if (reportTestCases) ReportLimbError("%", a, b, BlockBinary(a % b), Reference(ra % rb)); }
+			}
+			long shift = static_cast<long>(engine() % nbits);
+			if (!SameLimbs(Reference(ra << shift), BlockBinary(a << shift))) { ++nrOfFailedTests; if (reportTestCases) ReportLimbError("<<", a, b, BlockBinary(a << shift), Reference(ra << shift)); }
+			if (!SameLimbs(Reference(ra >> shift), BlockBinary(a >> shift))) { ++nrOfFailedTests; if (reportTestCases) ReportLimbError(">>", a, b, BlockBinary(a >> shift), Reference(ra >> shift)); }
+			if ((ra < rb) != (a < b)) { ++nrOfFailedTests; if (reportTestCases) ReportLimbError("<", a, b, a, ra); }
+			if (nrOfFailedTests > 25) break;
+		}
+		return nrOfFailedTests;
+	}
+
+}} // namespace sw::universal
+
+// conditional compile flags
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite = "blockbinary arithmetic on uint64_t limbs";
+	std::string test_tag = "uint64_t limbs";
+	std::cout << test_suite << '\n';
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+#if MANUAL_TESTING
+
+	blockbinary<128, std::uint64_t> a, b;
+	a.setblock(0, 0xFFFF'FFFF'FFFF'FFFFull);
+	b.setbits(0x1);
+	std::cout << to_hex(a) << " + " << to_hex(b) << " = " << to_hex(a + b) << '\n';
+	std::cout << to_hex(a) << " * " << to_hex(a) << " = " << to_hex(a * a) << '\n';
+
+	nrOfFailedTestCases += ReportTestResult(VerifyLimbArithmetic<128, BinaryNumberType::Signed>(true, 100), "blockbinary<128,uint64>", test_tag);
+
+	nrOfFailedTestCases = 0;
+
+#if STRESS_TESTING
+
+#endif
+
+#else
+
+	nrOfFailedTestCases += ReportTestResult(VerifyLimbArithmetic< 64, BinaryNumberType::Signed>(bReportIndividualTestCases, 1000), "blockbinary< 64,uint64>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyLimbArithmetic< 80, BinaryNumberType::Signed>(bReportIndividualTestCases, 1000), "blockbinary< 80,uint64>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyLimbArithmetic<128, BinaryNumberType::Signed>(bReportIndividualTestCases, 1000), "blockbinary<128,uint64>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyLimbArithmetic<200, BinaryNumberType::Signed>(bReportIndividualTestCases, 1000), "blockbinary<200,uint64>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyLimbArithmetic<256, BinaryNumberType::Signed>(bReportIndividualTestCases, 1000), "blockbinary<256,uint64>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyLimbArithmetic<512, BinaryNumberType::Signed>(bReportIndividualTestCases, 1000), "blockbinary<512,uint64>", test_tag);
+
+#if STRESS_TESTING
+
+	nrOfFailedTestCases += ReportTestResult(VerifyLimbArithmetic<1024, BinaryNumberType::Signed>(bReportIndividualTestCases, 10000), "blockbinary<1024,uint64>", test_tag);
+
+#endif  // STRESS_TESTING
+
+#endif  // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -206,6 +206,7 @@ try {
 	nrOfFailedTestCases += ReportTestResult(VerifyMultiplication<12, uint8_t>(bReportIndividualTestCases), "blockbinary<12,uint8>", test_tag);
 	nrOfFailedTestCases += ReportTestResult(VerifyMultiplication<12, uint16_t>(bReportIndividualTestCases), "blockbinary<12,uint16>", test_tag);
 	nrOfFailedTestCases += ReportTestResult(VerifyMultiplication<12, uint32_t>(bReportIndividualTestCases), "blockbinary<12,uint32>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyMultiplication<12, uint64_t>(bReportIndividualTestCases), "blockbinary<12,uint64>", test_tag);
 
 
 
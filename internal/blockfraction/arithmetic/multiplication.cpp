@@ -114,6 +114,7 @@ try {
 	nrOfFailedTestCases += ReportTestResult(VerifyBlockFractionMultiplication< blockfraction<14, uint8_t> >(reportTestCases),  "blockfraction<12, uint8 >", "multiplication");
 	nrOfFailedTestCases += ReportTestResult(VerifyBlockFractionMultiplication< blockfraction<14, uint16_t> >(reportTestCases), "blockfraction<12, uint16>", "multiplication");
 	nrOfFailedTestCases += ReportTestResult(VerifyBlockFractionMultiplication< blockfraction<14, uint32_t> >(reportTestCases), "blockfraction<12, uint32>", "multiplication");
+	nrOfFailedTestCases += ReportTestResult(VerifyBlockFractionMultiplication< blockfraction<14, uint64_t> >(reportTestCases), "blockfraction<12, uint64>", "multiplication");
 #endif
 
 	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
@@ -130,6 +130,7 @@ try {
 	nrOfFailedTestCases += ReportTestResult(VerifyBlockSignificantAddition< blocksignificant<12, uint8_t> >(reportTestCases),  "blocksignificant<12, uint8_t >", "addition");
 	nrOfFailedTestCases += ReportTestResult(VerifyBlockSignificantAddition< blocksignificant<12, uint16_t> >(reportTestCases), "blocksignificant<12, uint16_t>", "addition");
 	nrOfFailedTestCases += ReportTestResult(VerifyBlockSignificantAddition< blocksignificant<12, uint32_t> >(reportTestCases), "blocksignificant<12, uint32_t>", "addition");
+	nrOfFailedTestCases += ReportTestResult(VerifyBlockSignificantAddition< blocksignificant<12, uint64_t> >(reportTestCases), "blocksignificant<12, uint64_t>", "addition");
 #endif
 
 	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
@@ -0,0 +1,239 @@
+// dragon.cpp: test suite runner for the shortest round-trip and fixed precision decimal conversion of cfloat, posit, and fixpnt
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/posit/posit.hpp>
+#include <universal/number/fixpnt/fixpnt.hpp>
+#include <universal/verification/test_suite.hpp>
+
+namespace sw { namespace universal {
+
+	template<typename Number>
+	std::string ShortestString(const Number& v) {
+		char buffer[128];
+		std::to_chars_result r = to_chars(buffer, buffer + sizeof(buffer), v);
+		return std::string(buffer, r.ec == std::errc{} ? r.ptr : buffer);
+	}
+
+	// the shortest decimal must read back to the same encoding
+	template<typename Number>
+	int VerifyRoundTrip(const Number& v, bool reportTestCases) {
+		std::string shortest = ShortestString(v);
+		Number back(std::strtod(shortest.c_str(), nullptr));
+		if (back == v) return 0;
+		if (reportTestCases) std::cerr << "FAIL: " << type_tag(v) << ' ' << to_binary(v) << " : " << shortest << " reads back as " << to_binary(back) << '\n';
+		return 1;
+	}
+
+	// the encodings of an nbits number system, exhaustively for small systems, randomly sampled otherwise
+	template<typename Number, typename Test>
+	int EnumerateEncodings(Test test, unsigned nrSamples = 0x1'0000) {
+		constexpr unsigned nbits = Number::nbits;
+		int nrOfFailedTestCases = 0;
+		Number v{};
+		if constexpr (nbits <= 16) {
+			for (unsigned i = 0; i < (1u << nbits); ++i) {
+				v.setbits(i);
+				nrOfFailedTestCases += test(v);
+			}
+		}
+		else {
+			std::mt19937_64 engine(nbits);
+			for (unsigned i = 0; i < nrSamples; ++i) {
+				v.setbits(engine());
+				nrOfFailedTestCases += test(v);
+			}
+		}
+		return nrOfFailedTestCases;
+	}
+
+	// cfloats that embed in double print with precision digits exactly as printf does
+	template<typename Cfloat>
+	int VerifyPrintfEquivalence(const Cfloat& v, bool reportTestCases) {
+		if (v.isnan() || v.isinf()) return 0;
+		int nrOfFailedTestCases = 0;
+		double d = double(v);
+		char reference[512];
+		for (int precision : { 0, 1, 3, 6, 10, 17, 25 }) {
+			std::snprintf(reference, sizeof(reference), "%.*g", precision, d);
+			if (to_string(v, precision) != reference) ++nrOfFailedTestCases;
+			std::snprintf(reference, sizeof(reference), "%.*e", precision, d);
+			char buffer[512];
+			std::to_chars_result r = to_chars(buffer, buffer + sizeof(buffer), v, std::chars_format::scientific, precision);
+			if (std::string(buffer, r.ptr) != reference) ++nrOfFailedTestCases;
+			std::snprintf(reference, sizeof(reference), "%.*f", precision, d);
+			r = to_chars(buffer, buffer + sizeof(buffer), v, std::chars_format::fixed, precision);
+			if (std::string(buffer, r.ptr) != reference) ++nrOfFailedTestCases;
+		}
+		if (nrOfFailedTestCases > 0 && reportTestCases) std::cerr << "FAIL: " << to_binary(v) << " : " << to_string(v, 17) << " != " << d << '\n';
+		return nrOfFailedTestCases;
+	}
+
+	// for IEEE-754 configurations the shortest digits match the native shortest representation
+	template<typename Cfloat, typename Native>
+	int VerifyNativeShortest(const Cfloat& v, bool reportTestCases) {
+		if (v.isnan() || v.isinf()) return 0;
+		Native native = Native(v);
+		char buffer[64];
+		std::to_chars_result r = std::to_chars(buffer, buffer + sizeof(buffer), native, std::chars_format::scientific);
+		std::string reference(buffer, r.ptr);
+		r = to_chars(buffer, buffer + sizeof(buffer), v, std::chars_format::scientific);
+		std::string shortest(buffer, r.ptr);
+		if (shortest == reference) return 0;
+		if (reportTestCases) std::cerr << "FAIL: " << to_binary(v) << " : " << shortest << " != " << reference << '\n';
+		return 1;
+	}
+
+	// spot checks of the shortest representation
+	int VerifySpotChecks() {
+		using fp16 = cfloat<16, 5, uint16_t, true, false, false>;
+		using fp32 = cfloat<32, 8, uint32_t, true, false, false>;
+		int nrOfFailedTestCases = 0;
+		fp16 a(0.1);
+		if (ShortestString(a) != "0.1") ++nrOfFailedTestCases;
+		a = 65504.0;
+		if (ShortestString(a) != "65500") ++nrOfFailedTestCases;
+		a.setnan(NAN_TYPE_QUIET);
+		if (ShortestString(a) != "nan") ++nrOfFailedTestCases;
+		a = -0.0;
+		if (ShortestString(-a) != "0" || ShortestString(a) != "-0") ++nrOfFailedTestCases;
+		fp32 b(1.0e-30f);
+		if (ShortestString(b) != "1e-30") ++nrOfFailedTestCases;
+		posit<16, 1> p(0.1);
+		if (ShortestString(p) != "0.1") ++nrOfFailedTestCases;
+		p.setnar();
+		if (ShortestString(p) != "nar") ++nrOfFailedTestCases;
+		fixpnt<16, 8, Modulo, uint16_t> f(-1.25);
+		if (ShortestString(f) != "-1.25" || convert_to_decimal_string(f) != "-1.25000000") ++nrOfFailedTestCases;
+		f.setbits(0x8000);  // maxneg
+		if (convert_to_decimal_string(f) != "-128.00000000") ++nrOfFailedTestCases;
+		return nrOfFailedTestCases;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "dragon decimal conversion";
+	std::string test_tag    = "to_chars";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+	using fp16 = cfloat<16, 5, uint16_t, true, false, false>;
+	using fp32 = cfloat<32, 8, uint32_t, true, false, false>;
+	using fp64 = cfloat<64, 11, uint32_t, true, false, false>;
+
+#if MANUAL_TESTING
+
+	fp16 a(0.1);
+	std::cout << ShortestString(a) << " : " << a << " : " << to_string(a, 17) << '\n';
+	posit<32, 2> p(1.0 / 3.0);
+	std::cout << ShortestString(p) << " : " << p << " : " << to_string(p, 30) << '\n';
+	cfloat<128, 15, uint32_t, true, false, false> q(SpecificValue::minpos);
+	std::cout << ShortestString(q) << " : " << to_string(q, 40) << '\n';
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS;   // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	{
+		nrOfFailedTestCases += ReportTestResult(VerifySpotChecks(), "spot checks", test_tag);
+
+		// the buffer is never overrun
+		char buffer[4];
+		std::to_chars_result r = to_chars(buffer, buffer + sizeof(buffer), fp32(1.0e-30f));
+		if (r.ec != std::errc::value_too_large) ++nrOfFailedTestCases;
+		r = to_chars(buffer, buffer + sizeof(buffer), fp32(2.5f));
+		if (r.ec != std::errc{} || std::string(buffer, r.ptr) != "2.5") ++nrOfFailedTestCases;
+
+		nrOfFailedTestCases += ReportTestResult(EnumerateEncodings<fp16>([&](const fp16& v) { return v.isnan() || v.isinf() ? 0 : VerifyRoundTrip(v, reportTestCases); }), "fp16", "round trip");
+		nrOfFailedTestCases += ReportTestResult(EnumerateEncodings<fp16>([&](const fp16& v) { return VerifyPrintfEquivalence(v, reportTestCases); }), "fp16", "printf");
+		nrOfFailedTestCases += ReportTestResult(EnumerateEncodings<posit<16, 1>>([&](const posit<16, 1>& v) { return v.isnar() ? 0 : VerifyRoundTrip(v, reportTestCases); }), "posit<16,1>", "round trip");
+		nrOfFailedTestCases += ReportTestResult(EnumerateEncodings<posit<12, 2>>([&](const posit<12, 2>& v) { return v.isnar() ? 0 : VerifyRoundTrip(v, reportTestCases); }), "posit<12,2>", "round trip");
+		using Fixed = fixpnt<16, 8, Modulo, uint16_t>;
+		nrOfFailedTestCases += ReportTestResult(EnumerateEncodings<Fixed>([&](const Fixed& v) { return VerifyRoundTrip(v, reportTestCases); }), "fixpnt<16,8>", "round trip");
+	}
+#endif
+
+#if REGRESSION_LEVEL_2
+	{
+		nrOfFailedTestCases += ReportTestResult(EnumerateEncodings<fp32>([&](const fp32& v) { return v.isnan() || v.isinf() ? 0 : VerifyRoundTrip(v, reportTestCases); }), "fp32", "round trip");
+		nrOfFailedTestCases += ReportTestResult(EnumerateEncodings<fp32>([&](const fp32& v) { return VerifyNativeShortest<fp32, float>(v, reportTestCases); }), "fp32", "native shortest");
+		nrOfFailedTestCases += ReportTestResult(EnumerateEncodings<fp32>([&](const fp32& v) { return VerifyPrintfEquivalence(v, reportTestCases); }, 0x1000), "fp32", "printf");
+		nrOfFailedTestCases += ReportTestResult(EnumerateEncodings<posit<32, 2>>([&](const posit<32, 2>& v) { return v.isnar() ? 0 : VerifyRoundTrip(v, reportTestCases); }), "posit<32,2>", "round trip");
+		using Fixed = fixpnt<32, 16, Modulo, uint32_t>;
+		nrOfFailedTestCases += ReportTestResult(EnumerateEncodings<Fixed>([&](const Fixed& v) { return VerifyRoundTrip(v, reportTestCases); }), "fixpnt<32,16>", "round trip");
+	}
+#endif
+
+#if REGRESSION_LEVEL_3
+	{
+		nrOfFailedTestCases += ReportTestResult(EnumerateEncodings<fp64>([&](const fp64& v) { return VerifyNativeShortest<fp64, double>(v, reportTestCases); }), "fp64", "native shortest");
+		nrOfFailedTestCases += ReportTestResult(EnumerateEncodings<fp64>([&](const fp64& v) { return VerifyPrintfEquivalence(v, reportTestCases); }, 0x1000), "fp64", "printf");
+	}
+#endif
+
+#if REGRESSION_LEVEL_4
+	{
+		// extreme scales of wide formats are generated exactly
+		int nrOfFailedExtremes = 0;
+		cfloat<128, 15, uint32_t, true, false, false> q(SpecificValue::minpos);
+		if (ShortestString(q) != "6e-4966") ++nrOfFailedExtremes;
+		posit<256, 5> p(SpecificValue::maxpos);
+		if (to_string(p, 5) != "5.913e+2446") ++nrOfFailedExtremes;
+		nrOfFailedTestCases += ReportTestResult(nrOfFailedExtremes, "extreme scales", test_tag);
+	}
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught ad-hoc exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Caught unexpected universal arithmetic exception : " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Caught unexpected universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Caught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,316 @@
+// parse.cpp: test suite runner for the correctly rounded decimal parser of cfloat, posit, and fixpnt
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/posit/posit.hpp>
+#include <universal/number/fixpnt/fixpnt.hpp>
+#include <universal/verification/test_suite.hpp>
+
+namespace sw { namespace universal {
+
+	template<typename Number>
+	Number ParseString(const std::string& number) {
+		Number v{};
+		from_chars(number.data(), number.data() + number.size(), v);
+		return v;
+	}
+
+	template<typename Number>
+	bool SameEncoding(const Number& a, const Number& b) {
+		return to_binary(a) == to_binary(b);
+	}
+
+	// the shortest decimal of an encoding must parse back to the same encoding
+	template<typename Number>
+	int VerifyRoundTrip(const Number& v, bool reportTestCases) {
+		char buffer[128];
+		std::to_chars_result r = to_chars(buffer, buffer + sizeof(buffer), v);
+		std::string shortest(buffer, r.ptr);
+		Number back = ParseString<Number>(shortest);
+		if (SameEncoding(back, v)) return 0;
+		if (reportTestCases) std::cerr << "FAIL: " << type_tag(v) << ' ' << to_binary(v) << " : " << shortest << " parses as " << to_binary(back) << '\n';
+		return 1;
+	}
+
+	// the exact decimal of a double must round as the double does: for small formats
+	// the midpoints between encodings and their neighbors in double are the hard cases
+	template<typename Number>
+	int VerifyMidpoints(const Number& v, bool reportTestCases) {
+		Number next(v);
+		++next;
+		double a = double(v), b = double(next);
+		if (!std::isfinite(a) || !std::isfinite(b) || !(a < b)) return 0;
+		int nrOfFailedTestCases = 0;
+		double mid = a + (b - a) / 2.0;
+		for (double d : { mid, std::nextafter(mid, a), std::nextafter(mid, b), -mid }) {
+			char exact[1024];
+			std::snprintf(exact, sizeof(exact), "%.800g", d);
+			Number parsed = ParseString<Number>(exact);
+			Number reference(d);
+			if (!SameEncoding(parsed, reference)) {
+				if (reportTestCases) std::cerr << "FAIL: " << type_tag(v) << ' ' << exact << " parses as " << to_binary(parsed) << " instead of " << to_binary(reference) << '\n';
+				++nrOfFailedTestCases;
+			}
+		}
+		return nrOfFailedTestCases;
+	}
+
+	// the encodings of an nbits number system, exhaustively for small systems, randomly sampled otherwise
+	template<typename Number, typename Test>
+	int EnumerateEncodings(Test test, unsigned nrSamples = 0x1'0000) {
+		constexpr unsigned nbits = Number::nbits;
+		int nrOfFailedTestCases = 0;
+		Number v{};
+		if constexpr (nbits <= 16) {
+			for (unsigned i = 0; i < (1u << nbits); ++i) {
+				v.setbits(i);
+				nrOfFailedTestCases += test(v);
+			}
+		}
+		else {
+			std::mt19937_64 engine(nbits);
+			for (unsigned i = 0; i < nrSamples; ++i) {
+				v.setbits(engine());
+				nrOfFailedTestCases += test(v);
+			}
+		}
+		return nrOfFailedTestCases;
+	}
+
+	// random decimal strings with many digits and a wide exponent range
+	inline std::string RandomDecimal(std::mt19937_64& engine, int minExponent, int maxExponent) {
+		std::uniform_int_distribution<int> nrDigits(1, 40), digit(0, 9), exponent(minExponent, maxExponent);
+		std::string number;
+		if (engine() & 1u) number += '-';
+		int n = nrDigits(engine);
+		int point = std::uniform_int_distribution<int>(0, n)(engine);
+		for (int i = 0; i < n; ++i) {
+			if (i == point) number += '.';
+			number += static_cast<char>('0' + digit(engine));
+		}
+		number += 'e';
+		number += std::to_string(exponent(engine));
+		return number;
+	}
+
+	// IEEE-754 configurations must parse exactly as the native parsers do
+	template<typename Cfloat, typename Native>
+	int VerifyNativeParse(unsigned nrSamples, int minExponent, int maxExponent, bool reportTestCases) {
+		std::mt19937_64 engine(sizeof(Native));
+		int nrOfFailedTestCases = 0;
+		for (unsigned i = 0; i < nrSamples; ++i) {
+			std::string number = RandomDecimal(engine, minExponent, maxExponent);
+			Native native{};
+			if constexpr (std::is_same_v<Native, double>) {
+				native = std::strtod(number.c_str(), nullptr);
+			}
+			else {
+				native = std::strtof(number.c_str(), nullptr);
+			}
+			Cfloat parsed = ParseString<Cfloat>(number);
+			Cfloat reference(native);
+			if (!SameEncoding(parsed, reference)) {
+				if (reportTestCases) std::cerr << "FAIL: " << number << " parses as " << to_binary(parsed) << " instead of " << to_binary(reference) << '\n';
+				++nrOfFailedTestCases;
+			}
+		}
+		return nrOfFailedTestCases;
+	}
+
+	// spot checks of the parser interface
+	int VerifySpotChecks() {
+		using fp16 = cfloat<16, 5, uint16_t, true, false, false>;
+		using fp32 = cfloat<32, 8, uint32_t, true, false, false>;
+		using Fixed = fixpnt<16, 8, Modulo, uint16_t>;
+		using SaturatingFixed = fixpnt<16, 8, Saturate, uint16_t>;
+		int nrOfFailedTestCases = 0;
+
+		fp16 a;
+		std::string text = "0.1xyz";
+		std::from_chars_result r = from_chars(text.data(), text.data() + text.size(), a);
+		if (r.ec != std::errc{} || r.ptr != text.data() + 3 || a != fp16(0.1)) ++nrOfFailedTestCases;
+		text = "abc";
+		a = 1.0f;
+		r = from_chars(text.data(), text.data() + text.size(), a);
+		if (r.ec != std::errc::invalid_argument || r.ptr != text.data() || a != fp16(1.0f)) ++nrOfFailedTestCases;
+		if (!parse("-Infinity", a) || !a.isinf() || !a.isneg()) ++nrOfFailedTestCases;
+		if (!parse("nan", a) || !a.isnan()) ++nrOfFailedTestCases;
+		if (!parse("-0.0", a) || !a.iszero() || !a.isneg()) ++nrOfFailedTestCases;
+		if (!parse("1e5", a) || !a.isinf()) ++nrOfFailedTestCases;
+		if (!parse("65519.99", a) || a != fp16(65504.0f)) ++nrOfFailedTestCases;
+		if (parse("1.5 ", a)) ++nrOfFailedTestCases;
+		fp32 b;
+		if (!parse("1.00000005960464477539062500000000000000000000000000001", b) || b != fp32(1.00000012f)) ++nrOfFailedTestCases;
+		if (!parse("1.000000059604644775390625", b) || b != fp32(1.0f)) ++nrOfFailedTestCases;
+
+		posit<16, 1> p;
+		if (!parse("nar", p) || !p.isnar()) ++nrOfFailedTestCases;
+		if (!parse("1e-300", p) || p != posit<16, 1>(SpecificValue::minpos)) ++nrOfFailedTestCases;
+		if (!parse("-1e300", p) || p != posit<16, 1>(SpecificValue::maxneg)) ++nrOfFailedTestCases;
+		if (!parse("16.1x4000p", p) || p != posit<16, 1>(1.0)) ++nrOfFailedTestCases;
+		if (!parse("32.2x40000000p", p) || p != posit<16, 1>(1.0)) ++nrOfFailedTestCases;
+
+		Fixed f;
+		if (!parse("-1.25", f) || f != Fixed(-1.25)) ++nrOfFailedTestCases;
+		if (!parse("-128", f) || f.bits() != Fixed(SpecificValue::maxneg).bits()) ++nrOfFailedTestCases;
+		if (!parse("0.001953125", f) || !f.iszero()) ++nrOfFailedTestCases;        // tie rounds to even zero
+		if (!parse("0.0019531250001", f) || f != Fixed(SpecificValue::minpos)) ++nrOfFailedTestCases;
+		if (!parse("128", f) || f.bits() != Fixed(SpecificValue::maxneg).bits()) ++nrOfFailedTestCases; // wraps around
+		if (parse("inf", f)) ++nrOfFailedTestCases;
+		f.assign("3.14159");
+		if (f != Fixed(3.14159)) ++nrOfFailedTestCases;
+		SaturatingFixed s;
+		if (!parse("1000", s) || s != SaturatingFixed(SpecificValue::maxpos)) ++nrOfFailedTestCases;
+		if (!parse("-128.001", s) || s != SaturatingFixed(SpecificValue::maxneg)) ++nrOfFailedTestCases;
+
+		// bulk parsing stops at the first token that is not a number
+		text = "1, 2.5;3e0 \n -4 x 5";
+		fp32 values[8];
+		const char* end{ nullptr };
+		size_t n = parse_array(text.data(), text.data() + text.size(), values, 8, &end);
+		if (n != 4 || values[1] != fp32(2.5f) || values[3] != fp32(-4.0f) || *end != 'x') ++nrOfFailedTestCases;
+		std::vector<posit<32, 2>> positValues;
+		if (parse_array("0.5 0.25 1e-10", positValues) != 3 || positValues[2] != posit<32, 2>(1.0e-10)) ++nrOfFailedTestCases;
+		std::vector<double> doubles;
+		if (parse_array(" 0.1 0.2 ", doubles) != 2 || doubles[1] != 0.2) ++nrOfFailedTestCases;
+
+		std::istringstream istr("2.75 0.375");
+		fp32 c;
+		Fixed g;
+		istr >> c >> g;
+		if (!istr || c != fp32(2.75f) || g != Fixed(0.375)) ++nrOfFailedTestCases;
+		return nrOfFailedTestCases;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "decimal parser";
+	std::string test_tag    = "from_chars";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+	using fp16 = cfloat<16, 5, uint16_t, true, false, false>;
+	using fp32 = cfloat<32, 8, uint32_t, true, false, false>;
+	using fp64 = cfloat<64, 11, uint32_t, true, false, false>;
+
+#if MANUAL_TESTING
+
+	fp16 a = ParseString<fp16>("0.1");
+	std::cout << to_binary(a) << " : " << a << '\n';
+	posit<32, 2> p = ParseString<posit<32, 2>>("0.333333333333333333333333333333");
+	std::cout << to_binary(p) << " : " << p << '\n';
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS;   // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	{
+		nrOfFailedTestCases += ReportTestResult(VerifySpotChecks(), "spot checks", test_tag);
+
+		nrOfFailedTestCases += ReportTestResult(EnumerateEncodings<fp16>([&](const fp16& v) { return v.isnan() ? 0 : VerifyRoundTrip(v, reportTestCases); }), "fp16", "round trip");
+		nrOfFailedTestCases += ReportTestResult(EnumerateEncodings<fp16>([&](const fp16& v) { return VerifyMidpoints(v, reportTestCases); }), "fp16", "midpoints");
+		nrOfFailedTestCases += ReportTestResult(EnumerateEncodings<posit<16, 1>>([&](const posit<16, 1>& v) { return VerifyRoundTrip(v, reportTestCases); }), "posit<16,1>", "round trip");
+		nrOfFailedTestCases += ReportTestResult(EnumerateEncodings<posit<12, 2>>([&](const posit<12, 2>& v) { return VerifyMidpoints(v, reportTestCases); }), "posit<12,2>", "midpoints");
+		using Fixed = fixpnt<16, 8, Modulo, uint16_t>;
+		nrOfFailedTestCases += ReportTestResult(EnumerateEncodings<Fixed>([&](const Fixed& v) { return VerifyRoundTrip(v, reportTestCases); }), "fixpnt<16,8>", "round trip");
+		nrOfFailedTestCases += ReportTestResult(EnumerateEncodings<Fixed>([&](const Fixed& v) { return VerifyMidpoints(v, reportTestCases); }), "fixpnt<16,8>", "midpoints");
+	}
+#endif
+
+#if REGRESSION_LEVEL_2
+	{
+		nrOfFailedTestCases += ReportTestResult(EnumerateEncodings<fp32>([&](const fp32& v) { return v.isnan() ? 0 : VerifyRoundTrip(v, reportTestCases); }), "fp32", "round trip");
+		nrOfFailedTestCases += ReportTestResult(EnumerateEncodings<fp32>([&](const fp32& v) { return VerifyMidpoints(v, reportTestCases); }), "fp32", "midpoints");
+		nrOfFailedTestCases += ReportTestResult(VerifyNativeParse<fp32, float>(0x4000, -50, 40, reportTestCases), "fp32", "native parse");
+		nrOfFailedTestCases += ReportTestResult(EnumerateEncodings<posit<32, 2>>([&](const posit<32, 2>& v) { return VerifyRoundTrip(v, reportTestCases); }), "posit<32,2>", "round trip");
+		using Fixed = fixpnt<32, 16, Modulo, uint32_t>;
+		nrOfFailedTestCases += ReportTestResult(EnumerateEncodings<Fixed>([&](const Fixed& v) { return VerifyMidpoints(v, reportTestCases); }), "fixpnt<32,16>", "midpoints");
+	}
+#endif
+
+#if REGRESSION_LEVEL_3
+	{
+		nrOfFailedTestCases += ReportTestResult(EnumerateEncodings<fp64>([&](const fp64& v) { return v.isnan() ? 0 : VerifyRoundTrip(v, reportTestCases); }), "fp64", "round trip");
+		nrOfFailedTestCases += ReportTestResult(VerifyNativeParse<fp64, double>(0x4000, -340, 310, reportTestCases), "fp64", "native parse");
+		nrOfFailedTestCases += ReportTestResult(EnumerateEncodings<posit<64, 3>>([&](const posit<64, 3>& v) { return VerifyRoundTrip(v, reportTestCases); }, 0x1000), "posit<64,3>", "round trip");
+		using Fixed = fixpnt<80, 40, Modulo, uint32_t>;
+		nrOfFailedTestCases += ReportTestResult(EnumerateEncodings<Fixed>([&](const Fixed& v) { return VerifyRoundTrip(v, reportTestCases); }, 0x1000), "fixpnt<80,40>", "round trip");
+	}
+#endif
+
+#if REGRESSION_LEVEL_4
+	{
+		// extreme scales of wide formats take the exact path
+		using quad = cfloat<128, 15, uint32_t, true, false, false>;
+		nrOfFailedTestCases += ReportTestResult(EnumerateEncodings<quad>([&](const quad& v) { return v.isnan() ? 0 : VerifyRoundTrip(v, reportTestCases); }, 0x400), "cfloat<128,15>", "round trip");
+		nrOfFailedTestCases += ReportTestResult(EnumerateEncodings<posit<256, 5>>([&](const posit<256, 5>& v) { return VerifyRoundTrip(v, reportTestCases); }, 0x100), "posit<256,5>", "round trip");
+		int nrOfFailedExtremes = 0;
+		std::mt19937_64 engine(128);
+		for (unsigned i = 0; i < 0x400; ++i) {
+			quad v;
+			for (unsigned b = 0; b < quad::nbits; ++b) v.setbit(b, engine() & 1u);
+			if (!v.isnan()) nrOfFailedExtremes += VerifyRoundTrip(v, reportTestCases);
+		}
+		if (ParseString<quad>("6e-4966") != quad(SpecificValue::minpos)) ++nrOfFailedExtremes;
+		if (ParseString<quad>("3e-4966").iszero() == false) ++nrOfFailedExtremes;
+		posit<256, 5> p(SpecificValue::maxpos);
+		if (ParseString<posit<256, 5>>("1e3000") != p) ++nrOfFailedExtremes;
+		nrOfFailedTestCases += ReportTestResult(nrOfFailedExtremes, "extreme scales", test_tag);
+	}
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught ad-hoc exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Caught unexpected universal arithmetic exception : " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Caught unexpected universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Caught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,160 @@
+// condest.cpp: test suite for the Hager-Higham 1-norm condition estimator
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <cmath>
+#include <random>
+#include <string>
+#include <universal/number/posit/posit.hpp>
+#include <universal/blas/blas.hpp>
+#include <universal/blas/generators.hpp>
+#include <universal/verification/test_suite.hpp>
+
+namespace sw { namespace universal {
+
+	// ||A^{-1}||_1 computed column by column from the factorization, in double precision
+	double ExactInverseNorm1(const blas::matrix<double>& A) {
+		size_t n = num_rows(A);
+		blas::matrix<double> LU(A);
+		blas::vector<size_t> P(n);
+		blas::plu(LU, P);
+		double norm{ 0 };
+		blas::vector<double> x(n);
+		for (size_t j = 0; j < n; ++j) {
+			for (size_t i = 0; i < n; ++i) x(i) = (i == j ? 1.0 : 0.0);
+			blas::condest_internal::solve(LU, P, x);
+			double s{ 0 };
+			for (size_t i = 0; i < n; ++i) s += std::fabs(x(i));
+			norm = std::max(norm, s);
+		}
+		return norm;
+	}
+
+	// the estimate is a lower bound of kappa_1 and, for these matrices, within a small factor of it
+	template<typename Scalar>
+	int VerifyCondest(bool reportTestCases, const std::string& name, const blas::matrix<double>& Aref, double slack = 1.0e-6) {
+		double exact = matnorm(Aref, 1) * ExactInverseNorm1(Aref);
+		blas::matrix<Scalar> A(Aref);
+		double estimate = double(condest(A));
+		int nrOfFailedTestCases = 0;
+		if (!(estimate <= exact * (1.0 + slack) && estimate >= exact / 3.0)) {
+			++nrOfFailedTestCases;
+			if (reportTestCases) std::cerr << "FAIL: " << name << " estimate " << estimate << " exact " << exact << '\n';
+		}
+		else if (reportTestCases) {
+			std::cout << name << " : estimate " << estimate << " exact " << exact << '\n';
+		}
+		return nrOfFailedTestCases;
+	}
+
+	// repeated estimates from one factorization reuse the workspace and agree
+	int VerifyFactorizationReuse(bool reportTestCases) {
+		blas::matrix<double> A = blas::frank<double>(13);
+		size_t n = num_rows(A);
+		blas::matrix<double> LU(A);
+		blas::vector<size_t> P(n);
+		blas::plu(LU, P);
+		blas::condest_workspace<double> work(n);
+		double anorm = matnorm(A, 1);
+		double first = blas::condest1(LU, P, anorm, work);
+		double second = blas::condest1(LU, P, anorm, work);
+		int nrOfFailedTestCases = 0;
+		if (first != second || first != condest(A)) {
+			++nrOfFailedTestCases;
+			if (reportTestCases) std::cerr << "FAIL: " << first << " " << second << " " << condest(A) << '\n';
+		}
+		return nrOfFailedTestCases;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "Hager-Higham condition estimator";
+	std::string test_tag    = "condest";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	nrOfFailedTestCases += ReportTestResult(VerifyCondest<double>(true, "hilbert(6)", blas::hilbert<double>(6)), "double", test_tag);
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyCondest<double>(reportTestCases, "minij(10)", blas::minij<double>(10)), "double minij(10)", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyCondest<double>(reportTestCases, "frank(11)", blas::frank<double>(11)), "double frank(11)", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyCondest<double>(reportTestCases, "hilbert(8)", blas::hilbert<double>(8)), "double hilbert(8)", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyFactorizationReuse(reportTestCases), "double frank(13)", "condest1 reuse");
+#endif
+
+#if REGRESSION_LEVEL_2
+	{
+		std::mt19937_64 engine(42);
+		std::uniform_real_distribution<double> dist(-1.0, 1.0);
+		for (size_t n : { 5, 20, 60 }) {
+			blas::matrix<double> A(n, n);
+			for (size_t i = 0; i < n; ++i) for (size_t j = 0; j < n; ++j) A(i, j) = dist(engine);
+			std::string name = "random(" + std::to_string(n) + ")";
+			nrOfFailedTestCases += ReportTestResult(VerifyCondest<double>(reportTestCases, name, A), "double " + name, test_tag);
+		}
+	}
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyCondest< posit<32, 2> >(reportTestCases, "minij(10)", blas::minij<double>(10), 1.0e-4), "posit<32,2> minij(10)", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyCondest< float >(reportTestCases, "frank(9)", blas::frank<double>(9), 1.0e-2), "float frank(9)", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_4
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught ad-hoc exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Caught unexpected universal arithmetic exception : " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Caught unexpected universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << '\n';
+	return EXIT_FAILURE;
+}
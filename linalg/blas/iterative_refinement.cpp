@@ -0,0 +1,179 @@
+// iterative_refinement.cpp: test suite for the LU-IR and GMRES-IR mixed-precision iterative refinement engine
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <cmath>
+#include <string>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/posit/posit.hpp>
+#include <universal/number/dd/dd.hpp>
+#include <universal/blas/blas.hpp>
+#include <universal/blas/ext/solvers/iterative_refinement.hpp>
+#include <universal/blas/matrices/lambers_ill.hpp>
+#include <universal/blas/matrices/rump6x6ill.hpp>
+#include <universal/blas/matrices/steam3.hpp>
+#include <universal/blas/matrices/west0132.hpp>
+#include <universal/verification/test_suite.hpp>
+
+namespace sw { namespace universal {
+
+	using bf16 = cfloat<16, 8, uint16_t, true, false, false>;
+
+	// b = A * ones, so the forward error is measured against a known solution
+	template<typename ResidualPrecision, typename WorkingPrecision, typename FactorizationPrecision>
+	blas::ir_report RefineToOnes(const blas::matrix<double>& Ad, blas::ir_solver solver, double& forwardError) {
+		blas::matrix<ResidualPrecision> A(num_rows(Ad), num_cols(Ad));
+		for (size_t i = 0; i < num_rows(Ad); ++i) for (size_t j = 0; j < num_cols(Ad); ++j) A(i, j) = ResidualPrecision(Ad(i, j));
+		size_t n = num_rows(A);
+		blas::vector<ResidualPrecision> b(n);
+		for (size_t i = 0; i < n; ++i) {
+			ResidualPrecision s(0);
+			for (size_t j = 0; j < n; ++j) s += A(i, j);
+			b(i) = s;
+		}
+		blas::ir_options options;
+		options.solver = solver;
+		options.maxIterations = 50;
+		blas::vector<WorkingPrecision> x;
+		blas::ir_report report = blas::solve_ir<FactorizationPrecision>(A, b, x, options);
+		forwardError = 0.0;
+		for (size_t i = 0; i < n; ++i) forwardError = std::max(forwardError, std::fabs(double(x(i)) - 1.0));
+		return report;
+	}
+
+	// GMRES-IR must converge to the forward error bound, with fewer high-precision residuals than LU-IR
+	template<typename ResidualPrecision, typename WorkingPrecision, typename FactorizationPrecision>
+	int VerifyGMRESIR(bool reportTestCases, const std::string& name, const blas::matrix<double>& A, double tolerance) {
+		double luError, gmresError;
+		auto lu = RefineToOnes<ResidualPrecision, WorkingPrecision, FactorizationPrecision>(A, blas::ir_solver::LU, luError);
+		auto gmres = RefineToOnes<ResidualPrecision, WorkingPrecision, FactorizationPrecision>(A, blas::ir_solver::GMRES, gmresError);
+		if (reportTestCases) {
+			std::cout << name << " LU-IR    : " << lu << ", forward error " << luError << '\n';
+			std::cout << name << " GMRES-IR : " << gmres << ", forward error " << gmresError << '\n';
+		}
+		int nrOfFailedTestCases = 0;
+		if (!gmres.converged || !(gmresError <= tolerance)) {
+			++nrOfFailedTestCases;
+			if (reportTestCases) std::cerr << "FAIL: GMRES-IR on " << name << " : " << gmres << ", forward error " << gmresError << '\n';
+		}
+		if (lu.converged && luError <= tolerance && !(gmres.highPrecisionOps < lu.highPrecisionOps)) {
+			++nrOfFailedTestCases;
+			if (reportTestCases) std::cerr << "FAIL: GMRES-IR on " << name << " used " << gmres.highPrecisionOps << " high-precision ops, LU-IR " << lu.highPrecisionOps << '\n';
+		}
+		return nrOfFailedTestCases;
+	}
+
+	// a workspace and a factorization serve a sequence of right-hand sides
+	int VerifyWorkspaceReuse(bool reportTestCases) {
+		using Matrix = blas::matrix<double>;
+		Matrix A(steam3);
+		size_t n = num_rows(A);
+		blas::dense_lu_factorization<float, double> M(A);
+		blas::ir_workspace<double, double> work(n, 20);
+		blas::ir_options options;
+		options.gmresMaxIterations = 20;
+		int nrOfFailedTestCases = 0;
+		for (int k = 1; k <= 3; ++k) {
+			blas::vector<double> xref(n), b(n), x(n);
+			for (size_t i = 0; i < n; ++i) xref(i) = double(k) + double(i % 7);
+			b = A * xref;
+			x = b;
+			M.solve(x);
+			auto report = blas::refine(A, A, M, b, x, work, options);
+			double error{ 0 }, scale{ 0 };
+			for (size_t i = 0; i < n; ++i) {
+				error = std::max(error, std::fabs(x(i) - xref(i)));
+				scale = std::max(scale, std::fabs(xref(i)));
+			}
+			if (!report.converged || work.size() != n || work.krylovDimension() != 20 || error > 1.0e-6 * scale) {
+				++nrOfFailedTestCases;
+				if (reportTestCases) std::cerr << "FAIL: right-hand side " << k << " : " << report << ", forward error " << error << '\n';
+			}
+		}
+		return nrOfFailedTestCases;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "mixed-precision iterative refinement";
+	std::string test_tag    = "GMRES-IR";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	nrOfFailedTestCases += ReportTestResult(VerifyGMRESIR<dd, double, bf16>(true, "west0132", west0132, 1.0e-12), "bf16/double/dd", test_tag);
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	// factorization / working / residual precision
+	nrOfFailedTestCases += ReportTestResult(VerifyGMRESIR<double, double, bf16>(reportTestCases, "lambers_ill", lambers_ill, 1.0e-6), "bf16/double/double lambers_ill", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyGMRESIR<dd, double, bf16>(reportTestCases, "steam3", steam3, 1.0e-12), "bf16/double/dd steam3", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyWorkspaceReuse(reportTestCases), "float/double/double steam3", "workspace reuse");
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyGMRESIR<dd, double, bf16>(reportTestCases, "west0132", west0132, 1.0e-12), "bf16/double/dd west0132", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyGMRESIR<dd, dd, double>(reportTestCases, "rump6x6ill", rump6x6ill, 1.0e-6), "double/dd/dd rump6x6ill", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_3
+	// posit residuals accumulate in the quire
+	nrOfFailedTestCases += ReportTestResult(VerifyGMRESIR<posit<64, 3>, posit<32, 2>, posit<16, 2>>(reportTestCases, "west0132", west0132, 1.0e-6), "posit16/posit32/posit64 west0132", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_4
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught ad-hoc exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Caught unexpected universal arithmetic exception : " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Caught unexpected universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << '\n';
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,190 @@
+// runge_kutta.cpp: test suite for the Butcher tableau driven Runge-Kutta integrators and the ensemble driver
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <cmath>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/posit/posit.hpp>
+#include <universal/number/dd/dd.hpp>
+#include <universal/blas/blas.hpp>
+#include <universal/blas/solvers/runge_kutta.hpp>
+#include <universal/verification/test_suite.hpp>
+
+namespace sw { namespace universal {
+
+	// y' = -5 y + sin(t), a stiff-ish scalar problem with a known solution
+	auto decay = [](const auto& t, const auto& y, auto& dydt) {
+		using std::sin;
+		dydt[0] = -5 * y[0] + sin(t);
+	};
+	double decaySolution(double t) {
+		return (std::exp(-5.0 * t) * (1.0 + 1.0 / 26.0) + (5.0 * std::sin(t) - std::cos(t)) / 26.0);
+	}
+
+	// the Lorenz system in its chaotic regime
+	auto lorenz = [](const auto& t, const auto& y, auto& dydt) {
+		using Scalar = std::remove_cv_t<std::remove_reference_t<decltype(t)>>;
+		Scalar sigma(10), rho(28), beta = Scalar(8) / Scalar(3);
+		dydt[0] = sigma * (y[1] - y[0]);
+		dydt[1] = y[0] * (rho - y[2]) - y[1];
+		dydt[2] = y[0] * y[1] - beta * y[2];
+	};
+
+	// halving the step divides the global error by 2^order
+	int VerifyOrder(bool reportTestCases, const blas::butcher_tableau& tableau) {
+		int nrOfFailedTestCases = 0;
+		double error[2];
+		for (int refinement = 0; refinement < 2; ++refinement) {
+			size_t steps = 40 << refinement;
+			double h = 1.0 / double(steps);
+			blas::explicit_runge_kutta<double> rk(tableau, 1);
+			blas::vector<double> y{ 1.0 };
+			rk.integrate(decay, 0.0, y, h, steps);
+			error[refinement] = std::abs(y[0] - decaySolution(1.0));
+		}
+		double observed = std::log2(error[0] / error[1]);
+		if (std::abs(observed - tableau.order) > 0.25) {
+			++nrOfFailedTestCases;
+			if (reportTestCases) std::cerr << "FAIL: " << tableau.name << " observed order " << observed << " expected " << tableau.order << '\n';
+		}
+		return nrOfFailedTestCases;
+	}
+
+	// a lane of the ensemble must reproduce a standalone integration in the same number system bit for bit
+	template<typename Scalar>
+	int VerifyLane(bool reportTestCases, const blas::ensemble_report& report, size_t lane, const std::vector<double>& y0, double h, size_t steps) {
+		int nrOfFailedTestCases = 0;
+		blas::explicit_runge_kutta<Scalar> rk(blas::butcher_tableau::rk4(), y0.size());
+		blas::vector<Scalar> y(y0.size());
+		for (size_t i = 0; i < y0.size(); ++i) y[i] = Scalar(y0[i]);
+		rk.integrate(lorenz, Scalar(0), y, Scalar(h), steps);
+		for (size_t i = 0; i < y0.size(); ++i) {
+			if (double(y[i]) != report.lanes[lane].state[i]) {
+				++nrOfFailedTestCases;
+				if (reportTestCases) std::cerr << "FAIL: lane " << report.lanes[lane].type << " y[" << i << "] " << report.lanes[lane].state[i] << " != " << double(y[i]) << '\n';
+			}
+		}
+		return nrOfFailedTestCases;
+	}
+
+	int VerifyEnsemble(bool reportTestCases) {
+		using namespace sw::universal::blas;
+		int nrOfFailedTestCases = 0;
+		std::vector<double> y0{ 1.0, 1.0, 1.0 };
+		double h = 0.01;
+		size_t steps = 1000, interval = 50;
+		auto report = ensemble_integrate(std::tuple<dd, double, float, posit<32, 2>, cfloat<32, 8, uint32_t, true, false, false>>(), butcher_tableau::rk4(), lorenz, y0, 0.0, h, steps, interval);
+
+		if (report.lanes.size() != 5 || report.time.size() != steps / interval + 1) {
+			if (reportTestCases) std::cerr << "FAIL: ensemble report has " << report.lanes.size() << " lanes and " << report.time.size() << " samples\n";
+			return 1;
+		}
+		for (auto d : report.lanes[0].divergence) {
+			if (d != 0.0) {
+				++nrOfFailedTestCases;
+				if (reportTestCases) std::cerr << "FAIL: reference lane diverges from itself\n";
+				break;
+			}
+		}
+		// rounding differences grow exponentially in a chaotic system: lower precision diverges sooner
+		for (const auto& lane : report.lanes) {
+			if (lane.divergence.front() > 1.0e-6 || !lane.error.empty()) {
+				++nrOfFailedTestCases;
+				if (reportTestCases) std::cerr << "FAIL: lane " << lane.type << " initial divergence " << lane.divergence.front() << ' ' << lane.error << '\n';
+			}
+		}
+		size_t midway = report.time.size() / 2;
+		if (!(report.lanes[2].divergence[midway] > report.lanes[1].divergence[midway])) {
+			++nrOfFailedTestCases;
+			if (reportTestCases) std::cerr << "FAIL: float does not diverge before double\n";
+		}
+
+		nrOfFailedTestCases += VerifyLane<double>(reportTestCases, report, 1, y0, h, steps);
+		nrOfFailedTestCases += VerifyLane<float>(reportTestCases, report, 2, y0, h, steps);
+		nrOfFailedTestCases += VerifyLane< posit<32, 2> >(reportTestCases, report, 3, y0, h, steps);
+		nrOfFailedTestCases += VerifyLane< cfloat<32, 8, uint32_t, true, false, false> >(reportTestCases, report, 4, y0, h, steps);
+		return nrOfFailedTestCases;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "explicit Runge-Kutta integrators";
+	std::string test_tag    = "runge_kutta";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	nrOfFailedTestCases += ReportTestResult(VerifyEnsemble(true), "ensemble", "lorenz");
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyOrder(reportTestCases, blas::butcher_tableau::euler()), "double", "Euler order");
+	nrOfFailedTestCases += ReportTestResult(VerifyOrder(reportTestCases, blas::butcher_tableau::heun()), "double", "Heun order");
+	nrOfFailedTestCases += ReportTestResult(VerifyOrder(reportTestCases, blas::butcher_tableau::midpoint()), "double", "midpoint order");
+	nrOfFailedTestCases += ReportTestResult(VerifyOrder(reportTestCases, blas::butcher_tableau::rk4()), "double", "RK4 order");
+	nrOfFailedTestCases += ReportTestResult(VerifyOrder(reportTestCases, blas::butcher_tableau::rk38()), "double", "3/8-rule order");
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyEnsemble(reportTestCases), "ensemble", "lorenz");
+#endif
+
+#if REGRESSION_LEVEL_3
+#endif
+
+#if REGRESSION_LEVEL_4
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught ad-hoc exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Caught unexpected universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Caught unexpected universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Caught unexpected runtime error: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,242 @@
+// stencil.cpp: test suite for the matrix-free stencil operators and the iterative solvers that sweep them
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <cmath>
+#include <universal/number/posit/posit.hpp>
+#include <universal/blas/blas.hpp>
+#include <universal/blas/solvers/jacobi.hpp>
+#include <universal/blas/solvers/gauss_seidel.hpp>
+#include <universal/blas/solvers/sor.hpp>
+#include <universal/blas/solvers/cg.hpp>
+#include <universal/verification/test_suite.hpp>
+
+namespace sw { namespace universal {
+
+	// small integer values keep both products exact, so the matrix-free and the dense operator must agree bit for bit
+	template<typename Scalar>
+	blas::vector<Scalar> IntegerVector(size_t N) {
+		blas::vector<Scalar> x(N);
+		for (size_t i = 0; i < N; ++i) x[i] = Scalar(int((i * 7) % 11) - 5);
+		return x;
+	}
+
+	template<typename Scalar>
+	int VerifyMatvec(bool reportTestCases) {
+		int nrOfFailedTestCases = 0;
+		for (size_t m : { 1, 2, 5 }) {
+			for (size_t n : { 1, 3, 8 }) {
+				blas::matrix<Scalar> D;
+				blas::stencil<Scalar, 2> S;
+				blas::laplace2D(D, m, n);
+				blas::laplace2D(S, m, n);
+				auto x = IntegerVector<Scalar>(m * n);
+				auto yd = D * x;
+				auto ys = S * x;
+				for (size_t i = 0; i < m * n; ++i) {
+					if (yd[i] != ys[i]) {
+						++nrOfFailedTestCases;
+						if (reportTestCases) std::cerr << "FAIL: laplace2D " << m << 'x' << n << " row " << i << " : " << ys[i] << " != " << yd[i] << '\n';
+						break;
+					}
+				}
+			}
+		}
+		blas::matrix<Scalar> D;
+		blas::stencil<Scalar, 3> S;
+		blas::laplace3D(D, 3, 4, 5);
+		blas::laplace3D(S, 3, 4, 5);
+		auto x = IntegerVector<Scalar>(60);
+		auto yd = D * x;
+		auto ys = S * x;
+		for (size_t i = 0; i < 60; ++i) {
+			if (yd[i] != ys[i]) {
+				++nrOfFailedTestCases;
+				if (reportTestCases) std::cerr << "FAIL: laplace3D row " << i << " : " << ys[i] << " != " << yd[i] << '\n';
+				break;
+			}
+		}
+		return nrOfFailedTestCases;
+	}
+
+	// reference red-black SOR sweep on an m x n grid, serial and in natural order within each color
+	template<typename Scalar>
+	Scalar ReferenceSweep(size_t m, size_t n, const blas::vector<Scalar>& b, blas::vector<Scalar>& x, const Scalar& w) {
+		using std::abs;
+		Scalar one(1), four(4), change(0);
+		std::vector<Scalar> lineChange(m, Scalar(0));
+		for (size_t color = 0; color < 2; ++color) {
+			for (size_t i = 0; i < m; ++i) {
+				for (size_t j = 0; j < n; ++j) {
+					if (((i + j) & 1) != color) continue;
+					size_t p = i * n + j;
+					Scalar s(0);
+					if (j > 0) s += x[p - 1];
+					if (j + 1 < n) s += x[p + 1];
+					if (i > 0) s += x[p - n];
+					if (i + 1 < m) s += x[p + n];
+					Scalar update = (one - w) * x[p] + w * (b[p] - Scalar(-1) * s) / four;
+					lineChange[i] += abs(update - x[p]);
+					x[p] = update;
+				}
+			}
+		}
+		for (const auto& c : lineChange) change += c;
+		return change;
+	}
+
+	// the parallel sweeps reproduce the serial reference exactly, independent of how the lines are partitioned
+	template<typename Scalar>
+	int VerifyRedBlackSweep(bool reportTestCases) {
+		int nrOfFailedTestCases = 0;
+		constexpr size_t m = 37, n = 29;
+		blas::stencil<Scalar, 2> S;
+		blas::laplace2D(S, m, n);
+		blas::vector<Scalar> b(m * n), x(m * n, Scalar(0)), xref(m * n, Scalar(0));
+		for (size_t i = 0; i < m * n; ++i) b[i] = Scalar(std::sin(double(i)));
+		Scalar w(1.5);
+		for (int sweep = 0; sweep < 5; ++sweep) {
+			Scalar change = S.sor_sweep(b, x, w);
+			Scalar changeRef = ReferenceSweep(m, n, b, xref, w);
+			if (change != changeRef) {
+				++nrOfFailedTestCases;
+				if (reportTestCases) std::cerr << "FAIL: sweep " << sweep << " change " << change << " != " << changeRef << '\n';
+			}
+		}
+		for (size_t i = 0; i < m * n; ++i) {
+			if (x[i] != xref[i]) {
+				++nrOfFailedTestCases;
+				if (reportTestCases) std::cerr << "FAIL: x[" << i << "] " << x[i] << " != " << xref[i] << '\n';
+				break;
+			}
+		}
+		return nrOfFailedTestCases;
+	}
+
+	// all four solvers recover a known solution of the 2D Laplacian
+	template<typename Scalar>
+	int VerifySolvers(bool reportTestCases, double tolerance) {
+		using std::sqrt;
+		int nrOfFailedTestCases = 0;
+		constexpr size_t m = 16, n = 16, N = m * n;
+		blas::stencil<Scalar, 2> A;
+		blas::laplace2D(A, m, n);
+		blas::vector<Scalar> xtrue(N);
+		for (size_t i = 0; i < N; ++i) xtrue[i] = Scalar(1.0 + double(i % 5) / 8.0);
+		blas::vector<Scalar> b = A * xtrue;
+		Scalar tol(tolerance / 100.0);
+
+		auto check = [&](const blas::vector<Scalar>& x, const char* solver) {
+			double error = 0.0;
+			for (size_t i = 0; i < N; ++i) error = std::max(error, std::abs(double(x[i]) - double(xtrue[i])));
+			if (error > tolerance) {
+				++nrOfFailedTestCases;
+				if (reportTestCases) std::cerr << "FAIL: " << solver << " max error " << error << '\n';
+			}
+		};
+
+		blas::vector<Scalar> x(N, Scalar(0));
+		blas::Jacobi<blas::stencil<Scalar, 2>, blas::vector<Scalar>, 2000, false>(A, b, x, tol);
+		check(x, "Jacobi");
+
+		x = Scalar(0);
+		blas::GaussSeidel<blas::stencil<Scalar, 2>, blas::vector<Scalar>, 1000>(A, b, x, tol);
+		check(x, "Gauss-Seidel");
+
+		x = Scalar(0);
+		Scalar w = Scalar(2.0 / (1.0 + std::sin(3.14159265358979323846 / double(n + 1))));
+		blas::sor<blas::stencil<Scalar, 2>, blas::vector<Scalar>, 200>(A, b, x, w, tol);
+		check(x, "SOR");
+
+		x = Scalar(0);
+		blas::vector<Scalar> residuals;
+		auto M = blas::jacobi_preconditioner(A);
+		blas::cg<blas::stencil<Scalar, 2>, blas::vector<Scalar>, 200>(M, A, b, x, residuals, tol);
+		check(x, "cg");
+
+		return nrOfFailedTestCases;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "matrix-free stencil operators";
+	std::string test_tag    = "stencil";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	nrOfFailedTestCases += ReportTestResult(VerifySolvers<double>(true, 1.0e-8), "double", "solvers");
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyMatvec<double>(reportTestCases), "double", "matvec");
+	nrOfFailedTestCases += ReportTestResult(VerifyRedBlackSweep<double>(reportTestCases), "double", "red-black sweep");
+	nrOfFailedTestCases += ReportTestResult(VerifySolvers<double>(reportTestCases, 1.0e-8), "double", "solvers");
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyMatvec< posit<16, 1> >(reportTestCases), "posit<16,1>", "matvec");
+	nrOfFailedTestCases += ReportTestResult(VerifyRedBlackSweep<float>(reportTestCases), "float", "red-black sweep");
+	nrOfFailedTestCases += ReportTestResult(VerifySolvers<float>(reportTestCases, 1.0e-3), "float", "solvers");
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifySolvers< posit<32, 2> >(reportTestCases, 1.0e-5), "posit<32,2>", "solvers");
+#endif
+
+#if REGRESSION_LEVEL_4
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught ad-hoc exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Caught unexpected universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Caught unexpected universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Caught unexpected runtime error: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,187 @@
+// svd.cpp: test suite for the one-sided Jacobi singular value decomposition
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <cmath>
+#include <random>
+#include <string>
+#include <universal/number/posit/posit.hpp>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/blas/blas.hpp>
+#include <universal/verification/test_suite.hpp>
+
+namespace sw { namespace universal {
+
+	// A = (I - 2 u u^T) * diag(s) * (I - 2 v v^T) has the singular values s
+	blas::matrix<double> ReflectedDiagonal(size_t m, size_t n, const std::vector<double>& s, unsigned seed) {
+		std::mt19937_64 engine(seed);
+		std::normal_distribution<double> dist(0.0, 1.0);
+		std::vector<double> u(m), v(n);
+		double uu{ 0 }, vv{ 0 };
+		for (auto& e : u) { e = dist(engine); uu += e * e; }
+		for (auto& e : v) { e = dist(engine); vv += e * e; }
+		for (auto& e : u) e /= std::sqrt(uu);
+		for (auto& e : v) e /= std::sqrt(vv);
+		blas::matrix<double> D(m, n), A(m, n);
+		for (size_t i = 0; i < s.size(); ++i) D(i, i) = s[i];
+		// A = (I - 2uu^T) D (I - 2vv^T)
+		std::vector<double> Dv(m, 0.0);
+		for (size_t i = 0; i < m; ++i) for (size_t j = 0; j < n; ++j) Dv[i] += D(i, j) * v[j];
+		blas::matrix<double> B(m, n);
+		for (size_t i = 0; i < m; ++i) for (size_t j = 0; j < n; ++j) B(i, j) = D(i, j) - 2.0 * Dv[i] * v[j];
+		std::vector<double> uB(n, 0.0);
+		for (size_t i = 0; i < m; ++i) for (size_t j = 0; j < n; ++j) uB[j] += u[i] * B(i, j);
+		for (size_t i = 0; i < m; ++i) for (size_t j = 0; j < n; ++j) A(i, j) = B(i, j) - 2.0 * u[i] * uB[j];
+		return A;
+	}
+
+	// verify the singular values, the reconstruction A = U * Sigma * V^T, and the orthogonality of U and V
+	template<typename Scalar>
+	int VerifyJacobiSVD(bool reportTestCases, size_t m, size_t n, double tolerance, const blas::svd_options& options = blas::svd_options{}) {
+		size_t p = std::min(m, n);
+		std::vector<double> s(p);
+		for (size_t i = 0; i < p; ++i) s[i] = std::pow(10.0, -3.0 * double(i) / double(p)) * (i % 3 == 1 ? 0.5 : 1.0);
+		std::sort(s.begin(), s.end(), [](double a, double b) { return a > b; });
+		blas::matrix<double> Aref = ReflectedDiagonal(m, n, s, unsigned(m * 131 + n));
+		blas::matrix<Scalar> A(Aref), U, V;
+		blas::vector<Scalar> sigma;
+		blas::svd_convergence convergence = blas::jacobi_svd(A, U, sigma, V, options);
+
+		int nrOfFailedTestCases = 0;
+		if (!convergence.converged) {
+			++nrOfFailedTestCases;
+			if (reportTestCases) std::cerr << "FAIL: no convergence in " << convergence.sweeps << " sweeps\n";
+		}
+		if (sigma.size() != p || num_rows(U) != m || num_cols(U) != p || num_rows(V) != n || num_cols(V) != p) {
+			++nrOfFailedTestCases;
+			if (reportTestCases) std::cerr << "FAIL: shapes of U, sigma, V\n";
+			return nrOfFailedTestCases;
+		}
+		for (size_t i = 0; i < p; ++i) {
+			if (std::fabs(double(sigma[i]) - s[i]) > tolerance * s[0]) {
+				++nrOfFailedTestCases;
+				if (reportTestCases) std::cerr << "FAIL: sigma[" << i << "] = " << sigma[i] << " expected " << s[i] << '\n';
+			}
+		}
+		double reconstruction{ 0 }, orthogonalityU{ 0 }, orthogonalityV{ 0 };
+		for (size_t i = 0; i < m; ++i) {
+			for (size_t j = 0; j < n; ++j) {
+				double a{ 0 };
+				for (size_t k = 0; k < p; ++k) a += double(U(i, k)) * double(sigma[k]) * double(V(j, k));
+				reconstruction = std::max(reconstruction, std::fabs(a - Aref(i, j)));
+			}
+		}
+		for (size_t i = 0; i < p; ++i) {
+			for (size_t j = 0; j < p; ++j) {
+				double uu{ 0 }, vv{ 0 };
+				for (size_t k = 0; k < m; ++k) uu += double(U(k, i)) * double(U(k, j));
+				for (size_t k = 0; k < n; ++k) vv += double(V(k, i)) * double(V(k, j));
+				orthogonalityU = std::max(orthogonalityU, std::fabs(uu - (i == j ? 1.0 : 0.0)));
+				orthogonalityV = std::max(orthogonalityV, std::fabs(vv - (i == j ? 1.0 : 0.0)));
+			}
+		}
+		if (reconstruction > tolerance * s[0] || orthogonalityU > tolerance || orthogonalityV > tolerance) {
+			++nrOfFailedTestCases;
+			if (reportTestCases) std::cerr << "FAIL: |A - U S V^T| = " << reconstruction << " |U^T U - I| = " << orthogonalityU << " |V^T V - I| = " << orthogonalityV << '\n';
+		}
+		if (reportTestCases) std::cout << m << 'x' << n << " : sweeps " << convergence.sweeps << " : |A - U S V^T| = " << reconstruction << '\n';
+		return nrOfFailedTestCases;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "one-sided Jacobi SVD";
+	std::string test_tag    = "svd";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	blas::svd_options options;
+	options.trace = true;
+	nrOfFailedTestCases += ReportTestResult(VerifyJacobiSVD<double>(true, 20, 10, 1.0e-12, options), "double", "20x10");
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyJacobiSVD<double>(reportTestCases, 8, 8, 1.0e-13), "double", "8x8");
+	nrOfFailedTestCases += ReportTestResult(VerifyJacobiSVD<double>(reportTestCases, 20, 7, 1.0e-13), "double", "20x7");
+	nrOfFailedTestCases += ReportTestResult(VerifyJacobiSVD<double>(reportTestCases, 7, 20, 1.0e-13), "double", "7x20");
+	nrOfFailedTestCases += ReportTestResult(VerifyJacobiSVD<float>(reportTestCases, 16, 9, 1.0e-5), "float", "16x9");
+	nrOfFailedTestCases += ReportTestResult(VerifyJacobiSVD< cfloat<32, 8, uint32_t, true, false, false> >(reportTestCases, 12, 12, 1.0e-5), "cfloat<32,8>", "12x12");
+#endif
+
+#if REGRESSION_LEVEL_2
+	{
+		using Posit = posit<32, 2>;
+		blas::svd_options fused;
+		fused.fused = true;
+		nrOfFailedTestCases += ReportTestResult(VerifyJacobiSVD<Posit>(reportTestCases, 12, 10, 1.0e-6), "posit<32,2>", "12x10");
+		nrOfFailedTestCases += ReportTestResult(VerifyJacobiSVD<Posit>(reportTestCases, 12, 10, 1.0e-6, fused), "posit<32,2>", "12x10 quire");
+	}
+#endif
+
+#if REGRESSION_LEVEL_3
+	{
+		// above the parallel threshold the rounds are distributed across threads
+		blas::svd_options threaded;
+		threaded.nrThreads = 4;
+		nrOfFailedTestCases += ReportTestResult(VerifyJacobiSVD<double>(reportTestCases, 100, 80, 1.0e-12, threaded), "double", "100x80 4 threads");
+		nrOfFailedTestCases += ReportTestResult(VerifyJacobiSVD<double>(reportTestCases, 81, 130, 1.0e-12, threaded), "double", "81x130 4 threads");
+	}
+#endif
+
+#if REGRESSION_LEVEL_4
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught ad-hoc exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Caught unexpected universal arithmetic exception : " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Caught unexpected universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << '\n';
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,283 @@
+// tensor.cpp: test suite for the N-dimensional tensor, its strided views, and einsum-style contractions
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <cmath>
+#include <map>
+#include <random>
+#include <string>
+#include <universal/number/posit/posit.hpp>
+#include <universal/blas/blas.hpp>
+#include <universal/verification/test_suite.hpp>
+
+namespace sw { namespace universal {
+
+	template<typename Scalar, unsigned Rank>
+	void Iota(blas::tensor<Scalar, Rank>& T) {
+		double v = 0.0;
+		for (auto& e : T) e = Scalar(v++);
+	}
+
+	template<typename Scalar, unsigned Rank>
+	void Random(blas::tensor<Scalar, Rank>& T, std::mt19937_64& engine) {
+		std::uniform_real_distribution<double> dist(-1.0, 1.0);
+		for (auto& e : T) e = Scalar(dist(engine));
+	}
+
+	// views refer to the elements of the tensor: no copies are made
+	int VerifyViews(bool reportTestCases) {
+		int nrOfFailedTestCases = 0;
+		blas::tensor<double, 3> T(2, 3, 4);
+		Iota(T);
+
+		auto P = T.permute({ 2, 0, 1 });           // P(k, i, j) = T(i, j, k)
+		auto S = T.slice(1, 1, 3);                 // S(i, j, k) = T(i, j + 1, k)
+		auto A = T.at(2, 3);                       // A(i, j) = T(i, j, 3)
+		auto R = T.reshape(std::array<size_t, 2>{ 6, 4 });
+		auto Tt = T.transpose();                   // Tt(k, j, i) = T(i, j, k)
+		for (size_t i = 0; i < 2; ++i) for (size_t j = 0; j < 3; ++j) for (size_t k = 0; k < 4; ++k) {
+			if (P(k, i, j) != T(i, j, k) || Tt(k, j, i) != T(i, j, k) || R(i * 3 + j, k) != T(i, j, k)) ++nrOfFailedTestCases;
+			if (j < 2 && S(i, j, k) != T(i, j + 1, k)) ++nrOfFailedTestCases;
+			if (k == 3 && A(i, j) != T(i, j, k)) ++nrOfFailedTestCases;
+		}
+		if (reportTestCases && nrOfFailedTestCases) std::cerr << "FAIL: view elements differ from the tensor elements\n";
+
+		// writes through a view are visible in the tensor
+		S(1, 0, 2) = -1.0;
+		P(3, 0, 0) = -2.0;
+		if (T(1, 1, 2) != -1.0 || T(0, 0, 3) != -2.0) {
+			++nrOfFailedTestCases;
+			if (reportTestCases) std::cerr << "FAIL: writes through a view\n";
+		}
+
+		if (!T.view().is_contiguous() || !R.is_contiguous() || P.is_contiguous() || S.is_contiguous() || !T.slice(0, 1, 2).is_contiguous()) {
+			++nrOfFailedTestCases;
+			if (reportTestCases) std::cerr << "FAIL: is_contiguous\n";
+		}
+
+		// a strided view cannot be relabeled, but it can be materialized
+		bool caught = false;
+		try { P.reshape(std::array<size_t, 1>{ 24 }); }
+		catch (const blas::tensor_incompatible_shapes&) { caught = true; }
+		blas::tensor<double, 3> Pc(P);
+		auto flat = Pc.reshape(std::array<size_t, 1>{ 24 });
+		if (!caught || flat(5) != P(0, 1, 2) || Pc.shape() != std::array<size_t, 3>{ 4, 2, 3 }) {
+			++nrOfFailedTestCases;
+			if (reportTestCases) std::cerr << "FAIL: reshape of a strided view\n";
+		}
+		return nrOfFailedTestCases;
+	}
+
+	// reference contraction: visit every assignment of the labels and accumulate in double
+	template<typename ViewA, typename ViewB, size_t RankC>
+	blas::tensor<double, RankC> ReferenceContraction(const ViewA& A, const std::string& la, const ViewB& B, const std::string& lb,
+	                                                 const std::array<size_t, RankC>& shape, const std::string& lc) {
+		constexpr size_t RankA = ViewA::rank, RankB = ViewB::rank;
+		std::map<char, size_t> extent;
+		for (size_t d = 0; d < RankA; ++d) extent[la[d]] = A.extent(unsigned(d));
+		for (size_t d = 0; d < RankB; ++d) extent[lb[d]] = B.extent(unsigned(d));
+		std::string names;
+		size_t assignments = 1;
+		for (const auto& e : extent) { names += e.first; assignments *= e.second; }
+		blas::tensor<double, RankC> C(shape);
+		std::map<char, size_t> value;
+		for (size_t n = 0; n < assignments; ++n) {
+			size_t r = n;
+			for (char c : names) { value[c] = r % extent[c]; r /= extent[c]; }
+			std::array<size_t, RankA> ia{};
+			std::array<size_t, RankB> ib{};
+			std::array<size_t, RankC> ic{};
+			for (size_t d = 0; d < RankA; ++d) ia[d] = value[la[d]];
+			for (size_t d = 0; d < RankB; ++d) ib[d] = value[lb[d]];
+			for (size_t d = 0; d < RankC; ++d) ic[d] = value[lc[d]];
+			C[ic] += double(A[ia]) * double(B[ib]);
+		}
+		return C;
+	}
+
+	template<unsigned RankC, typename ViewA, typename ViewB>
+	int VerifyContraction(bool reportTestCases, const std::string& spec, const ViewA& A, const ViewB& B, double tolerance) {
+		auto C = blas::einsum<RankC>(spec, A, B);
+		size_t comma = spec.find(','), arrow = spec.find("->");
+		auto R = ReferenceContraction(A, spec.substr(0, comma), B, spec.substr(comma + 1, arrow - comma - 1), C.shape(), spec.substr(arrow + 2));
+		double error{ 0 };
+		auto r = R.begin();
+		for (const auto& e : C) error = std::max(error, std::fabs(double(e) - *r++));
+		int nrOfFailedTestCases = 0;
+		if (error > tolerance) {
+			++nrOfFailedTestCases;
+			if (reportTestCases) std::cerr << "FAIL: " << spec << " error " << error << '\n';
+		}
+		else if (reportTestCases) {
+			std::cout << std::setw(20) << spec << " : " << blas::to_string(C.shape()) << " error " << error << '\n';
+		}
+		return nrOfFailedTestCases;
+	}
+
+	// the classes of labels: rows, columns, reduction, batch, diagonals, and labels summed in one operand only
+	template<typename Scalar>
+	int VerifyContractions(bool reportTestCases, double tolerance, size_t M = 70, size_t K = 150, size_t N = 130) {
+		int nrOfFailedTestCases = 0;
+		std::mt19937_64 engine(7);
+		blas::tensor<Scalar, 2> A(M, K), B(K, N), S(9, 9);
+		blas::tensor<Scalar, 3> X(3, 20, 30), Y(3, 30, 25), Z(5, 6, 7);
+		blas::tensor<Scalar, 1> u(K), v(K);
+		Random(A, engine); Random(B, engine); Random(S, engine);
+		Random(X, engine); Random(Y, engine); Random(Z, engine);
+		Random(u, engine); Random(v, engine);
+
+		nrOfFailedTestCases += VerifyContraction<2>(reportTestCases, "ik,kj->ij", A.view(), B.view(), tolerance);
+		nrOfFailedTestCases += VerifyContraction<2>(reportTestCases, "ik,kj->ji", A.view(), B.view(), tolerance);
+		nrOfFailedTestCases += VerifyContraction<2>(reportTestCases, "ki,jk->ij", A.transpose(), B.transpose(), tolerance);
+		nrOfFailedTestCases += VerifyContraction<2>(reportTestCases, "ik,kj->ij", A.slice(0, 1, M - 1).slice(1, 3, K - 2), B.slice(0, 3, K - 2), tolerance);
+		nrOfFailedTestCases += VerifyContraction<3>(reportTestCases, "bij,bjk->bik", X.view(), Y.view(), tolerance);
+		nrOfFailedTestCases += VerifyContraction<2>(reportTestCases, "bij,bjk->ik", X.view(), Y.view(), tolerance);
+		nrOfFailedTestCases += VerifyContraction<3>(reportTestCases, "abc,ad->bcd", Z.view(), S.slice(0, 0, 5).slice(1, 0, 4), tolerance);
+		nrOfFailedTestCases += VerifyContraction<2>(reportTestCases, "i,j->ij", u.view(), v.view(), tolerance);
+		nrOfFailedTestCases += VerifyContraction<0>(reportTestCases, "i,i->", u.view(), v.view(), tolerance);
+		nrOfFailedTestCases += VerifyContraction<1>(reportTestCases, "ii,j->j", S.view(), v.view(), tolerance);
+		nrOfFailedTestCases += VerifyContraction<1>(reportTestCases, "ij,kl->l", A.slice(0, 0, 4).slice(1, 0, 5), B.slice(0, 0, 6).slice(1, 0, 7), tolerance);
+		nrOfFailedTestCases += VerifyContraction<3>(reportTestCases, "ab,cd->abd", A.slice(0, 0, 4).slice(1, 0, 5), B.reshape(std::array<size_t, 2>{ 3, K * N / 3 }).slice(1, 0, 6), tolerance);
+
+		// the rank 2 product agrees with the matrix product
+		blas::tensor<Scalar, 2> C = A * B;
+		blas::matrix<Scalar> Am(M, K), Bm(K, N);
+		for (size_t i = 0; i < M; ++i) for (size_t k = 0; k < K; ++k) Am(i, k) = A(i, k);
+		for (size_t k = 0; k < K; ++k) for (size_t j = 0; j < N; ++j) Bm(k, j) = B(k, j);
+		blas::matrix<Scalar> Cm = Am * Bm;
+		double error{ 0 };
+		for (size_t i = 0; i < M; ++i) for (size_t j = 0; j < N; ++j) error = std::max(error, std::fabs(double(C(i, j)) - double(Cm(i, j))));
+		if (error > tolerance) {
+			++nrOfFailedTestCases;
+			if (reportTestCases) std::cerr << "FAIL: tensor product differs from the matrix product by " << error << '\n';
+		}
+		return nrOfFailedTestCases;
+	}
+
+	// a reduction with cancellation: native accumulation loses the small terms, wide accumulation keeps them
+	template<typename Scalar>
+	int VerifyWideAccumulation(bool reportTestCases, double big) {
+		constexpr size_t K = 300; // more than one reduction block
+		blas::tensor<Scalar, 2> A(2, K), B(K, 1);
+		for (size_t k = 0; k < K; ++k) {
+			A(0, k) = Scalar(k % 3 == 0 ? big : (k % 3 == 1 ? 1.0 : -big));
+			A(1, k) = Scalar(1.0);
+			B(k, 0) = Scalar(1.0);
+		}
+		auto native = blas::einsum<2>("ik,kj->ij", A, B);
+		auto wide = blas::einsum<2>("ik,kj->ij", A, B, blas::Accumulation::Wide);
+		int nrOfFailedTestCases = 0;
+		if (double(wide(0, 0)) != double(K / 3) || double(wide(1, 0)) != double(K) || double(native(0, 0)) == double(K / 3)) {
+			++nrOfFailedTestCases;
+			if (reportTestCases) std::cerr << "FAIL: " << type_tag(Scalar()) << " native " << native(0, 0) << " wide " << wide(0, 0) << " exact " << K / 3 << '\n';
+		}
+		else if (reportTestCases) {
+			std::cout << type_tag(Scalar()) << " native " << native(0, 0) << " wide " << wide(0, 0) << " exact " << K / 3 << '\n';
+		}
+		return nrOfFailedTestCases;
+	}
+
+	int VerifyShapeErrors(bool reportTestCases) {
+		blas::tensor<double, 2> A(3, 4), B(5, 6);
+		int nrOfFailedTestCases = 0;
+		for (std::string spec : { "ij,jk->ik", "ij,kl->im", "ij,kl->ii", "ijk,kl->il", "ij,kl" }) {
+			bool caught = false;
+			try { blas::einsum<2>(spec, A, B); }
+			catch (const blas::tensor_incompatible_shapes& err) {
+				caught = true;
+				if (reportTestCases) std::cout << spec << " : " << err.what() << '\n';
+			}
+			if (!caught) {
+				++nrOfFailedTestCases;
+				if (reportTestCases) std::cerr << "FAIL: " << spec << " did not throw\n";
+			}
+		}
+		return nrOfFailedTestCases;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "N-dimensional tensor";
+	std::string test_tag    = "tensor";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	blas::tensor<float, 3> T(2, 3, 4);
+	Iota(T);
+	std::cout << T << '\n' << T.permute({ 1, 0, 2 }) << '\n';
+	nrOfFailedTestCases += ReportTestResult(VerifyContractions<double>(true, 1.0e-12), "double", "einsum");
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyViews(reportTestCases), "double", "views");
+	nrOfFailedTestCases += ReportTestResult(VerifyContractions<double>(reportTestCases, 1.0e-12), "double", "einsum");
+	nrOfFailedTestCases += ReportTestResult(VerifyShapeErrors(reportTestCases), "double", "shape errors");
+	nrOfFailedTestCases += ReportTestResult(VerifyWideAccumulation<float>(reportTestCases, 1.0e8), "float", "wide accumulation");
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyContractions<float>(reportTestCases, 1.0e-4), "float", "einsum");
+	nrOfFailedTestCases += ReportTestResult(VerifyWideAccumulation< posit<16, 1> >(reportTestCases, 4096.0), "posit<16,1>", "quire accumulation");
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyContractions< posit<32, 2> >(reportTestCases, 1.0e-5, 20, 30, 24), "posit<32,2>", "einsum");
+#endif
+
+#if REGRESSION_LEVEL_4
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught ad-hoc exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Caught unexpected universal arithmetic exception : " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Caught unexpected universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << '\n';
+	return EXIT_FAILURE;
+}
@@ -6,6 +6,7 @@
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 #include <universal/utility/directives.hpp>
 #include <cmath>
+#include <random>
 #include <universal/number/integer/integer.hpp>
 #include <universal/number/fixpnt/fixpnt.hpp>
 #include <universal/number/cfloat/cfloat.hpp>
@@ -16,9 +17,124 @@
 #include <universal/blas/statistics.hpp>
 #include <universal/verification/test_suite.hpp>
 
+namespace sw { namespace universal {
+
+	// reference: two-pass moments and quartiles of a fully sorted copy
+	blas::SummaryStats<double> ReferenceStatistics(const std::vector<double>& data) {
+		size_t N = data.size();
+		double sum{ 0 };
+		for (auto e : data) sum += e;
+		double mean = sum / double(N);
+		sum = 0.0;
+		for (auto e : data) sum += (e - mean) * (e - mean);
+		std::vector<double> v(data);
+		std::sort(v.begin(), v.end());
+		blas::SummaryStats<double> stats;
+		stats.mean = mean;
+		stats.stddev = std::sqrt(sum / double(N - 1));
+		stats.quantiles.set(v[0], v[N / 4], v[N / 2], v[(3 * N) / 4], v[N - 1]);
+		return stats;
+	}
+
+	// single-pass moments and exact quantiles must agree with the two-pass, sort-based reference
+	int VerifyExactStatistics(bool reportTestCases, size_t N) {
+		std::vector<double> data(N);
+		blas::gaussian_random(data, 1.0e3, 1.0);    // a large mean stresses the one-pass variance
+		auto stats = blas::summaryStatistics(data, blas::QuantileMethod::Exact);
+		auto ref = ReferenceStatistics(data);
+		int nrOfFailedTestCases = 0;
+		if (std::fabs(stats.mean - ref.mean) > 1.0e-12 * std::fabs(ref.mean) || std::fabs(stats.stddev - ref.stddev) > 1.0e-9 * ref.stddev) {
+			++nrOfFailedTestCases;
+			if (reportTestCases) std::cerr << "FAIL: moments " << stats.mean << ' ' << stats.stddev << " reference " << ref.mean << ' ' << ref.stddev << '\n';
+		}
+		for (int i = 0; i < 5; ++i) {
+			if (stats.quantiles.q[i] != ref.quantiles.q[i]) {
+				++nrOfFailedTestCases;
+				if (reportTestCases) std::cerr << "FAIL: quantile " << i << " : " << stats.quantiles.q[i] << " reference " << ref.quantiles.q[i] << '\n';
+			}
+		}
+		return nrOfFailedTestCases;
+	}
+
+	// accumulators of the two halves merge into the accumulator of the whole
+	int VerifyMerge(bool reportTestCases, size_t N) {
+		std::vector<double> data(N);
+		blas::gaussian_random(data, -2.0, 3.0);
+		blas::StreamingStats<double> whole, left, right;
+		blas::QuantileSketch<double> sketchLeft(200, 1), sketchRight(200, 2);
+		for (size_t i = 0; i < N; ++i) {
+			whole.push(data[i]);
+			if (i < N / 3) { left.push(data[i]); sketchLeft.push(data[i]); }
+			else { right.push(data[i]); sketchRight.push(data[i]); }
+		}
+		left.merge(right);
+		sketchLeft.merge(sketchRight);
+		int nrOfFailedTestCases = 0;
+		if (left.count() != whole.count() || std::fabs(left.mean() - whole.mean()) > 1.0e-12 || std::fabs(left.stddev() - whole.stddev()) > 1.0e-12
+			|| left.min() != whole.min() || left.max() != whole.max()) {
+			++nrOfFailedTestCases;
+			if (reportTestCases) std::cerr << "FAIL: merged moments " << left.mean() << ' ' << left.stddev() << " whole " << whole.mean() << ' ' << whole.stddev() << '\n';
+		}
+		if (sketchLeft.count() != N || sketchLeft.quantile(0.0) != whole.min() || sketchLeft.quantile(1.0) != whole.max()) {
+			++nrOfFailedTestCases;
+			if (reportTestCases) std::cerr << "FAIL: merged sketch extrema\n";
+		}
+		return nrOfFailedTestCases;
+	}
+
+	// the rank of each sketched quantile in the sorted data is within the error bound of the sketch
+	int VerifySketchAccuracy(bool reportTestCases, size_t N, unsigned k, double rankTolerance) {
+		std::vector<double> data(N);
+		blas::gaussian_random(data, 0.0, 1.0);
+		auto stats = blas::summaryStatistics(data, blas::QuantileMethod::Sketch, k);
+		std::vector<double> v(data);
+		std::sort(v.begin(), v.end());
+		int nrOfFailedTestCases = 0;
+		double phi[5] = { 0.0, 0.25, 0.5, 0.75, 1.0 };
+		for (int i = 0; i < 5; ++i) {
+			double r = double(std::lower_bound(v.begin(), v.end(), stats.quantiles.q[i]) - v.begin()) / double(N);
+			if (std::fabs(r - phi[i]) > rankTolerance) {
+				++nrOfFailedTestCases;
+				if (reportTestCases) std::cerr << "FAIL: k " << k << " quantile " << phi[i] << " has rank " << r << '\n';
+			}
+		}
+		return nrOfFailedTestCases;
+	}
+
+	// NaNs propagate into the mean and rank below every other value
+	int VerifyNaN(bool reportTestCases) {
+		std::vector<double> data = { 3.0, 1.0, std::numeric_limits<double>::quiet_NaN(), 2.0, 5.0, 4.0, 0.0, 6.0 };
+		int nrOfFailedTestCases = 0;
+		for (auto method : { blas::QuantileMethod::Exact, blas::QuantileMethod::Sketch }) {
+			auto stats = blas::summaryStatistics(data, method);
+			if (!std::isnan(stats.mean) || !std::isnan(stats.quantiles.q[0]) || stats.quantiles.q[4] != 6.0) {
+				++nrOfFailedTestCases;
+				if (reportTestCases) std::cerr << "FAIL: NaN handling\n" << stats;
+			}
+		}
+		return nrOfFailedTestCases;
+	}
+
+	template<typename Scalar>
+	int VerifyNumberSystem(bool reportTestCases) {
+		std::vector<Scalar> data(1000);
+		for (size_t i = 0; i < data.size(); ++i) data[i] = Scalar(double(i % 100) / 8.0);
+		auto exact = blas::summaryStatistics(data, blas::QuantileMethod::Exact);
+		auto sketched = blas::summaryStatistics(data, blas::QuantileMethod::Sketch, 64);
+		int nrOfFailedTestCases = 0;
+		if (std::fabs(double(exact.mean) - 6.1875) > 0.01 || exact.quantiles.q[0] != Scalar(0) || exact.quantiles.q[4] != Scalar(12.375)
+			|| sketched.quantiles.q[0] != Scalar(0) || sketched.quantiles.q[4] != Scalar(12.375)) {
+			++nrOfFailedTestCases;
+			if (reportTestCases) std::cerr << "FAIL: " << type_tag(Scalar()) << '\n' << exact << sketched;
+		}
+		return nrOfFailedTestCases;
+	}
+
+}} // namespace sw::universal
+
 
 // Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
-#define MANUAL_TESTING 1
+#define MANUAL_TESTING 0
 // REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
 // It is the responsibility of the regression test to organize the tests in a quartile progression.
 //#undef REGRESSION_LEVEL_OVERRIDE
@@ -77,15 +193,21 @@ try {
 #else
 
 #if REGRESSION_LEVEL_1
-
+	nrOfFailedTestCases += ReportTestResult(VerifyExactStatistics(reportTestCases, 1001), "double", "exact 1001");
+	nrOfFailedTestCases += ReportTestResult(VerifyMerge(reportTestCases, 10000), "double", "merge");
+	nrOfFailedTestCases += ReportTestResult(VerifyNaN(reportTestCases), "double", "NaN");
+	nrOfFailedTestCases += ReportTestResult(VerifySketchAccuracy(reportTestCases, 100000, 200, 0.02), "double", "sketch k=200");
 #endif
 
 #if REGRESSION_LEVEL_2
-
+	nrOfFailedTestCases += ReportTestResult(VerifyNumberSystem< posit<32, 2> >(reportTestCases), "posit<32,2>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyNumberSystem< cfloat<32, 8, uint32_t, true, false, false> >(reportTestCases), "cfloat<32,8>", test_tag);
 #endif
 
 #if REGRESSION_LEVEL_3
-
+	// large enough to be accumulated in parallel slices
+	nrOfFailedTestCases += ReportTestResult(VerifyExactStatistics(reportTestCases, 1024 * 1024), "double", "exact 1M");
+	nrOfFailedTestCases += ReportTestResult(VerifySketchAccuracy(reportTestCases, 1024 * 1024, 400, 0.01), "double", "sketch k=400");
 #endif
 
 #if REGRESSION_LEVEL_4
@@ -0,0 +1,261 @@
+// engine.cpp: test suite for the execution strategies of the vectorized math functions
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <cmath>
+#include <random>
+#include <string>
+#include <universal/number/posit/posit.hpp>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/bfloat/bfloat.hpp>
+#include <universal/blas/blas.hpp>
+#include <universal/verification/test_suite.hpp>
+
+namespace sw { namespace universal {
+
+	using blas::VmathFunction;
+	using blas::VmathKernel;
+
+	const char* FunctionName(VmathFunction f) {
+		switch (f) {
+		case VmathFunction::exp:     return "exp";
+		case VmathFunction::log:     return "log";
+		case VmathFunction::tanh:    return "tanh";
+		case VmathFunction::sigmoid: return "sigmoid";
+		case VmathFunction::sqrt:    return "sqrt";
+		case VmathFunction::rsqrt:   return "rsqrt";
+		case VmathFunction::sin:     return "sin";
+		case VmathFunction::cos:     return "cos";
+		}
+		return "unknown";
+	}
+
+	double Reference(VmathFunction f, double x) {
+		switch (f) {
+		case VmathFunction::exp:     return std::exp(x);
+		case VmathFunction::log:     return std::log(x);
+		case VmathFunction::tanh:    return std::tanh(x);
+		case VmathFunction::sigmoid: return 1.0 / (1.0 + std::exp(-x));
+		case VmathFunction::sqrt:    return std::sqrt(x);
+		case VmathFunction::rsqrt:   return 1.0 / std::sqrt(x);
+		case VmathFunction::sin:     return std::sin(x);
+		case VmathFunction::cos:     return std::cos(x);
+		}
+		return 0.0;
+	}
+
+	// arguments that cover the domain of the function, including the special cases of float
+	blas::vector<float> Arguments(VmathFunction f, size_t N) {
+		std::mt19937_64 engine(static_cast<unsigned>(f) + 1);
+		double range = (f == VmathFunction::sin || f == VmathFunction::cos) ? 1.0e5 : 100.0;
+		std::uniform_real_distribution<double> distribution(-range, range);
+		blas::vector<float> x(N);
+		for (size_t i = 0; i < N; ++i) {
+			float v = static_cast<float>(distribution(engine));
+			if (f == VmathFunction::log || f == VmathFunction::sqrt || f == VmathFunction::rsqrt) v = std::fabs(v) * std::ldexp(1.0f, static_cast<int>(engine() % 200) - 100);
+			x[i] = v;
+		}
+		x[0] = 0.0f;
+		x[1] = std::numeric_limits<float>::infinity();
+		x[2] = std::numeric_limits<float>::quiet_NaN();
+		x[3] = 1.0e-40f;  // subnormal
+		return x;
+	}
+
+	// the single precision kernels must be within maxUlp of the double precision reference rounded to float
+	template<VmathFunction f>
+	int VerifyFloatKernel(bool reportTestCases, size_t N, double maxUlp) {
+		int nrOfFailedTests = 0;
+		blas::vector<float> x = Arguments(f, N);
+		blas::vector<float> y = blas::vmath_apply<f>(x);
+		for (size_t i = 0; i < N; ++i) {
+			float reference = static_cast<float>(Reference(f, double(x[i])));
+			float result = y[i];
+			bool pass{ true };
+			if (std::isnan(reference) || std::isinf(reference) || reference == 0.0f) {
+				pass = (std::isnan(reference) ? std::isnan(result) : result == reference);
+			}
+			else {
+				float ulp = std::nextafter(std::fabs(reference), std::numeric_limits<float>::infinity()) - std::fabs(reference);
+				pass = (std::fabs(double(result) - double(reference)) <= maxUlp * ulp);
+			}
+			if (!pass) {
+				++nrOfFailedTests;
+				if (reportTestCases) ReportOneInputFunctionError("FAIL", FunctionName(f), x[i], result, reference);
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	// the table and parallel kernels must reproduce the scalar function of the number system exactly
+	template<VmathFunction f, typename Scalar>
+	int VerifyScalarEquivalence(bool reportTestCases, size_t N) {
+		int nrOfFailedTests = 0;
+		blas::vector<float> arguments = Arguments(f, N);
+		blas::vector<Scalar> x(N);
+		for (size_t i = 4; i < N; ++i) x[i] = Scalar(arguments[i]);
+		x[0] = 0; x[1] = 1; x[2] = -1; x[3] = 2;
+		blas::vector<Scalar> y = blas::vmath_apply<f>(x);
+		for (size_t i = 0; i < N; ++i) {
+			Scalar reference;
+			try {
+				reference = blas::vmath::evaluate<f>(x[i]);
+			}
+			catch (...) {
+				reference = Scalar(SpecificValue::qnan);
+			}
+			if (y[i] != reference && !(y[i].isnan() && reference.isnan())) {
+				++nrOfFailedTests;
+				if (reportTestCases) ReportOneInputFunctionError("FAIL", FunctionName(f), x[i], y[i], reference);
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	// bfloat16 rounds the float kernel, and must be within one ulp of the correctly rounded result
+	template<VmathFunction f, typename Scalar>
+	int VerifyEmbeddedKernel(bool reportTestCases, size_t N) {
+		int nrOfFailedTests = 0;
+		blas::vector<float> arguments = Arguments(f, N);
+		blas::vector<Scalar> x(N);
+		for (size_t i = 0; i < N; ++i) x[i] = Scalar(arguments[i]);
+		blas::vector<Scalar> y = blas::vmath_apply<f>(x);
+		for (size_t i = 0; i < N; ++i) {
+			double reference = Reference(f, double(x[i]));
+			Scalar rounded(reference);
+			if (y[i] == rounded || (y[i].isnan() && rounded.isnan())) continue;
+			Scalar below(rounded), above(rounded);
+			--below; ++above;
+			if (y[i] == below || y[i] == above) continue;
+			++nrOfFailedTests;
+			if (reportTestCases) ReportOneInputFunctionError("FAIL", FunctionName(f), x[i], y[i], rounded);
+		}
+		return nrOfFailedTests;
+	}
+
+	// cfloats with the float encoding must reproduce the float kernel exactly
+	template<VmathFunction f, typename Scalar>
+	int VerifyFloatEncoding(bool reportTestCases, size_t N) {
+		int nrOfFailedTests = 0;
+		blas::vector<float> arguments = Arguments(f, N);
+		blas::vector<Scalar> x(N);
+		for (size_t i = 0; i < N; ++i) x[i] = Scalar(arguments[i]);
+		blas::vector<float> reference = blas::vmath_apply<f>(arguments);
+		blas::vector<Scalar> y = blas::vmath_apply<f>(x);
+		for (size_t i = 0; i < N; ++i) {
+			Scalar rounded(reference[i]);
+			if (y[i] == rounded || (y[i].isnan() && rounded.isnan())) continue;
+			++nrOfFailedTests;
+			if (reportTestCases) ReportOneInputFunctionError("FAIL", FunctionName(f), x[i], y[i], rounded);
+		}
+		return nrOfFailedTests;
+	}
+
+	template<VmathFunction f>
+	int VerifyFunction(bool reportTestCases, size_t N) {
+		int nrOfFailedTests = 0;
+		nrOfFailedTests += ReportTestResult(VerifyFloatKernel<f>(reportTestCases, N, 4.0), "float", FunctionName(f));
+		nrOfFailedTests += ReportTestResult(VerifyFloatEncoding<f, fp32>(reportTestCases, N), "fp32", FunctionName(f));
+		nrOfFailedTests += ReportTestResult(VerifyScalarEquivalence<f, half>(reportTestCases, N), "half", FunctionName(f));
+		nrOfFailedTests += ReportTestResult(VerifyEmbeddedKernel<f, bfloat16>(reportTestCases, N), "bfloat16", FunctionName(f));
+		nrOfFailedTests += ReportTestResult(VerifyScalarEquivalence<f, posit<16, 1>>(reportTestCases, N), "posit<16,1>", FunctionName(f));
+		nrOfFailedTests += ReportTestResult(VerifyScalarEquivalence<f, posit<32, 2>>(reportTestCases, N), "posit<32,2>", FunctionName(f));
+		return nrOfFailedTests;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 0
+#define REGRESSION_LEVEL_4 0
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "vmath execution engine validation";
+	std::string test_tag    = "vmath engine";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+	static_assert(blas::vmath::select_kernel<float>() == VmathKernel::simd, "float must select the simd kernel");
+	static_assert(blas::vmath::select_kernel<fp32>() == VmathKernel::simd, "fp32 must select the simd kernel");
+	static_assert(blas::vmath::select_kernel<half>() == VmathKernel::table, "half must select the table kernel");
+	static_assert(blas::vmath::select_kernel<cfloat<32, 8, uint32_t, false, false, false>>() == VmathKernel::parallel, "fp32 without subnormals must select the parallel kernel");
+	static_assert(blas::vmath::select_kernel<bfloat16>() == VmathKernel::simd, "bfloat16 must select the simd kernel");
+	static_assert(blas::vmath::select_kernel<posit<16, 1>>() == VmathKernel::table, "posit<16,1> must select the table kernel");
+	static_assert(blas::vmath::select_kernel<cfloat<12, 8, uint16_t, true, true, false>>() == VmathKernel::table, "cfloat<12,8> with supernormals must select the table kernel");
+	static_assert(blas::vmath::select_kernel<posit<32, 2>>() == VmathKernel::parallel, "posit<32,2> must select the parallel kernel");
+	static_assert(blas::vmath::select_kernel<fp64>() == VmathKernel::parallel, "fp64 must select the parallel kernel");
+
+#if MANUAL_TESTING
+
+	blas::vector<float> x = { 0.5f, 1.0f, 2.0f, 100.0f };
+	std::cout << blas::exp(x) << '\n' << blas::sigmoid(x) << '\n' << blas::rsqrt(x) << '\n';
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	constexpr size_t N = 1000;
+	nrOfFailedTestCases += VerifyFunction<VmathFunction::exp>(reportTestCases, N);
+	nrOfFailedTestCases += VerifyFunction<VmathFunction::log>(reportTestCases, N);
+	nrOfFailedTestCases += VerifyFunction<VmathFunction::tanh>(reportTestCases, N);
+	nrOfFailedTestCases += VerifyFunction<VmathFunction::sigmoid>(reportTestCases, N);
+	nrOfFailedTestCases += VerifyFunction<VmathFunction::sqrt>(reportTestCases, N);
+	nrOfFailedTestCases += VerifyFunction<VmathFunction::rsqrt>(reportTestCases, N);
+	nrOfFailedTestCases += VerifyFunction<VmathFunction::sin>(reportTestCases, N);
+	nrOfFailedTestCases += VerifyFunction<VmathFunction::cos>(reportTestCases, N);
+#endif
+
+#if REGRESSION_LEVEL_2
+#endif
+
+#if REGRESSION_LEVEL_3
+#endif
+
+#if REGRESSION_LEVEL_4
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught ad-hoc exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Caught unexpected universal arithmetic exception : " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Caught unexpected universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << '\n';
+	return EXIT_FAILURE;
+}
@@ -6,6 +6,7 @@
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 
 #include <universal/utility/directives.hpp>
+#include <random>
 //#define ALGORITHM_VERBOSE_OUTPUT 1
 //#define ALGORITHM_TRACE_SQRT 1
 #include <universal/number/algorithm/newtons_iteration.hpp>
@@ -48,8 +49,34 @@ void GenerateTestCase(Ty x, Ty y, Ty z) {
 	std::cout << std::setprecision(precision);
 }
 
+namespace sw { namespace universal {
+
+	// compare the cfloat fma against the IEEE-754 fma of the equivalent native type
+	template<typename Cfloat, typename Real>
+	int VerifyFmaAgainstNative(bool reportTestCases, unsigned nrRandoms) {
+		std::mt19937_64 engine(42);
+		std::uniform_real_distribution<Real> significant(-1.0, 1.0);
+		std::uniform_int_distribution<int> exponent(-24, 24);
+		int nrOfFailedTests = 0;
+		for (unsigned i = 0; i < nrRandoms; ++i) {
+			Real x = std::ldexp(significant(engine), exponent(engine));
+			Real y = std::ldexp(significant(engine), exponent(engine));
+			Real z = std::ldexp(significant(engine), exponent(engine));
+			Cfloat cx(x), cy(y), cz(z), cfma, cref;
+			cfma = sw::universal::fma(cx, cy, cz);
+			cref = std::fma(x, y, z);
+			if (cfma != cref) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL fma(" << to_binary(cx) << ", " << to_binary(cy) << ", " << to_binary(cz) << ") = " << to_binary(cfma) << " reference " << to_binary(cref) << '\n';
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+}} // namespace sw::universal
+
 // Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
-#define MANUAL_TESTING 1
+#define MANUAL_TESTING 0
 // REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
 // It is the responsibility of the regression test to organize the tests in a quartile progression.
 //#undef REGRESSION_LEVEL_OVERRIDE
@@ -103,19 +130,32 @@ try {
 #else
 
 #if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatFma< cfloat<4, 1, uint8_t, true, true, isSaturating> >(reportTestCases), "cfloat<4,1,sub+normal+super>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatFma< cfloat<5, 2, uint8_t, hasSubnormals, hasSupernormals, isSaturating> >(reportTestCases), "cfloat<5,2>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatFma< cfloat<6, 2, uint8_t, hasSubnormals, hasSupernormals, isSaturating> >(reportTestCases), "cfloat<6,2>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatFma< cfloat<6, 3, uint8_t, true, false, isSaturating> >(reportTestCases), "cfloat<6,3,sub+normal>", test_tag);
 
+	nrOfFailedTestCases += ReportTestResult(VerifyFmaAgainstNative< cfloat<32, 8, uint32_t, true, false, false>, float >(reportTestCases, 10000), "cfloat<32,8,sub+normal>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyFmaAgainstNative< cfloat<64, 11, uint32_t, true, false, false>, double >(reportTestCases, 10000), "cfloat<64,11,sub+normal>", test_tag);
 #endif
 
 #if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatFma< cfloat<7, 2, uint8_t, hasSubnormals, hasSupernormals, isSaturating> >(reportTestCases), "cfloat<7,2>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatFma< cfloat<7, 3, uint8_t, true, true, isSaturating> >(reportTestCases), "cfloat<7,3,sub+normal+super>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatFma< cfloat<7, 2, uint8_t, true, false, true> >(reportTestCases), "cfloat<7,2,sub+normal+sat>", test_tag);
 
+	nrOfFailedTestCases += ReportTestResult(VerifyFmaAgainstNative< cfloat<32, 8, uint8_t, true, false, false>, float >(reportTestCases, 10000), "cfloat<32,8,uint8_t,sub+normal>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyFmaAgainstNative< cfloat<64, 11, uint64_t, true, false, false>, double >(reportTestCases, 10000), "cfloat<64,11,uint64_t,sub+normal>", test_tag);
 #endif
 
 #if REGRESSION_LEVEL_3
-
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatFma< cfloat<8, 2, uint8_t, hasSubnormals, hasSupernormals, isSaturating> >(reportTestCases), "cfloat<8,2>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatFma< cfloat<8, 4, uint8_t, true, false, isSaturating> >(reportTestCases), "cfloat<8,4,sub+normal>", test_tag);
 #endif
 
 #if REGRESSION_LEVEL_4
-
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatFma< cfloat<8, 3, uint8_t, true, true, isSaturating> >(reportTestCases), "cfloat<8,3,sub+normal+super>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyFmaAgainstNative< cfloat<64, 11, uint8_t, true, false, false>, double >(reportTestCases, 100000), "cfloat<64,11,uint8_t,sub+normal>", test_tag);
 #endif // REGRESSION_LEVEL_4
 
 	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
@@ -0,0 +1,169 @@
+// sqrt.cpp: test suite runner for the correctly rounded square root and reciprocal square root of cfloat
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <random>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/verification/test_suite.hpp>
+#include <universal/verification/cfloat_test_suite.hpp>
+
+/*
+   The native square root is a digit recurrence on the significant that delivers
+   guard, round, and sticky bits to the cfloat rounding stage. The references:
+   - cfloats of up to 16 bits are enumerated against double precision, which has
+     more than 2p+2 bits and thus rounds the root correctly a second time
+   - single and double precision cfloats are compared bit for bit against std::sqrt
+   - wider cfloats are bracketed: r is the correctly rounded root of x when x lies
+     between the squares of the midpoints to its neighbors, which are exact in a
+     cfloat with twice the precision
+*/
+
+namespace sw { namespace universal {
+
+	// compare the cfloat sqrt against the IEEE-754 sqrt of the equivalent native type
+	template<typename Cfloat, typename Real, typename RawBits>
+	int VerifySqrtAgainstNative(bool reportTestCases, unsigned nrRandoms) {
+		std::mt19937_64 engine(42);
+		int nrOfFailedTests = 0;
+		for (unsigned i = 0; i < nrRandoms; ++i) {
+			Cfloat a, result, ref;
+			a.setbits(static_cast<RawBits>(engine()) & ~(RawBits(1) << (Cfloat::nbits - 1)));  // positive values
+			if (a.isnan() || a.isinf()) continue;
+			result = sw::universal::sqrt(a);
+			ref = std::sqrt(Real(a));
+			if (result != ref) {
+				++nrOfFailedTests;
+				if (reportTestCases) ReportUnaryArithmeticError("FAIL", "sqrt", a, result, ref);
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	// bracket the root between the midpoints to its neighbors: (r - ulp/2)^2 < x < (r + ulp/2)^2
+	template<typename Cfloat, typename Wide>
+	int VerifySqrtBracket(bool reportTestCases, unsigned nrRandoms) {
+		std::mt19937_64 engine(42);
+		std::uniform_real_distribution<double> value(0.0, 1.0e6), fraction(0.0, 1.0);
+		int nrOfFailedTests = 0;
+		for (unsigned i = 0; i < nrRandoms; ++i) {
+			// a value with a full significant
+			Cfloat a = Cfloat(value(engine)) + Cfloat(fraction(engine)) * Cfloat(std::ldexp(1.0, -60));
+			if (a.iszero()) continue;
+			Cfloat r = sw::universal::sqrt(a);
+			Cfloat below(r), above(r);
+			--below;
+			++above;
+			Wide lower = (Wide(below) + Wide(r)) / Wide(2.0);
+			Wide upper = (Wide(r) + Wide(above)) / Wide(2.0);
+			Wide x(a);
+			if (!(lower * lower <= x && x <= upper * upper)) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL sqrt(" << to_binary(a) << ") = " << to_binary(r) << " is not the correctly rounded root\n";
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "cfloat sqrt and rsqrt validation";
+	std::string test_tag    = "sqrt";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	using Cfloat = cfloat<16, 5, std::uint16_t, true, false, false>;
+	Cfloat a(2.0);
+	std::cout << "sqrt(" << a << ")  = " << sqrt(a) << " : " << to_binary(sqrt(a)) << '\n';
+	std::cout << "rsqrt(" << a << ") = " << rsqrt(a) << " : " << to_binary(rsqrt(a)) << '\n';
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatSqrt< cfloat<8, 2, std::uint8_t, true, false, false> >(reportTestCases), "cfloat<8,2,sub+normal>", "sqrt");
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS;   // ignore errors
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatSqrt< cfloat< 8, 2, std::uint8_t, true,  false, false> >(reportTestCases), "cfloat< 8,2,sub+normal>", "sqrt");
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatSqrt< cfloat< 8, 3, std::uint8_t, true,  true,  false> >(reportTestCases), "cfloat< 8,3,sub+normal+super>", "sqrt");
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatSqrt< cfloat< 8, 4, std::uint8_t, false, false, false> >(reportTestCases), "cfloat< 8,4,normal>", "sqrt");
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatSqrt< cfloat< 8, 2, std::uint8_t, true,  false, true > >(reportTestCases), "cfloat< 8,2,sub+normal+sat>", "sqrt");
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatSqrt< cfloat<12, 4, std::uint8_t, true,  false, false> >(reportTestCases), "cfloat<12,4,sub+normal>", "sqrt");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatRsqrt< cfloat< 8, 2, std::uint8_t, true,  false, false> >(reportTestCases), "cfloat< 8,2,sub+normal>", "rsqrt");
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatRsqrt< cfloat< 8, 3, std::uint8_t, true,  true,  false> >(reportTestCases), "cfloat< 8,3,sub+normal+super>", "rsqrt");
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatRsqrt< cfloat<12, 4, std::uint8_t, true,  false, false> >(reportTestCases), "cfloat<12,4,sub+normal>", "rsqrt");
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatSqrt< cfloat<16, 5, std::uint16_t, true,  false, false> >(reportTestCases), "cfloat<16,5,sub+normal>", "sqrt");
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatSqrt< cfloat<16, 8, std::uint16_t, true,  false, false> >(reportTestCases), "cfloat<16,8,sub+normal>", "sqrt");
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatSqrt< cfloat<16, 5, std::uint8_t,  true,  true,  false> >(reportTestCases), "cfloat<16,5,sub+normal+super>", "sqrt");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatRsqrt< cfloat<16, 5, std::uint16_t, true,  false, false> >(reportTestCases), "cfloat<16,5,sub+normal>", "rsqrt");
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatRsqrt< cfloat<16, 8, std::uint16_t, true,  false, false> >(reportTestCases), "cfloat<16,8,sub+normal>", "rsqrt");
+
+	nrOfFailedTestCases += ReportTestResult(VerifySqrtAgainstNative< cfloat<32, 8, std::uint32_t, true, false, false>, float, std::uint32_t >(reportTestCases, 100000), "cfloat<32,8,sub+normal>", "sqrt");
+	nrOfFailedTestCases += ReportTestResult(VerifySqrtAgainstNative< cfloat<64, 11, std::uint64_t, true, false, false>, double, std::uint64_t >(reportTestCases, 10000), "cfloat<64,11,sub+normal>", "sqrt");
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifySqrtBracket< cfloat<80, 11, std::uint64_t, true, false, false>, cfloat<160, 11, std::uint64_t, true, false, false> >(reportTestCases, 1000), "cfloat<80,11,sub+normal>", "sqrt");
+	nrOfFailedTestCases += ReportTestResult(VerifySqrtBracket< cfloat<128, 15, std::uint64_t, true, false, false>, cfloat<256, 15, std::uint64_t, true, false, false> >(reportTestCases, 1000), "cfloat<128,15,sub+normal>", "sqrt");
+#endif
+
+#if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatSqrt< cfloat<16, 2, std::uint16_t, true,  false, false> >(reportTestCases), "cfloat<16,2,sub+normal>", "sqrt");
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatRsqrt< cfloat<16, 2, std::uint16_t, true,  false, false> >(reportTestCases), "cfloat<16,2,sub+normal>", "rsqrt");
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught ad-hoc exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Caught unexpected universal arithmetic exception : " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Caught unexpected universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Caught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
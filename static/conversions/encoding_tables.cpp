@@ -0,0 +1,197 @@
+// encoding_tables.cpp: test suite for the exhaustive encode/decode tables of small number systems
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <random>
+#include <vector>
+#include <universal/number/posit/posit.hpp>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/lns/lns.hpp>
+#include <universal/number/takum/takum.hpp>
+#include <universal/verification/test_suite.hpp>
+
+namespace sw { namespace universal {
+
+	bool SameDouble(double a, double b) {
+		if (std::isnan(a) || std::isnan(b)) return std::isnan(a) && std::isnan(b);
+		std::uint64_t ua, ub;
+		std::memcpy(&ua, &a, sizeof(ua));
+		std::memcpy(&ub, &b, sizeof(ub));
+		return ua == ub;
+	}
+
+	// the decode table must be bit-identical to the conversion of the number system for every encoding
+	template<typename Number>
+	int VerifyDecodeTable(bool reportTestCases) {
+		using traits = encoding_table_traits<Number>;
+		constexpr std::size_t NR_ENCODINGS = std::size_t(1) << Number::nbits;
+		int nrOfFailedTestCases = 0;
+		Number a;
+		for (std::size_t i = 0; i < NR_ENCODINGS; ++i) {
+			a.setbits(i);
+			double reference = traits::decode(a);
+			double result = double(a);
+			if (!SameDouble(result, reference)) {
+				++nrOfFailedTestCases;
+				if (reportTestCases) ReportConversionError("FAIL", "decode", reference, a, result);
+			}
+		}
+		return nrOfFailedTestCases;
+	}
+
+	// the encode table must select the same encoding as the conversion of the number system
+	// on both sides of every rounding threshold, at every value, and at random samples
+	template<typename Number>
+	int VerifyEncodeTable(bool reportTestCases, unsigned nrRandoms = 10000) {
+		using traits = encoding_table_traits<Number>;
+		constexpr std::size_t NR_ENCODINGS = std::size_t(1) << Number::nbits;
+		int nrOfFailedTestCases = 0;
+		auto check = [&](double v) {
+			Number reference(v);
+			Number result = encoding_table<Number>::from_double(v);
+			if (traits::encoding(result) != traits::encoding(reference)) {
+				++nrOfFailedTestCases;
+				if (reportTestCases) ReportConversionError("FAIL", "encode", v, result, double(reference));
+			}
+		};
+		for (double t : encoding_table<Number>::thresholds()) {
+			check(t);
+			check(std::nextafter(t, -INFINITY));
+			check(std::nextafter(t, +INFINITY));
+		}
+		Number a;
+		for (std::size_t i = 0; i < NR_ENCODINGS; ++i) {
+			a.setbits(i);
+			check(double(a));
+		}
+		Number maxpos(SpecificValue::maxpos), minpos(SpecificValue::minpos);
+		std::mt19937_64 generator;
+		std::uniform_real_distribution<double> logscale(std::log2(double(minpos)) - 2.0, std::log2(double(maxpos)) + 2.0);
+		for (unsigned i = 0; i < nrRandoms; ++i) {
+			double v = std::exp2(logscale(generator));
+			check(v);
+			check(-v);
+		}
+		return nrOfFailedTestCases;
+	}
+
+	// the bulk converters must round-trip every encoding the conversion produces
+	template<typename Number>
+	int VerifyBulkConversion(bool reportTestCases) {
+		using traits = encoding_table_traits<Number>;
+		constexpr std::size_t NR_ENCODINGS = std::size_t(1) << Number::nbits;
+		int nrOfFailedTestCases = 0;
+		std::vector<Number> src(NR_ENCODINGS), dst(NR_ENCODINGS);
+		std::vector<double> values(NR_ENCODINGS);
+		for (std::size_t i = 0; i < NR_ENCODINGS; ++i) src[i].setbits(i);
+		convert_to_double(src.data(), values.data(), NR_ENCODINGS);
+		convert_from_double(values.data(), dst.data(), NR_ENCODINGS);
+		for (std::size_t i = 0; i < NR_ENCODINGS; ++i) {
+			Number reference(traits::decode(src[i]));
+			if (!SameDouble(values[i], traits::decode(src[i])) || traits::encoding(dst[i]) != traits::encoding(reference)) {
+				++nrOfFailedTestCases;
+				if (reportTestCases) ReportConversionError("FAIL", "bulk", values[i], dst[i], double(reference));
+			}
+		}
+		return nrOfFailedTestCases;
+	}
+
+	template<typename Number>
+	int VerifyEncodingTable(bool reportTestCases) {
+		return VerifyDecodeTable<Number>(reportTestCases) + VerifyEncodeTable<Number>(reportTestCases) + VerifyBulkConversion<Number>(reportTestCases);
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "encoding table verification";
+	std::string test_tag    = "encoding table";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	using Posit = posit<16, 2>;
+	Posit p(1.0);
+	std::cout << "thresholds around 1.0 : ";
+	for (double t : encoding_table<Posit>::thresholds()) if (t > 0.999 && t < 1.001) std::cout << std::setprecision(17) << t << ' ';
+	std::cout << '\n';
+
+	nrOfFailedTestCases += ReportTestResult(VerifyEncodingTable< posit<8, 2> >(true), "posit< 8,2>", test_tag);
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyEncodingTable< posit<8, 0> >(reportTestCases), "posit< 8,0>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyEncodingTable< posit<8, 2> >(reportTestCases), "posit< 8,2>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyEncodingTable< cfloat<8, 2, std::uint8_t, true, false, false> >(reportTestCases), "cfloat< 8,2,sub>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyEncodingTable< cfloat<8, 4, std::uint8_t, false, false, false> >(reportTestCases), "cfloat< 8,4>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyEncodingTable< cfloat<8, 3, std::uint8_t, true, true, true> >(reportTestCases), "cfloat< 8,3,sub,super,sat>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyEncodingTable< lns<8, 3> >(reportTestCases), "lns< 8,3>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyEncodingTable< takum<8> >(reportTestCases), "takum< 8>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyEncodingTable< posit<12, 1> >(reportTestCases), "posit<12,1>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyEncodingTable< cfloat<12, 5, std::uint16_t, true, false, false> >(reportTestCases), "cfloat<12,5,sub>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyEncodingTable< lns<12, 6, std::uint16_t> >(reportTestCases), "lns<12,6>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyEncodingTable< takum<12, std::uint16_t> >(reportTestCases), "takum<12>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyEncodingTable< posit<16, 2> >(reportTestCases), "posit<16,2>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyEncodingTable< cfloat<16, 5, std::uint16_t, true, false, false> >(reportTestCases), "cfloat<16,5,sub>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyEncodingTable< cfloat<16, 8, std::uint8_t, true, false, false> >(reportTestCases), "cfloat<16,8,sub>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyEncodingTable< cfloat<16, 5, std::uint16_t, false, false, true> >(reportTestCases), "cfloat<16,5,sat>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += ReportTestResult(VerifyEncodingTable< lns<16, 8, std::uint16_t> >(reportTestCases), "lns<16,8>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyEncodingTable< takum<16, std::uint16_t> >(reportTestCases), "takum<16>", test_tag);
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -6,62 +6,11 @@
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 #include <universal/utility/directives.hpp>
 #include <universal/number/dbns/dbns.hpp>
-//#include <universal/verification/test_suite.hpp>    // there is a generic VerifyAddition there: we need a trait to break template match
-// in the mean time: explicity bring in the dependencies to get the test running
-#include <universal/verification/test_status.hpp>
 #include <universal/verification/test_case.hpp>
-#include <universal/verification/test_reporters.hpp>
-
-namespace sw { namespace universal {
-
-	//template<typename DbnsType,
-	//	std::enable_if_t<is_dbns<DbnsType>, DbnsType> = 0
-	//>
-	template<typename DbnsType>
-	int VerifyAddition(bool reportTestCases) {
-		constexpr size_t nbits = DbnsType::nbits;
-		//constexpr size_t rbits = DbnsType::rbits;
-		//constexpr Behavior behavior = DbnsType::behavior;
-		//using bt = typename DbnsType::BlockType;
-		constexpr size_t NR_ENCODINGS = (1ull << nbits);
-		int nrOfFailedTestCases = 0;
-
-		if constexpr (bCollectDbnsEventStatistics) dbnsStats.reset();
-
-		DbnsType a, b, c, cref;
-		for (size_t i = 0; i < NR_ENCODINGS; ++i) {
-			a.setbits(i);
-			double da = double(a);
-			for (size_t j = 0; j < NR_ENCODINGS; ++j) {
-				b.setbits(j);
-				double db = double(b);
-
-				double ref = da + db;
-//				if (reportTestCases && !isInRange<DbnsType>(ref)) {
-//					std::cerr << da << " * " << db << " = " << ref << " which is not in range " << range(a) << '\n';
-//				}
-				c = a + b;
-				cref = ref;
-				if (c != cref) {
-					if (c.isnan() && cref.isnan()) continue; // NaN non-equivalence
-					++nrOfFailedTestCases;
-					if (reportTestCases) ReportBinaryArithmeticError("FAIL", "+", a, b, c, cref);
-				}
-				else {
-					// if (reportTestCases) ReportBinaryArithmeticSuccess("PASS", "+", a, b, c, ref);
-				}
-				if (nrOfFailedTestCases > 24) return nrOfFailedTestCases;
-			}
-		}
-		if constexpr (bCollectDbnsEventStatistics) if (reportTestCases) std::cout << dbnsStats << '\n';
-		return nrOfFailedTestCases;
-	}
-
-} }  // namespace sw::universal
-
+#include <universal/verification/dbns_test_suite.hpp>
 
 // Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
-#define MANUAL_TESTING 1
+#define MANUAL_TESTING 0
 // REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
 // It is the responsibility of the regression test to organize the tests in a quartile progression.
 //#undef REGRESSION_LEVEL_OVERRIDE
@@ -110,18 +59,18 @@ try {
 #endif
 
 	reportTestCases = true;
-	nrOfFailedTestCases += ReportTestResult(VerifyAddition<DBNS4_1_sat>(reportTestCases), "dbns<4,1,uint8_t>", test_tag);
-	nrOfFailedTestCases += ReportTestResult(VerifyAddition<DBNS4_2_sat>(reportTestCases), "dbns<4,2,uint8_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyDbnsAddition<DBNS4_1_sat>(reportTestCases), "dbns<4,1,uint8_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyDbnsAddition<DBNS4_2_sat>(reportTestCases), "dbns<4,2,uint8_t>", test_tag);
 
-	nrOfFailedTestCases += ReportTestResult(VerifyAddition<DBNS5_2_sat>(reportTestCases), "dbns<5,2,uint8_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyDbnsAddition<DBNS5_2_sat>(reportTestCases), "dbns<5,2,uint8_t>", test_tag);
 
-	nrOfFailedTestCases += ReportTestResult(VerifyAddition<DBNS6_2_sat>(reportTestCases), "dbns<6,2,uint8_t>", test_tag);
-	nrOfFailedTestCases += ReportTestResult(VerifyAddition<DBNS6_3_sat>(reportTestCases), "dbns<6,3,uint8_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyDbnsAddition<DBNS6_2_sat>(reportTestCases), "dbns<6,2,uint8_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyDbnsAddition<DBNS6_3_sat>(reportTestCases), "dbns<6,3,uint8_t>", test_tag);
 
-	nrOfFailedTestCases += ReportTestResult(VerifyAddition<DBNS7_3_sat>(reportTestCases), "dbns<7,3,uint8_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyDbnsAddition<DBNS7_3_sat>(reportTestCases), "dbns<7,3,uint8_t>", test_tag);
 
-	nrOfFailedTestCases += ReportTestResult(VerifyAddition<DBNS8_3_sat>(reportTestCases), "dbns<8,3,uint8_t>", test_tag);
-	nrOfFailedTestCases += ReportTestResult(VerifyAddition<DBNS8_4_sat>(reportTestCases), "dbns<8,4,uint8_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyDbnsAddition<DBNS8_3_sat>(reportTestCases), "dbns<8,3,uint8_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyDbnsAddition<DBNS8_4_sat>(reportTestCases), "dbns<8,4,uint8_t>", test_tag);
 
 	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
 	return EXIT_SUCCESS;
@@ -138,33 +87,43 @@ try {
 	using DBNS8_4_sat = dbns<8, 4, std::uint8_t, Behavior::Saturating>;
 
 
-	nrOfFailedTestCases += ReportTestResult(VerifyAddition<DBNS4_1_sat>(reportTestCases), "dbns<4,1,uint8_t>", test_tag);
-	nrOfFailedTestCases += ReportTestResult(VerifyAddition<DBNS4_2_sat>(reportTestCases), "dbns<4,2,uint8_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyDbnsAddition<DBNS4_1_sat>(reportTestCases), "dbns<4,1,uint8_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyDbnsAddition<DBNS4_2_sat>(reportTestCases), "dbns<4,2,uint8_t>", test_tag);
 	
-	nrOfFailedTestCases += ReportTestResult(VerifyAddition<DBNS5_2_sat>(reportTestCases), "dbns<5,2,uint8_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyDbnsAddition<DBNS5_2_sat>(reportTestCases), "dbns<5,2,uint8_t>", test_tag);
 
-	nrOfFailedTestCases += ReportTestResult(VerifyAddition<DBNS6_2_sat>(reportTestCases), "dbns<6,2,uint8_t>", test_tag);
-	nrOfFailedTestCases += ReportTestResult(VerifyAddition<DBNS6_3_sat>(reportTestCases), "dbns<6,3,uint8_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyDbnsAddition<DBNS6_2_sat>(reportTestCases), "dbns<6,2,uint8_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyDbnsAddition<DBNS6_3_sat>(reportTestCases), "dbns<6,3,uint8_t>", test_tag);
 
-	nrOfFailedTestCases += ReportTestResult(VerifyAddition<DBNS7_3_sat>(reportTestCases), "dbns<7,3,uint8_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyDbnsAddition<DBNS7_3_sat>(reportTestCases), "dbns<7,3,uint8_t>", test_tag);
 	
-	nrOfFailedTestCases += ReportTestResult(VerifyAddition<DBNS8_3_sat>(reportTestCases), "dbns<8,3,uint8_t>", test_tag);
-	nrOfFailedTestCases += ReportTestResult(VerifyAddition<DBNS8_4_sat>(reportTestCases), "dbns<8,4,uint8_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyDbnsAddition<DBNS8_3_sat>(reportTestCases), "dbns<8,3,uint8_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyDbnsAddition<DBNS8_4_sat>(reportTestCases), "dbns<8,4,uint8_t>", test_tag);
 
 #endif
 
 #if REGRESSION_LEVEL_2
-	using DBNS9_4_sat = dbns<9, 4, std::uint8_t>;
-	using DBNS10_4_sat = dbns<10, 4, std::uint8_t>;
+	using DBNS9_4 = dbns<9, 4, std::uint8_t>;
+	using DBNS10_4 = dbns<10, 4, std::uint16_t>;
+	using DBNS10_6 = dbns<10, 6, std::uint16_t>;
 
-	nrOfFailedTestCases += ReportTestResult(VerifyAddition<DBNS9_4_sat>(reportTestCases), "dbns<9,4,uint8_t>", test_tag);
-	nrOfFailedTestCases += ReportTestResult(VerifyAddition<DBNS10_4_sat>(reportTestCases), "dbns<10,4,uint8_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyDbnsAddition<DBNS9_4>(reportTestCases), "dbns<9,4,uint8_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyDbnsAddition<DBNS10_4>(reportTestCases), "dbns<10,4,uint16_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyDbnsAddition<DBNS10_6>(reportTestCases), "dbns<10,6,uint16_t>", test_tag);
 #endif
 
 #if REGRESSION_LEVEL_3
+	using DBNS11_5 = dbns<11, 5, std::uint16_t>;
+
+	nrOfFailedTestCases += ReportTestResult(VerifyDbnsAddition<DBNS11_5>(reportTestCases), "dbns<11,5,uint16_t>", test_tag);
 #endif
 
 #if REGRESSION_LEVEL_4
+	using DBNS12_4 = dbns<12, 4, std::uint16_t>;
+	using DBNS12_7 = dbns<12, 7, std::uint16_t>;
+
+	nrOfFailedTestCases += ReportTestResult(VerifyDbnsAddition<DBNS12_4>(reportTestCases), "dbns<12,4,uint16_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyDbnsAddition<DBNS12_7>(reportTestCases), "dbns<12,7,uint16_t>", test_tag);
 #endif
 
 	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
@@ -0,0 +1,128 @@
+// fma.cpp: test suite runner for fixed-point fused multiply-add
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+
+// Configure the fixpnt template environment
+// first: enable general or specialized fixed-point configurations
+#define FIXPNT_FAST_SPECIALIZATION
+// second: enable/disable fixpnt arithmetic exceptions
+#define FIXPNT_THROW_ARITHMETIC_EXCEPTION 0
+#include <universal/number/fixpnt/fixpnt.hpp>
+#include <universal/verification/fixpnt_test_suite.hpp>
+
+// generate specific test case that you can trace with the trace conditions in fixed_point.hpp
+template<unsigned nbits, unsigned rbits, bool arithmetic, typename bt, typename Ty>
+void GenerateTestCase(Ty _a, Ty _b, Ty _c) {
+	sw::universal::fixpnt<nbits, rbits, arithmetic, bt> a, b, c, cref, result, unfused;
+	a = _a;
+	b = _b;
+	c = _c;
+	result = fma(a, b, c);
+	unfused = a * b + c;
+	Ty ref = std::fma(Ty(a), Ty(b), Ty(c));
+	cref = ref;
+	std::streamsize oldPrecision = std::cout.precision();
+	std::cout << std::setprecision(nbits - 2);
+	std::cout << a << " * " << b << " + " << c << " = " << result << " (reference: " << cref << ", unfused: " << unfused << ")   ";
+	std::cout << (cref == result ? "PASS" : "FAIL") << '\n';
+	std::cout << to_binary(a) << " * " << to_binary(b) << " + " << to_binary(c) << " = " << to_binary(result) << " (reference: " << to_binary(cref) << ")\n\n";
+	std::cout << std::dec << std::setprecision(oldPrecision);
+}
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "fixed-point fused multiply-add";
+	std::string test_tag    = "fma";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	// the product 0.0625 * 0.5 rounds away in the unfused path, but contributes to the rounding of the fma
+	GenerateTestCase<8, 4, Modulo, uint8_t>(0.0625f, 0.5f, 1.0f);
+	GenerateTestCase<8, 4, Modulo, uint8_t>(0.1875f, 0.5f, 1.0f);
+	GenerateTestCase<8, 4, Saturate, uint8_t>(7.5f, 7.5f, -1.0f);
+
+	nrOfFailedTestCases += ReportTestResult(VerifyFma<4, 2, Modulo, uint8_t>(reportTestCases), "fixpnt< 4, 2,Modulo,uint8_t >", test_tag);
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyFma< 4, 0, Modulo, uint8_t>(reportTestCases), "fixpnt< 4, 0,Modulo,uint8_t >", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyFma< 4, 2, Modulo, uint8_t>(reportTestCases), "fixpnt< 4, 2,Modulo,uint8_t >", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyFma< 4, 4, Modulo, uint8_t>(reportTestCases), "fixpnt< 4, 4,Modulo,uint8_t >", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyFma< 6, 3, Modulo, uint8_t>(reportTestCases), "fixpnt< 6, 3,Modulo,uint8_t >", test_tag);
+
+	nrOfFailedTestCases += ReportTestResult(VerifyFma< 4, 2, Saturate, uint8_t>(reportTestCases), "fixpnt< 4, 2,Saturate,uint8_t >", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyFma< 6, 3, Saturate, uint8_t>(reportTestCases), "fixpnt< 6, 3,Saturate,uint8_t >", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyFma< 8, 0, Modulo, uint8_t>(reportTestCases), "fixpnt< 8, 0,Modulo,uint8_t >", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyFma< 8, 4, Modulo, uint8_t>(reportTestCases), "fixpnt< 8, 4,Modulo,uint8_t >", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyFma< 8, 8, Modulo, uint8_t>(reportTestCases), "fixpnt< 8, 8,Modulo,uint8_t >", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyFma< 8, 4, Saturate, uint8_t>(reportTestCases), "fixpnt< 8, 4,Saturate,uint8_t >", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyFma< 8, 4, Modulo, uint16_t>(reportTestCases), "fixpnt< 8, 4,Modulo,uint16_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyFma< 8, 7, Saturate, uint8_t>(reportTestCases), "fixpnt< 8, 7,Saturate,uint8_t >", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += ReportTestResult(VerifyFma< 9, 4, Modulo, uint8_t>(reportTestCases), "fixpnt< 9, 4,Modulo,uint8_t >", test_tag);
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::fixpnt_arithmetic_exception& err) {
+	std::cerr << "Uncaught fixpnt arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::fixpnt_internal_exception& err) {
+	std::cerr << "Uncaught fixpnt internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
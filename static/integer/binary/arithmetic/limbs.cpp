@@ -0,0 +1,175 @@
+// limbs.cpp: verification of integer arithmetic on uint64_t limbs against the same arithmetic on uint32_t limbs
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <random>
+// configure the integer arithmetic class
+#define INTEGER_THROW_ARITHMETIC_EXCEPTION 0
+#include <universal/number/integer/integer.hpp>
+#include <universal/verification/test_suite.hpp>
+
+/*
+   integer<nbits, uint64_t> composes its arithmetic out of 64-bit limbs with a 128-bit
+   widening multiply and an explicit carry out. The reference is the same integer on
+   32-bit limbs, for which the carry and the upper half of the partial product fit in a
+   uint64_t. The random operands are drawn limb by limb from {0, all ones, random} so that
+   long carry and borrow chains are exercised.
+*/
+
+namespace sw { namespace universal {
+
+	template<unsigned nbits>
+	void CopyLimbs(const integer<nbits, std::uint32_t>& src, integer<nbits, std::uint64_t>& tgt) {
+		for (unsigned i = 0; i < integer<nbits, std::uint64_t>::nrBlocks; ++i) {
+			std::uint64_t lo = src.block(2 * i);
+			std::uint64_t hi = src.block(2 * i + 1);
+			tgt.setblock(i, (hi << 32) | lo);
+		}
+	}
+
+	template<unsigned nbits>
+	bool SameLimbs(const integer<nbits, std::uint32_t>& ref, const integer<nbits, std::uint64_t>& result) {
+		integer<nbits, std::uint64_t> r;
+		CopyLimbs(ref, r);
+		return r == result;
+	}
+
+	template<unsigned nbits, typename RandomEngine>
+	integer<nbits, std::uint32_t> RandomLimbs(RandomEngine& engine) {
+		using Reference = integer<nbits, std::uint32_t>;
+		Reference a;
+		for (unsigned i = 0; i < Reference::nrBlocks; ++i) {
+			std::uint64_t r = engine();
+			std::uint32_t limb = ((r & 0x3) == 0 ? 0u : ((r & 0x3) == 1 ? 0xFFFF'FFFFu : static_cast<std::uint32_t>(r >> 32)));
+			a.setblock(i, (i == Reference::MSU ? limb & Reference::MSU_MASK : limb));
+		}
+		return a;
+	}
+
+	template<unsigned nbits>
+	void ReportLimbError(const std::string& op, const integer<nbits, std::uint64_t>& a, const integer<nbits, std::uint64_t>& b, const integer<nbits, std::uint64_t>& result, const integer<nbits, std::uint32_t>& ref) {
+		std::cerr << "FAIL " << to_hex(a) << ' ' << op << ' ' << to_hex(b) << " = " << to_hex(result) << " reference " << to_hex(ref) << '\n';
+	}
+
+	template<unsigned nbits>
+	int VerifyLimbArithmetic(bool reportTestCases, unsigned nrRandoms) {
+		using Reference = integer<nbits, std::uint32_t>;
+		using Integer   = integer<nbits, std::uint64_t>;
+		std::mt19937_64 engine(nbits);
+		int nrOfFailedTests = 0;
+		for (unsigned n = 0; n < nrRandoms; ++n) {
+			Reference ra = RandomLimbs<nbits>(engine), rb = RandomLimbs<nbits>(engine);
+			Integer a, b;
+			CopyLimbs(ra, a);
+			CopyLimbs(rb, b);
+
+			if (!SameLimbs(Reference(ra + rb), Integer(a + b))) { ++nrOfFailedTests; if (reportTestCases) ReportLimbError("+", a, b, Integer(a + b), Reference(ra + rb)); }
+			if (!SameLimbs(Reference(ra - rb), Integer(a - b))) { ++nrOfFailedTests; if (reportTestCases) ReportLimbError("-", a, b, Integer(a - b), Reference(ra - rb)); }
+			if (!SameLimbs(Reference(ra * rb), Integer(a * b))) { ++nrOfFailedTests; if (reportTestCases) ReportLimbError("*", a, b, Integer(a * b), Reference(ra * rb)); }
+			if (!rb.iszero()) {
+				if (!SameLimbs(Reference(ra / rb), Integer(a / b))) { ++nrOfFailedTests; if (reportTestCases) ReportLimbError("/", a, b, Integer(a / b), Reference(ra / rb)); }
+				if (!SameLimbs(Reference(ra % rb), Integer(a % b))) { ++nrOfFailedTests; if (reportTestCases) ReportLimbError("%", a, b, Integer(a % b), Reference(ra % rb)); }
+			}
+			Reference rc(ra); rc *= rb.block(0);
+			Integer c(a); c *= static_cast<std::uint64_t>(rb.block(0));
+			if (!SameLimbs(rc, c)) { ++nrOfFailedTests; if (reportTestCases) ReportLimbError("*=", a, b, c, rc); }
+			int shift = static_cast<int>(engine() % nbits);
+			if (!SameLimbs(Reference(ra << shift), Integer(a << shift))) { ++nrOfFailedTests; if (reportTestCases) ReportLimbError("<<", a, b, Integer(a << shift), Reference(ra << shift)); }
+			if (!SameLimbs(Reference(ra >> shift), Integer(a >> shift))) { ++nrOfFailedTests; if (reportTestCases) ReportLimbError(">>", a, b, Integer(a >> shift), Reference(ra >> shift)); }
+			if ((ra < rb) != (a < b)) { ++nrOfFailedTests; if (reportTestCases) ReportLimbError("<", a, b, a, ra); }
+			if (to_string(ra) != to_string(a)) { ++nrOfFailedTests; if (reportTestCases) ReportLimbError("to_string", a, b, a, ra); }
+			if (nrOfFailedTests > 25) break;
+		}
+		return nrOfFailedTests;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "Integer arithmetic on uint64_t limbs";
+	std::string test_tag    = "integer<> uint64_t limbs";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	integer<128, std::uint64_t> a, b;
+	a.setblock(0, 0xFFFF'FFFF'FFFF'FFFFull);
+	b = 1;
+	std::cout << to_hex(a) << " + " << to_hex(b) << " = " << to_hex(a + b) << '\n';
+	std::cout << to_hex(a) << " * " << to_hex(a) << " = " << to_hex(a * a) << '\n';
+
+	nrOfFailedTestCases += ReportTestResult(VerifyLimbArithmetic<128>(reportTestCases, 100), "integer<128, uint64_t>", test_tag);
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyLimbArithmetic< 64>(reportTestCases, 1000), "integer< 64, uint64_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyLimbArithmetic< 96>(reportTestCases, 1000), "integer< 96, uint64_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyLimbArithmetic<128>(reportTestCases, 1000), "integer<128, uint64_t>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyLimbArithmetic<160>(reportTestCases, 1000), "integer<160, uint64_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyLimbArithmetic<256>(reportTestCases, 1000), "integer<256, uint64_t>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyLimbArithmetic<500>(reportTestCases, 1000), "integer<500, uint64_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyLimbArithmetic<512>(reportTestCases, 1000), "integer<512, uint64_t>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += ReportTestResult(VerifyLimbArithmetic<1024>(reportTestCases, 1000), "integer<1024, uint64_t>", test_tag);
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught ad-hoc exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Caught unexpected universal arithmetic exception : " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Caught unexpected universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Caught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,193 @@
+// modular.cpp: test runner for Montgomery and Barrett modular multiplication and exponentiation on fixed-sized, arbitrary precision integers
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <random>
+// configure the integer arithmetic class
+#define INTEGER_THROW_ARITHMETIC_EXCEPTION 1
+#include <universal/number/integer/integer.hpp>
+#include <universal/verification/test_suite.hpp>
+
+/*
+   The reference for the modular products is the double-width integer product followed by
+   the remainder, and the reference for modexp is binary square-and-multiply on that product.
+   The moduli are drawn with a random number of significant limbs so that the reductions
+   also run with R = B^k smaller than the integer encoding.
+*/
+
+namespace sw { namespace universal {
+
+	template<typename Integer, typename RandomEngine>
+	Integer RandomValue(RandomEngine& engine, unsigned nrLimbs) {
+		using BlockType = typename Integer::BlockType;
+		Integer a{};
+		for (unsigned i = 0; i < nrLimbs && i < Integer::nrBlocks; ++i) {
+			std::uint64_t r = engine();
+			BlockType limb = ((r & 0x7) == 0 ? BlockType(~BlockType(0)) : static_cast<BlockType>(engine()));
+			a.setblock(i, limb);
+		}
+		a.setbit(Integer::nbits - 1, false);  // non-negative
+		return a;
+	}
+
+	template<unsigned nbits, typename BlockType>
+	integer<nbits, BlockType> ReferenceModMul(const integer<nbits, BlockType>& a, const integer<nbits, BlockType>& b, const integer<nbits, BlockType>& N) {
+		using Wide = integer<2 * nbits, BlockType>;
+		Wide wa(a), wb(b), wN(N);
+		Wide r = (wa * wb) % wN;
+		integer<nbits, BlockType> result;
+		result.bitcopy(r);
+		return result;
+	}
+
+	template<unsigned nbits, typename BlockType>
+	integer<nbits, BlockType> ReferenceModExp(const integer<nbits, BlockType>& base, const integer<nbits, BlockType>& exponent, const integer<nbits, BlockType>& N) {
+		integer<nbits, BlockType> result = integer<nbits, BlockType>(1) % N, x = base % N;
+		for (int i = findMsb(exponent); i >= 0; --i) {
+			result = ReferenceModMul(result, result, N);
+			if (exponent.test(static_cast<unsigned>(i))) result = ReferenceModMul(result, x, N);
+		}
+		return result;
+	}
+
+	template<unsigned nbits, typename BlockType>
+	int VerifyModularArithmetic(bool reportTestCases, unsigned nrRandoms, unsigned exponentLimbs) {
+		using Integer = integer<nbits, BlockType>;
+		constexpr unsigned nrBlocks = Integer::nrBlocks;
+		std::mt19937_64 engine(nbits + sizeof(BlockType));
+		int nrOfFailedTests = 0;
+		for (unsigned n = 0; n < nrRandoms; ++n) {
+			unsigned k = 1 + static_cast<unsigned>(engine() % nrBlocks);
+			Integer N = RandomValue<Integer>(engine, k);
+			if (N.iszero() || N.isone()) continue;
+			Integer a = RandomValue<Integer>(engine, k) % N, b = RandomValue<Integer>(engine, k) % N;
+			Integer e = RandomValue<Integer>(engine, exponentLimbs);
+
+			barrett<Integer> br(N);
+			Integer ref = ReferenceModMul(a, b, N);
+			Integer result = br.mul(a, b);
+			if (result != ref) {
+				++nrOfFailedTests;
+				if (reportTestCases) ReportBinaryArithmeticError("FAIL", "barrett", a, b, result, ref);
+			}
+			Integer expref = ReferenceModExp(a, e, N);
+			result = br.modexp(a, e);
+			if (result != expref) {
+				++nrOfFailedTests;
+				if (reportTestCases) ReportBinaryArithmeticError("FAIL", "barrett modexp", a, e, result, expref);
+			}
+
+			if (N.isodd()) {
+				montgomery<Integer> mont(N);
+				result = mont.from_montgomery(mont.mul(mont.to_montgomery(a), mont.to_montgomery(b)));
+				if (result != ref) {
+					++nrOfFailedTests;
+					if (reportTestCases) ReportBinaryArithmeticError("FAIL", "montgomery", a, b, result, ref);
+				}
+				result = mont.modexp(a, e);
+				if (result != expref) {
+					++nrOfFailedTests;
+					if (reportTestCases) ReportBinaryArithmeticError("FAIL", "montgomery modexp", a, e, result, expref);
+				}
+			}
+			result = modexp(a, e, N);
+			if (result != expref) {
+				++nrOfFailedTests;
+				if (reportTestCases) ReportBinaryArithmeticError("FAIL", "modexp", a, e, result, expref);
+			}
+			if (nrOfFailedTests > 24) break;
+		}
+		return nrOfFailedTests;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "Integer modular arithmetic verification";
+	std::string test_tag    = "modular";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	{
+		using Integer = integer<128, std::uint32_t>;
+		Integer N = 1'000'000'007, a = 3, e = N - 1;  // Fermat: a^(N-1) = 1 mod N for prime N
+		std::cout << "3^(N-1) mod N = " << modexp(a, e, N) << '\n';
+	}
+
+	nrOfFailedTestCases += ReportTestResult(VerifyModularArithmetic<128, std::uint32_t>(true, 100, 2), "integer<128, uint32_t>", test_tag);
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyModularArithmetic< 64, std::uint8_t >(reportTestCases, 500, 8), "integer< 64, uint8_t >", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyModularArithmetic<128, std::uint32_t>(reportTestCases, 500, 4), "integer<128, uint32_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyModularArithmetic<128, std::uint64_t>(reportTestCases, 500, 2), "integer<128, uint64_t>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyModularArithmetic<256, std::uint16_t>(reportTestCases, 200, 4), "integer<256, uint16_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyModularArithmetic<512, std::uint32_t>(reportTestCases, 100, 2), "integer<512, uint32_t>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_3
+	// 32 limbs: at the Karatsuba threshold
+	nrOfFailedTestCases += ReportTestResult(VerifyModularArithmetic<1024, std::uint32_t>(reportTestCases, 50, 2), "integer<1024, uint32_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyModularArithmetic<1024, std::uint64_t>(reportTestCases, 50, 1), "integer<1024, uint64_t>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += ReportTestResult(VerifyModularArithmetic<2048, std::uint64_t>(reportTestCases, 20, 1), "integer<2048, uint64_t>", test_tag);
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught ad-hoc exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Caught unexpected universal arithmetic exception : " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Caught unexpected universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Caught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
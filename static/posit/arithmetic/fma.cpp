@@ -8,6 +8,7 @@
 #include <cstdint>	// uint8_t, etc.
 #include <cmath>	// for frexp/frexpf and std::fma
 #include <cfenv>	// feclearexcept/fetestexcept
+#include <random>
 
 // enable/disable posit arithmetic exceptions
 #define POSIT_THROW_ARITHMETIC_EXCEPTION 0
@@ -35,8 +36,77 @@ void GenerateTestCase(Ty a, Ty b, Ty c) {
 	std::cout << std::setprecision(5);
 }
 
+namespace sw { namespace universal {
+
+	// the quire accumulates a*b + c exactly, and the conversion back to a posit is the single rounding the fma must match
+	template<unsigned nbits, unsigned es>
+	posit<nbits, es> QuireFma(const posit<nbits, es>& a, const posit<nbits, es>& b, const posit<nbits, es>& c) {
+		posit<nbits, es> one(1), result;
+		if (a.isnar() || b.isnar() || c.isnar()) {
+			result.setnar();
+			return result;
+		}
+		if constexpr (es + 2 >= nbits) {
+			// no fraction bits, and thus no quire: the operands are small powers of 2 and double computes a*b + c exactly
+			result = double(a) * double(b) + double(c);
+		}
+		else {
+			quire<nbits, es, 2> q(0);
+			q += quire_mul(a, b);
+			q += quire_mul(c, one);
+			convert(q.to_value(), result);
+		}
+		return result;
+	}
+
+	// enumerate all fma cases of a small posit configuration
+	template<unsigned nbits, unsigned es>
+	int ValidateFMA(const std::string& tag, bool reportTestCases) {
+		constexpr unsigned NR_POSITS = (1u << nbits);
+		int nrOfFailedTests = 0;
+		posit<nbits, es> pa, pb, pc, pfma, pref;
+		for (unsigned i = 0; i < NR_POSITS; ++i) {
+			pa.setbits(i);
+			for (unsigned j = 0; j < NR_POSITS; ++j) {
+				pb.setbits(j);
+				for (unsigned k = 0; k < NR_POSITS; ++k) {
+					pc.setbits(k);
+					pfma = sw::universal::fma(pa, pb, pc);
+					pref = QuireFma(pa, pb, pc);
+					if (pfma != pref) {
+						++nrOfFailedTests;
+						if (reportTestCases) std::cerr << "FAIL " << tag << "(" << pa << ", " << pb << ", " << pc << ") = " << pfma << " reference " << pref << '\n';
+					}
+				}
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	// compare the fma of random operands against the quire reference
+	template<unsigned nbits, unsigned es>
+	int VerifyRandomFma(bool reportTestCases, unsigned nrRandoms) {
+		std::mt19937_64 engine(42);
+		int nrOfFailedTests = 0;
+		posit<nbits, es> pa, pb, pc, pfma, pref;
+		for (unsigned i = 0; i < nrRandoms; ++i) {
+			pa.setbits(engine());
+			pb.setbits(engine());
+			pc.setbits(engine());
+			pfma = sw::universal::fma(pa, pb, pc);
+			pref = QuireFma(pa, pb, pc);
+			if (pfma != pref) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL fma(" << pa << ", " << pb << ", " << pc << ") = " << pfma << " reference " << pref << '\n';
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+}} // namespace sw::universal
+
 // Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
-#define MANUAL_TESTING 1
+#define MANUAL_TESTING 0
 // REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
 // It is the responsibility of the regression test to organize the tests in a quartile progression.
 //#undef REGRESSION_LEVEL_OVERRIDE
@@ -56,7 +126,6 @@ void ReportSizeof();
 void ReportFmaResults();
 void ReportErrors();
 
-// TODO
 int main()
 try {
 	using namespace sw::universal;
@@ -108,16 +177,27 @@ try {
 #else
 
 #if REGRESSION_LEVEL_1
-	nrOfFailedTestCases += ReportTestResult(ValidateFMA<2, 0>(tag, reportTestCases), "posit<2,0>", "fused multiply-accumulate");
+	nrOfFailedTestCases += ReportTestResult(ValidateFMA<2, 0>(test_tag, reportTestCases), "posit< 2,0>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(ValidateFMA<3, 0>(test_tag, reportTestCases), "posit< 3,0>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(ValidateFMA<4, 0>(test_tag, reportTestCases), "posit< 4,0>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(ValidateFMA<5, 0>(test_tag, reportTestCases), "posit< 5,0>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(ValidateFMA<5, 1>(test_tag, reportTestCases), "posit< 5,1>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(ValidateFMA<6, 1>(test_tag, reportTestCases), "posit< 6,1>", test_tag);
 #endif
 
 #if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(ValidateFMA<7, 1>(test_tag, reportTestCases), "posit< 7,1>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyRandomFma<16, 1>(reportTestCases, 10000), "posit<16,1>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyRandomFma<32, 2>(reportTestCases, 10000), "posit<32,2>", test_tag);
 #endif
 
 #if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(ValidateFMA<8, 0>(test_tag, reportTestCases), "posit< 8,0>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyRandomFma<64, 3>(reportTestCases, 10000), "posit<64,3>", test_tag);
 #endif
 
 #if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += ReportTestResult(ValidateFMA<8, 2>(test_tag, reportTestCases), "posit< 8,2>", test_tag);
 #endif
 
 	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
@@ -0,0 +1,278 @@
+// correctly_rounded.cpp: test suite runner for the correctly rounded elementary functions of wide posits
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <random>
+#include <string>
+
+// use default number system library configuration
+#include <universal/number/posit/posit.hpp>
+#include <universal/verification/posit_test_suite_mathlib.hpp>
+
+namespace sw { namespace universal {
+
+	// posits do not overflow or underflow: project a double precision reference that does onto maxpos or minpos
+	template<typename Posit>
+	Posit ProjectedReference(double reference) {
+		Posit p;
+		if (std::isinf(reference)) {
+			p.maxpos();
+			if (std::signbit(reference)) p = -p;
+		}
+		else if (reference == 0.0) {
+			p.minpos();
+			if (std::signbit(reference)) p = -p;
+		}
+		else {
+			p = reference;
+		}
+		return p;
+	}
+
+	template<unsigned nbits, unsigned es>
+	posit<nbits, es> EvaluateFunction(const std::string& function, const posit<nbits, es>& x) {
+		if (function == "exp")   return exp(x);
+		if (function == "exp2")  return exp2(x);
+		if (function == "exp10") return exp10(x);
+		if (function == "expm1") return expm1(x);
+		if (function == "log")   return log(x);
+		if (function == "log2")  return log2(x);
+		if (function == "log10") return log10(x);
+		if (function == "log1p") return log1p(x);
+		if (function == "sin")   return sin(x);
+		if (function == "cos")   return cos(x);
+		if (function == "tan")   return tan(x);
+		if (function == "pow")   return pow(x, posit<nbits, es>(2.75));
+		return posit<nbits, es>(SpecificValue::nar);
+	}
+
+	const std::vector<std::string> elementaryFunctions = { "exp", "exp2", "exp10", "expm1", "log", "log2", "log10", "log1p", "sin", "cos", "tan", "pow" };
+
+	// random arguments in [-range, range], with log-like functions evaluated on |x|
+	template<unsigned nbits, unsigned es>
+	posit<nbits, es> RandomArgument(const std::string& function, std::mt19937_64& engine, double range) {
+		std::uniform_real_distribution<double> distribution(-range, range);
+		posit<nbits, es> x(distribution(engine));
+		// populate the fraction bits below the precision of the double
+		for (int i = static_cast<int>(engine() % 256); i > 0; --i) ++x;
+		if (function == "log" || function == "log2" || function == "log10" || function == "pow") x = abs(x);
+		if (function == "log1p" && x <= posit<nbits, es>(-1)) x = abs(x);
+		return x;
+	}
+
+	// round a wide posit to posit<nbits,es>: the fast specializations do not convert from other posit configurations
+	template<unsigned nbits, unsigned es, unsigned wbits, unsigned wes>
+	posit<nbits, es> Round(const posit<wbits, wes>& wide) {
+		posit<nbits, es> p;
+		if (wide.isnar()) return posit<nbits, es>(SpecificValue::nar);
+		return convert(wide.to_value(), p);
+	}
+
+	// the correctly rounded posit<nbits,es> result of an argument representable in posit<nbits,es> must be the
+	// correctly rounded result of the wider posit<wbits,wes>, rounded again, unless that second rounding is a tie
+	template<unsigned nbits, unsigned es, unsigned wbits, unsigned wes>
+	int VerifyAgainstWide(bool reportTestCases, const std::string& function, const posit<nbits, es>& x) {
+		using Posit = posit<nbits, es>;
+		using Wide = posit<wbits, wes>;
+		Posit result = EvaluateFunction(function, x);
+		Wide wide = EvaluateFunction(function, Wide(x));
+		Wide below(wide), above(wide);
+		--below;
+		++above;
+		if (!wide.isnar() && Round<nbits, es>(below) != Round<nbits, es>(above)) return 0; // the wide result is too close to a rounding boundary
+		Posit reference = Round<nbits, es>(wide);
+		if (result != reference) {
+			if (reportTestCases) ReportOneInputFunctionError("FAIL", function.c_str(), x, result, reference);
+			return 1;
+		}
+		return 0;
+	}
+
+	template<unsigned nbits, unsigned es, unsigned wbits, unsigned wes>
+	int VerifyPrecisionConsistency(bool reportTestCases, const std::string& function, double range, int nrTestCases) {
+		std::mt19937_64 engine(nbits * wbits);
+		int nrOfFailedTests = 0;
+		for (int i = 0; i < nrTestCases; ++i) {
+			nrOfFailedTests += VerifyAgainstWide<nbits, es, wbits, wes>(reportTestCases, function, RandomArgument<nbits, es>(function, engine, range));
+		}
+		return nrOfFailedTests;
+	}
+
+	// all encodings of a small posit: with a wide reference of the same es, this covers the saturating
+	// results and the dynamic range of large es that a double precision reference cannot represent
+	template<unsigned nbits, unsigned es, unsigned wbits>
+	int VerifyExhaustiveAgainstWide(bool reportTestCases, const std::string& function) {
+		int nrOfFailedTests = 0;
+		posit<nbits, es> x;
+		for (std::uint64_t i = 0; i < (std::uint64_t(1) << nbits); ++i) {
+			x.setbits(i);
+			nrOfFailedTests += VerifyAgainstWide<nbits, es, wbits, es>(reportTestCases, function, x);
+		}
+		return nrOfFailedTests;
+	}
+
+	// the correctly rounded result of a posit<32,2> must equal the rounded double precision reference
+	// whenever the double precision result is not within its error bound of a rounding boundary
+	template<unsigned nbits, unsigned es>
+	int VerifyAgainstDouble(bool reportTestCases, const std::string& function, double range, int nrTestCases) {
+		using Posit = posit<nbits, es>;
+		std::mt19937_64 engine(nbits);
+		int nrOfFailedTests = 0;
+		for (int i = 0; i < nrTestCases; ++i) {
+			Posit x = RandomArgument<nbits, es>(function, engine, range);
+			double d = double(x);
+			double ref{ 0.0 };
+			if (function == "exp")   ref = std::exp(d);
+			if (function == "exp2")  ref = std::exp2(d);
+			if (function == "exp10") ref = std::pow(10.0, d);
+			if (function == "expm1") ref = std::expm1(d);
+			if (function == "log")   ref = std::log(d);
+			if (function == "log2")  ref = std::log2(d);
+			if (function == "log10") ref = std::log10(d);
+			if (function == "log1p") ref = std::log1p(d);
+			if (function == "sin")   ref = std::sin(d);
+			if (function == "cos")   ref = std::cos(d);
+			if (function == "tan")   ref = std::tan(d);
+			if (function == "pow")   ref = std::pow(d, 2.75);
+			if (std::isnan(ref) || ref == 0.0) continue;
+			Posit lo = ProjectedReference<Posit>(ref * (1.0 - 0x1p-45));
+			Posit hi = ProjectedReference<Posit>(ref * (1.0 + 0x1p-45));
+			if (lo != hi) continue;
+			Posit result = EvaluateFunction(function, x);
+			if (result != lo) {
+				++nrOfFailedTests;
+				if (reportTestCases) ReportOneInputFunctionError("FAIL", function.c_str(), x, result, lo);
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	// results that are exactly representable must be produced exactly
+	template<unsigned nbits, unsigned es>
+	int VerifyExactCases(bool reportTestCases) {
+		using Posit = posit<nbits, es>;
+		int nrOfFailedTests = 0;
+		auto check = [&](const char* function, const Posit& x, const Posit& result, const Posit& reference) {
+			if (result != reference) {
+				++nrOfFailedTests;
+				if (reportTestCases) ReportOneInputFunctionError("FAIL", function, x, result, reference);
+			}
+		};
+		for (int k = -20; k <= 20; ++k) {
+			Posit x(k), powerOf2(std::ldexp(1.0, k));
+			check("exp2", x, exp2(x), powerOf2);
+			check("log2", powerOf2, log2(powerOf2), x);
+		}
+		for (int k = 1; k <= 15; ++k) {
+			Posit x(k), powerOf10(std::pow(10.0, k));
+			if (double(powerOf10) != std::pow(10.0, k)) break; // 10^k is no longer representable
+			check("exp10", x, exp10(x), powerOf10);
+			check("log10", powerOf10, log10(powerOf10), x);
+		}
+		Posit one(1), zero(0), three(3), third(1.0 / 3.0);
+		check("exp", zero, exp(zero), one);
+		check("log", one, log(one), zero);
+		check("sin", zero, sin(zero), zero);
+		check("cos", zero, cos(zero), one);
+		check("pow", three, pow(three, 5), Posit(243));
+		check("pow", third, pow(third, 2), third * third);
+		return nrOfFailedTests;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 0
+#define REGRESSION_LEVEL_4 0
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "posit correctly rounded elementary function validation";
+	std::string test_tag    = "correctly rounded";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	posit<64, 3> x(0.75);
+	std::cout << std::setprecision(20) << exp(x) << " : " << std::exp(0.75) << '\n';
+	std::cout << std::setprecision(20) << sin(posit<64, 3>(1.0e10)) << " : " << std::sin(1.0e10) << '\n';
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyExactCases<32, 2>(reportTestCases), "posit<32,2>", "exact cases");
+	nrOfFailedTestCases += ReportTestResult(VerifyExactCases<64, 3>(reportTestCases), "posit<64,3>", "exact cases");
+	for (const auto& function : elementaryFunctions) {
+		nrOfFailedTestCases += ReportTestResult(VerifyAgainstDouble<32, 2>(reportTestCases, function, 10.0, 100), "posit<32,2>", function);
+	}
+	for (const auto& function : { "exp", "exp2", "sin" }) {
+		nrOfFailedTestCases += ReportTestResult(VerifyExhaustiveAgainstWide<10, 7, 64>(reportTestCases, function), "posit<10,7> vs <64,7>", function);
+	}
+#endif
+
+#if REGRESSION_LEVEL_2
+	for (const auto& function : elementaryFunctions) {
+		nrOfFailedTestCases += ReportTestResult(VerifyPrecisionConsistency<32, 2, 64, 3>(reportTestCases, function, 10.0, 100), "posit<32,2> vs <64,3>", function);
+	}
+	nrOfFailedTestCases += ReportTestResult(VerifyExactCases<128, 4>(reportTestCases), "posit<128,4>", "exact cases");
+#endif
+
+#if REGRESSION_LEVEL_3
+	for (const auto& function : elementaryFunctions) {
+		nrOfFailedTestCases += ReportTestResult(VerifyAgainstDouble<32, 2>(reportTestCases, function, 1000.0, 1000), "posit<32,2>", function);
+		nrOfFailedTestCases += ReportTestResult(VerifyPrecisionConsistency<64, 3, 128, 4>(reportTestCases, function, 100.0, 100), "posit<64,3> vs <128,4>", function);
+	}
+#endif
+
+#if REGRESSION_LEVEL_4
+	for (const auto& function : elementaryFunctions) {
+		nrOfFailedTestCases += ReportTestResult(VerifyPrecisionConsistency<32, 2, 64, 3>(reportTestCases, function, 1.0e6, 1000), "posit<32,2> vs <64,3>", function);
+	}
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught ad-hoc exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::posit_arithmetic_exception& err) {
+	std::cerr << "Caught unexpected posit arithmetic exception : " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::posit_internal_exception& err) {
+	std::cerr << "Caught unexpected posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << '\n';
+	return EXIT_FAILURE;
+}